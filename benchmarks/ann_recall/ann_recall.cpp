@@ -0,0 +1,108 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <ArborX_Version.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <cstdlib>
+#include <iostream>
+
+#include "ann_recall.hpp"
+#include "vecs_io.hpp"
+
+int main(int argc, char *argv[])
+{
+  Kokkos::ScopeGuard guard(argc, argv);
+
+  std::cout << "ArborX version    : " << ArborX::version() << std::endl;
+  std::cout << "ArborX hash       : " << ArborX::gitCommitHash() << std::endl;
+
+  namespace bpo = boost::program_options;
+
+  ArborXBenchmark::Parameters params;
+
+  bpo::options_description desc("Allowed options");
+  // clang-format off
+  desc.add_options()
+      ( "help", "help message" )
+      ( "base", bpo::value<std::string>(&params.base_file), "base vectors (.fvecs | .bvecs)" )
+      ( "queries", bpo::value<std::string>(&params.query_file), "query vectors (.fvecs | .bvecs)" )
+      ( "groundtruth", bpo::value<std::string>(&params.groundtruth_file)->default_value(""), "ground-truth neighbor ids (.ivecs); computed exactly when omitted" )
+      ( "k", bpo::value<int>(&params.k)->default_value(10), "number of neighbors per query" )
+      ( "max-num-points", bpo::value<int>(&params.max_num_points)->default_value(-1), "max number of base vectors to read in" )
+      ( "max-num-queries", bpo::value<int>(&params.max_num_queries)->default_value(-1), "max number of query vectors to read in" )
+      ( "eps", bpo::value<std::vector<float>>(&params.eps_sweep)->multitoken(), "approximate-nearest eps values to sweep (default: 0.1 0.25 0.5 1 2)" )
+      ( "visit-budget", bpo::value<std::vector<int>>(&params.budget_sweep)->multitoken(), "per-query node-visit budgets to sweep, 0 = unlimited (default: 0)" )
+      ( "skip-brute-force", bpo::bool_switch(&params.skip_brute_force), "skip the brute-force throughput row" )
+      ;
+  // clang-format on
+  bpo::variables_map vm;
+  bpo::store(bpo::command_line_parser(argc, argv).options(desc).run(), vm);
+  bpo::notify(vm);
+
+  if (vm.count("help") > 0 || params.base_file.empty() ||
+      params.query_file.empty())
+  {
+    std::cout << desc << '\n';
+    std::cout << "Example (SIFT1M):\n"
+                 "  --base sift_base.fvecs --queries sift_query.fvecs "
+                 "--groundtruth sift_groundtruth.ivecs --k 10\n";
+    return 1;
+  }
+
+  if (params.eps_sweep.empty())
+    params.eps_sweep = {0.1f, 0.25f, 0.5f, 1.f, 2.f};
+  if (params.budget_sweep.empty())
+    params.budget_sweep = {0};
+
+  int const dim = getVecsDimension(params.base_file);
+
+  printf("base file         : %s\n", params.base_file.c_str());
+  printf("query file        : %s\n", params.query_file.c_str());
+  printf("groundtruth       : %s\n", (params.groundtruth_file.empty()
+                                          ? "(computed exactly)"
+                                          : params.groundtruth_file.c_str()));
+
+  using ArborXBenchmark::run;
+
+  bool success;
+  switch (dim)
+  {
+  case 3:
+    success = run<3>(params);
+    break;
+  case 25:
+    success = run<25>(params);
+    break;
+  case 50:
+    success = run<50>(params);
+    break;
+  case 100:
+    success = run<100>(params);
+    break;
+  case 128:
+    success = run<128>(params);
+    break;
+  case 200:
+    success = run<200>(params);
+    break;
+  default:
+    std::cerr << "Error: dimension " << dim
+              << " not instantiated (add it to TEMPLATE_PARAMETERS in the "
+                 "benchmark's CMakeLists.txt)\n";
+    success = false;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,34 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <string>
+#include <vector>
+
+namespace ArborXBenchmark
+{
+
+struct Parameters
+{
+  std::string base_file;
+  std::string query_file;
+  std::string groundtruth_file;
+  int k;
+  int max_num_points;
+  int max_num_queries;
+  std::vector<float> eps_sweep;
+  std::vector<int> budget_sweep;
+  bool skip_brute_force;
+};
+
+template <int DIM>
+bool run(Parameters const &params);
+
+} // namespace ArborXBenchmark
@@ -0,0 +1,205 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <ArborX_BruteForce.hpp>
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_HyperPoint.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_PairValueIndex.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <set>
+#include <tuple>
+#include <utility> // declval
+#include <vector>
+
+#include "ann_recall.hpp"
+#include "vecs_io.hpp"
+
+template <typename... P, typename T>
+auto vec2view(std::vector<T> const &in, std::string const &label = "")
+{
+  Kokkos::View<T *, P...> out(
+      Kokkos::view_alloc(label, Kokkos::WithoutInitializing), in.size());
+  Kokkos::deep_copy(out, Kokkos::View<T const *, Kokkos::HostSpace,
+                                      Kokkos::MemoryTraits<Kokkos::Unmanaged>>{
+                             in.data(), in.size()});
+  return out;
+}
+
+template <int DIM>
+bool ArborXBenchmark::run(ArborXBenchmark::Parameters const &params)
+{
+  using ExecutionSpace = Kokkos::DefaultExecutionSpace;
+  using MemorySpace = typename ExecutionSpace::memory_space;
+  ExecutionSpace space;
+
+  using Point = ArborX::ExperimentalHyperGeometry::Point<DIM>;
+  using Value = ArborX::PairValueIndex<Point>;
+
+  auto base = loadVecs<DIM>(params.base_file, params.max_num_points);
+  auto queries = loadVecs<DIM>(params.query_file, params.max_num_queries);
+
+  int const n = base.size();
+  int const nq = queries.size();
+  int const k = params.k;
+  ARBORX_ASSERT(n >= k);
+
+  printf("base              : %d points [dim = %d]\n", n, DIM);
+  printf("queries           : %d\n", nq);
+  printf("k                 : %d\n", k);
+
+  auto points = vec2view<MemorySpace>(base, "Benchmark::base");
+  auto query_points = vec2view<MemorySpace>(queries, "Benchmark::queries");
+
+  Kokkos::View<ArborX::Nearest<Point> *, MemorySpace> exact_predicates(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "Benchmark::exact_predicates"),
+      nq);
+  Kokkos::parallel_for(
+      "Benchmark::make_exact_predicates",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, nq),
+      KOKKOS_LAMBDA(int i) {
+        exact_predicates(i) = ArborX::nearest(query_points(i), k);
+      });
+
+  // Warm up once, then time a single full batch. The CRS offsets are kept:
+  // a budget-capped approximate query may return fewer than k neighbors
+  auto timed_query = [&](auto const &tree, auto const &predicates) {
+    Kokkos::View<int *, MemorySpace> indices("Benchmark::indices", 0);
+    Kokkos::View<int *, MemorySpace> offsets("Benchmark::offsets", 0);
+    tree.query(space, predicates, ArborX::Details::LegacyDefaultCallback{},
+               indices, offsets);
+    space.fence();
+    auto const start = std::chrono::high_resolution_clock::now();
+    tree.query(space, predicates, ArborX::Details::LegacyDefaultCallback{},
+               indices, offsets);
+    space.fence();
+    auto const end = std::chrono::high_resolution_clock::now();
+    double const seconds = std::chrono::duration<double>(end - start).count();
+    return std::make_tuple(
+        seconds,
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices),
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets));
+  };
+
+  // Ground truth as one id set per query, either read from the dataset's
+  // .ivecs file or computed with an exact brute-force pass
+  std::vector<std::set<int>> ground_truth(nq);
+
+  printf("\n%-12s %8s %10s %12s %12s %12s %8s\n", "algorithm", "eps", "budget",
+         "build [ms]", "query [ms]", "QPS", "recall");
+
+  auto recall = [&](auto const &indices_host, auto const &offsets_host) {
+    long hits = 0;
+    for (int i = 0; i < nq; ++i)
+      for (int j = offsets_host(i); j < offsets_host(i + 1); ++j)
+        hits += ground_truth[i].count(indices_host(j));
+    return (double)hits / ((double)nq * k);
+  };
+
+  auto print_row = [&](char const *algorithm, float eps, int budget,
+                       double build_ms, double query_sec, double rec) {
+    char budget_str[32];
+    if (budget <= 0)
+      snprintf(budget_str, sizeof(budget_str), "%10s", "-");
+    else
+      snprintf(budget_str, sizeof(budget_str), "%10d", budget);
+    printf("%-12s %8.3f %s %12.1f %12.2f %12.0f %8.4f\n", algorithm, eps,
+           budget_str, build_ms, query_sec * 1000, nq / query_sec, rec);
+  };
+
+  if (!params.groundtruth_file.empty())
+  {
+    int gt_k;
+    auto gt = loadGroundTruth(params.groundtruth_file, gt_k);
+    ARBORX_ASSERT((int)gt.size() >= nq * gt_k);
+    ARBORX_ASSERT(gt_k >= k);
+    for (int i = 0; i < nq; ++i)
+      ground_truth[i] =
+          std::set<int>(gt.begin() + i * (long)gt_k,
+                        gt.begin() + i * (long)gt_k + k);
+  }
+
+  if (params.groundtruth_file.empty() || !params.skip_brute_force)
+  {
+    space.fence();
+    auto start = std::chrono::high_resolution_clock::now();
+    ArborX::BruteForce<MemorySpace, Value> brute_force(
+        space, ArborX::Experimental::attach_indices(points));
+    space.fence();
+    auto end = std::chrono::high_resolution_clock::now();
+    double const build_ms =
+        std::chrono::duration<double>(end - start).count() * 1000;
+
+    auto const [seconds, indices_host, offsets_host] =
+        timed_query(brute_force, exact_predicates);
+
+    if (params.groundtruth_file.empty())
+      for (int i = 0; i < nq; ++i)
+        ground_truth[i] =
+            std::set<int>(indices_host.data() + offsets_host(i),
+                          indices_host.data() + offsets_host(i + 1));
+
+    if (!params.skip_brute_force)
+      print_row("brute", 0.f, 0, build_ms, seconds,
+                recall(indices_host, offsets_host));
+  }
+
+  space.fence();
+  auto start = std::chrono::high_resolution_clock::now();
+  ArborX::BoundingVolumeHierarchy<MemorySpace, Value> bvh(
+      space, ArborX::Experimental::attach_indices(points));
+  space.fence();
+  auto end = std::chrono::high_resolution_clock::now();
+  double const bvh_build_ms =
+      std::chrono::duration<double>(end - start).count() * 1000;
+
+  {
+    auto const [seconds, indices_host, offsets_host] =
+        timed_query(bvh, exact_predicates);
+    print_row("bvh", 0.f, 0, bvh_build_ms, seconds,
+              recall(indices_host, offsets_host));
+  }
+
+  using ApproxPredicate = decltype(ArborX::Experimental::approximate_nearest(
+      std::declval<ArborX::Nearest<Point> const &>(), 0.f, 0));
+  Kokkos::View<ApproxPredicate *, MemorySpace> approx_predicates(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "Benchmark::approx_predicates"),
+      nq);
+  for (auto eps : params.eps_sweep)
+    for (auto budget : params.budget_sweep)
+    {
+      int const device_budget =
+          (budget <= 0
+               ? ArborX::Details::KokkosExt::ArithmeticTraits::finite_max<
+                     int>::value
+               : budget);
+      Kokkos::parallel_for(
+          "Benchmark::make_approx_predicates",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, nq),
+          KOKKOS_LAMBDA(int i) {
+            approx_predicates(i) = ArborX::Experimental::approximate_nearest(
+                ArborX::nearest(query_points(i), k), eps, device_budget);
+          });
+
+      auto const [seconds, indices_host, offsets_host] =
+          timed_query(bvh, approx_predicates);
+      print_row("bvh", eps, budget, bvh_build_ms, seconds,
+                recall(indices_host, offsets_host));
+    }
+
+  return true;
+}
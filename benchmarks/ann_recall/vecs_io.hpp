@@ -0,0 +1,113 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef VECS_IO_HPP
+#define VECS_IO_HPP
+
+#include <ArborX_Exception.hpp>
+#include <ArborX_HyperPoint.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Readers for the texmex vector formats (http://corpus-texmex.irisa.fr/)
+// that the standard ANN datasets ship in: .fvecs/.bvecs hold the base and
+// query vectors (SIFT1M, GIST1M), .ivecs the ground-truth neighbor ids.
+// Every vector is stored as a 32-bit component count followed by the
+// components (float, uint8, or int32, by extension). ANN-benchmarks HDF5
+// datasets (GloVe, ...) convert to these formats with a few lines of h5py.
+
+inline bool hasExtension(std::string const &filename, std::string const &ext)
+{
+  return filename.size() >= ext.size() &&
+         filename.compare(filename.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+inline int getVecsDimension(std::string const &filename)
+{
+  std::ifstream input(filename, std::ifstream::binary);
+  if (!input.good())
+    throw std::runtime_error("Error reading file \"" + filename + "\"");
+
+  int dim;
+  input.read(reinterpret_cast<char *>(&dim), sizeof(int));
+  ARBORX_ASSERT(dim > 0);
+
+  return dim;
+}
+
+template <int DIM>
+std::vector<ArborX::ExperimentalHyperGeometry::Point<DIM>>
+loadVecs(std::string const &filename, int max_num = -1)
+{
+  std::ifstream input(filename, std::ifstream::binary);
+  if (!input.good())
+    throw std::runtime_error("Error reading file \"" + filename + "\"");
+
+  bool const byte_components = hasExtension(filename, ".bvecs");
+
+  std::vector<ArborX::ExperimentalHyperGeometry::Point<DIM>> v;
+  int dim;
+  while (input.read(reinterpret_cast<char *>(&dim), sizeof(int)))
+  {
+    ARBORX_ASSERT(dim == DIM);
+    ArborX::ExperimentalHyperGeometry::Point<DIM> point;
+    if (byte_components)
+    {
+      uint8_t components[DIM];
+      input.read(reinterpret_cast<char *>(components), DIM);
+      for (int d = 0; d < DIM; ++d)
+        point[d] = components[d];
+    }
+    else
+    {
+      float components[DIM];
+      input.read(reinterpret_cast<char *>(components), DIM * sizeof(float));
+      for (int d = 0; d < DIM; ++d)
+        point[d] = components[d];
+    }
+    v.push_back(point);
+    if (max_num > 0 && (int)v.size() >= max_num)
+      break;
+  }
+
+  return v;
+}
+
+// Returns the ids flattened with stride gt_k (the per-query neighbor count
+// stored in the file, typically 100); entries within a row are ordered by
+// increasing distance, so the first k form the ground truth for recall@k
+inline std::vector<int> loadGroundTruth(std::string const &filename, int &gt_k)
+{
+  std::ifstream input(filename, std::ifstream::binary);
+  if (!input.good())
+    throw std::runtime_error("Error reading file \"" + filename + "\"");
+
+  std::vector<int> ids;
+  gt_k = -1;
+  int dim;
+  while (input.read(reinterpret_cast<char *>(&dim), sizeof(int)))
+  {
+    if (gt_k < 0)
+      gt_k = dim;
+    ARBORX_ASSERT(dim == gt_k);
+    auto const old_size = ids.size();
+    ids.resize(old_size + dim);
+    input.read(reinterpret_cast<char *>(ids.data() + old_size),
+               dim * sizeof(int));
+  }
+
+  return ids;
+}
+
+#endif
@@ -21,6 +21,7 @@
 #include <iostream>
 
 #include "benchmark_registration.hpp"
+#include "sweep.hpp"
 
 #ifdef ARBORX_PERFORMANCE_TESTING
 #include <mpi.h>
@@ -201,6 +202,7 @@ int main(int argc, char *argv[])
   std::string source_pt_cloud;
   std::string target_pt_cloud;
   std::vector<std::string> exact_specs;
+  bool sweep;
   // clang-format off
     desc.add_options()
         ( "help", "produce help message" )
@@ -212,6 +214,7 @@ int main(int argc, char *argv[])
         ( "source-point-cloud-type", bpo::value<std::string>(&source_pt_cloud)->default_value("filled_box"), "shape of the source point cloud"  )
         ( "target-point-cloud-type", bpo::value<std::string>(&target_pt_cloud)->default_value("filled_box"), "shape of the target point cloud"  )
         ( "exact-spec", bpo::value<std::vector<std::string>>(&exact_specs)->multitoken(), "exact specification (can be specified multiple times for batch)" )
+        ( "sweep", bpo::bool_switch(&sweep)->default_value(false), "build trees across the curve x builder matrix and report a build-time vs query-throughput Pareto table per backend" )
     ;
   // clang-format on
   bpo::variables_map vm;
@@ -280,13 +283,23 @@ int main(int argc, char *argv[])
     specs.push_back(single_spec);
   }
 
-  for (auto const &spec : specs)
+  if (sweep)
   {
-    register_bvh_benchmarks(spec);
-    register_boostrtree_benchmarks(spec);
+    // The whole configuration matrix is evaluated in-process from the same
+    // generated point clouds, so no benchmarks are registered
+    for (auto const &spec : specs)
+      run_pareto_sweeps(spec);
   }
+  else
+  {
+    for (auto const &spec : specs)
+    {
+      register_bvh_benchmarks(spec);
+      register_boostrtree_benchmarks(spec);
+    }
 
-  benchmark::RunSpecifiedBenchmarks();
+    benchmark::RunSpecifiedBenchmarks();
+  }
 
   Kokkos::finalize();
 #ifdef ARBORX_PERFORMANCE_TESTING
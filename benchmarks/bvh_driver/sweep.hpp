@@ -0,0 +1,202 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef SWEEP_HPP
+#define SWEEP_HPP
+
+#include <ArborX_LinearBVH.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "benchmark_registration.hpp"
+
+// Sweep mode: build trees across the curve x builder configuration matrix
+// from a single generated point cloud and report a build-time vs
+// query-throughput Pareto table per backend. One process evaluates the whole
+// matrix, so the inputs (and their Pareto ranking) are directly comparable
+// across configurations, which scripted one-configuration-per-run
+// invocations cannot guarantee.
+
+struct SweepEntry
+{
+  std::string config;
+  double build_ms;
+  double query_rate; // queries per second
+  bool pareto = false;
+};
+
+template <typename DeviceType>
+struct SweepCountCallback
+{
+  Kokkos::View<int *, DeviceType> _count;
+
+  template <typename Query, typename Value>
+  KOKKOS_FUNCTION void operator()(Query const &query, Value const &) const
+  {
+    Kokkos::atomic_increment(&_count(ArborX::getData(query)));
+  }
+};
+
+template <typename ExecutionSpace>
+void run_pareto_sweep(Spec const &spec, std::string const &backend_name)
+{
+  using MemorySpace = typename ExecutionSpace::memory_space;
+  using DeviceType = Kokkos::Device<ExecutionSpace, MemorySpace>;
+  using TreeType =
+      ArborX::BoundingVolumeHierarchy<MemorySpace,
+                                      ArborX::PairValueIndex<ArborX::Point>>;
+
+  ExecutionSpace exec_space;
+
+  auto const points =
+      constructPoints<DeviceType>(spec.n_values, spec.source_point_cloud_type);
+  auto const queries_no_index = makeSpatialQueries<DeviceType>(
+      spec.n_values, spec.n_queries, spec.n_neighbors,
+      spec.target_point_cloud_type);
+  QueriesWithIndex<decltype(queries_no_index)> queries{queries_no_index};
+
+  std::vector<SweepEntry> entries;
+
+  auto const now = []() { return std::chrono::high_resolution_clock::now(); };
+
+  auto time_configuration = [&](std::string const &config, auto const &curve,
+                                auto const &builder) {
+    constexpr int n_build_reps = 3;
+    constexpr int n_query_reps = 5;
+
+    // Warm-up build absorbs one-time costs (allocator pools, JIT)
+    TreeType tree(exec_space, ArborX::Experimental::attach_indices(points),
+                  ArborX::Details::DefaultIndexableGetter{}, curve, builder);
+
+    double build_s = std::numeric_limits<double>::max();
+    for (int rep = 0; rep < n_build_reps; ++rep)
+    {
+      exec_space.fence();
+      auto const start = now();
+      TreeType rebuilt(exec_space,
+                       ArborX::Experimental::attach_indices(points),
+                       ArborX::Details::DefaultIndexableGetter{}, curve,
+                       builder);
+      exec_space.fence();
+      build_s = std::min(
+          build_s, std::chrono::duration<double>(now() - start).count());
+    }
+
+    Kokkos::View<int *, DeviceType> counts("Benchmark::counts",
+                                           spec.n_queries);
+    SweepCountCallback<DeviceType> callback{counts};
+    auto const policy =
+        ArborX::Experimental::TraversalPolicy().setPredicateSorting(
+            spec.sort_predicates);
+    // Warm-up query
+    tree.query(exec_space, queries, callback, policy);
+
+    double query_s = std::numeric_limits<double>::max();
+    for (int rep = 0; rep < n_query_reps; ++rep)
+    {
+      exec_space.fence();
+      auto const start = now();
+      tree.query(exec_space, queries, callback, policy);
+      exec_space.fence();
+      query_s = std::min(
+          query_s, std::chrono::duration<double>(now() - start).count());
+    }
+
+    entries.push_back({config, build_s * 1000, spec.n_queries / query_s});
+  };
+
+  auto sweep_curve = [&](std::string const &curve_name, auto const &curve) {
+    using ArborX::Experimental::KarrasBuilder;
+    using ArborX::Experimental::PLOCBuilder;
+
+    time_configuration(curve_name + "/Karras", curve, KarrasBuilder{});
+    time_configuration(curve_name + "/Karras/rotations=2", curve,
+                       KarrasBuilder{/*restructure_rounds*/ 2});
+    time_configuration(curve_name + "/PLOC", curve, PLOCBuilder{});
+    PLOCBuilder ploc_restructured;
+    ploc_restructured.restructure_rounds = 2;
+    time_configuration(curve_name + "/PLOC/rotations=2", curve,
+                       ploc_restructured);
+  };
+
+  sweep_curve("Morton32", ArborX::Experimental::Morton32{});
+  sweep_curve("Morton64", ArborX::Experimental::Morton64{});
+  sweep_curve("Hilbert32", ArborX::Experimental::Hilbert32{});
+  sweep_curve("Hilbert64", ArborX::Experimental::Hilbert64{});
+  // The SAH builder partitions primitives directly, so the curve choice is
+  // irrelevant; evaluate it once
+  time_configuration("SAH", ArborX::Experimental::Morton64{},
+                     ArborX::Experimental::SAHBuilder{});
+
+  // An entry is on the Pareto front unless some other entry builds at least
+  // as fast and answers queries at least as fast, one of the two strictly
+  for (auto &entry : entries)
+  {
+    entry.pareto = std::none_of(
+        entries.begin(), entries.end(), [&entry](SweepEntry const &other) {
+          return other.build_ms <= entry.build_ms &&
+                 other.query_rate >= entry.query_rate &&
+                 (other.build_ms < entry.build_ms ||
+                  other.query_rate > entry.query_rate);
+        });
+  }
+
+  std::printf("\n== Pareto sweep: %s (%d values, %d queries) ==\n",
+              backend_name.c_str(), spec.n_values, spec.n_queries);
+  std::printf("%-28s %12s %14s  %s\n", "configuration", "build [ms]",
+              "query [Mq/s]", "pareto");
+  for (auto const &entry : entries)
+    std::printf("%-28s %12.3f %14.3f  %s\n", entry.config.c_str(),
+                entry.build_ms, entry.query_rate / 1e6,
+                entry.pareto ? "*" : "");
+}
+
+inline void run_pareto_sweeps(Spec const &spec)
+{
+#ifdef KOKKOS_ENABLE_SERIAL
+  if (spec.backends == "all" || spec.backends == "serial")
+    run_pareto_sweep<Kokkos::Serial>(spec, "ArborX::BVH<Serial>");
+#endif
+#ifdef KOKKOS_ENABLE_OPENMP
+  if (spec.backends == "all" || spec.backends == "openmp")
+    run_pareto_sweep<Kokkos::OpenMP>(spec, "ArborX::BVH<OpenMP>");
+#endif
+#ifdef KOKKOS_ENABLE_THREADS
+  if (spec.backends == "all" || spec.backends == "threads")
+    run_pareto_sweep<Kokkos::Threads>(spec, "ArborX::BVH<Threads>");
+#endif
+#ifdef KOKKOS_ENABLE_CUDA
+  if (spec.backends == "all" || spec.backends == "cuda")
+    run_pareto_sweep<Kokkos::Cuda>(spec, "ArborX::BVH<Cuda>");
+#endif
+#ifdef KOKKOS_ENABLE_HIP
+  if (spec.backends == "all" || spec.backends == "hip")
+    run_pareto_sweep<Kokkos::HIP>(spec, "ArborX::BVH<HIP>");
+#endif
+#ifdef KOKKOS_ENABLE_OPENMPTARGET
+  if (spec.backends == "all" || spec.backends == "openmptarget")
+    run_pareto_sweep<Kokkos::Experimental::OpenMPTarget>(
+        spec, "ArborX::BVH<OpenMPTarget>");
+#endif
+#ifdef KOKKOS_ENABLE_SYCL
+  if (spec.backends == "all" || spec.backends == "sycl")
+    run_pareto_sweep<Kokkos::Experimental::SYCL>(spec, "ArborX::BVH<SYCL>");
+#endif
+}
+
+#endif
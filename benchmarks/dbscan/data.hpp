@@ -15,6 +15,10 @@
 #include <ArborX_Exception.hpp>
 #include <ArborX_HyperPoint.hpp>
 
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <random>
 #include <vector>
@@ -111,6 +115,99 @@ std::vector<Point<DIM>> loadData(std::string const &filename,
   return v;
 }
 
+// Streaming variant of loadData() for binary files: the points are read in
+// chunks into two host staging buffers (pinned when the backend provides a
+// host-pinned space) and copied to the device on per-buffer asynchronous
+// instances, so the file read of one chunk overlaps the transfer of the
+// previous one. The chunk_callback(instance, num_arrived) hook is invoked
+// after each chunk's copy has been enqueued; a caller can use it to launch
+// work on the already-arrived prefix of the view (e.g. incremental tree
+// construction) on the same instance, overlapping compute with the rest of
+// the load.
+template <int DIM, typename MemorySpace, typename ExecutionSpace,
+          typename ChunkCallback>
+Kokkos::View<Point<DIM> *, MemorySpace>
+loadDataStreaming(ExecutionSpace const &space, std::string const &filename,
+                  ChunkCallback &&chunk_callback, int max_num_points = -1,
+                  int chunk_size = (1 << 22))
+{
+  std::cout << "Streaming in \"" << filename << "\" in binary mode...";
+  std::cout.flush();
+
+  std::ifstream input(filename, std::ifstream::binary);
+  ARBORX_ASSERT(input.good());
+
+  int num_points = 0;
+  int dim = 0;
+  input.read(reinterpret_cast<char *>(&num_points), sizeof(int));
+  input.read(reinterpret_cast<char *>(&dim), sizeof(int));
+  ARBORX_ASSERT(dim == DIM);
+
+  if (max_num_points > 0 && max_num_points < num_points)
+    num_points = max_num_points;
+
+  Kokkos::View<Point<DIM> *, MemorySpace> points(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Benchmark::points"),
+      num_points);
+
+#ifdef KOKKOS_HAS_SHARED_HOST_PINNED_SPACE
+  using StagingMemorySpace = Kokkos::SharedHostPinnedSpace;
+#else
+  using StagingMemorySpace = Kokkos::HostSpace;
+#endif
+  using StagingBuffer = Kokkos::View<Point<DIM> *, StagingMemorySpace>;
+
+  int const buffer_size = std::min(chunk_size, num_points);
+  StagingBuffer staging[2] = {
+      StagingBuffer(Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                       "Benchmark::staging_0"),
+                    buffer_size),
+      StagingBuffer(Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                       "Benchmark::staging_1"),
+                    buffer_size)};
+
+  // One instance per buffer: the copy out of one buffer runs while the file
+  // read refills the other
+  auto instances = Kokkos::Experimental::partition_space(space, 1, 1);
+
+  int buffer = 0;
+  for (int offset = 0; offset < num_points;
+       offset += chunk_size, buffer = 1 - buffer)
+  {
+    int const n = std::min(chunk_size, num_points - offset);
+
+    // The copy launched two chunks ago must have drained this buffer before
+    // the read overwrites it
+    instances[buffer].fence();
+    input.read(reinterpret_cast<char *>(staging[buffer].data()),
+               n * sizeof(Point<DIM>));
+
+    Kokkos::deep_copy(
+        instances[buffer],
+        Kokkos::subview(points, Kokkos::make_pair(offset, offset + n)),
+        Kokkos::subview(staging[buffer], Kokkos::make_pair(0, n)));
+    chunk_callback(instances[buffer], offset + n);
+  }
+  ARBORX_ASSERT(input.good());
+
+  instances[0].fence();
+  instances[1].fence();
+
+  std::cout << "done\nRead in " << num_points << " " << dim << "D points"
+            << std::endl;
+
+  return points;
+}
+
+template <int DIM, typename MemorySpace, typename ExecutionSpace>
+Kokkos::View<Point<DIM> *, MemorySpace>
+loadDataStreaming(ExecutionSpace const &space, std::string const &filename,
+                  int max_num_points = -1)
+{
+  return loadDataStreaming<DIM, MemorySpace>(
+      space, filename, [](ExecutionSpace const &, int) {}, max_num_points);
+}
+
 template <int DIM, typename Generator>
 auto randomDomainPoint(Generator &generator, float L)
 {
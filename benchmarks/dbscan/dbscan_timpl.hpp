@@ -9,6 +9,7 @@
  * SPDX-License-Identifier: BSD-3-Clause                                    *
  ****************************************************************************/
 
+#include <ArborX_ClusterPostprocessing.hpp>
 #include <ArborX_DBSCAN.hpp>
 #include <ArborX_DBSCANVerification.hpp>
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
@@ -42,110 +43,6 @@ void writeLabelsData(std::string const &filename,
   out.write((char *)labels_host.data(), sizeof(int) * n);
 }
 
-template <typename ExecutionSpace, typename LabelsView,
-          typename ClusterIndicesView, typename ClusterOffsetView>
-void sortAndFilterClusters(ExecutionSpace const &exec_space,
-                           LabelsView const &labels,
-                           ClusterIndicesView &cluster_indices,
-                           ClusterOffsetView &cluster_offset,
-                           int cluster_min_size = 1)
-{
-  Kokkos::Profiling::pushRegion("ArborX::DBSCAN::sortAndFilterClusters");
-
-  namespace KokkosExt = ArborX::Details::KokkosExt;
-
-  static_assert(Kokkos::is_view<LabelsView>{});
-  static_assert(Kokkos::is_view<ClusterIndicesView>{});
-  static_assert(Kokkos::is_view<ClusterOffsetView>{});
-
-  using MemorySpace = typename LabelsView::memory_space;
-
-  static_assert(std::is_same<typename LabelsView::value_type, int>{});
-  static_assert(std::is_same<typename ClusterIndicesView::value_type, int>{});
-  static_assert(std::is_same<typename ClusterOffsetView::value_type, int>{});
-
-  static_assert(std::is_same<typename LabelsView::memory_space, MemorySpace>{});
-  static_assert(
-      std::is_same<typename ClusterIndicesView::memory_space, MemorySpace>{});
-  static_assert(
-      std::is_same<typename ClusterOffsetView::memory_space, MemorySpace>{});
-
-  ARBORX_ASSERT(cluster_min_size >= 1);
-
-  int const n = labels.extent_int(0);
-
-  Kokkos::View<int *, MemorySpace> cluster_sizes(
-      "ArborX::DBSCAN::cluster_sizes", n);
-  Kokkos::parallel_for(
-      "ArborX::DBSCAN::compute_cluster_sizes",
-      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
-      KOKKOS_LAMBDA(int const i) {
-        // Ignore noise points
-        if (labels(i) < 0)
-          return;
-
-        Kokkos::atomic_increment(&cluster_sizes(labels(i)));
-      });
-
-  // This kernel serves dual purpose:
-  // - it constructs an offset array through exclusive prefix sum, with a
-  //   caveat that small clusters (of size < cluster_min_size) are filtered out
-  // - it creates a mapping from a cluster index into the cluster's position in
-  //   the offset array
-  // We reuse the cluster_sizes array for the second, creating a new alias for
-  // it for clarity.
-  auto &map_cluster_to_offset_position = cluster_sizes;
-  constexpr int IGNORED_CLUSTER = -1;
-  int num_clusters;
-  KokkosExt::reallocWithoutInitializing(exec_space, cluster_offset, n + 1);
-  Kokkos::parallel_scan(
-      "ArborX::DBSCAN::compute_cluster_offset_with_filter",
-      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
-      KOKKOS_LAMBDA(int const i, int &update, bool final_pass) {
-        bool is_cluster_too_small = (cluster_sizes(i) < cluster_min_size);
-        if (!is_cluster_too_small)
-        {
-          if (final_pass)
-          {
-            cluster_offset(update) = cluster_sizes(i);
-            map_cluster_to_offset_position(i) = update;
-          }
-          ++update;
-        }
-        else
-        {
-          if (final_pass)
-            map_cluster_to_offset_position(i) = IGNORED_CLUSTER;
-        }
-      },
-      num_clusters);
-  Kokkos::resize(Kokkos::WithoutInitializing, cluster_offset, num_clusters + 1);
-  KokkosExt::exclusive_scan(exec_space, cluster_offset, cluster_offset, 0);
-
-  auto cluster_starts = KokkosExt::clone(exec_space, cluster_offset);
-  KokkosExt::reallocWithoutInitializing(
-      exec_space, cluster_indices,
-      KokkosExt::lastElement(exec_space, cluster_offset));
-  Kokkos::parallel_for(
-      "ArborX::DBSCAN::compute_cluster_indices",
-      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
-      KOKKOS_LAMBDA(int const i) {
-        // Ignore noise points
-        if (labels(i) < 0)
-          return;
-
-        auto offset_pos = map_cluster_to_offset_position(labels(i));
-        if (offset_pos != IGNORED_CLUSTER)
-        {
-          auto position =
-              Kokkos::atomic_fetch_add(&cluster_starts(offset_pos), 1);
-          cluster_indices(position) = i;
-        }
-      });
-
-  Kokkos::Profiling::popRegion();
-}
-
 template <typename... P, typename T>
 auto vec2view(std::vector<T> const &in, std::string const &label = "")
 {
@@ -173,21 +70,33 @@ bool ArborXBenchmark::run(ArborXBenchmark::Parameters const &params)
 
   ExecutionSpace exec_space;
 
-  std::vector<ArborX::ExperimentalHyperGeometry::Point<DIM>> data;
-  if (!params.filename.empty())
+  using Point = ArborX::ExperimentalHyperGeometry::Point<DIM>;
+  Kokkos::View<Point *, MemorySpace> primitives;
+  if (!params.filename.empty() && params.binary && params.num_samples <= 0)
   {
-    // Read in data
-    data = loadData<DIM>(params.filename, params.binary, params.max_num_points,
-                         params.num_samples);
+    // Binary files stream straight into device memory, overlapping the file
+    // read with the host-device transfer instead of waiting for the whole
+    // cloud to arrive on the host first
+    primitives = loadDataStreaming<DIM, MemorySpace>(
+        exec_space, params.filename, params.max_num_points);
   }
   else
   {
-    // Generate data
-    data = GanTao<DIM>(params.n, params.variable_density);
+    std::vector<Point> data;
+    if (!params.filename.empty())
+    {
+      // Read in data
+      data = loadData<DIM>(params.filename, params.binary,
+                           params.max_num_points, params.num_samples);
+    }
+    else
+    {
+      // Generate data
+      data = GanTao<DIM>(params.n, params.variable_density);
+    }
+    primitives = vec2view<MemorySpace>(data, "Benchmark::primitives");
   }
 
-  auto const primitives = vec2view<MemorySpace>(data, "Benchmark::primitives");
-
   using Primitives = decltype(primitives);
 
   Kokkos::View<int *, MemorySpace> labels("Example::labels", 0);
@@ -214,8 +123,9 @@ bool ArborXBenchmark::run(ArborXBenchmark::Parameters const &params)
                                                      0);
     Kokkos::View<int *, MemorySpace> cluster_offset("Testing::cluster_offset",
                                                     0);
-    sortAndFilterClusters(exec_space, labels, cluster_indices, cluster_offset,
-                          params.cluster_min_size);
+    ArborX::Experimental::sortAndFilterClusters(exec_space, labels,
+                                                cluster_indices, cluster_offset,
+                                                params.cluster_min_size);
     Kokkos::Profiling::popRegion();
 
     Kokkos::Profiling::popRegion();
@@ -270,6 +180,8 @@ bool ArborXBenchmark::run(ArborXBenchmark::Parameters const &params)
       dendrogram_impl = DendrogramImplementation::UNION_FIND;
     else if (params.dendrogram == "boruvka")
       dendrogram_impl = DendrogramImplementation::BORUVKA;
+    else if (params.dendrogram == "alpha")
+      dendrogram_impl = DendrogramImplementation::ALPHA;
     else
     {
       auto error_string = "Unknown dendogram: \"" + params.dendrogram + "\"";
@@ -22,8 +22,10 @@
 #include <cmath> // sqrt, cbrt
 #include <iomanip>
 #include <iostream> // cout
+#include <memory>
 #include <numeric>
 #include <random>
+#include <sstream>
 #include <utility>
 #include <vector>
 
@@ -218,81 +220,64 @@ struct ArborX::AccessTraits<NearestNeighborsSearches<DeviceType>,
 
 namespace bpo = boost::program_options;
 
-template <class NO>
-int main_(std::vector<std::string> const &args, const MPI_Comm comm)
+struct BenchmarkParams
 {
-  TimeMonitor time_monitor;
-
-  using DeviceType = typename NO::device_type;
-  using ExecutionSpace = typename DeviceType::execution_space;
-  using MemorySpace = typename DeviceType::memory_space;
-
   int n_values;
   int n_queries;
   int n_neighbors;
   double shift;
   int partition_dim;
-  bool perform_knn_search = true;
-  bool perform_radius_search = true;
-  bool shift_queries = false;
+  bool perform_knn_search;
+  bool perform_radius_search;
+  bool shift_queries;
+  double skew_exponent;
+  double hotspot_fraction;
+};
 
-  bpo::options_description desc("Allowed options");
-  // clang-format off
-    desc.add_options()
-        ( "help", "produce help message" )
-        ( "values", bpo::value<int>(&n_values)->default_value(20000), "Number of indexable values (source) per MPI rank." )
-        ( "queries", bpo::value<int>(&n_queries)->default_value(5000), "Number of queries (target) per MPI rank." )
-        ( "neighbors", bpo::value<int>(&n_neighbors)->default_value(10), "Desired number of results per query." )
-        ( "shift", bpo::value<double>(&shift)->default_value(1.), "Shift of the point clouds. '0' means the clouds are built "
-	                                                          "at the same place, while '1' places the clouds next to each"
-								  "other. Negative values and values larger than one "
-                                                                  "mean that the clouds are separated." )
-        ( "partition_dim", bpo::value<int>(&partition_dim)->default_value(3), "Number of dimension used by the partitioning of the global "
-                                                                              "point cloud. 1 -> local clouds are aligned on a line, 2 -> "
-                                                                              "local clouds form a board, 3 -> local clouds form a box." )
-        ( "do-not-perform-knn-search", "skip kNN search" )
-        ( "do-not-perform-radius-search", "skip radius search" )
-        ( "shift-queries" , "By default, points are reused for the queries. Enabling this option shrinks the local box queries are created "
-                            "in to a third of its size and moves it to the center of the global box. The result is a huge imbalance for the "
-                            "number of queries that need to be processed by each processor.")
-        ;
-  // clang-format on
-  bpo::variables_map vm;
-  bpo::store(bpo::command_line_parser(args).options(desc).run(), vm);
-  bpo::notify(vm);
+// Maximum over the participating ranks; skipped phases report -1
+struct BenchmarkTimings
+{
+  double construction = -1.;
+  double knn = -1.;
+  double radius = -1.;
+};
+
+template <class DeviceType>
+BenchmarkTimings run_benchmark(MPI_Comm comm, BenchmarkParams const &params,
+                               TimeMonitor *time_monitor)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
 
   int comm_rank;
   MPI_Comm_rank(comm, &comm_rank);
   int comm_size;
   MPI_Comm_size(comm, &comm_size);
 
-  if (vm.count("help") > 0)
+  int const n_queries = params.n_queries;
+  int const n_neighbors = params.n_neighbors;
+  double const shift = params.shift;
+  int const partition_dim = params.partition_dim;
+
+  // Power-law per-rank skew: rank r holds a share proportional to
+  // (r+1)^-skew_exponent, normalized so that the global count matches the
+  // balanced run. The cloud geometry (box size and placement) stays that of
+  // the balanced run, so the skew shows up as density imbalance, the way
+  // production decompositions produce it.
+  int n_values = params.n_values;
+  if (params.skew_exponent > 0)
   {
-    if (comm_rank == 0)
-      std::cout << desc << '\n';
-    throw HelpPrinted();
+    double weights_sum = 0.;
+    for (int r = 0; r < comm_size; ++r)
+      weights_sum += std::pow(r + 1, -params.skew_exponent);
+    n_values = std::max<int>(
+        1, std::lround(params.n_values * comm_size *
+                       std::pow(comm_rank + 1, -params.skew_exponent) /
+                       weights_sum));
   }
 
-  if (vm.count("do-not-perform-knn-search") > 0)
-    perform_knn_search = false;
-  if (vm.count("do-not-perform-radius-search") > 0)
-    perform_radius_search = false;
-  if (vm.count("shift-queries") > 0)
-    shift_queries = true;
-
-  if (comm_rank == 0)
-  {
-    std::cout << std::boolalpha;
-    std::cout << "\nRunning with arguments:\n"
-              << "perform knn search      : " << perform_knn_search << '\n'
-              << "perform radius search   : " << perform_radius_search << '\n'
-              << "#points/MPI process     : " << n_values << '\n'
-              << "#queries/MPI process    : " << n_queries << '\n'
-              << "size of shift           : " << shift << '\n'
-              << "dimension               : " << partition_dim << '\n'
-              << "shift-queries           : " << shift_queries << '\n'
-              << '\n';
-  }
+  BenchmarkTimings timings;
+  auto const now = []() { return std::chrono::high_resolution_clock::now(); };
 
   Kokkos::View<ArborX::Point *, DeviceType> random_values(
       Kokkos::view_alloc(Kokkos::WithoutInitializing, "Benchmark::values"),
@@ -315,7 +300,7 @@ int main_(std::vector<std::string> const &args, const MPI_Comm comm)
     {
       i_max = comm_size;
       offset_x = 2 * shift * comm_rank;
-      a = n_values;
+      a = params.n_values;
 
       break;
     }
@@ -326,7 +311,7 @@ int main_(std::vector<std::string> const &args, const MPI_Comm comm)
       int j = comm_rank / i_max;
       offset_x = 2 * shift * i;
       offset_y = 2 * shift * j;
-      a = std::sqrt(n_values);
+      a = std::sqrt(params.n_values);
 
       break;
     }
@@ -340,7 +325,7 @@ int main_(std::vector<std::string> const &args, const MPI_Comm comm)
       offset_x = 2 * shift * i;
       offset_y = 2 * shift * j;
       offset_z = 2 * shift * k;
-      a = std::cbrt(n_values);
+      a = std::cbrt(params.n_values);
 
       break;
     }
@@ -374,7 +359,7 @@ int main_(std::vector<std::string> const &args, const MPI_Comm comm)
         random_values,
         Kokkos::subview(random_points, Kokkos::pair<int, int>(0, n_values)));
 
-    if (!shift_queries)
+    if (!params.shift_queries)
     {
       // By default, random points are "reused" between building the tree and
       // performing queries.
@@ -398,6 +383,22 @@ int main_(std::vector<std::string> const &args, const MPI_Comm comm)
                  (partition_dim > 2)}};
       Kokkos::deep_copy(random_queries, random_queries_host);
     }
+
+    if (params.hotspot_fraction > 0)
+    {
+      // Concentrate a fraction of every rank's predicates in the cloud of
+      // rank 0, so that the forwarding path and the Distributor see the
+      // many-to-one traffic that hotspots produce
+      auto random_queries_host = Kokkos::create_mirror_view(random_queries);
+      Kokkos::deep_copy(random_queries_host, random_queries);
+      int const n_hotspot =
+          std::min<int>(n_queries, params.hotspot_fraction * n_queries);
+      for (int i = 0; i < n_hotspot; ++i)
+        random_queries_host(i) = {{a * random(),
+                                   a * random() * (partition_dim > 1),
+                                   a * random() * (partition_dim > 2)}};
+      Kokkos::deep_copy(random_queries, random_queries_host);
+    }
   }
 
   Kokkos::View<ArborX::Box *, DeviceType> bounding_boxes(
@@ -414,37 +415,49 @@ int main_(std::vector<std::string> const &args, const MPI_Comm comm)
                              {{x + 1., y + 1., z + 1.}}};
       });
 
-  auto construction = time_monitor.getNewTimer("construction");
+  std::unique_ptr<TimeMonitor::Timer> construction;
+  if (time_monitor)
+    construction = time_monitor->getNewTimer("construction");
   MPI_Barrier(comm);
-  construction->start();
+  if (construction)
+    construction->start();
+  auto start = now();
   ArborX::DistributedTree<MemorySpace> distributed_tree(comm, ExecutionSpace{},
                                                         bounding_boxes);
-  construction->stop();
+  timings.construction = std::chrono::duration<double>(now() - start).count();
+  if (construction)
+    construction->stop();
 
   std::ostream &os = std::cout;
-  if (comm_rank == 0)
+  if (time_monitor && comm_rank == 0)
     os << "construction done\n";
 
-  if (perform_knn_search)
+  if (params.perform_knn_search)
   {
     Kokkos::View<int *, DeviceType> offsets("Benchmark::offsets", 0);
     Kokkos::View<ArborX::PairIndexRank *, DeviceType> values(
         "Benchmark::values", 0);
 
-    auto knn = time_monitor.getNewTimer("knn");
+    std::unique_ptr<TimeMonitor::Timer> knn;
+    if (time_monitor)
+      knn = time_monitor->getNewTimer("knn");
     MPI_Barrier(comm);
-    knn->start();
+    if (knn)
+      knn->start();
+    start = now();
     distributed_tree.query(
         ExecutionSpace{},
         NearestNeighborsSearches<DeviceType>{random_queries, n_neighbors},
         values, offsets);
-    knn->stop();
+    timings.knn = std::chrono::duration<double>(now() - start).count();
+    if (knn)
+      knn->stop();
 
-    if (comm_rank == 0)
+    if (time_monitor && comm_rank == 0)
       os << "knn done\n";
   }
 
-  if (perform_radius_search)
+  if (params.perform_radius_search)
   {
     // Radius is computed so that the number of results per query for a
     // uniformly distributed primitives in a [-a,a]^d box is approximately
@@ -479,18 +492,182 @@ int main_(std::vector<std::string> const &args, const MPI_Comm comm)
     Kokkos::View<ArborX::PairIndexRank *, DeviceType> values("Testing::values",
                                                              0);
 
-    auto radius = time_monitor.getNewTimer("radius");
+    std::unique_ptr<TimeMonitor::Timer> radius;
+    if (time_monitor)
+      radius = time_monitor->getNewTimer("radius");
     MPI_Barrier(comm);
-    radius->start();
+    if (radius)
+      radius->start();
+    start = now();
     distributed_tree.query(ExecutionSpace{},
                            RadiusSearches<DeviceType>{random_queries, r},
                            values, offsets);
-    radius->stop();
+    timings.radius = std::chrono::duration<double>(now() - start).count();
+    if (radius)
+      radius->stop();
 
-    if (comm_rank == 0)
+    if (time_monitor && comm_rank == 0)
       os << "radius done\n";
   }
-  time_monitor.summarize(comm);
+
+  MPI_Allreduce(MPI_IN_PLACE, &timings.construction, 1, MPI_DOUBLE, MPI_MAX,
+                comm);
+  MPI_Allreduce(MPI_IN_PLACE, &timings.knn, 1, MPI_DOUBLE, MPI_MAX, comm);
+  MPI_Allreduce(MPI_IN_PLACE, &timings.radius, 1, MPI_DOUBLE, MPI_MAX, comm);
+
+  return timings;
+}
+
+template <class NO>
+int main_(std::vector<std::string> const &args, const MPI_Comm comm)
+{
+  TimeMonitor time_monitor;
+
+  using DeviceType = typename NO::device_type;
+
+  int n_values;
+  int n_queries;
+  int n_neighbors;
+  double shift;
+  int partition_dim;
+  bool perform_knn_search = true;
+  bool perform_radius_search = true;
+  bool shift_queries = false;
+  double skew_exponent;
+  double hotspot_fraction;
+  std::string scaling_mode;
+
+  bpo::options_description desc("Allowed options");
+  // clang-format off
+    desc.add_options()
+        ( "help", "produce help message" )
+        ( "values", bpo::value<int>(&n_values)->default_value(20000), "Number of indexable values (source) per MPI rank." )
+        ( "queries", bpo::value<int>(&n_queries)->default_value(5000), "Number of queries (target) per MPI rank." )
+        ( "neighbors", bpo::value<int>(&n_neighbors)->default_value(10), "Desired number of results per query." )
+        ( "shift", bpo::value<double>(&shift)->default_value(1.), "Shift of the point clouds. '0' means the clouds are built "
+	                                                          "at the same place, while '1' places the clouds next to each"
+								  "other. Negative values and values larger than one "
+                                                                  "mean that the clouds are separated." )
+        ( "partition_dim", bpo::value<int>(&partition_dim)->default_value(3), "Number of dimension used by the partitioning of the global "
+                                                                              "point cloud. 1 -> local clouds are aligned on a line, 2 -> "
+                                                                              "local clouds form a board, 3 -> local clouds form a box." )
+        ( "do-not-perform-knn-search", "skip kNN search" )
+        ( "do-not-perform-radius-search", "skip radius search" )
+        ( "shift-queries" , "By default, points are reused for the queries. Enabling this option shrinks the local box queries are created "
+                            "in to a third of its size and moves it to the center of the global box. The result is a huge imbalance for the "
+                            "number of queries that need to be processed by each processor.")
+        ( "skew-exponent", bpo::value<double>(&skew_exponent)->default_value(0.), "Power-law exponent for the per-rank primitive counts: rank r holds "
+                                                                                 "a share proportional to (r+1)^-exponent, normalized so that the "
+                                                                                 "global count is unchanged. '0' keeps the counts balanced." )
+        ( "hotspot-fraction", bpo::value<double>(&hotspot_fraction)->default_value(0.), "Fraction of every rank's queries placed in the point cloud of "
+                                                                                       "rank 0, concentrating the forwarded traffic on one processor." )
+        ( "scaling", bpo::value<std::string>(&scaling_mode)->default_value(""), "Run a scaling sweep over sub-communicators of 1, 2, 4, ... ranks "
+                                                                                "instead of a single benchmark and print a CSV report. 'weak' keeps "
+                                                                                "the per-rank problem size fixed, 'strong' the global one." )
+        ;
+  // clang-format on
+  bpo::variables_map vm;
+  bpo::store(bpo::command_line_parser(args).options(desc).run(), vm);
+  bpo::notify(vm);
+
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+  int comm_size;
+  MPI_Comm_size(comm, &comm_size);
+
+  if (vm.count("help") > 0)
+  {
+    if (comm_rank == 0)
+      std::cout << desc << '\n';
+    throw HelpPrinted();
+  }
+
+  if (vm.count("do-not-perform-knn-search") > 0)
+    perform_knn_search = false;
+  if (vm.count("do-not-perform-radius-search") > 0)
+    perform_radius_search = false;
+  if (vm.count("shift-queries") > 0)
+    shift_queries = true;
+
+  if (!scaling_mode.empty() && scaling_mode != "weak" &&
+      scaling_mode != "strong")
+    throw std::runtime_error("scaling should be 'weak' or 'strong'");
+
+  if (comm_rank == 0)
+  {
+    std::cout << std::boolalpha;
+    std::cout << "\nRunning with arguments:\n"
+              << "perform knn search      : " << perform_knn_search << '\n'
+              << "perform radius search   : " << perform_radius_search << '\n'
+              << "#points/MPI process     : " << n_values << '\n'
+              << "#queries/MPI process    : " << n_queries << '\n'
+              << "size of shift           : " << shift << '\n'
+              << "dimension               : " << partition_dim << '\n'
+              << "shift-queries           : " << shift_queries << '\n'
+              << "skew exponent           : " << skew_exponent << '\n'
+              << "hotspot fraction        : " << hotspot_fraction << '\n'
+              << "scaling                 : "
+              << (scaling_mode.empty() ? "none" : scaling_mode) << '\n'
+              << '\n';
+  }
+
+  BenchmarkParams params{n_values,           n_queries,
+                         n_neighbors,        shift,
+                         partition_dim,      perform_knn_search,
+                         perform_radius_search,
+                         shift_queries,      skew_exponent,
+                         hotspot_fraction};
+
+  if (scaling_mode.empty())
+  {
+    run_benchmark<DeviceType>(comm, params, &time_monitor);
+    time_monitor.summarize(comm);
+
+    return 0;
+  }
+
+  // Scaling sweep: benchmark sub-communicators of 1, 2, 4, ... ranks (always
+  // including the full one). Weak scaling keeps the per-rank counts fixed,
+  // strong scaling the global ones, with the full communicator as reference.
+  std::vector<int> step_sizes;
+  for (int s = 1; s < comm_size; s *= 2)
+    step_sizes.push_back(s);
+  step_sizes.push_back(comm_size);
+
+  std::stringstream report;
+  report << "mode,ranks,values_per_rank,queries_per_rank,skew_exponent,"
+            "hotspot_fraction,construction,knn,radius\n";
+  for (int step_size : step_sizes)
+  {
+    auto step_params = params;
+    if (scaling_mode == "strong")
+    {
+      step_params.n_values =
+          std::max<long long>(1, (long long)n_values * comm_size / step_size);
+      step_params.n_queries =
+          std::max<long long>(1, (long long)n_queries * comm_size / step_size);
+    }
+
+    MPI_Comm step_comm;
+    MPI_Comm_split(comm, comm_rank < step_size ? 0 : MPI_UNDEFINED, comm_rank,
+                   &step_comm);
+    if (step_comm != MPI_COMM_NULL)
+    {
+      auto const timings =
+          run_benchmark<DeviceType>(step_comm, step_params, nullptr);
+      if (comm_rank == 0)
+        report << scaling_mode << ',' << step_size << ','
+               << step_params.n_values << ',' << step_params.n_queries << ','
+               << skew_exponent << ',' << hotspot_fraction << ','
+               << timings.construction << ',' << timings.knn << ','
+               << timings.radius << '\n';
+      MPI_Comm_free(&step_comm);
+    }
+    // Keep the idle ranks out of the way while the sub-communicator runs
+    MPI_Barrier(comm);
+  }
+  if (comm_rank == 0)
+    std::cout << report.str();
 
   return 0;
 }
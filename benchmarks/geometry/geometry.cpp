@@ -0,0 +1,339 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <ArborX_Box.hpp>
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtVersion.hpp>
+#include <ArborX_KDOP.hpp>
+#include <ArborX_Point.hpp>
+#include <ArborX_Ray.hpp>
+#include <ArborX_Sphere.hpp>
+#include <ArborX_Version.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Random.hpp>
+
+#include <chrono>
+#include <iostream>
+
+#include <benchmark/benchmark.h>
+
+// Microbenchmarks for the geometry primitive kernels that every traversal is
+// made of. Each benchmark streams over independent pairs of geometries and
+// folds the kernel results into a reduction so that the compiler cannot
+// discard the computation. The reported "rate" counter is kernel evaluations
+// per second, which is what to gate on.
+
+template <typename ExecutionSpace>
+auto makeRandomPoints(ExecutionSpace const &exec_space, int n)
+{
+  using MemorySpace = typename ExecutionSpace::memory_space;
+  Kokkos::View<ArborX::Point *, MemorySpace> points(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "Benchmark::points"),
+      n);
+  Kokkos::Random_XorShift1024_Pool<ExecutionSpace> rand_pool(1984);
+  Kokkos::parallel_for(
+      "Benchmark::init_points",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        auto rand_gen = rand_pool.get_state();
+        points(i) = {rand_gen.frand(100.f), rand_gen.frand(100.f),
+                     rand_gen.frand(100.f)};
+        rand_pool.free_state(rand_gen);
+      });
+  return points;
+}
+
+template <typename ExecutionSpace>
+auto makeRandomBoxes(ExecutionSpace const &exec_space, int n)
+{
+  using MemorySpace = typename ExecutionSpace::memory_space;
+  Kokkos::View<ArborX::Box *, MemorySpace> boxes(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "Benchmark::boxes"),
+      n);
+  Kokkos::Random_XorShift1024_Pool<ExecutionSpace> rand_pool(1984);
+  Kokkos::parallel_for(
+      "Benchmark::init_boxes",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        auto rand_gen = rand_pool.get_state();
+        ArborX::Point const center{rand_gen.frand(100.f),
+                                   rand_gen.frand(100.f),
+                                   rand_gen.frand(100.f)};
+        float const half_extent = 0.1f + rand_gen.frand(2.f);
+        boxes(i) = {{center[0] - half_extent, center[1] - half_extent,
+                     center[2] - half_extent},
+                    {center[0] + half_extent, center[1] + half_extent,
+                     center[2] + half_extent}};
+        rand_pool.free_state(rand_gen);
+      });
+  return boxes;
+}
+
+// Time a device kernel with a fence on each side, the same way the other
+// Google-Benchmark drivers do it.
+template <typename ExecutionSpace, typename Kernel>
+void timeKernel(benchmark::State &state, ExecutionSpace const &exec_space,
+                int n, Kernel const &kernel)
+{
+  for (auto _ : state)
+  {
+    exec_space.fence();
+    auto const start = std::chrono::high_resolution_clock::now();
+
+    kernel();
+
+    exec_space.fence();
+    auto const end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed_seconds = end - start;
+    state.SetIterationTime(elapsed_seconds.count());
+  }
+  state.counters["rate"] =
+      benchmark::Counter(n, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void BM_distance_point_point(benchmark::State &state)
+{
+  using ExecutionSpace = Kokkos::DefaultExecutionSpace;
+  ExecutionSpace exec_space;
+
+  int const n = state.range(0);
+  auto points = makeRandomPoints(exec_space, 2 * n);
+
+  timeKernel(state, exec_space, n, [&]() {
+    float sum;
+    Kokkos::parallel_reduce(
+        "Benchmark::distance_point_point",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+        KOKKOS_LAMBDA(int i, float &update) {
+          update += ArborX::Details::distance(points(i), points(i + n));
+        },
+        sum);
+    benchmark::DoNotOptimize(sum);
+  });
+}
+
+void BM_distance_point_box(benchmark::State &state)
+{
+  using ExecutionSpace = Kokkos::DefaultExecutionSpace;
+  ExecutionSpace exec_space;
+
+  int const n = state.range(0);
+  auto points = makeRandomPoints(exec_space, n);
+  auto boxes = makeRandomBoxes(exec_space, n);
+
+  timeKernel(state, exec_space, n, [&]() {
+    float sum;
+    Kokkos::parallel_reduce(
+        "Benchmark::distance_point_box",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+        KOKKOS_LAMBDA(int i, float &update) {
+          update += ArborX::Details::distance(points(i), boxes(i));
+        },
+        sum);
+    benchmark::DoNotOptimize(sum);
+  });
+}
+
+void BM_distance_box_box(benchmark::State &state)
+{
+  using ExecutionSpace = Kokkos::DefaultExecutionSpace;
+  ExecutionSpace exec_space;
+
+  int const n = state.range(0);
+  auto boxes = makeRandomBoxes(exec_space, 2 * n);
+
+  timeKernel(state, exec_space, n, [&]() {
+    float sum;
+    Kokkos::parallel_reduce(
+        "Benchmark::distance_box_box",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+        KOKKOS_LAMBDA(int i, float &update) {
+          update += ArborX::Details::distance(boxes(i), boxes(i + n));
+        },
+        sum);
+    benchmark::DoNotOptimize(sum);
+  });
+}
+
+void BM_intersects_box_box(benchmark::State &state)
+{
+  using ExecutionSpace = Kokkos::DefaultExecutionSpace;
+  ExecutionSpace exec_space;
+
+  int const n = state.range(0);
+  auto boxes = makeRandomBoxes(exec_space, 2 * n);
+
+  timeKernel(state, exec_space, n, [&]() {
+    int count;
+    Kokkos::parallel_reduce(
+        "Benchmark::intersects_box_box",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+        KOKKOS_LAMBDA(int i, int &update) {
+          update += ArborX::Details::intersects(boxes(i), boxes(i + n));
+        },
+        count);
+    benchmark::DoNotOptimize(count);
+  });
+}
+
+void BM_intersects_sphere_box(benchmark::State &state)
+{
+  using ExecutionSpace = Kokkos::DefaultExecutionSpace;
+  ExecutionSpace exec_space;
+
+  int const n = state.range(0);
+  auto points = makeRandomPoints(exec_space, n);
+  auto boxes = makeRandomBoxes(exec_space, n);
+
+  timeKernel(state, exec_space, n, [&]() {
+    int count;
+    Kokkos::parallel_reduce(
+        "Benchmark::intersects_sphere_box",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+        KOKKOS_LAMBDA(int i, int &update) {
+          update += ArborX::Details::intersects(
+              ArborX::Sphere{points(i), 5.f}, boxes(i));
+        },
+        count);
+    benchmark::DoNotOptimize(count);
+  });
+}
+
+void BM_expand_box(benchmark::State &state)
+{
+  using ExecutionSpace = Kokkos::DefaultExecutionSpace;
+  ExecutionSpace exec_space;
+
+  int const n = state.range(0);
+  auto points = makeRandomPoints(exec_space, n);
+  auto boxes = makeRandomBoxes(exec_space, n);
+
+  timeKernel(state, exec_space, n, [&]() {
+    float sum;
+    Kokkos::parallel_reduce(
+        "Benchmark::expand_box",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+        KOKKOS_LAMBDA(int i, float &update) {
+          ArborX::Box box;
+          ArborX::Details::expand(box, boxes(i));
+          ArborX::Details::expand(box, points(i));
+          update += box.minCorner()[0] + box.maxCorner()[2];
+        },
+        sum);
+    benchmark::DoNotOptimize(sum);
+  });
+}
+
+// Slab test on the ray layout the traversals use (origin + normalized
+// direction, no precomputed inverse). Half the rays point at their box, half
+// away from it, so both the hit and the early-out paths are exercised.
+void BM_intersects_ray_box(benchmark::State &state)
+{
+  using ExecutionSpace = Kokkos::DefaultExecutionSpace;
+  using MemorySpace = ExecutionSpace::memory_space;
+  ExecutionSpace exec_space;
+
+  int const n = state.range(0);
+  auto points = makeRandomPoints(exec_space, n);
+  auto boxes = makeRandomBoxes(exec_space, n);
+
+  Kokkos::View<ArborX::Experimental::Ray *, MemorySpace> rays(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "Benchmark::rays"),
+      n);
+  Kokkos::parallel_for(
+      "Benchmark::init_rays",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        auto const centroid = ArborX::Details::returnCentroid(boxes(i));
+        float const sign = (i % 2 ? 1.f : -1.f);
+        rays(i) = ArborX::Experimental::Ray{
+            points(i),
+            {sign * (centroid[0] - points(i)[0]),
+             sign * (centroid[1] - points(i)[1]),
+             sign * (centroid[2] - points(i)[2])}};
+      });
+
+  timeKernel(state, exec_space, n, [&]() {
+    int count;
+    Kokkos::parallel_reduce(
+        "Benchmark::intersects_ray_box",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+        KOKKOS_LAMBDA(int i, int &update) {
+          update += ArborX::Experimental::intersects(rays(i), boxes(i));
+        },
+        count);
+    benchmark::DoNotOptimize(count);
+  });
+}
+
+template <int k>
+void BM_kdop(benchmark::State &state)
+{
+  using ExecutionSpace = Kokkos::DefaultExecutionSpace;
+  ExecutionSpace exec_space;
+
+  int const n = state.range(0);
+  auto points = makeRandomPoints(exec_space, n);
+  auto boxes = makeRandomBoxes(exec_space, 2 * n);
+
+  timeKernel(state, exec_space, n, [&]() {
+    int count;
+    Kokkos::parallel_reduce(
+        "Benchmark::kdop",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+        KOKKOS_LAMBDA(int i, int &update) {
+          ArborX::Experimental::KDOP<k> kdop;
+          expand(kdop, boxes(i));
+          expand(kdop, points(i));
+          update += kdop.intersects(boxes(i + n));
+        },
+        count);
+    benchmark::DoNotOptimize(count);
+  });
+}
+
+int main(int argc, char *argv[])
+{
+  Kokkos::ScopeGuard guard(argc, argv);
+
+  std::cout << "ArborX version    : " << ArborX::version() << std::endl;
+  std::cout << "ArborX hash       : " << ArborX::gitCommitHash() << std::endl;
+  std::cout << "Kokkos version    : " << ArborX::Details::KokkosExt::version()
+            << std::endl;
+
+  benchmark::Initialize(&argc, argv);
+
+  auto const register_benchmark = [](auto *b) {
+    b->RangeMultiplier(10)
+        ->Range(100000, 1000000)
+        ->UseManualTime()
+        ->Unit(benchmark::kMicrosecond);
+  };
+  register_benchmark(BENCHMARK(BM_distance_point_point));
+  register_benchmark(BENCHMARK(BM_distance_point_box));
+  register_benchmark(BENCHMARK(BM_distance_box_box));
+  register_benchmark(BENCHMARK(BM_intersects_box_box));
+  register_benchmark(BENCHMARK(BM_intersects_sphere_box));
+  register_benchmark(BENCHMARK(BM_expand_box));
+  register_benchmark(BENCHMARK(BM_intersects_ray_box));
+  register_benchmark(BENCHMARK_TEMPLATE1(BM_kdop, 6));
+  register_benchmark(BENCHMARK_TEMPLATE1(BM_kdop, 14));
+  register_benchmark(BENCHMARK_TEMPLATE1(BM_kdop, 18));
+  register_benchmark(BENCHMARK_TEMPLATE1(BM_kdop, 26));
+
+  benchmark::RunSpecifiedBenchmarks();
+
+  return EXIT_SUCCESS;
+}
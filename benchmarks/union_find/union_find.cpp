@@ -101,8 +101,13 @@ buildEdges(DisallowLoops, ExecutionSpace const &exec_space, int num_edges)
   return edges;
 }
 
+struct Default
+{};
+struct Scattered
+{};
+
 template <typename ExecutionSpace>
-auto buildUnionFind(ExecutionSpace const &exec_space, int n)
+auto buildUnionFind(Default, ExecutionSpace const &exec_space, int n)
 {
   using MemorySpace = typename ExecutionSpace::memory_space;
 
@@ -117,7 +122,14 @@ auto buildUnionFind(ExecutionSpace const &exec_space, int n)
     return ArborX::Details::UnionFind<MemorySpace, /*DoSerial*/ false>(labels);
 }
 
-template <typename Tag>
+template <typename ExecutionSpace>
+auto buildUnionFind(Scattered, ExecutionSpace const &exec_space, int n)
+{
+  using MemorySpace = typename ExecutionSpace::memory_space;
+  return ArborX::Details::ScatteredUnionFind<MemorySpace>(exec_space, n);
+}
+
+template <typename Tag, typename Variant>
 void BM_union_find(benchmark::State &state)
 {
   using ExecutionSpace = Kokkos::DefaultExecutionSpace;
@@ -128,7 +140,7 @@ void BM_union_find(benchmark::State &state)
   auto const n = num_edges + 1;
 
   auto edges = buildEdges(Tag{}, exec_space, num_edges);
-  auto union_find = buildUnionFind(exec_space, n);
+  auto union_find = buildUnionFind(Variant{}, exec_space, n);
 
   for (auto _ : state)
   {
@@ -165,12 +177,22 @@ int main(int argc, char *argv[])
 
   benchmark::Initialize(&argc, argv);
 
-  BENCHMARK_TEMPLATE1(BM_union_find, AllowLoops)
+  BENCHMARK_TEMPLATE2(BM_union_find, AllowLoops, Default)
+      ->RangeMultiplier(10)
+      ->Range(10000, 100000)
+      ->UseManualTime()
+      ->Unit(benchmark::kMicrosecond);
+  BENCHMARK_TEMPLATE2(BM_union_find, DisallowLoops, Default)
+      ->RangeMultiplier(10)
+      ->Range(10000, 100000)
+      ->UseManualTime()
+      ->Unit(benchmark::kMicrosecond);
+  BENCHMARK_TEMPLATE2(BM_union_find, AllowLoops, Scattered)
       ->RangeMultiplier(10)
       ->Range(10000, 100000)
       ->UseManualTime()
       ->Unit(benchmark::kMicrosecond);
-  BENCHMARK_TEMPLATE1(BM_union_find, DisallowLoops)
+  BENCHMARK_TEMPLATE2(BM_union_find, DisallowLoops, Scattered)
       ->RangeMultiplier(10)
       ->Range(10000, 100000)
       ->UseManualTime()
@@ -0,0 +1,131 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_AUTO_INDEX_HPP
+#define ARBORX_AUTO_INDEX_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_BruteForce.hpp>
+#include <ArborX_DetailsLegacy.hpp>
+#include <ArborX_LinearBVH.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Runtime dispatcher between BruteForce and BoundingVolumeHierarchy behind
+// the common query interface. Brute force wins below a certain number of
+// primitives (the tree build cost dominates, and small trees do not prune
+// enough to pay for the traversal overhead) and in high dimensions (boxes
+// overlap so heavily that the traversal degenerates to a linear scan with
+// extra bookkeeping); the crossover depends on the backend. Applications
+// whose problem sizes straddle the boundary can use this class instead of
+// hardcoding one structure.
+template <
+    typename MemorySpace, typename Value = Details::LegacyDefaultTemplateValue,
+    typename IndexableGetter = Details::DefaultIndexableGetter,
+    typename BoundingVolume = ExperimentalHyperGeometry::Box<
+        GeometryTraits::dimension_v<
+            std::decay_t<std::invoke_result_t<IndexableGetter, Value>>>,
+        typename GeometryTraits::coordinate_type<
+            std::decay_t<std::invoke_result_t<IndexableGetter, Value>>>::type>>
+class AutoIndex
+{
+  using BVH =
+      BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
+                              BoundingVolume>;
+  using BF = BruteForce<MemorySpace, Value, IndexableGetter, BoundingVolume>;
+
+public:
+  using memory_space = MemorySpace;
+  static_assert(Kokkos::is_memory_space<MemorySpace>::value);
+  using size_type = typename MemorySpace::size_type;
+  using bounding_volume_type = typename BVH::bounding_volume_type;
+  using value_type = typename BVH::value_type;
+
+  AutoIndex() = default;
+
+  template <typename ExecutionSpace, typename Values>
+  AutoIndex(ExecutionSpace const &space, Values const &values,
+            IndexableGetter const &indexable_getter = IndexableGetter())
+  {
+    auto const n = AccessTraits<Values, PrimitivesTag>::size(values);
+    constexpr int dim = GeometryTraits::dimension_v<bounding_volume_type>;
+
+    _use_brute_force = useBruteForce(space, n, dim);
+    if constexpr (std::is_same_v<Value, Details::LegacyDefaultTemplateValue>)
+    {
+      if (_use_brute_force)
+        _brute_force = BF(space, values);
+      else
+        _bvh = BVH(space, values);
+    }
+    else
+    {
+      if (_use_brute_force)
+        _brute_force = BF(space, values, indexable_getter);
+      else
+        _bvh = BVH(space, values, indexable_getter);
+    }
+  }
+
+  KOKKOS_FUNCTION
+  size_type size() const noexcept
+  {
+    return _use_brute_force ? _brute_force.size() : _bvh.size();
+  }
+
+  KOKKOS_FUNCTION
+  bool empty() const noexcept { return size() == 0; }
+
+  KOKKOS_FUNCTION
+  bounding_volume_type bounds() const noexcept
+  {
+    return _use_brute_force ? _brute_force.bounds() : _bvh.bounds();
+  }
+
+  // Which structure the constructor picked (mostly for diagnostics)
+  bool usesBruteForce() const noexcept { return _use_brute_force; }
+
+  template <typename ExecutionSpace, typename Predicates, typename... Args>
+  void query(ExecutionSpace const &space, Predicates const &predicates,
+             Args &&...args) const
+  {
+    if (_use_brute_force)
+      _brute_force.query(space, predicates, std::forward<Args>(args)...);
+    else
+      _bvh.query(space, predicates, std::forward<Args>(args)...);
+  }
+
+private:
+  // The crossover estimate. The dimension cutoff matches where the
+  // brute_force_vs_bvh benchmark stops showing any benefit from the tree;
+  // the size threshold is higher on massively parallel backends, which
+  // amortize the quadratic scan over many more threads than the tree build
+  // can occupy at these sizes.
+  template <typename ExecutionSpace>
+  static bool useBruteForce(ExecutionSpace const &space, size_type n, int dim)
+  {
+    if (dim > 6)
+      return true;
+    size_type const threshold = (space.concurrency() > 1024 ? 16384 : 4096);
+    return n <= threshold;
+  }
+
+  bool _use_brute_force = false;
+  BVH _bvh;
+  BF _brute_force;
+};
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -33,8 +33,9 @@ template <
     typename BoundingVolume = ExperimentalHyperGeometry::Box<
         GeometryTraits::dimension_v<
             std::decay_t<std::invoke_result_t<IndexableGetter, Value>>>,
-        typename GeometryTraits::coordinate_type<
-            std::decay_t<std::invoke_result_t<IndexableGetter, Value>>>::type>>
+        GeometryTraits::compute_coordinate_t<
+            typename GeometryTraits::coordinate_type<std::decay_t<
+                std::invoke_result_t<IndexableGetter, Value>>>::type>>
 class BruteForce
 {
 public:
@@ -50,6 +51,12 @@ public:
   BruteForce(ExecutionSpace const &space, Values const &values,
              IndexableGetter const &indexable_getter = IndexableGetter());
 
+  // Add values to the index without reconstructing it. The values view grows
+  // geometrically, making repeated appends an amortized-constant copy per
+  // value.
+  template <typename ExecutionSpace, typename Values>
+  void append(ExecutionSpace const &space, Values const &values);
+
   KOKKOS_FUNCTION
   size_type size() const noexcept { return _size; }
 
@@ -88,6 +95,8 @@ public:
 private:
   size_type _size{0};
   bounding_volume_type _bounds;
+  // May carry spare capacity past _size after append(); only the first _size
+  // entries are valid
   Kokkos::View<value_type *, memory_space> _values;
   IndexableGetter _indexable_getter;
 };
@@ -118,6 +127,15 @@ public:
             Details::DefaultIndexableGetter())
   {}
 
+  template <typename ExecutionSpace, typename Primitives>
+  void append(ExecutionSpace const &space, Primitives const &primitives)
+  {
+    Details::check_valid_access_traits(PrimitivesTag{}, primitives);
+    base_type::append(space,
+                      Details::LegacyValues<Primitives, bounding_volume_type>{
+                          primitives});
+  }
+
   template <typename ExecutionSpace, typename Predicates, typename Callback,
             typename Ignore = int>
   void query(ExecutionSpace const &space, Predicates const &predicates,
@@ -208,6 +226,62 @@ BruteForce<MemorySpace, Value, IndexableGetter, BoundingVolume>::BruteForce(
       space, values, _indexable_getter, _values, _bounds);
 }
 
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume>
+template <typename ExecutionSpace, typename UserValues>
+void BruteForce<MemorySpace, Value, IndexableGetter, BoundingVolume>::append(
+    ExecutionSpace const &space, UserValues const &user_values)
+{
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+  Details::check_valid_access_traits<UserValues>(
+      PrimitivesTag{}, user_values, Details::DoNotCheckGetReturnType());
+
+  using Values = Details::AccessValues<UserValues, PrimitivesTag>;
+  Values values{user_values};
+
+  static_assert(
+      Details::KokkosExt::is_accessible_from<typename Values::memory_space,
+                                             ExecutionSpace>::value,
+      "Values must be accessible from the execution space");
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::BruteForce::append");
+
+  size_type const n_new = values.size();
+  if (n_new == 0)
+  {
+    return;
+  }
+
+  size_type const new_size = _size + n_new;
+  if (new_size > _values.extent(0))
+  {
+    // Doubling the capacity keeps the copy cost of repeated appends amortized
+    // constant per value
+    auto const capacity =
+        Kokkos::max(new_size, (size_type)(2 * _values.extent(0)));
+    Kokkos::View<value_type *, memory_space> values_with_capacity(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::BruteForce::values"),
+        capacity);
+    Kokkos::deep_copy(space,
+                      Kokkos::subview(values_with_capacity,
+                                      Kokkos::make_pair(size_type(0), _size)),
+                      Kokkos::subview(_values,
+                                      Kokkos::make_pair(size_type(0), _size)));
+    _values = values_with_capacity;
+  }
+
+  // There is no structure to maintain: the new values go behind the existing
+  // ones, and only the scene bounds need updating
+  BoundingVolume new_bounds{};
+  Details::BruteForceImpl::initializeBoundingVolumesAndReduceBoundsOfTheScene(
+      space, values, _indexable_getter,
+      Kokkos::subview(_values, Kokkos::make_pair(_size, new_size)), new_bounds);
+  _bounds += new_bounds;
+  _size = new_size;
+}
+
 template <typename MemorySpace, typename Value, typename IndexableGetter,
           typename BoundingVolume>
 template <typename ExecutionSpace, typename UserPredicates, typename Callback,
@@ -230,18 +304,32 @@ void BruteForce<MemorySpace, Value, IndexableGetter, BoundingVolume>::query(
   Predicates predicates{user_predicates};
 
   using Tag = typename Predicates::value_type::Tag;
-  static_assert(std::is_same<Tag, Details::SpatialPredicateTag>{},
-                "nearest query not implemented yet");
 
-  Kokkos::Profiling::pushRegion("ArborX::BruteForce::query::spatial");
+  // Restrict to the first _size entries as the view may carry spare capacity
+  // left behind by append()
+  auto values =
+      Kokkos::subview(_values, Kokkos::make_pair(size_type(0), _size));
 
-  Details::BruteForceImpl::query(
-      space, predicates, _values,
-      Details::Indexables<decltype(_values), IndexableGetter>{
-          _values, _indexable_getter},
-      callback);
+  if constexpr (std::is_same_v<Tag, Details::SpatialPredicateTag>)
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::BruteForce::query::spatial");
 
-  Kokkos::Profiling::popRegion();
+    Details::BruteForceImpl::query(
+        space, predicates, values,
+        Details::Indexables<decltype(values), IndexableGetter>{
+            values, _indexable_getter},
+        callback);
+  }
+  else
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::BruteForce::query::nearest");
+
+    Details::BruteForceImpl::queryNearest(
+        space, predicates, values,
+        Details::Indexables<decltype(values), IndexableGetter>{
+            values, _indexable_getter},
+        callback);
+  }
 }
 
 } // namespace ArborX
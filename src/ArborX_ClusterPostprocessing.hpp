@@ -0,0 +1,136 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_CLUSTER_POSTPROCESSING_HPP
+#define ARBORX_CLUSTER_POSTPROCESSING_HPP
+
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_Exception.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Turn the labels produced by dbscan() (or any labeling where negative
+// values denote noise) into a compressed cluster representation:
+// cluster_indices lists the member points of each cluster consecutively,
+// with cluster c occupying [cluster_offset(c), cluster_offset(c + 1)).
+// Noise points and clusters smaller than cluster_min_size are dropped, and
+// the surviving clusters are renumbered 0..k-1 in the order of their
+// original labels.
+template <typename ExecutionSpace, typename LabelsView,
+          typename ClusterIndicesView, typename ClusterOffsetView>
+void sortAndFilterClusters(ExecutionSpace const &exec_space,
+                           LabelsView const &labels,
+                           ClusterIndicesView &cluster_indices,
+                           ClusterOffsetView &cluster_offset,
+                           int cluster_min_size = 1)
+{
+  Kokkos::Profiling::pushRegion("ArborX::DBSCAN::sortAndFilterClusters");
+
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+
+  static_assert(Kokkos::is_view<LabelsView>{});
+  static_assert(Kokkos::is_view<ClusterIndicesView>{});
+  static_assert(Kokkos::is_view<ClusterOffsetView>{});
+
+  using MemorySpace = typename LabelsView::memory_space;
+
+  static_assert(std::is_same<typename LabelsView::value_type, int>{});
+  static_assert(std::is_same<typename ClusterIndicesView::value_type, int>{});
+  static_assert(std::is_same<typename ClusterOffsetView::value_type, int>{});
+
+  static_assert(
+      std::is_same<typename ClusterIndicesView::memory_space, MemorySpace>{});
+  static_assert(
+      std::is_same<typename ClusterOffsetView::memory_space, MemorySpace>{});
+
+  ARBORX_ASSERT(cluster_min_size >= 1);
+
+  int const n = labels.extent_int(0);
+
+  Kokkos::View<int *, MemorySpace> cluster_sizes(
+      "ArborX::DBSCAN::cluster_sizes", n);
+  Kokkos::parallel_for(
+      "ArborX::DBSCAN::compute_cluster_sizes",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int const i) {
+        // Ignore noise points
+        if (labels(i) < 0)
+          return;
+
+        Kokkos::atomic_increment(&cluster_sizes(labels(i)));
+      });
+
+  // This kernel serves dual purpose:
+  // - it constructs an offset array through exclusive prefix sum, with a
+  //   caveat that small clusters (of size < cluster_min_size) are filtered out
+  // - it creates a mapping from a cluster index into the cluster's position in
+  //   the offset array
+  // We reuse the cluster_sizes array for the second, creating a new alias for
+  // it for clarity.
+  auto &map_cluster_to_offset_position = cluster_sizes;
+  constexpr int IGNORED_CLUSTER = -1;
+  int num_clusters;
+  KokkosExt::reallocWithoutInitializing(exec_space, cluster_offset, n + 1);
+  Kokkos::parallel_scan(
+      "ArborX::DBSCAN::compute_cluster_offset_with_filter",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int const i, int &update, bool final_pass) {
+        bool is_cluster_too_small = (cluster_sizes(i) < cluster_min_size);
+        if (!is_cluster_too_small)
+        {
+          if (final_pass)
+          {
+            cluster_offset(update) = cluster_sizes(i);
+            map_cluster_to_offset_position(i) = update;
+          }
+          ++update;
+        }
+        else
+        {
+          if (final_pass)
+            map_cluster_to_offset_position(i) = IGNORED_CLUSTER;
+        }
+      },
+      num_clusters);
+  Kokkos::resize(Kokkos::WithoutInitializing, cluster_offset, num_clusters + 1);
+  KokkosExt::exclusive_scan(exec_space, cluster_offset, cluster_offset, 0);
+
+  auto cluster_starts = KokkosExt::clone(exec_space, cluster_offset);
+  KokkosExt::reallocWithoutInitializing(
+      exec_space, cluster_indices,
+      KokkosExt::lastElement(exec_space, cluster_offset));
+  Kokkos::parallel_for(
+      "ArborX::DBSCAN::compute_cluster_indices",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int const i) {
+        // Ignore noise points
+        if (labels(i) < 0)
+          return;
+
+        auto offset_pos = map_cluster_to_offset_position(labels(i));
+        if (offset_pos != IGNORED_CLUSTER)
+        {
+          auto position =
+              Kokkos::atomic_fetch_add(&cluster_starts(offset_pos), 1);
+          cluster_indices(position) = i;
+        }
+      });
+
+  Kokkos::Profiling::popRegion();
+}
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -19,13 +19,17 @@
 #include <ArborX_DetailsHalfTraversal.hpp>
 #include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp> // reallocWithoutInitializing
 #include <ArborX_DetailsSortUtils.hpp>
 #include <ArborX_DetailsUtils.hpp> // sortObjects
 #include <ArborX_HyperBox.hpp>
 #include <ArborX_HyperSphere.hpp>
 #include <ArborX_LinearBVH.hpp>
+#include <ArborX_PeriodicSphere.hpp>
 #include <ArborX_Sphere.hpp>
 
+#include <algorithm> // min
+
 namespace ArborX
 {
 
@@ -52,6 +56,20 @@ struct DBSCANCorePoints
   }
 };
 
+// Core-point test for the weighted variant: a point is core when the
+// accumulated weight of its neighborhood reaches the threshold
+template <typename MemorySpace>
+struct DBSCANWeightedCorePoints
+{
+  Kokkos::View<float *, MemorySpace> _weight_sums;
+  float _core_min_weight;
+
+  KOKKOS_FUNCTION bool operator()(int const i) const
+  {
+    return _weight_sums(i) >= _core_min_weight;
+  }
+};
+
 template <typename Primitives>
 struct PrimitivesWithRadius
 {
@@ -76,6 +94,34 @@ struct WithinRadiusGetter
   }
 };
 
+template <typename Primitives, int DIM, typename Coordinate>
+struct PrimitivesWithRadiusPeriodic
+{
+  Primitives _primitives;
+  float _r;
+  Experimental::PeriodicDomain<DIM, Coordinate> _domain;
+};
+
+template <int DIM, typename Coordinate>
+struct WithinRadiusPeriodicGetter
+{
+  float _r;
+  Experimental::PeriodicDomain<DIM, Coordinate> _domain;
+
+  template <typename Point>
+  KOKKOS_FUNCTION auto operator()(Point const &point) const
+  {
+    static_assert(GeometryTraits::is_point<Point>::value);
+    static_assert(GeometryTraits::dimension_v<Point> == DIM);
+
+    auto const &hyper_point = reinterpret_cast<
+        ExperimentalHyperGeometry::Point<DIM, Coordinate> const &>(point);
+    using ArborX::intersects;
+    return intersects(Experimental::PeriodicSphere<DIM, Coordinate>{
+        hyper_point, _r, _domain});
+  }
+};
+
 template <typename Primitives, typename PermuteFilter>
 struct PrimitivesWithRadiusReorderedAndFiltered
 {
@@ -125,6 +171,34 @@ struct AccessTraits<Details::PrimitivesWithRadius<Primitives>, PredicatesTag>
   }
 };
 
+template <typename Primitives, int DIM, typename Coordinate>
+struct AccessTraits<
+    Details::PrimitivesWithRadiusPeriodic<Primitives, DIM, Coordinate>,
+    PredicatesTag>
+{
+  using memory_space = typename Primitives::memory_space;
+  using Predicates =
+      Details::PrimitivesWithRadiusPeriodic<Primitives, DIM, Coordinate>;
+
+  static KOKKOS_FUNCTION size_t size(Predicates const &w)
+  {
+    return w._primitives.size();
+  }
+  static KOKKOS_FUNCTION auto get(Predicates const &w, size_t i)
+  {
+    auto const &point = w._primitives(i);
+    static_assert(GeometryTraits::dimension_v<std::decay_t<decltype(point)>> ==
+                  DIM);
+    // FIXME reinterpret_cast is dangerous here if access traits return user
+    // point structure (e.g., struct MyPoint { float y; float x; })
+    auto const &hyper_point = reinterpret_cast<
+        ExperimentalHyperGeometry::Point<DIM, Coordinate> const &>(point);
+    return attach(intersects(Experimental::PeriodicSphere<DIM, Coordinate>{
+                      hyper_point, w._r, w._domain}),
+                  (int)i);
+  }
+};
+
 template <typename Primitives, typename PermuteFilter>
 struct AccessTraits<Details::PrimitivesWithRadiusReorderedAndFiltered<
                         Primitives, PermuteFilter>,
@@ -204,13 +278,201 @@ struct AccessTraits<
   using memory_space = typename MixedOffsets::memory_space;
 };
 
+namespace Details
+{
+
+// FDBSCAN core determination and cluster traversals over an already built
+// tree, shared between the open and the periodic dbscan() overloads. The
+// distance semantics are fully determined by the predicates (used by the
+// counting pass) and the predicate getter (used by the half-traversals).
+//
+// NOTE: pushes the "clusters" profiling region but leaves closing it to the
+// caller, which finalizes the labels within the same region.
+template <typename UnionFind, typename ExecutionSpace, typename BVH,
+          typename MemorySpace, typename Predicates, typename PredicateGetter>
+void fdbscanComputeClusters(ExecutionSpace const &exec_space, BVH const &bvh,
+                            Kokkos::View<int *, MemorySpace> const &labels,
+                            Kokkos::View<int *, MemorySpace> &num_neigh,
+                            int core_min_size, Predicates const &predicates,
+                            PredicateGetter const &within_radius)
+{
+  int const n = labels.size();
+
+  Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters");
+  if (core_min_size == 2)
+  {
+    // Perform the queries and build clusters through callback
+    using CorePoints = Details::CCSCorePoints;
+#if defined(KOKKOS_COMPILER_NVCC) && (KOKKOS_COMPILER_NVCC < 1140)
+    // Workaround a compiler bug
+    using HalfTraversal =
+        Details::HalfTraversal<BVH,
+                               Details::FDBSCANCallback<UnionFind, CorePoints>,
+                               PredicateGetter>;
+#else
+    using Details::HalfTraversal;
+#endif
+    Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters::query");
+    HalfTraversal(
+        exec_space, bvh,
+        Details::FDBSCANCallback<UnionFind, CorePoints>{labels, CorePoints{}},
+        within_radius);
+    Kokkos::Profiling::popRegion();
+  }
+  else if (core_min_size <= 16)
+  {
+    // Fused formulation: core status and connectivity are determined in a
+    // single walk of the tree instead of a counting pass followed by a
+    // cluster pass. The price is a bounded per-point neighbor buffer,
+    // which is why larger core_min_size falls through to the two-pass
+    // version.
+    Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters::query");
+    Kokkos::resize(Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing),
+                   num_neigh, n);
+    Kokkos::deep_copy(exec_space, num_neigh,
+                      1); // a point is its own neighbor
+    Kokkos::View<int *, MemorySpace> neigh_buffer(
+        Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                           "ArborX::DBSCAN::neigh_buffer"),
+        n * (long long)(core_min_size - 2));
+
+#if defined(KOKKOS_COMPILER_NVCC) && (KOKKOS_COMPILER_NVCC < 1140)
+    // Workaround a compiler bug
+    using HalfTraversal = Details::HalfTraversal<
+        BVH, Details::FDBSCANFusedCallback<UnionFind, MemorySpace>,
+        PredicateGetter>;
+#else
+    using Details::HalfTraversal;
+#endif
+    HalfTraversal(exec_space, bvh,
+                  Details::FDBSCANFusedCallback<UnionFind, MemorySpace>{
+                      labels, num_neigh, neigh_buffer, core_min_size},
+                  within_radius);
+
+    Kokkos::parallel_for(
+        "ArborX::DBSCAN::clusters::finalize_fused",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+        Details::FDBSCANFusedFinalize<UnionFind, MemorySpace>{
+            labels, num_neigh, neigh_buffer, core_min_size});
+    Kokkos::Profiling::popRegion();
+  }
+  else
+  {
+    // Determine core points
+    Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters::num_neigh");
+    Kokkos::resize(Kokkos::view_alloc(exec_space), num_neigh, n);
+    bvh.query(exec_space, predicates,
+              Details::CountUpToN<MemorySpace>{num_neigh, core_min_size});
+    Kokkos::Profiling::popRegion();
+
+    using CorePoints = Details::DBSCANCorePoints<MemorySpace>;
+#if defined(KOKKOS_COMPILER_NVCC) && (KOKKOS_COMPILER_NVCC < 1140)
+    // Workaround a compiler bug
+    using HalfTraversal =
+        Details::HalfTraversal<BVH,
+                               Details::FDBSCANCallback<UnionFind, CorePoints>,
+                               PredicateGetter>;
+#else
+    using Details::HalfTraversal;
+#endif
+
+    // Perform the queries and build clusters through callback
+    Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters::query");
+    HalfTraversal(exec_space, bvh,
+                  Details::FDBSCANCallback<UnionFind, CorePoints>{
+                      labels, CorePoints{num_neigh, core_min_size}},
+                  within_radius);
+    Kokkos::Profiling::popRegion();
+  }
+}
+
+// Used for the minpts = 2 noise marking where no neighbor counts are
+// available: any point in a non-singleton cluster is core there, so treating
+// every point as non-core marks exactly the singletons as noise
+struct UnknownCorePoints
+{
+  KOKKOS_FUNCTION bool operator()(int) const { return false; }
+};
+
+// Flatten the union-find parents so that every label points to the cluster
+// representative, and mark singleton non-core points as noise
+template <typename ExecutionSpace, typename MemorySpace, typename CorePoints>
+void finalizeClusterLabels(ExecutionSpace const &exec_space,
+                           Kokkos::View<int *, MemorySpace> const &labels,
+                           CorePoints const &is_core)
+{
+  int const n = labels.size();
+
+  // Per [1]:
+  //
+  // ```
+  // The finalization kernel will, ultimately, make all parents
+  // point directly to the representative.
+  // ```
+  Kokkos::View<int *, MemorySpace> cluster_sizes(
+      Kokkos::view_alloc(exec_space, "ArborX::DBSCAN::cluster_sizes"), n);
+  Kokkos::parallel_for(
+      "ArborX::DBSCAN::finalize_labels",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int const i) {
+        // ##### ECL license (see LICENSE.ECL) #####
+        int next;
+        int vstat = labels(i);
+        int const old = vstat;
+        while (vstat > (next = labels(vstat)))
+        {
+          vstat = next;
+        }
+        if (vstat != old)
+          labels(i) = vstat;
+
+        Kokkos::atomic_increment(&cluster_sizes(labels(i)));
+      });
+  Kokkos::parallel_for(
+      "ArborX::DBSCAN::mark_noise",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int const i) {
+        if (cluster_sizes(labels(i)) == 1 && !is_core(i))
+          labels(i) = -1;
+      });
+}
+
+template <typename ExecutionSpace, typename MemorySpace>
+void finalizeClusterLabels(ExecutionSpace const &exec_space,
+                           Kokkos::View<int *, MemorySpace> const &labels,
+                           Kokkos::View<int *, MemorySpace> const &num_neigh,
+                           int core_min_size)
+{
+  if (core_min_size == 2)
+  {
+    // Ideally, this would have used the same is_core() as the else() clause.
+    // But there's no available valid one:
+    // - CCSCorePoints cannot be used as it always returns true, which is OK
+    //   inside the callback, but not here
+    // - DBSCANCorePoints cannot be used either as num_neigh is not initialized
+    //   in the special case.
+    finalizeClusterLabels(exec_space, labels, Details::UnknownCorePoints{});
+  }
+  else
+  {
+    finalizeClusterLabels(
+        exec_space, labels,
+        Details::DBSCANCorePoints<MemorySpace>{num_neigh, core_min_size});
+  }
+}
+
+} // namespace Details
+
 namespace DBSCAN
 {
 
 enum class Implementation
 {
   FDBSCAN,
-  FDBSCAN_DenseBox
+  FDBSCAN_DenseBox,
+  // Sample the point density at runtime and pick whichever of the two
+  // implementations fits the dataset (see dbscan())
+  Auto
 };
 
 struct Parameters
@@ -219,6 +481,9 @@ struct Parameters
   bool _verbose = false;
   // Algorithm implementation (FDBSCAN or FDBSCAN-DenseBox)
   Implementation _implementation = Implementation::FDBSCAN_DenseBox;
+  // Occupancy threshold above which a cell is treated as dense by
+  // FDBSCAN-DenseBox (0 = use core_min_size, the smallest correct value)
+  int _dense_cell_min_size = 0;
 
   Parameters &setVerbosity(bool verbose)
   {
@@ -230,6 +495,11 @@ struct Parameters
     _implementation = impl;
     return *this;
   }
+  Parameters &setDenseCellMinSize(int dense_cell_min_size)
+  {
+    _dense_cell_min_size = dense_cell_min_size;
+    return *this;
+  }
 };
 } // namespace DBSCAN
 
@@ -253,6 +523,11 @@ dbscan(ExecutionSpace const &exec_space, Primitives const &primitives,
 
   ARBORX_ASSERT(eps > 0);
   ARBORX_ASSERT(core_min_size >= 2);
+  // Points of a dense cell are declared core without counting their
+  // neighbors, which is only valid when the cell holds at least
+  // core_min_size points
+  ARBORX_ASSERT(parameters._dense_cell_min_size == 0 ||
+                parameters._dense_cell_min_size >= core_min_size);
 
 #ifdef KOKKOS_ENABLE_SERIAL
   using UnionFind = Details::UnionFind<
@@ -279,7 +554,83 @@ dbscan(ExecutionSpace const &exec_space, Primitives const &primitives,
 
   Kokkos::View<int *, MemorySpace> labels("ArborX::DBSCAN::labels", 0);
 
-  if (parameters._implementation == DBSCAN::Implementation::FDBSCAN)
+  int const dense_cell_min_size = (parameters._dense_cell_min_size > 0
+                                       ? parameters._dense_cell_min_size
+                                       : core_min_size);
+
+  auto implementation = parameters._implementation;
+  if (implementation == DBSCAN::Implementation::Auto)
+  {
+    // Estimate the share of points living in dense cells from a strided
+    // sample. FDBSCAN-DenseBox removes those points from both the tree and
+    // the neighbor counting, so it pays for its grid preprocessing once a
+    // sizable fraction of the dataset collapses into dense cells; otherwise
+    // plain FDBSCAN wins. The crossover between the two is flat, so a rough
+    // estimate is sufficient.
+    Kokkos::Profiling::pushRegion("ArborX::DBSCAN::implementation_selection");
+
+    implementation = DBSCAN::Implementation::FDBSCAN;
+
+    int const sample_size = std::min(n, 4096);
+    if (sample_size > 0)
+    {
+      Box bounds;
+      Details::TreeConstruction::calculateBoundingBoxOfTheScene(
+          exec_space,
+          Details::Indexables<Points, Details::DefaultIndexableGetter>{
+              points, Details::DefaultIndexableGetter{}},
+          bounds);
+      Details::CartesianGrid<dim> const grid(bounds, eps / std::sqrt(dim));
+
+      Kokkos::View<size_t *, MemorySpace> sample_cell_indices(
+          Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                             "ArborX::DBSCAN::sample_cell_indices"),
+          sample_size);
+      Kokkos::parallel_for(
+          "ArborX::DBSCAN::compute_sample_cell_indices",
+          Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, sample_size),
+          KOKKOS_LAMBDA(int i) {
+            sample_cell_indices(i) =
+                grid.cellIndex(points(((long long)i * n) / sample_size));
+          });
+      Details::sortObjects(exec_space, sample_cell_indices);
+
+      Kokkos::View<int *, MemorySpace> sample_cell_offsets(
+          "ArborX::DBSCAN::sample_cell_offsets", 0);
+      Details::computeOffsetsInOrderedView(exec_space, sample_cell_indices,
+                                           sample_cell_offsets);
+
+      // A cell holding c sampled points holds an estimated c*n/sample_size
+      // points overall
+      int num_sampled_points_in_dense_cells;
+      Kokkos::parallel_reduce(
+          "ArborX::DBSCAN::count_sampled_points_in_dense_cells",
+          Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0,
+                                              sample_cell_offsets.size() - 1),
+          KOKKOS_LAMBDA(int i, int &update) {
+            int const count =
+                sample_cell_offsets(i + 1) - sample_cell_offsets(i);
+            if ((long long)count * n >=
+                (long long)dense_cell_min_size * sample_size)
+              update += count;
+          },
+          num_sampled_points_in_dense_cells);
+
+      if (4 * num_sampled_points_in_dense_cells >= sample_size)
+        implementation = DBSCAN::Implementation::FDBSCAN_DenseBox;
+
+      if (verbose)
+        printf("implementation (auto): %s [dense sample fraction %.2f%%]\n",
+               implementation == DBSCAN::Implementation::FDBSCAN_DenseBox
+                   ? "FDBSCAN-DenseBox"
+                   : "FDBSCAN",
+               (100.f * num_sampled_points_in_dense_cells) / sample_size);
+    }
+
+    Kokkos::Profiling::popRegion();
+  }
+
+  if (implementation == DBSCAN::Implementation::FDBSCAN)
   {
     // Build the tree
     Kokkos::Profiling::pushRegion("ArborX::DBSCAN::tree_construction");
@@ -293,59 +644,12 @@ dbscan(ExecutionSpace const &exec_space, Primitives const &primitives,
                    labels, n);
     KokkosExt::iota(exec_space, labels);
 
-    Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters");
-    if (is_special_case)
-    {
-      // Perform the queries and build clusters through callback
-      using CorePoints = Details::CCSCorePoints;
-#if defined(KOKKOS_COMPILER_NVCC) && (KOKKOS_COMPILER_NVCC < 1140)
-      // Workaround a compiler bug
-      using HalfTraversal = Details::HalfTraversal<
-          decltype(bvh), Details::FDBSCANCallback<UnionFind, CorePoints>,
-          Details::WithinRadiusGetter>;
-#else
-      using Details::HalfTraversal;
-#endif
-      Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters::query");
-      HalfTraversal(
-          exec_space, bvh,
-          Details::FDBSCANCallback<UnionFind, CorePoints>{labels, CorePoints{}},
-          Details::WithinRadiusGetter{eps});
-      Kokkos::Profiling::popRegion();
-    }
-    else
-    {
-      auto const predicates =
-          Details::PrimitivesWithRadius<Points>{points, eps};
-
-      // Determine core points
-      Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters::num_neigh");
-      Kokkos::resize(Kokkos::view_alloc(exec_space), num_neigh, n);
-      bvh.query(exec_space, predicates,
-                Details::CountUpToN<MemorySpace>{num_neigh, core_min_size});
-      Kokkos::Profiling::popRegion();
-
-      using CorePoints = Details::DBSCANCorePoints<MemorySpace>;
-#if defined(KOKKOS_COMPILER_NVCC) && (KOKKOS_COMPILER_NVCC < 1140)
-      // Workaround a compiler bug
-      using HalfTraversal = Details::HalfTraversal<
-          decltype(bvh), Details::FDBSCANCallback<UnionFind, CorePoints>,
-          Details::WithinRadiusGetter>;
-#else
-      using Details::HalfTraversal;
-#endif
-
-      // Perform the queries and build clusters through callback
-      Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters::query");
-      HalfTraversal(exec_space, bvh,
-                    Details::FDBSCANCallback<UnionFind, CorePoints>{
-                        labels, CorePoints{num_neigh, core_min_size}},
-                    Details::WithinRadiusGetter{eps});
-      Kokkos::Profiling::popRegion();
-    }
+    Details::fdbscanComputeClusters<UnionFind>(
+        exec_space, bvh, labels, num_neigh, core_min_size,
+        Details::PrimitivesWithRadius<Points>{points, eps},
+        Details::WithinRadiusGetter{eps});
   }
-  else if (parameters._implementation ==
-           DBSCAN::Implementation::FDBSCAN_DenseBox)
+  else if (implementation == DBSCAN::Implementation::FDBSCAN_DenseBox)
   {
     // Find dense boxes
     Kokkos::Profiling::pushRegion("ArborX::DBSCAN::dense_cells");
@@ -377,7 +681,7 @@ dbscan(ExecutionSpace const &exec_space, Primitives const &primitives,
       num_nonempty_cells = cell_offsets.size() - 1;
 
       num_points_in_dense_cells = Details::reorderDenseAndSparseCells(
-          exec_space, cell_offsets, core_min_size, sorted_cell_indices,
+          exec_space, cell_offsets, dense_cell_min_size, sorted_cell_indices,
           permute);
     }
     int num_points_in_sparse_cells = n - num_points_in_dense_cells;
@@ -412,6 +716,18 @@ dbscan(ExecutionSpace const &exec_space, Primitives const &primitives,
     Details::unionFindWithinEachDenseCell(exec_space, dense_sorted_cell_indices,
                                           permute, UnionFind{labels});
 
+    // In low dimensions, neighboring dense cells are connected directly
+    // through the grid stencil, so that the points in dense cells -- the
+    // bulk of the data on the workloads this algorithm targets -- never
+    // issue a tree query. The tree queries below then come from the
+    // sparse-cell points only.
+    constexpr bool use_dense_cell_stencil = (dim == 2 || dim == 3);
+    if constexpr (use_dense_cell_stencil)
+      Details::mergeAdjacentDenseCells(exec_space, grid, points,
+                                       dense_sorted_cell_indices,
+                                       dense_cell_offsets, permute, eps,
+                                       UnionFind{labels});
+
     Kokkos::Profiling::popRegion();
 
     // Build the tree
@@ -437,14 +753,32 @@ dbscan(ExecutionSpace const &exec_space, Primitives const &primitives,
       // Perform the queries and build clusters through callback
       using CorePoints = Details::CCSCorePoints;
       Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters::query");
-      auto const predicates =
-          Details::PrimitivesWithRadius<Points>{points, eps};
-      bvh.query(exec_space, predicates,
-                Details::FDBSCANDenseBoxCallback<UnionFind, CorePoints, Points,
-                                                 decltype(dense_cell_offsets),
-                                                 decltype(permute)>{
-                    labels, CorePoints{}, points, dense_cell_offsets,
-                    exec_space, permute, eps});
+      if constexpr (use_dense_cell_stencil)
+      {
+        auto sparse_permute = Kokkos::subview(
+            permute, Kokkos::make_pair(num_points_in_dense_cells, n));
+        auto const sparse_predicates =
+            Details::PrimitivesWithRadiusReorderedAndFiltered<
+                Points, decltype(sparse_permute)>{points, eps, sparse_permute};
+        bvh.query(exec_space, sparse_predicates,
+                  Details::FDBSCANDenseBoxSparseCallback<
+                      UnionFind, CorePoints, Points,
+                      decltype(dense_cell_offsets), decltype(permute)>{
+                      labels, CorePoints{}, points, dense_cell_offsets,
+                      exec_space, permute, eps});
+      }
+      else
+      {
+        auto const predicates =
+            Details::PrimitivesWithRadius<Points>{points, eps};
+        bvh.query(
+            exec_space, predicates,
+            Details::FDBSCANDenseBoxCallback<UnionFind, CorePoints, Points,
+                                             decltype(dense_cell_offsets),
+                                             decltype(permute)>{
+                labels, CorePoints{}, points, dense_cell_offsets, exec_space,
+                permute, eps});
+      }
       Kokkos::Profiling::popRegion();
     }
     else
@@ -478,70 +812,364 @@ dbscan(ExecutionSpace const &exec_space, Primitives const &primitives,
 
       // Perform the queries and build clusters through callback
       Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters::query");
-      auto const predicates =
-          Details::PrimitivesWithRadius<Points>{points, eps};
-      bvh.query(exec_space, predicates,
-                Details::FDBSCANDenseBoxCallback<UnionFind, CorePoints, Points,
-                                                 decltype(dense_cell_offsets),
-                                                 decltype(permute)>{
-                    labels, CorePoints{num_neigh, core_min_size}, points,
-                    dense_cell_offsets, exec_space, permute, eps});
+      if constexpr (use_dense_cell_stencil)
+      {
+        auto const sparse_predicates =
+            Details::PrimitivesWithRadiusReorderedAndFiltered<
+                Points, decltype(sparse_permute)>{points, eps, sparse_permute};
+        bvh.query(exec_space, sparse_predicates,
+                  Details::FDBSCANDenseBoxSparseCallback<
+                      UnionFind, CorePoints, Points,
+                      decltype(dense_cell_offsets), decltype(permute)>{
+                      labels, CorePoints{num_neigh, core_min_size}, points,
+                      dense_cell_offsets, exec_space, permute, eps});
+      }
+      else
+      {
+        auto const predicates =
+            Details::PrimitivesWithRadius<Points>{points, eps};
+        bvh.query(
+            exec_space, predicates,
+            Details::FDBSCANDenseBoxCallback<UnionFind, CorePoints, Points,
+                                             decltype(dense_cell_offsets),
+                                             decltype(permute)>{
+                labels, CorePoints{num_neigh, core_min_size}, points,
+                dense_cell_offsets, exec_space, permute, eps});
+      }
       Kokkos::Profiling::popRegion();
     }
   }
 
-  // Per [1]:
-  //
-  // ```
-  // The finalization kernel will, ultimately, make all parents
-  // point directly to the representative.
-  // ```
-  Kokkos::View<int *, MemorySpace> cluster_sizes(
-      Kokkos::view_alloc(exec_space, "ArborX::DBSCAN::cluster_sizes"), n);
+  Details::finalizeClusterLabels(exec_space, labels, num_neigh, core_min_size);
+  Kokkos::Profiling::popRegion();
+
+  Kokkos::Profiling::popRegion();
+
+  return labels;
+}
+
+// Overload clustering points that live in a periodic domain (e.g., an MD or
+// cosmology box): distances wrap around the periodic dimensions following
+// the minimum-image convention, so clusters straddling a boundary are
+// recovered without replicating ghost points. Always runs plain FDBSCAN as
+// the dense-box grid does not wrap; the implementation parameter is ignored.
+template <typename ExecutionSpace, typename Primitives, int DIM,
+          typename Coordinate>
+Kokkos::View<int *,
+             typename AccessTraits<Primitives, PrimitivesTag>::memory_space>
+dbscan(ExecutionSpace const &exec_space, Primitives const &primitives,
+       float eps, int core_min_size,
+       Experimental::PeriodicDomain<DIM, Coordinate> const &domain,
+       DBSCAN::Parameters const &parameters = DBSCAN::Parameters())
+{
+  Kokkos::Profiling::pushRegion("ArborX::DBSCAN");
+
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+
+  using Points = Details::AccessValues<Primitives, PrimitivesTag>;
+  using MemorySpace = typename Points::memory_space;
+
+  static_assert(
+      KokkosExt::is_accessible_from<MemorySpace, ExecutionSpace>::value,
+      "Primitives must be accessible from the execution space");
+
+  ARBORX_ASSERT(eps > 0);
+  ARBORX_ASSERT(core_min_size >= 2);
+  for (int d = 0; d < DIM; ++d)
+    ARBORX_ASSERT(domain.period(d) >= 0);
+
+  (void)parameters;
+
+#ifdef KOKKOS_ENABLE_SERIAL
+  using UnionFind = Details::UnionFind<
+      MemorySpace,
+      /*DoSerial=*/std::is_same_v<ExecutionSpace, Kokkos::Serial>>;
+#else
+  using UnionFind = Details::UnionFind<MemorySpace>;
+#endif
+
+  using Point = typename Points::value_type;
+  static_assert(GeometryTraits::is_point<Point>{});
+  static_assert(GeometryTraits::dimension_v<Point> == DIM);
+
+  Points points{primitives};
+  int const n = points.size();
+
+  Kokkos::View<int *, MemorySpace> num_neigh("ArborX::DBSCAN::num_neighbors",
+                                             0);
+  Kokkos::View<int *, MemorySpace> labels("ArborX::DBSCAN::labels", 0);
+
+  // Build the tree
+  Kokkos::Profiling::pushRegion("ArborX::DBSCAN::tree_construction");
+  BoundingVolumeHierarchy<MemorySpace, PairValueIndex<Point>> bvh(
+      exec_space, Experimental::attach_indices(points));
+  Kokkos::Profiling::popRegion();
+
+  Kokkos::resize(Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing),
+                 labels, n);
+  KokkosExt::iota(exec_space, labels);
+
+  Details::fdbscanComputeClusters<UnionFind>(
+      exec_space, bvh, labels, num_neigh, core_min_size,
+      Details::PrimitivesWithRadiusPeriodic<Points, DIM, Coordinate>{
+          points, eps, domain},
+      Details::WithinRadiusPeriodicGetter<DIM, Coordinate>{eps, domain});
+
+  Details::finalizeClusterLabels(exec_space, labels, num_neigh, core_min_size);
+  Kokkos::Profiling::popRegion();
+
+  Kokkos::Profiling::popRegion();
+
+  return labels;
+}
+
+// Weighted overload for points carrying a multiplicity (e.g., pre-aggregated
+// super-points): a point is core when the accumulated weight of its
+// eps-neighborhood (including its own) reaches core_min_weight, instead of
+// the neighbor count reaching core_min_size. With unit weights the result is
+// identical to the unweighted dbscan(). Always runs plain FDBSCAN as the
+// dense-box variant declares dense-cell points core by count alone; the
+// implementation parameter is ignored.
+template <typename ExecutionSpace, typename Primitives, typename Weights,
+          std::enable_if_t<Kokkos::is_view_v<Weights>> * = nullptr>
+Kokkos::View<int *,
+             typename AccessTraits<Primitives, PrimitivesTag>::memory_space>
+dbscan(ExecutionSpace const &exec_space, Primitives const &primitives,
+       float eps, float core_min_weight, Weights const &weights,
+       DBSCAN::Parameters const &parameters = DBSCAN::Parameters())
+{
+  Kokkos::Profiling::pushRegion("ArborX::DBSCAN");
+
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+
+  using Points = Details::AccessValues<Primitives, PrimitivesTag>;
+  using MemorySpace = typename Points::memory_space;
+
+  static_assert(
+      KokkosExt::is_accessible_from<MemorySpace, ExecutionSpace>::value,
+      "Primitives must be accessible from the execution space");
+  static_assert(KokkosExt::is_accessible_from<
+                    typename Weights::memory_space, ExecutionSpace>::value,
+                "Weights must be accessible from the execution space");
+
+  ARBORX_ASSERT(eps > 0);
+  ARBORX_ASSERT(core_min_weight > 0);
+
+  (void)parameters;
+
+#ifdef KOKKOS_ENABLE_SERIAL
+  using UnionFind = Details::UnionFind<
+      MemorySpace,
+      /*DoSerial=*/std::is_same_v<ExecutionSpace, Kokkos::Serial>>;
+#else
+  using UnionFind = Details::UnionFind<MemorySpace>;
+#endif
+
+  using Point = typename Points::value_type;
+  static_assert(GeometryTraits::is_point<Point>{});
+
+  Points points{primitives};
+  int const n = points.size();
+  ARBORX_ASSERT((int)weights.size() == n);
+
+  Kokkos::View<int *, MemorySpace> labels("ArborX::DBSCAN::labels", 0);
+
+  // Build the tree
+  Kokkos::Profiling::pushRegion("ArborX::DBSCAN::tree_construction");
+  BoundingVolumeHierarchy<MemorySpace, PairValueIndex<Point>> bvh(
+      exec_space, Experimental::attach_indices(points));
+  Kokkos::Profiling::popRegion();
+
+  Kokkos::resize(Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing),
+                 labels, n);
+  KokkosExt::iota(exec_space, labels);
+
+  Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters");
+
+  auto const predicates = Details::PrimitivesWithRadius<Points>{points, eps};
+
+  // Determine core points by accumulated neighborhood weight. There is no
+  // counting special case or fused path here: core status depends on the
+  // weights, not on the number of visited pairs.
+  Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters::neigh_weight");
+  Kokkos::View<float *, MemorySpace> weight_sums(
+      Kokkos::view_alloc(exec_space, "ArborX::DBSCAN::neigh_weights"), n);
+  bvh.query(exec_space, predicates,
+            Details::CountUpToWeight<MemorySpace, Weights>{weight_sums, weights,
+                                                           core_min_weight});
+  Kokkos::Profiling::popRegion();
+
+  using CorePoints = Details::DBSCANWeightedCorePoints<MemorySpace>;
+#if defined(KOKKOS_COMPILER_NVCC) && (KOKKOS_COMPILER_NVCC < 1140)
+  // Workaround a compiler bug
+  using HalfTraversal = Details::HalfTraversal<
+      decltype(bvh), Details::FDBSCANCallback<UnionFind, CorePoints>,
+      Details::WithinRadiusGetter>;
+#else
+  using Details::HalfTraversal;
+#endif
+
+  // Perform the queries and build clusters through callback
+  Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters::query");
+  HalfTraversal(exec_space, bvh,
+                Details::FDBSCANCallback<UnionFind, CorePoints>{
+                    labels, CorePoints{weight_sums, core_min_weight}},
+                Details::WithinRadiusGetter{eps});
+  Kokkos::Profiling::popRegion();
+
+  Details::finalizeClusterLabels(exec_space, labels,
+                                 CorePoints{weight_sums, core_min_weight});
+  Kokkos::Profiling::popRegion();
+
+  Kokkos::Profiling::popRegion();
+
+  return labels;
+}
+
+// Overload that additionally emits the eps-neighbor adjacency the clustering
+// discovers, as a full CSR graph: row i of offsets/indices holds every point
+// within eps of point i (i itself excluded), mirroring the
+// findFullNeighborList contract. Consumers that need the graph anyway
+// (cluster statistics, graph analytics) otherwise rebuild it with a second
+// round of tree walks right after clustering; here the tree is shared, the
+// materialized degrees replace the neighbor-counting traversal, and the
+// cluster merging sweeps the graph instead of walking the tree again.
+// Always runs plain FDBSCAN as the dense-box variant never visits the
+// intra-cell pairs; the implementation parameter is ignored.
+template <typename ExecutionSpace, typename Primitives, typename Offsets,
+          typename Indices>
+Kokkos::View<int *,
+             typename AccessTraits<Primitives, PrimitivesTag>::memory_space>
+dbscan(ExecutionSpace const &exec_space, Primitives const &primitives,
+       float eps, int core_min_size, Offsets &offsets, Indices &indices,
+       DBSCAN::Parameters const &parameters = DBSCAN::Parameters())
+{
+  Kokkos::Profiling::pushRegion("ArborX::DBSCAN");
+
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+
+  using Points = Details::AccessValues<Primitives, PrimitivesTag>;
+  using MemorySpace = typename Points::memory_space;
+
+  static_assert(
+      KokkosExt::is_accessible_from<MemorySpace, ExecutionSpace>::value,
+      "Primitives must be accessible from the execution space");
+  static_assert(Kokkos::is_view_v<Offsets> && Kokkos::is_view_v<Indices>);
+
+  ARBORX_ASSERT(eps > 0);
+  ARBORX_ASSERT(core_min_size >= 2);
+
+  (void)parameters;
+
+#ifdef KOKKOS_ENABLE_SERIAL
+  using UnionFind = Details::UnionFind<
+      MemorySpace,
+      /*DoSerial=*/std::is_same_v<ExecutionSpace, Kokkos::Serial>>;
+#else
+  using UnionFind = Details::UnionFind<MemorySpace>;
+#endif
+
+  using Point = typename Points::value_type;
+  static_assert(GeometryTraits::is_point<Point>{});
+
+  Points points{primitives};
+  int const n = points.size();
+
+  Kokkos::View<int *, MemorySpace> num_neigh("ArborX::DBSCAN::num_neighbors",
+                                             0);
+  Kokkos::View<int *, MemorySpace> labels("ArborX::DBSCAN::labels", 0);
+
+  // Build the tree
+  Kokkos::Profiling::pushRegion("ArborX::DBSCAN::tree_construction");
+  BoundingVolumeHierarchy<MemorySpace, PairValueIndex<Point>> bvh(
+      exec_space, Experimental::attach_indices(points));
+  Kokkos::Profiling::popRegion();
+
+  // Materialize the adjacency over the already built tree: count both
+  // endpoints of every pair, fill one direction, mirror it (the same scheme
+  // as findFullNeighborList)
+  Kokkos::Profiling::pushRegion("ArborX::DBSCAN::adjacency");
+  auto const within_radius = Details::WithinRadiusGetter{eps};
+
+  KokkosExt::reallocWithoutInitializing(exec_space, offsets, n + 1);
+  Kokkos::deep_copy(exec_space, offsets, 0);
+  Details::HalfTraversal(
+      exec_space, bvh,
+      KOKKOS_LAMBDA(int i, int j) {
+        Kokkos::atomic_increment(&offsets(i));
+        Kokkos::atomic_increment(&offsets(j));
+      },
+      within_radius);
+  KokkosExt::exclusive_scan(exec_space, offsets, offsets, 0);
+  KokkosExt::reallocWithoutInitializing(
+      exec_space, indices, KokkosExt::lastElement(exec_space, offsets));
+
+  auto counts = KokkosExt::clone(exec_space,
+                                 Kokkos::subview(offsets, std::make_pair(0, n)),
+                                 "ArborX::DBSCAN::adjacency_counts");
+  Details::HalfTraversal(
+      exec_space, bvh,
+      KOKKOS_LAMBDA(int i, int j) {
+        indices(Kokkos::atomic_fetch_inc(&counts(j))) = i;
+      },
+      within_radius);
+
+  auto counts_copy =
+      KokkosExt::clone(exec_space, counts, counts.label() + "_copy");
   Kokkos::parallel_for(
-      "ArborX::DBSCAN::finalize_labels",
+      "ArborX::DBSCAN::adjacency_mirror",
+      Kokkos::TeamPolicy<ExecutionSpace>(exec_space, n, Kokkos::AUTO, 1),
+      KOKKOS_LAMBDA(
+          typename Kokkos::TeamPolicy<ExecutionSpace>::member_type const
+              &member) {
+        auto const i = member.league_rank();
+        auto const first = offsets(i);
+        auto const last = counts_copy(i);
+        Kokkos::parallel_for(
+            Kokkos::TeamVectorRange(member, last - first), [&](int j) {
+              int const k = indices(first + j);
+              indices(Kokkos::atomic_fetch_inc(&counts(k))) = i;
+            });
+      });
+  Kokkos::Profiling::popRegion();
+
+  Kokkos::Profiling::pushRegion("ArborX::DBSCAN::clusters");
+
+  // The graph holds the exact degrees, making the neighbor-counting
+  // traversal of the regular path unnecessary. Counts include the point
+  // itself, matching the counting semantics.
+  Kokkos::resize(Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing),
+                 num_neigh, n);
+  Kokkos::parallel_for(
+      "ArborX::DBSCAN::degrees_to_num_neigh",
       Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
-      KOKKOS_LAMBDA(int const i) {
-        // ##### ECL license (see LICENSE.ECL) #####
-        int next;
-        int vstat = labels(i);
-        int const old = vstat;
-        while (vstat > (next = labels(vstat)))
+      KOKKOS_LAMBDA(int i) { num_neigh(i) = offsets(i + 1) - offsets(i) + 1; });
+
+  Kokkos::resize(Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing),
+                 labels, n);
+  KokkosExt::iota(exec_space, labels);
+
+  // Sweep the materialized graph instead of walking the tree a second time;
+  // every pair is processed from its smaller endpoint, reproducing the
+  // FDBSCANCallback semantics. With the true degrees at hand there is no
+  // need for the minpts = 2 special case of the regular path.
+  using CorePoints = Details::DBSCANCorePoints<MemorySpace>;
+  Details::FDBSCANCallback<UnionFind, CorePoints> callback{
+      labels, CorePoints{num_neigh, core_min_size}};
+  Kokkos::parallel_for(
+      "ArborX::DBSCAN::clusters::sweep_graph",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        for (int k = offsets(i); k < offsets(i + 1); ++k)
         {
-          vstat = next;
+          int const j = indices(k);
+          if (i < j)
+            callback(i, j);
         }
-        if (vstat != old)
-          labels(i) = vstat;
-
-        Kokkos::atomic_increment(&cluster_sizes(labels(i)));
       });
-  if (is_special_case)
-  {
-    // Ideally, this kernel would have had the exactly same form as in the
-    // else() clause. But there's no available valid is_core() for use here:
-    // - CCSCorePoints cannot be used as it always returns true, which is OK
-    //   inside the callback, but not here
-    // - DBSCANCorePoints cannot be used either as num_neigh is not initialized
-    //   in the special case.
-    Kokkos::parallel_for(
-        "ArborX::DBSCAN::mark_noise",
-        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
-        KOKKOS_LAMBDA(int const i) {
-          if (cluster_sizes(labels(i)) == 1)
-            labels(i) = -1;
-        });
-  }
-  else
-  {
-    Details::DBSCANCorePoints<MemorySpace> is_core{num_neigh, core_min_size};
-    Kokkos::parallel_for(
-        "ArborX::DBSCAN::mark_noise",
-        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
-        KOKKOS_LAMBDA(int const i) {
-          if (cluster_sizes(labels(i)) == 1 && !is_core(i))
-            labels(i) = -1;
-        });
-  }
+
+  Details::finalizeClusterLabels(exec_space, labels,
+                                 CorePoints{num_neigh, core_min_size});
   Kokkos::Profiling::popRegion();
 
   Kokkos::Profiling::popRegion();
@@ -0,0 +1,504 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DBSCAN_OUT_OF_CORE_HPP
+#define ARBORX_DBSCAN_OUT_OF_CORE_HPP
+
+#include <ArborX_DBSCAN.hpp>
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsCartesianGrid.hpp>
+#include <ArborX_DetailsHalfTraversal.hpp>
+#include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+#include <ArborX_DetailsUnionFind.hpp>
+#include <ArborX_HyperBox.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_SpaceFillingCurves.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+namespace ArborX
+{
+
+namespace Details
+{
+
+// Emit the pairs within eps that can affect the global labels: at least one
+// endpoint must be owned by the tile (a pair of two halo points is emitted
+// by the tile owning one of them) and at least one endpoint must be core (a
+// pair of two non-core points never changes a label). The buffer is appended
+// to atomically; on overflow the counter keeps growing past the capacity so
+// that the caller can resize and rerun the traversal.
+template <typename MemorySpace>
+struct OutOfCoreEdgesCallback
+{
+  Kokkos::View<char *, MemorySpace> _is_core;
+  int _num_owned; // tile points precede the halo points in the chunk
+  Kokkos::View<Kokkos::pair<int, int> *, MemorySpace> _edges;
+  Kokkos::View<int, MemorySpace> _num_edges;
+
+  KOKKOS_FUNCTION void operator()(int i, int j) const
+  {
+    if (i >= _num_owned && j >= _num_owned)
+      return;
+    if (!_is_core(i) && !_is_core(j))
+      return;
+
+    int const e = Kokkos::atomic_fetch_add(&_num_edges(), 1);
+    if (e < (int)_edges.size())
+      _edges(e) = {i, j};
+  }
+};
+
+} // namespace Details
+
+namespace Experimental
+{
+
+// DBSCAN for datasets that do not fit in device memory. The points stay
+// resident on the host, partitioned into grid tiles no smaller than eps (so
+// that the eps-halo of a tile is confined to its immediate neighbors, see
+// Details::CartesianGrid). The tiles are streamed through the device in the
+// space-filling curve order of their cells, double-buffered on two execution
+// space instances so that the upload of the next chunk overlaps with the
+// processing of the current one. Each chunk consists of a tile together
+// with its halo, which covers the full eps-neighborhood of every tile point
+// and thus yields their exact core status. A second sweep harvests the
+// label-changing pairs, which are replayed into a host-side union-find; the
+// resulting labels are identical to running dbscan() on the whole dataset
+// up to the usual ambiguity of border point assignment.
+//
+// max_tile_points sets the targeted tile population under roughly uniform
+// density; skewed datasets may produce larger tiles, which are still
+// processed as single chunks. Like the in-core dbscan(), indices (and thus
+// the dataset size) are limited to what fits in an int.
+template <typename ExecutionSpace, typename PointsView>
+Kokkos::View<int *, Kokkos::HostSpace>
+dbscanOutOfCore(ExecutionSpace const &exec_space, PointsView const &points,
+                float eps, int core_min_size, int max_tile_points = 1 << 24)
+{
+  Kokkos::Profiling::pushRegion("ArborX::DBSCAN::out_of_core");
+
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+
+  static_assert(Kokkos::is_view_v<PointsView>);
+  static_assert(KokkosExt::is_accessible_from_host<PointsView>::value,
+                "Points must be accessible from the host");
+
+  using Point = typename PointsView::non_const_value_type;
+  static_assert(GeometryTraits::is_point<Point>{});
+  constexpr int DIM = GeometryTraits::dimension_v<Point>;
+  using Box = ExperimentalHyperGeometry::Box<DIM>;
+  using MemorySpace = typename ExecutionSpace::memory_space;
+
+  ARBORX_ASSERT(eps > 0);
+  ARBORX_ASSERT(core_min_size >= 2);
+  ARBORX_ASSERT(max_tile_points > 0);
+
+  int const n = points.extent_int(0);
+
+  Kokkos::View<int *, Kokkos::HostSpace> labels(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "ArborX::DBSCAN::labels"),
+      n);
+  std::iota(labels.data(), labels.data() + n, 0);
+  if (n == 0)
+  {
+    Kokkos::Profiling::popRegion();
+    return labels;
+  }
+
+  Kokkos::Profiling::pushRegion("ArborX::DBSCAN::out_of_core::tiling");
+
+  Box bounds;
+  for (int i = 0; i < n; ++i)
+    Details::expand(bounds, points(i));
+
+  // The cell length targets max_tile_points points per tile under uniform
+  // density while never going below eps, which keeps the halo of a tile
+  // within its 3^DIM neighborhood
+  float h[DIM];
+  {
+    int const cells_per_dim = std::max(
+        1, (int)std::floor(std::pow((double)n / max_tile_points, 1. / DIM)));
+    for (int d = 0; d < DIM; ++d)
+      h[d] = std::max(eps, (bounds.maxCorner()[d] - bounds.minCorner()[d]) /
+                               cells_per_dim);
+  }
+  Details::CartesianGrid<DIM> const grid(bounds, h);
+
+  // Bin the points into the non-empty tiles
+  std::unordered_map<size_t, int> tile_of_cell;
+  std::vector<size_t> tile_cells;
+  std::vector<int> point_tile(n);
+  for (int i = 0; i < n; ++i)
+  {
+    auto const cell = grid.cellIndex(points(i));
+    auto [it, inserted] =
+        tile_of_cell.try_emplace(cell, (int)tile_cells.size());
+    if (inserted)
+      tile_cells.push_back(cell);
+    point_tile[i] = it->second;
+  }
+  int const num_tiles = (int)tile_cells.size();
+
+  std::vector<int> tile_offsets(num_tiles + 1, 0);
+  for (int i = 0; i < n; ++i)
+    ++tile_offsets[point_tile[i] + 1];
+  for (int t = 0; t < num_tiles; ++t)
+    tile_offsets[t + 1] += tile_offsets[t];
+  std::vector<int> tile_points(n);
+  {
+    auto starts = tile_offsets;
+    for (int i = 0; i < n; ++i)
+      tile_points[starts[point_tile[i]]++] = i;
+  }
+
+  // Stream the tiles in the space-filling curve order of their cells, which
+  // maximizes the halo overlap between consecutively processed chunks
+  std::vector<int> tile_order(num_tiles);
+  std::iota(tile_order.begin(), tile_order.end(), 0);
+  {
+    std::vector<unsigned long long> keys(num_tiles);
+    for (int t = 0; t < num_tiles; ++t)
+      keys[t] = Morton64{}(bounds, grid.cellBox(tile_cells[t]));
+    std::sort(tile_order.begin(), tile_order.end(),
+              [&keys](int a, int b) { return keys[a] < keys[b]; });
+  }
+
+  // Chunk of a tile = its own points followed by its eps-halo: the points
+  // of the neighboring cells within eps of the tile box
+  std::vector<int> chunk_offsets(num_tiles + 1, 0);
+  std::vector<int> chunk_num_owned(num_tiles);
+  std::vector<int> chunk_points;
+  chunk_points.reserve(n);
+  for (int tt = 0; tt < num_tiles; ++tt)
+  {
+    int const t = tile_order[tt];
+    auto const tile_box = grid.cellBox(tile_cells[t]);
+
+    for (int i = tile_offsets[t]; i < tile_offsets[t + 1]; ++i)
+      chunk_points.push_back(tile_points[i]);
+    chunk_num_owned[tt] = tile_offsets[t + 1] - tile_offsets[t];
+
+    // Decode the cell multi-index (mirroring cellBox())
+    size_t coords[DIM];
+    {
+      auto cell = tile_cells[t];
+      for (int d = 0; d < DIM; ++d)
+      {
+        coords[d] = cell % grid.extent(d);
+        cell /= grid.extent(d);
+      }
+    }
+
+    // Walk the 3^DIM - 1 neighboring cells
+    int shift[DIM];
+    for (int d = 0; d < DIM; ++d)
+      shift[d] = -1;
+    while (true)
+    {
+      bool is_self = true;
+      bool is_valid = true;
+      size_t neighbor = 0;
+      for (int d = DIM - 1; d >= 0; --d)
+      {
+        if (shift[d] != 0)
+          is_self = false;
+        auto const c = (long long)coords[d] + shift[d];
+        if (c < 0 || c >= (long long)grid.extent(d))
+        {
+          is_valid = false;
+          break;
+        }
+        neighbor = neighbor * grid.extent(d) + c;
+      }
+      if (is_valid && !is_self)
+      {
+        auto it = tile_of_cell.find(neighbor);
+        if (it != tile_of_cell.end())
+        {
+          int const u = it->second;
+          for (int i = tile_offsets[u]; i < tile_offsets[u + 1]; ++i)
+          {
+            int const p = tile_points[i];
+            if (Details::distance(points(p), tile_box) <= eps)
+              chunk_points.push_back(p);
+          }
+        }
+      }
+
+      int d = 0;
+      for (; d < DIM; ++d)
+      {
+        if (++shift[d] <= 1)
+          break;
+        shift[d] = -1;
+      }
+      if (d == DIM)
+        break;
+    }
+    chunk_offsets[tt + 1] = (int)chunk_points.size();
+  }
+
+  int max_chunk_size = 0;
+  for (int tt = 0; tt < num_tiles; ++tt)
+    max_chunk_size =
+        std::max(max_chunk_size, chunk_offsets[tt + 1] - chunk_offsets[tt]);
+
+  Kokkos::Profiling::popRegion();
+
+  // Two execution space instances double-buffer the chunks: while one
+  // instance processes a chunk, the other uploads the next one
+  auto instances = Kokkos::Experimental::partition_space(exec_space, 1, 1);
+
+  Kokkos::View<Point *, MemorySpace> chunk_points_d[2];
+  decltype(Kokkos::create_mirror_view(chunk_points_d[0])) chunk_points_h[2];
+  for (int s = 0; s < 2; ++s)
+  {
+    chunk_points_d[s] = Kokkos::View<Point *, MemorySpace>(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                           "ArborX::DBSCAN::chunk_points"),
+        max_chunk_size);
+    chunk_points_h[s] = Kokkos::create_mirror_view(chunk_points_d[s]);
+  }
+
+  using BVH =
+      BoundingVolumeHierarchy<MemorySpace, Details::PairValueIndex<Point>>;
+  // Keep the trees alive across iterations: slot s may not be reused before
+  // the work enqueued on instances[s] has completed
+  BVH bvh[2];
+
+  // First sweep: exact core status of every point. The chunk covers the
+  // full eps-neighborhood of each tile point, so counting neighbors within
+  // the chunk gives the same counts as the in-core algorithm.
+  Kokkos::Profiling::pushRegion("ArborX::DBSCAN::out_of_core::core_points");
+  std::vector<char> is_core(n, 0);
+  {
+    Kokkos::View<int *, MemorySpace> counts_d[2];
+    decltype(Kokkos::create_mirror_view(counts_d[0])) counts_h[2];
+    for (int s = 0; s < 2; ++s)
+    {
+      counts_d[s] = Kokkos::View<int *, MemorySpace>(
+          Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                             "ArborX::DBSCAN::num_neighbors"),
+          max_chunk_size);
+      counts_h[s] = Kokkos::create_mirror_view(counts_d[s]);
+    }
+
+    int pending[2] = {-1, -1};
+    auto harvest = [&](int s) {
+      int const tt = pending[s];
+      if (tt < 0)
+        return;
+      instances[s].fence();
+      for (int i = 0; i < chunk_num_owned[tt]; ++i)
+        is_core[chunk_points[chunk_offsets[tt] + i]] =
+            (counts_h[s](i) >= core_min_size);
+      pending[s] = -1;
+    };
+
+    for (int tt = 0; tt < num_tiles; ++tt)
+    {
+      int const s = tt % 2;
+      harvest(s);
+
+      int const chunk_size = chunk_offsets[tt + 1] - chunk_offsets[tt];
+      int const num_owned = chunk_num_owned[tt];
+      for (int i = 0; i < chunk_size; ++i)
+        chunk_points_h[s](i) = points(chunk_points[chunk_offsets[tt] + i]);
+
+      auto chunk = Kokkos::subview(chunk_points_d[s],
+                                   Kokkos::make_pair(0, chunk_size));
+      Kokkos::deep_copy(instances[s], chunk,
+                        Kokkos::subview(chunk_points_h[s],
+                                        Kokkos::make_pair(0, chunk_size)));
+
+      bvh[s] = BVH(instances[s], Experimental::attach_indices(chunk));
+
+      auto counts =
+          Kokkos::subview(counts_d[s], Kokkos::make_pair(0, num_owned));
+      Kokkos::deep_copy(instances[s], counts, 0);
+      auto owned = Kokkos::subview(chunk, Kokkos::make_pair(0, num_owned));
+      bvh[s].query(
+          instances[s],
+          Details::PrimitivesWithRadius<decltype(owned)>{owned, eps},
+          Details::CountUpToN<MemorySpace>{counts, core_min_size});
+      Kokkos::deep_copy(
+          instances[s],
+          Kokkos::subview(counts_h[s], Kokkos::make_pair(0, num_owned)),
+          counts);
+
+      pending[s] = tt;
+    }
+    harvest(0);
+    harvest(1);
+  }
+  Kokkos::Profiling::popRegion();
+
+  // Second sweep: harvest the label-changing pairs of each chunk and replay
+  // them into the host union-find. Core-core pairs are merged; a pair of a
+  // core and a non-core point attaches the border point to the core one
+  // (merge_into(), so that a border point cannot bridge two clusters).
+  Kokkos::Profiling::pushRegion("ArborX::DBSCAN::out_of_core::clusters");
+  Details::UnionFind<Kokkos::HostSpace, /*DoSerial=*/true> union_find(labels);
+  {
+    Kokkos::View<char *, MemorySpace> is_core_d[2];
+    decltype(Kokkos::create_mirror_view(is_core_d[0])) is_core_h[2];
+    Kokkos::View<Kokkos::pair<int, int> *, MemorySpace> edges_d[2];
+    decltype(Kokkos::create_mirror_view(edges_d[0])) edges_h[2];
+    Kokkos::View<int, MemorySpace> num_edges_d[2];
+    decltype(Kokkos::create_mirror_view(num_edges_d[0])) num_edges_h[2];
+    for (int s = 0; s < 2; ++s)
+    {
+      is_core_d[s] = Kokkos::View<char *, MemorySpace>(
+          Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                             "ArborX::DBSCAN::chunk_is_core"),
+          max_chunk_size);
+      is_core_h[s] = Kokkos::create_mirror_view(is_core_d[s]);
+      edges_d[s] = Kokkos::View<Kokkos::pair<int, int> *, MemorySpace>(
+          Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                             "ArborX::DBSCAN::chunk_edges"),
+          std::max(1 << 16, 16 * max_chunk_size));
+      edges_h[s] = Kokkos::create_mirror_view(edges_d[s]);
+      num_edges_d[s] =
+          Kokkos::View<int, MemorySpace>("ArborX::DBSCAN::chunk_num_edges");
+      num_edges_h[s] = Kokkos::create_mirror_view(num_edges_d[s]);
+    }
+
+    int pending[2] = {-1, -1};
+    auto harvest = [&](int s) {
+      int const tt = pending[s];
+      if (tt < 0)
+        return;
+      instances[s].fence();
+
+      int const chunk_size = chunk_offsets[tt + 1] - chunk_offsets[tt];
+      int const num_owned = chunk_num_owned[tt];
+      int num_edges = num_edges_h[s]();
+      if (num_edges > (int)edges_d[s].size())
+      {
+        // The edge buffer overflowed; grow it to the now known size and
+        // rerun the traversal of this chunk
+        edges_d[s] = Kokkos::View<Kokkos::pair<int, int> *, MemorySpace>(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                               "ArborX::DBSCAN::chunk_edges"),
+            num_edges);
+        edges_h[s] = Kokkos::create_mirror_view(edges_d[s]);
+        Kokkos::deep_copy(instances[s], num_edges_d[s], 0);
+        Details::HalfTraversal(
+            instances[s], bvh[s],
+            Details::OutOfCoreEdgesCallback<MemorySpace>{
+                Kokkos::subview(is_core_d[s],
+                                Kokkos::make_pair(0, chunk_size)),
+                num_owned, edges_d[s], num_edges_d[s]},
+            Details::WithinRadiusGetter{eps});
+        Kokkos::deep_copy(instances[s], num_edges_h[s], num_edges_d[s]);
+        instances[s].fence();
+        num_edges = num_edges_h[s]();
+      }
+
+      Kokkos::deep_copy(
+          instances[s],
+          Kokkos::subview(edges_h[s], Kokkos::make_pair(0, num_edges)),
+          Kokkos::subview(edges_d[s], Kokkos::make_pair(0, num_edges)));
+      instances[s].fence();
+
+      int const *chunk = chunk_points.data() + chunk_offsets[tt];
+      for (int e = 0; e < num_edges; ++e)
+      {
+        int const gi = chunk[edges_h[s](e).first];
+        int const gj = chunk[edges_h[s](e).second];
+        if (is_core[gi] && is_core[gj])
+          union_find.merge(gi, gj);
+        else if (is_core[gi])
+          union_find.merge_into(gj, gi);
+        else
+          union_find.merge_into(gi, gj);
+      }
+      pending[s] = -1;
+    };
+
+    for (int tt = 0; tt < num_tiles; ++tt)
+    {
+      int const s = tt % 2;
+      harvest(s);
+
+      int const chunk_size = chunk_offsets[tt + 1] - chunk_offsets[tt];
+      int const num_owned = chunk_num_owned[tt];
+      for (int i = 0; i < chunk_size; ++i)
+      {
+        int const p = chunk_points[chunk_offsets[tt] + i];
+        chunk_points_h[s](i) = points(p);
+        is_core_h[s](i) = is_core[p];
+      }
+
+      auto chunk = Kokkos::subview(chunk_points_d[s],
+                                   Kokkos::make_pair(0, chunk_size));
+      Kokkos::deep_copy(instances[s], chunk,
+                        Kokkos::subview(chunk_points_h[s],
+                                        Kokkos::make_pair(0, chunk_size)));
+      auto chunk_is_core =
+          Kokkos::subview(is_core_d[s], Kokkos::make_pair(0, chunk_size));
+      Kokkos::deep_copy(
+          instances[s], chunk_is_core,
+          Kokkos::subview(is_core_h[s], Kokkos::make_pair(0, chunk_size)));
+
+      bvh[s] = BVH(instances[s], Experimental::attach_indices(chunk));
+
+      Kokkos::deep_copy(instances[s], num_edges_d[s], 0);
+#if defined(KOKKOS_COMPILER_NVCC) && (KOKKOS_COMPILER_NVCC < 1140)
+      // Workaround a compiler bug
+      Details::HalfTraversal<BVH,
+                             Details::OutOfCoreEdgesCallback<MemorySpace>,
+                             Details::WithinRadiusGetter>(
+#else
+      Details::HalfTraversal(
+#endif
+          instances[s], bvh[s],
+          Details::OutOfCoreEdgesCallback<MemorySpace>{
+              chunk_is_core, num_owned, edges_d[s], num_edges_d[s]},
+          Details::WithinRadiusGetter{eps});
+      Kokkos::deep_copy(instances[s], num_edges_h[s], num_edges_d[s]);
+
+      pending[s] = tt;
+    }
+    harvest(0);
+    harvest(1);
+  }
+
+  // Flatten the labels: cores point to their final representative, borders
+  // were assigned a core label that may since have been merged further, and
+  // untouched non-core points are noise
+  for (int i = 0; i < n; ++i)
+  {
+    if (is_core[i])
+      labels(i) = union_find.representative(i);
+    else if (labels(i) != i)
+      labels(i) = union_find.representative(labels(i));
+    else
+      labels(i) = -1;
+  }
+  Kokkos::Profiling::popRegion();
+
+  Kokkos::Profiling::popRegion();
+
+  return labels;
+}
+
+} // namespace Experimental
+} // namespace ArborX
+
+#endif
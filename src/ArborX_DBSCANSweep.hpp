@@ -0,0 +1,286 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DBSCAN_SWEEP_HPP
+#define ARBORX_DBSCAN_SWEEP_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_Callbacks.hpp>
+#include <ArborX_DBSCAN.hpp> // WithinRadiusGetter, DBSCANCorePoints
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsFDBSCAN.hpp>
+#include <ArborX_DetailsHalfTraversal.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsSortUtils.hpp>
+#include <ArborX_DetailsUnionFind.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_PairValueIndex.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm> // max_element
+#include <vector>
+
+namespace ArborX
+{
+
+namespace Details
+{
+
+// Edge-collecting callbacks of dbscanSweep: the first traversal sizes each
+// point's share of the edge list, the second one fills it
+template <typename MemorySpace>
+struct DBSCANSweepCountCallback
+{
+  Kokkos::View<int *, MemorySpace> _counts;
+
+  KOKKOS_FUNCTION auto operator()(int i, int) const
+  {
+    Kokkos::atomic_increment(&_counts(i));
+    return CallbackTreeTraversalControl::normal_continuation;
+  }
+};
+
+template <typename Points, typename MemorySpace>
+struct DBSCANSweepFillCallback
+{
+  Points _points;
+  Kokkos::View<int *, MemorySpace> _offsets;
+  Kokkos::View<int *, MemorySpace> _cursors;
+  Kokkos::View<int *, MemorySpace> _edges_i;
+  Kokkos::View<int *, MemorySpace> _edges_j;
+  Kokkos::View<float *, MemorySpace> _edge_distances;
+
+  KOKKOS_FUNCTION auto operator()(int i, int j) const
+  {
+    int const e = _offsets(i) + Kokkos::atomic_fetch_add(&_cursors(i), 1);
+    _edges_i(e) = i;
+    _edges_j(e) = j;
+    _edge_distances(e) = distance(_points(i), _points(j));
+    return CallbackTreeTraversalControl::normal_continuation;
+  }
+};
+
+} // namespace Details
+
+namespace Experimental
+{
+
+// Run DBSCAN at several eps values over a single tree build and a single
+// traversal. The tree is traversed once at the largest eps, collecting every
+// neighbor pair together with its distance; the labels for each requested
+// eps are then derived by replaying the prefix of the distance-sorted pair
+// list that falls within that eps, at the cost of one sweep over the prefix
+// per value instead of one tree build and traversal per value.
+//
+// The returned labelings are aligned with eps_values and each matches what
+// dbscan() would produce at that eps. The edge list at the largest eps has
+// to fit in memory, which is what bounds the usable range.
+template <typename ExecutionSpace, typename Primitives>
+std::vector<Kokkos::View<
+    int *, typename AccessTraits<Primitives, PrimitivesTag>::memory_space>>
+dbscanSweep(ExecutionSpace const &exec_space, Primitives const &primitives,
+            std::vector<float> const &eps_values, int core_min_size)
+{
+  Kokkos::Profiling::ScopedRegion guard("ArborX::DBSCANSweep");
+
+  namespace KokkosExt = Details::KokkosExt;
+
+  using Points = Details::AccessValues<Primitives, PrimitivesTag>;
+  using MemorySpace = typename Points::memory_space;
+
+  static_assert(
+      KokkosExt::is_accessible_from<MemorySpace, ExecutionSpace>::value,
+      "Primitives must be accessible from the execution space");
+
+  ARBORX_ASSERT(!eps_values.empty());
+  for (auto eps : eps_values)
+    ARBORX_ASSERT(eps > 0);
+  ARBORX_ASSERT(core_min_size >= 2);
+
+  float const eps_max =
+      *std::max_element(eps_values.begin(), eps_values.end());
+
+  using Point = typename Points::value_type;
+  static_assert(GeometryTraits::is_point<Point>{});
+
+  Points points{primitives};
+  int const n = points.size();
+
+  Kokkos::Profiling::pushRegion("ArborX::DBSCANSweep::tree_construction");
+  BoundingVolumeHierarchy<MemorySpace, PairValueIndex<Point>> bvh(
+      exec_space, Experimental::attach_indices(points));
+  Kokkos::Profiling::popRegion();
+
+  // Collect every neighbor pair within the largest eps, annotated with its
+  // distance
+  Kokkos::Profiling::pushRegion("ArborX::DBSCANSweep::collect_edges");
+  Kokkos::View<int *, MemorySpace> offsets(
+      Kokkos::view_alloc(exec_space, "ArborX::DBSCANSweep::offsets"), n + 1);
+  {
+#if defined(KOKKOS_COMPILER_NVCC) && (KOKKOS_COMPILER_NVCC < 1140)
+    // Workaround a compiler bug
+    using HalfTraversal = Details::HalfTraversal<
+        decltype(bvh), Details::DBSCANSweepCountCallback<MemorySpace>,
+        Details::WithinRadiusGetter>;
+#else
+    using Details::HalfTraversal;
+#endif
+    HalfTraversal(exec_space, bvh,
+                  Details::DBSCANSweepCountCallback<MemorySpace>{offsets},
+                  Details::WithinRadiusGetter{eps_max});
+  }
+  KokkosExt::exclusive_scan(exec_space, offsets, offsets, 0);
+  int const num_edges = KokkosExt::lastElement(exec_space, offsets);
+
+  Kokkos::View<int *, MemorySpace> cursors(
+      Kokkos::view_alloc(exec_space, "ArborX::DBSCANSweep::cursors"), n);
+  Kokkos::View<int *, MemorySpace> edges_i(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::DBSCANSweep::edges_i"),
+      num_edges);
+  Kokkos::View<int *, MemorySpace> edges_j(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::DBSCANSweep::edges_j"),
+      num_edges);
+  Kokkos::View<float *, MemorySpace> edge_distances(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::DBSCANSweep::edge_distances"),
+      num_edges);
+  {
+#if defined(KOKKOS_COMPILER_NVCC) && (KOKKOS_COMPILER_NVCC < 1140)
+    // Workaround a compiler bug
+    using HalfTraversal = Details::HalfTraversal<
+        decltype(bvh), Details::DBSCANSweepFillCallback<Points, MemorySpace>,
+        Details::WithinRadiusGetter>;
+#else
+    using Details::HalfTraversal;
+#endif
+    HalfTraversal(exec_space, bvh,
+                  Details::DBSCANSweepFillCallback<Points, MemorySpace>{
+                      points, offsets, cursors, edges_i, edges_j,
+                      edge_distances},
+                  Details::WithinRadiusGetter{eps_max});
+  }
+
+  // Order the pairs by distance so that every eps maps to a prefix
+  auto permute = Details::sortObjects(exec_space, edge_distances);
+  Details::applyPermutation(exec_space, permute, edges_i);
+  Details::applyPermutation(exec_space, permute, edges_j);
+  Kokkos::Profiling::popRegion();
+
+#ifdef KOKKOS_ENABLE_SERIAL
+  using UnionFind = Details::UnionFind<
+      MemorySpace,
+      /*DoSerial=*/std::is_same_v<ExecutionSpace, Kokkos::Serial>>;
+#else
+  using UnionFind = Details::UnionFind<MemorySpace>;
+#endif
+  using CorePoints = Details::DBSCANCorePoints<MemorySpace>;
+
+  std::vector<Kokkos::View<int *, MemorySpace>> all_labels;
+  all_labels.reserve(eps_values.size());
+
+  Kokkos::View<int *, MemorySpace> num_neigh(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::DBSCANSweep::num_neighbors"),
+      n);
+  for (auto eps : eps_values)
+  {
+    Kokkos::Profiling::ScopedRegion level_guard("ArborX::DBSCANSweep::level");
+
+    // Number of pairs within this eps (they form a prefix of the sorted
+    // pair list)
+    Kokkos::View<int, MemorySpace> cut("ArborX::DBSCANSweep::cut");
+    Kokkos::parallel_for(
+        "ArborX::DBSCANSweep::find_cut",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, 1),
+        KOKKOS_LAMBDA(int) {
+          int first = 0;
+          int last = num_edges;
+          while (first < last)
+          {
+            int const mid = first + (last - first) / 2;
+            if (edge_distances(mid) <= eps)
+              first = mid + 1;
+            else
+              last = mid;
+          }
+          cut() = first;
+        });
+    int num_edges_eps;
+    Kokkos::deep_copy(exec_space, num_edges_eps, cut);
+    exec_space.fence("ArborX::DBSCANSweep (cut copied to host)");
+
+    Kokkos::deep_copy(exec_space, num_neigh, 1); // a point is its own neighbor
+    Kokkos::parallel_for(
+        "ArborX::DBSCANSweep::count_neighbors",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_edges_eps),
+        KOKKOS_LAMBDA(int e) {
+          Kokkos::atomic_increment(&num_neigh(edges_i(e)));
+          Kokkos::atomic_increment(&num_neigh(edges_j(e)));
+        });
+
+    Kokkos::View<int *, MemorySpace> labels(
+        Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                           "ArborX::DBSCANSweep::labels"),
+        n);
+    KokkosExt::iota(exec_space, labels);
+
+    // Replay the prefix through the regular FDBSCAN callback; each pair
+    // shows up exactly once, just as in the half traversal
+    Details::FDBSCANCallback<UnionFind, CorePoints> callback{
+        UnionFind{labels}, CorePoints{num_neigh, core_min_size}};
+    Kokkos::parallel_for(
+        "ArborX::DBSCANSweep::clusters",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_edges_eps),
+        KOKKOS_LAMBDA(int e) { callback(edges_i(e), edges_j(e)); });
+
+    Kokkos::View<int *, MemorySpace> cluster_sizes(
+        Kokkos::view_alloc(exec_space, "ArborX::DBSCANSweep::cluster_sizes"),
+        n);
+    Kokkos::parallel_for(
+        "ArborX::DBSCANSweep::finalize_labels",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+        KOKKOS_LAMBDA(int const i) {
+          // ##### ECL license (see LICENSE.ECL) #####
+          int next;
+          int vstat = labels(i);
+          int const old = vstat;
+          while (vstat > (next = labels(vstat)))
+          {
+            vstat = next;
+          }
+          if (vstat != old)
+            labels(i) = vstat;
+
+          Kokkos::atomic_increment(&cluster_sizes(labels(i)));
+        });
+    CorePoints is_core{num_neigh, core_min_size};
+    Kokkos::parallel_for(
+        "ArborX::DBSCANSweep::mark_noise",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+        KOKKOS_LAMBDA(int const i) {
+          if (cluster_sizes(labels(i)) == 1 && !is_core(i))
+            labels(i) = -1;
+        });
+
+    all_labels.push_back(labels);
+  }
+
+  return all_labels;
+}
+
+} // namespace Experimental
+} // namespace ArborX
+
+#endif
@@ -0,0 +1,509 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DISTRIBUTED_DBSCAN_HPP
+#define ARBORX_DISTRIBUTED_DBSCAN_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_DBSCAN.hpp>
+#include <ArborX_DetailsDistributedTreeUtils.hpp>
+#include <ArborX_DetailsDistributor.hpp>
+#include <ArborX_DetailsFDBSCAN.hpp>
+#include <ArborX_DetailsHalfTraversal.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsTreeConstruction.hpp>
+#include <ArborX_DetailsUnionFind.hpp>
+#include <ArborX_HyperBox.hpp>
+#include <ArborX_IndexableGetter.hpp>
+#include <ArborX_LinearBVH.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <climits>
+#include <vector>
+
+#include <mpi.h>
+
+namespace ArborX::Experimental
+{
+
+// Distributed flavor of ArborX::dbscan(). Every rank contributes its local
+// points, and receives one label per local point. A label is the smallest
+// global id over the core points of the cluster, where the global id of a
+// point encodes its owning rank in the upper 32 bits and its local index in
+// the lower ones; noise points are labeled -1. The produced clusters are
+// identical to what a serial run over the union of all points would produce
+// (up to the usual ambiguity of a border point within eps of several
+// clusters).
+//
+// The algorithm ghosts every point onto the ranks whose domain comes within
+// eps of it, so that each rank sees the full eps-neighborhood of its own
+// points and can run the regular FDBSCAN locally. Clusters spanning several
+// ranks are then stitched together by iteratively exchanging cluster
+// representatives through the ghost points until a fixed point is reached,
+// which takes a number of rounds bounded by the rank-diameter of the widest
+// cluster. Only core points participate in the stitching: a border point may
+// legitimately be assigned to different clusters on different ranks, and
+// letting it carry representatives across would fuse clusters that merely
+// share a border point.
+//
+// Must be called collectively. The dense-box implementation is not available
+// in the distributed setting, the implementation parameter is ignored.
+template <typename ExecutionSpace, typename Primitives>
+Kokkos::View<long long *,
+             typename AccessTraits<Primitives, PrimitivesTag>::memory_space>
+dbscan(MPI_Comm comm, ExecutionSpace const &space, Primitives const &primitives,
+       float eps, int core_min_size,
+       DBSCAN::Parameters const & = DBSCAN::Parameters())
+{
+  Kokkos::Profiling::pushRegion("ArborX::DistributedDBSCAN");
+
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+
+  using Points = Details::AccessValues<Primitives, PrimitivesTag>;
+  using MemorySpace = typename Points::memory_space;
+
+  static_assert(
+      KokkosExt::is_accessible_from<MemorySpace, ExecutionSpace>::value,
+      "Primitives must be accessible from the execution space");
+
+  ARBORX_ASSERT(eps > 0);
+  ARBORX_ASSERT(core_min_size >= 2);
+
+#ifdef KOKKOS_ENABLE_SERIAL
+  using UnionFind = Details::UnionFind<
+      MemorySpace,
+      /*DoSerial=*/std::is_same_v<ExecutionSpace, Kokkos::Serial>>;
+#else
+  using UnionFind = Details::UnionFind<MemorySpace>;
+#endif
+
+  using Point = typename Points::value_type;
+  static_assert(GeometryTraits::is_point<Point>{});
+  constexpr int dim = GeometryTraits::dimension_v<Point>;
+  using Box = ExperimentalHyperGeometry::Box<dim>;
+
+  bool const is_special_case = (core_min_size == 2);
+
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+  int comm_size;
+  MPI_Comm_size(comm, &comm_size);
+
+  Points points{primitives};
+  int const n = points.size();
+
+  Kokkos::Profiling::pushRegion("ArborX::DistributedDBSCAN::ghost_points");
+
+  // Gather the rank bounding boxes; together with eps they determine which
+  // local points must be ghosted to which neighbor.
+  Box local_box;
+  Details::TreeConstruction::calculateBoundingBoxOfTheScene(
+      space, Details::Indexables<Points, Details::DefaultIndexableGetter>{
+                 points, Details::DefaultIndexableGetter{}},
+      local_box);
+  space.fence("ArborX::DistributedDBSCAN (local bounds ready before"
+              " MPI_Allgather)");
+  std::vector<Box> rank_boxes(comm_size);
+  MPI_Allgather(&local_box, sizeof(Box), MPI_BYTE, rank_boxes.data(),
+                sizeof(Box), MPI_BYTE, comm);
+
+  // Only ranks whose domain comes within eps of ours can receive ghosts.
+  // Ranks holding no points have invalid boxes and fail the check.
+  std::vector<int> candidates_host;
+  for (int r = 0; r < comm_size; ++r)
+    if (r != comm_rank && Details::distance(rank_boxes[r], local_box) <= eps)
+      candidates_host.push_back(r);
+  int const n_candidates = candidates_host.size();
+
+  auto candidate_ranks =
+      Details::DistributedTree::copyVectorToView<ExecutionSpace, MemorySpace>(
+          space, candidates_host,
+          "ArborX::DistributedDBSCAN::candidate_ranks");
+  Kokkos::View<Box *, MemorySpace> candidate_boxes(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedDBSCAN::candidate_boxes"),
+      n_candidates);
+  {
+    auto candidate_boxes_host = Kokkos::create_mirror_view(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, Kokkos::HostSpace{}),
+        candidate_boxes);
+    for (int c = 0; c < n_candidates; ++c)
+      candidate_boxes_host(c) = rank_boxes[candidates_host[c]];
+    Kokkos::deep_copy(space, candidate_boxes, candidate_boxes_host);
+  }
+
+  // A point is exported to every candidate rank whose box it comes within
+  // eps of
+  Kokkos::View<int *, MemorySpace> export_offsets(
+      Kokkos::view_alloc(space, "ArborX::DistributedDBSCAN::export_offsets"),
+      n + 1);
+  Kokkos::parallel_for(
+      "ArborX::DistributedDBSCAN::count_exports",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        int count = 0;
+        for (int c = 0; c < n_candidates; ++c)
+          if (Details::distance(points(i), candidate_boxes(c)) <= eps)
+            ++count;
+        export_offsets(i) = count;
+      });
+  KokkosExt::exclusive_scan(space, export_offsets, export_offsets, 0);
+  int const n_exports = KokkosExt::lastElement(space, export_offsets);
+
+  Kokkos::View<int *, MemorySpace> export_ranks(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedDBSCAN::export_ranks"),
+      n_exports);
+  Kokkos::View<int *, MemorySpace> export_ids(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedDBSCAN::export_ids"),
+      n_exports);
+  Kokkos::View<Point *, MemorySpace> export_points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedDBSCAN::export_points"),
+      n_exports);
+  Kokkos::parallel_for(
+      "ArborX::DistributedDBSCAN::fill_exports",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        int k = export_offsets(i);
+        for (int c = 0; c < n_candidates; ++c)
+          if (Details::distance(points(i), candidate_boxes(c)) <= eps)
+          {
+            export_ranks(k) = candidate_ranks(c);
+            export_ids(k) = i;
+            export_points(k) = points(i);
+            ++k;
+          }
+      });
+
+  // The distributor layout is deterministic, so later exchanges of
+  // per-export data (core status, cluster representatives) arrive in the
+  // same order as the ghost points themselves
+  Details::Distributor<MemorySpace> distributor(comm);
+  int const n_ghosts = distributor.createFromSends(space, export_ranks);
+
+  Kokkos::View<Point *, MemorySpace> ghost_points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedDBSCAN::ghost_points"),
+      n_ghosts);
+  Details::DistributedTree::sendAcrossNetwork(space, distributor,
+                                              export_points, ghost_points);
+  Kokkos::View<int *, MemorySpace> ghost_ids(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedDBSCAN::ghost_ids"),
+      n_ghosts);
+  Details::DistributedTree::sendAcrossNetwork(space, distributor, export_ids,
+                                              ghost_ids);
+  Kokkos::View<int *, MemorySpace> ghost_owners(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedDBSCAN::ghost_owners"),
+      n_ghosts);
+  Details::DistributedTree::fillImportRanks(space, distributor, ghost_owners);
+
+  Kokkos::View<Point *, MemorySpace> combined_points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedDBSCAN::points"),
+      n + n_ghosts);
+  Kokkos::parallel_for(
+      "ArborX::DistributedDBSCAN::copy_local_points",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) { combined_points(i) = points(i); });
+  Kokkos::deep_copy(
+      space,
+      Kokkos::subview(combined_points, Kokkos::make_pair(n, n + n_ghosts)),
+      ghost_points);
+
+  Kokkos::Profiling::popRegion();
+
+  // Run the regular FDBSCAN over the local points plus the ghosts. The
+  // eps-neighborhood of every local point is fully present, so the local
+  // neighbor counts and cluster merges agree with a serial run; only the
+  // cluster names need global reconciliation afterwards.
+  Kokkos::Profiling::pushRegion("ArborX::DistributedDBSCAN::tree_construction");
+  BoundingVolumeHierarchy<MemorySpace, PairValueIndex<Point>> bvh(
+      space, attach_indices(combined_points));
+  Kokkos::Profiling::popRegion();
+
+  Kokkos::View<int *, MemorySpace> labels(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedDBSCAN::local_labels"),
+      n + n_ghosts);
+  KokkosExt::iota(space, labels);
+
+  Kokkos::View<int *, MemorySpace> num_neigh(
+      "ArborX::DistributedDBSCAN::num_neighbors", 0);
+
+  Kokkos::Profiling::pushRegion("ArborX::DistributedDBSCAN::clusters");
+  if (is_special_case)
+  {
+    // Perform the queries and build clusters through callback
+    using CorePoints = Details::CCSCorePoints;
+#if defined(KOKKOS_COMPILER_NVCC) && (KOKKOS_COMPILER_NVCC < 1140)
+    // Workaround a compiler bug
+    using HalfTraversal = Details::HalfTraversal<
+        decltype(bvh), Details::FDBSCANCallback<UnionFind, CorePoints>,
+        Details::WithinRadiusGetter>;
+#else
+    using Details::HalfTraversal;
+#endif
+    Kokkos::Profiling::pushRegion("ArborX::DistributedDBSCAN::clusters::query");
+    HalfTraversal(
+        space, bvh,
+        Details::FDBSCANCallback<UnionFind, CorePoints>{labels, CorePoints{}},
+        Details::WithinRadiusGetter{eps});
+    Kokkos::Profiling::popRegion();
+  }
+  else
+  {
+    auto const predicates = Details::PrimitivesWithRadius<Points>{points, eps};
+
+    // Determine core points. The counts are only valid for the local points;
+    // a ghost's neighborhood extends past the halo, so its status is fetched
+    // from the owner below.
+    Kokkos::Profiling::pushRegion(
+        "ArborX::DistributedDBSCAN::clusters::num_neigh");
+    Kokkos::resize(Kokkos::view_alloc(space), num_neigh, n + n_ghosts);
+    bvh.query(space, predicates,
+              Details::CountUpToN<MemorySpace>{num_neigh, core_min_size});
+
+    Kokkos::View<int *, MemorySpace> export_core(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::DistributedDBSCAN::export_core"),
+        n_exports);
+    int const core_min = core_min_size;
+    Kokkos::parallel_for(
+        "ArborX::DistributedDBSCAN::fill_export_core",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_exports),
+        KOKKOS_LAMBDA(int k) {
+          export_core(k) = (num_neigh(export_ids(k)) >= core_min) ? INT_MAX : 0;
+        });
+    Kokkos::View<int *, MemorySpace> ghost_core(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::DistributedDBSCAN::ghost_core"),
+        n_ghosts);
+    Details::DistributedTree::sendAcrossNetwork(space, distributor,
+                                                export_core, ghost_core);
+    Kokkos::parallel_for(
+        "ArborX::DistributedDBSCAN::set_ghost_core_status",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_ghosts),
+        KOKKOS_LAMBDA(int g) { num_neigh(n + g) = ghost_core(g); });
+    Kokkos::Profiling::popRegion();
+
+    using CorePoints = Details::DBSCANCorePoints<MemorySpace>;
+#if defined(KOKKOS_COMPILER_NVCC) && (KOKKOS_COMPILER_NVCC < 1140)
+    // Workaround a compiler bug
+    using HalfTraversal = Details::HalfTraversal<
+        decltype(bvh), Details::FDBSCANCallback<UnionFind, CorePoints>,
+        Details::WithinRadiusGetter>;
+#else
+    using Details::HalfTraversal;
+#endif
+
+    // Perform the queries and build clusters through callback
+    Kokkos::Profiling::pushRegion("ArborX::DistributedDBSCAN::clusters::query");
+    HalfTraversal(space, bvh,
+                  Details::FDBSCANCallback<UnionFind, CorePoints>{
+                      labels, CorePoints{num_neigh, core_min_size}},
+                  Details::WithinRadiusGetter{eps});
+    Kokkos::Profiling::popRegion();
+  }
+
+  // Flatten the labels and mark the noise, exactly as in ArborX::dbscan().
+  // The counts over the combined set are exact: a local point whose only
+  // neighbors live on another rank still sees them as ghosts.
+  Kokkos::View<int *, MemorySpace> cluster_sizes(
+      Kokkos::view_alloc(space, "ArborX::DistributedDBSCAN::cluster_sizes"),
+      n + n_ghosts);
+  Kokkos::parallel_for(
+      "ArborX::DistributedDBSCAN::finalize_labels",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n + n_ghosts),
+      KOKKOS_LAMBDA(int const i) {
+        // ##### ECL license (see LICENSE.ECL) #####
+        int next;
+        int vstat = labels(i);
+        int const old = vstat;
+        while (vstat > (next = labels(vstat)))
+        {
+          vstat = next;
+        }
+        if (vstat != old)
+          labels(i) = vstat;
+
+        Kokkos::atomic_increment(&cluster_sizes(labels(i)));
+      });
+  if (is_special_case)
+  {
+    Kokkos::parallel_for(
+        "ArborX::DistributedDBSCAN::mark_noise",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n + n_ghosts),
+        KOKKOS_LAMBDA(int const i) {
+          if (cluster_sizes(labels(i)) == 1)
+            labels(i) = -1;
+        });
+    // With minpts equal to two, any point that ended up in a cluster has a
+    // neighbor and therefore is a core point. This reconstructs the valid
+    // is_core() that is missing during the clustering phase (see the note in
+    // ArborX::dbscan()), which the label reconciliation below relies on.
+    Kokkos::resize(Kokkos::view_alloc(space), num_neigh, n + n_ghosts);
+    Kokkos::parallel_for(
+        "ArborX::DistributedDBSCAN::set_core_status",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n + n_ghosts),
+        KOKKOS_LAMBDA(int const i) {
+          num_neigh(i) = (labels(i) >= 0 ? INT_MAX : 0);
+        });
+  }
+  else
+  {
+    Details::DBSCANCorePoints<MemorySpace> is_core{num_neigh, core_min_size};
+    Kokkos::parallel_for(
+        "ArborX::DistributedDBSCAN::mark_noise",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n + n_ghosts),
+        KOKKOS_LAMBDA(int const i) {
+          if (cluster_sizes(labels(i)) == 1 && !is_core(i))
+            labels(i) = -1;
+        });
+  }
+  Kokkos::Profiling::popRegion();
+
+  // Reconcile the cluster names across ranks. Each local cluster tracks the
+  // smallest global id over its core members, and a point and its ghost
+  // copies keep exchanging that representative between the owner and the
+  // holders until nothing decreases anywhere. Border points are deliberately
+  // left out: their cluster assignment is allowed to differ between ranks.
+  Kokkos::Profiling::pushRegion("ArborX::DistributedDBSCAN::merge_labels");
+
+  Details::DBSCANCorePoints<MemorySpace> is_core{num_neigh, core_min_size};
+
+  Kokkos::View<long long *, MemorySpace> cluster_rep(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedDBSCAN::cluster_rep"),
+      n + n_ghosts);
+  Kokkos::deep_copy(space, cluster_rep, LLONG_MAX);
+  Kokkos::parallel_for(
+      "ArborX::DistributedDBSCAN::init_cluster_rep",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n + n_ghosts),
+      KOKKOS_LAMBDA(int i) {
+        if (labels(i) < 0 || !is_core(i))
+          return;
+        long long const gid =
+            (i < n) ? (((long long)comm_rank << 32) | i)
+                    : (((long long)ghost_owners(i - n) << 32) |
+                       ghost_ids(i - n));
+        Kokkos::atomic_min(&cluster_rep(labels(i)), gid);
+      });
+
+  // The reverse exchange, from the holders of the ghosts back to their
+  // owners. Shipping the owner-local ids once establishes which point each
+  // entry of the subsequent representative exchanges refers to.
+  Details::Distributor<MemorySpace> inverse_distributor(comm);
+  int const n_returns = inverse_distributor.createFromSends(space, ghost_owners);
+  Kokkos::View<int *, MemorySpace> return_ids(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedDBSCAN::return_ids"),
+      n_returns);
+  Details::DistributedTree::sendAcrossNetwork(space, inverse_distributor,
+                                              ghost_ids, return_ids);
+
+  Kokkos::View<long long *, MemorySpace> fwd_exports(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedDBSCAN::fwd_exports"),
+      n_exports);
+  Kokkos::View<long long *, MemorySpace> fwd_imports(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedDBSCAN::fwd_imports"),
+      n_ghosts);
+  Kokkos::View<long long *, MemorySpace> bwd_exports(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedDBSCAN::bwd_exports"),
+      n_ghosts);
+  Kokkos::View<long long *, MemorySpace> bwd_imports(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedDBSCAN::bwd_imports"),
+      n_returns);
+  while (true)
+  {
+    // Owners push the current representatives to the ghost copies
+    Kokkos::parallel_for(
+        "ArborX::DistributedDBSCAN::fill_fwd_exports",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_exports),
+        KOKKOS_LAMBDA(int k) {
+          int const i = export_ids(k);
+          fwd_exports(k) = (labels(i) >= 0 && is_core(i))
+                               ? cluster_rep(labels(i))
+                               : LLONG_MAX;
+        });
+    Details::DistributedTree::sendAcrossNetwork(space, distributor,
+                                                fwd_exports, fwd_imports);
+    int changed_fwd = 0;
+    Kokkos::parallel_reduce(
+        "ArborX::DistributedDBSCAN::apply_fwd_imports",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_ghosts),
+        KOKKOS_LAMBDA(int g, int &update) {
+          int const root = labels(n + g);
+          if (root < 0 || !is_core(n + g))
+            return;
+          auto const rep = fwd_imports(g);
+          if (rep < Kokkos::atomic_fetch_min(&cluster_rep(root), rep))
+            update = 1;
+        },
+        changed_fwd);
+
+    // The holders push theirs back to the owners
+    Kokkos::parallel_for(
+        "ArborX::DistributedDBSCAN::fill_bwd_exports",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_ghosts),
+        KOKKOS_LAMBDA(int g) {
+          int const root = labels(n + g);
+          bwd_exports(g) = (root >= 0 && is_core(n + g)) ? cluster_rep(root)
+                                                         : LLONG_MAX;
+        });
+    Details::DistributedTree::sendAcrossNetwork(space, inverse_distributor,
+                                                bwd_exports, bwd_imports);
+    int changed_bwd = 0;
+    Kokkos::parallel_reduce(
+        "ArborX::DistributedDBSCAN::apply_bwd_imports",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_returns),
+        KOKKOS_LAMBDA(int e, int &update) {
+          int const i = return_ids(e);
+          if (labels(i) < 0 || !is_core(i))
+            return;
+          auto const rep = bwd_imports(e);
+          if (rep < Kokkos::atomic_fetch_min(&cluster_rep(labels(i)), rep))
+            update = 1;
+        },
+        changed_bwd);
+
+    int changed = changed_fwd + changed_bwd;
+    MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_SUM, comm);
+    if (changed == 0)
+      break;
+  }
+  Kokkos::Profiling::popRegion();
+
+  Kokkos::View<long long *, MemorySpace> global_labels(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedDBSCAN::labels"),
+      n);
+  Kokkos::parallel_for(
+      "ArborX::DistributedDBSCAN::assign_global_labels",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        global_labels(i) = (labels(i) < 0 ? -1 : cluster_rep(labels(i)));
+      });
+
+  Kokkos::Profiling::popRegion();
+
+  return global_labels;
+}
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -14,20 +14,63 @@
 
 #include <ArborX_AccessTraits.hpp>
 #include <ArborX_Box.hpp>
+#include <ArborX_DetailsAlgorithms.hpp>
 #include <ArborX_DetailsDistributedTreeNearest.hpp>
 #include <ArborX_DetailsDistributedTreeSpatial.hpp>
+#include <ArborX_DetailsGpuAwareMpi.hpp>
+#include <ArborX_DetailsHappyTreeFriends.hpp>
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_Exception.hpp>
 #include <ArborX_LinearBVH.hpp>
+#include <ArborX_QueryRequest.hpp>
 
 #include <Kokkos_Core.hpp>
 
+#include <algorithm>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <mpi.h>
 
 namespace ArborX
 {
 
+namespace Experimental
+{
+// Tag selecting the hierarchical top tree of the DistributedTree
+// constructor. Ranks are grouped into contiguous groups of group_size;
+// every rank replicates a supertree over one box per group plus the
+// subtree of its own group, so top-tree memory and traversal cost grow
+// with the group size and the group count instead of the world size.
+// A sensible group size is the number of ranks per node.
+struct HierarchicalTopTree
+{
+  int group_size;
+};
+
+// Tag selecting the fragmented top tree of the DistributedTree constructor.
+// Every rank is represented in the replicated top tree by up to
+// fragments_per_rank boxes carved out of the upper levels of its local tree
+// instead of by a single bounding box. The tighter summaries shrink both the
+// number of ranks a predicate is forwarded to and the remote traversal
+// volume, at the price of a top tree that is fragments_per_rank times
+// larger. Only spatial queries are supported in this mode for now.
+struct FragmentedTopTree
+{
+  int fragments_per_rank;
+};
+
+// Tag selecting the replicated mode of the DistributedTree constructor.
+// Every rank gathers the primitives of all ranks once and builds the entire
+// tree locally, so queries involve no per-query communication at all. Meant
+// for small global datasets queried by large predicate counts, where the
+// forwarding machinery is pure overhead; memory and build time scale with
+// the global primitive count on every rank.
+struct ReplicatedTree
+{};
+} // namespace Experimental
+
 // NOTE: query() must be called as collective over all processes in the
 // communicator passed to the constructor
 template <typename MemorySpace>
@@ -43,9 +86,40 @@ public:
   DistributedTree(MPI_Comm comm, ExecutionSpace const &space,
                   Primitives const &primitives);
 
+  // Hierarchical variant for large communicators (see
+  // Experimental::HierarchicalTopTree). Only spatial queries are supported
+  // in this mode for now; a query destined to a remote group is routed
+  // through that group's first rank, which expands it to the member ranks.
+  template <typename ExecutionSpace, typename Primitives>
+  DistributedTree(MPI_Comm comm, ExecutionSpace const &space,
+                  Primitives const &primitives,
+                  Experimental::HierarchicalTopTree mode);
+
+  // Variant replicating several box fragments per rank instead of one
+  // bounding box (see Experimental::FragmentedTopTree). Only spatial
+  // queries are supported in this mode for now.
+  template <typename ExecutionSpace, typename Primitives>
+  DistributedTree(MPI_Comm comm, ExecutionSpace const &space,
+                  Primitives const &primitives,
+                  Experimental::FragmentedTopTree mode);
+
+  // Variant holding the whole tree on every rank (see
+  // Experimental::ReplicatedTree). The output format is unchanged: results
+  // carry owner-local indices and owning ranks. Only spatial queries are
+  // supported in this mode for now.
+  template <typename ExecutionSpace, typename Primitives>
+  DistributedTree(MPI_Comm comm, ExecutionSpace const &space,
+                  Primitives const &primitives,
+                  Experimental::ReplicatedTree mode);
+
   // Return the smallest axis-aligned box able to contain all the objects
   // stored in the tree or an invalid box if the tree is empty.
-  bounding_volume_type bounds() const noexcept { return _top_tree.bounds(); }
+  bounding_volume_type bounds() const noexcept
+  {
+    if (_replicated)
+      return _bottom_tree.bounds();
+    return _group_size > 0 ? _super_tree.bounds() : _top_tree.bounds();
+  }
 
   // Return the global number of objects stored in the tree
   size_type size() const noexcept { return _top_tree_size; }
@@ -88,9 +162,57 @@ public:
                                                 std::forward<Args>(args)...);
   }
 
+  // Asynchronous variant of query() for spatial predicates. Returns a
+  // request handle as soon as the predicates destined to other processes
+  // have been posted and the local traversal has been launched on `space`,
+  // so that independent work can overlap with the communication. The results
+  // appear in the output views passed here once the handle completes; those
+  // views must stay alive until then, and every process must drive its
+  // handle to completion (see Experimental::QueryRequest).
+  template <typename ExecutionSpace, typename UserPredicates, typename... Args>
+  Experimental::QueryRequest queryAsync(ExecutionSpace const &space,
+                                        UserPredicates const &user_predicates,
+                                        Args &&...args) const
+  {
+    static_assert(
+        Details::KokkosExt::is_accessible_from<MemorySpace,
+                                               ExecutionSpace>::value);
+
+    using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+    static_assert(Details::KokkosExt::is_accessible_from<
+                      typename Predicates::memory_space, ExecutionSpace>::value,
+                  "Predicates must be accessible from the execution space");
+
+    Predicates predicates{user_predicates};
+
+    using Tag = typename Predicates::value_type::Tag;
+    return Details::DistributedTreeImpl::queryDispatchAsync(
+        Tag{}, *this, space, predicates, std::forward<Args>(args)...);
+  }
+
+  // Write the tree to a set of binary files sharing the given prefix: every
+  // rank writes its local tree to "<prefix>.bottom.<rank>" and rank 0 writes
+  // the replicated top tree to "<prefix>.top" (see
+  // BoundingVolumeHierarchy::saveToFile() for the file format and its
+  // portability caveats). Collective; when it returns, all the files are
+  // complete. Only trees built with the default constructor are supported.
+  void saveToFile(std::string const &prefix) const;
+
+  // Restore a tree written by saveToFile() on a communicator of the same
+  // size. Both tree constructions and the exchange of the rank bounding
+  // boxes are replaced by parallel file reads; only the gathering of the
+  // local tree sizes still communicates. Collective.
+  template <typename ExecutionSpace>
+  static DistributedTree loadFromFile(MPI_Comm comm,
+                                      ExecutionSpace const &space,
+                                      std::string const &prefix);
+
 private:
   friend struct Details::DistributedTreeImpl;
 
+  // Used by loadFromFile()
+  DistributedTree() = default;
+
   MPI_Comm getComm() const { return *_comm_ptr; }
 
   std::shared_ptr<MPI_Comm> _comm_ptr;
@@ -98,18 +220,31 @@ private:
   BVH<MemorySpace> _bottom_tree; // local
   size_type _top_tree_size;
   Kokkos::View<size_type *, MemorySpace> _bottom_tree_sizes;
+
+  // Hierarchical mode (inactive when _group_size == 0)
+  BVH<MemorySpace> _super_tree; // replicated, one box per group
+  BVH<MemorySpace> _group_tree; // one box per rank of this rank's group
+  int _group_size = 0;
+
+  // Number of top tree boxes per rank (see Experimental::FragmentedTopTree)
+  int _n_fragments = 1;
+
+  // Replicated mode (see Experimental::ReplicatedTree): the bottom tree
+  // holds the primitives of all ranks, in rank order, and there is no top
+  // tree. _rank_offset is the exclusive scan of the per-rank primitive
+  // counts, used to map global indices back to owner-local ones.
+  bool _replicated = false;
+  Kokkos::View<int *, MemorySpace> _rank_offset;
+
+  void setupCommunicator(MPI_Comm comm);
+
+  template <typename ExecutionSpace>
+  void setupCommunicatorAndSizes(MPI_Comm comm, ExecutionSpace const &space);
 };
 
 template <typename MemorySpace>
-template <typename ExecutionSpace, typename Primitives>
-DistributedTree<MemorySpace>::DistributedTree(MPI_Comm comm,
-                                              ExecutionSpace const &space,
-                                              Primitives const &primitives)
+void DistributedTree<MemorySpace>::setupCommunicator(MPI_Comm comm)
 {
-  Kokkos::Profiling::pushRegion("ArborX::DistributedTree::DistributedTree");
-
-  static_assert(Kokkos::is_execution_space<ExecutionSpace>::value);
-
   // Create new context for the library to isolate library's communication from
   // user's
   _comm_ptr.reset(
@@ -125,6 +260,53 @@ DistributedTree<MemorySpace>::DistributedTree(MPI_Comm comm,
         MPI_Comm_free(p);
         delete p;
       });
+}
+
+template <typename MemorySpace>
+template <typename ExecutionSpace>
+void DistributedTree<MemorySpace>::setupCommunicatorAndSizes(
+    MPI_Comm comm, ExecutionSpace const &space)
+{
+  setupCommunicator(comm);
+
+  Kokkos::Profiling::pushRegion("ArborX::DistributedTree::DistributedTree::"
+                                "size_calculation");
+
+  int comm_rank;
+  MPI_Comm_rank(getComm(), &comm_rank);
+  int comm_size;
+  MPI_Comm_size(getComm(), &comm_size);
+
+  Kokkos::DefaultHostExecutionSpace host_exec;
+  _bottom_tree_sizes = Kokkos::View<size_type *, MemorySpace>(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedTree::"
+                         "leave_count_in_local_trees"),
+      comm_size);
+  auto bottom_tree_sizes_host = Kokkos::create_mirror_view(
+      Kokkos::view_alloc(host_exec, Kokkos::WithoutInitializing),
+      _bottom_tree_sizes);
+  host_exec.fence();
+  bottom_tree_sizes_host(comm_rank) = _bottom_tree.size();
+  MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+                static_cast<void *>(bottom_tree_sizes_host.data()),
+                sizeof(size_type), MPI_BYTE, getComm());
+  Kokkos::deep_copy(space, _bottom_tree_sizes, bottom_tree_sizes_host);
+
+  _top_tree_size = Details::KokkosExt::reduce(space, _bottom_tree_sizes, 0);
+
+  Kokkos::Profiling::popRegion();
+}
+
+template <typename MemorySpace>
+template <typename ExecutionSpace, typename Primitives>
+DistributedTree<MemorySpace>::DistributedTree(MPI_Comm comm,
+                                              ExecutionSpace const &space,
+                                              Primitives const &primitives)
+{
+  Kokkos::Profiling::pushRegion("ArborX::DistributedTree::DistributedTree");
+
+  static_assert(Kokkos::is_execution_space<ExecutionSpace>::value);
 
   Kokkos::Profiling::pushRegion("ArborX::DistributedTree::DistributedTree::"
                                 "bottom_tree_construction");
@@ -132,6 +314,9 @@ DistributedTree<MemorySpace>::DistributedTree(MPI_Comm comm,
   _bottom_tree = BVH<MemorySpace>(space, primitives);
 
   Kokkos::Profiling::popRegion();
+
+  setupCommunicatorAndSizes(comm, space);
+
   Kokkos::Profiling::pushRegion("ArborX::DistributedTree::DistributedTree::"
                                 "top_tree_construction");
 
@@ -147,53 +332,464 @@ DistributedTree<MemorySpace>::DistributedTree(MPI_Comm comm,
       comm_size);
 
   Kokkos::DefaultHostExecutionSpace host_exec;
-#ifdef ARBORX_ENABLE_GPU_AWARE_MPI
-  Kokkos::deep_copy(space, Kokkos::subview(boxes, comm_rank),
-                    _bottom_tree.bounds());
-  space.fence("ArborX::DistributedTree::DistributedTree"
-              " (fill on device done before MPI_Allgather)");
+  if (Details::hasGpuAwareMpiSupport())
+  {
+    Kokkos::deep_copy(space, Kokkos::subview(boxes, comm_rank),
+                      _bottom_tree.bounds());
+    space.fence("ArborX::DistributedTree::DistributedTree"
+                " (fill on device done before MPI_Allgather)");
+
+    MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+                  static_cast<void *>(boxes.data()), sizeof(Box), MPI_BYTE,
+                  getComm());
+  }
+  else
+  {
+    auto boxes_host = Kokkos::create_mirror_view(
+        Kokkos::view_alloc(host_exec, Kokkos::WithoutInitializing), boxes);
+    host_exec.fence();
+    boxes_host(comm_rank) = _bottom_tree.bounds();
 
-  MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
-                static_cast<void *>(boxes.data()), sizeof(Box), MPI_BYTE,
-                getComm());
-#else
-  auto boxes_host = Kokkos::create_mirror_view(
-      Kokkos::view_alloc(host_exec, Kokkos::WithoutInitializing), boxes);
-  host_exec.fence();
-  boxes_host(comm_rank) = _bottom_tree.bounds();
+    MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+                  static_cast<void *>(boxes_host.data()), sizeof(Box),
+                  MPI_BYTE, getComm());
 
-  MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
-                static_cast<void *>(boxes_host.data()), sizeof(Box), MPI_BYTE,
-                getComm());
+    Kokkos::deep_copy(space, boxes, boxes_host);
+  }
 
-  Kokkos::deep_copy(space, boxes, boxes_host);
-#endif
+  _top_tree = BVH<MemorySpace>{space, boxes};
+
+  Kokkos::Profiling::popRegion();
+  Kokkos::Profiling::popRegion();
+}
+
+template <typename MemorySpace>
+template <typename ExecutionSpace, typename Primitives>
+DistributedTree<MemorySpace>::DistributedTree(
+    MPI_Comm comm, ExecutionSpace const &space, Primitives const &primitives,
+    Experimental::HierarchicalTopTree mode)
+{
+  Kokkos::Profiling::pushRegion("ArborX::DistributedTree::DistributedTree");
+
+  static_assert(Kokkos::is_execution_space<ExecutionSpace>::value);
+  ARBORX_ASSERT(mode.group_size > 0);
+
+  Kokkos::Profiling::pushRegion("ArborX::DistributedTree::DistributedTree::"
+                                "bottom_tree_construction");
+
+  _bottom_tree = BVH<MemorySpace>(space, primitives);
+
+  Kokkos::Profiling::popRegion();
+
+  setupCommunicatorAndSizes(comm, space);
+
+  Kokkos::Profiling::pushRegion("ArborX::DistributedTree::DistributedTree::"
+                                "top_tree_construction");
+
+  int comm_rank;
+  MPI_Comm_rank(getComm(), &comm_rank);
+  int comm_size;
+  MPI_Comm_size(getComm(), &comm_size);
+
+  _group_size = std::min(mode.group_size, comm_size);
+  int const my_group = comm_rank / _group_size;
+  int const n_groups = (comm_size + _group_size - 1) / _group_size;
+
+  // Ranks of a group gather the member boxes among themselves; the group
+  // leaders gather the group boxes and broadcast them to their members. No
+  // rank ever sees the world's rank boxes, so both the communication volume
+  // and the replicated tree footprint scale with the group size and the
+  // group count rather than with the world size.
+  MPI_Comm group_comm;
+  MPI_Comm_split(getComm(), my_group, comm_rank, &group_comm);
+  int group_rank;
+  MPI_Comm_rank(group_comm, &group_rank);
+  int n_members;
+  MPI_Comm_size(group_comm, &n_members);
+
+  Box local_bounds = _bottom_tree.bounds();
+
+  std::vector<Box> member_boxes_host(n_members);
+  MPI_Allgather(&local_bounds, sizeof(Box), MPI_BYTE,
+                member_boxes_host.data(), sizeof(Box), MPI_BYTE, group_comm);
+
+  Box group_box;
+  for (auto const &box : member_boxes_host)
+    Details::expand(group_box, box);
+
+  std::vector<Box> group_boxes_host(n_groups);
+  MPI_Comm leader_comm;
+  MPI_Comm_split(getComm(), group_rank == 0 ? 0 : MPI_UNDEFINED, comm_rank,
+                 &leader_comm);
+  if (leader_comm != MPI_COMM_NULL)
+  {
+    MPI_Allgather(&group_box, sizeof(Box), MPI_BYTE, group_boxes_host.data(),
+                  sizeof(Box), MPI_BYTE, leader_comm);
+    MPI_Comm_free(&leader_comm);
+  }
+  MPI_Bcast(group_boxes_host.data(), n_groups * sizeof(Box), MPI_BYTE, 0,
+            group_comm);
+  MPI_Comm_free(&group_comm);
+
+  auto to_device = [&space](std::vector<Box> const &v, char const *label) {
+    Kokkos::View<Box *, MemorySpace> d(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing, label),
+        v.size());
+    Kokkos::View<Box const *, Kokkos::HostSpace,
+                 Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+        h(v.data(), v.size());
+    Kokkos::deep_copy(space, d, h);
+    return d;
+  };
+  _group_tree =
+      BVH<MemorySpace>{space, to_device(member_boxes_host,
+                                        "ArborX::DistributedTree::"
+                                        "DistributedTree::member_boxes")};
+  _super_tree =
+      BVH<MemorySpace>{space, to_device(group_boxes_host,
+                                        "ArborX::DistributedTree::"
+                                        "DistributedTree::group_boxes")};
+
+  Kokkos::Profiling::popRegion();
+  Kokkos::Profiling::popRegion();
+}
+
+template <typename MemorySpace>
+template <typename ExecutionSpace, typename Primitives>
+DistributedTree<MemorySpace>::DistributedTree(
+    MPI_Comm comm, ExecutionSpace const &space, Primitives const &primitives,
+    Experimental::FragmentedTopTree mode)
+{
+  Kokkos::Profiling::pushRegion("ArborX::DistributedTree::DistributedTree");
+
+  static_assert(Kokkos::is_execution_space<ExecutionSpace>::value);
+  ARBORX_ASSERT(mode.fragments_per_rank > 0);
+
+  Kokkos::Profiling::pushRegion("ArborX::DistributedTree::DistributedTree::"
+                                "bottom_tree_construction");
+
+  _bottom_tree = BVH<MemorySpace>(space, primitives);
+
+  Kokkos::Profiling::popRegion();
+
+  setupCommunicatorAndSizes(comm, space);
+
+  Kokkos::Profiling::pushRegion("ArborX::DistributedTree::DistributedTree::"
+                                "top_tree_construction");
+
+  int comm_rank;
+  MPI_Comm_rank(getComm(), &comm_rank);
+  int comm_size;
+  MPI_Comm_size(getComm(), &comm_size);
+
+  _n_fragments = mode.fragments_per_rank;
+  int const n_fragments = _n_fragments;
+
+  // Carve the local tree into up to n_fragments subtrees by repeatedly
+  // splitting the frontier subtree with the largest bounding box, and
+  // summarize each subtree by its box. A rank holding fewer objects than
+  // fragments leaves the surplus slots at their default, invalid, value; an
+  // invalid box satisfies no predicate, exactly like the boxes contributed
+  // by empty ranks in the single-box constructor.
+  Kokkos::View<Box *, MemorySpace> fragments(
+      Kokkos::view_alloc(space, "ArborX::DistributedTree::DistributedTree::"
+                                "local_fragments"),
+      n_fragments);
+  if (_bottom_tree.size() > 1)
+  {
+    Kokkos::View<int *, MemorySpace> frontier(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::DistributedTree::DistributedTree::"
+                           "fragment_frontier"),
+        n_fragments);
+    auto const bottom_tree = _bottom_tree;
+    Kokkos::parallel_for(
+        "ArborX::DistributedTree::DistributedTree::extract_fragments",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, 1), KOKKOS_LAMBDA(int) {
+          using Details::HappyTreeFriends;
+
+          auto node_box = [&](int node) {
+            Box box;
+            if (HappyTreeFriends::isLeaf(bottom_tree, node))
+              Details::expand(
+                  box, HappyTreeFriends::getIndexable(bottom_tree, node));
+            else
+              Details::expand(box,
+                              HappyTreeFriends::getInternalBoundingVolume(
+                                  bottom_tree, node));
+            return box;
+          };
+
+          int count = 0;
+          frontier(count++) = HappyTreeFriends::getRoot(bottom_tree);
+          while (count < n_fragments)
+          {
+            // Split the widest frontier subtree, measured by the sum of the
+            // extents of its bounding box
+            int widest = -1;
+            float max_measure = -1;
+            for (int i = 0; i < count; ++i)
+            {
+              if (HappyTreeFriends::isLeaf(bottom_tree, frontier(i)))
+                continue;
+              auto const box = node_box(frontier(i));
+              float measure = 0;
+              for (int d = 0; d < 3; ++d)
+                measure += box.maxCorner()[d] - box.minCorner()[d];
+              if (measure > max_measure)
+              {
+                max_measure = measure;
+                widest = i;
+              }
+            }
+            if (widest < 0)
+              break;
+            int const node = frontier(widest);
+            frontier(widest) =
+                HappyTreeFriends::getLeftChild(bottom_tree, node);
+            frontier(count++) =
+                HappyTreeFriends::getRightChild(bottom_tree, node);
+          }
+          for (int i = 0; i < count; ++i)
+            fragments(i) = node_box(frontier(i));
+        });
+  }
+  else if (_bottom_tree.size() == 1)
+  {
+    Kokkos::deep_copy(space, Kokkos::subview(fragments, 0),
+                      _bottom_tree.bounds());
+  }
+
+  Kokkos::View<Box *, MemorySpace> boxes(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedTree::DistributedTree::"
+                         "rank_bounding_boxes"),
+      comm_size * n_fragments);
+
+  Kokkos::DefaultHostExecutionSpace host_exec;
+  if (Details::hasGpuAwareMpiSupport())
+  {
+    Kokkos::deep_copy(
+        space,
+        Kokkos::subview(boxes,
+                        Kokkos::make_pair(comm_rank * n_fragments,
+                                          (comm_rank + 1) * n_fragments)),
+        fragments);
+    space.fence("ArborX::DistributedTree::DistributedTree"
+                " (fill on device done before MPI_Allgather)");
+
+    MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+                  static_cast<void *>(boxes.data()),
+                  n_fragments * sizeof(Box), MPI_BYTE, getComm());
+  }
+  else
+  {
+    auto boxes_host = Kokkos::create_mirror_view(
+        Kokkos::view_alloc(host_exec, Kokkos::WithoutInitializing), boxes);
+    auto fragments_host = Kokkos::create_mirror_view(
+        Kokkos::view_alloc(host_exec, Kokkos::WithoutInitializing), fragments);
+    Kokkos::deep_copy(space, fragments_host, fragments);
+    space.fence("ArborX::DistributedTree::DistributedTree"
+                " (copy local fragments to host before MPI_Allgather)");
+    std::copy(fragments_host.data(), fragments_host.data() + n_fragments,
+              boxes_host.data() + comm_rank * n_fragments);
+
+    MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+                  static_cast<void *>(boxes_host.data()),
+                  n_fragments * sizeof(Box), MPI_BYTE, getComm());
+
+    Kokkos::deep_copy(space, boxes, boxes_host);
+  }
 
   _top_tree = BVH<MemorySpace>{space, boxes};
 
   Kokkos::Profiling::popRegion();
+  Kokkos::Profiling::popRegion();
+}
+
+template <typename MemorySpace>
+template <typename ExecutionSpace, typename Primitives>
+DistributedTree<MemorySpace>::DistributedTree(MPI_Comm comm,
+                                              ExecutionSpace const &space,
+                                              Primitives const &primitives,
+                                              Experimental::ReplicatedTree)
+{
+  Kokkos::Profiling::pushRegion("ArborX::DistributedTree::DistributedTree");
+
+  static_assert(Kokkos::is_execution_space<ExecutionSpace>::value);
+
+  _replicated = true;
+
+  setupCommunicator(comm);
+
+  int comm_rank;
+  MPI_Comm_rank(getComm(), &comm_rank);
+  int comm_size;
+  MPI_Comm_size(getComm(), &comm_size);
+
   Kokkos::Profiling::pushRegion("ArborX::DistributedTree::DistributedTree::"
-                                "size_calculation");
+                                "primitive_gather");
+
+  Details::check_valid_access_traits(PrimitivesTag{}, primitives);
+  using Values = Details::AccessValues<Primitives, PrimitivesTag>;
+  Values values{primitives};
+  using Primitive = typename Values::value_type;
+
+  int const n_local = values.size();
+  std::vector<int> counts(comm_size);
+  MPI_Allgather(&n_local, 1, MPI_INT, counts.data(), 1, MPI_INT, getComm());
+
+  std::vector<int> displs(comm_size + 1, 0);
+  for (int r = 0; r < comm_size; ++r)
+    displs[r + 1] = displs[r] + counts[r];
+  int const n_global = displs[comm_size];
+
+  Kokkos::View<Primitive *, MemorySpace> global_primitives(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedTree::DistributedTree::"
+                         "replicated_primitives"),
+      n_global);
+  auto local_primitives = Kokkos::subview(
+      global_primitives,
+      Kokkos::make_pair(displs[comm_rank], displs[comm_rank + 1]));
+  Kokkos::parallel_for(
+      "ArborX::DistributedTree::DistributedTree::copy_local_primitives",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_local),
+      KOKKOS_LAMBDA(int i) { local_primitives(i) = values(i); });
+
+  std::vector<int> recv_bytes(comm_size);
+  std::vector<int> recv_displs(comm_size);
+  for (int r = 0; r < comm_size; ++r)
+  {
+    recv_bytes[r] = counts[r] * (int)sizeof(Primitive);
+    recv_displs[r] = displs[r] * (int)sizeof(Primitive);
+  }
+
+  Kokkos::DefaultHostExecutionSpace host_exec;
+  if (Details::hasGpuAwareMpiSupport())
+  {
+    space.fence("ArborX::DistributedTree::DistributedTree"
+                " (fill on device done before MPI_Allgatherv)");
+    MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+                   static_cast<void *>(global_primitives.data()),
+                   recv_bytes.data(), recv_displs.data(), MPI_BYTE, getComm());
+  }
+  else
+  {
+    auto global_primitives_host = Kokkos::create_mirror_view(
+        Kokkos::view_alloc(host_exec, Kokkos::WithoutInitializing),
+        global_primitives);
+    Kokkos::deep_copy(space,
+                      Kokkos::subview(global_primitives_host,
+                                      Kokkos::make_pair(displs[comm_rank],
+                                                        displs[comm_rank + 1])),
+                      local_primitives);
+    space.fence("ArborX::DistributedTree::DistributedTree"
+                " (copy local primitives to host before MPI_Allgatherv)");
+
+    MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+                   static_cast<void *>(global_primitives_host.data()),
+                   recv_bytes.data(), recv_displs.data(), MPI_BYTE, getComm());
+
+    Kokkos::deep_copy(space, global_primitives, global_primitives_host);
+  }
 
+  _top_tree_size = n_global;
   _bottom_tree_sizes = Kokkos::View<size_type *, MemorySpace>(
       Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
                          "ArborX::DistributedTree::"
                          "leave_count_in_local_trees"),
       comm_size);
-  auto bottom_tree_sizes_host = Kokkos::create_mirror_view(
-      Kokkos::view_alloc(host_exec, Kokkos::WithoutInitializing),
-      _bottom_tree_sizes);
-  host_exec.fence();
-  bottom_tree_sizes_host(comm_rank) = _bottom_tree.size();
-  MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
-                static_cast<void *>(bottom_tree_sizes_host.data()),
-                sizeof(size_type), MPI_BYTE, getComm());
-  Kokkos::deep_copy(space, _bottom_tree_sizes, bottom_tree_sizes_host);
+  _rank_offset = Kokkos::View<int *, MemorySpace>(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedTree::rank_offset"),
+      comm_size + 1);
+  {
+    auto bottom_tree_sizes_host = Kokkos::create_mirror_view(
+        Kokkos::view_alloc(host_exec, Kokkos::WithoutInitializing),
+        _bottom_tree_sizes);
+    host_exec.fence();
+    for (int r = 0; r < comm_size; ++r)
+      bottom_tree_sizes_host(r) = counts[r];
+    Kokkos::deep_copy(space, _bottom_tree_sizes, bottom_tree_sizes_host);
+
+    Kokkos::View<int const *, Kokkos::HostSpace,
+                 Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+        displs_host(displs.data(), comm_size + 1);
+    Kokkos::deep_copy(space, _rank_offset, displs_host);
+  }
 
-  _top_tree_size = Details::KokkosExt::reduce(space, _bottom_tree_sizes, 0);
+  Kokkos::Profiling::popRegion();
+  Kokkos::Profiling::pushRegion("ArborX::DistributedTree::DistributedTree::"
+                                "bottom_tree_construction");
+
+  // The "bottom" tree holds everyone's primitives; there is no top tree to
+  // discover destination ranks with since there are no destinations
+  _bottom_tree = BVH<MemorySpace>(space, global_primitives);
+
+  Kokkos::Profiling::popRegion();
+  Kokkos::Profiling::popRegion();
+}
+
+template <typename MemorySpace>
+void DistributedTree<MemorySpace>::saveToFile(std::string const &prefix) const
+{
+  Kokkos::Profiling::pushRegion("ArborX::DistributedTree::saveToFile");
+
+  // The hierarchical, fragmented, and replicated modes lay their trees out
+  // differently and would need their own file layout
+  ARBORX_ASSERT(_group_size == 0 && _n_fragments == 1 && !_replicated);
+
+  int comm_rank;
+  MPI_Comm_rank(getComm(), &comm_rank);
+
+  _bottom_tree.saveToFile(prefix + ".bottom." + std::to_string(comm_rank));
+  if (comm_rank == 0)
+    _top_tree.saveToFile(prefix + ".top");
+
+  // Do not return before every file is complete so that the caller may hand
+  // the prefix to loadFromFile() right away
+  MPI_Barrier(getComm());
 
   Kokkos::Profiling::popRegion();
+}
+
+template <typename MemorySpace>
+template <typename ExecutionSpace>
+DistributedTree<MemorySpace>
+DistributedTree<MemorySpace>::loadFromFile(MPI_Comm comm,
+                                           ExecutionSpace const &space,
+                                           std::string const &prefix)
+{
+  Kokkos::Profiling::pushRegion("ArborX::DistributedTree::loadFromFile");
+
+  static_assert(Kokkos::is_execution_space<ExecutionSpace>::value);
+
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+  int comm_size;
+  MPI_Comm_size(comm, &comm_size);
+
+  // BVH<MemorySpace> is a thin wrapper without data members of its own, so
+  // assigning through the base restores the full state
+  using BaseTree = BoundingVolumeHierarchy<MemorySpace, PairValueIndex<Box>,
+                                           Details::DefaultIndexableGetter, Box>;
+
+  DistributedTree tree;
+  static_cast<BaseTree &>(tree._bottom_tree) = BaseTree::loadFromFile(
+      space, prefix + ".bottom." + std::to_string(comm_rank));
+
+  // Gathers the restored local tree sizes; the only communication left
+  tree.setupCommunicatorAndSizes(comm, space);
+
+  static_cast<BaseTree &>(tree._top_tree) =
+      BaseTree::loadFromFile(space, prefix + ".top");
+  // The top tree stores one bounding box per rank of the writing run
+  ARBORX_ASSERT((int)tree._top_tree.size() == comm_size);
+
   Kokkos::Profiling::popRegion();
+
+  return tree;
 }
 
 } // namespace ArborX
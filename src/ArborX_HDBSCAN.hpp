@@ -11,6 +11,7 @@
 #ifndef ARBORX_HDBSCAN_HPP
 #define ARBORX_HDBSCAN_HPP
 
+#include <ArborX_CondensedTree.hpp>
 #include <ArborX_Dendrogram.hpp>
 #include <ArborX_MinimumSpanningTree.hpp>
 
@@ -44,6 +45,58 @@ auto hdbscan(ExecutionSpace const &exec_space, Primitives const &primitives,
   MinimumSpanningTree<MemorySpace> mst(exec_space, primitives, core_min_size);
   Kokkos::Profiling::popRegion();
 
+  Kokkos::Profiling::pushRegion("ArborX::HDBSCAN::dendrogram");
+  Dendrogram<MemorySpace> dendrogram(exec_space, mst.edges, dendrogram_impl);
+  Kokkos::Profiling::popRegion();
+
+  return dendrogram;
+}
+
+// Run the full pipeline, including excess-of-mass cluster extraction, and
+// return the cluster labels directly (-1 for noise). min_cluster_size is the
+// smallest number of points a condensed cluster has to retain; see
+// extractClustersEOM() for the extraction itself.
+template <typename ExecutionSpace, typename Primitives>
+auto hdbscanLabels(ExecutionSpace const &exec_space,
+                   Primitives const &primitives, int core_min_size,
+                   int min_cluster_size,
+                   DendrogramImplementation dendrogram_impl =
+                       DendrogramImplementation::BORUVKA)
+{
+  auto dendrogram =
+      hdbscan(exec_space, primitives, core_min_size, dendrogram_impl);
+
+  return extractClustersEOM(exec_space, dendrogram, min_cluster_size);
+}
+
+// Approximate variant of hdbscan() for problem sizes where the exact minimum
+// spanning tree over mutual-reachability distances is the scaling wall. The
+// tree is built over a sparse candidate graph of each point's nearest
+// neighbors instead of all implicit edges, which cuts both the time and the
+// memory of the spanning tree phase; components the candidate graph misses
+// are still connected exactly, so the result is always a spanning tree.
+//
+// num_candidates is the accuracy budget: the number of candidate neighbors
+// kept per point. The dendrogram converges to the exact one as the budget
+// grows, and is typically indistinguishable from it in low dimension already
+// for small budgets; -1 picks a default based on core_min_size.
+template <typename ExecutionSpace, typename Primitives>
+auto hdbscanApproximate(ExecutionSpace const &exec_space,
+                        Primitives const &primitives, int core_min_size,
+                        int num_candidates = -1)
+{
+  Kokkos::Profiling::ScopedRegion guard("ArborX::HDBSCAN");
+
+  using namespace ArborX::Details;
+
+  using MemorySpace = typename Primitives::memory_space;
+
+  Kokkos::Profiling::pushRegion("ArborX::HDBSCAN::mst");
+  MinimumSpanningTree<MemorySpace> mst(exec_space, primitives, core_min_size,
+                                       MSTAlgorithm::EdgeContraction,
+                                       num_candidates);
+  Kokkos::Profiling::popRegion();
+
   Kokkos::Profiling::pushRegion("ArborX::HDBSCAN::dendrogram");
   Dendrogram<MemorySpace> dendrogram(exec_space, mst.edges);
   Kokkos::Profiling::popRegion();
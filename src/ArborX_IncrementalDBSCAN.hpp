@@ -0,0 +1,456 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_INCREMENTAL_DBSCAN_HPP
+#define ARBORX_INCREMENTAL_DBSCAN_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_DBSCAN.hpp> // PrimitivesWithRadiusReorderedAndFiltered
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsMutableBVH.hpp>
+#include <ArborX_DetailsUnionFind.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_PairValueIndex.hpp>
+#include <ArborX_Predicates.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+namespace ArborX
+{
+
+namespace Details
+{
+
+// Counting callback of IncrementalDBSCAN: updates the neighbor counts around
+// a batch of inserted points, and records the old points whose count just
+// crossed the core threshold. Unlike the capped batch counting (CountUpToN),
+// the counts are kept exact so that later removals can detect demotions.
+template <typename MemorySpace>
+struct IncrementalDBSCANCountCallback
+{
+  Kokkos::View<int *, MemorySpace> _num_neigh;
+  Kokkos::View<char *, MemorySpace> _promoted;
+  int _core_min_size;
+  // Points at indices >= _first_new count their own neighborhoods; older
+  // points only receive the increments contributed by the batch
+  int _first_new;
+
+  template <typename Query, typename Value>
+  KOKKOS_FUNCTION void operator()(Query const &query, Value const &value) const
+  {
+    int const i = getData(query);
+    int const j = value.index;
+    if (j == i)
+      return;
+    Kokkos::atomic_increment(&_num_neigh(i));
+    if (j < _first_new)
+    {
+      int const old = Kokkos::atomic_fetch_add(&_num_neigh(j), 1);
+      if (old == _core_min_size - 1)
+        _promoted(j) = 1;
+    }
+  }
+};
+
+// Removal counterpart: the predicates are the spheres of the removed points,
+// whose values were already tombstoned, so every reported value is a
+// surviving point losing one neighbor
+template <typename MemorySpace>
+struct IncrementalDBSCANUncountCallback
+{
+  Kokkos::View<int *, MemorySpace> _num_neigh;
+  Kokkos::View<char *, MemorySpace> _demoted;
+  int _core_min_size;
+
+  template <typename Query, typename Value>
+  KOKKOS_FUNCTION void operator()(Query const &, Value const &value) const
+  {
+    int const j = value.index;
+    int const old = Kokkos::atomic_fetch_sub(&_num_neigh(j), 1);
+    if (old == _core_min_size)
+      _demoted(j) = 1;
+  }
+};
+
+// Clustering callback of IncrementalDBSCAN. Same logic as FDBSCANCallback,
+// minus the half-traversal assumption: a pair may show up in both
+// orientations (or repeatedly across epochs), which merge() and merge_into()
+// both tolerate.
+template <typename UnionFind, typename CorePoints>
+struct IncrementalDBSCANClusterCallback
+{
+  UnionFind _union_find;
+  CorePoints _is_core;
+
+  template <typename Query, typename Value>
+  KOKKOS_FUNCTION void operator()(Query const &query, Value const &value) const
+  {
+    int const i = getData(query);
+    int const j = value.index;
+    if (j == i)
+      return;
+    if (_is_core(i))
+    {
+      if (_is_core(j))
+        _union_find.merge(i, j);
+      else
+        _union_find.merge_into(j, i);
+    }
+    else if (_is_core(j))
+    {
+      // See the NOTE in FDBSCANCallback for why a border point must never
+      // become a representative
+      _union_find.merge_into(i, j);
+    }
+  }
+};
+
+} // namespace Details
+
+namespace Experimental
+{
+
+// Maintains a DBSCAN labeling of a point set under streaming insertions and
+// removals without re-clustering the whole set.
+//
+// Insertions are exact and local: the neighbor counts are updated around the
+// inserted batch, and the union-find forest is extended around the inserted
+// points plus the old points they promote to core status. Clusters can only
+// grow or merge under insertion, so no previous decision has to be revisited.
+// Removals decrement the counts around the removed points and then recluster
+// the members of every cluster that lost a point or had a core point
+// demoted; clusters that kept all their members and core points are left
+// untouched. The cost of either operation therefore scales with the churn
+// and its neighborhoods, not with the total number of points.
+//
+// Points are identified by their insertion order, which is what remove()
+// refers to and what indexes the view returned by labels(). The underlying
+// tree absorbs the churn lazily and is folded into a fresh one once the
+// stale fraction passes a threshold (see MutableBVH).
+template <typename MemorySpace, typename Point>
+class IncrementalDBSCAN
+{
+  static_assert(GeometryTraits::is_point<Point>::value);
+
+  using BVH = BoundingVolumeHierarchy<MemorySpace, PairValueIndex<Point>>;
+
+public:
+  using memory_space = MemorySpace;
+
+  template <typename ExecutionSpace, typename Primitives>
+  IncrementalDBSCAN(ExecutionSpace const &space, Primitives const &primitives,
+                    float eps, int core_min_size)
+      : _eps(eps)
+      , _core_min_size(core_min_size)
+      , _points("ArborX::IncrementalDBSCAN::points", 0)
+      , _labels("ArborX::IncrementalDBSCAN::labels", 0)
+      , _num_neigh("ArborX::IncrementalDBSCAN::num_neighbors", 0)
+      , _removed("ArborX::IncrementalDBSCAN::removed", 0)
+      , _bvh(space, Kokkos::View<PairValueIndex<Point> *, MemorySpace>(
+                        "ArborX::IncrementalDBSCAN::values", 0))
+  {
+    ARBORX_ASSERT(eps > 0);
+    ARBORX_ASSERT(core_min_size >= 2);
+
+    insert(space, primitives);
+  }
+
+  // Total number of points that were inserted and not removed
+  int size() const { return _bvh.size(); }
+
+  // Insert a batch of points; they join the labeling immediately
+  template <typename ExecutionSpace, typename Primitives>
+  void insert(ExecutionSpace const &space, Primitives const &user_points)
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::IncrementalDBSCAN::insert");
+
+    using Points = Details::AccessValues<Primitives, PrimitivesTag>;
+    static_assert(std::is_same_v<typename Points::value_type, Point>);
+
+    Points points{user_points};
+    int const num_new = points.size();
+    int const first_new = _points.size();
+    int const n = first_new + num_new;
+
+    Kokkos::resize(Kokkos::view_alloc(space, Kokkos::WithoutInitializing),
+                   _points, n);
+    Kokkos::resize(Kokkos::view_alloc(space, Kokkos::WithoutInitializing),
+                   _labels, n);
+    Kokkos::resize(Kokkos::view_alloc(space, Kokkos::WithoutInitializing),
+                   _num_neigh, n);
+    Kokkos::resize(Kokkos::view_alloc(space), _removed, n);
+
+    Kokkos::View<PairValueIndex<Point> *, MemorySpace> new_values(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::IncrementalDBSCAN::insert::new_values"),
+        num_new);
+    auto all_points = _points;
+    auto labels = _labels;
+    auto num_neigh = _num_neigh;
+    Kokkos::parallel_for(
+        "ArborX::IncrementalDBSCAN::insert::init_state",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_new),
+        KOKKOS_LAMBDA(int k) {
+          int const i = first_new + k;
+          Point const point = points(k);
+          all_points(i) = point;
+          labels(i) = i;
+          num_neigh(i) = 1; // a point is its own neighbor
+          new_values(k) = {point, (unsigned)i};
+        });
+    _bvh.insert(space, new_values);
+
+    // Fold the accumulated churn into a fresh tree before the heavy queries
+    if (_bvh.churn() > 0.1f)
+      _bvh.rebuild(space);
+
+    // Update the neighbor counts around the batch, recording promotions
+    Kokkos::View<char *, MemorySpace> promoted(
+        Kokkos::view_alloc(space,
+                           "ArborX::IncrementalDBSCAN::insert::promoted"),
+        n);
+    Kokkos::View<int *, MemorySpace> new_ids(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::IncrementalDBSCAN::insert::new_ids"),
+        num_new);
+    Details::KokkosExt::iota(space, new_ids, first_new);
+    _bvh.query(space,
+               Details::PrimitivesWithRadiusReorderedAndFiltered<
+                   decltype(_points), decltype(new_ids)>{_points, _eps,
+                                                         new_ids},
+               Details::IncrementalDBSCANCountCallback<MemorySpace>{
+                   _num_neigh, promoted, _core_min_size, first_new});
+
+    // Extend the forest around the inserted and the newly promoted points. A
+    // promoted point may bridge previously separate clusters; points that
+    // are neither inserted nor promoted cannot change any decision.
+    Kokkos::View<int *, MemorySpace> changed_offsets(
+        Kokkos::view_alloc(
+            space, "ArborX::IncrementalDBSCAN::insert::changed_offsets"),
+        n + 1);
+    Kokkos::parallel_for(
+        "ArborX::IncrementalDBSCAN::insert::flag_changed",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i) {
+          changed_offsets(i) = (i >= first_new || promoted(i));
+        });
+    Details::KokkosExt::exclusive_scan(space, changed_offsets, changed_offsets,
+                                       0);
+    int const num_changed =
+        Details::KokkosExt::lastElement(space, changed_offsets);
+    Kokkos::View<int *, MemorySpace> changed_ids(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::IncrementalDBSCAN::insert::changed_ids"),
+        num_changed);
+    Kokkos::parallel_for(
+        "ArborX::IncrementalDBSCAN::insert::compact_changed",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i) {
+          if (changed_offsets(i + 1) != changed_offsets(i))
+            changed_ids(changed_offsets(i)) = i;
+        });
+
+    cluster(space, changed_ids);
+  }
+
+  // Remove points by their insertion index. Only the clusters that lost a
+  // member or a core point are re-labeled.
+  template <typename ExecutionSpace>
+  void remove(ExecutionSpace const &space,
+              Kokkos::View<int *, MemorySpace> const &indices)
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::IncrementalDBSCAN::remove");
+
+    int const n = _points.size();
+    int const num_removed = indices.size();
+
+    auto removed = _removed;
+    Kokkos::parallel_for(
+        "ArborX::IncrementalDBSCAN::remove::tombstone",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_removed),
+        KOKKOS_LAMBDA(int k) { removed(indices(k)) = 1; });
+    _bvh.remove(space, indices);
+    if (_bvh.churn() > 0.1f)
+      _bvh.rebuild(space);
+
+    // Every survivor within reach of a removed point loses one neighbor;
+    // record the core points this demotes
+    Kokkos::View<char *, MemorySpace> demoted(
+        Kokkos::view_alloc(space,
+                           "ArborX::IncrementalDBSCAN::remove::demoted"),
+        n);
+    _bvh.query(space,
+               Details::PrimitivesWithRadiusReorderedAndFiltered<
+                   decltype(_points), std::decay_t<decltype(indices)>>{
+                   _points, _eps, indices},
+               Details::IncrementalDBSCANUncountCallback<MemorySpace>{
+                   _num_neigh, demoted, _core_min_size});
+
+    // Flatten the forest so that labels hold representatives directly, and
+    // mark the clusters of the removed and the demoted points as affected
+    auto labels = _labels;
+    Kokkos::parallel_for(
+        "ArborX::IncrementalDBSCAN::remove::finalize_labels",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int const i) {
+          // ##### ECL license (see LICENSE.ECL) #####
+          int next;
+          int vstat = labels(i);
+          int const old = vstat;
+          while (vstat > (next = labels(vstat)))
+          {
+            vstat = next;
+          }
+          if (vstat != old)
+            labels(i) = vstat;
+        });
+    Kokkos::View<char *, MemorySpace> affected(
+        Kokkos::view_alloc(
+            space, "ArborX::IncrementalDBSCAN::remove::affected_clusters"),
+        n);
+    Kokkos::parallel_for(
+        "ArborX::IncrementalDBSCAN::remove::mark_affected",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i) {
+          if (removed(i) || demoted(i))
+            affected(labels(i)) = 1;
+        });
+
+    // Gather the surviving members of the affected clusters, cut them loose,
+    // and recluster them against the whole set. A cluster that kept all its
+    // members and core points cannot be touched by this pass: two core
+    // points can only end up merged if they are within eps of each other, in
+    // which case they were already in one (hence affected) cluster; border
+    // claims may move a member to a surviving neighbor cluster, which is a
+    // legal assignment.
+    Kokkos::View<int *, MemorySpace> member_offsets(
+        Kokkos::view_alloc(
+            space, "ArborX::IncrementalDBSCAN::remove::member_offsets"),
+        n + 1);
+    Kokkos::parallel_for(
+        "ArborX::IncrementalDBSCAN::remove::flag_members",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i) {
+          member_offsets(i) = (!removed(i) && affected(labels(i)));
+        });
+    Details::KokkosExt::exclusive_scan(space, member_offsets, member_offsets,
+                                       0);
+    int const num_members =
+        Details::KokkosExt::lastElement(space, member_offsets);
+    Kokkos::View<int *, MemorySpace> member_ids(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::IncrementalDBSCAN::remove::member_ids"),
+        num_members);
+    Kokkos::parallel_for(
+        "ArborX::IncrementalDBSCAN::remove::reset_members",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i) {
+          if (member_offsets(i + 1) != member_offsets(i))
+          {
+            member_ids(member_offsets(i)) = i;
+            labels(i) = i;
+          }
+          if (removed(i))
+            labels(i) = i;
+        });
+
+    cluster(space, member_ids);
+  }
+
+  // Current labeling: the cluster representative for every clustered point,
+  // -1 for noise and removed points
+  template <typename ExecutionSpace>
+  Kokkos::View<int *, MemorySpace> labels(ExecutionSpace const &space) const
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::IncrementalDBSCAN::labels");
+
+    int const n = _points.size();
+
+    Kokkos::View<int *, MemorySpace> out(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::IncrementalDBSCAN::labels"),
+        n);
+    Kokkos::View<int *, MemorySpace> cluster_sizes(
+        Kokkos::view_alloc(space,
+                           "ArborX::IncrementalDBSCAN::cluster_sizes"),
+        n);
+    auto labels = _labels;
+    auto removed = _removed;
+    Kokkos::parallel_for(
+        "ArborX::IncrementalDBSCAN::labels::resolve",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i) {
+          if (removed(i))
+          {
+            out(i) = -1;
+            return;
+          }
+          // Follow the parent pointers without compressing them, as the
+          // forest must stay untouched in this const accessor
+          int curr = i;
+          int next;
+          while (curr != (next = labels(curr)))
+            curr = next;
+          out(i) = curr;
+          Kokkos::atomic_increment(&cluster_sizes(curr));
+        });
+    Details::DBSCANCorePoints<MemorySpace> is_core{_num_neigh, _core_min_size};
+    Kokkos::parallel_for(
+        "ArborX::IncrementalDBSCAN::labels::mark_noise",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i) {
+          if (out(i) != -1 && cluster_sizes(out(i)) == 1 && !is_core(i))
+            out(i) = -1;
+        });
+    return out;
+  }
+
+private:
+  // Run the clustering pass around the given points against the whole set
+  template <typename ExecutionSpace>
+  void cluster(ExecutionSpace const &space,
+               Kokkos::View<int *, MemorySpace> const &ids)
+  {
+#ifdef KOKKOS_ENABLE_SERIAL
+    using UnionFind = Details::UnionFind<
+        MemorySpace,
+        /*DoSerial=*/std::is_same_v<ExecutionSpace, Kokkos::Serial>>;
+#else
+    using UnionFind = Details::UnionFind<MemorySpace>;
+#endif
+    using CorePoints = Details::DBSCANCorePoints<MemorySpace>;
+
+    _bvh.query(
+        space,
+        Details::PrimitivesWithRadiusReorderedAndFiltered<
+            decltype(_points), std::decay_t<decltype(ids)>>{_points, _eps,
+                                                            ids},
+        Details::IncrementalDBSCANClusterCallback<UnionFind, CorePoints>{
+            UnionFind{_labels}, CorePoints{_num_neigh, _core_min_size}});
+  }
+
+  float _eps;
+  int _core_min_size;
+  Kokkos::View<Point *, MemorySpace> _points;
+  // Union-find forest over the points; flattened lazily
+  Kokkos::View<int *, MemorySpace> _labels;
+  // Exact number of points within eps, the point itself included
+  Kokkos::View<int *, MemorySpace> _num_neigh;
+  Kokkos::View<char *, MemorySpace> _removed;
+  MutableBVH<BVH> _bvh;
+};
+
+} // namespace Experimental
+} // namespace ArborX
+
+#endif
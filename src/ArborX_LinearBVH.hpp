@@ -14,17 +14,30 @@
 
 #include <ArborX_AccessTraits.hpp>
 #include <ArborX_Box.hpp>
+#include <ArborX_BuildWorkspace.hpp>
 #include <ArborX_Callbacks.hpp>
 #include <ArborX_CrsGraphWrapper.hpp>
 #include <ArborX_DetailsBatchedQueries.hpp>
 #include <ArborX_DetailsCrsGraphWrapperImpl.hpp>
 #include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
 #include <ArborX_DetailsLegacy.hpp>
 #include <ArborX_DetailsNode.hpp>
 #include <ArborX_DetailsPermutedData.hpp>
 #include <ArborX_DetailsSortUtils.hpp>
 #include <ArborX_DetailsTreeConstruction.hpp>
+#include <ArborX_DetailsTreeConstructionPLOC.hpp>
+#include <ArborX_DetailsTreeConstructionSAH.hpp>
+#include <ArborX_DetailsTreeConstructionSmall.hpp>
+#include <ArborX_DetailsTreeRefit.hpp>
+#include <ArborX_DetailsTreeRelayout.hpp>
+#include <ArborX_DetailsTreeRestructuring.hpp>
 #include <ArborX_DetailsTreeTraversal.hpp>
+#include <ArborX_DetailsTreeTraversalCoherent.hpp>
+#include <ArborX_TraversalPolicy.hpp>
+#include <ArborX_DetailsTreeTraversalInstrumented.hpp>
+#include <ArborX_DetailsTreeTraversalPacket.hpp>
+#include <ArborX_DetailsTreeTraversalWorkQueue.hpp>
 #include <ArborX_HyperBox.hpp>
 #include <ArborX_IndexableGetter.hpp>
 #include <ArborX_SpaceFillingCurves.hpp>
@@ -33,20 +46,142 @@
 #include <Kokkos_Core.hpp>
 #include <Kokkos_Profiling_ScopedRegion.hpp>
 
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+
 namespace ArborX
 {
 
 namespace Experimental
 {
-struct PerThread
+// NOTE: the PerThread and PerTeam in-kernel query tags live in
+// ArborX_TraversalPolicy.hpp
+
+// Construction algorithm selectors. The default Karras-style builder is the
+// fastest; the PLOC builder spends a few extra passes over the leaves to
+// produce tighter bounding volumes, which pays off for build-once
+// query-forever workloads.
+struct KarrasBuilder
+{
+  // Number of post-build rotation rounds reducing the surface area of
+  // internal nodes (0 disables restructuring)
+  int restructure_rounds = 0;
+  // Promise that the values are already ordered along the space-filling
+  // curve, skipping the construction sort. The promise is not checked; a
+  // broken one produces a valid but arbitrarily bad tree.
+  bool assume_presorted = false;
+  // Trees at or below this size are built by a single fused kernel instead
+  // of the multi-launch pipeline, trading asymptotic complexity for launch
+  // latency (0 disables the fused path)
+  int single_kernel_threshold = 2048;
+  // Rewrite internal nodes in breadth-first order after the build, making
+  // the hot top levels of the tree contiguous in memory (helps host-side
+  // traversals most)
+  bool bfs_relayout = false;
+  // Record parent links while the hierarchy is emitted instead of recovering
+  // them lazily on the first update(). Worthwhile for refit-heavy workloads;
+  // ignored when restructuring or relayout is enabled (those passes rewrite
+  // the topology, invalidating construction-time links) or when the tree is
+  // small enough for the fused single-kernel build
+  bool compute_parents = false;
+};
+struct PLOCBuilder
+{
+  // Number of clusters inspected on each side when searching for the merge
+  // candidate minimizing surface area
+  int search_radius = 16;
+  int restructure_rounds = 0;
+  bool assume_presorted = false;
+  bool bfs_relayout = false;
+};
+// Host-side binned-SAH builder: much slower to build, best tree quality.
+// For geometry that is built once and queried forever.
+struct SAHBuilder
+{
+  int num_bins = 16;
+};
+
+// Storage layout selectors for the values held in the leaves. The default
+// array-of-structures layout stores each value next to its rope. The
+// structure-of-arrays layout is restricted to PairValueIndex values paired
+// with the default indexable getter (i.e., trees built via attach_indices()):
+// the geometries stay in the leaf nodes while the indices move to a separate
+// array, so geometry-only traversals stop dragging the indices through the
+// cache. For a 3D float point with a 4-byte index that is a quarter of the
+// leaf traffic.
+struct ValuesAoS
+{};
+struct ValuesSoA
 {};
+
+// Per-array device memory held by a tree, in bytes (see
+// BoundingVolumeHierarchy::memoryUsage()). The stored values are embedded in
+// the leaf nodes and are accounted for there, except for the indices split
+// out by the ValuesSoA layout.
+struct TreeMemoryUsage
+{
+  std::size_t leaf_nodes = 0;
+  std::size_t internal_nodes = 0;
+  // Indices of the values, populated only by the ValuesSoA layout
+  std::size_t indices = 0;
+  // Leaf permutation retained for update(); released by compact(false)
+  std::size_t permutation = 0;
+  // Parent links, present only after the first update()
+  std::size_t parents = 0;
+
+  std::size_t total() const
+  {
+    return leaf_nodes + internal_nodes + indices + permutation + parents;
+  }
+};
 } // namespace Experimental
 
 namespace Details
 {
 struct HappyTreeFriends;
+
+// On-disk layout of a serialized tree (see
+// BoundingVolumeHierarchy::saveToFile()): the header, the bounding volume
+// and each node array start at a multiple of tree_file_alignment, so a
+// loader may mmap the file and hand the arrays to the device as-is.
+struct TreeFileHeader
+{
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t leaf_node_size;
+  std::uint32_t internal_node_size;
+  std::uint32_t bounding_volume_size;
+  std::uint64_t size;
+  std::uint64_t permutation_size;
+};
+
+inline constexpr char tree_file_magic[8] = {'A', 'r', 'b', 'o',
+                                            'r', 'X', 'B', 'T'};
+inline constexpr std::uint32_t tree_file_version = 1;
+inline constexpr std::size_t tree_file_alignment = 64;
 } // namespace Details
 
+// BoundingVolume is the type stored in the internal nodes and defaults to an
+// axis-aligned box of the indexable's dimension. Any geometry providing
+// expand() and the predicate checks works; KDOP<14> or KDOP<18>
+// (ArborX_KDOP.hpp) is worth trying for diagonally-aligned geometry, where
+// the extra planes cut down the false-positive leaf visits that loose boxes
+// produce.
+//
+// Stream ordering: construction and query submit all device work and
+// temporary allocations to the execution space instance they are given and
+// never fence globally, so independent trees driven from distinct instances
+// overlap on backends with concurrent streams (see
+// benchmarks/execution_space_instances). Algorithms that need an
+// intermediate result on the host (buffer sizing in query, the per-level
+// loops of the PLOC builder, the host-side SAH build) fence that one
+// instance, which blocks the submitting host thread but not the other
+// streams; use one host thread per instance, or the workspace query path
+// once at steady state, when even that stall matters. bounds() is filled by
+// an asynchronous copy during construction: fence the instance before
+// reading it from the host.
 template <
     typename MemorySpace, typename Value = Details::LegacyDefaultTemplateValue,
     typename IndexableGetter = Details::DefaultIndexableGetter,
@@ -54,7 +189,8 @@ template <
         GeometryTraits::dimension_v<
             std::decay_t<std::invoke_result_t<IndexableGetter, Value>>>,
         typename GeometryTraits::coordinate_type<
-            std::decay_t<std::invoke_result_t<IndexableGetter, Value>>>::type>>
+            std::decay_t<std::invoke_result_t<IndexableGetter, Value>>>::type>,
+    typename ValuesLayout = Experimental::ValuesAoS>
 class BoundingVolumeHierarchy
 {
 public:
@@ -67,11 +203,64 @@ public:
   BoundingVolumeHierarchy() = default; // build an empty tree
 
   template <typename ExecutionSpace, typename Values,
-            typename SpaceFillingCurve = Experimental::Morton64>
+            typename SpaceFillingCurve = Experimental::Morton64,
+            typename Builder = Experimental::KarrasBuilder>
   BoundingVolumeHierarchy(
       ExecutionSpace const &space, Values const &values,
       IndexableGetter const &indexable_getter = IndexableGetter(),
-      SpaceFillingCurve const &curve = SpaceFillingCurve());
+      SpaceFillingCurve const &curve = SpaceFillingCurve(),
+      Builder const &builder = Builder(),
+      Experimental::BuildWorkspace<MemorySpace> *workspace = nullptr);
+
+  // Replace the stored values with new ones (same number, same order as at
+  // construction) and refit the bounding volumes bottom-up without changing
+  // the topology. Much cheaper than a full rebuild when values moved only
+  // slightly; tree quality degrades as they drift, at which point the caller
+  // should reconstruct.
+  template <typename ExecutionSpace, typename Values>
+  void update(ExecutionSpace const &space, Values const &values);
+
+  // Write the tree to a binary file that loadFromFile() restores without any
+  // per-node fixup: the node arrays are stored exactly as they sit in
+  // memory, 64-byte aligned, so a loader can also memory-map the file and
+  // bulk-copy them to the device. The layout is tied to the ABI of the node
+  // types and the endianness of the writer; the header records a version and
+  // the node sizes, which are checked on load.
+  void saveToFile(std::string const &filename) const;
+
+  // Restore a tree written by saveToFile() on a matching build, turning
+  // minutes of construction for static geometry into an I/O-bound copy. A
+  // stateful indexable getter is not serialized and must be passed again.
+  template <typename ExecutionSpace>
+  static BoundingVolumeHierarchy
+  loadFromFile(ExecutionSpace const &space, std::string const &filename,
+               IndexableGetter const &indexable_getter = IndexableGetter());
+
+  // Break down the device memory held by the tree, in bytes. Computed from
+  // the stored view extents, so the numbers match what diffing allocator
+  // statistics around construction would report (minus construction scratch,
+  // which is already released by the time the constructor returns).
+  Experimental::TreeMemoryUsage memoryUsage() const
+  {
+    Experimental::TreeMemoryUsage usage;
+    usage.leaf_nodes = _leaf_nodes.size() * sizeof(leaf_node_type);
+    usage.internal_nodes = _internal_nodes.size() * sizeof(internal_node_type);
+    usage.indices = _indices.size() * sizeof(index_type);
+    usage.permutation = _permutation.size() * sizeof(unsigned int);
+    usage.parents = _parents.size() * sizeof(int);
+    return usage;
+  }
+
+  // Release memory that queries do not need. The parent links are always
+  // dropped (the next update() recovers them from the ropes). Passing false
+  // additionally drops the leaf permutation, reclaiming 4 bytes per value at
+  // the price of making update() invalid; queries are unaffected either way.
+  void compact(bool keep_update_support = true)
+  {
+    _parents = {};
+    if (!keep_update_support)
+      _permutation = {};
+  }
 
   KOKKOS_FUNCTION
   size_type size() const noexcept { return _size; }
@@ -82,6 +271,13 @@ public:
   KOKKOS_FUNCTION
   bounding_volume_type bounds() const noexcept { return _bounds; }
 
+  // Queries never mutate the tree and keep all intermediate state (predicate
+  // sort scratch, counting and CRS output buffers) local to the call. It is
+  // therefore safe to issue read-only queries against one shared tree from
+  // several host threads concurrently, provided each thread passes its own
+  // execution space instance (see tstQueryTreeConcurrency). Interleaving
+  // queries with update(), compact(), or assignment to the tree requires
+  // external synchronization.
   template <typename ExecutionSpace, typename Predicates, typename Callback>
   void query(ExecutionSpace const &space, Predicates const &predicates,
              Callback const &callback,
@@ -109,6 +305,239 @@ public:
         std::forward<View>(view), std::forward<Args>(args)...);
   }
 
+  // Asynchronous CRS query: the whole query is enqueued on the execution
+  // space instance and the call returns a completion handle without the
+  // host ever blocking, so a frame loop can line up query, physics, and
+  // I/O work back to back. Requires a workspace whose buffers can be sized
+  // up front: run one synchronous workspace query first (the retained
+  // counts then size every subsequent call), or cap each predicate with a
+  // non-zero TraversalPolicy buffer size. The offset and output views are
+  // only valid after wait() returned; wait() throws if a predicate
+  // overflowed its buffer, and re-issuing the query right away succeeds
+  // since exact counts were captured. See Experimental::QueryFuture.
+  template <typename ExecutionSpace, typename UserPredicates,
+            typename CallbackOrView, typename View, typename... Args>
+  std::enable_if_t<Kokkos::is_view_v<std::decay_t<View>>,
+                   Experimental::QueryFuture<ExecutionSpace, MemorySpace>>
+  queryAsync(ExecutionSpace const &space, UserPredicates const &user_predicates,
+             CallbackOrView &&callback_or_view, View &&view,
+             Args &&...args) const
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::BVH::query_async");
+
+    Details::CrsGraphWrapperImpl::
+        check_valid_callback_if_first_argument_is_not_a_view<value_type>(
+            callback_or_view, user_predicates, view);
+
+    using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+    using Tag = typename Predicates::value_type::Tag;
+
+    return Details::CrsGraphWrapperImpl::queryDispatchAsync(
+        Tag{}, *this, space, Predicates{user_predicates},
+        std::forward<CallbackOrView>(callback_or_view),
+        std::forward<View>(view), std::forward<Args>(args)...);
+  }
+
+  // Count-only query: fills counts(i) with the number of values matching
+  // predicate i, skipping result materialization entirely (no output
+  // allocation, no second traversal)
+  template <typename ExecutionSpace, typename UserPredicates,
+            typename CountView>
+  std::enable_if_t<Kokkos::is_view_v<CountView>>
+  queryCount(ExecutionSpace const &space,
+             UserPredicates const &user_predicates, CountView &counts,
+             Experimental::TraversalPolicy const &policy =
+                 Experimental::TraversalPolicy()) const
+  {
+    static_assert(Details::KokkosExt::is_accessible_from<
+                  MemorySpace, ExecutionSpace>::value);
+    Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+
+    using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+    using Tag = typename Predicates::value_type::Tag;
+    static_assert(std::is_same_v<Tag, Details::SpatialPredicateTag>,
+                  "queryCount only supports spatial predicates");
+
+    Details::CrsGraphWrapperImpl::queryCount(
+        *this, space, Predicates{user_predicates}, counts, policy);
+  }
+
+  // Any-hit query: fills hits(i) with whether anything matches predicate i;
+  // each predicate's traversal stops at its first match
+  template <typename ExecutionSpace, typename UserPredicates,
+            typename HitView>
+  std::enable_if_t<Kokkos::is_view_v<HitView>>
+  queryAny(ExecutionSpace const &space, UserPredicates const &user_predicates,
+           HitView &hits,
+           Experimental::TraversalPolicy const &policy =
+               Experimental::TraversalPolicy()) const
+  {
+    static_assert(Details::KokkosExt::is_accessible_from<
+                  MemorySpace, ExecutionSpace>::value);
+    Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+
+    using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+    using Tag = typename Predicates::value_type::Tag;
+    static_assert(std::is_same_v<Tag, Details::SpatialPredicateTag>,
+                  "queryAny only supports spatial predicates");
+
+    Details::CrsGraphWrapperImpl::queryAny(
+        *this, space, Predicates{user_predicates}, hits, policy);
+  }
+
+  // Reduction query: folds the matches of predicate i into results(i)
+  // during the traversal, skipping CRS materialization entirely (no output
+  // allocation, one pass instead of two). The functor is called as
+  // functor(predicate, value, update) with update referencing results(i);
+  // one thread walks a predicate, so the update needs no atomics. results
+  // must be pre-sized to the number of predicates and pre-filled with the
+  // reduction identity (e.g. zero for a mass sum, the largest float for a
+  // closest-distance fold), which also lets successive calls accumulate.
+  template <typename ExecutionSpace, typename UserPredicates,
+            typename Functor, typename ResultView>
+  std::enable_if_t<Kokkos::is_view_v<ResultView>>
+  queryReduce(ExecutionSpace const &space,
+              UserPredicates const &user_predicates, Functor const &functor,
+              ResultView &results,
+              Experimental::TraversalPolicy const &policy =
+                  Experimental::TraversalPolicy()) const
+  {
+    static_assert(Details::KokkosExt::is_accessible_from<
+                  MemorySpace, ExecutionSpace>::value);
+    Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+
+    using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+    using Tag = typename Predicates::value_type::Tag;
+    static_assert(std::is_same_v<Tag, Details::SpatialPredicateTag>,
+                  "queryReduce only supports spatial predicates");
+
+    Details::CrsGraphWrapperImpl::queryReduce(
+        *this, space, Predicates{user_predicates}, functor, results, policy);
+  }
+
+  // Team-cooperative reduction query: like queryReduce, but a whole team
+  // traverses each predicate, so predicates matching thousands of leaves
+  // spread their callback work across the team instead of serializing it on
+  // one thread. Every member folds its matches into a private partial and
+  // the partials are summed with a team reduction before results(i) is
+  // updated, which restricts the fold to a sum: the result type must
+  // value-initialize to the identity and define operator+. results must be
+  // pre-sized and pre-filled as for queryReduce; the commit accumulates.
+  template <typename ExecutionSpace, typename UserPredicates,
+            typename Functor, typename ResultView>
+  std::enable_if_t<Kokkos::is_view_v<ResultView>>
+  queryReduceTeam(ExecutionSpace const &space,
+                  UserPredicates const &user_predicates,
+                  Functor const &functor, ResultView &results,
+                  Experimental::TraversalPolicy const &policy =
+                      Experimental::TraversalPolicy()) const
+  {
+    static_assert(Details::KokkosExt::is_accessible_from<
+                  MemorySpace, ExecutionSpace>::value);
+    Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+
+    using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+    using Tag = typename Predicates::value_type::Tag;
+    static_assert(std::is_same_v<Tag, Details::SpatialPredicateTag>,
+                  "queryReduceTeam only supports spatial predicates");
+
+    Details::CrsGraphWrapperImpl::queryReduceTeam(
+        *this, space, Predicates{user_predicates}, functor, results, policy);
+  }
+
+  // Dense nearest query: the results of predicate i are written to row i of
+  // the rank-2 (num_queries, k) output view, and counts(i) receives the
+  // number of valid entries in the row (fewer than k only when the tree
+  // holds fewer values). Since every row is bounded by k, this skips the
+  // offsets computation of the CRS layout entirely and writes fixed-stride
+  // rows consumers can index without indirection.
+  template <typename ExecutionSpace, typename UserPredicates, typename OutView,
+            typename CountView>
+  std::enable_if_t<Kokkos::is_view_v<OutView> && Kokkos::is_view_v<CountView>>
+  queryNearestDense(ExecutionSpace const &space,
+                    UserPredicates const &user_predicates, OutView const &out,
+                    CountView &counts,
+                    Experimental::TraversalPolicy const &policy =
+                        Experimental::TraversalPolicy()) const
+  {
+    static_assert(Details::KokkosExt::is_accessible_from<
+                  MemorySpace, ExecutionSpace>::value);
+    Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+
+    using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+    using Tag = typename Predicates::value_type::Tag;
+    static_assert(std::is_same_v<Tag, Details::NearestPredicateTag>,
+                  "queryNearestDense only supports nearest predicates");
+
+    Details::CrsGraphWrapperImpl::queryNearestDense(
+        *this, space, Predicates{user_predicates}, out, counts, policy);
+  }
+
+  // Heterogeneous batch query: a spatial and a nearest batch are answered
+  // together, with one joint predicate sort and one count and one fill
+  // launch covering both, instead of two back-to-back query() calls whose
+  // smaller batch is mostly launch overhead. Spatial predicate i fills row i
+  // of the CRS output and nearest predicate j row spatial_count + j.
+  template <typename ExecutionSpace, typename SpatialUserPredicates,
+            typename NearestUserPredicates, typename OutputView,
+            typename OffsetView>
+  std::enable_if_t<Kokkos::is_view_v<OutputView> &&
+                   Kokkos::is_view_v<OffsetView>>
+  queryMixed(ExecutionSpace const &space,
+             SpatialUserPredicates const &spatial_user_predicates,
+             NearestUserPredicates const &nearest_user_predicates,
+             OutputView &out, OffsetView &offset,
+             Experimental::TraversalPolicy const &policy =
+                 Experimental::TraversalPolicy()) const
+  {
+    static_assert(Details::KokkosExt::is_accessible_from<
+                  MemorySpace, ExecutionSpace>::value);
+    Details::check_valid_access_traits(PredicatesTag{},
+                                       spatial_user_predicates);
+    Details::check_valid_access_traits(PredicatesTag{},
+                                       nearest_user_predicates);
+
+    using SpatialPredicates =
+        Details::AccessValues<SpatialUserPredicates, PredicatesTag>;
+    using NearestPredicates =
+        Details::AccessValues<NearestUserPredicates, PredicatesTag>;
+    static_assert(std::is_same_v<typename SpatialPredicates::value_type::Tag,
+                                 Details::SpatialPredicateTag>,
+                  "the first batch must consist of spatial predicates");
+    static_assert(std::is_same_v<typename NearestPredicates::value_type::Tag,
+                                 Details::NearestPredicateTag>,
+                  "the second batch must consist of nearest predicates");
+
+    Details::CrsGraphWrapperImpl::queryMixed(
+        *this, space, SpatialPredicates{spatial_user_predicates},
+        NearestPredicates{nearest_user_predicates}, out, offset, policy);
+  }
+
+  // Instrumented query: invokes the callback exactly as query() would, and
+  // additionally fills stats(i) with the traversal counters of predicate i
+  // (see Experimental::TraversalStatistics). Runs a dedicated traversal so
+  // that the production query path stays counter-free; predicates are not
+  // sorted, keeping stats indexed by the user's predicate order.
+  template <typename ExecutionSpace, typename UserPredicates,
+            typename Callback, typename StatsView>
+  std::enable_if_t<Kokkos::is_view_v<StatsView>>
+  queryInstrumented(ExecutionSpace const &space,
+                    UserPredicates const &user_predicates,
+                    Callback const &callback, StatsView &stats) const
+  {
+    static_assert(Details::KokkosExt::is_accessible_from<
+                  MemorySpace, ExecutionSpace>::value);
+    Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+    Details::check_valid_callback<value_type>(callback, user_predicates);
+
+    using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+    Predicates predicates{user_predicates};
+
+    Details::KokkosExt::reallocWithoutInitializing(space, stats,
+                                                   predicates.size());
+    Details::traverseInstrumented(space, *this, predicates, callback, stats);
+  }
+
   template <typename Predicate, typename Callback>
   KOKKOS_FUNCTION void query(Experimental::PerThread,
                              Predicate const &predicate,
@@ -121,26 +550,75 @@ public:
     tree_traversal(predicate);
   }
 
+  // Team-cooperative in-kernel query: the members of the calling team
+  // jointly traverse one predicate, each claiming a disjoint subtree, which
+  // removes the single-thread divergence of the PerThread variant. All
+  // members must call with the same predicate. The callback may be invoked
+  // concurrently by different members, and an early-exit hint only
+  // terminates the caller's portion of the traversal. Spatial predicates
+  // only.
+  template <typename TeamMember, typename Predicate, typename Callback>
+  KOKKOS_FUNCTION void query(Experimental::PerTeam, TeamMember const &team,
+                             Predicate const &predicate,
+                             Callback const &callback) const
+  {
+    static_assert(
+        std::is_same_v<typename Predicate::Tag, Details::SpatialPredicateTag>,
+        "PerTeam query only supports spatial predicates");
+    ArborX::Details::TreeTraversal<BoundingVolumeHierarchy,
+                                   /* Predicates Dummy */ std::true_type,
+                                   Callback, typename Predicate::Tag>
+        tree_traversal(*this, callback);
+    tree_traversal(predicate, team.team_rank(), team.team_size());
+  }
+
 private:
   friend struct Details::HappyTreeFriends;
+  template <typename, typename, typename, typename, typename>
+  friend class BoundingVolumeHierarchy;
+
+  static constexpr bool use_soa_values =
+      std::is_same_v<ValuesLayout, Experimental::ValuesSoA>;
+  static_assert(std::is_same_v<ValuesLayout, Experimental::ValuesAoS> ||
+                    use_soa_values,
+                "Invalid values layout");
+  static_assert(!use_soa_values ||
+                    (Details::is_pair_value_index<Value>::value &&
+                     std::is_same_v<IndexableGetter,
+                                    Details::DefaultIndexableGetter>),
+                "SoA values layout requires PairValueIndex values with the "
+                "default indexable getter (see attach_indices())");
 
   using indexable_type =
       std::decay_t<std::invoke_result_t<IndexableGetter, Value>>;
-  using leaf_node_type = Details::LeafNode<value_type>;
+  // With the SoA layout the leaves only store the indexable; the indices
+  // live in _indices and getValue() reassembles the pair
+  using leaf_value_type =
+      std::conditional_t<use_soa_values, indexable_type, value_type>;
+  using leaf_node_type = Details::LeafNode<leaf_value_type>;
   using internal_node_type = Details::InternalNode<bounding_volume_type>;
+  using index_type = typename Details::pair_value_index_type<Value>::type;
 
   size_type _size{0};
   bounding_volume_type _bounds;
   Kokkos::View<leaf_node_type *, MemorySpace> _leaf_nodes;
   Kokkos::View<internal_node_type *, MemorySpace> _internal_nodes;
   IndexableGetter _indexable_getter;
+  // Indices of the values in leaf order; empty unless the SoA layout is used
+  Kokkos::View<index_type *, MemorySpace> _indices;
+  // Leaf order assigned by the space-filling curve, kept to allow update()
+  // to match new values to their leaves. Parent links are recovered from the
+  // ropes on the first update() call.
+  Kokkos::View<unsigned int *, MemorySpace> _permutation;
+  Kokkos::View<int *, MemorySpace> _parents;
 };
 
 // The partial template specialization parameters *must* match the default ones
 template <typename MemorySpace>
 class BoundingVolumeHierarchy<MemorySpace, Details::LegacyDefaultTemplateValue,
                               Details::DefaultIndexableGetter,
-                              ExperimentalHyperGeometry::Box<3, float>>
+                              ExperimentalHyperGeometry::Box<3, float>,
+                              Experimental::ValuesAoS>
     : public BoundingVolumeHierarchy<MemorySpace, PairValueIndex<Box>,
                                      Details::DefaultIndexableGetter, Box>
 {
@@ -228,6 +706,14 @@ public:
   {
     base_type::query(tag, predicate, callback);
   }
+
+  template <typename TeamMember, typename Predicate, typename Callback>
+  KOKKOS_FUNCTION void query(Experimental::PerTeam tag, TeamMember const &team,
+                             Predicate const &predicate,
+                             Callback const &callback) const
+  {
+    base_type::query(tag, team, predicate, callback);
+  }
 };
 
 template <
@@ -242,42 +728,319 @@ using BVH = BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
                                     BoundingVolume>;
 
 template <typename MemorySpace, typename Value, typename IndexableGetter,
-          typename BoundingVolume>
+          typename BoundingVolume, typename ValuesLayout>
 template <typename ExecutionSpace, typename UserValues,
-          typename SpaceFillingCurve>
-BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter, BoundingVolume>::
+          typename SpaceFillingCurve, typename Builder>
+BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter, BoundingVolume,
+                        ValuesLayout>::
     BoundingVolumeHierarchy(ExecutionSpace const &space,
                             UserValues const &user_values,
                             IndexableGetter const &indexable_getter,
-                            SpaceFillingCurve const &curve)
+                            SpaceFillingCurve const &curve,
+                            Builder const &builder,
+                            Experimental::BuildWorkspace<MemorySpace>
+                                *workspace)
     : _size(AccessTraits<UserValues, PrimitivesTag>::size(user_values))
     , _leaf_nodes(Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
                                      "ArborX::BVH::leaf_nodes"),
-                  _size)
+                  use_soa_values ? 0 : _size)
     , _internal_nodes(Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
                                          "ArborX::BVH::internal_nodes"),
-                      _size > 1 ? _size - 1 : 0)
+                      (use_soa_values || _size <= 1) ? 0 : _size - 1)
     , _indexable_getter(indexable_getter)
 {
+  if constexpr (std::is_same_v<SpaceFillingCurve, Experimental::AutoMorton>)
+  {
+    // Decide on a concrete code width from the input and delegate; the
+    // narrow code builds faster whenever the dataset cannot produce
+    // meaningful key collisions
+    Details::check_valid_access_traits<UserValues>(
+        PrimitivesTag{}, user_values, Details::DoNotCheckGetReturnType());
+    using Values = Details::AccessValues<UserValues, PrimitivesTag>;
+    if (Details::selectNarrowMortonCode(space, Values{user_values},
+                                        _indexable_getter, curve))
+      *this = BoundingVolumeHierarchy(space, user_values, indexable_getter,
+                                      Experimental::Morton32{}, builder,
+                                      workspace);
+    else
+      *this = BoundingVolumeHierarchy(space, user_values, indexable_getter,
+                                      Experimental::Morton64{}, builder,
+                                      workspace);
+  }
+  else if constexpr (use_soa_values)
+  {
+    // Build with the default layout so every builder path stays unchanged,
+    // then split the leaves. The transient pair array is released right
+    // after; the internal nodes and the permutation are shared, not copied.
+    BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
+                            BoundingVolume>
+        aos(space, user_values, indexable_getter, curve, builder, workspace);
+
+    _bounds = aos._bounds;
+    _internal_nodes = aos._internal_nodes;
+    _permutation = aos._permutation;
+
+    auto const aos_leaf_nodes = aos._leaf_nodes;
+    auto const n = aos_leaf_nodes.size();
+    Kokkos::View<leaf_node_type *, MemorySpace> leaf_nodes(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::BVH::leaf_nodes"),
+        n);
+    Kokkos::View<index_type *, MemorySpace> indices(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::BVH::indices"),
+        n);
+    Kokkos::parallel_for(
+        "ArborX::BVH::BVH::split_leaf_nodes",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i) {
+          auto const &leaf = aos_leaf_nodes(i);
+          leaf_nodes(i) = {leaf.rope, leaf.value.value};
+          indices(i) = leaf.value.index;
+        });
+    _leaf_nodes = leaf_nodes;
+    _indices = indices;
+
+    return;
+  }
+  else
+  {
+    static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                         ExecutionSpace>::value);
+    // FIXME redo with RangeTraits
+    Details::check_valid_access_traits<UserValues>(
+        PrimitivesTag{}, user_values, Details::DoNotCheckGetReturnType());
+
+    using Values = Details::AccessValues<UserValues, PrimitivesTag>;
+    Values values{user_values};
+
+    static_assert(
+        Details::KokkosExt::is_accessible_from<typename Values::memory_space,
+                                               ExecutionSpace>::value,
+        "Values must be accessible from the execution space");
+
+    constexpr int DIM = GeometryTraits::dimension_v<BoundingVolume>;
+
+    Details::check_valid_space_filling_curve<DIM>(curve);
+
+    Kokkos::Profiling::ScopedRegion guard("ArborX::BVH::BVH");
+    Kokkos::Profiling::markEvent("ArborX::BVH::BVH::num_values=" +
+                                 std::to_string(size()));
+
+    if (empty())
+    {
+      return;
+    }
+
+    if (size() == 1)
+    {
+      Details::TreeConstruction::initializeSingleLeafTree(
+          space, values, _indexable_getter, _leaf_nodes, _bounds);
+      return;
+    }
+
+    if constexpr (std::is_same_v<Builder, Experimental::SAHBuilder>)
+    {
+      // The SAH builder partitions primitives directly; no space-filling curve
+      // projection or sort is involved
+      Kokkos::Profiling::pushRegion("ArborX::BVH::BVH::generate_hierarchy_sah");
+      Details::TreeConstruction::generateHierarchySAH(
+          space, values, _indexable_getter, builder.num_bins, _leaf_nodes,
+          _internal_nodes, _bounds);
+      Kokkos::Profiling::popRegion();
+      return;
+    }
+
+    if constexpr (std::is_same_v<Builder, Experimental::KarrasBuilder>)
+    {
+      if (size() <= (size_type)builder.single_kernel_threshold &&
+          builder.restructure_rounds == 0 && !builder.assume_presorted)
+      {
+        // Small tree: everything (bounds, curve projection, sort, hierarchy)
+        // in one launch
+        Kokkos::Profiling::ScopedRegion small_guard(
+            "ArborX::BVH::BVH::build_small_tree");
+        using LinearOrderingValueType = std::invoke_result_t<
+            SpaceFillingCurve,
+            ExperimentalHyperGeometry::Box<
+                DIM,
+                typename GeometryTraits::coordinate_type<BoundingVolume>::type>,
+            indexable_type>;
+        using Workspace = Experimental::BuildWorkspace<MemorySpace>;
+        Kokkos::View<LinearOrderingValueType *, MemorySpace> linear_ordering;
+        if (workspace)
+          linear_ordering = workspace->template scratch<LinearOrderingValueType>(
+              Workspace::LinearOrdering, size());
+        else
+          linear_ordering = Kokkos::View<LinearOrderingValueType *, MemorySpace>(
+              Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                                 "ArborX::BVH::BVH::linear_ordering"),
+              size());
+        _permutation = Kokkos::View<unsigned int *, MemorySpace>(
+            Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                               "ArborX::BVH::BVH::permutation"),
+            size());
+        Details::TreeConstruction::buildSmallTree(
+            space, values, _indexable_getter, curve, linear_ordering,
+            _permutation, _leaf_nodes, _internal_nodes, _bounds);
+        return;
+      }
+    }
+
+    Details::Indexables<Values, IndexableGetter> indexables{values,
+                                                            indexable_getter};
+
+    Kokkos::Profiling::pushRegion("ArborX::BVH::BVH::compute_linear_ordering");
+
+    ExperimentalHyperGeometry::Box<
+        DIM, typename GeometryTraits::coordinate_type<BoundingVolume>::type>
+        bbox{};
+
+    // Map indexables from multidimensional domain to one-dimensional interval
+    using LinearOrderingValueType =
+        std::invoke_result_t<SpaceFillingCurve, decltype(bbox), indexable_type>;
+    using Workspace = Experimental::BuildWorkspace<MemorySpace>;
+    Kokkos::View<LinearOrderingValueType *, MemorySpace> linear_ordering_indices;
+    if (workspace)
+      linear_ordering_indices = workspace->template scratch<
+          LinearOrderingValueType>(Workspace::LinearOrdering, size());
+    else
+      linear_ordering_indices = Kokkos::View<LinearOrderingValueType *,
+                                             MemorySpace>(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                             "ArborX::BVH::BVH::linear_ordering"),
+          size());
+    if constexpr (GeometryTraits::is_point<indexable_type>{})
+    {
+      // For points, caching centroids would only duplicate the input; keep the
+      // two separate streaming passes
+      Details::TreeConstruction::calculateBoundingBoxOfTheScene(space,
+                                                                indexables, bbox);
+      Details::TreeConstruction::projectOntoSpaceFillingCurve(
+          space, indexables, curve, bbox, linear_ordering_indices);
+    }
+    else
+    {
+      // Fused path: compute the scene bounds while caching centroids so the
+      // second pass does not re-stream the primitives
+      using CentroidPoint = std::decay_t<decltype(Details::returnCentroid(
+          std::declval<indexable_type>()))>;
+      if (workspace)
+        Details::TreeConstruction::projectOntoSpaceFillingCurveFused(
+            space, indexables, curve, bbox, linear_ordering_indices,
+            workspace->template scratch<CentroidPoint>(Workspace::Centroids,
+                                                       size()));
+      else
+        Details::TreeConstruction::projectOntoSpaceFillingCurveFused(
+            space, indexables, curve, bbox, linear_ordering_indices);
+    }
+
+    Kokkos::Profiling::popRegion();
+    Kokkos::Profiling::pushRegion("ArborX::BVH::BVH::sort_linearized_order");
+
+    // Compute the ordering of the indexables along the space-filling curve
+    bool assume_presorted = false;
+    if constexpr (!std::is_same_v<Builder, Experimental::SAHBuilder>)
+      assume_presorted = builder.assume_presorted;
+
+    Kokkos::View<unsigned int *, MemorySpace> permutation_indices;
+    if (assume_presorted)
+    {
+      // The caller guarantees the values are already in curve order; the
+      // permutation degenerates to the identity
+      permutation_indices = Kokkos::View<unsigned int *, MemorySpace>(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                             "ArborX::BVH::BVH::permutation"),
+          size());
+      Details::KokkosExt::iota(space, permutation_indices);
+    }
+    else
+    {
+      permutation_indices = Details::sortObjects(space, linear_ordering_indices);
+    }
+    _permutation = permutation_indices;
+
+    Kokkos::Profiling::popRegion();
+    Kokkos::Profiling::pushRegion("ArborX::BVH::BVH::generate_hierarchy");
+
+    // Generate bounding volume hierarchy
+    if constexpr (std::is_same_v<Builder, Experimental::PLOCBuilder>)
+    {
+      Details::TreeConstruction::generateHierarchyPLOC(
+          space, values, _indexable_getter, permutation_indices, _leaf_nodes,
+          _internal_nodes, _bounds, builder.search_radius);
+    }
+    else
+    {
+      static_assert(std::is_same_v<Builder, Experimental::KarrasBuilder>,
+                    "Invalid builder");
+      if (builder.compute_parents && builder.restructure_rounds == 0 &&
+          !builder.bfs_relayout)
+        _parents = Kokkos::View<int *, MemorySpace>(
+            Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                               "ArborX::BVH::parents"),
+            2 * size() - 1);
+      if (workspace)
+        Details::TreeConstruction::generateHierarchy(
+            space, values, _indexable_getter, permutation_indices,
+            linear_ordering_indices, _leaf_nodes, _internal_nodes, _bounds,
+            workspace->template scratch<int>(Workspace::HierarchyRanges,
+                                             _internal_nodes.size()),
+            _parents);
+      else
+        Details::TreeConstruction::generateHierarchy(
+            space, values, _indexable_getter, permutation_indices,
+            linear_ordering_indices, _leaf_nodes, _internal_nodes, _bounds,
+            _parents);
+    }
+
+    if constexpr (!std::is_same_v<Builder, Experimental::SAHBuilder>)
+    {
+      if (builder.restructure_rounds > 0)
+      {
+        Kokkos::Profiling::pushRegion("ArborX::BVH::BVH::restructure");
+        Details::TreeConstruction::optimizeTreeRotations(
+            space, _indexable_getter, _leaf_nodes, _internal_nodes,
+            builder.restructure_rounds);
+        Kokkos::Profiling::popRegion();
+      }
+      if (builder.bfs_relayout)
+      {
+        Kokkos::Profiling::pushRegion("ArborX::BVH::BVH::relayout");
+        Details::TreeConstruction::relayoutBreadthFirst(space, _leaf_nodes,
+                                                        _internal_nodes);
+        Kokkos::Profiling::popRegion();
+      }
+    }
+
+    Kokkos::Profiling::popRegion();
+  }
+}
+
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume, typename ValuesLayout>
+template <typename ExecutionSpace, typename UserValues>
+void BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter,
+                             BoundingVolume,
+                             ValuesLayout>::update(ExecutionSpace const &space,
+                                                   UserValues const
+                                                       &user_values)
+{
+  static_assert(!use_soa_values,
+                "update() is not available with the SoA values layout");
   static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
                                                        ExecutionSpace>::value);
-  // FIXME redo with RangeTraits
   Details::check_valid_access_traits<UserValues>(
       PrimitivesTag{}, user_values, Details::DoNotCheckGetReturnType());
 
   using Values = Details::AccessValues<UserValues, PrimitivesTag>;
   Values values{user_values};
 
-  static_assert(
-      Details::KokkosExt::is_accessible_from<typename Values::memory_space,
-                                             ExecutionSpace>::value,
-      "Values must be accessible from the execution space");
+  ARBORX_ASSERT(values.size() == size());
+  // Trees built by the SAH builder do not record the leaf permutation
+  ARBORX_ASSERT(size() <= 1 || _permutation.size() == size());
 
-  constexpr int DIM = GeometryTraits::dimension_v<BoundingVolume>;
-
-  Details::check_valid_space_filling_curve<DIM>(curve);
-
-  Kokkos::Profiling::ScopedRegion guard("ArborX::BVH::BVH");
+  Kokkos::Profiling::ScopedRegion guard("ArborX::BVH::update");
 
   if (empty())
   {
@@ -291,58 +1054,145 @@ BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter, BoundingVolume>::
     return;
   }
 
-  Details::Indexables<Values, IndexableGetter> indexables{values,
-                                                          indexable_getter};
+  if (_parents.size() == 0)
+  {
+    _parents = Kokkos::View<int *, MemorySpace>(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::BVH::parents"),
+        2 * size() - 1);
+    Details::TreeRefit::computeParents(space, _leaf_nodes, _internal_nodes,
+                                       _parents);
+  }
 
-  Kokkos::Profiling::pushRegion(
-      "ArborX::BVH::BVH::calculate_scene_bounding_box");
+  Details::TreeRefit::refitHierarchy(space, values, _indexable_getter,
+                                     _permutation, _leaf_nodes,
+                                     _internal_nodes, _parents, _bounds);
+}
 
-  // determine the bounding box of the scene
-  ExperimentalHyperGeometry::Box<
-      DIM, typename GeometryTraits::coordinate_type<BoundingVolume>::type>
-      bbox{};
-  Details::TreeConstruction::calculateBoundingBoxOfTheScene(space, indexables,
-                                                            bbox);
-  Kokkos::Profiling::popRegion();
-  Kokkos::Profiling::pushRegion("ArborX::BVH::BVH::compute_linear_ordering");
-
-  // Map indexables from multidimensional domain to one-dimensional interval
-  using LinearOrderingValueType =
-      std::invoke_result_t<SpaceFillingCurve, decltype(bbox), indexable_type>;
-  Kokkos::View<LinearOrderingValueType *, MemorySpace> linear_ordering_indices(
-      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
-                         "ArborX::BVH::BVH::linear_ordering"),
-      size());
-  Details::TreeConstruction::projectOntoSpaceFillingCurve(
-      space, indexables, curve, bbox, linear_ordering_indices);
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume, typename ValuesLayout>
+void BoundingVolumeHierarchy<
+    MemorySpace, Value, IndexableGetter, BoundingVolume,
+    ValuesLayout>::saveToFile(std::string const &filename) const
+{
+  static_assert(!use_soa_values,
+                "the version-1 file format does not store the indices array "
+                "of the SoA values layout");
+  static_assert(std::is_trivially_copyable_v<leaf_node_type> &&
+                std::is_trivially_copyable_v<internal_node_type>,
+                "Serialized node arrays are raw memory images");
 
-  Kokkos::Profiling::popRegion();
-  Kokkos::Profiling::pushRegion("ArborX::BVH::BVH::sort_linearized_order");
+  Kokkos::Profiling::ScopedRegion guard("ArborX::BVH::saveToFile");
 
-  // Compute the ordering of the indexables along the space-filling curve
-  auto permutation_indices =
-      Details::sortObjects(space, linear_ordering_indices);
+  std::ofstream file(filename, std::ios::binary);
+  ARBORX_ASSERT(file.is_open());
 
-  Kokkos::Profiling::popRegion();
-  Kokkos::Profiling::pushRegion("ArborX::BVH::BVH::generate_hierarchy");
+  auto write_section = [&file](void const *data, std::size_t n) {
+    constexpr auto alignment = Details::tree_file_alignment;
+    char const zeros[alignment] = {};
+    file.write(static_cast<char const *>(data), n);
+    if (n % alignment != 0)
+      file.write(zeros, alignment - n % alignment);
+  };
 
-  // Generate bounding volume hierarchy
-  Details::TreeConstruction::generateHierarchy(
-      space, values, _indexable_getter, permutation_indices,
-      linear_ordering_indices, _leaf_nodes, _internal_nodes, _bounds);
+  Details::TreeFileHeader header;
+  std::memcpy(header.magic, Details::tree_file_magic, sizeof(header.magic));
+  header.version = Details::tree_file_version;
+  header.leaf_node_size = sizeof(leaf_node_type);
+  header.internal_node_size = sizeof(internal_node_type);
+  header.bounding_volume_size = sizeof(bounding_volume_type);
+  header.size = _size;
+  header.permutation_size = _permutation.extent(0);
+  write_section(&header, sizeof(header));
+  write_section(&_bounds, sizeof(_bounds));
 
-  Kokkos::Profiling::popRegion();
+  // The parent links are not stored; update() recovers them from the ropes
+  auto leaf_nodes =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, _leaf_nodes);
+  write_section(leaf_nodes.data(), leaf_nodes.size() * sizeof(leaf_node_type));
+  auto internal_nodes =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, _internal_nodes);
+  write_section(internal_nodes.data(),
+                internal_nodes.size() * sizeof(internal_node_type));
+  auto permutation =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, _permutation);
+  write_section(permutation.data(), permutation.size() * sizeof(unsigned int));
+
+  ARBORX_ASSERT(file.good());
+}
+
+template <typename MemorySpace, typename Value, typename IndexableGetter,
+          typename BoundingVolume, typename ValuesLayout>
+template <typename ExecutionSpace>
+BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter, BoundingVolume,
+                        ValuesLayout>
+BoundingVolumeHierarchy<MemorySpace, Value, IndexableGetter, BoundingVolume,
+                        ValuesLayout>::
+    loadFromFile(ExecutionSpace const &space, std::string const &filename,
+                 IndexableGetter const &indexable_getter)
+{
+  static_assert(!use_soa_values,
+                "the version-1 file format does not store the indices array "
+                "of the SoA values layout");
+  Kokkos::Profiling::ScopedRegion guard("ArborX::BVH::loadFromFile");
+
+  std::ifstream file(filename, std::ios::binary);
+  ARBORX_ASSERT(file.is_open());
+
+  auto read_section = [&file](void *data, std::size_t n) {
+    constexpr auto alignment = Details::tree_file_alignment;
+    file.read(static_cast<char *>(data), n);
+    if (n % alignment != 0)
+      file.seekg(alignment - n % alignment, std::ios::cur);
+  };
+
+  Details::TreeFileHeader header;
+  read_section(&header, sizeof(header));
+  ARBORX_ASSERT(file.good());
+  ARBORX_ASSERT(std::memcmp(header.magic, Details::tree_file_magic,
+                            sizeof(header.magic)) == 0);
+  ARBORX_ASSERT(header.version == Details::tree_file_version);
+  // The node layout of the reader must match the writer's bit for bit
+  ARBORX_ASSERT(header.leaf_node_size == sizeof(leaf_node_type) &&
+                header.internal_node_size == sizeof(internal_node_type) &&
+                header.bounding_volume_size == sizeof(bounding_volume_type));
+
+  BoundingVolumeHierarchy tree;
+  tree._size = header.size;
+  tree._indexable_getter = indexable_getter;
+  read_section(&tree._bounds, sizeof(tree._bounds));
+
+  auto load_view = [&space, &read_section](auto &view, char const *label,
+                                           std::size_t n) {
+    using View = std::decay_t<decltype(view)>;
+    view = View(Kokkos::view_alloc(space, Kokkos::WithoutInitializing, label),
+                n);
+    auto mirror = Kokkos::create_mirror_view(Kokkos::WithoutInitializing, view);
+    read_section(mirror.data(), n * sizeof(typename View::value_type));
+    Kokkos::deep_copy(space, view, mirror);
+    // The host buffer goes out of scope here
+    space.fence("ArborX::BVH::loadFromFile");
+  };
+
+  load_view(tree._leaf_nodes, "ArborX::BVH::leaf_nodes", tree._size);
+  load_view(tree._internal_nodes, "ArborX::BVH::internal_nodes",
+            tree._size > 1 ? tree._size - 1 : 0);
+  load_view(tree._permutation, "ArborX::BVH::permutation",
+            header.permutation_size);
+
+  ARBORX_ASSERT(file.good());
+  return tree;
 }
 
 template <typename MemorySpace, typename Value, typename IndexableGetter,
-          typename BoundingVolume>
+          typename BoundingVolume, typename ValuesLayout>
 template <typename ExecutionSpace, typename UserPredicates, typename Callback>
 void BoundingVolumeHierarchy<
-    MemorySpace, Value, IndexableGetter,
-    BoundingVolume>::query(ExecutionSpace const &space,
-                           UserPredicates const &user_predicates,
-                           Callback const &callback,
-                           Experimental::TraversalPolicy const &policy) const
+    MemorySpace, Value, IndexableGetter, BoundingVolume,
+    ValuesLayout>::query(ExecutionSpace const &space,
+                         UserPredicates const &user_predicates,
+                         Callback const &callback,
+                         Experimental::TraversalPolicy const &policy) const
 {
   static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
                                                        ExecutionSpace>::value);
@@ -378,7 +1228,59 @@ void BoundingVolumeHierarchy<
 
   Kokkos::Profiling::pushRegion(profiling_prefix);
 
-  if (policy._sort_predicates)
+  auto const do_traverse = [&](auto const &predicates_) {
+    if constexpr (std::is_same_v<Tag, Details::SpatialPredicateTag>)
+    {
+      if (policy._work_queue)
+      {
+        Details::traverseWithWorkQueue(space, *this, predicates_, callback);
+        return;
+      }
+      if (policy._coherent_batches)
+      {
+        Details::traverseCoherently(space, *this, predicates_, callback);
+        return;
+      }
+      if constexpr (Details::predicate_packets_are_rays_v<Predicates> &&
+                    GeometryTraits::is_box<bounding_volume_type>::value &&
+                    GeometryTraits::dimension_v<bounding_volume_type> == 3)
+      {
+        if (policy._ray_packets)
+        {
+          Details::traverseRayPackets(space, *this, predicates_, callback);
+          return;
+        }
+      }
+      if (policy._scratch_tree)
+      {
+        Details::traverseWithScratchTree(space, *this, predicates_, callback);
+        return;
+      }
+    }
+    if constexpr (std::is_same_v<Tag, Details::NearestPredicateTag>)
+    {
+      if (policy._restart_trail)
+      {
+        Details::traverseWithRestartTrail(space, *this, predicates_, callback);
+        return;
+      }
+      if (policy._scratch_stacks)
+      {
+        Details::traverseWithScratchStacks(space, *this, predicates_,
+                                           callback);
+        return;
+      }
+      if (policy._k_major_buffer)
+      {
+        Details::traverseWithKMajorBuffer(space, *this, predicates_, callback);
+        return;
+      }
+    }
+    Details::traverse(space, *this, predicates_, callback,
+                      policy._latency_histogram);
+  };
+
+  if (policy._sort_predicates || policy._cost_scheduling)
   {
     Kokkos::Profiling::pushRegion(profiling_prefix + "::compute_permutation");
     using DeviceType = Kokkos::Device<ExecutionSpace, MemorySpace>;
@@ -388,24 +1290,63 @@ void BoundingVolumeHierarchy<
         scene_bounding_box{};
     using namespace Details;
     expand(scene_bounding_box, bounds());
-    auto permute = Details::BatchedQueries<DeviceType>::
-        sortPredicatesAlongSpaceFillingCurve(space, Experimental::Morton32(),
-                                             scene_bounding_box, predicates);
+    auto permute =
+        policy._cost_scheduling
+            ? Details::BatchedQueries<DeviceType>::sortPredicatesByEstimatedCost(
+                  space, scene_bounding_box, predicates)
+            : Details::BatchedQueries<DeviceType>::
+                  sortPredicatesAlongSpaceFillingCurve(
+                      space, Experimental::Morton32(), scene_bounding_box,
+                      predicates);
     Kokkos::Profiling::popRegion();
 
     using PermutedPredicates =
         Details::PermutedData<Predicates, decltype(permute)>;
-    Details::traverse(space, *this, PermutedPredicates{predicates, permute},
-                      callback);
+    do_traverse(PermutedPredicates{predicates, permute});
   }
   else
   {
-    Details::traverse(space, *this, predicates, callback);
+    do_traverse(predicates);
   }
 
   Kokkos::Profiling::popRegion();
 }
 
+namespace Experimental
+{
+
+// Build a BVH whose leaves store only 32-bit indices into the user's
+// primitives; the indexable getter fetches the geometry from the original
+// view at traversal time (converting primitives that are not their own
+// bounding volume on the fly). Unlike attach_indices, the geometry is
+// never duplicated into the values array -- the indexable traffic turns
+// into cached reads of data the application already owns -- so tree memory
+// beyond the nodes drops to one index per primitive. The primitives must
+// stay alive and unchanged for the lifetime of the tree. Callbacks receive
+// the primitive index as the value.
+template <typename ExecutionSpace, typename Primitives,
+          typename SpaceFillingCurve = Morton64>
+auto make_index_only_bvh(ExecutionSpace const &space,
+                         Primitives const &primitives,
+                         SpaceFillingCurve const &curve = SpaceFillingCurve())
+{
+  Details::check_valid_access_traits(PrimitivesTag{}, primitives);
+  using AccessValues = Details::AccessValues<Primitives, PrimitivesTag>;
+  using MemorySpace = typename AccessValues::memory_space;
+  using IndexableGetter = PrimitivesIndexableGetter<AccessValues>;
+
+  AccessValues access_values{primitives};
+  // The counting stand-in writes the indices straight into the leaves,
+  // avoiding a materialized index view that would be copied once and
+  // discarded
+  Details::IndexValues<MemorySpace> values{
+      (std::size_t)access_values.size()};
+  return BoundingVolumeHierarchy<MemorySpace, unsigned, IndexableGetter>(
+      space, values, IndexableGetter{access_values}, curve);
+}
+
+} // namespace Experimental
+
 } // namespace ArborX
 
 #endif
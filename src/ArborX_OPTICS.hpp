@@ -0,0 +1,166 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_OPTICS_HPP
+#define ARBORX_OPTICS_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_MinimumSpanningTree.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <queue>
+#include <vector>
+
+namespace ArborX::Experimental
+{
+
+// Reachability plot: visiting the points in the order order(0), order(1),
+// ... produces the monotone expansion of the densest available region, with
+// reachability(i) the mutual reachability distance at which order(i) was
+// absorbed. Valleys in the plot are clusters, peaks separate them. The first
+// point of every connected sweep has no predecessor and gets infinity.
+template <typename MemorySpace>
+struct OPTICS
+{
+  Kokkos::View<int *, MemorySpace> order;
+  Kokkos::View<float *, MemorySpace> reachability;
+};
+
+// Compute the OPTICS ordering of the points for a given core_min_size.
+//
+// The expensive part — the neighbor searches and the minimum spanning tree
+// over mutual reachability distances — runs on device through the MST
+// machinery. The ordering itself is the Prim traversal of that tree (at
+// every step the unvisited point with the smallest connection to the
+// visited set is absorbed, which is exactly the OPTICS expansion with
+// unbounded eps); it only touches the n - 1 tree edges and is done on host,
+// like the other cluster-level sequential tails in the library.
+//
+// NOTE: reachabilities are the symmetric mutual reachability distances
+// max(core(p), core(q), d(p, q)), whereas the textbook OPTICS uses the
+// asymmetric max(core(q), d(p, q)). The plots differ only around points
+// whose own core distance dominates.
+template <typename ExecutionSpace, typename Primitives>
+OPTICS<typename Details::AccessValues<Primitives,
+                                      PrimitivesTag>::memory_space>
+optics(ExecutionSpace const &exec_space, Primitives const &primitives,
+       int core_min_size)
+{
+  Kokkos::Profiling::ScopedRegion guard("ArborX::OPTICS");
+
+  using Points = Details::AccessValues<Primitives, PrimitivesTag>;
+  using MemorySpace = typename Points::memory_space;
+
+  constexpr auto inf =
+      Details::KokkosExt::ArithmeticTraits::infinity<float>::value;
+
+  Points points{primitives};
+  int const n = points.size();
+
+  OPTICS<MemorySpace> result{
+      Kokkos::View<int *, MemorySpace>(
+          Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                             "ArborX::OPTICS::order"),
+          n),
+      Kokkos::View<float *, MemorySpace>(
+          Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                             "ArborX::OPTICS::reachability"),
+          n)};
+  if (n == 0)
+    return result;
+  if (n == 1)
+  {
+    Kokkos::deep_copy(exec_space, result.order, 0);
+    Kokkos::deep_copy(exec_space, result.reachability, inf);
+    return result;
+  }
+
+  Kokkos::Profiling::pushRegion("ArborX::OPTICS::mst");
+  Details::MinimumSpanningTree<MemorySpace> mst(exec_space, primitives,
+                                                core_min_size);
+  Kokkos::Profiling::popRegion();
+
+  Kokkos::Profiling::pushRegion("ArborX::OPTICS::ordering");
+
+  auto edges_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{},
+                                                        mst.edges);
+  int const num_edges = n - 1;
+
+  // Build the adjacency of the tree
+  std::vector<int> offsets(n + 1, 0);
+  for (int e = 0; e < num_edges; ++e)
+  {
+    ++offsets[edges_host(e).source + 1];
+    ++offsets[edges_host(e).target + 1];
+  }
+  for (int v = 0; v < n; ++v)
+    offsets[v + 1] += offsets[v];
+  std::vector<int> incident(2 * num_edges);
+  {
+    auto starts = offsets;
+    for (int e = 0; e < num_edges; ++e)
+    {
+      incident[starts[edges_host(e).source]++] = e;
+      incident[starts[edges_host(e).target]++] = e;
+    }
+  }
+
+  // Prim traversal of the tree with a lazy min-heap. The heap only ever
+  // holds tree edges, so the walk is O(n log n) regardless of the original
+  // dimensionality.
+  auto order_host = Kokkos::create_mirror_view(result.order);
+  auto reachability_host = Kokkos::create_mirror_view(result.reachability);
+
+  using HeapEntry = std::pair<float, int>; // (weight, edge)
+  std::priority_queue<HeapEntry, std::vector<HeapEntry>,
+                      std::greater<HeapEntry>>
+      frontier;
+  std::vector<bool> visited(n, false);
+
+  int num_ordered = 0;
+  auto absorb = [&](int v, float reachability) {
+    visited[v] = true;
+    order_host(num_ordered) = v;
+    reachability_host(num_ordered) = reachability;
+    ++num_ordered;
+    for (int k = offsets[v]; k < offsets[v + 1]; ++k)
+    {
+      auto const &edge = edges_host(incident[k]);
+      if (!visited[edge.source] || !visited[edge.target])
+        frontier.push({edge.weight, incident[k]});
+    }
+  };
+
+  absorb(0, inf);
+  while (num_ordered < n)
+  {
+    auto [weight, e] = frontier.top();
+    frontier.pop();
+    auto const &edge = edges_host(e);
+    int const v = (visited[edge.source] ? edge.target : edge.source);
+    if (visited[v])
+      continue; // stale entry, both endpoints already absorbed
+    absorb(v, weight);
+  }
+
+  Kokkos::deep_copy(exec_space, result.order, order_host);
+  Kokkos::deep_copy(exec_space, result.reachability, reachability_host);
+
+  Kokkos::Profiling::popRegion();
+
+  return result;
+}
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -0,0 +1,205 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_RAY_STREAM_HPP
+#define ARBORX_RAY_STREAM_HPP
+
+#include <ArborX_Callbacks.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp> // iota
+#include <ArborX_DetailsSortUtils.hpp> // sortObjects, applyPermutation
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_Predicates.hpp>
+#include <ArborX_Ray.hpp>
+#include <ArborX_SpaceFillingCurves.hpp>
+#include <ArborX_TraversalPolicy.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <utility> // declval
+
+namespace ArborX
+{
+
+namespace Details
+{
+
+// Record the first hit reported for each ray of the round. With
+// ordered_intersects the hits arrive by increasing entry distance along the
+// ray, so the first one is the closest and the traversal can stop there.
+template <typename Hits, typename Found>
+struct RayStreamClosestHit
+{
+  Hits _hits;
+  Found _found;
+
+  template <typename Predicate, typename Value>
+  KOKKOS_FUNCTION auto operator()(Predicate const &predicate,
+                                  Value const &value) const
+  {
+    int const slot = getData(predicate);
+    _hits(slot) = value;
+    _found(slot) = 1;
+    return CallbackTreeTraversalControl::early_exit;
+  }
+};
+
+template <typename Tree>
+struct RayStreamHit
+{
+  using type = typename Tree::value_type;
+};
+
+// The legacy interface hands callbacks the index of the primitive, not the
+// stored value
+template <typename MemorySpace>
+struct RayStreamHit<BoundingVolumeHierarchy<
+    MemorySpace, LegacyDefaultTemplateValue, DefaultIndexableGetter,
+    ExperimentalHyperGeometry::Box<3, float>, Experimental::ValuesAoS>>
+{
+  using type = int;
+};
+
+} // namespace Details
+
+namespace Experimental
+{
+
+// Wavefront-style tracing of a batch of rays with multiple bounces. Each
+// round sorts the surviving rays by direction octant and quantized origin,
+// finds the closest hit of every ray with an ordered traversal, invokes the
+// shader on the hits, and compacts the batch before the next round. Sorting
+// restores the memory coherence that secondary (bounce) rays lose, and the
+// compaction keeps terminated rays from occupying threads, which is where
+// the classic speedup on incoherent workloads comes from.
+//
+// The shader is called once per bounce for every ray that hit something,
+// with the ray's index in the original batch, the hit (the stored value, or
+// the primitive index for the legacy interface), and a mutable reference to
+// the ray. Returning true continues the ray — the shader is expected to
+// have updated it to the bounce ray — and returning false retires it. Rays
+// that hit nothing retire silently; a shader that needs to handle misses
+// (e.g., an environment term) can track which of its rays never came back.
+// The loop ends when every ray has retired or after max_bounces rounds.
+template <typename ExecutionSpace, typename Tree, typename Rays,
+          typename Shader>
+void traverseRayStream(ExecutionSpace const &space, Tree const &tree,
+                       Rays const &rays, Shader const &shader, int max_bounces)
+{
+  Kokkos::Profiling::ScopedRegion guard("ArborX::RayStream");
+
+  static_assert(Kokkos::is_view_v<Rays> && Rays::rank == 1);
+  static_assert(
+      std::is_same_v<typename Rays::non_const_value_type, Experimental::Ray>);
+
+  using MemorySpace = typename Tree::memory_space;
+  using Hit = typename Details::RayStreamHit<Tree>::type;
+  using Predicate =
+      decltype(attach(ordered_intersects(std::declval<Ray const &>()), 0));
+
+  int const n = rays.extent(0);
+  if (n == 0 || tree.empty())
+    return;
+
+  Box const scene = tree.bounds();
+
+  Kokkos::View<int *, MemorySpace> active(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::RayStream::active"),
+      n);
+  Details::KokkosExt::iota(space, active);
+  int n_active = n;
+
+  for (int bounce = 0; n_active > 0 && bounce < max_bounces; ++bounce)
+  {
+    // Sort the active rays by direction octant first and Morton cell of the
+    // origin second, so that rays about to walk similar subtrees end up in
+    // the same thread batches
+    Kokkos::View<unsigned long long *, MemorySpace> keys(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::RayStream::keys"),
+        n_active);
+    Kokkos::parallel_for(
+        "ArborX::RayStream::compute_keys",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_active),
+        KOKKOS_LAMBDA(int j) {
+          auto const &ray = rays(active(j));
+          auto const &direction = ray.direction();
+          unsigned long long const octant = (direction[0] > 0 ? 1 : 0) |
+                                            (direction[1] > 0 ? 2 : 0) |
+                                            (direction[2] > 0 ? 4 : 0);
+          keys(j) = (octant << 61) | (Morton64{}(scene, ray.origin()) >> 3);
+        });
+    auto permute = Details::sortObjects(space, keys);
+    Details::applyPermutation(space, permute, active);
+
+    Kokkos::View<Predicate *, MemorySpace> predicates(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::RayStream::predicates"),
+        n_active);
+    Kokkos::parallel_for(
+        "ArborX::RayStream::form_predicates",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_active),
+        KOKKOS_LAMBDA(int j) {
+          predicates(j) = attach(ordered_intersects(rays(active(j))), j);
+        });
+
+    Kokkos::View<Hit *, MemorySpace> hits(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::RayStream::hits"),
+        n_active);
+    Kokkos::View<int *, MemorySpace> found(
+        Kokkos::view_alloc(space, "ArborX::RayStream::found"), n_active);
+
+    // The stream is already in traversal order; the query must not sort it
+    // back by centroid
+    tree.query(space, predicates,
+               Details::RayStreamClosestHit<decltype(hits), decltype(found)>{
+                   hits, found},
+               TraversalPolicy().setPredicateSorting(false));
+
+    Kokkos::View<int *, MemorySpace> survive(
+        Kokkos::view_alloc(space, "ArborX::RayStream::survive"), n_active);
+    Kokkos::parallel_for(
+        "ArborX::RayStream::shade",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_active),
+        KOKKOS_LAMBDA(int j) {
+          if (found(j))
+            survive(j) = shader(active(j), hits(j), rays(active(j))) ? 1 : 0;
+        });
+
+    Kokkos::View<int *, MemorySpace> next_active(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::RayStream::active"),
+        n_active);
+    int n_survived;
+    Kokkos::parallel_scan(
+        "ArborX::RayStream::compact",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_active),
+        KOKKOS_LAMBDA(int j, int &update, bool last_pass) {
+          if (survive(j))
+          {
+            if (last_pass)
+              next_active(update) = active(j);
+            ++update;
+          }
+        },
+        n_survived);
+    active = next_active;
+    n_active = n_survived;
+  }
+}
+
+} // namespace Experimental
+
+} // namespace ArborX
+
+#endif
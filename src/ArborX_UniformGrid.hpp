@@ -0,0 +1,251 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_UNIFORM_GRID_HPP
+#define ARBORX_UNIFORM_GRID_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_Box.hpp>
+#include <ArborX_Callbacks.hpp>
+#include <ArborX_CrsGraphWrapper.hpp>
+#include <ArborX_DetailsCartesianGrid.hpp>
+#include <ArborX_DetailsCrsGraphWrapperImpl.hpp>
+#include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+#include <ArborX_DetailsSortUtils.hpp>
+#include <ArborX_HyperBox.hpp>
+#include <ArborX_Point.hpp>
+#include <ArborX_Predicates.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+namespace ArborX
+{
+
+// Uniform-grid index over 3D points: points are binned into the cells of a
+// CartesianGrid and sorted by cell, a query walks the cells overlapping the
+// predicate geometry and tests their points. There is no hierarchy to
+// descend, which beats the BVH when the data is uniformly dense and the
+// query radius is on the order of the cell size -- pick the cell size
+// accordingly (the query radius is usually the right choice). Degenerate
+// for strongly non-uniform data: a single crowded cell serializes its
+// queries.
+//
+// The query interface matches the tree indices for spatial predicates,
+// including CSR output, so call sites can switch structures unchanged:
+// callbacks are invoked as callback(predicate, int index) with the index of
+// the matching point.
+template <typename MemorySpace>
+class UniformGrid
+{
+public:
+  using memory_space = MemorySpace;
+  static_assert(Kokkos::is_memory_space<MemorySpace>::value);
+  using size_type = typename MemorySpace::size_type;
+  using bounding_volume_type = ExperimentalHyperGeometry::Box<3, float>;
+  using value_type = int;
+
+  UniformGrid() = default;
+
+  template <typename ExecutionSpace, typename Primitives>
+  UniformGrid(ExecutionSpace const &space, Primitives const &user_primitives,
+              float cell_size)
+  {
+    static_assert(Details::KokkosExt::is_accessible_from<
+                  MemorySpace, ExecutionSpace>::value);
+    Details::check_valid_access_traits(PrimitivesTag{}, user_primitives);
+
+    using AccessValues =
+        Details::AccessValues<Primitives, PrimitivesTag>;
+    AccessValues primitives{user_primitives};
+
+    using Primitive = typename AccessValues::value_type;
+    static_assert(GeometryTraits::is_point<Primitive>{},
+                  "UniformGrid only supports point primitives");
+    static_assert(GeometryTraits::dimension_v<Primitive> == 3);
+
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::UniformGrid::UniformGrid");
+
+    int const n = primitives.size();
+    _points = Kokkos::View<Point *, MemorySpace>(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::UniformGrid::points"),
+        n);
+
+    if (n == 0)
+      return;
+
+    auto points = _points;
+    bounding_volume_type bounds{};
+    Kokkos::parallel_reduce(
+        "ArborX::UniformGrid::copy_points_and_reduce_bounds",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i, bounding_volume_type &update) {
+          auto const &point = primitives(i);
+          points(i) = {(float)point[0], (float)point[1], (float)point[2]};
+          using Details::expand;
+          bounding_volume_type bounding_volume{};
+          expand(bounding_volume, points(i));
+          update += bounding_volume;
+        },
+        Kokkos::Sum<bounding_volume_type>{bounds});
+    _bounds = bounds;
+
+    _grid = Details::CartesianGrid<3>(bounds, cell_size);
+
+    _cell_indices = Kokkos::View<size_t *, MemorySpace>(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::UniformGrid::cell_indices"),
+        n);
+    auto cell_indices = _cell_indices;
+    auto const grid = _grid;
+    Kokkos::parallel_for(
+        "ArborX::UniformGrid::compute_cell_indices",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i) { cell_indices(i) = grid.cellIndex(points(i)); });
+
+    // Sorts the cell indices and yields the slot-to-point map
+    _permute = Details::sortObjects(space, _cell_indices);
+  }
+
+  KOKKOS_FUNCTION
+  size_type size() const noexcept { return _points.size(); }
+
+  KOKKOS_FUNCTION
+  bool empty() const noexcept { return size() == 0; }
+
+  KOKKOS_FUNCTION
+  bounding_volume_type bounds() const noexcept { return _bounds; }
+
+  template <typename ExecutionSpace, typename UserPredicates,
+            typename Callback, typename Ignore = int>
+  void query(ExecutionSpace const &space, UserPredicates const &user_predicates,
+             Callback const &callback, Ignore = Ignore()) const
+  {
+    static_assert(Details::KokkosExt::is_accessible_from<
+                  MemorySpace, ExecutionSpace>::value);
+    Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+    Details::check_valid_callback<value_type>(callback, user_predicates);
+
+    using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+    Predicates predicates{user_predicates};
+
+    static_assert(
+        std::is_same_v<typename Predicates::value_type::Tag,
+                       Details::SpatialPredicateTag>,
+        "UniformGrid only supports spatial predicates");
+
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::UniformGrid::query::spatial");
+
+    int const n = _points.extent_int(0);
+    auto const points = _points;
+    auto const cell_indices = _cell_indices;
+    auto const permute = _permute;
+    auto const grid = _grid;
+    Kokkos::parallel_for(
+        "ArborX::UniformGrid::query",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
+        KOKKOS_LAMBDA(int q) {
+          auto const &predicate = predicates(q);
+
+          using Details::expand;
+          bounding_volume_type query_box{};
+          expand(query_box, getGeometry(predicate));
+
+          // Cell range overlapping the predicate geometry, clamped to the
+          // grid
+          int lo[3];
+          int hi[3];
+          for (int d = 0; d < 3; ++d)
+          {
+            auto const min = grid.minCorner(d);
+            auto const h = grid.cellSize(d);
+            int const n_d = (int)grid.extent(d);
+            lo[d] = Kokkos::clamp(
+                (int)Kokkos::floor((query_box.minCorner()[d] - min) / h), 0,
+                n_d - 1);
+            hi[d] = Kokkos::clamp(
+                (int)Kokkos::floor((query_box.maxCorner()[d] - min) / h), 0,
+                n_d - 1);
+          }
+
+          for (int i2 = lo[2]; i2 <= hi[2]; ++i2)
+            for (int i1 = lo[1]; i1 <= hi[1]; ++i1)
+              for (int i0 = lo[0]; i0 <= hi[0]; ++i0)
+              {
+                // Same linearization as CartesianGrid::cellIndex
+                size_t const cell =
+                    ((size_t)i2 * grid.extent(1) + i1) * grid.extent(0) + i0;
+
+                // Points of a cell are contiguous in the sorted ordering;
+                // locate the range by binary search
+                int first = 0;
+                int count = n;
+                while (count > 0)
+                {
+                  int const step = count / 2;
+                  int const it = first + step;
+                  if (cell_indices(it) < cell)
+                  {
+                    first = it + 1;
+                    count -= step + 1;
+                  }
+                  else
+                    count = step;
+                }
+
+                for (int slot = first;
+                     slot < n && cell_indices(slot) == cell; ++slot)
+                {
+                  int const index = (int)permute(slot);
+                  if (predicate(points(index)) &&
+                      Details::invoke_callback_and_check_early_exit(
+                          callback, predicate, index))
+                    return;
+                }
+              }
+        });
+  }
+
+  template <typename ExecutionSpace, typename UserPredicates,
+            typename CallbackOrView, typename View, typename... Args>
+  std::enable_if_t<Kokkos::is_view_v<std::decay_t<View>>>
+  query(ExecutionSpace const &space, UserPredicates const &user_predicates,
+        CallbackOrView &&callback_or_view, View &&view, Args &&...args) const
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::UniformGrid::query_crs");
+
+    Details::CrsGraphWrapperImpl::
+        check_valid_callback_if_first_argument_is_not_a_view<value_type>(
+            callback_or_view, user_predicates, view);
+
+    using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+    using Tag = typename Predicates::value_type::Tag;
+
+    Details::CrsGraphWrapperImpl::queryDispatch(
+        Tag{}, *this, space, Predicates{user_predicates},
+        std::forward<CallbackOrView>(callback_or_view),
+        std::forward<View>(view), std::forward<Args>(args)...);
+  }
+
+private:
+  Kokkos::View<Point *, MemorySpace> _points;
+  Kokkos::View<size_t *, MemorySpace> _cell_indices;
+  Kokkos::View<unsigned int *, MemorySpace> _permute;
+  Details::CartesianGrid<3> _grid;
+  bounding_volume_type _bounds;
+};
+
+} // namespace ArborX
+
+#endif
@@ -14,6 +14,7 @@
 
 #include <ArborX_GeometryTraits.hpp>
 #include <ArborX_HyperPoint.hpp>
+#include <ArborX_HyperTriangle.hpp>
 #include <ArborX_Point.hpp>
 #include <ArborX_Predicates.hpp>
 
@@ -227,6 +228,73 @@ struct AccessTraits<Details::AccessValues<Values, Tag>, Tag>
   static decltype(auto) size(AccessValues const &w) { return w.size(); }
 };
 
+namespace Experimental
+{
+
+// Indexed representation of a triangle mesh: a view of vertices and a view
+// of vertex indices, three per face (flattened if the index view is rank-1).
+// Triangles are assembled on the fly when a face is accessed, so passing a
+// mesh to ArborX does not require materializing one triangle, i.e., three
+// vertex copies, per face.
+template <typename Vertices, typename Indices>
+struct IndexedTriangleMesh
+{
+  static_assert(Kokkos::is_view<Vertices>{} && Vertices::rank == 1);
+  static_assert(Kokkos::is_view<Indices>{} &&
+                (Indices::rank == 1 || Indices::rank == 2));
+  static_assert(
+      GeometryTraits::is_point<typename Vertices::non_const_value_type>{});
+  static_assert(std::is_integral_v<typename Indices::non_const_value_type>);
+
+  Vertices _vertices;
+  Indices _indices;
+
+  KOKKOS_FUNCTION auto numFaces() const
+  {
+    if constexpr (Indices::rank == 1)
+      return _indices.extent(0) / 3;
+    else
+      return _indices.extent(0);
+  }
+
+  KOKKOS_FUNCTION decltype(auto) vertex(int face, int k) const
+  {
+    if constexpr (Indices::rank == 1)
+      return _vertices(_indices(3 * face + k));
+    else
+      return _vertices(_indices(face, k));
+  }
+
+  KOKKOS_FUNCTION auto triangle(int face) const
+  {
+    using Point = typename Vertices::non_const_value_type;
+    constexpr int DIM = GeometryTraits::dimension_v<Point>;
+    using Coordinate = typename GeometryTraits::coordinate_type<Point>::type;
+    return ExperimentalHyperGeometry::Triangle<DIM, Coordinate>{
+        vertex(face, 0), vertex(face, 1), vertex(face, 2)};
+  }
+};
+
+} // namespace Experimental
+
+template <typename Vertices, typename Indices>
+struct AccessTraits<Experimental::IndexedTriangleMesh<Vertices, Indices>,
+                    PrimitivesTag>
+{
+  using Mesh = Experimental::IndexedTriangleMesh<Vertices, Indices>;
+
+  using memory_space = typename Vertices::memory_space;
+
+  KOKKOS_FUNCTION
+  static auto size(Mesh const &mesh) { return mesh.numFaces(); }
+
+  // Returns by value
+  KOKKOS_FUNCTION static auto get(Mesh const &mesh, int i)
+  {
+    return mesh.triangle(i);
+  }
+};
+
 namespace Traits
 {
 using PredicatesTag [[deprecated("Use ArborX::PredicatesTag instead.")]] =
@@ -0,0 +1,84 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_ATTACH_HANDLES_HPP
+#define ARBORX_ATTACH_HANDLES_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_Predicates.hpp>
+
+#include <Kokkos_Macros.hpp>
+
+namespace ArborX
+{
+
+namespace Experimental
+{
+// Lazily attach to each predicate its position in the batch as a 32-bit
+// handle, instead of embedding the payload itself with attach(). Attached
+// data travels inside the predicate object, so a large payload is loaded on
+// every node visit of the traversal even though callbacks only consume it on
+// a match. Keeping the payload in a separate view and attaching only its
+// index removes that dead weight from the hot loop; a callback recovers the
+// payload with payloads(getData(predicate)).
+template <typename Predicates, typename Handle>
+class AttachHandles
+{
+private:
+  using Data = Details::AccessValues<Predicates, PredicatesTag>;
+
+  static_assert(std::is_integral_v<Handle> && sizeof(Handle) == 4);
+
+public:
+  Data _data;
+
+  using memory_space = typename Data::memory_space;
+
+  AttachHandles(Predicates const &predicates)
+      : _data{predicates}
+  {}
+
+  KOKKOS_FUNCTION
+  auto operator()(int i) const { return attach(_data(i), Handle(i)); }
+
+  KOKKOS_FUNCTION
+  auto size() const { return _data.size(); }
+};
+
+template <typename Predicates, typename Handle = unsigned>
+auto attach_handles(Predicates const &predicates)
+{
+  return AttachHandles<Predicates, Handle>{predicates};
+}
+} // namespace Experimental
+
+} // namespace ArborX
+
+template <typename Predicates, typename Handle>
+struct ArborX::AccessTraits<
+    ArborX::Experimental::AttachHandles<Predicates, Handle>,
+    ArborX::PredicatesTag>
+{
+  using Self = ArborX::Experimental::AttachHandles<Predicates, Handle>;
+
+  using memory_space = typename Self::memory_space;
+
+  KOKKOS_FUNCTION static auto size(Self const &predicates)
+  {
+    return predicates.size();
+  }
+  KOKKOS_FUNCTION static decltype(auto) get(Self const &predicates, int i)
+  {
+    return predicates(i);
+  }
+};
+
+#endif
@@ -0,0 +1,63 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_BUILD_WORKSPACE_HPP
+#define ARBORX_BUILD_WORKSPACE_HPP
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Scratch allocations for tree construction, reusable across rebuilds. When
+// a workspace is passed to the BoundingVolumeHierarchy constructor, the
+// temporary buffers (space-filling curve codes, hierarchy generation ranges)
+// are carved out of the workspace instead of being allocated and freed per
+// build, which matters for high-frequency small-tree rebuild loops where
+// device malloc/free dominates.
+//
+// Buffers grow but never shrink, and the views handed out alias workspace
+// memory: the workspace must outlive the construction (but not the tree),
+// and a workspace must not be used by two concurrent builds.
+template <class MemorySpace>
+class BuildWorkspace
+{
+public:
+  enum Slot
+  {
+    LinearOrdering = 0,
+    HierarchyRanges,
+    Centroids,
+    NumSlots
+  };
+
+  template <typename T>
+  Kokkos::View<T *, MemorySpace> scratch(Slot slot, size_t n)
+  {
+    auto &buffer = _buffers[slot];
+    size_t const bytes = n * sizeof(T);
+    if (buffer.extent(0) < bytes)
+      Kokkos::realloc(Kokkos::WithoutInitializing, buffer, bytes);
+    return {reinterpret_cast<T *>(buffer.data()), n};
+  }
+
+private:
+  Kokkos::View<char *, MemorySpace> _buffers[NumSlots] = {
+      Kokkos::View<char *, MemorySpace>(
+          "ArborX::BuildWorkspace::linear_ordering", 0),
+      Kokkos::View<char *, MemorySpace>("ArborX::BuildWorkspace::ranges", 0),
+      Kokkos::View<char *, MemorySpace>("ArborX::BuildWorkspace::centroids",
+                                        0)};
+};
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -37,6 +37,14 @@ struct [[deprecated]] InlineCallbackTag
 struct PostCallbackTag
 {};
 
+// Tag for post callbacks that reduce the matches of each predicate to
+// exactly one output value (the callback must resize the output view to one
+// entry per predicate). In distributed spatial queries the reduction is
+// executed on the ranks owning the data, so only the reduced values are
+// exchanged; each predicate then gets back one result per rank it contacted.
+struct ReductionPostCallbackTag
+{};
+
 struct DefaultCallback
 {
   template <typename Predicate, typename Value, typename OutputFunctor>
@@ -57,6 +65,12 @@ struct is_tagged_post_callback
                                 Callback>::type
 {};
 
+template <typename Callback>
+struct is_tagged_reduction_post_callback
+    : Kokkos::is_detected_exact<ReductionPostCallbackTag,
+                                CallbackTagArchetypeAlias, Callback>::type
+{};
+
 // output functor to pass to the callback during detection
 template <typename T>
 struct Sink
@@ -148,9 +162,7 @@ void check_valid_callback(Callback const &callback, Predicates const &)
                 "Callback 'operator()' does not have the correct signature");
 
   static_assert(
-      !(std::is_same_v<PredicateTag, SpatialPredicateTag> ||
-        std::is_same_v<PredicateTag,
-                       Experimental::OrderedSpatialPredicateTag>) ||
+      !std::is_same_v<PredicateTag, SpatialPredicateTag> ||
           (std::is_same_v<
                CallbackTreeTraversalControl,
                std::invoke_result_t<Callback const &, Predicate, Value>> ||
@@ -159,6 +171,23 @@ void check_valid_callback(Callback const &callback, Predicates const &)
       "Callback 'operator()' return type must be void or "
       "ArborX::CallbackTreeTraversalControl");
 
+  // Ordered spatial callbacks may additionally return an updated culling
+  // distance (closest-hit queries): nodes farther than the smallest value
+  // returned so far are pruned from the traversal
+  static_assert(
+      !std::is_same_v<PredicateTag,
+                      Experimental::OrderedSpatialPredicateTag> ||
+          (std::is_same_v<
+               CallbackTreeTraversalControl,
+               std::invoke_result_t<Callback const &, Predicate, Value>> ||
+           std::is_void_v<
+               std::invoke_result_t<Callback const &, Predicate, Value>> ||
+           std::is_arithmetic_v<
+               std::invoke_result_t<Callback const &, Predicate, Value>>),
+      "Callback 'operator()' return type must be void, "
+      "ArborX::CallbackTreeTraversalControl, or an arithmetic culling "
+      "distance");
+
   static_assert(
       !std::is_same_v<PredicateTag, NearestPredicateTag> ||
           std::is_void_v<
@@ -0,0 +1,100 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_COLLISION_LIST_HPP
+#define ARBORX_COLLISION_LIST_HPP
+
+#include <ArborX_DetailsHalfTraversal.hpp>
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_Predicates.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Fattens each stored box by the collision margin before the overlap test:
+// pairs whose boxes come within the margin of touching are reported as
+// well, which is what contact solvers need to warm-start resting contacts.
+struct CollisionListPredicateGetter
+{
+  float _margin = 0;
+
+  template <typename Box>
+  KOKKOS_FUNCTION auto operator()(Box box) const
+  {
+    constexpr int DIM = GeometryTraits::dimension_v<Box>;
+    for (int d = 0; d < DIM; ++d)
+    {
+      box.minCorner()[d] -= _margin;
+      box.maxCorner()[d] += _margin;
+    }
+    return intersects(box);
+  }
+};
+
+// Broad-phase collision detection over the boxes stored in a tree: invokes
+// callback(i, j) exactly once for every unordered pair {i, j}, i != j,
+// whose (fattened) boxes overlap, with i and j the positions of the boxes
+// at tree construction. Built on the half traversal, where each leaf only
+// tests the part of the tree following it: half the work of querying a
+// tree with its own boxes, and no self pair or (j, i) duplicate to filter.
+template <class ExecutionSpace, class Tree, class Callback>
+void forEachOverlappingPair(ExecutionSpace const &space, Tree const &tree,
+                            Callback const &callback, float margin = 0)
+{
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::Experimental::ForEachOverlappingPair");
+
+  Details::HalfTraversal(space, tree, callback,
+                         CollisionListPredicateGetter{margin});
+}
+
+// Broad-phase pair list: every overlapping (fattened) pair exactly once,
+// in unspecified order
+template <class ExecutionSpace, class Tree>
+Kokkos::View<Kokkos::pair<int, int> *, typename Tree::memory_space>
+findOverlappingPairs(ExecutionSpace const &space, Tree const &tree,
+                     float margin = 0)
+{
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::Experimental::FindOverlappingPairs");
+
+  using MemorySpace = typename Tree::memory_space;
+
+  Kokkos::View<int, MemorySpace> count(
+      Kokkos::view_alloc(space, "ArborX::Experimental::CollisionList::count"));
+  forEachOverlappingPair(
+      space, tree,
+      KOKKOS_LAMBDA(int, int) { Kokkos::atomic_increment(&count()); }, margin);
+
+  int n_pairs;
+  Kokkos::deep_copy(space, n_pairs, count);
+  space.fence("ArborX::Experimental::CollisionList (pair count on host)");
+
+  Kokkos::View<Kokkos::pair<int, int> *, MemorySpace> pairs(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::Experimental::CollisionList::pairs"),
+      n_pairs);
+  Kokkos::deep_copy(space, count, 0);
+  forEachOverlappingPair(
+      space, tree,
+      KOKKOS_LAMBDA(int i, int j) {
+        pairs(Kokkos::atomic_fetch_inc(&count())) = {i, j};
+      },
+      margin);
+
+  return pairs;
+}
+
+} // namespace ArborX::Experimental
+
+#endif
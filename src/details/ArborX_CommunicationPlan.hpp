@@ -0,0 +1,83 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_COMMUNICATION_PLAN_HPP
+#define ARBORX_COMMUNICATION_PLAN_HPP
+
+#include <ArborX_DetailsDistributor.hpp>
+
+#include <optional>
+
+#include <mpi.h>
+
+namespace ArborX::Experimental
+{
+
+// Reusable communication plan for repeated distributed queries. When a plan
+// is passed to DistributedTree::query() after the offset view, the query
+// forwarding distributor is built once — including, at scale, the graph
+// communicator backing the neighborhood-collective exchange — and replayed
+// with refreshed payload sizes on subsequent calls, instead of redoing the
+// full sort and dense count exchange of the plan construction every time.
+//
+// Replaying requires the communication topology to be stable: every rank a
+// query is forwarded to must already have been a neighbor when the plan was
+// built (ranks may drop out; they get zero-size messages). When predicates
+// move across that boundary, e.g. after a rebalance, call invalidate() to
+// force a rebuild on the next query. A plan is tied to the tree's
+// communicator and must not be shared between trees.
+template <class MemorySpace>
+class CommunicationPlan
+{
+public:
+  void invalidate() { _forward.reset(); }
+
+  // Use one-sided puts instead of two-sided messages for the forwarding
+  // exchanges (see Distributor::enableOneSidedCommunication()). Takes effect
+  // when the plan is (re)built.
+  void setOneSidedCommunication(bool one_sided)
+  {
+    _one_sided = one_sided;
+    invalidate();
+  }
+
+  // Build the distributor on the first call, replay it afterwards. Returns
+  // the number of imports. Collective.
+  template <typename ExecutionSpace, typename View>
+  size_t createOrUpdateFromSends(MPI_Comm comm, ExecutionSpace const &space,
+                                 View const &destination_ranks)
+  {
+    if (_forward)
+      return _forward->updateFromSends(space, destination_ranks);
+
+    _forward.emplace(comm);
+    auto const n_imports =
+        _forward->createFromSends(space, destination_ranks);
+    if (_one_sided)
+      _forward->enableOneSidedCommunication();
+    else
+      _forward->createGraphCommunicator();
+    return n_imports;
+  }
+
+  Details::Distributor<MemorySpace> const &forwardDistributor() const
+  {
+    return *_forward;
+  }
+
+private:
+  std::optional<Details::Distributor<MemorySpace>> _forward;
+  bool _one_sided = false;
+};
+
+} // namespace ArborX::Experimental
+
+#endif
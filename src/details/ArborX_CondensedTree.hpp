@@ -0,0 +1,342 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_CONDENSED_TREE_HPP
+#define ARBORX_CONDENSED_TREE_HPP
+
+#include <ArborX_Dendrogram.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_Exception.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <algorithm> // sort
+#include <numeric>   // iota
+#include <vector>
+
+namespace ArborX::Experimental
+{
+
+// Excess-of-mass cluster extraction from a dendrogram.
+//
+// The dendrogram is condensed on the fly: walking towards the root, a point
+// stays "unclustered" until its subtree first reaches min_cluster_size, and
+// an edge starts a new condensed cluster when it is a large-enough child of
+// a node at which at least two children could stand alone. Every condensed
+// cluster accumulates a stability score, the sum over its points of the
+// difference between the lambda (inverse distance) at which the point left
+// the cluster and the lambda at which the cluster was born. Clusters are
+// then selected so that no selected cluster is an ancestor of another one
+// and the total selected stability is maximal, and every point is labeled
+// by the selected cluster it passed through (-1 if there is none, i.e.,
+// noise). The root is never selected.
+//
+// The per-point work runs on the device; only the selection itself, ranging
+// over condensed clusters rather than points, runs on the host, mirroring
+// what dendrogramUnionFind() does for the dendrogram construction.
+//
+// Returns the labels; `stabilities` is resized to the number of selected
+// clusters and holds the score of each label.
+template <typename ExecutionSpace, typename MemorySpace>
+Kokkos::View<int *, MemorySpace>
+extractClustersEOM(ExecutionSpace const &exec_space,
+                   Dendrogram<MemorySpace> const &dendrogram,
+                   int min_cluster_size,
+                   Kokkos::View<float *, MemorySpace> &stabilities)
+{
+  Kokkos::Profiling::ScopedRegion guard("ArborX::EOM");
+
+  namespace KokkosExt = Details::KokkosExt;
+
+  auto const parents = dendrogram._parents;
+  auto const heights = dendrogram._parent_heights;
+
+  int const num_edges = heights.extent_int(0);
+  int const n = num_edges + 1;
+  int const vertices_offset = num_edges;
+  ARBORX_ASSERT(parents.extent_int(0) == num_edges + n);
+  ARBORX_ASSERT(min_cluster_size >= 2);
+
+  Kokkos::View<int *, MemorySpace> labels(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::EOM::labels"),
+      n);
+
+  if (min_cluster_size > n)
+  {
+    // No subtree is large enough to form a cluster
+    Kokkos::deep_copy(exec_space, labels, -1);
+    KokkosExt::reallocWithoutInitializing(exec_space, stabilities, 0);
+    return labels;
+  }
+
+  // Number of points below every dendrogram edge
+  Kokkos::Profiling::pushRegion("ArborX::EOM::subtree_sizes");
+  Kokkos::View<int *, MemorySpace> sizes(
+      Kokkos::view_alloc(exec_space, "ArborX::EOM::sizes"), num_edges);
+  Kokkos::parallel_for(
+      "ArborX::EOM::compute_subtree_sizes",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int v) {
+        int node = parents(vertices_offset + v);
+        while (node != -1)
+        {
+          Kokkos::atomic_increment(&sizes(node));
+          node = parents(node);
+        }
+      });
+  Kokkos::Profiling::popRegion();
+
+  // An edge is a split when at least two of its children could stand alone
+  // as clusters; a large-enough child of a split starts a new condensed
+  // cluster, and so does the root
+  Kokkos::Profiling::pushRegion("ArborX::EOM::condensed_clusters");
+  Kokkos::View<int *, MemorySpace> num_big_children(
+      Kokkos::view_alloc(exec_space, "ArborX::EOM::num_big_children"),
+      num_edges);
+  Kokkos::parallel_for(
+      "ArborX::EOM::count_big_children",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_edges),
+      KOKKOS_LAMBDA(int e) {
+        if (sizes(e) >= min_cluster_size && parents(e) != -1)
+          Kokkos::atomic_increment(&num_big_children(parents(e)));
+      });
+
+  Kokkos::View<int *, MemorySpace> is_cluster(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::EOM::is_cluster"),
+      num_edges);
+  Kokkos::parallel_for(
+      "ArborX::EOM::flag_clusters",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_edges),
+      KOKKOS_LAMBDA(int e) {
+        is_cluster(e) =
+            (sizes(e) >= min_cluster_size &&
+             (parents(e) == -1 || num_big_children(parents(e)) >= 2));
+      });
+
+  Kokkos::View<int *, MemorySpace> cluster_ids(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::EOM::cluster_ids"),
+      num_edges);
+  KokkosExt::exclusive_scan(exec_space, is_cluster, cluster_ids, 0);
+  int num_clusters;
+  {
+    Kokkos::View<int, MemorySpace> num_clusters_view(
+        Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                           "ArborX::EOM::num_clusters"));
+    Kokkos::parallel_for(
+        "ArborX::EOM::fetch_num_clusters",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, 1),
+        KOKKOS_LAMBDA(int) {
+          num_clusters_view() =
+              cluster_ids(num_edges - 1) + is_cluster(num_edges - 1);
+        });
+    Kokkos::deep_copy(exec_space, num_clusters, num_clusters_view);
+    exec_space.fence("ArborX::EOM (cluster count copied to host)");
+  }
+  Kokkos::Profiling::popRegion();
+
+  // Per-cluster quantities. A cluster is born at the height of the edge
+  // above it; points that continue into a child cluster leave at the
+  // child's birth, all other points leave at the first edge above them that
+  // is large enough on its own.
+  Kokkos::Profiling::pushRegion("ArborX::EOM::stability");
+  Kokkos::View<int *, MemorySpace> cluster_parents(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::EOM::cluster_parents"),
+      num_clusters);
+  Kokkos::View<int *, MemorySpace> cluster_sizes(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::EOM::cluster_sizes"),
+      num_clusters);
+  Kokkos::View<float *, MemorySpace> cluster_births(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::EOM::cluster_births"),
+      num_clusters);
+  Kokkos::View<float *, MemorySpace> cluster_stabilities(
+      Kokkos::view_alloc(exec_space, "ArborX::EOM::cluster_stabilities"),
+      num_clusters);
+
+  Kokkos::parallel_for(
+      "ArborX::EOM::compute_cluster_parents",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_edges),
+      KOKKOS_LAMBDA(int e) {
+        if (!is_cluster(e))
+          return;
+
+        int const id = cluster_ids(e);
+        cluster_sizes(id) = sizes(e);
+        int const p = parents(e);
+        if (p == -1)
+        {
+          cluster_parents(id) = -1;
+          cluster_births(id) = 0.f;
+          return;
+        }
+        float const birth = 1.f / heights(p);
+        cluster_births(id) = birth;
+
+        int c = p;
+        while (!is_cluster(c))
+          c = parents(c);
+        cluster_parents(id) = cluster_ids(c);
+
+        // Points entering this cluster leave the parent cluster here
+        Kokkos::atomic_add(&cluster_stabilities(cluster_ids(c)),
+                           sizes(e) * birth);
+      });
+
+  // For every point, find the cluster it leaves and the lambda at which it
+  // does; remember the cluster for the final labeling
+  Kokkos::View<int *, MemorySpace> point_clusters(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::EOM::point_clusters"),
+      n);
+  Kokkos::parallel_for(
+      "ArborX::EOM::compute_point_departures",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int v) {
+        int e = parents(vertices_offset + v);
+        while (sizes(e) < min_cluster_size)
+          e = parents(e);
+        float const lambda = 1.f / heights(e);
+
+        while (!is_cluster(e))
+          e = parents(e);
+        int const id = cluster_ids(e);
+
+        point_clusters(v) = id;
+        Kokkos::atomic_add(&cluster_stabilities(id), lambda);
+      });
+
+  Kokkos::parallel_for(
+      "ArborX::EOM::finalize_stabilities",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_clusters),
+      KOKKOS_LAMBDA(int id) {
+        cluster_stabilities(id) -= cluster_sizes(id) * cluster_births(id);
+      });
+  Kokkos::Profiling::popRegion();
+
+  // Excess-of-mass selection over the condensed clusters. The number of
+  // clusters is small compared to the number of points, so this part runs
+  // on the host.
+  Kokkos::Profiling::pushRegion("ArborX::EOM::selection");
+  auto cluster_parents_host = Kokkos::create_mirror_view_and_copy(
+      Kokkos::HostSpace{}, cluster_parents);
+  auto cluster_stabilities_host = Kokkos::create_mirror_view_and_copy(
+      Kokkos::HostSpace{}, cluster_stabilities);
+  exec_space.fence(
+      "ArborX::EOM (cluster data copied to host before selection)");
+
+  // Cluster ids follow the dendrogram edge order, which does not have to
+  // put children before parents (the Boruvka dendrogram does not), so order
+  // the clusters by their depth in the cluster tree instead
+  std::vector<int> depths(num_clusters);
+  std::vector<int> order(num_clusters);
+  std::iota(order.begin(), order.end(), 0);
+  for (int id = 0; id < num_clusters; ++id)
+  {
+    int depth = 0;
+    for (int c = cluster_parents_host(id); c != -1;
+         c = cluster_parents_host(c))
+      ++depth;
+    depths[id] = depth;
+  }
+  std::sort(order.begin(), order.end(),
+            [&depths](int i, int j) { return depths[i] > depths[j]; });
+
+  // Deepest first: every cluster is processed after all of its children. A
+  // cluster is selected when its own stability is at least that of the best
+  // selection in its subtree; the root covers everything and is never
+  // selected.
+  std::vector<float> subtree_stabilities(num_clusters, 0.f);
+  std::vector<char> selected(num_clusters, 0);
+  for (int id : order)
+  {
+    auto const parent = cluster_parents_host(id);
+    if (parent == -1)
+      continue;
+    auto &subtree = subtree_stabilities[id];
+    if (subtree <= cluster_stabilities_host(id))
+    {
+      subtree = cluster_stabilities_host(id);
+      selected[id] = 1;
+    }
+    subtree_stabilities[parent] += subtree;
+  }
+
+  // Shallowest first: suppress selected descendants of selected clusters
+  // and assign consecutive labels
+  int num_selected = 0;
+  std::vector<int> final_labels(num_clusters, -1);
+  std::vector<float> selected_stabilities;
+  for (auto it = order.rbegin(); it != order.rend(); ++it)
+  {
+    int const id = *it;
+    auto const parent = cluster_parents_host(id);
+    if (parent != -1 && final_labels[parent] != -1)
+    {
+      selected[id] = 0;
+      final_labels[id] = final_labels[parent];
+      continue;
+    }
+    if (selected[id])
+    {
+      final_labels[id] = num_selected++;
+      selected_stabilities.push_back(cluster_stabilities_host(id));
+    }
+  }
+  Kokkos::Profiling::popRegion();
+
+  // Send the per-cluster labels back and expand them to the points
+  Kokkos::View<int *, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>
+      final_labels_host(final_labels.data(), num_clusters);
+  Kokkos::View<int *, MemorySpace> final_labels_device(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::EOM::final_labels"),
+      num_clusters);
+  Kokkos::deep_copy(exec_space, final_labels_device, final_labels_host);
+
+  Kokkos::parallel_for(
+      "ArborX::EOM::assign_labels",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int v) {
+        labels(v) = final_labels_device(point_clusters(v));
+      });
+
+  KokkosExt::reallocWithoutInitializing(exec_space, stabilities, num_selected);
+  if (num_selected > 0)
+  {
+    Kokkos::View<float *, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>
+        selected_stabilities_host(selected_stabilities.data(), num_selected);
+    Kokkos::deep_copy(exec_space, stabilities, selected_stabilities_host);
+  }
+
+  return labels;
+}
+
+template <typename ExecutionSpace, typename MemorySpace>
+Kokkos::View<int *, MemorySpace>
+extractClustersEOM(ExecutionSpace const &exec_space,
+                   Dendrogram<MemorySpace> const &dendrogram,
+                   int min_cluster_size)
+{
+  Kokkos::View<float *, MemorySpace> stabilities("ArborX::EOM::stabilities",
+                                                 0);
+  return extractClustersEOM(exec_space, dendrogram, min_cluster_size,
+                            stabilities);
+}
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -15,6 +15,7 @@
 #include <ArborX_DetailsKokkosExtSort.hpp>
 #include <ArborX_DetailsKokkosExtViewHelpers.hpp>
 #include <ArborX_DetailsWeightedEdge.hpp>
+#include <ArborX_Exception.hpp>
 
 #include <Kokkos_Core.hpp>
 
@@ -24,7 +25,8 @@ namespace ArborX::Experimental
 enum class DendrogramImplementation
 {
   BORUVKA,
-  UNION_FIND
+  UNION_FIND,
+  ALPHA
 };
 
 template <typename MemorySpace>
@@ -44,10 +46,15 @@ struct Dendrogram
 
   template <typename ExecutionSpace>
   Dendrogram(ExecutionSpace const &exec_space,
-             Kokkos::View<Details::WeightedEdge *, MemorySpace> edges)
+             Kokkos::View<Details::WeightedEdge *, MemorySpace> edges,
+             DendrogramImplementation impl = DendrogramImplementation::ALPHA)
       : _parents("ArborX::Dendrogram::parents", 0)
       , _parent_heights("ArborX::Dendrogram::parent_heights", 0)
   {
+    // The fused Boruvka dendrogram is computed together with the MST and does
+    // not go through this constructor
+    ARBORX_ASSERT(impl != DendrogramImplementation::BORUVKA);
+
     Kokkos::Profiling::pushRegion("ArborX::Dendrogram::Dendrogram");
 
     namespace KokkosExt = ArborX::Details::KokkosExt;
@@ -60,20 +67,47 @@ struct Dendrogram
     KokkosExt::reallocWithoutInitializing(exec_space, _parent_heights,
                                           num_edges);
 
-    Kokkos::View<Details::UnweightedEdge *, MemorySpace> unweighted_edges(
-        Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
-                           "ArborX::Dendrogram::unweighted_edges"),
-        num_edges);
-    splitEdges(exec_space, edges, unweighted_edges, _parent_heights);
-
-    Kokkos::Profiling::pushRegion("ArborX::Dendrogram::sort_edges");
-    KokkosExt::sortByKey(exec_space, _parent_heights, unweighted_edges);
-    Kokkos::Profiling::popRegion();
-
-    using ConstEdges =
-        Kokkos::View<Details::UnweightedEdge const *, MemorySpace>;
-    Details::dendrogramUnionFind(exec_space, ConstEdges(unweighted_edges),
-                                 _parents);
+    if (impl == DendrogramImplementation::ALPHA)
+    {
+      // Work on a copy to not reorder the caller's edges
+      Kokkos::View<Details::WeightedEdge *, MemorySpace> sorted_edges(
+          Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                             "ArborX::Dendrogram::sorted_edges"),
+          num_edges);
+      Kokkos::deep_copy(exec_space, sorted_edges, edges);
+
+      auto &weights = _parent_heights; // alias
+      Kokkos::parallel_for(
+          "ArborX::Dendrogram::copy_weights",
+          Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_edges),
+          KOKKOS_LAMBDA(int const e) { weights(e) = edges(e).weight; });
+
+      Kokkos::Profiling::pushRegion("ArborX::Dendrogram::sort_edges");
+      KokkosExt::sortByKey(exec_space, _parent_heights, sorted_edges);
+      Kokkos::Profiling::popRegion();
+
+      using ConstEdges =
+          Kokkos::View<Details::WeightedEdge const *, MemorySpace>;
+      Details::dendrogramAlphaTree(exec_space, ConstEdges(sorted_edges),
+                                   _parents);
+    }
+    else
+    {
+      Kokkos::View<Details::UnweightedEdge *, MemorySpace> unweighted_edges(
+          Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                             "ArborX::Dendrogram::unweighted_edges"),
+          num_edges);
+      splitEdges(exec_space, edges, unweighted_edges, _parent_heights);
+
+      Kokkos::Profiling::pushRegion("ArborX::Dendrogram::sort_edges");
+      KokkosExt::sortByKey(exec_space, _parent_heights, unweighted_edges);
+      Kokkos::Profiling::popRegion();
+
+      using ConstEdges =
+          Kokkos::View<Details::UnweightedEdge const *, MemorySpace>;
+      Details::dendrogramUnionFind(exec_space, ConstEdges(unweighted_edges),
+                                   _parents);
+    }
 
     Kokkos::Profiling::popRegion();
   }
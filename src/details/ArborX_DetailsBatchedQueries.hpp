@@ -14,13 +14,17 @@
 
 #include <ArborX_Box.hpp>
 #include <ArborX_DetailsAlgorithms.hpp> // returnCentroid, translateAndScale
-#include <ArborX_DetailsSortUtils.hpp>  // sortObjects
+#include <ArborX_DetailsKokkosExtSort.hpp>          // sortByKey
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp> // iota
+#include <ArborX_DetailsSortUtils.hpp>              // sortObjects
 #include <ArborX_HyperBox.hpp>
 #include <ArborX_SpaceFillingCurves.hpp>
 
 #include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
 
 #include <tuple>
+#include <utility>
 
 namespace ArborX::Details
 {
@@ -50,6 +54,9 @@ public:
                                        Box const &scene_bounding_box,
                                        Predicates const &predicates)
   {
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::BatchedQueries::sort_predicates");
+
     auto const n_queries = predicates.size();
 
     using Point =
@@ -71,6 +78,217 @@ public:
     return sortObjects(space, linear_ordering_indices);
   }
 
+  // Same as above, but with the projection and permutation buffers provided
+  // by the caller (see Experimental::QueryWorkspace), so that no allocation
+  // takes place
+  template <typename ExecutionSpace, typename Predicates, typename Box,
+            typename SpaceFillingCurve, typename LinearOrderingView,
+            typename PermuteView>
+  static void sortPredicatesAlongSpaceFillingCurve(
+      ExecutionSpace const &space, SpaceFillingCurve const &curve,
+      Box const &scene_bounding_box, Predicates const &predicates,
+      LinearOrderingView &linear_ordering_indices, PermuteView &permute)
+  {
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::BatchedQueries::sort_predicates");
+
+    auto const n_queries = predicates.size();
+    ARBORX_ASSERT(linear_ordering_indices.extent(0) == n_queries);
+    ARBORX_ASSERT(permute.extent(0) == n_queries);
+
+    Kokkos::parallel_for(
+        "ArborX::BatchedQueries::project_predicates_onto_space_filling_curve",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int i) {
+          linear_ordering_indices(i) = curve(
+              scene_bounding_box, returnCentroid(getGeometry(predicates(i))));
+        });
+
+    Kokkos::Profiling::pushRegion("ArborX::BatchedQueries::sort_predicates::"
+                                  "sort");
+    KokkosExt::iota(space, permute);
+    KokkosExt::sortByKey(space, linear_ordering_indices, permute);
+    Kokkos::Profiling::popRegion();
+  }
+
+  // Joint ordering of two predicate batches: both are projected onto the
+  // same curve and sorted as one sequence, so a heterogeneous query pays a
+  // single sort. Permutation values below first.size() refer to the first
+  // batch; larger ones, shifted by first.size(), to the second.
+  template <typename ExecutionSpace, typename FirstPredicates,
+            typename SecondPredicates, typename Box,
+            typename SpaceFillingCurve>
+  static Kokkos::View<unsigned int *, DeviceType>
+  sortMixedPredicatesAlongSpaceFillingCurve(ExecutionSpace const &space,
+                                            SpaceFillingCurve const &curve,
+                                            Box const &scene_bounding_box,
+                                            FirstPredicates const &first,
+                                            SecondPredicates const &second)
+  {
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::BatchedQueries::sort_mixed_predicates");
+
+    int const n_first = first.size();
+    int const n_total = n_first + (int)second.size();
+
+    using Point = std::decay_t<decltype(returnCentroid(getGeometry(first(0))))>;
+    using LinearOrderingValueType =
+        std::invoke_result_t<SpaceFillingCurve, Box, Point>;
+    Kokkos::View<LinearOrderingValueType *, DeviceType> linear_ordering_indices(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::BVH::query::linear_ordering"),
+        n_total);
+    Kokkos::parallel_for(
+        "ArborX::BatchedQueries::"
+        "project_mixed_predicates_onto_space_filling_curve",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_total),
+        KOKKOS_LAMBDA(int i) {
+          linear_ordering_indices(i) =
+              (i < n_first)
+                  ? curve(scene_bounding_box,
+                          returnCentroid(getGeometry(first(i))))
+                  : curve(scene_bounding_box,
+                          returnCentroid(getGeometry(second(i - n_first))));
+        });
+
+    return sortObjects(space, linear_ordering_indices);
+  }
+
+  // Longest-processing-time ordering: predicates are sorted by decreasing
+  // estimated traversal cost so that the heavy ones are scheduled first and
+  // overlap with the bulk of the light work, instead of clumping into the
+  // tail blocks of the kernel. The estimate is the volume of the predicate
+  // geometry clipped against the scene, a proxy for the number of leaves
+  // the traversal will touch; predicates without extent all estimate zero
+  // and keep their relative order.
+  template <typename ExecutionSpace, typename Predicates, typename Box>
+  static Kokkos::View<unsigned int *, DeviceType>
+  sortPredicatesByEstimatedCost(ExecutionSpace const &space,
+                                Box const &scene_bounding_box,
+                                Predicates const &predicates)
+  {
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::BatchedQueries::schedule_predicates");
+
+    auto const n_queries = predicates.size();
+
+    Kokkos::View<float *, DeviceType> costs(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::BVH::query::predicate_costs"),
+        n_queries);
+    Kokkos::parallel_for(
+        "ArborX::BatchedQueries::estimate_predicate_costs",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int i) {
+          constexpr int DIM = GeometryTraits::dimension_v<Box>;
+          Box box{};
+          expand(box, getGeometry(predicates(i)));
+          float cost = 1;
+          for (int d = 0; d < DIM; ++d)
+          {
+            // Clip against the scene so that oversized or unbounded
+            // predicates do not drown the estimate
+            float const lo = Kokkos::max(
+                (float)box.minCorner()[d],
+                (float)scene_bounding_box.minCorner()[d]);
+            float const hi = Kokkos::min(
+                (float)box.maxCorner()[d],
+                (float)scene_bounding_box.maxCorner()[d]);
+            cost *= Kokkos::max(hi - lo, 0.f);
+          }
+          // sortObjects() sorts ascending; negate for heaviest-first
+          costs(i) = -cost;
+        });
+
+    return sortObjects(space, costs);
+  }
+
+  // Duplicate detection for batches where many predicates are byte-identical
+  // (e.g. query spheres generated from shared mesh corners). Predicates are
+  // hashed over their object representation, sorted by hash, and adjacent
+  // entries with equal hashes are byte-compared, so a hash collision can
+  // only cost a missed match, never a wrong one. Returns the indices of one
+  // representative per distinct predicate, and for every predicate the
+  // position of its representative in that list. Only byte-identical
+  // predicates are folded: attached data is part of the comparison, and
+  // padding bytes must be consistent across duplicates.
+  template <typename ExecutionSpace, typename Predicates>
+  static auto deduplicatePredicates(ExecutionSpace const &space,
+                                    Predicates const &predicates)
+  {
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::BatchedQueries::deduplicate_predicates");
+
+    using Predicate = typename Predicates::value_type;
+    int const n = predicates.size();
+
+    Kokkos::View<unsigned long long *, DeviceType> hashes(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::BatchedQueries::predicate_hashes"),
+        n);
+    Kokkos::parallel_for(
+        "ArborX::BatchedQueries::hash_predicates",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+          // FNV-1a over the object representation
+          auto const &predicate = predicates(i);
+          auto const *bytes = reinterpret_cast<unsigned char const *>(&predicate);
+          unsigned long long hash = 14695981039346656037ull;
+          for (std::size_t b = 0; b < sizeof(Predicate); ++b)
+            hash = (hash ^ bytes[b]) * 1099511628211ull;
+          hashes(i) = hash;
+        });
+
+    auto permute = sortObjects(space, hashes);
+
+    Kokkos::View<int *, DeviceType> duplicate_map(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::BatchedQueries::duplicate_map"),
+        n);
+    Kokkos::View<unsigned int *, DeviceType> unique_scratch(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::BatchedQueries::unique_scratch"),
+        n);
+    int n_unique;
+    Kokkos::parallel_scan(
+        "ArborX::BatchedQueries::extract_unique_predicates",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i, int &update, bool final_pass) {
+          bool head = true;
+          if (i > 0 && hashes(i) == hashes(i - 1))
+          {
+            auto const &a = predicates(permute(i));
+            auto const &b = predicates(permute(i - 1));
+            auto const *bytes_a = reinterpret_cast<unsigned char const *>(&a);
+            auto const *bytes_b = reinterpret_cast<unsigned char const *>(&b);
+            head = false;
+            for (std::size_t k = 0; k < sizeof(Predicate); ++k)
+              if (bytes_a[k] != bytes_b[k])
+              {
+                head = true;
+                break;
+              }
+          }
+          update += head;
+          if (final_pass)
+          {
+            if (head)
+              unique_scratch(update - 1) = permute(i);
+            duplicate_map(permute(i)) = update - 1;
+          }
+        },
+        n_unique);
+
+    Kokkos::View<unsigned int *, DeviceType> unique_indices(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::BatchedQueries::unique_predicate_indices"),
+        n_unique);
+    Kokkos::deep_copy(space, unique_indices,
+                      Kokkos::subview(unique_scratch,
+                                      Kokkos::make_pair(0, n_unique)));
+
+    return std::make_pair(unique_indices, duplicate_map);
+  }
+
   // NOTE  trailing return type seems required :(
   // error: The enclosing parent function ("applyPermutation") for an extended
   // __host__ __device__ lambda must not have deduced return type
@@ -13,15 +13,55 @@
 #define ARBORX_DETAILS_BRUTE_FORCE_IMPL_HPP
 
 #include <ArborX_DetailsAlgorithms.hpp> // expand
+#include <ArborX_DetailsContainers.hpp>
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_DetailsHeap.hpp>
 #include <ArborX_DetailsKokkosExtMinMaxOperations.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsLaunchPolicies.hpp>
+#include <ArborX_DetailsPriorityQueue.hpp>
 #include <ArborX_Exception.hpp>
+#include <ArborX_Predicates.hpp>
 
 #include <Kokkos_Core.hpp>
 
+#include <type_traits>
+
 namespace ArborX
 {
 namespace Details
 {
+
+// Size of the register-resident candidate array in the nearest kernel: the
+// compile-time k when the predicate carries one, otherwise a one-element
+// placeholder (the actual candidates then live in a global buffer)
+template <typename Predicate, typename = void>
+struct static_k_or_one : std::integral_constant<int, 1>
+{};
+template <typename Predicate>
+struct static_k_or_one<Predicate, std::void_t<decltype(Predicate::static_k)>>
+    : std::integral_constant<int, Predicate::static_k>
+{};
+
+// Nearest predicates over high-dimensional points are served by the
+// distance-matrix kernel, which trades the per-pair distance evaluation for
+// a norm precomputation plus inner products (||q - p||^2 = ||q||^2 + ||p||^2
+// - 2<q,p>, with ||q||^2 constant per query and dropped from the comparison
+// key). Low dimensions stay on the direct kernel: the inner-product
+// formulation saves nothing there and is more sensitive to cancellation.
+template <typename Predicate, typename Indexable, typename = void>
+struct use_distance_matrix : std::false_type
+{};
+template <typename Predicate, typename Indexable>
+struct use_distance_matrix<
+    Predicate, Indexable,
+    std::enable_if_t<GeometryTraits::is_point<std::decay_t<decltype(getGeometry(
+                         std::declval<Predicate const &>()))>>::value &&
+                     GeometryTraits::is_point<Indexable>::value>>
+    : std::bool_constant<(GeometryTraits::dimension_v<Indexable> >= 8)>
+{};
+
 struct BruteForceImpl
 {
   template <class ExecutionSpace, class Values, class IndexableGetter,
@@ -52,7 +92,9 @@ struct BruteForceImpl
                     Values const &values, Indexables const &indexables,
                     Callback const &callback)
   {
-    using TeamPolicy = Kokkos::TeamPolicy<ExecutionSpace>;
+    using TeamPolicy =
+        Kokkos::TeamPolicy<ExecutionSpace,
+                           typename TraversalLaunchBounds<ExecutionSpace>::type>;
     using PredicateType = typename Predicates::value_type;
     using IndexableType = std::decay_t<decltype(indexables(0))>;
 
@@ -136,6 +178,370 @@ struct BruteForceImpl
               });
         });
   }
+
+  // Tiled kNN kernel. Every thread owns one predicate and keeps its k-best
+  // candidate set across the whole scan, while the team cycles blocks of
+  // indexables through scratch memory (the GEMM-like formulation: every
+  // staged block is read by all threads of the team). Compile-time-k
+  // predicates keep their candidates in registers; for runtime k the heaps
+  // live in a global buffer sized by a scan over getK(), as in
+  // TreeTraversal::nearest.
+  template <class ExecutionSpace, class Predicates, class Values,
+            class Indexables, class Callback>
+  static void queryNearest(ExecutionSpace const &space,
+                           Predicates const &predicates, Values const &values,
+                           Indexables const &indexables,
+                           Callback const &callback)
+  {
+    using MemorySpace = typename Values::memory_space;
+    using TeamPolicy =
+        Kokkos::TeamPolicy<ExecutionSpace,
+                           typename TraversalLaunchBounds<ExecutionSpace>::type>;
+    using PredicateType = typename Predicates::value_type;
+    using IndexableType = std::decay_t<decltype(indexables(0))>;
+    using PairIndexDistance = Kokkos::pair<int, float>;
+
+    if constexpr (use_distance_matrix<PredicateType, IndexableType>::value)
+    {
+      queryNearestDistanceMatrix(space, predicates, values, indexables,
+                                 callback);
+      return;
+    }
+
+    int const n_indexables = values.size();
+    int const n_predicates = predicates.size();
+    if (n_indexables == 0 || n_predicates == 0)
+      return;
+
+    int const max_scratch_size = TeamPolicy::scratch_size_max(0);
+    int const indexables_per_team = max_scratch_size / sizeof(IndexableType);
+    ARBORX_ASSERT(indexables_per_team > 0);
+
+    using ScratchIndexableType =
+        Kokkos::View<IndexableType *,
+                     typename ExecutionSpace::scratch_memory_space,
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+    int const scratch_size =
+        ScratchIndexableType::shmem_size(indexables_per_team);
+
+    constexpr bool static_k = has_static_k<PredicateType>::value;
+
+    Kokkos::View<PairIndexDistance *, MemorySpace> buffer(
+        "ArborX::BruteForce::query::nearest::buffer", 0);
+    Kokkos::View<int *, MemorySpace> offset(
+        "ArborX::BruteForce::query::nearest::offset", 0);
+    if constexpr (!static_k)
+    {
+      // The number of neighbors k is only known at runtime and may differ
+      // between predicates, so the candidate heaps cannot live in registers
+      KokkosExt::reallocWithoutInitializing(space, offset, n_predicates + 1);
+      Kokkos::parallel_for(
+          "ArborX::BruteForce::query::nearest::"
+          "scan_queries_for_numbers_of_neighbors",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_predicates),
+          KOKKOS_LAMBDA(int i) { offset(i) = getK(predicates(i)); });
+      KokkosExt::exclusive_scan(space, offset, offset, 0);
+      KokkosExt::reallocWithoutInitializing(
+          space, buffer, KokkosExt::lastElement(space, offset));
+    }
+
+    auto kernel = KOKKOS_LAMBDA(
+        typename TeamPolicy::member_type const &member)
+    {
+      // One predicate per thread; threads past the end still participate in
+      // the staging and the barriers
+      int const q =
+          member.league_rank() * member.team_size() + member.team_rank();
+      bool const active = (q < n_predicates);
+      auto const predicate = predicates(active ? q : 0);
+      // Squared distances throughout, same as TreeTraversal::nearestQuery()
+      auto const bound = getBound(predicate);
+      auto radius = bound * bound;
+
+      struct CompareDistance
+      {
+        KOKKOS_FUNCTION bool operator()(PairIndexDistance const &lhs,
+                                        PairIndexDistance const &rhs) const
+        {
+          return lhs.second < rhs.second;
+        }
+      };
+
+      int k;
+      PairIndexDistance best[static_k_or_one<PredicateType>::value];
+      PairIndexDistance *candidates;
+      if constexpr (static_k)
+      {
+        k = PredicateType::static_k;
+        candidates = best; // registers
+      }
+      else
+      {
+        k = getK(predicate);
+        candidates = (active && k > 0 ? &buffer(offset(q)) : best);
+      }
+
+      PriorityQueue<PairIndexDistance, CompareDistance,
+                    UnmanagedStaticVector<PairIndexDistance>>
+          heap(UnmanagedStaticVector<PairIndexDistance>(
+              candidates, active && k > 0 ? k : 0));
+
+      ScratchIndexableType scratch_indexables(member.team_scratch(0),
+                                              indexables_per_team);
+      for (int indexable_start = 0; indexable_start < n_indexables;
+           indexable_start += indexables_per_team)
+      {
+        int const indexables_in_this_tile =
+            KokkosExt::min(indexables_per_team, n_indexables - indexable_start);
+
+        Kokkos::parallel_for(
+            Kokkos::TeamVectorRange(member, indexables_in_this_tile),
+            [&](int j) {
+              scratch_indexables(j) = indexables(indexable_start + j);
+            });
+        member.team_barrier();
+
+        if (active && k > 0)
+        {
+          for (int j = 0; j < indexables_in_this_tile; ++j)
+          {
+            auto const d = predicate.distanceSquared(scratch_indexables(j));
+            if (d < radius)
+            {
+              auto const candidate = Kokkos::make_pair(indexable_start + j, d);
+              if ((int)heap.size() < k)
+                heap.push(candidate);
+              else
+                heap.popPush(candidate);
+              if ((int)heap.size() == k)
+                radius = heap.top().second;
+            }
+          }
+        }
+        // Wait for all the threads to finish reading before the next block
+        // overwrites the scratch
+        member.team_barrier();
+      }
+
+      if (active && k > 0)
+      {
+        sortHeap(heap.data(), heap.data() + heap.size(), heap.valueComp());
+        for (decltype(heap.size()) i = 0; i < heap.size(); ++i)
+          callback(predicate, values((heap.data() + i)->first));
+      }
+    };
+
+    TeamPolicy probe(space, 1, 1);
+    int const team_size =
+        KokkosExt::min(probe.team_size_max(kernel, Kokkos::ParallelForTag{}),
+                       n_predicates);
+    int const n_teams = (n_predicates + team_size - 1) / team_size;
+    Kokkos::parallel_for(
+        "ArborX::BruteForce::query::nearest::"
+        "check_all_predicates_against_all_indexables",
+        TeamPolicy(space, n_teams, team_size)
+            .set_scratch_size(0, Kokkos::PerTeam(scratch_size)),
+        kernel);
+  }
+
+  // Distance-matrix variant of the kNN kernel for high-dimensional points.
+  // Squared primitive norms are computed once up front and staged in scratch
+  // together with the coordinates; each thread then ranks candidates by
+  // ||p||^2 - 2<q,p>, which orders them exactly like the true distance (the
+  // query norm is constant per thread) while replacing the coordinate
+  // differences of the direct kernel by pure multiply-adds over the staged
+  // block. The tiling and the candidate-set handling match queryNearest.
+  template <class ExecutionSpace, class Predicates, class Values,
+            class Indexables, class Callback>
+  static void queryNearestDistanceMatrix(ExecutionSpace const &space,
+                                         Predicates const &predicates,
+                                         Values const &values,
+                                         Indexables const &indexables,
+                                         Callback const &callback)
+  {
+    using MemorySpace = typename Values::memory_space;
+    using TeamPolicy = Kokkos::TeamPolicy<ExecutionSpace>;
+    using PredicateType = typename Predicates::value_type;
+    using IndexableType = std::decay_t<decltype(indexables(0))>;
+    // Coordinates may be stored in reduced precision (which is what makes
+    // this kernel attractive for embedding vectors: half the staged bytes
+    // per tile); norms and inner products always accumulate in the compute
+    // type
+    using Coordinate = GeometryTraits::compute_coordinate_t<
+        typename GeometryTraits::coordinate_type<IndexableType>::type>;
+    using PairIndexDistance = Kokkos::pair<int, Coordinate>;
+    constexpr int DIM = GeometryTraits::dimension_v<IndexableType>;
+
+    int const n_indexables = values.size();
+    int const n_predicates = predicates.size();
+    if (n_indexables == 0 || n_predicates == 0)
+      return;
+
+    Kokkos::View<Coordinate *, MemorySpace> squared_norms(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::BruteForce::query::nearest::squared_norms"),
+        n_indexables);
+    Kokkos::parallel_for(
+        "ArborX::BruteForce::query::nearest::precompute_squared_norms",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_indexables),
+        KOKKOS_LAMBDA(int i) {
+          auto const &p = indexables(i);
+          Coordinate norm = 0;
+          for (int d = 0; d < DIM; ++d)
+          {
+            Coordinate const c = p[d];
+            norm += c * c;
+          }
+          squared_norms(i) = norm;
+        });
+
+    int const max_scratch_size = TeamPolicy::scratch_size_max(0);
+    int const indexables_per_team =
+        max_scratch_size / (sizeof(IndexableType) + sizeof(Coordinate));
+    ARBORX_ASSERT(indexables_per_team > 0);
+
+    using ScratchIndexableType =
+        Kokkos::View<IndexableType *,
+                     typename ExecutionSpace::scratch_memory_space,
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+    using ScratchNormType =
+        Kokkos::View<Coordinate *,
+                     typename ExecutionSpace::scratch_memory_space,
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+    int const scratch_size =
+        ScratchIndexableType::shmem_size(indexables_per_team) +
+        ScratchNormType::shmem_size(indexables_per_team);
+
+    constexpr bool static_k = has_static_k<PredicateType>::value;
+
+    Kokkos::View<PairIndexDistance *, MemorySpace> buffer(
+        "ArborX::BruteForce::query::nearest::buffer", 0);
+    Kokkos::View<int *, MemorySpace> offset(
+        "ArborX::BruteForce::query::nearest::offset", 0);
+    if constexpr (!static_k)
+    {
+      KokkosExt::reallocWithoutInitializing(space, offset, n_predicates + 1);
+      Kokkos::parallel_for(
+          "ArborX::BruteForce::query::nearest::"
+          "scan_queries_for_numbers_of_neighbors",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_predicates),
+          KOKKOS_LAMBDA(int i) { offset(i) = getK(predicates(i)); });
+      KokkosExt::exclusive_scan(space, offset, offset, 0);
+      KokkosExt::reallocWithoutInitializing(
+          space, buffer, KokkosExt::lastElement(space, offset));
+    }
+
+    auto kernel = KOKKOS_LAMBDA(
+        typename TeamPolicy::member_type const &member)
+    {
+      int const q =
+          member.league_rank() * member.team_size() + member.team_rank();
+      bool const active = (q < n_predicates);
+      auto const predicate = predicates(active ? q : 0);
+      auto const query_point = getGeometry(predicate);
+
+      Coordinate query_norm = 0;
+      for (int d = 0; d < DIM; ++d)
+      {
+        Coordinate const c = query_point[d];
+        query_norm += c * c;
+      }
+
+      // Bounds and candidate keys live in the biased key space
+      // d^2 - ||q||^2, shifted once instead of per pair
+      auto const bound = getBound(predicate);
+      Coordinate radius = bound * bound - query_norm;
+
+      struct CompareDistance
+      {
+        KOKKOS_FUNCTION bool operator()(PairIndexDistance const &lhs,
+                                        PairIndexDistance const &rhs) const
+        {
+          return lhs.second < rhs.second;
+        }
+      };
+
+      int k;
+      PairIndexDistance best[static_k_or_one<PredicateType>::value];
+      PairIndexDistance *candidates;
+      if constexpr (static_k)
+      {
+        k = PredicateType::static_k;
+        candidates = best; // registers
+      }
+      else
+      {
+        k = getK(predicate);
+        candidates = (active && k > 0 ? &buffer(offset(q)) : best);
+      }
+
+      PriorityQueue<PairIndexDistance, CompareDistance,
+                    UnmanagedStaticVector<PairIndexDistance>>
+          heap(UnmanagedStaticVector<PairIndexDistance>(
+              candidates, active && k > 0 ? k : 0));
+
+      ScratchIndexableType scratch_indexables(member.team_scratch(0),
+                                              indexables_per_team);
+      ScratchNormType scratch_norms(member.team_scratch(0),
+                                    indexables_per_team);
+      for (int indexable_start = 0; indexable_start < n_indexables;
+           indexable_start += indexables_per_team)
+      {
+        int const indexables_in_this_tile =
+            KokkosExt::min(indexables_per_team, n_indexables - indexable_start);
+
+        Kokkos::parallel_for(
+            Kokkos::TeamVectorRange(member, indexables_in_this_tile),
+            [&](int j) {
+              scratch_indexables(j) = indexables(indexable_start + j);
+              scratch_norms(j) = squared_norms(indexable_start + j);
+            });
+        member.team_barrier();
+
+        if (active && k > 0)
+        {
+          for (int j = 0; j < indexables_in_this_tile; ++j)
+          {
+            auto const &p = scratch_indexables(j);
+            Coordinate dot = 0;
+            for (int d = 0; d < DIM; ++d)
+              dot += (Coordinate)query_point[d] * (Coordinate)p[d];
+            auto const key = scratch_norms(j) - 2 * dot;
+            if (key < radius)
+            {
+              auto const candidate = Kokkos::make_pair(indexable_start + j, key);
+              if ((int)heap.size() < k)
+                heap.push(candidate);
+              else
+                heap.popPush(candidate);
+              if ((int)heap.size() == k)
+                radius = heap.top().second;
+            }
+          }
+        }
+        member.team_barrier();
+      }
+
+      if (active && k > 0)
+      {
+        sortHeap(heap.data(), heap.data() + heap.size(), heap.valueComp());
+        for (decltype(heap.size()) i = 0; i < heap.size(); ++i)
+          callback(predicate, values((heap.data() + i)->first));
+      }
+    };
+
+    TeamPolicy probe(space, 1, 1);
+    int const team_size =
+        KokkosExt::min(probe.team_size_max(kernel, Kokkos::ParallelForTag{}),
+                       n_predicates);
+    int const n_teams = (n_predicates + team_size - 1) / team_size;
+    Kokkos::parallel_for(
+        "ArborX::BruteForce::query::nearest::"
+        "distance_matrix_check_all_predicates_against_all_indexables",
+        TeamPolicy(space, n_teams, team_size)
+            .set_scratch_size(0, Kokkos::PerTeam(scratch_size)),
+        kernel);
+  }
 };
 } // namespace Details
 } // namespace ArborX
@@ -36,6 +36,8 @@ private:
 public:
   static constexpr int dim = DIM;
 
+  CartesianGrid() = default;
+
   CartesianGrid(Box const &bounds, float h)
       : _bounds(bounds)
   {
@@ -97,6 +99,20 @@ public:
     return _n[d];
   }
 
+  KOKKOS_FUNCTION
+  auto minCorner(int d) const
+  {
+    KOKKOS_ASSERT(0 <= d && d < DIM);
+    return _bounds.minCorner()[d];
+  }
+
+  KOKKOS_FUNCTION
+  float cellSize(int d) const
+  {
+    KOKKOS_ASSERT(0 <= d && d < DIM);
+    return _h[d];
+  }
+
 private:
   void buildGrid()
   {
@@ -18,8 +18,10 @@
 #include <impl/Kokkos_Error.hpp> // KOKKOS_ASSERT
 #endif
 
-#include <cstddef> // size_t, ptrdiff_t
-#include <utility> // move, forward
+#include <cstddef>     // size_t, ptrdiff_t
+#include <iterator>    // random_access_iterator_tag
+#include <type_traits> // remove_cv_t
+#include <utility>     // move, forward
 
 namespace ArborX
 {
@@ -104,6 +106,88 @@ class UnmanagedStaticVector
   // clang-format on
 };
 
+// Random access iterator stepping over every stride-th element of an array,
+// so that the heap algorithms (see ArborX_DetailsHeap.hpp) can operate on a
+// per-thread sequence interleaved across a thread batch (see
+// UnmanagedStridedVector)
+template <typename T>
+class StridedIterator
+{
+  // clang-format off
+  public:
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using pointer = T *;
+    using iterator_category = std::random_access_iterator_tag;
+    KOKKOS_DEFAULTED_FUNCTION StridedIterator() = default;
+    KOKKOS_INLINE_FUNCTION StridedIterator(T *ptr, difference_type stride) : _ptr(ptr), _stride(stride) {}
+    KOKKOS_INLINE_FUNCTION reference operator*() const { return *_ptr; }
+    KOKKOS_INLINE_FUNCTION pointer operator->() const { return _ptr; }
+    KOKKOS_INLINE_FUNCTION reference operator[](difference_type n) const { return *(_ptr + n * _stride); }
+    KOKKOS_INLINE_FUNCTION StridedIterator &operator++() { _ptr += _stride; return *this; }
+    KOKKOS_INLINE_FUNCTION StridedIterator operator++(int) { auto copy = *this; _ptr += _stride; return copy; }
+    KOKKOS_INLINE_FUNCTION StridedIterator &operator--() { _ptr -= _stride; return *this; }
+    KOKKOS_INLINE_FUNCTION StridedIterator operator--(int) { auto copy = *this; _ptr -= _stride; return copy; }
+    KOKKOS_INLINE_FUNCTION StridedIterator &operator+=(difference_type n) { _ptr += n * _stride; return *this; }
+    KOKKOS_INLINE_FUNCTION StridedIterator &operator-=(difference_type n) { _ptr -= n * _stride; return *this; }
+    KOKKOS_INLINE_FUNCTION StridedIterator operator+(difference_type n) const { return {_ptr + n * _stride, _stride}; }
+    KOKKOS_INLINE_FUNCTION StridedIterator operator-(difference_type n) const { return {_ptr - n * _stride, _stride}; }
+    KOKKOS_INLINE_FUNCTION difference_type operator-(StridedIterator const &other) const { return (_ptr - other._ptr) / _stride; }
+    KOKKOS_INLINE_FUNCTION bool operator==(StridedIterator const &other) const { return _ptr == other._ptr; }
+    KOKKOS_INLINE_FUNCTION bool operator!=(StridedIterator const &other) const { return _ptr != other._ptr; }
+    KOKKOS_INLINE_FUNCTION bool operator<(StridedIterator const &other) const { return _ptr < other._ptr; }
+
+  private:
+    T *_ptr = nullptr;
+    difference_type _stride = 1;
+  // clang-format on
+};
+
+// UnmanagedStaticVector over a strided sequence: element i lives at
+// ptr + i * stride. With the stride equal to the batch size and ptr offset
+// by the thread id, the vectors of a thread batch interleave (k-major
+// layout), and threads updating their i-th element access adjacent words
+template <typename T>
+class UnmanagedStridedVector
+{
+  // clang-format off
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type &;
+    using const_reference = value_type const &;
+    using pointer = StridedIterator<T>;
+    using const_pointer = StridedIterator<T const>;
+    KOKKOS_FUNCTION UnmanagedStridedVector( T *ptr, size_type max_size, difference_type stride ) : _ptr(ptr) , _max_size(max_size), _stride(stride) { KOKKOS_ASSERT(ptr != nullptr); KOKKOS_ASSERT(stride > 0); }
+    KOKKOS_INLINE_FUNCTION bool empty() const { return _size == 0; }
+    KOKKOS_INLINE_FUNCTION size_type size() const { return _size; }
+    KOKKOS_INLINE_FUNCTION constexpr size_type maxSize() const { return _max_size; }
+    KOKKOS_INLINE_FUNCTION constexpr size_type capacity() const { return _max_size; }
+    KOKKOS_INLINE_FUNCTION reference operator[]( size_type pos ) { KOKKOS_ASSERT(pos < size()); return *(_ptr + pos * _stride); }
+    KOKKOS_INLINE_FUNCTION const_reference operator[]( size_type pos ) const { KOKKOS_ASSERT(pos < size()); return *(_ptr + pos * _stride); }
+    KOKKOS_INLINE_FUNCTION reference back() { KOKKOS_ASSERT(size() > 0); return *(_ptr + (_size - 1) * _stride); }
+    KOKKOS_INLINE_FUNCTION const_reference back() const { KOKKOS_ASSERT(size() > 0); return *(_ptr + (_size - 1) * _stride); }
+    KOKKOS_INLINE_FUNCTION void pushBack(T const &value) { KOKKOS_ASSERT(size() < maxSize()); *(_ptr + _size++ * _stride) = value; }
+    KOKKOS_INLINE_FUNCTION void pushBack(T &&value) { KOKKOS_ASSERT(size() < maxSize()); *(_ptr + _size++ * _stride) = std::move(value); }
+    template<class... Args>
+    KOKKOS_INLINE_FUNCTION void emplaceBack(Args&&... args) { KOKKOS_ASSERT(size() < maxSize()); ::new (static_cast<void*>(_ptr + _size++ * _stride)) T(std::forward<Args>(args)...); }
+    KOKKOS_INLINE_FUNCTION void popBack() { KOKKOS_ASSERT(size() > 0); _size--; }
+    KOKKOS_INLINE_FUNCTION reference front() { KOKKOS_ASSERT(size() > 0); return *_ptr; }
+    KOKKOS_INLINE_FUNCTION const_reference front() const { KOKKOS_ASSERT(size() > 0); return *_ptr; }
+    KOKKOS_INLINE_FUNCTION void clear() { _size = 0; }
+    KOKKOS_INLINE_FUNCTION pointer data() { return pointer(_ptr, _stride); }
+    KOKKOS_INLINE_FUNCTION const_pointer data() const { return const_pointer(_ptr, _stride); }
+
+  private:
+    T *_ptr = nullptr;
+    size_type const _max_size = 0;
+    difference_type const _stride = 1;
+    size_type _size = 0;
+  // clang-format on
+};
+
 } // namespace Details
 } // namespace ArborX
 
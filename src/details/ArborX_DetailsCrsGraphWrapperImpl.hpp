@@ -18,10 +18,19 @@
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
 #include <ArborX_DetailsKokkosExtViewHelpers.hpp>
 #include <ArborX_DetailsPermutedData.hpp>
+#include <ArborX_Exception.hpp>
 #include <ArborX_HyperBox.hpp>
 #include <ArborX_Predicates.hpp>
+#include <ArborX_QueryFuture.hpp>
+#include <ArborX_QueryWorkspace.hpp>
 #include <ArborX_TraversalPolicy.hpp>
 
+#include <Kokkos_DetectionIdiom.hpp>
+
+#include <algorithm> // max
+#include <cstdlib>   // abs
+#include <string>
+
 namespace ArborX
 {
 namespace Details
@@ -79,7 +88,7 @@ struct InsertGenerator
       auto const buffer_size = *(&offset + 1) - offset;
 
       return _callback(raw_predicate, value, [&](ValueType const &v) {
-        int count_old = Kokkos::atomic_fetch_add(&count, 1);
+        auto const count_old = Kokkos::atomic_fetch_add(&count, 1);
         if (count_old < buffer_size)
           _out(offset + count_old) = v;
       });
@@ -111,30 +120,210 @@ struct InsertGenerator
 namespace CrsGraphWrapperImpl
 {
 
+// Archetype for detecting trees that support in-kernel per-thread queries,
+// which the write-combining second pass below is built on
+struct DetectionCallbackArchetype
+{
+  template <typename Predicate, typename Value>
+  KOKKOS_FUNCTION void operator()(Predicate const &, Value const &) const
+  {}
+};
+
+template <typename Tree, typename Predicate>
+using PerThreadQueryArchetypeExpression =
+    decltype(std::declval<Tree const &>().query(
+        Experimental::PerThread{}, std::declval<Predicate const &>(),
+        std::declval<DetectionCallbackArchetype const &>()));
+
+struct Iota
+{
+  KOKKOS_FUNCTION unsigned int operator()(int const i) const { return i; }
+};
+
+// Batches below this size keep the on-the-fly permutation: the double
+// indirection they pay over the buffered passes is cheaper than allocating
+// and filling a copy of the predicates
+constexpr int materialize_predicates_min_batch = 1 << 12;
+
+// Applies the permutation and attaches the positions once, producing a flat
+// view the buffered traversal streams directly. PermutedData re-reads the
+// permutation array and re-attaches on every access, and the two-pass query
+// accesses each predicate several times; one extra streaming pass replaces
+// all those scattered double-indirections.
+template <typename ExecutionSpace, typename Predicates, typename Permute>
+auto materializePermutedPredicates(ExecutionSpace const &space,
+                                   Predicates const &predicates,
+                                   Permute const &permute)
+{
+  using MemorySpace = typename Predicates::memory_space;
+  using AttachedPredicate = std::decay_t<decltype(attach(predicates(0), 0))>;
+
+  int const n_queries = predicates.size();
+  Kokkos::View<AttachedPredicate *, MemorySpace> materialized(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::CrsGraphWrapper::materialized_predicates"),
+      n_queries);
+  Kokkos::parallel_for(
+      "ArborX::CrsGraphWrapper::materialize_permuted_predicates",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int i) {
+        materialized(i) = attach(predicates(permute(i)), i);
+      });
+  return MaterializedPredicates<decltype(materialized)>{materialized};
+}
+
+// Second-pass fill with write combining. The plain second pass has every
+// thread stream its matches to its own CSR row, so at any instant the warp
+// stores to as many scattered rows as it has lanes. Here each thread stages
+// its matches in a team scratch block and the whole team then flushes the
+// blocks one row at a time, so consecutive lanes write consecutive
+// addresses. Matches beyond the staging capacity spill straight to global
+// memory past the staged part of the row; the order within a row is
+// unspecified either way.
+template <typename ExecutionSpace, typename Tree, typename PermutedPredicates,
+          typename Callback, typename OutputView, typename CountView>
+void secondPassWriteCombining(ExecutionSpace const &space, Tree const &tree,
+                              PermutedPredicates const &permuted_predicates,
+                              Callback const &callback, OutputView const &out,
+                              CountView const &counts)
+{
+  using ValueType = typename OutputView::value_type;
+  using OffsetValue = typename CountView::non_const_value_type;
+  using TeamPolicy = Kokkos::TeamPolicy<ExecutionSpace>;
+  using ScratchValues =
+      Kokkos::View<ValueType *, typename ExecutionSpace::scratch_memory_space,
+                   Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+  using ScratchCounts =
+      Kokkos::View<int *, typename ExecutionSpace::scratch_memory_space,
+                   Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+  using ScratchBases =
+      Kokkos::View<OffsetValue *,
+                   typename ExecutionSpace::scratch_memory_space,
+                   Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+  int const n_queries = permuted_predicates.size();
+
+  // A warp-sized chunk per thread is enough to turn the flushed stores into
+  // full transactions without starving occupancy on scratch
+  constexpr int staging_capacity = 32;
+
+  auto kernel = KOKKOS_LAMBDA(typename TeamPolicy::member_type const &member)
+  {
+    int const team_size = member.team_size();
+    int const rank = member.team_rank();
+    int const q = member.league_rank() * team_size + rank;
+    bool const active = (q < n_queries);
+
+    ScratchValues staged(member.team_scratch(0),
+                         (size_t)team_size * staging_capacity);
+    ScratchCounts staged_counts(member.team_scratch(0), team_size);
+    ScratchBases bases(member.team_scratch(0), team_size);
+
+    int n_staged = 0;
+    OffsetValue base = 0;
+    OffsetValue n_spilled = 0;
+    if (active)
+    {
+      base = counts(q);
+      // Keep the attached predicate alive for the whole traversal; slicing
+      // off the position must not reference a temporary
+      auto const predicate_with_index = permuted_predicates(q);
+      auto const &predicate = getPredicate(predicate_with_index);
+      tree.query(Experimental::PerThread{}, predicate,
+                 [&](auto const &, auto const &value) {
+                   return callback(predicate, value, [&](ValueType const &v) {
+                     if (n_staged < staging_capacity)
+                       staged((size_t)rank * staging_capacity + n_staged++) = v;
+                     else
+                       out(base + staging_capacity + n_spilled++) = v;
+                   });
+                 });
+    }
+    staged_counts(rank) = n_staged;
+    bases(rank) = base;
+    member.team_barrier();
+
+    // The team flushes the staged blocks one row at a time: every lane of
+    // the copy targets the same contiguous destination range
+    for (int t = 0; t < team_size; ++t)
+    {
+      int const cnt = staged_counts(t);
+      auto const b = bases(t);
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, cnt), [&](int j) {
+        out(b + j) = staged((size_t)t * staging_capacity + j);
+      });
+    }
+  };
+
+  int const per_thread_scratch = staging_capacity * sizeof(ValueType) +
+                                 sizeof(int) + sizeof(OffsetValue);
+  TeamPolicy probe(space, 1, 1);
+  probe.set_scratch_size(0, Kokkos::PerThread(per_thread_scratch));
+  int const team_size = std::min(
+      probe.team_size_max(kernel, Kokkos::ParallelForTag{}), n_queries);
+  int const n_teams = (n_queries + team_size - 1) / team_size;
+  Kokkos::parallel_for(
+      "ArborX::CrsGraphWrapper::second_pass_write_combining",
+      TeamPolicy(space, n_teams, team_size)
+          .set_scratch_size(0, Kokkos::PerThread(per_thread_scratch)),
+      kernel);
+}
+
 template <typename ExecutionSpace, typename Tree, typename Predicates,
           typename Callback, typename OutputView, typename OffsetView,
           typename PermuteType>
 void queryImpl(ExecutionSpace const &space, Tree const &tree,
                Predicates const &predicates, Callback const &callback,
                OutputView &out, OffsetView &offset, PermuteType permute,
-               BufferStatus buffer_status)
+               BufferStatus buffer_status, bool user_storage = false)
 {
   // pre-condition: offset and out are preallocated. If buffer_size > 0, offset
-  // is pre-initialized
+  // is pre-initialized. If user_storage is true, out belongs to the caller and
+  // must never be reallocated, shrunk, or replaced; its size is a capacity.
 
   static_assert(Kokkos::is_execution_space<ExecutionSpace>{});
 
+  // The offset element type parametrizes all result indexing below; pass
+  // 64-bit offset views when the total result count may exceed 2^31
+  using OffsetValue = typename OffsetView::non_const_value_type;
+
   auto const n_queries = predicates.size();
 
+  // When sorted predicates go through the buffered passes, each is read
+  // several times (count pass, overflow and underflow scans, possibly a fill
+  // pass), and every read chases the permutation array again. Large batches
+  // amortize materializing the permuted predicates once instead.
+  if constexpr (!is_materialized_predicates<Predicates>::value &&
+                !std::is_same_v<PermuteType, Iota>)
+  {
+    if (buffer_status != BufferStatus::PreallocationNone &&
+        (int)n_queries >= materialize_predicates_min_batch)
+    {
+      queryImpl(space, tree,
+                materializePermutedPredicates(space, predicates, permute),
+                callback, out, offset, permute, buffer_status, user_storage);
+      return;
+    }
+  }
+
   Kokkos::Profiling::pushRegion("ArborX::CrsGraphWrapper::two_pass");
 
   using CountView = OffsetView;
   CountView counts(Kokkos::view_alloc(space, "ArborX::CrsGraphWrapper::counts"),
                    n_queries);
 
+  // Materialized predicates already carry their positions; everything else
+  // is permuted and index-attached on the fly
   using PermutedPredicates =
-      PermutedData<Predicates, PermuteType, true /*AttachIndices*/>;
-  PermutedPredicates permuted_predicates = {predicates, permute};
+      std::conditional_t<is_materialized_predicates<Predicates>::value,
+                         Predicates,
+                         PermutedData<Predicates, PermuteType, true>>;
+  PermutedPredicates permuted_predicates = [&] {
+    if constexpr (is_materialized_predicates<Predicates>::value)
+      return predicates;
+    else
+      return PermutedPredicates{predicates, permute};
+  }();
 
   using PermutedOffset = PermutedData<OffsetView, PermuteType>;
   PermutedOffset permuted_offset = {offset, permute};
@@ -168,13 +357,13 @@ void queryImpl(ExecutionSpace const &space, Tree const &tree,
 
     if (!overflow)
     {
-      int n_results;
+      OffsetValue n_results;
       Kokkos::parallel_reduce(
           "ArborX::CrsGraphWrapper::compute_underflow",
           Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
-          KOKKOS_LAMBDA(int i, int &update) { update += counts(i); },
+          KOKKOS_LAMBDA(int i, OffsetValue &update) { update += counts(i); },
           n_results);
-      underflow = (n_results < out.extent_int(0));
+      underflow = (n_results < (OffsetValue)out.extent(0));
     }
   }
   else
@@ -196,7 +385,7 @@ void queryImpl(ExecutionSpace const &space, Tree const &tree,
       "ArborX::CrsGraphWrapper::first_pass_postprocess");
 
   OffsetView preallocated_offset("ArborX::CrsGraphWrapper::offset_copy", 0);
-  if (underflow)
+  if (underflow && !user_storage)
   {
     // Store a copy of the original offset. We'll need it for compression.
     preallocated_offset = KokkosExt::clone(space, offset);
@@ -208,7 +397,10 @@ void queryImpl(ExecutionSpace const &space, Tree const &tree,
       KOKKOS_LAMBDA(int const i) { permuted_offset(i) = counts(i); });
   KokkosExt::exclusive_scan(space, offset, offset, 0);
 
-  int const n_results = KokkosExt::lastElement(space, offset);
+  OffsetValue const n_results = KokkosExt::lastElement(space, offset);
+
+  Kokkos::Profiling::markEvent("ArborX::CrsGraphWrapper::num_results=" +
+                               std::to_string(n_results));
 
   if(n_results < 0){
     // This condition confirms an overflow has occurred. Note that a positive 
@@ -227,15 +419,20 @@ void queryImpl(ExecutionSpace const &space, Tree const &tree,
     // Exit early if either no results were found for any of the queries, or
     // nothing was inserted inside a callback for found results. This check
     // guarantees that the second pass will not be executed.
-    Kokkos::resize(out, 0);
+    if (!user_storage)
+      Kokkos::resize(out, 0);
     // FIXME: do we need to reset offset if it was preallocated here?
     Kokkos::Profiling::popRegion();
     return;
   }
 
-  if (overflow || buffer_status == BufferStatus::PreallocationNone)
+  if (overflow || buffer_status == BufferStatus::PreallocationNone ||
+      (underflow && user_storage))
   {
-    // Not enough (individual) storage for results
+    // Not enough (individual) storage for results. With user-provided storage
+    // we also land here on underflow: compressing in place would race, so we
+    // rerun the fill pass at the compact offsets instead of allocating a
+    // temporary.
 
     // If it was hard preallocation, we simply throw
     ARBORX_ASSERT(buffer_status != BufferStatus::PreallocationHard);
@@ -249,13 +446,33 @@ void queryImpl(ExecutionSpace const &space, Tree const &tree,
         Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
         KOKKOS_LAMBDA(int const i) { counts(i) = permuted_offset(i); });
 
-    KokkosExt::reallocWithoutInitializing(space, out, n_results);
-
-    tree.query(
-        space, permuted_predicates,
-        InsertGenerator<SecondPassTag, Callback, OutputView, CountView,
-                        PermutedOffset>{callback, out, counts, permuted_offset},
-        ArborX::Experimental::TraversalPolicy().setPredicateSorting(false));
+    if (!user_storage)
+      KokkosExt::reallocWithoutInitializing(space, out, n_results);
+    else if ((OffsetValue)out.extent(0) < n_results)
+      throw SearchException(
+          "user-provided output view capacity (" +
+          std::to_string(out.extent(0)) + ") is too small to hold the " +
+          std::to_string(n_results) + " query results");
+
+    using PredicateType = typename Predicates::value_type;
+    if constexpr (Kokkos::is_detected<PerThreadQueryArchetypeExpression, Tree,
+                                      PredicateType>::value &&
+                  std::is_same_v<typename PredicateType::Tag,
+                                 SpatialPredicateTag>)
+    {
+      // counts holds the output base of every row at this point
+      secondPassWriteCombining(space, tree, permuted_predicates, callback, out,
+                               counts);
+    }
+    else
+    {
+      tree.query(space, permuted_predicates,
+                 InsertGenerator<SecondPassTag, Callback, OutputView, CountView,
+                                 PermutedOffset>{callback, out, counts,
+                                                 permuted_offset},
+                 ArborX::Experimental::TraversalPolicy().setPredicateSorting(
+                     false));
+    }
 
     Kokkos::Profiling::popRegion();
   }
@@ -273,8 +490,8 @@ void queryImpl(ExecutionSpace const &space, Tree const &tree,
         "ArborX::CrsGraphWrapper::copy_valid_values",
         Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
         KOKKOS_LAMBDA(int i) {
-          int count = offset(i + 1) - offset(i);
-          for (int j = 0; j < count; ++j)
+          auto const count = offset(i + 1) - offset(i);
+          for (OffsetValue j = 0; j < count; ++j)
           {
             tmp_out(offset(i) + j) = out(preallocated_offset(i) + j);
           }
@@ -290,21 +507,144 @@ void queryImpl(ExecutionSpace const &space, Tree const &tree,
   Kokkos::Profiling::popRegion();
 }
 
-struct Iota
+template <typename Callback, typename ArenaView, typename CountView,
+          typename TotalView>
+struct ArenaInsertGenerator
 {
-  KOKKOS_FUNCTION unsigned int operator()(int const i) const { return i; }
+  Callback _callback;
+  ArenaView _arena;
+  CountView _counts;
+  TotalView _total;
+  int _capacity;
+
+  using ValueType = typename ArenaView::value_type::second_type;
+
+  template <typename Predicate, typename Value>
+  KOKKOS_FUNCTION auto operator()(Predicate const &predicate,
+                                  Value const &value) const
+  {
+    auto const predicate_index = getData(predicate);
+    return _callback(getPredicate(predicate), value, [&](ValueType const &v) {
+      Kokkos::atomic_increment(&_counts(predicate_index));
+      auto const slot = Kokkos::atomic_fetch_add(&_total(), 1);
+      if (slot < _capacity)
+        _arena(slot) = {predicate_index, v};
+    });
+  }
 };
 
+// Single-pass alternative to count+fill: results are bump-allocated from a
+// fixed-capacity arena during the only traversal, then compacted into CRS
+// order with a data pass (no second tree walk). The per-predicate counts
+// gathered during the pass are exact even if the arena overflows, so the
+// overflow fallback runs just the fill pass of the classic scheme — the
+// first walk is never wasted.
+template <typename ExecutionSpace, typename Tree, typename Predicates,
+          typename Callback, typename OutputView, typename OffsetView,
+          typename PermuteType>
+void queryImplSinglePass(ExecutionSpace const &space, Tree const &tree,
+                         Predicates const &predicates,
+                         Callback const &callback, OutputView &out,
+                         OffsetView &offset, PermuteType permute,
+                         int arena_size)
+{
+  using MemorySpace = typename Tree::memory_space;
+  using Value = typename OutputView::value_type;
+
+  auto const n_queries = predicates.size();
+
+  Kokkos::Profiling::pushRegion("ArborX::CrsGraphWrapper::single_pass");
+
+  using CountView = OffsetView;
+  CountView counts(Kokkos::view_alloc(space, "ArborX::CrsGraphWrapper::counts"),
+                   n_queries);
+
+  Kokkos::View<Kokkos::pair<int, Value> *, MemorySpace> arena(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::CrsGraphWrapper::arena"),
+      arena_size);
+  // 64-bit so the bump counter cannot wrap (and corrupt slot indices) when
+  // the traversal produces more results than the arena holds
+  Kokkos::View<long long, MemorySpace> total(
+      Kokkos::view_alloc(space, "ArborX::CrsGraphWrapper::arena_total"));
+
+  using PermutedPredicates =
+      PermutedData<Predicates, PermuteType, true /*AttachIndices*/>;
+  PermutedPredicates permuted_predicates = {predicates, permute};
+
+  using PermutedOffset = PermutedData<OffsetView, PermuteType>;
+  PermutedOffset permuted_offset = {offset, permute};
+
+  tree.query(space, permuted_predicates,
+             ArenaInsertGenerator<Callback, decltype(arena), CountView,
+                                  decltype(total)>{callback, arena, counts,
+                                                   total, arena_size},
+             ArborX::Experimental::TraversalPolicy().setPredicateSorting(
+                 false));
+
+  long long n_results;
+  Kokkos::deep_copy(space, n_results, total);
+  space.fence("ArborX::CrsGraphWrapper::single_pass (arena total on host)");
+
+  Kokkos::parallel_for(
+      "ArborX::CrsGraphWrapper::copy_counts_to_offsets",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int const i) { permuted_offset(i) = counts(i); });
+  KokkosExt::exclusive_scan(space, offset, offset, 0);
+
+  KokkosExt::reallocWithoutInitializing(space, out, n_results);
+
+  if (n_results <= arena_size)
+  {
+    // Compact the arena into CRS order, reusing counts as per-predicate
+    // write cursors (order within a predicate is not specified)
+    Kokkos::deep_copy(space, counts, 0);
+    Kokkos::parallel_for(
+        "ArborX::CrsGraphWrapper::compact_arena",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_results),
+        KOKKOS_LAMBDA(int i) {
+          auto const &entry = arena(i);
+          out(permuted_offset(entry.first) +
+              Kokkos::atomic_fetch_add(&counts(entry.first), 1)) =
+              entry.second;
+        });
+  }
+  else
+  {
+    // Arena overflowed; the counts are still exact, run the fill pass only
+    Kokkos::Profiling::pushRegion(
+        "ArborX::CrsGraphWrapper::single_pass::overflow_fill");
+
+    Kokkos::parallel_for(
+        "ArborX::CrsGraphWrapper::copy_offsets_to_counts",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int const i) { counts(i) = permuted_offset(i); });
+
+    tree.query(
+        space, permuted_predicates,
+        InsertGenerator<SecondPassTag, Callback, OutputView, CountView,
+                        PermutedOffset>{callback, out, counts, permuted_offset},
+        ArborX::Experimental::TraversalPolicy().setPredicateSorting(false));
+
+    Kokkos::Profiling::popRegion();
+  }
+
+  Kokkos::Profiling::popRegion();
+}
+
 template <typename Tag, typename ExecutionSpace, typename Predicates,
           typename OffsetView, typename OutView>
 std::enable_if_t<std::is_same_v<Tag, SpatialPredicateTag> ||
                  std::is_same_v<Tag, Experimental::OrderedSpatialPredicateTag>>
 allocateAndInitializeStorage(Tag, ExecutionSpace const &space,
                              Predicates const &predicates, OffsetView &offset,
-                             OutView &out, int buffer_size)
+                             OutView &out, int buffer_size, bool user_provided)
 {
   auto const n_queries = predicates.size();
-  KokkosExt::reallocWithoutInitializing(space, offset, n_queries + 1);
+  if (user_provided)
+    ARBORX_ASSERT(offset.extent(0) == n_queries + 1);
+  else
+    KokkosExt::reallocWithoutInitializing(space, offset, n_queries + 1);
 
   buffer_size = std::abs(buffer_size);
 
@@ -325,10 +665,14 @@ template <typename Tag, typename ExecutionSpace, typename Predicates,
 std::enable_if_t<std::is_same_v<Tag, NearestPredicateTag>>
 allocateAndInitializeStorage(Tag, ExecutionSpace const &space,
                              Predicates const &predicates, OffsetView &offset,
-                             OutView &out, int /*buffer_size*/)
+                             OutView &out, int /*buffer_size*/,
+                             bool user_provided)
 {
   auto const n_queries = predicates.size();
-  KokkosExt::reallocWithoutInitializing(space, offset, n_queries + 1);
+  if (user_provided)
+    ARBORX_ASSERT(offset.extent(0) == n_queries + 1);
+  else
+    KokkosExt::reallocWithoutInitializing(space, offset, n_queries + 1);
 
   Kokkos::parallel_for(
       "ArborX::CrsGraphWrapper::query::nearest::"
@@ -337,8 +681,77 @@ allocateAndInitializeStorage(Tag, ExecutionSpace const &space,
       KOKKOS_LAMBDA(int i) { offset(i) = getK(predicates(i)); });
   KokkosExt::exclusive_scan(space, offset, offset, 0);
 
-  KokkosExt::reallocWithoutInitializing(space, out,
-                                        KokkosExt::lastElement(space, offset));
+  auto const max_results = KokkosExt::lastElement(space, offset);
+  if (!user_provided)
+    KokkosExt::reallocWithoutInitializing(space, out, max_results);
+  else if ((decltype(max_results))out.extent(0) < max_results)
+    throw SearchException("user-provided output view capacity (" +
+                          std::to_string(out.extent(0)) +
+                          ") is too small to hold the " +
+                          std::to_string(max_results) +
+                          " requested nearest neighbors");
+}
+
+// Strided subset of the predicates used for density sampling. Attaches the
+// sample slot as data so a counting callback can find its slot.
+template <typename Predicates>
+struct SampledPredicates
+{
+  Predicates _predicates;
+  int _stride;
+  int _size;
+};
+
+template <typename Callback, typename CountView>
+struct SampleCountCallback
+{
+  Callback _callback;
+  CountView _counts;
+
+  template <typename Predicate, typename Value>
+  KOKKOS_FUNCTION void operator()(Predicate const &predicate,
+                                  Value const &value) const
+  {
+    auto const sample_index = getData(predicate);
+    _callback(getPredicate(predicate), value, [&](auto const &) {
+      Kokkos::atomic_increment(&_counts(sample_index));
+    });
+  }
+};
+
+// Estimate a per-query buffer size by running the counting traversal over a
+// small strided sample of the predicates. Returns 0 (count-then-fill) when
+// the sample produced no results, otherwise the sample mean with a 50%
+// margin as a soft preallocation hint.
+template <typename ExecutionSpace, typename Tree, typename Predicates,
+          typename Callback>
+int estimateBufferSize(ExecutionSpace const &space, Tree const &tree,
+                       Predicates const &predicates, Callback const &callback)
+{
+  using MemorySpace = typename Tree::memory_space;
+
+  int const n_queries = predicates.size();
+  constexpr int max_samples = 32;
+  int const stride = std::max(1, n_queries / max_samples);
+  int const n_samples = (n_queries + stride - 1) / stride;
+
+  Kokkos::View<int *, MemorySpace> counts(
+      Kokkos::view_alloc(space, "ArborX::CrsGraphWrapper::sample_counts"),
+      n_samples);
+  tree.query(space, SampledPredicates<Predicates>{predicates, stride,
+                                                  n_samples},
+             SampleCountCallback<Callback, decltype(counts)>{callback, counts},
+             Experimental::TraversalPolicy().setPredicateSorting(false));
+
+  int total;
+  Kokkos::parallel_reduce(
+      "ArborX::CrsGraphWrapper::reduce_sample_counts",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_samples),
+      KOKKOS_LAMBDA(int i, int &update) { update += counts(i); }, total);
+
+  if (total == 0)
+    return 0;
+  return (3 * total + 2 * n_samples - 1) / (2 * n_samples);
 }
 
 // Views are passed by reference here because internally Kokkos::realloc()
@@ -359,6 +772,70 @@ queryDispatch(Tag, Tree const &tree, ExecutionSpace const &space,
 
   check_valid_callback<typename Tree::value_type>(callback, predicates, out);
 
+  if (policy._deduplicate_predicates && !policy._user_provided_storage)
+  {
+    auto const deduplicated =
+        BatchedQueries<DeviceType>::deduplicatePredicates(space, predicates);
+    auto const &unique_indices = deduplicated.first;
+    auto const &duplicate_map = deduplicated.second;
+    int const n_queries = predicates.size();
+    int const n_unique = unique_indices.size();
+    if (n_unique < n_queries)
+    {
+      Kokkos::Profiling::ScopedRegion guard(
+          "ArborX::CrsGraphWrapper::query::deduplicated");
+
+      using Predicate = typename Predicates::value_type;
+      Kokkos::View<Predicate *, DeviceType> unique_predicates(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                             "ArborX::CrsGraphWrapper::unique_predicates"),
+          n_unique);
+      Kokkos::parallel_for(
+          "ArborX::CrsGraphWrapper::gather_unique_predicates",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_unique),
+          KOKKOS_LAMBDA(int i) {
+            unique_predicates(i) = predicates(unique_indices(i));
+          });
+
+      OutputView unique_out(out.label(), 0);
+      OffsetView unique_offset(offset.label(), 0);
+      auto relaxed_policy = policy;
+      relaxed_policy._deduplicate_predicates = false;
+      queryDispatch(Tag{}, tree, space, unique_predicates, callback,
+                    unique_out, unique_offset, relaxed_policy);
+
+      // Scatter the rows of the representatives to all their duplicates
+      KokkosExt::reallocWithoutInitializing(space, offset, n_queries + 1);
+      Kokkos::parallel_for(
+          "ArborX::CrsGraphWrapper::count_duplicated_results",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries + 1),
+          KOKKOS_LAMBDA(int i) {
+            if (i == n_queries)
+              offset(i) = 0;
+            else
+            {
+              auto const m = duplicate_map(i);
+              offset(i) = unique_offset(m + 1) - unique_offset(m);
+            }
+          });
+      KokkosExt::exclusive_scan(space, offset, offset, 0);
+      KokkosExt::reallocWithoutInitializing(space, out,
+                                            KokkosExt::lastElement(space,
+                                                                   offset));
+      Kokkos::parallel_for(
+          "ArborX::CrsGraphWrapper::scatter_duplicated_results",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+          KOKKOS_LAMBDA(int i) {
+            using OffsetValue = typename OffsetView::non_const_value_type;
+            auto const m = duplicate_map(i);
+            auto const count = offset(i + 1) - offset(i);
+            for (OffsetValue j = 0; j < count; ++j)
+              out(offset(i) + j) = unique_out(unique_offset(m) + j);
+          });
+      return;
+    }
+  }
+
   std::string profiling_prefix = "ArborX::CrsGraphWrapper::query::";
   if constexpr (std::is_same_v<Tag, SpatialPredicateTag>)
   {
@@ -379,16 +856,48 @@ queryDispatch(Tag, Tree const &tree, ExecutionSpace const &space,
   }
 
   Kokkos::Profiling::pushRegion(profiling_prefix);
+  Kokkos::Profiling::markEvent(profiling_prefix + "::num_predicates=" +
+                               std::to_string(predicates.size()));
+
+  bool single_pass = false;
+  int buffer_size = policy._buffer_size;
+  if constexpr (std::is_same_v<Tag, SpatialPredicateTag>)
+  {
+    single_pass = (policy._single_pass_arena > 0);
+    if (single_pass)
+    {
+      // The arena replaces the per-query buffers entirely; only the offset
+      // view needs to be set up below
+      buffer_size = 0;
+    }
+    else if (policy._adaptive_buffer_size)
+    {
+      Kokkos::Profiling::pushRegion(profiling_prefix +
+                                    "::estimate_buffer_size");
+      buffer_size = estimateBufferSize(space, tree, predicates, callback);
+      Kokkos::Profiling::popRegion();
+    }
+  }
+
+  bool const user_storage = policy._user_provided_storage;
+  if (user_storage)
+  {
+    // Caller-owned views rule out every scheme that reallocates: fall back to
+    // count-and-fill for spatial predicates, and turn the exact-k
+    // preallocation into a capacity check for nearest ones
+    single_pass = false;
+    buffer_size = 0;
+  }
 
   Kokkos::Profiling::pushRegion(profiling_prefix + "::init_and_alloc");
 
   allocateAndInitializeStorage(Tag{}, space, predicates, offset, out,
-                               policy._buffer_size);
+                               buffer_size, user_storage);
 
   Kokkos::Profiling::popRegion();
 
   auto buffer_status = (std::is_same<Tag, SpatialPredicateTag>{}
-                            ? toBufferStatus(policy._buffer_size)
+                            ? toBufferStatus(buffer_size)
                             : BufferStatus::PreallocationSoft);
 
   if (policy._sort_predicates)
@@ -401,90 +910,1056 @@ queryDispatch(Tag, Tree const &tree, ExecutionSpace const &space,
         scene_bounding_box{};
     using namespace Details;
     expand(scene_bounding_box, tree.bounds());
-    auto permute = Details::BatchedQueries<DeviceType>::
-        sortPredicatesAlongSpaceFillingCurve(space, Experimental::Morton32(),
-                                             scene_bounding_box, predicates);
+    auto sort = [&](auto const &curve) {
+      return Details::BatchedQueries<DeviceType>::
+          sortPredicatesAlongSpaceFillingCurve(space, curve, scene_bounding_box,
+                                               predicates);
+    };
+    auto permute =
+        (policy._sorting_curve == Experimental::SortingCurve::Hilbert)
+            ? sort(Experimental::Hilbert32())
+            : sort(Experimental::Morton32());
     Kokkos::Profiling::popRegion();
 
-    queryImpl(space, tree, predicates, callback, out, offset, permute,
-              buffer_status);
+    if (single_pass)
+      queryImplSinglePass(space, tree, predicates, callback, out, offset,
+                          permute, policy._single_pass_arena);
+    else
+      queryImpl(space, tree, predicates, callback, out, offset, permute,
+                buffer_status, user_storage);
   }
   else
   {
     Iota permute;
-    queryImpl(space, tree, predicates, callback, out, offset, permute,
-              buffer_status);
+    if (single_pass)
+      queryImplSinglePass(space, tree, predicates, callback, out, offset,
+                          permute, policy._single_pass_arena);
+    else
+      queryImpl(space, tree, predicates, callback, out, offset, permute,
+                buffer_status, user_storage);
   }
 
   Kokkos::Profiling::popRegion();
 }
 
-template <typename Tag, typename Tree, typename ExecutionSpace,
-          typename Predicates, typename Indices, typename Offset>
-inline std::enable_if_t<Kokkos::is_view_v<Indices> && Kokkos::is_view_v<Offset>>
-queryDispatch(Tag, Tree const &tree, ExecutionSpace const &space,
-              Predicates const &predicates, Indices &indices, Offset &offset,
-              Experimental::TraversalPolicy const &policy =
-                  Experimental::TraversalPolicy())
+template <typename PermutedCounts>
+struct CountingCallback
 {
-  queryDispatch(Tag{}, tree, space, predicates, DefaultCallback{}, indices,
-                offset, policy);
-}
+  PermutedCounts _counts;
+
+  template <typename Predicate, typename Value>
+  KOKKOS_FUNCTION void operator()(Predicate const &predicate,
+                                  Value const &) const
+  {
+    Kokkos::atomic_increment(&_counts(getData(predicate)));
+  }
+};
 
+// Two-pass query with every internal allocation carved out of a caller-owned
+// workspace (see Experimental::QueryWorkspace): the offset and output views
+// handed back alias workspace memory and nothing is allocated once the
+// workspace buffers have reached steady-state sizes. Selected by passing a
+// workspace to query() after the offset view.
+//
+// Repeat calls additionally switch from count-first to buffer-first
+// traversal on their own: the previous call's per-predicate result counts
+// (retained in the workspace) size the buffers of a single bounded
+// traversal, with a compaction data pass on underflow and a fill-pass
+// fallback on overflow. Setting a non-zero TraversalPolicy buffer size
+// disables the heuristic.
 template <typename Tag, typename Tree, typename ExecutionSpace,
           typename Predicates, typename OutputView, typename OffsetView,
           typename Callback>
-inline std::enable_if_t<is_tagged_post_callback<Callback>::value>
+std::enable_if_t<!is_tagged_post_callback<Callback>::value &&
+                 Kokkos::is_view_v<OutputView> && Kokkos::is_view_v<OffsetView>>
 queryDispatch(Tag, Tree const &tree, ExecutionSpace const &space,
               Predicates const &predicates, Callback const &callback,
               OutputView &out, OffsetView &offset,
+              Experimental::QueryWorkspace<typename Tree::memory_space>
+                  &workspace,
               Experimental::TraversalPolicy const &policy =
                   Experimental::TraversalPolicy())
 {
   using MemorySpace = typename Tree::memory_space;
+  using DeviceType = Kokkos::Device<ExecutionSpace, MemorySpace>;
+  using Workspace = Experimental::QueryWorkspace<MemorySpace>;
+  using OffsetValue = typename OffsetView::non_const_value_type;
+  using Value = typename OutputView::non_const_value_type;
 
-  Kokkos::View<typename Tree::value_type *, MemorySpace> indices(
-      "ArborX::CrsGraphWrapper::query::indices", 0);
-  queryDispatch(Tag{}, tree, space, predicates, DefaultCallback{}, indices,
-                offset, policy);
-  callback(predicates, offset, indices, out);
-}
+  check_valid_callback<typename Tree::value_type>(callback, predicates, out);
 
-template <typename Value, typename Callback, typename Predicates,
-          typename OutputView>
-std::enable_if_t<!Kokkos::is_view_v<Callback> &&
-                 !is_tagged_post_callback<Callback>::value>
-check_valid_callback_if_first_argument_is_not_a_view(
-    Callback const &callback, Predicates const &predicates,
-    OutputView const &out)
-{
-  check_valid_callback<Value>(callback, predicates, out);
-}
+  auto const n_queries = predicates.size();
 
-template <typename Value, typename Callback, typename Predicates,
-          typename OutputView>
-std::enable_if_t<!Kokkos::is_view_v<Callback> &&
-                 is_tagged_post_callback<Callback>::value>
-check_valid_callback_if_first_argument_is_not_a_view(Callback const &,
-                                                     Predicates const &,
-                                                     OutputView const &)
-{
-  // TODO
-}
+  Kokkos::Profiling::pushRegion("ArborX::CrsGraphWrapper::query_workspace");
+
+  offset = workspace.template scratch<OffsetValue>(Workspace::Offsets,
+                                                   n_queries + 1);
+  auto counts =
+      workspace.template scratch<OffsetValue>(Workspace::Counts, n_queries);
+
+  auto run = [&](auto const &permute) -> OffsetValue {
+    using Permute = std::decay_t<decltype(permute)>;
+    using PermutedPredicates = PermutedData<Predicates, Permute, true>;
+    using PermutedOffset = PermutedData<OffsetView, Permute>;
+    PermutedPredicates permuted_predicates = {predicates, permute};
+    PermutedOffset permuted_offset = {offset, permute};
+
+    Kokkos::deep_copy(space, counts, 0);
+
+    // When the previous call completed with the same number of predicates,
+    // the offset buffer still holds the exclusive scan of its per-predicate
+    // result counts. Use it as a buffer layout for a single bounded
+    // traversal: iterative applications issuing the same (or slowly
+    // drifting) predicates then get exact-fit results from one tree walk
+    // instead of a count pass followed by a fill pass. Predicates that
+    // drifted enough to overflow their buffer fall back to the fill pass
+    // below -- the counts gathered during the bounded pass are exact, so the
+    // first walk is never wasted.
+    bool const buffered =
+        (policy._buffer_size == 0 && workspace.hasCounts(n_queries));
+    if (buffered)
+    {
+      OffsetValue const n_capacity = KokkosExt::lastElement(space, offset);
+      out = workspace.template scratch<Value>(Workspace::Values, n_capacity);
 
-template <typename Value, typename View, typename Predicates,
-          typename OutputView>
-std::enable_if_t<Kokkos::is_view_v<View>>
-check_valid_callback_if_first_argument_is_not_a_view(View const &,
-                                                     Predicates const &,
-                                                     OutputView const &)
-{
-  // do nothing
-}
+      tree.query(
+          space, permuted_predicates,
+          InsertGenerator<FirstPassTag, Callback, OutputView, decltype(counts),
+                          PermutedOffset>{callback, out, counts,
+                                          permuted_offset},
+          ArborX::Experimental::TraversalPolicy().setPredicateSorting(false));
 
-} // namespace CrsGraphWrapperImpl
+      int overflow_int;
+      Kokkos::parallel_reduce(
+          "ArborX::CrsGraphWrapper::compute_overflow",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+          KOKKOS_LAMBDA(int i, int &update) {
+            auto const *const offset_ptr = &permuted_offset(i);
+            if (counts(i) > *(offset_ptr + 1) - *offset_ptr)
+              update = 1;
+          },
+          overflow_int);
+
+      if (overflow_int == 0)
+      {
+        OffsetValue n_results;
+        Kokkos::parallel_reduce(
+            "ArborX::CrsGraphWrapper::compute_underflow",
+            Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+            KOKKOS_LAMBDA(int i, OffsetValue &update) { update += counts(i); },
+            n_results);
+
+        if (n_results == n_capacity)
+        {
+          // No buffer over- or underflowed, so every count matched its
+          // buffer size: the offsets are already the exact scan
+          return n_results;
+        }
+
+        // Underflow: compact the results at the exact offsets. A data pass,
+        // no second tree walk.
+        auto preallocated_offset = workspace.template scratch<OffsetValue>(
+            Workspace::OffsetsScratch, n_queries + 1);
+        Kokkos::deep_copy(space, preallocated_offset, offset);
+
+        Kokkos::parallel_for(
+            "ArborX::CrsGraphWrapper::copy_counts_to_offsets",
+            Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+            KOKKOS_LAMBDA(int const i) { permuted_offset(i) = counts(i); });
+        KokkosExt::exclusive_scan(space, offset, offset, 0);
+
+        auto compact_out = workspace.template scratch<Value>(
+            Workspace::ValuesScratch, n_results);
+        auto const full_out = out;
+        Kokkos::parallel_for(
+            "ArborX::CrsGraphWrapper::copy_valid_values",
+            Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+            KOKKOS_LAMBDA(int i) {
+              auto const count = offset(i + 1) - offset(i);
+              for (OffsetValue j = 0; j < count; ++j)
+                compact_out(offset(i) + j) =
+                    full_out(preallocated_offset(i) + j);
+            });
+        out = compact_out;
+        return n_results;
+      }
+      // Overflow: fall through to the scan and the fill pass with the exact
+      // counts
+    }
+    else
+    {
+      // Count pass. The attached index is the position in the permuted
+      // ordering, matching the second pass convention, so counts are counted
+      // directly (no permutation wrapper).
+      tree.query(
+          space, permuted_predicates,
+          CountingCallback<decltype(counts)>{counts},
+          ArborX::Experimental::TraversalPolicy().setPredicateSorting(false));
+    }
+
+    Kokkos::parallel_for(
+        "ArborX::CrsGraphWrapper::copy_counts_to_offsets",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int const i) { permuted_offset(i) = counts(i); });
+    KokkosExt::exclusive_scan(space, offset, offset, 0);
+
+    OffsetValue const n_results = KokkosExt::lastElement(space, offset);
+
+    out = workspace.template scratch<Value>(Workspace::Values, n_results);
+
+    if (n_results == 0)
+      return n_results;
+
+    // Fill pass, reusing counts as write cursors
+    Kokkos::parallel_for(
+        "ArborX::CrsGraphWrapper::copy_offsets_to_counts",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int const i) { counts(i) = permuted_offset(i); });
+
+    tree.query(
+        space, permuted_predicates,
+        InsertGenerator<SecondPassTag, Callback, OutputView, decltype(counts),
+                        PermutedOffset>{callback, out, counts, permuted_offset},
+        ArborX::Experimental::TraversalPolicy().setPredicateSorting(false));
+
+    return n_results;
+  };
+
+  OffsetValue n_results;
+  if (policy._sort_predicates)
+  {
+    auto permute = workspace.template scratch<unsigned int>(
+        Workspace::Permutation, n_queries);
+
+    if (!(policy._replay_permutation && workspace.hasPermutation(n_queries)))
+    {
+      Kokkos::Profiling::pushRegion(
+          "ArborX::CrsGraphWrapper::query_workspace::compute_permutation");
+      using bounding_volume_type = std::decay_t<decltype(tree.bounds())>;
+      ExperimentalHyperGeometry::Box<
+          GeometryTraits::dimension_v<bounding_volume_type>,
+          typename GeometryTraits::coordinate_type<bounding_volume_type>::type>
+          scene_bounding_box{};
+      using namespace Details;
+      expand(scene_bounding_box, tree.bounds());
+
+      // Both 32-bit curves produce unsigned int codes
+      auto linear_ordering = workspace.template scratch<unsigned int>(
+          Workspace::LinearOrdering, n_queries);
+      auto sort = [&](auto const &curve) {
+        Details::BatchedQueries<DeviceType>::
+            sortPredicatesAlongSpaceFillingCurve(space, curve,
+                                                 scene_bounding_box, predicates,
+                                                 linear_ordering, permute);
+      };
+      if (policy._sorting_curve == Experimental::SortingCurve::Hilbert)
+        sort(Experimental::Hilbert32());
+      else
+        sort(Experimental::Morton32());
+      workspace.capturePermutation(n_queries);
+      Kokkos::Profiling::popRegion();
+    }
+
+    n_results = run(permute);
+  }
+  else
+  {
+    n_results = run(Iota{});
+  }
+
+  // Every exit of run() leaves the offset buffer holding the exact scan of
+  // this call's per-predicate counts, which the next call can size from
+  workspace.captureCounts(n_queries, n_results);
+
+  Kokkos::Profiling::popRegion();
+}
+
+// Fully asynchronous variant of the workspace query: every kernel, copy,
+// and buffer comes from or goes to the caller's execution space instance
+// and the function returns a QueryFuture without the host ever blocking.
+// The price is that capacities must be known up front: either the workspace
+// holds the counts of a previous call with the same number of predicates
+// (prime it with one synchronous workspace query), or a non-zero
+// TraversalPolicy buffer size caps every predicate. Capacities are hard --
+// wait() throws when one overflowed, but the counts recorded during the
+// bounded traversal are exact, so re-issuing the query then succeeds.
+// Predicates are only sorted when a captured permutation can be replayed
+// (see TraversalPolicy::setPermutationReplay); computing a fresh one would
+// synchronize. The output view is sized to capacity, not to the result
+// count: consume it through the offsets after wait().
+template <typename Tag, typename Tree, typename ExecutionSpace,
+          typename Predicates, typename OutputView, typename OffsetView,
+          typename Callback>
+std::enable_if_t<
+    !is_tagged_post_callback<Callback>::value &&
+        Kokkos::is_view_v<OutputView> && Kokkos::is_view_v<OffsetView>,
+    Experimental::QueryFuture<ExecutionSpace, typename Tree::memory_space>>
+queryDispatchAsync(Tag, Tree const &tree, ExecutionSpace const &space,
+                   Predicates const &predicates, Callback const &callback,
+                   OutputView &out, OffsetView &offset,
+                   Experimental::QueryWorkspace<typename Tree::memory_space>
+                       &workspace,
+                   Experimental::TraversalPolicy const &policy =
+                       Experimental::TraversalPolicy())
+{
+  using MemorySpace = typename Tree::memory_space;
+  using Workspace = Experimental::QueryWorkspace<MemorySpace>;
+  using OffsetValue = typename OffsetView::non_const_value_type;
+  using Value = typename OutputView::non_const_value_type;
+
+  check_valid_callback<typename Tree::value_type>(callback, predicates, out);
+
+  auto const n_queries = predicates.size();
+
+  Kokkos::Profiling::pushRegion("ArborX::CrsGraphWrapper::query_async");
+
+  offset = workspace.template scratch<OffsetValue>(Workspace::Offsets,
+                                                   n_queries + 1);
+  auto counts =
+      workspace.template scratch<OffsetValue>(Workspace::Counts, n_queries);
+  auto status = workspace.template scratch<int>(Workspace::Status, 2);
+
+  // The sign of the buffer size does not matter here: asynchronous
+  // capacities are always hard
+  int const buffer_size = std::abs(policy._buffer_size);
+  bool const have_layout = (buffer_size == 0 && workspace.hasCounts(n_queries));
+  ARBORX_ASSERT(have_layout || buffer_size > 0);
+
+  size_t n_capacity;
+  if (have_layout)
+  {
+    // The offsets of the previous call are still in place and are the
+    // capacity layout; nothing to do
+    n_capacity = workspace.totalCount();
+  }
+  else
+  {
+    n_capacity = n_queries * (size_t)buffer_size;
+    Kokkos::parallel_for(
+        "ArborX::CrsGraphWrapper::query_async::init_offsets",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries + 1),
+        KOKKOS_LAMBDA(int i) { offset(i) = (OffsetValue)i * buffer_size; });
+  }
+
+  out = workspace.template scratch<Value>(Workspace::Values, n_capacity);
+
+  // In flux until wait() recaptures them from the device
+  workspace.invalidateCounts();
+
+  Kokkos::deep_copy(space, counts, 0);
+  Kokkos::deep_copy(space, status, 0);
+
+  auto enqueue = [&](auto const &permute) {
+    using Permute = std::decay_t<decltype(permute)>;
+    using PermutedPredicates = PermutedData<Predicates, Permute, true>;
+    using PermutedOffset = PermutedData<OffsetView, Permute>;
+    PermutedPredicates permuted_predicates = {predicates, permute};
+    PermutedOffset permuted_offset = {offset, permute};
+
+    auto const full_out = out;
+    tree.query(
+        space, permuted_predicates,
+        InsertGenerator<FirstPassTag, Callback, OutputView, decltype(counts),
+                        PermutedOffset>{callback, full_out, counts,
+                                        permuted_offset},
+        ArborX::Experimental::TraversalPolicy().setPredicateSorting(false));
+
+    // Record overflow on the device for wait() to inspect
+    Kokkos::parallel_for(
+        "ArborX::CrsGraphWrapper::query_async::check_overflow",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int i) {
+          auto const *const offset_ptr = &permuted_offset(i);
+          if (counts(i) > *(offset_ptr + 1) - *offset_ptr)
+            Kokkos::atomic_store(&status(0), 1);
+        });
+
+    // Rewrite the offsets to the scan of the actual counts and compact.
+    // Unconditional, unlike the synchronous path: whether every buffer came
+    // out exactly full cannot be known without reading back.
+    auto preallocated_offset = workspace.template scratch<OffsetValue>(
+        Workspace::OffsetsScratch, n_queries + 1);
+    Kokkos::deep_copy(space, preallocated_offset, offset);
+
+    Kokkos::parallel_for(
+        "ArborX::CrsGraphWrapper::copy_counts_to_offsets",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int const i) { permuted_offset(i) = counts(i); });
+    KokkosExt::exclusive_scan(space, offset, offset, 0);
+
+    auto compact_out = workspace.template scratch<Value>(
+        Workspace::ValuesScratch, n_capacity);
+    Kokkos::parallel_for(
+        "ArborX::CrsGraphWrapper::copy_valid_values",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int i) {
+          auto const count = offset(i + 1) - offset(i);
+          for (OffsetValue j = 0; j < count; ++j)
+            compact_out(offset(i) + j) = full_out(preallocated_offset(i) + j);
+        });
+    out = compact_out;
+
+    // Total result count for wait() to recapture. The completion handle
+    // stores it as int; a wider total raises the overflow flag rather than
+    // truncating silently (use the synchronous workspace path for runs
+    // expected to exceed 2^31 results).
+    Kokkos::parallel_for(
+        "ArborX::CrsGraphWrapper::query_async::record_total",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, 1),
+        KOKKOS_LAMBDA(int) {
+          auto const total = offset(n_queries);
+          if constexpr (sizeof(OffsetValue) > sizeof(int))
+            if (total > (OffsetValue)KokkosExt::ArithmeticTraits::finite_max<
+                            int>::value)
+              Kokkos::atomic_store(&status(0), 1);
+          status(1) = (int)total;
+        });
+  };
+
+  if (policy._sort_predicates && policy._replay_permutation &&
+      workspace.hasPermutation(n_queries))
+  {
+    auto permute = workspace.template scratch<unsigned int>(
+        Workspace::Permutation, n_queries);
+    enqueue(permute);
+  }
+  else
+  {
+    enqueue(Iota{});
+  }
+
+  Kokkos::Profiling::popRegion();
+
+  return {space, status, &workspace, n_queries};
+}
+
+// Count-only variant of the two-pass query: runs just the counting
+// traversal and stops, skipping the output allocation and the fill pass
+// entirely. counts(i) receives the number of matches of predicate i.
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename CountView>
+void queryCount(Tree const &tree, ExecutionSpace const &space,
+                Predicates const &predicates, CountView &counts,
+                Experimental::TraversalPolicy const &policy =
+                    Experimental::TraversalPolicy())
+{
+  using MemorySpace = typename Tree::memory_space;
+  using DeviceType = Kokkos::Device<ExecutionSpace, MemorySpace>;
+
+  auto const n_queries = predicates.size();
+
+  Kokkos::Profiling::pushRegion("ArborX::CrsGraphWrapper::query_count");
+
+  KokkosExt::reallocWithoutInitializing(space, counts, n_queries);
+  Kokkos::deep_copy(space, counts, 0);
+
+  auto run = [&](auto const &permute) {
+    using Permute = std::decay_t<decltype(permute)>;
+    using PermutedPredicates = PermutedData<Predicates, Permute, true>;
+    using PermutedCounts = PermutedData<CountView, Permute>;
+    tree.query(space, PermutedPredicates{predicates, permute},
+               CountingCallback<PermutedCounts>{{counts, permute}},
+               Experimental::TraversalPolicy().setPredicateSorting(false));
+  };
+
+  if (policy._sort_predicates)
+  {
+    Kokkos::Profiling::pushRegion(
+        "ArborX::CrsGraphWrapper::query_count::compute_permutation");
+    using bounding_volume_type = std::decay_t<decltype(tree.bounds())>;
+    ExperimentalHyperGeometry::Box<
+        GeometryTraits::dimension_v<bounding_volume_type>,
+        typename GeometryTraits::coordinate_type<bounding_volume_type>::type>
+        scene_bounding_box{};
+    expand(scene_bounding_box, tree.bounds());
+    auto sort = [&](auto const &curve) {
+      return BatchedQueries<DeviceType>::sortPredicatesAlongSpaceFillingCurve(
+          space, curve, scene_bounding_box, predicates);
+    };
+    auto permute =
+        (policy._sorting_curve == Experimental::SortingCurve::Hilbert)
+            ? sort(Experimental::Hilbert32())
+            : sort(Experimental::Morton32());
+    Kokkos::Profiling::popRegion();
+
+    run(permute);
+  }
+  else
+  {
+    run(Iota{});
+  }
+
+  Kokkos::Profiling::popRegion();
+}
+
+template <typename PermutedHits>
+struct AnyHitCallback
+{
+  PermutedHits _hits;
+
+  template <typename Predicate, typename Value>
+  KOKKOS_FUNCTION auto operator()(Predicate const &predicate,
+                                  Value const &) const
+  {
+    _hits(getData(predicate)) = true;
+    // The first match answers the question; stop this predicate's traversal
+    return CallbackTreeTraversalControl::early_exit;
+  }
+};
+
+// Any-hit variant: hits(i) receives whether predicate i matches anything.
+// Each predicate's traversal terminates at its first match, so dense scenes
+// pay for one leaf test instead of a full enumeration.
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename HitView>
+void queryAny(Tree const &tree, ExecutionSpace const &space,
+              Predicates const &predicates, HitView &hits,
+              Experimental::TraversalPolicy const &policy =
+                  Experimental::TraversalPolicy())
+{
+  using MemorySpace = typename Tree::memory_space;
+  using DeviceType = Kokkos::Device<ExecutionSpace, MemorySpace>;
+
+  auto const n_queries = predicates.size();
+
+  Kokkos::Profiling::pushRegion("ArborX::CrsGraphWrapper::query_any");
+
+  KokkosExt::reallocWithoutInitializing(space, hits, n_queries);
+  Kokkos::deep_copy(space, hits, false);
+
+  auto run = [&](auto const &permute) {
+    using Permute = std::decay_t<decltype(permute)>;
+    using PermutedPredicates = PermutedData<Predicates, Permute, true>;
+    using PermutedHits = PermutedData<HitView, Permute>;
+    tree.query(space, PermutedPredicates{predicates, permute},
+               AnyHitCallback<PermutedHits>{{hits, permute}},
+               Experimental::TraversalPolicy().setPredicateSorting(false));
+  };
+
+  if (policy._sort_predicates)
+  {
+    Kokkos::Profiling::pushRegion(
+        "ArborX::CrsGraphWrapper::query_any::compute_permutation");
+    using bounding_volume_type = std::decay_t<decltype(tree.bounds())>;
+    ExperimentalHyperGeometry::Box<
+        GeometryTraits::dimension_v<bounding_volume_type>,
+        typename GeometryTraits::coordinate_type<bounding_volume_type>::type>
+        scene_bounding_box{};
+    expand(scene_bounding_box, tree.bounds());
+    auto sort = [&](auto const &curve) {
+      return BatchedQueries<DeviceType>::sortPredicatesAlongSpaceFillingCurve(
+          space, curve, scene_bounding_box, predicates);
+    };
+    auto permute =
+        (policy._sorting_curve == Experimental::SortingCurve::Hilbert)
+            ? sort(Experimental::Hilbert32())
+            : sort(Experimental::Morton32());
+    Kokkos::Profiling::popRegion();
+
+    run(permute);
+  }
+  else
+  {
+    run(Iota{});
+  }
+
+  Kokkos::Profiling::popRegion();
+}
+
+template <typename Functor, typename PermutedResults>
+struct ReductionCallback
+{
+  Functor _functor;
+  PermutedResults _results;
+
+  template <typename Predicate, typename Value>
+  KOKKOS_FUNCTION void operator()(Predicate const &predicate,
+                                  Value const &value) const
+  {
+    _functor(predicate, value, _results(getData(predicate)));
+  }
+};
+
+// Reduction variant: folds every value matching predicate i into result(i)
+// during the traversal itself, with no output materialization and a single
+// tree walk. The functor is invoked as functor(predicate, value, update),
+// where update references result(i); a predicate is walked by one thread,
+// so plain (non-atomic) updates are safe. The results view must be
+// pre-sized and pre-filled with the reduction identity by the caller --
+// that keeps the identity out of the interface (zero for sums, the largest
+// float for min-distance folds) and lets batched calls accumulate.
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename Functor, typename ResultView>
+void queryReduce(Tree const &tree, ExecutionSpace const &space,
+                 Predicates const &predicates, Functor const &functor,
+                 ResultView &results,
+                 Experimental::TraversalPolicy const &policy =
+                     Experimental::TraversalPolicy())
+{
+  using MemorySpace = typename Tree::memory_space;
+  using DeviceType = Kokkos::Device<ExecutionSpace, MemorySpace>;
+
+  auto const n_queries = predicates.size();
+  ARBORX_ASSERT(results.size() == n_queries);
+
+  Kokkos::Profiling::pushRegion("ArborX::CrsGraphWrapper::query_reduce");
+
+  auto run = [&](auto const &permute) {
+    using Permute = std::decay_t<decltype(permute)>;
+    using PermutedPredicates = PermutedData<Predicates, Permute, true>;
+    using PermutedResults = PermutedData<ResultView, Permute>;
+    tree.query(space, PermutedPredicates{predicates, permute},
+               ReductionCallback<Functor, PermutedResults>{functor,
+                                                           {results, permute}},
+               Experimental::TraversalPolicy().setPredicateSorting(false));
+  };
+
+  if (policy._sort_predicates)
+  {
+    Kokkos::Profiling::pushRegion(
+        "ArborX::CrsGraphWrapper::query_reduce::compute_permutation");
+    using bounding_volume_type = std::decay_t<decltype(tree.bounds())>;
+    ExperimentalHyperGeometry::Box<
+        GeometryTraits::dimension_v<bounding_volume_type>,
+        typename GeometryTraits::coordinate_type<bounding_volume_type>::type>
+        scene_bounding_box{};
+    expand(scene_bounding_box, tree.bounds());
+    auto sort = [&](auto const &curve) {
+      return BatchedQueries<DeviceType>::sortPredicatesAlongSpaceFillingCurve(
+          space, curve, scene_bounding_box, predicates);
+    };
+    auto permute =
+        (policy._sorting_curve == Experimental::SortingCurve::Hilbert)
+            ? sort(Experimental::Hilbert32())
+            : sort(Experimental::Morton32());
+    Kokkos::Profiling::popRegion();
+
+    run(permute);
+  }
+  else
+  {
+    run(Iota{});
+  }
+
+  Kokkos::Profiling::popRegion();
+}
+
+template <typename Tree, typename PermutedPredicates, typename Functor,
+          typename PermutedResults>
+struct TeamReductionQuery
+{
+  Tree _tree;
+  PermutedPredicates _predicates;
+  Functor _functor;
+  PermutedResults _results;
+
+  template <typename TeamMember>
+  KOKKOS_FUNCTION void operator()(TeamMember const &member) const
+  {
+    using Result = std::decay_t<decltype(_results(0))>;
+
+    auto const i = member.league_rank();
+    auto const &predicate = _predicates(i);
+
+    // Every member folds its share of the matches into a private partial;
+    // value initialization provides the sum identity
+    Result partial{};
+    auto accumulate = [&](auto const &p, auto const &value) {
+      _functor(p, value, partial);
+    };
+    _tree.query(Experimental::PerTeam{}, member, predicate, accumulate);
+
+    member.team_reduce(Kokkos::Sum<Result>(partial));
+    Kokkos::single(Kokkos::PerTeam(member), [&] { _results(i) += partial; });
+  }
+};
+
+// Team-cooperative flavor of queryReduce for high-multiplicity predicates:
+// a whole team walks each predicate, with the members claiming disjoint
+// subtrees (see the PerTeam in-kernel query), so a predicate matching
+// thousands of leaves no longer funnels all callback work through its
+// single owning thread. Each member folds its matches into a private
+// partial and the partials are combined with a team reduction before the
+// per-predicate result is committed -- which restricts the fold to a sum:
+// the result type must value-initialize to the identity and define
+// operator+. results must be pre-sized and pre-filled by the caller, as
+// with queryReduce, and the commit accumulates into the existing entry.
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename Functor, typename ResultView>
+void queryReduceTeam(Tree const &tree, ExecutionSpace const &space,
+                     Predicates const &predicates, Functor const &functor,
+                     ResultView &results,
+                     Experimental::TraversalPolicy const &policy =
+                         Experimental::TraversalPolicy())
+{
+  using MemorySpace = typename Tree::memory_space;
+  using DeviceType = Kokkos::Device<ExecutionSpace, MemorySpace>;
+
+  auto const n_queries = predicates.size();
+  ARBORX_ASSERT(results.size() == n_queries);
+
+  Kokkos::Profiling::pushRegion("ArborX::CrsGraphWrapper::query_reduce_team");
+
+  auto run = [&](auto const &permute) {
+    using Permute = std::decay_t<decltype(permute)>;
+    using PermutedPredicates = PermutedData<Predicates, Permute>;
+    using PermutedResults = PermutedData<ResultView, Permute>;
+    using TeamPolicy = Kokkos::TeamPolicy<ExecutionSpace>;
+    Kokkos::parallel_for(
+        "ArborX::CrsGraphWrapper::query_reduce_team::traverse",
+        TeamPolicy(space, n_queries, Kokkos::AUTO),
+        TeamReductionQuery<Tree, PermutedPredicates, Functor, PermutedResults>{
+            tree, {predicates, permute}, functor, {results, permute}});
+  };
+
+  if (policy._sort_predicates)
+  {
+    Kokkos::Profiling::pushRegion(
+        "ArborX::CrsGraphWrapper::query_reduce_team::compute_permutation");
+    using bounding_volume_type = std::decay_t<decltype(tree.bounds())>;
+    ExperimentalHyperGeometry::Box<
+        GeometryTraits::dimension_v<bounding_volume_type>,
+        typename GeometryTraits::coordinate_type<bounding_volume_type>::type>
+        scene_bounding_box{};
+    expand(scene_bounding_box, tree.bounds());
+    auto sort = [&](auto const &curve) {
+      return BatchedQueries<DeviceType>::sortPredicatesAlongSpaceFillingCurve(
+          space, curve, scene_bounding_box, predicates);
+    };
+    auto permute =
+        (policy._sorting_curve == Experimental::SortingCurve::Hilbert)
+            ? sort(Experimental::Hilbert32())
+            : sort(Experimental::Morton32());
+    Kokkos::Profiling::popRegion();
+
+    run(permute);
+  }
+  else
+  {
+    run(Iota{});
+  }
+
+  Kokkos::Profiling::popRegion();
+}
+
+template <typename OutView, typename CountView, typename Permute>
+struct DenseNearestCallback
+{
+  OutView _out;
+  CountView _counts;
+  Permute _permute;
+
+  template <typename Predicate, typename Value>
+  KOKKOS_FUNCTION void operator()(Predicate const &predicate,
+                                  Value const &value) const
+  {
+    auto const i = _permute(getData(predicate));
+    // A single thread walks each predicate, so the slot bump needs no atomic
+    _out(i, _counts(i)++) = value;
+  }
+};
+
+// Dense-output nearest variant: the results of predicate i go into row i of
+// a rank-2 (n_queries, k) view. Every row is bounded by k, so the offsets
+// scan of the CRS layout buys nothing here; skipping it saves the scan and
+// hands consumers coalesced fixed-stride rows with no indirection. Slots
+// are filled in traversal order, and counts(i) receives the number of
+// filled entries -- smaller than getK(predicate) only when the tree holds
+// fewer values.
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename OutView, typename CountView>
+void queryNearestDense(Tree const &tree, ExecutionSpace const &space,
+                       Predicates const &predicates, OutView const &out,
+                       CountView &counts,
+                       Experimental::TraversalPolicy const &policy =
+                           Experimental::TraversalPolicy())
+{
+  static_assert(OutView::rank == 2);
+
+  using MemorySpace = typename Tree::memory_space;
+  using DeviceType = Kokkos::Device<ExecutionSpace, MemorySpace>;
+
+  auto const n_queries = predicates.size();
+  ARBORX_ASSERT(out.extent(0) == n_queries);
+
+  Kokkos::Profiling::pushRegion("ArborX::CrsGraphWrapper::query_nearest_dense");
+
+  int max_k;
+  Kokkos::parallel_reduce(
+      "ArborX::CrsGraphWrapper::query_nearest_dense::max_k",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int i, int &update) {
+        auto const k = getK(predicates(i));
+        if (k > update)
+          update = k;
+      },
+      Kokkos::Max<int>(max_k));
+  if (max_k > (int)out.extent(1))
+    throw SearchException("output view row length (" +
+                          std::to_string(out.extent(1)) +
+                          ") is too small to hold the " +
+                          std::to_string(max_k) +
+                          " requested nearest neighbors");
+
+  KokkosExt::reallocWithoutInitializing(space, counts, n_queries);
+  Kokkos::deep_copy(space, counts, 0);
+
+  auto run = [&](auto const &permute) {
+    using Permute = std::decay_t<decltype(permute)>;
+    using PermutedPredicates = PermutedData<Predicates, Permute, true>;
+    tree.query(space, PermutedPredicates{predicates, permute},
+               DenseNearestCallback<OutView, CountView, Permute>{out, counts,
+                                                                 permute},
+               Experimental::TraversalPolicy().setPredicateSorting(false));
+  };
+
+  if (policy._sort_predicates)
+  {
+    Kokkos::Profiling::pushRegion(
+        "ArborX::CrsGraphWrapper::query_nearest_dense::compute_permutation");
+    using bounding_volume_type = std::decay_t<decltype(tree.bounds())>;
+    ExperimentalHyperGeometry::Box<
+        GeometryTraits::dimension_v<bounding_volume_type>,
+        typename GeometryTraits::coordinate_type<bounding_volume_type>::type>
+        scene_bounding_box{};
+    expand(scene_bounding_box, tree.bounds());
+    auto sort = [&](auto const &curve) {
+      return BatchedQueries<DeviceType>::sortPredicatesAlongSpaceFillingCurve(
+          space, curve, scene_bounding_box, predicates);
+    };
+    auto permute =
+        (policy._sorting_curve == Experimental::SortingCurve::Hilbert)
+            ? sort(Experimental::Hilbert32())
+            : sort(Experimental::Morton32());
+    Kokkos::Profiling::popRegion();
+
+    run(permute);
+  }
+  else
+  {
+    run(Iota{});
+  }
+
+  Kokkos::Profiling::popRegion();
+}
+
+// Heterogeneous batch variant: a spatial batch and a nearest batch are
+// served over the same tree by shared launches instead of two back-to-back
+// query() calls. Both batches are projected onto one space-filling curve and
+// sorted together, and single count and fill kernels cover the union through
+// per-thread traversals, so the smaller batch no longer pays a full set of
+// launches of its own. Spatial predicate i fills row i of the CRS output;
+// nearest predicate j fills row n_spatial + j.
+template <typename Tree, typename ExecutionSpace, typename SpatialPredicates,
+          typename NearestPredicates, typename OutputView, typename OffsetView>
+void queryMixed(Tree const &tree, ExecutionSpace const &space,
+                SpatialPredicates const &spatial_predicates,
+                NearestPredicates const &nearest_predicates, OutputView &out,
+                OffsetView &offset,
+                Experimental::TraversalPolicy const &policy =
+                    Experimental::TraversalPolicy())
+{
+  using MemorySpace = typename Tree::memory_space;
+  using DeviceType = Kokkos::Device<ExecutionSpace, MemorySpace>;
+  using OffsetValue = typename OffsetView::non_const_value_type;
+
+  int const n_spatial = spatial_predicates.size();
+  int const n_total = n_spatial + (int)nearest_predicates.size();
+
+  Kokkos::Profiling::pushRegion("ArborX::CrsGraphWrapper::query_mixed");
+
+  Kokkos::View<unsigned int *, MemorySpace> permute(
+      "ArborX::CrsGraphWrapper::query_mixed::permute", 0);
+  if (policy._sort_predicates)
+  {
+    Kokkos::Profiling::pushRegion(
+        "ArborX::CrsGraphWrapper::query_mixed::compute_permutation");
+    using bounding_volume_type = std::decay_t<decltype(tree.bounds())>;
+    ExperimentalHyperGeometry::Box<
+        GeometryTraits::dimension_v<bounding_volume_type>,
+        typename GeometryTraits::coordinate_type<bounding_volume_type>::type>
+        scene_bounding_box{};
+    expand(scene_bounding_box, tree.bounds());
+    auto sort = [&](auto const &curve) {
+      return BatchedQueries<DeviceType>::
+          sortMixedPredicatesAlongSpaceFillingCurve(space, curve,
+                                                    scene_bounding_box,
+                                                    spatial_predicates,
+                                                    nearest_predicates);
+    };
+    permute = (policy._sorting_curve == Experimental::SortingCurve::Hilbert)
+                  ? sort(Experimental::Hilbert32())
+                  : sort(Experimental::Morton32());
+    Kokkos::Profiling::popRegion();
+  }
+  else
+  {
+    KokkosExt::reallocWithoutInitializing(space, permute, n_total);
+    KokkosExt::iota(space, permute);
+  }
+
+  KokkosExt::reallocWithoutInitializing(space, offset, n_total + 1);
+
+  // One thread walks one predicate of either kind, so the counts need no
+  // atomics and the fill cursors stay thread-local
+  Kokkos::parallel_for(
+      "ArborX::CrsGraphWrapper::query_mixed::count",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_total),
+      KOKKOS_LAMBDA(int t) {
+        int const p = (int)permute(t);
+        OffsetValue count = 0;
+        auto count_hit = [&](auto const &, auto const &) { ++count; };
+        if (p < n_spatial)
+          tree.query(Experimental::PerThread{}, spatial_predicates(p),
+                     count_hit);
+        else
+          tree.query(Experimental::PerThread{},
+                     nearest_predicates(p - n_spatial), count_hit);
+        offset(p) = count;
+      });
+  KokkosExt::exclusive_scan(space, offset, offset, 0);
+
+  OffsetValue const n_results = KokkosExt::lastElement(space, offset);
+  KokkosExt::reallocWithoutInitializing(space, out, n_results);
+
+  Kokkos::parallel_for(
+      "ArborX::CrsGraphWrapper::query_mixed::fill",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_total),
+      KOKKOS_LAMBDA(int t) {
+        int const p = (int)permute(t);
+        auto cursor = offset(p);
+        auto insert = [&](auto const &, auto const &value) {
+          out(cursor++) = value;
+        };
+        if (p < n_spatial)
+          tree.query(Experimental::PerThread{}, spatial_predicates(p), insert);
+        else
+          tree.query(Experimental::PerThread{},
+                     nearest_predicates(p - n_spatial), insert);
+      });
+
+  Kokkos::Profiling::popRegion();
+}
+
+template <typename Tag, typename Tree, typename ExecutionSpace,
+          typename Predicates, typename Indices, typename Offset>
+inline std::enable_if_t<Kokkos::is_view_v<Indices> && Kokkos::is_view_v<Offset>>
+queryDispatch(Tag, Tree const &tree, ExecutionSpace const &space,
+              Predicates const &predicates, Indices &indices, Offset &offset,
+              Experimental::TraversalPolicy const &policy =
+                  Experimental::TraversalPolicy())
+{
+  queryDispatch(Tag{}, tree, space, predicates, DefaultCallback{}, indices,
+                offset, policy);
+}
+
+template <typename Tag, typename Tree, typename ExecutionSpace,
+          typename Predicates, typename Indices, typename Offset>
+inline std::enable_if_t<Kokkos::is_view_v<Indices> && Kokkos::is_view_v<Offset>>
+queryDispatch(Tag, Tree const &tree, ExecutionSpace const &space,
+              Predicates const &predicates, Indices &indices, Offset &offset,
+              Experimental::QueryWorkspace<typename Tree::memory_space>
+                  &workspace,
+              Experimental::TraversalPolicy const &policy =
+                  Experimental::TraversalPolicy())
+{
+  queryDispatch(Tag{}, tree, space, predicates, DefaultCallback{}, indices,
+                offset, workspace, policy);
+}
+
+template <typename Tag, typename Tree, typename ExecutionSpace,
+          typename Predicates, typename Indices, typename Offset>
+inline std::enable_if_t<
+    Kokkos::is_view_v<Indices> && Kokkos::is_view_v<Offset>,
+    Experimental::QueryFuture<ExecutionSpace, typename Tree::memory_space>>
+queryDispatchAsync(Tag, Tree const &tree, ExecutionSpace const &space,
+                   Predicates const &predicates, Indices &indices,
+                   Offset &offset,
+                   Experimental::QueryWorkspace<typename Tree::memory_space>
+                       &workspace,
+                   Experimental::TraversalPolicy const &policy =
+                       Experimental::TraversalPolicy())
+{
+  return queryDispatchAsync(Tag{}, tree, space, predicates, DefaultCallback{},
+                            indices, offset, workspace, policy);
+}
+
+template <typename Tag, typename Tree, typename ExecutionSpace,
+          typename Predicates, typename OutputView, typename OffsetView,
+          typename Callback>
+inline std::enable_if_t<is_tagged_post_callback<Callback>::value>
+queryDispatch(Tag, Tree const &tree, ExecutionSpace const &space,
+              Predicates const &predicates, Callback const &callback,
+              OutputView &out, OffsetView &offset,
+              Experimental::TraversalPolicy const &policy =
+                  Experimental::TraversalPolicy())
+{
+  using MemorySpace = typename Tree::memory_space;
+
+  Kokkos::View<typename Tree::value_type *, MemorySpace> indices(
+      "ArborX::CrsGraphWrapper::query::indices", 0);
+  queryDispatch(Tag{}, tree, space, predicates, DefaultCallback{}, indices,
+                offset, policy);
+  callback(predicates, offset, indices, out);
+}
+
+template <typename Value, typename Callback, typename Predicates,
+          typename OutputView>
+std::enable_if_t<!Kokkos::is_view_v<Callback> &&
+                 !is_tagged_post_callback<Callback>::value>
+check_valid_callback_if_first_argument_is_not_a_view(
+    Callback const &callback, Predicates const &predicates,
+    OutputView const &out)
+{
+  check_valid_callback<Value>(callback, predicates, out);
+}
+
+template <typename Value, typename Callback, typename Predicates,
+          typename OutputView>
+std::enable_if_t<!Kokkos::is_view_v<Callback> &&
+                 is_tagged_post_callback<Callback>::value>
+check_valid_callback_if_first_argument_is_not_a_view(Callback const &,
+                                                     Predicates const &,
+                                                     OutputView const &)
+{
+  // TODO
+}
+
+template <typename Value, typename View, typename Predicates,
+          typename OutputView>
+std::enable_if_t<Kokkos::is_view_v<View>>
+check_valid_callback_if_first_argument_is_not_a_view(View const &,
+                                                     Predicates const &,
+                                                     OutputView const &)
+{
+  // do nothing
+}
+
+} // namespace CrsGraphWrapperImpl
+
+} // namespace Details
+
+template <typename Predicates>
+struct AccessTraits<
+    Details::CrsGraphWrapperImpl::SampledPredicates<Predicates>, PredicatesTag>
+{
+  using SampledPredicates =
+      Details::CrsGraphWrapperImpl::SampledPredicates<Predicates>;
+
+  using memory_space = typename Predicates::memory_space;
+
+  KOKKOS_FUNCTION static std::size_t size(SampledPredicates const &sampled)
+  {
+    return sampled._size;
+  }
+
+  KOKKOS_FUNCTION static auto get(SampledPredicates const &sampled,
+                                  std::size_t index)
+  {
+    return attach(sampled._predicates(index * sampled._stride), (int)index);
+  }
+};
 
-} // namespace Details
 } // namespace ArborX
 
 #endif
@@ -13,7 +13,10 @@
 #define ARBORX_DETAILS_DENDROGRAM_HPP
 
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp> // iota
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsMinimumSpanningTree.hpp> // computeParents, chain values
 #include <ArborX_DetailsUnionFind.hpp>
+#include <ArborX_DetailsWeightedEdge.hpp>
 
 #include <Kokkos_Core.hpp>
 
@@ -116,6 +119,184 @@ void dendrogramUnionFind(
   Kokkos::Profiling::popRegion();
 }
 
+// Fully parallel device dendrogram construction for an already computed
+// edge list (sorted by increasing weight), following the alpha-tree / chain
+// decomposition scheme that the Boruvka-fused dendrogram uses: the tree is
+// contracted in Boruvka rounds where every component picks its smallest
+// incident edge, the edges contracted in round r learn in round r + 1 which
+// alpha edge (and which of its sides) they hang off, and computeParents()
+// resolves the per-chain orderings in one sort. This replaces the
+// sequential host union-find sweep, whose single thread dominates the total
+// time on large skewed trees.
+//
+// Equal-weight edges are ranked by their position in the sorted order, so
+// their placement within a chain may differ from the union-find one; the
+// dendrogram is equivalent up to such reorderings.
+template <typename ExecutionSpace, typename MemorySpace>
+void dendrogramAlphaTree(
+    ExecutionSpace const &exec_space,
+    Kokkos::View<WeightedEdge const *, MemorySpace> sorted_edges,
+    Kokkos::View<int *, MemorySpace> &parents)
+{
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::Dendrogram::dendrogram_alpha_tree");
+
+  int const num_edges = sorted_edges.size();
+  int const num_vertices = num_edges + 1;
+
+  if (num_edges == 0)
+  {
+    Kokkos::deep_copy(exec_space, parents, -1);
+    return;
+  }
+
+  // A vertex enters the dendrogram through its smallest incident edge
+  auto vertex_parents = Kokkos::subview(
+      parents, std::make_pair(num_edges, num_edges + num_vertices));
+  Kokkos::deep_copy(exec_space, vertex_parents, INT_MAX);
+  Kokkos::parallel_for(
+      "ArborX::Dendrogram::compute_vertex_parents",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_edges),
+      KOKKOS_LAMBDA(int const e) {
+        Kokkos::atomic_min(&vertex_parents(sorted_edges(e).source), e);
+        Kokkos::atomic_min(&vertex_parents(sorted_edges(e).target), e);
+      });
+
+  Kokkos::View<int *, MemorySpace> labels(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::Dendrogram::labels"),
+      num_vertices);
+  KokkosExt::iota(exec_space, labels);
+  UnionFind<MemorySpace> union_find(labels);
+
+  Kokkos::View<int *, MemorySpace> edges_mapping(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::Dendrogram::edges_mapping"),
+      num_vertices);
+  Kokkos::View<int *, MemorySpace> sided_parents(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::Dendrogram::sided_parents"),
+      num_edges);
+
+  Kokkos::View<int *, MemorySpace> active(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::Dendrogram::active_edges"),
+      num_edges);
+  KokkosExt::iota(exec_space, active);
+  auto next_active = KokkosExt::cloneWithoutInitializingNorCopying(
+      exec_space, active);
+  auto selected = KokkosExt::cloneWithoutInitializingNorCopying(
+      exec_space, active);
+
+  int num_active = num_edges;
+  int num_selected = 0;
+  int iterations = 0;
+  while (num_active > 0)
+  {
+    Kokkos::Profiling::ScopedRegion round_guard(
+        "ArborX::Dendrogram::alpha_" + std::to_string(++iterations) + "_" +
+        std::to_string(num_active));
+
+    // Every component picks its smallest incident active edge (edges are
+    // ranked by their sorted position, which matches the weight order)
+    Kokkos::deep_copy(exec_space, edges_mapping, INT_MAX);
+    Kokkos::parallel_for(
+        "ArborX::Dendrogram::find_component_min_edges",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_active),
+        KOKKOS_LAMBDA(int const k) {
+          int const e = active(k);
+          Kokkos::atomic_min(&edges_mapping(labels(sorted_edges(e).source)),
+                             e);
+          Kokkos::atomic_min(&edges_mapping(labels(sorted_edges(e).target)),
+                             e);
+        });
+
+    // The edges contracted in the previous round hang off the alpha edge
+    // their component picks now: either directly on one of its sides, or
+    // further up its chain (same encoding as the Boruvka version)
+    Kokkos::parallel_for(
+        "ArborX::Dendrogram::update_sided_parents",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_selected),
+        KOKKOS_LAMBDA(int const k) {
+          int const e = selected(k);
+          int const component = labels(sorted_edges(e).source);
+          int const alpha_edge_index = edges_mapping(component);
+          if (e < alpha_edge_index)
+          {
+            bool const is_left_side =
+                (labels(sorted_edges(alpha_edge_index).source) == component);
+            sided_parents(e) =
+                2 * alpha_edge_index + static_cast<int>(is_left_side);
+          }
+          else
+          {
+            sided_parents(e) = FOLLOW_CHAIN_VALUE - alpha_edge_index;
+          }
+        });
+
+    // Gather this round's picks (before the labels change)
+    Kokkos::parallel_scan(
+        "ArborX::Dendrogram::extract_selected_edges",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_active),
+        KOKKOS_LAMBDA(int const k, int &update, bool final_pass) {
+          int const e = active(k);
+          auto const &edge = sorted_edges(e);
+          if (edges_mapping(labels(edge.source)) == e ||
+              edges_mapping(labels(edge.target)) == e)
+          {
+            if (final_pass)
+              selected(update) = e;
+            ++update;
+          }
+        },
+        num_selected);
+
+    // Contract the picked edges
+    Kokkos::parallel_for(
+        "ArborX::Dendrogram::merge_components",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_selected),
+        KOKKOS_LAMBDA(int const k) {
+          auto const &edge = sorted_edges(selected(k));
+          union_find.merge(edge.source, edge.target);
+        });
+    Kokkos::parallel_for(
+        "ArborX::Dendrogram::flatten_labels",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_vertices),
+        KOKKOS_LAMBDA(int const i) { labels(i) = union_find.representative(i); });
+
+    // An edge stays active exactly until it is picked, at which point its
+    // endpoints fall into the same component
+    int num_still_active;
+    Kokkos::parallel_scan(
+        "ArborX::Dendrogram::compress_active_edges",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_active),
+        KOKKOS_LAMBDA(int const k, int &update, bool final_pass) {
+          int const e = active(k);
+          auto const &edge = sorted_edges(e);
+          if (labels(edge.source) != labels(edge.target))
+          {
+            if (final_pass)
+              next_active(update) = e;
+            ++update;
+          }
+        },
+        num_still_active);
+    std::swap(active, next_active);
+    num_active = num_still_active;
+  }
+
+  // The picks of the final round merged everything into a single component
+  // and have no alpha edge above them
+  Kokkos::parallel_for(
+      "ArborX::Dendrogram::assign_root_chain",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_selected),
+      KOKKOS_LAMBDA(int const k) {
+        sided_parents(selected(k)) = ROOT_CHAIN_VALUE;
+      });
+
+  computeParents(exec_space, sorted_edges, sided_parents, parents);
+}
+
 } // namespace ArborX::Details
 
 #endif
@@ -18,6 +18,15 @@
 // Don't really need it, but our self containment tests rely on its presence
 #include <mpi.h>
 
+namespace ArborX::Experimental
+{
+template <class MemorySpace>
+class CommunicationPlan;
+template <class MemorySpace>
+class GhostCache;
+class QueryRequest;
+} // namespace ArborX::Experimental
+
 namespace ArborX::Details
 {
 struct DistributedTreeImpl
@@ -40,6 +49,109 @@ struct DistributedTreeImpl
                 ExecutionSpace const &space, Predicates const &queries,
                 Callback const &callback, OutputView &out, OffsetView &offset);
 
+  // spatial queries replaying a reusable communication plan
+  template <typename DistributedTree, typename ExecutionSpace,
+            typename Predicates, typename IndicesAndRanks, typename Offset>
+  static std::enable_if_t<Kokkos::is_view<IndicesAndRanks>{} &&
+                          Kokkos::is_view<Offset>{}>
+  queryDispatch(
+      SpatialPredicateTag, DistributedTree const &tree,
+      ExecutionSpace const &space, Predicates const &queries,
+      IndicesAndRanks &values, Offset &offset,
+      Experimental::CommunicationPlan<typename DistributedTree::memory_space>
+          &plan);
+
+  template <typename DistributedTree, typename ExecutionSpace,
+            typename Predicates, typename OutputView, typename OffsetView,
+            typename Callback>
+  static std::enable_if_t<Kokkos::is_view<OutputView>{} &&
+                          Kokkos::is_view<OffsetView>{}>
+  queryDispatch(
+      SpatialPredicateTag, DistributedTree const &tree,
+      ExecutionSpace const &space, Predicates const &queries,
+      Callback const &callback, OutputView &out, OffsetView &offset,
+      Experimental::CommunicationPlan<typename DistributedTree::memory_space>
+          &plan);
+
+  // spatial queries reusing the cached remote contribution (see GhostCache)
+  template <typename DistributedTree, typename ExecutionSpace,
+            typename Predicates, typename IndicesAndRanks, typename Offset>
+  static std::enable_if_t<Kokkos::is_view<IndicesAndRanks>{} &&
+                          Kokkos::is_view<Offset>{}>
+  queryDispatch(
+      SpatialPredicateTag, DistributedTree const &tree,
+      ExecutionSpace const &space, Predicates const &queries,
+      IndicesAndRanks &values, Offset &offset,
+      Experimental::GhostCache<typename DistributedTree::memory_space> &ghost);
+
+  template <typename DistributedTree, typename ExecutionSpace,
+            typename Predicates, typename OutputView, typename OffsetView,
+            typename Callback>
+  static std::enable_if_t<Kokkos::is_view<OutputView>{} &&
+                          Kokkos::is_view<OffsetView>{}>
+  queryDispatch(
+      SpatialPredicateTag, DistributedTree const &tree,
+      ExecutionSpace const &space, Predicates const &queries,
+      Callback const &callback, OutputView &out, OffsetView &offset,
+      Experimental::GhostCache<typename DistributedTree::memory_space> &ghost);
+
+  // spatial queries over a hierarchical top tree (see
+  // Experimental::HierarchicalTopTree)
+  template <typename DistributedTree, typename ExecutionSpace,
+            typename Predicates, typename OutputView, typename OffsetView,
+            typename Callback>
+  static void queryDispatchSpatialHierarchical(DistributedTree const &tree,
+                                               ExecutionSpace const &space,
+                                               Predicates const &queries,
+                                               Callback const &callback,
+                                               OutputView &out,
+                                               OffsetView &offset);
+
+  // spatial queries executing a reduction post callback on the ranks owning
+  // the data (see ReductionPostCallbackTag); only the reduced values are
+  // exchanged on the way back
+  template <typename DistributedTree, typename ExecutionSpace,
+            typename Predicates, typename OutputView, typename OffsetView,
+            typename Callback>
+  static void queryDispatchSpatialReduction(DistributedTree const &tree,
+                                            ExecutionSpace const &space,
+                                            Predicates const &queries,
+                                            Callback const &callback,
+                                            OutputView &out,
+                                            OffsetView &offset);
+
+  template <typename DistributedTree, typename ExecutionSpace,
+            typename Predicates, typename OutputView, typename OffsetView,
+            typename Callback>
+  static void queryDispatchSpatial(
+      DistributedTree const &tree, ExecutionSpace const &space,
+      Predicates const &queries, Callback const &callback, OutputView &out,
+      OffsetView &offset,
+      Experimental::CommunicationPlan<typename DistributedTree::memory_space>
+          *plan,
+      Experimental::GhostCache<typename DistributedTree::memory_space> *ghost);
+
+  // asynchronous spatial queries (see Experimental::QueryRequest)
+  template <typename DistributedTree, typename ExecutionSpace,
+            typename Predicates, typename IndicesAndRanks, typename Offset>
+  static std::enable_if_t<Kokkos::is_view<IndicesAndRanks>{} &&
+                              Kokkos::is_view<Offset>{},
+                          Experimental::QueryRequest>
+  queryDispatchAsync(SpatialPredicateTag, DistributedTree const &tree,
+                     ExecutionSpace const &space, Predicates const &queries,
+                     IndicesAndRanks &values, Offset &offset);
+
+  template <typename DistributedTree, typename ExecutionSpace,
+            typename Predicates, typename OutputView, typename OffsetView,
+            typename Callback>
+  static std::enable_if_t<Kokkos::is_view<OutputView>{} &&
+                              Kokkos::is_view<OffsetView>{},
+                          Experimental::QueryRequest>
+  queryDispatchAsync(SpatialPredicateTag, DistributedTree const &tree,
+                     ExecutionSpace const &space, Predicates const &queries,
+                     Callback const &callback, OutputView &out,
+                     OffsetView &offset);
+
   // nearest neighbors queries
   template <typename DistributedTree, typename ExecutionSpace,
             typename Predicates, typename Indices, typename Offset,
@@ -64,19 +176,29 @@ struct DistributedTreeImpl
   // nearest neighbors helpers
   template <typename DistributedTree, typename ExecutionSpace,
             typename Predicates, typename Indices, typename Offset,
-            typename Distances>
+            typename Distances, typename Bounds>
   static void deviseStrategy(ExecutionSpace const &space,
                              Predicates const &queries,
                              DistributedTree const &tree, Indices &indices,
-                             Offset &offset, Distances &);
+                             Offset &offset, Distances &, Bounds &);
 
   template <typename DistributedTree, typename ExecutionSpace,
             typename Predicates, typename Indices, typename Offset,
-            typename Distances>
+            typename Distances, typename Bounds>
   static void reassessStrategy(ExecutionSpace const &space,
                                Predicates const &queries,
                                DistributedTree const &tree, Indices &indices,
-                               Offset &offset, Distances &distances);
+                               Offset &offset, Distances &distances,
+                               Bounds &bounds);
+
+  template <typename DistributedTree, typename ExecutionSpace,
+            typename Predicates, typename Indices, typename Offset,
+            typename Distances, typename Bounds>
+  static void deviseSingleRoundStrategy(ExecutionSpace const &space,
+                                        Predicates const &queries,
+                                        DistributedTree const &tree,
+                                        Indices &indices, Offset &offset,
+                                        Distances &, Bounds &bounds);
 };
 
 } // namespace ArborX::Details
@@ -16,7 +16,9 @@
 #include <ArborX_DetailsDistributedTreeImpl.hpp>
 #include <ArborX_DetailsDistributedTreeUtils.hpp>
 #include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
 #include <ArborX_DetailsKokkosExtMinMaxOperations.hpp>
+#include <ArborX_DetailsKokkosExtSegmentedSort.hpp>
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
 #include <ArborX_DetailsKokkosExtViewHelpers.hpp>
 #include <ArborX_LinearBVH.hpp>
@@ -28,6 +30,8 @@
 #include <Kokkos_Core.hpp>
 #include <Kokkos_Profiling_ScopedRegion.hpp>
 
+#include <cstdlib>
+
 // Don't really need it, but our self containment tests rely on its presence
 #include <mpi.h>
 
@@ -104,6 +108,48 @@ struct AccessTraits<
   }
 };
 
+namespace Details
+{
+// Decorates each nearest predicate with the distance to its farthest
+// first-round neighbor (see BoundedNearest), so that the second-round
+// traversals on remote ranks start pruning from the k-th best distance known
+// globally instead of from infinity.
+template <class Predicates, class Distances>
+struct BoundedNearestPredicates
+{
+  Predicates predicates;
+  Distances bounds;
+};
+} // namespace Details
+
+template <class Predicates, class Distances>
+struct AccessTraits<Details::BoundedNearestPredicates<Predicates, Distances>,
+                    PredicatesTag>
+{
+  using Predicate = typename Predicates::value_type;
+  using Self = Details::BoundedNearestPredicates<Predicates, Distances>;
+
+  using memory_space = typename Predicates::memory_space;
+  using size_type = decltype(std::declval<Predicates const &>().size());
+
+  static KOKKOS_FUNCTION size_type size(Self const &x)
+  {
+    return x.predicates.size();
+  }
+  static KOKKOS_FUNCTION auto get(Self const &x, size_type i)
+  {
+    // Nudge the bound up by one ulp so that the first-round neighbor sitting
+    // exactly at the bound is found again (the traversal prunes with a
+    // strict comparison, and recomputing the same predicate-leaf distance on
+    // its home rank reproduces the same float)
+    return BoundedNearest<Predicate>{
+        x.predicates(i),
+        Kokkos::nextafter(
+            x.bounds(i),
+            Details::KokkosExt::ArithmeticTraits::infinity<float>::value)};
+  }
+};
+
 namespace Details
 {
 
@@ -164,12 +210,255 @@ struct CallbackWithDistance
   }
 };
 
+// Opt-in tree-structured merge of the nearest results on their way back to
+// the originating ranks (set the environment variable
+// ARBORX_NEAREST_TREE_MERGE to a nonzero value). Pays off when queries
+// contact many ranks each: the direct return path then delivers k results
+// times the contacted-rank count to the originating rank, most of which the
+// final merge discards.
+inline bool useNearestTreeMerge()
+{
+  static bool const value = [] {
+    char const *env = std::getenv("ARBORX_NEAREST_TREE_MERGE");
+    return env != nullptr && std::atoi(env) != 0;
+  }();
+  return value;
+}
+
+// Opt-in single-round nearest search (set the environment variable
+// ARBORX_NEAREST_SINGLE_ROUND to a nonzero value). The forwarding set is
+// derived from the top tree alone instead of being refined from a first
+// traversal round, halving the communication epochs per call at the price
+// of forwarding to the ranks a tight second-round radius would exclude.
+inline bool useNearestSingleRound()
+{
+  static bool const value = [] {
+    char const *env = std::getenv("ARBORX_NEAREST_SINGLE_ROUND");
+    return env != nullptr && std::atoi(env) != 0;
+  }();
+  return value;
+}
+
+// Everything one candidate result needs to be routed and merged on its way
+// back to the originating rank
+struct NearestCandidate
+{
+  int index;
+  int rank;   // rank owning the candidate
+  int id;     // query id on the originating rank
+  int origin; // originating rank
+  int k;
+  float distance;
+};
+
+// Keep, for every query present in the view, only its k closest candidates.
+// Dropping a candidate beaten by k others of the same merged subset can
+// never drop a member of the final result, so the truncation is safe at any
+// point of the route.
+template <typename ExecutionSpace, typename MemorySpace>
+void truncateNearestCandidates(
+    ExecutionSpace const &space,
+    Kokkos::View<NearestCandidate *, MemorySpace> &candidates)
+{
+  int const n = candidates.extent(0);
+  if (n == 0)
+    return;
+
+  // Group the candidates of the same query together
+  Kokkos::View<long long *, MemorySpace> keys(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedTree::query::nearest::merge_keys"),
+      n);
+  Kokkos::parallel_for(
+      "ArborX::DistributedTree::query::nearest::fill_merge_keys",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        keys(i) = ((long long)candidates(i).origin << 32) | candidates(i).id;
+      });
+  DistributedTree::sortResults(space, keys, keys, candidates);
+
+  int n_groups;
+  Kokkos::parallel_reduce(
+      "ArborX::DistributedTree::query::nearest::count_groups",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i, int &update) {
+        update += (i == 0 || keys(i) != keys(i - 1));
+      },
+      n_groups);
+  Kokkos::View<int *, MemorySpace> group_offsets(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::nearest::group_offsets"),
+      n_groups + 1);
+  Kokkos::parallel_scan(
+      "ArborX::DistributedTree::query::nearest::fill_group_offsets",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i, int &update, bool final_pass) {
+        bool const head = (i == 0 || keys(i) != keys(i - 1));
+        if (final_pass)
+        {
+          if (head)
+            group_offsets(update) = i;
+          if (i == n - 1)
+            group_offsets(n_groups) = n;
+        }
+        update += head;
+      });
+
+  Kokkos::View<int *, MemorySpace> new_offsets(
+      Kokkos::view_alloc(
+          space, "ArborX::DistributedTree::query::nearest::truncated_offsets"),
+      n_groups + 1);
+  Kokkos::parallel_for(
+      "ArborX::DistributedTree::query::nearest::count_truncated",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_groups),
+      KOKKOS_LAMBDA(int g) {
+        using KokkosExt::min;
+        new_offsets(g) = min(group_offsets(g + 1) - group_offsets(g),
+                             candidates(group_offsets(g)).k);
+      });
+  KokkosExt::exclusive_scan(space, new_offsets, new_offsets, 0);
+
+  int const n_new = KokkosExt::lastElement(space, new_offsets);
+  if (n_new == n)
+    return;
+
+  Kokkos::View<NearestCandidate *, MemorySpace> new_candidates(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         candidates.label()),
+      n_new);
+
+  // Ordering every group by distance turns the truncation into keeping the
+  // head of the group
+  Kokkos::View<float *, MemorySpace> group_distances(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::nearest::merge_distances"),
+      n);
+  Kokkos::parallel_for(
+      "ArborX::DistributedTree::query::nearest::extract_distances",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) { group_distances(i) = candidates(i).distance; });
+  KokkosExt::segmentedSortByKey(space, group_offsets, group_distances,
+                                candidates);
+
+  Kokkos::parallel_for(
+      "ArborX::DistributedTree::query::nearest::truncate_candidates",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_groups),
+      KOKKOS_LAMBDA(int g) {
+        int const count = new_offsets(g + 1) - new_offsets(g);
+        for (int j = 0; j < count; ++j)
+          new_candidates(new_offsets(g) + j) = candidates(group_offsets(g) + j);
+      });
+
+  candidates = new_candidates;
+}
+
+// Route the candidates back to their originating ranks through a hypercube
+// overlay instead of directly. In step d every rank forwards the candidates
+// whose origin differs from it in bit d to the neighbor across that bit and
+// merges what arrives, truncating every query back to its k closest. After
+// ceil(log2 P) steps everything has arrived, and no rank ever receives more
+// than about k * log2(P) candidates per query instead of k times the
+// contacted-rank count that the direct return path delivers to the
+// originating rank.
+template <typename ExecutionSpace, typename MemorySpace>
+void communicateNearestResultsBack(
+    MPI_Comm comm, ExecutionSpace const &space,
+    Kokkos::View<NearestCandidate *, MemorySpace> &candidates)
+{
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::DistributedTree::communicateNearestResultsBack");
+
+  using namespace DistributedTree;
+
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+  int comm_size;
+  MPI_Comm_size(comm, &comm_size);
+
+  // Responding-rank filtering: nothing beyond the k closest per query ever
+  // enters the network
+  truncateNearestCandidates(space, candidates);
+
+  for (int bit = 1; bit < comm_size; bit <<= 1)
+  {
+    int const n = candidates.extent(0);
+
+    // Partition into the candidates staying on this rank for this step and
+    // the ones routed through the neighbor across the current bit. When the
+    // rank count is not a power of two the neighbor may not exist, in which
+    // case the candidates are sent to their origin directly.
+    int n_go;
+    Kokkos::parallel_reduce(
+        "ArborX::DistributedTree::query::nearest::count_routed",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i, int &update) {
+          update += (((candidates(i).origin ^ comm_rank) & bit) != 0);
+        },
+        n_go);
+
+    Kokkos::View<NearestCandidate *, MemorySpace> stay(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           candidates.label()),
+        n - n_go);
+    Kokkos::View<NearestCandidate *, MemorySpace> exports(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedTree::query::nearest::route_exports"),
+        n_go);
+    Kokkos::View<int *, MemorySpace> export_ranks(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedTree::query::nearest::route_export_ranks"),
+        n_go);
+    Kokkos::View<int[2], MemorySpace> counters(
+        Kokkos::view_alloc(
+            space, "ArborX::DistributedTree::query::nearest::route_counters"));
+    Kokkos::parallel_for(
+        "ArborX::DistributedTree::query::nearest::split_routed",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i) {
+          if (((candidates(i).origin ^ comm_rank) & bit) != 0)
+          {
+            int const j = Kokkos::atomic_fetch_add(&counters(1), 1);
+            exports(j) = candidates(i);
+            int const neighbor = comm_rank ^ bit;
+            export_ranks(j) =
+                (neighbor < comm_size ? neighbor : candidates(i).origin);
+          }
+          else
+          {
+            stay(Kokkos::atomic_fetch_add(&counters(0), 1)) = candidates(i);
+          }
+        });
+
+    Distributor<MemorySpace> distributor(comm);
+    int const n_in = distributor.createFromSends(space, export_ranks);
+
+    Kokkos::View<NearestCandidate *, MemorySpace> merged(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           candidates.label()),
+        (n - n_go) + n_in);
+    Kokkos::deep_copy(space,
+                      Kokkos::subview(merged, Kokkos::make_pair(0, n - n_go)),
+                      stay);
+    auto imports = Kokkos::subview(
+        merged, Kokkos::make_pair(n - n_go, (n - n_go) + n_in));
+    sendAcrossNetwork(space, distributor, exports,
+                      Kokkos::View<NearestCandidate *, MemorySpace>(imports));
+
+    candidates = merged;
+    truncateNearestCandidates(space, candidates);
+  }
+}
+
 template <typename Tree, typename ExecutionSpace, typename Predicates,
-          typename Indices, typename Offset, typename Distances>
+          typename Indices, typename Offset, typename Distances,
+          typename Bounds>
 void DistributedTreeImpl::deviseStrategy(ExecutionSpace const &space,
                                          Predicates const &queries,
                                          Tree const &tree, Indices &indices,
-                                         Offset &offset, Distances &)
+                                         Offset &offset, Distances &, Bounds &)
 {
   Kokkos::Profiling::ScopedRegion guard(
       "ArborX::DistributedTree::deviseStrategy");
@@ -227,27 +516,24 @@ void DistributedTreeImpl::deviseStrategy(ExecutionSpace const &space,
 }
 
 template <typename Tree, typename ExecutionSpace, typename Predicates,
-          typename Indices, typename Offset, typename Distances>
+          typename Indices, typename Offset, typename Distances,
+          typename Bounds>
 void DistributedTreeImpl::reassessStrategy(ExecutionSpace const &space,
                                            Predicates const &queries,
                                            Tree const &tree, Indices &indices,
-                                           Offset &offset, Distances &distances)
+                                           Offset &offset, Distances &distances,
+                                           Bounds &bounds)
 {
   Kokkos::Profiling::ScopedRegion guard(
       "ArborX::DistributedTree::reassessStrategy");
 
   using namespace DistributedTree;
-  using MemorySpace = typename Tree::memory_space;
 
   auto const &top_tree = tree._top_tree;
   auto const n_queries = queries.size();
 
-  // Determine distance to the farthest neighbor found so far.
-  Kokkos::View<float *, MemorySpace> farthest_distances(
-      Kokkos::view_alloc(
-          space, Kokkos::WithoutInitializing,
-          "ArborX::DistributedTree::query::reassessStrategy::distances"),
-      n_queries);
+  // Determine distance to the farthest neighbor found so far. Doubles as the
+  // per-query pruning bound for the second-round traversals.
   // NOTE: in principle distances( j ) are arranged in ascending order for
   // offset( i ) <= j < offset( i + 1 ) so max() is not necessary.
   Kokkos::parallel_for(
@@ -255,24 +541,117 @@ void DistributedTreeImpl::reassessStrategy(ExecutionSpace const &space,
       Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
       KOKKOS_LAMBDA(int i) {
         using KokkosExt::max;
-        farthest_distances(i) = 0.;
+        bounds(i) = 0.;
         for (int j = offset(i); j < offset(i + 1); ++j)
-          farthest_distances(i) = max(farthest_distances(i), distances(j));
+          bounds(i) = max(bounds(i), distances(j));
       });
 
   check_valid_access_traits(
       PredicatesTag{},
-      WithinDistanceFromPredicates<Predicates, decltype(farthest_distances)>{
-          queries, farthest_distances});
+      WithinDistanceFromPredicates<Predicates, Bounds>{queries, bounds});
 
   query(top_tree, space,
-        WithinDistanceFromPredicates<Predicates, decltype(farthest_distances)>{
-            queries, farthest_distances},
+        WithinDistanceFromPredicates<Predicates, Bounds>{queries, bounds},
         indices, offset);
   // NOTE: in principle, we could perform radius searches on the bottom_tree
   // rather than nearest queries.
 }
 
+// Farthest distance from a point to any point of a box. Applied to the
+// centroid of a convex query geometry, it bounds the distance from that
+// geometry to anything contained in the box.
+KOKKOS_INLINE_FUNCTION float farthestDistance(Point const &point,
+                                              Box const &box)
+{
+  float distance_squared = 0;
+  for (int d = 0; d < 3; ++d)
+  {
+    using Kokkos::abs;
+    using KokkosExt::max;
+    float const tmp = max(abs(point[d] - box.minCorner()[d]),
+                          abs(point[d] - box.maxCorner()[d]));
+    distance_squared += tmp * tmp;
+  }
+  return Kokkos::sqrt(distance_squared);
+}
+
+// Single-round alternative to the deviseStrategy/reassessStrategy pair (see
+// useNearestSingleRound): the forwarding set is computed from the top tree
+// alone, with no first traversal round to refine from. The boxes of the
+// closest ranks that together hold at least k leaves must contain the k
+// nearest neighbors, so the farthest box corner among them is a valid
+// per-query search radius; forwarding to every rank whose box comes within
+// that radius then finds the true neighbors in one round.
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename Indices, typename Offset, typename Distances,
+          typename Bounds>
+void DistributedTreeImpl::deviseSingleRoundStrategy(
+    ExecutionSpace const &space, Predicates const &queries, Tree const &tree,
+    Indices &indices, Offset &offset, Distances &, Bounds &bounds)
+{
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::DistributedTree::deviseSingleRoundStrategy");
+
+  using namespace DistributedTree;
+  using MemorySpace = typename Tree::memory_space;
+
+  auto const &top_tree = tree._top_tree;
+  auto const &bottom_tree_sizes = tree._bottom_tree_sizes;
+
+  // Find the k nearest local trees, as in deviseStrategy
+  query(top_tree, space, queries, indices, offset);
+
+  // Recover the box of every rank from the top tree leaves
+  int const n_ranks = bottom_tree_sizes.extent(0);
+  Kokkos::View<Box *, MemorySpace> rank_boxes(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::nearest::rank_boxes"),
+      n_ranks);
+  Kokkos::parallel_for(
+      "ArborX::DistributedTree::query::nearest::fill_rank_boxes",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, top_tree.size()),
+      KOKKOS_LAMBDA(int i) {
+        rank_boxes(HappyTreeFriends::getValue(top_tree, i).index) =
+            HappyTreeFriends::getIndexable(top_tree, i);
+      });
+
+  // Accumulate leaf counts over the closest ranks until k is reached, as in
+  // deviseStrategy, and take the farthest corner of the boxes visited along
+  // the way as the search radius
+  auto const n_queries = queries.size();
+  Kokkos::parallel_for(
+      "ArborX::DistributedTree::query::nearest::conservative_bounds",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int i) {
+        using KokkosExt::max;
+        int leaves_count = 0;
+        int const n_nearest_neighbors = getK(queries(i));
+        bounds(i) = 0.f;
+        for (int j = offset(i); j < offset(i + 1); ++j)
+        {
+          int const bottom_tree_size = bottom_tree_sizes(indices(j));
+          if ((bottom_tree_size == 0) || (leaves_count >= n_nearest_neighbors))
+            break;
+          leaves_count += bottom_tree_size;
+          bounds(i) =
+              max(bounds(i),
+                  farthestDistance(returnCentroid(getGeometry(queries(i))),
+                                   rank_boxes(indices(j))));
+        }
+      });
+
+  // Forward to every rank whose box comes within the radius; the k nearest
+  // neighbors cannot live anywhere else
+  check_valid_access_traits(
+      PredicatesTag{},
+      WithinDistanceFromPredicates<Predicates, Bounds>{queries, bounds});
+
+  query(top_tree, space,
+        WithinDistanceFromPredicates<Predicates, Bounds>{queries, bounds},
+        indices, offset);
+}
+
 template <typename Tree, typename ExecutionSpace, typename Predicates,
           typename Indices, typename Offset, typename Ranks, typename Distances>
 std::enable_if_t<Kokkos::is_view<Indices>{} && Kokkos::is_view<Offset>{} &&
@@ -286,6 +665,19 @@ DistributedTreeImpl::queryDispatchImpl(NearestPredicateTag, Tree const &tree,
   Kokkos::Profiling::ScopedRegion guard(
       "ArborX::DistributedTree::query::nearest");
 
+  // The strategies below discover candidate ranks through the replicated
+  // top tree, which a hierarchical top tree does not carry (see
+  // Experimental::HierarchicalTopTree); only spatial queries are supported
+  // in that mode for now
+  ARBORX_ASSERT(tree._group_size == 0);
+  // Likewise, with a fragmented top tree the indices coming out of the top
+  // tree denote fragments rather than ranks, which the strategies do not
+  // interpret (see Experimental::FragmentedTopTree)
+  ARBORX_ASSERT(tree._n_fragments == 1);
+  // A replicated tree carries no top tree at all (see
+  // Experimental::ReplicatedTree)
+  ARBORX_ASSERT(!tree._replicated);
+
   using namespace DistributedTree;
   using MemorySpace = typename Tree::memory_space;
 
@@ -294,6 +686,16 @@ DistributedTreeImpl::queryDispatchImpl(NearestPredicateTag, Tree const &tree,
 
   Distances distances("ArborX::DistributedTree::query::nearest::distances", 0);
 
+  // Per-query upper bound on the distance to the k-th neighbor, infinite in
+  // the 1st pass and tightened by reassessStrategy for the 2nd one. Forwarded
+  // along with the queries so that remote traversals can prune against it.
+  Kokkos::View<float *, MemorySpace> bounds(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedTree::query::nearest::bounds"),
+      queries.size());
+  Kokkos::deep_copy(space, bounds,
+                    KokkosExt::ArithmeticTraits::infinity<float>::value);
+
   // "Strategy" is used to determine what ranks to forward queries to.  In
   // the 1st pass, the queries are sent to as many ranks as necessary to
   // guarantee that all k neighbors queried for are found.  In the 2nd pass,
@@ -313,11 +715,20 @@ DistributedTreeImpl::queryDispatchImpl(NearestPredicateTag, Tree const &tree,
   // NOTE: compiler would not deduce __range for the braced-init-list, but I
   // got it to work with the static_cast to function pointers.
   using Strategy = void (*)(ExecutionSpace const &, Predicates const &,
-                            Tree const &, Indices &, Offset &, Distances &);
-  for (auto implementStrategy : {static_cast<Strategy>(deviseStrategy),
-                                 static_cast<Strategy>(reassessStrategy)})
+                            Tree const &, Indices &, Offset &, Distances &,
+                            decltype(bounds) &);
+  Strategy strategies[] = {static_cast<Strategy>(deviseStrategy),
+                           static_cast<Strategy>(reassessStrategy)};
+  int n_rounds = 2;
+  if (useNearestSingleRound())
+  {
+    strategies[0] = static_cast<Strategy>(deviseSingleRoundStrategy);
+    n_rounds = 1;
+  }
+  for (int round = 0; round < n_rounds; ++round)
   {
-    implementStrategy(space, queries, tree, indices, offset, distances);
+    auto implementStrategy = strategies[round];
+    implementStrategy(space, queries, tree, indices, offset, distances, bounds);
 
     {
       // NOTE_COMM_NEAREST: The communication pattern here for the nearest
@@ -327,14 +738,18 @@ DistributedTreeImpl::queryDispatchImpl(NearestPredicateTag, Tree const &tree,
       // - explicit distances
       // - results filtering
 
-      // Forward queries
+      // Forward queries, each carrying its current k-th best distance bound
       using Query = typename Predicates::value_type;
+      using BoundedPredicates =
+          BoundedNearestPredicates<Predicates, decltype(bounds)>;
       Kokkos::View<int *, MemorySpace> ids(
           "ArborX::DistributedTree::query::nearest::query_ids", 0);
-      Kokkos::View<Query *, MemorySpace> fwd_queries(
+      Kokkos::View<BoundedNearest<Query> *, MemorySpace> fwd_queries(
           "ArborX::DistributedTree::query::nearest::fwd_queries", 0);
-      forwardQueries(comm, space, queries, indices, offset, fwd_queries, ids,
-                     ranks);
+      AccessValues<BoundedPredicates, PredicatesTag> bounded_queries{
+          BoundedPredicates{queries, bounds}};
+      forwardQueries(comm, space, bounded_queries, indices, offset, fwd_queries,
+                     ids, ranks);
 
       // Perform queries that have been received
       Kokkos::View<PairIndexDistance *, MemorySpace> out(
@@ -342,22 +757,66 @@ DistributedTreeImpl::queryDispatchImpl(NearestPredicateTag, Tree const &tree,
       query(bottom_tree, space, fwd_queries, callback_with_distance, out,
             offset);
 
-      // Unzip
-      auto const n = out.extent(0);
-      KokkosExt::reallocWithoutInitializing(space, indices, n);
-      KokkosExt::reallocWithoutInitializing(space, distances, n);
-      Kokkos::parallel_for(
-          "ArborX::DistributedTree::query::nearest::split_"
-          "index_distance_pairs",
-          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
-          KOKKOS_LAMBDA(int i) {
-            indices(i) = out(i).index;
-            distances(i) = out(i).distance;
-          });
-
-      // Communicate results back
-      communicateResultsBack(comm, space, indices, offset, ranks, ids,
-                             &distances);
+      if (useNearestTreeMerge())
+      {
+        // Merge the results on their way back: candidates are truncated to
+        // the k closest per query before and after every hop, so the return
+        // volume stays near k per query instead of k per contacted rank
+        int comm_rank;
+        MPI_Comm_rank(comm, &comm_rank);
+
+        int const n_fwd_queries = fwd_queries.extent(0);
+        Kokkos::View<NearestCandidate *, MemorySpace> candidates(
+            Kokkos::view_alloc(
+                space, Kokkos::WithoutInitializing,
+                "ArborX::DistributedTree::query::nearest::candidates"),
+            out.extent(0));
+        Kokkos::parallel_for(
+            "ArborX::DistributedTree::query::nearest::fill_candidates",
+            Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_fwd_queries),
+            KOKKOS_LAMBDA(int q) {
+              for (int i = offset(q); i < offset(q + 1); ++i)
+                candidates(i) = {out(i).index, comm_rank,
+                                 ids(q),       ranks(q),
+                                 getK(fwd_queries(q)), out(i).distance};
+            });
+
+        communicateNearestResultsBack(comm, space, candidates);
+
+        auto const n = candidates.extent(0);
+        KokkosExt::reallocWithoutInitializing(space, indices, n);
+        KokkosExt::reallocWithoutInitializing(space, distances, n);
+        KokkosExt::reallocWithoutInitializing(space, ranks, n);
+        KokkosExt::reallocWithoutInitializing(space, ids, n);
+        Kokkos::parallel_for(
+            "ArborX::DistributedTree::query::nearest::split_candidates",
+            Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+            KOKKOS_LAMBDA(int i) {
+              indices(i) = candidates(i).index;
+              ranks(i) = candidates(i).rank;
+              ids(i) = candidates(i).id;
+              distances(i) = candidates(i).distance;
+            });
+      }
+      else
+      {
+        // Unzip
+        auto const n = out.extent(0);
+        KokkosExt::reallocWithoutInitializing(space, indices, n);
+        KokkosExt::reallocWithoutInitializing(space, distances, n);
+        Kokkos::parallel_for(
+            "ArborX::DistributedTree::query::nearest::split_"
+            "index_distance_pairs",
+            Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+            KOKKOS_LAMBDA(int i) {
+              indices(i) = out(i).index;
+              distances(i) = out(i).distance;
+            });
+
+        // Communicate results back
+        communicateResultsBack(comm, space, indices, offset, ranks, ids,
+                               &distances);
+      }
 
       // Merge results
       Kokkos::Profiling::pushRegion(
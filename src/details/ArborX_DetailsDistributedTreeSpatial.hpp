@@ -11,13 +11,21 @@
 #ifndef ARBORX_DETAILS_DISTRIBUTED_TREE_SPATIAL_HPP
 #define ARBORX_DETAILS_DISTRIBUTED_TREE_SPATIAL_HPP
 
+#include <ArborX_Callbacks.hpp>
+#include <ArborX_CommunicationPlan.hpp>
 #include <ArborX_DetailsDistributedTreeImpl.hpp>
 #include <ArborX_DetailsDistributedTreeUtils.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_GhostCache.hpp>
 #include <ArborX_Predicates.hpp>
+#include <ArborX_QueryRequest.hpp>
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_Profiling_ScopedRegion.hpp>
 
+#include <memory>
+
 #include <mpi.h>
 
 namespace ArborX::Details
@@ -33,15 +41,582 @@ struct DefaultCallbackWithRank
   }
 };
 
+// Counterpart of DefaultCallbackWithRank for a replicated tree (see
+// Experimental::ReplicatedTree). The local tree stores the primitives of
+// all ranks in rank order, so the owning rank and the owner-local index are
+// recovered from the global index, keeping the output format of the
+// forwarding-based modes.
+template <typename OffsetView>
+struct ReplicatedCallbackWithRank
+{
+  // Exclusive scan of the per-rank primitive counts
+  OffsetView _rank_offset;
+
+  template <typename Predicate, typename OutputFunctor>
+  KOKKOS_FUNCTION void operator()(Predicate const &, int primitive_index,
+                                  OutputFunctor const &out) const
+  {
+    // Binary search for the owning rank
+    int first = 0;
+    int last = _rank_offset.size() - 1;
+    while (last - first > 1)
+    {
+      int const middle = (first + last) / 2;
+      if (primitive_index < _rank_offset(middle))
+        last = middle;
+      else
+        first = middle;
+    }
+    out({primitive_index - _rank_offset(first), first});
+  }
+};
+
+// Convert the fragment indices produced by a fragmented top tree (see
+// Experimental::FragmentedTopTree) into destination ranks, and remove the
+// duplicates a predicate collects when it intersects several fragments of
+// the same rank. The rest of the dispatch relies on each predicate listing
+// each destination rank at most once.
+template <typename ExecutionSpace, typename Indices, typename Offset>
+void mapFragmentsToRanks(ExecutionSpace const &space, int n_fragments,
+                         Indices &indices, Offset &offset)
+{
+  using MemorySpace = typename Indices::memory_space;
+
+  int const n_queries = offset.extent(0) - 1;
+
+  Kokkos::View<int *, MemorySpace> new_offset(
+      Kokkos::view_alloc(space, "ArborX::DistributedTree::query::spatial::"
+                                "fragment_dedup_offset"),
+      n_queries + 1);
+  Kokkos::parallel_for(
+      "ArborX::DistributedTree::query::spatial::count_fragment_ranks",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int q) {
+        for (int i = offset(q); i < offset(q + 1); ++i)
+          indices(i) /= n_fragments;
+        // Insertion sort; the blocks hold at most a handful of entries per
+        // contacted rank
+        for (int i = offset(q) + 1; i < offset(q + 1); ++i)
+        {
+          int const value = indices(i);
+          int j = i - 1;
+          while (j >= offset(q) && indices(j) > value)
+          {
+            indices(j + 1) = indices(j);
+            --j;
+          }
+          indices(j + 1) = value;
+        }
+        int count = 0;
+        for (int i = offset(q); i < offset(q + 1); ++i)
+          count += (i == offset(q) || indices(i) != indices(i - 1));
+        new_offset(q) = count;
+      });
+  KokkosExt::exclusive_scan(space, new_offset, new_offset, 0);
+
+  Kokkos::View<int *, MemorySpace> new_indices(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, indices.label()),
+      KokkosExt::lastElement(space, new_offset));
+  Kokkos::parallel_for(
+      "ArborX::DistributedTree::query::spatial::compact_fragment_ranks",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int q) {
+        int j = new_offset(q);
+        for (int i = offset(q); i < offset(q + 1); ++i)
+          if (i == offset(q) || indices(i) != indices(i - 1))
+            new_indices(j++) = indices(i);
+      });
+  indices = new_indices;
+  Kokkos::deep_copy(space, offset, new_offset);
+}
+
+// Spatial query over a hierarchical top tree (see
+// Experimental::HierarchicalTopTree): predicates are routed in two hops.
+// The supertree yields the candidate groups; a predicate destined to this
+// rank's own group is expanded to the member ranks immediately through the
+// replicated group tree, the others travel to the candidate group's leader,
+// which expands them against its group tree and forwards them on. Results
+// return directly to the originating rank, which travels with the
+// predicate.
 template <typename Tree, typename ExecutionSpace, typename Predicates,
           typename OutputView, typename OffsetView, typename Callback>
-std::enable_if_t<Kokkos::is_view<OutputView>{} && Kokkos::is_view<OffsetView>{}>
-DistributedTreeImpl::queryDispatch(SpatialPredicateTag, Tree const &tree,
-                                   ExecutionSpace const &space,
-                                   Predicates const &queries,
-                                   Callback const &callback, OutputView &out,
-                                   OffsetView &offset)
+void DistributedTreeImpl::queryDispatchSpatialHierarchical(
+    Tree const &tree, ExecutionSpace const &space, Predicates const &queries,
+    Callback const &callback, OutputView &out, OffsetView &offset)
+{
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::DistributedTree::query::spatial_hierarchical");
+
+  using namespace DistributedTree;
+  using MemorySpace = typename Tree::memory_space;
+  using Query = typename Predicates::value_type;
+
+  auto comm = tree.getComm();
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+
+  int const group_size = tree._group_size;
+  int const my_group = comm_rank / group_size;
+  int const n_queries = queries.size();
+
+  Kokkos::View<int *, MemorySpace> group_indices(
+      "ArborX::DistributedTree::query::hierarchical::group_indices", 0);
+  query(tree._super_tree, space, queries, group_indices, offset);
+
+  // A query not intersecting this group's box cannot intersect any member
+  // box, so querying the group tree with all predicates yields exactly the
+  // member expansion of the own-group candidates
+  Kokkos::View<int *, MemorySpace> member_indices(
+      "ArborX::DistributedTree::query::hierarchical::member_indices", 0);
+  Kokkos::View<int *, MemorySpace> member_offset(
+      "ArborX::DistributedTree::query::hierarchical::member_offset", 0);
+  query(tree._group_tree, space, queries, member_indices, member_offset);
+
+  Kokkos::View<int *, MemorySpace> export_offset(
+      "ArborX::DistributedTree::query::hierarchical::export_offset",
+      n_queries + 1);
+  Kokkos::parallel_for(
+      "ArborX::DistributedTree::query::hierarchical::count_exports",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int q) {
+        int count = member_offset(q + 1) - member_offset(q);
+        for (int i = offset(q); i < offset(q + 1); ++i)
+          if (group_indices(i) != my_group)
+            ++count;
+        export_offset(q) = count;
+      });
+  KokkosExt::exclusive_scan(space, export_offset, export_offset, 0);
+  int const n_exports = KokkosExt::lastElement(space, export_offset);
+
+  Kokkos::View<int *, MemorySpace> export_ranks(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::hierarchical::export_ranks"),
+      n_exports);
+  Kokkos::View<Query *, MemorySpace> export_queries(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::hierarchical::export_queries"),
+      n_exports);
+  Kokkos::View<int *, MemorySpace> export_ids(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::hierarchical::export_ids"),
+      n_exports);
+  // Nonzero when the entry is addressed to its final destination; zero when
+  // the receiving group leader still needs to expand it
+  Kokkos::View<int *, MemorySpace> export_final(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::hierarchical::export_final"),
+      n_exports);
+  Kokkos::parallel_for(
+      "ArborX::DistributedTree::query::hierarchical::fill_exports",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int q) {
+        int j = export_offset(q);
+        for (int m = member_offset(q); m < member_offset(q + 1); ++m)
+        {
+          export_ranks(j) = my_group * group_size + member_indices(m);
+          export_final(j) = 1;
+          export_queries(j) = queries(q);
+          export_ids(j) = q;
+          ++j;
+        }
+        for (int i = offset(q); i < offset(q + 1); ++i)
+        {
+          int const g = group_indices(i);
+          if (g == my_group)
+            continue;
+          export_ranks(j) = g * group_size;
+          export_final(j) = 0;
+          export_queries(j) = queries(q);
+          export_ids(j) = q;
+          ++j;
+        }
+      });
+
+  // Hop 1. The originating rank of an entry is its source, so it is implied
+  // by the receive layout
+  Distributor<MemorySpace> distributor1(comm);
+  int const n1 = distributor1.createFromSends(space, export_ranks);
+  Kokkos::View<Query *, MemorySpace> imp_queries(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::hierarchical::imp_queries"),
+      n1);
+  Kokkos::View<int *, MemorySpace> imp_ids(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::hierarchical::imp_ids"),
+      n1);
+  Kokkos::View<int *, MemorySpace> imp_final(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::hierarchical::imp_final"),
+      n1);
+  Kokkos::View<int *, MemorySpace> imp_orig(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::hierarchical::imp_orig"),
+      n1);
+  sendAcrossNetwork(space, distributor1, export_queries, imp_queries);
+  sendAcrossNetwork(space, distributor1, export_ids, imp_ids);
+  sendAcrossNetwork(space, distributor1, export_final, imp_final);
+  fillImportRanks(space, distributor1, imp_orig);
+
+  // Split the received entries: the final ones feed the local traversal, the
+  // rest are this group's share to expand as its leader
+  int n_expand;
+  Kokkos::parallel_reduce(
+      "ArborX::DistributedTree::query::hierarchical::count_expand",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n1),
+      KOKKOS_LAMBDA(int i, int &update) { update += 1 - imp_final(i); },
+      n_expand);
+  int const n_direct = n1 - n_expand;
+
+  Kokkos::View<Query *, MemorySpace> expand_queries(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::hierarchical::expand_queries"),
+      n_expand);
+  Kokkos::View<int *, MemorySpace> expand_ids(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::hierarchical::expand_ids"),
+      n_expand);
+  Kokkos::View<int *, MemorySpace> expand_orig(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::hierarchical::expand_orig"),
+      n_expand);
+  Kokkos::View<Query *, MemorySpace> fwd_queries(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::hierarchical::fwd_queries"),
+      n_direct);
+  Kokkos::View<int *, MemorySpace> fwd_ids(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::hierarchical::fwd_ids"),
+      n_direct);
+  Kokkos::View<int *, MemorySpace> fwd_ranks(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::hierarchical::fwd_ranks"),
+      n_direct);
+  Kokkos::View<int, MemorySpace> direct_counter(
+      "ArborX::DistributedTree::query::hierarchical::direct_counter");
+  Kokkos::View<int, MemorySpace> expand_counter(
+      "ArborX::DistributedTree::query::hierarchical::expand_counter");
+  Kokkos::parallel_for(
+      "ArborX::DistributedTree::query::hierarchical::split_imports",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n1), KOKKOS_LAMBDA(int i) {
+        if (imp_final(i))
+        {
+          int const j = Kokkos::atomic_fetch_add(&direct_counter(), 1);
+          fwd_queries(j) = imp_queries(i);
+          fwd_ids(j) = imp_ids(i);
+          fwd_ranks(j) = imp_orig(i);
+        }
+        else
+        {
+          int const j = Kokkos::atomic_fetch_add(&expand_counter(), 1);
+          expand_queries(j) = imp_queries(i);
+          expand_ids(j) = imp_ids(i);
+          expand_orig(j) = imp_orig(i);
+        }
+      });
+
+  // Hop 2: expand the leader's share to the member ranks. The originating
+  // rank is no longer the source, so it travels explicitly
+  Kokkos::View<int *, MemorySpace> em_indices(
+      "ArborX::DistributedTree::query::hierarchical::em_indices", 0);
+  Kokkos::View<int *, MemorySpace> em_offset(
+      "ArborX::DistributedTree::query::hierarchical::em_offset", 0);
+  query(tree._group_tree, space, expand_queries, em_indices, em_offset);
+
+  int const n2_exports = em_indices.extent(0);
+  Kokkos::View<int *, MemorySpace> export2_ranks(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::hierarchical::export2_ranks"),
+      n2_exports);
+  Kokkos::View<Query *, MemorySpace> export2_queries(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::hierarchical::export2_queries"),
+      n2_exports);
+  Kokkos::View<int *, MemorySpace> export2_ids(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::hierarchical::export2_ids"),
+      n2_exports);
+  Kokkos::View<int *, MemorySpace> export2_orig(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::hierarchical::export2_orig"),
+      n2_exports);
+  Kokkos::parallel_for(
+      "ArborX::DistributedTree::query::hierarchical::fill_exports2",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_expand),
+      KOKKOS_LAMBDA(int e) {
+        for (int m = em_offset(e); m < em_offset(e + 1); ++m)
+        {
+          export2_ranks(m) = my_group * group_size + em_indices(m);
+          export2_queries(m) = expand_queries(e);
+          export2_ids(m) = expand_ids(e);
+          export2_orig(m) = expand_orig(e);
+        }
+      });
+
+  Distributor<MemorySpace> distributor2(comm);
+  int const n2 = distributor2.createFromSends(space, export2_ranks);
+
+  int const n_fwd = n_direct + n2;
+  Kokkos::resize(Kokkos::view_alloc(space, Kokkos::WithoutInitializing),
+                 fwd_queries, n_fwd);
+  Kokkos::resize(Kokkos::view_alloc(space, Kokkos::WithoutInitializing),
+                 fwd_ids, n_fwd);
+  Kokkos::resize(Kokkos::view_alloc(space, Kokkos::WithoutInitializing),
+                 fwd_ranks, n_fwd);
+  auto tail = [n_direct, n_fwd](auto const &view) {
+    return Kokkos::subview(view, std::make_pair(n_direct, n_fwd));
+  };
+  sendAcrossNetwork(space, distributor2, export2_queries, tail(fwd_queries));
+  sendAcrossNetwork(space, distributor2, export2_ids, tail(fwd_ids));
+  sendAcrossNetwork(space, distributor2, export2_orig, tail(fwd_ranks));
+
+  // Group the forwarded entries by originating rank: the return exchange
+  // assumes the batches of a rank are consecutive
+  sortResults(space, fwd_ranks, fwd_queries, fwd_ids, fwd_ranks);
+
+  // Local traversal, return of the results, and postprocessing as in the
+  // flat path
+  query(tree._bottom_tree, space, fwd_queries, callback, out, offset);
+
+  communicateResultsBack(comm, space, out, offset, fwd_ranks, fwd_ids);
+
+  Kokkos::Profiling::pushRegion(
+      "ArborX::DistributedTree::spatial::postprocess_results");
+
+  countResults(space, n_queries, fwd_ids, offset);
+  sortResults(space, fwd_ids, out);
+
+  Kokkos::Profiling::popRegion();
+}
+
+// Spatial query executing a per-predicate reduction on the ranks owning the
+// data (see ReductionPostCallbackTag). Predicates are forwarded as usual,
+// but each receiving rank reduces the matches of every forwarded predicate
+// to a single value before the return exchange, so the payload shipped back
+// shrinks from one value per match to one value per (predicate, rank) pair.
+// The final output holds, for each predicate, one entry per contacted rank.
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename OutputView, typename OffsetView, typename Callback>
+void DistributedTreeImpl::queryDispatchSpatialReduction(
+    Tree const &tree, ExecutionSpace const &space, Predicates const &queries,
+    Callback const &callback, OutputView &out, OffsetView &offset)
 {
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::DistributedTree::query::spatial_reduction");
+
+  using namespace DistributedTree;
+  using MemorySpace = typename Tree::memory_space;
+  using Query = typename Predicates::value_type;
+
+  // The two-hop routing re-forwards predicates from the group leaders and
+  // would need the reduction to run twice
+  ARBORX_ASSERT(tree._group_size == 0);
+
+  int const n_queries = queries.size();
+
+  if (tree._replicated)
+  {
+    // All the data is local: reduce in place, one entry per predicate
+    Kokkos::View<int *, MemorySpace> indices(
+        "ArborX::DistributedTree::query::reduction::indices", 0);
+    query(tree._bottom_tree, space, queries, indices, offset);
+    callback(queries, offset, indices, out);
+    ARBORX_ASSERT(out.extent_int(0) == n_queries);
+    KokkosExt::reallocWithoutInitializing(space, offset, n_queries + 1);
+    KokkosExt::iota(space, offset);
+    return;
+  }
+
+  auto const &bottom_tree = tree._bottom_tree;
+  auto comm = tree.getComm();
+
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+
+  Kokkos::View<int *, MemorySpace> indices(
+      "ArborX::DistributedTree::query::spatial::indices", 0);
+  query(tree._top_tree, space, queries, indices, offset);
+
+  if (tree._n_fragments > 1)
+    mapFragmentsToRanks(space, tree._n_fragments, indices, offset);
+
+  // Same self/remote split as the plain spatial path, overlapping the
+  // rank's own reduction with the predicate exchange
+  Kokkos::View<int *, MemorySpace> remote_offset(
+      "ArborX::DistributedTree::query::spatial::remote_offset", n_queries + 1);
+  Kokkos::View<int *, MemorySpace> self_offset(
+      "ArborX::DistributedTree::query::spatial::self_offset", n_queries + 1);
+  Kokkos::parallel_for(
+      "ArborX::DistributedTree::query::spatial::count_destinations",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int q) {
+        for (int i = offset(q); i < offset(q + 1); ++i)
+        {
+          if (indices(i) == comm_rank)
+            ++self_offset(q);
+          else
+            ++remote_offset(q);
+        }
+      });
+  KokkosExt::exclusive_scan(space, remote_offset, remote_offset, 0);
+  KokkosExt::exclusive_scan(space, self_offset, self_offset, 0);
+
+  int const n_remote = KokkosExt::lastElement(space, remote_offset);
+  int const n_self = KokkosExt::lastElement(space, self_offset);
+
+  Kokkos::View<int *, MemorySpace> remote_indices(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::spatial::remote_indices"),
+      n_remote);
+  Kokkos::View<int *, MemorySpace> self_ids(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedTree::query::spatial::self_ids"),
+      n_self);
+  Kokkos::View<Query *, MemorySpace> self_queries(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::spatial::self_queries"),
+      n_self);
+  Kokkos::parallel_for(
+      "ArborX::DistributedTree::query::spatial::split_destinations",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int q) {
+        int j = remote_offset(q);
+        for (int i = offset(q); i < offset(q + 1); ++i)
+        {
+          if (indices(i) == comm_rank)
+          {
+            self_ids(self_offset(q)) = q;
+            self_queries(self_offset(q)) = queries(q);
+          }
+          else
+          {
+            remote_indices(j++) = indices(i);
+          }
+        }
+      });
+
+  auto forwarded =
+      forwardQueriesBegin(comm, space, queries, remote_indices, remote_offset);
+
+  // Reduce the predicates this rank keeps while the exchange is in flight
+  OutputView self_out(
+      Kokkos::view_alloc(space,
+                         "ArborX::DistributedTree::query::reduction::self_out"),
+      0);
+  {
+    Kokkos::View<int *, MemorySpace> self_indices(
+        "ArborX::DistributedTree::query::reduction::self_indices", 0);
+    Kokkos::View<int *, MemorySpace> self_match_offset(
+        "ArborX::DistributedTree::query::reduction::self_match_offset", 0);
+    query(bottom_tree, space, self_queries, self_indices, self_match_offset);
+    callback(self_queries, self_match_offset, self_indices, self_out);
+    ARBORX_ASSERT(self_out.extent_int(0) == n_self);
+  }
+
+  // Reduce the predicates received from other ranks
+  forwarded.wait();
+  int const n_fwd = forwarded.queries.extent(0);
+  {
+    Kokkos::View<int *, MemorySpace> fwd_indices(
+        "ArborX::DistributedTree::query::reduction::fwd_indices", 0);
+    Kokkos::View<int *, MemorySpace> fwd_match_offset(
+        "ArborX::DistributedTree::query::reduction::fwd_match_offset", 0);
+    query(bottom_tree, space, forwarded.queries, fwd_indices,
+          fwd_match_offset);
+    callback(forwarded.queries, fwd_match_offset, fwd_indices, out);
+    ARBORX_ASSERT(out.extent_int(0) == n_fwd);
+  }
+
+  // The return exchange carries exactly one value per forwarded predicate
+  Kokkos::View<int *, MemorySpace> return_offset(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::reduction::return_offset"),
+      n_fwd + 1);
+  KokkosExt::iota(space, return_offset);
+  communicateResultsBack(comm, space, out, return_offset, forwarded.ranks,
+                         forwarded.ids);
+
+  Kokkos::Profiling::pushRegion(
+      "ArborX::DistributedTree::spatial::postprocess_results");
+
+  // Merge results, appending the locally produced ones to the imports
+  int const n_imports = out.extent(0);
+  auto ids = forwarded.ids;
+  Kokkos::resize(Kokkos::view_alloc(space, Kokkos::WithoutInitializing), out,
+                 n_imports + n_self);
+  Kokkos::resize(Kokkos::view_alloc(space, Kokkos::WithoutInitializing), ids,
+                 n_imports + n_self);
+  Kokkos::parallel_for(
+      "ArborX::DistributedTree::query::reduction::append_self_results",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_self),
+      KOKKOS_LAMBDA(int k) {
+        out(n_imports + k) = self_out(k);
+        ids(n_imports + k) = self_ids(k);
+      });
+
+  countResults(space, n_queries, ids, offset);
+  sortResults(space, ids, out);
+
+  Kokkos::Profiling::popRegion();
+}
+
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename OutputView, typename OffsetView, typename Callback>
+void DistributedTreeImpl::queryDispatchSpatial(
+    Tree const &tree, ExecutionSpace const &space, Predicates const &queries,
+    Callback const &callback, OutputView &out, OffsetView &offset,
+    Experimental::CommunicationPlan<typename Tree::memory_space> *plan,
+    Experimental::GhostCache<typename Tree::memory_space> *ghost)
+{
+  if constexpr (is_tagged_reduction_post_callback<Callback>::value)
+  {
+    // The plan replay and the ghost cache both key on raw per-match results
+    ARBORX_ASSERT(plan == nullptr && ghost == nullptr);
+    queryDispatchSpatialReduction(tree, space, queries, callback, out, offset);
+    return;
+  }
+
+  if (tree._replicated)
+  {
+    // Every rank holds the entire tree: the query is a purely local
+    // traversal, and there are no imports to plan or cache
+    ARBORX_ASSERT(plan == nullptr && ghost == nullptr);
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::DistributedTree::query::spatial_replicated");
+    query(tree._bottom_tree, space, queries, callback, out, offset);
+    return;
+  }
+
+  if (tree._group_size > 0)
+  {
+    // The hierarchical routing rebuilds its two distributors every call and
+    // never caches imports
+    ARBORX_ASSERT(plan == nullptr && ghost == nullptr);
+    queryDispatchSpatialHierarchical(tree, space, queries, callback, out,
+                                     offset);
+    return;
+  }
+
   Kokkos::Profiling::ScopedRegion guard(
       "ArborX::DistributedTree::query::spatial");
 
@@ -52,12 +627,16 @@ DistributedTreeImpl::queryDispatch(SpatialPredicateTag, Tree const &tree,
   auto const &bottom_tree = tree._bottom_tree;
   auto comm = tree.getComm();
 
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+
   Kokkos::View<int *, MemorySpace> indices(
       "ArborX::DistributedTree::query::spatial::indices", 0);
-  Kokkos::View<int *, MemorySpace> ranks(
-      "ArborX::DistributedTree::query::spatial::ranks", 0);
   query(top_tree, space, queries, indices, offset);
 
+  if (tree._n_fragments > 1)
+    mapFragmentsToRanks(space, tree._n_fragments, indices, offset);
+
   {
     // NOTE_COMM_SPATIAL: The communication pattern here for the spatial search
     // is identical to that of the nearest search (see NOTE_COMM_NEAREST). The
@@ -65,27 +644,159 @@ DistributedTreeImpl::queryDispatch(SpatialPredicateTag, Tree const &tree,
     // - usage of callbacks
     // - no explicit distances
     // - no results filtering
+    //
+    // Unlike the nearest search, the communication is overlapped with
+    // computation: predicates whose only destination would be this very rank
+    // are not round-tripped through MPI but are traversed locally while the
+    // exchange of the remote-destined predicates is in flight.
 
-    // Forward queries
     using Query = typename Predicates::value_type;
-    Kokkos::View<int *, MemorySpace> ids(
-        "ArborX::DistributedTree::query::spatial::query_ids", 0);
-    Kokkos::View<Query *, MemorySpace> fwd_queries(
-        "ArborX::DistributedTree::query::spatial::fwd_queries", 0);
-    forwardQueries(comm, space, queries, indices, offset, fwd_queries, ids,
-                   ranks);
 
-    // Perform queries that have been received
-    query(bottom_tree, space, fwd_queries, callback, out, offset);
+    int const n_queries = queries.size();
 
-    // Communicate results back
-    communicateResultsBack(comm, space, out, offset, ranks, ids);
+    // Separate the rank's own rank from the destinations found in the top
+    // tree. Each query lists each destination rank at most once, so a query
+    // contributes at most one self entry.
+    Kokkos::View<int *, MemorySpace> remote_offset(
+        "ArborX::DistributedTree::query::spatial::remote_offset",
+        n_queries + 1);
+    Kokkos::View<int *, MemorySpace> self_offset(
+        "ArborX::DistributedTree::query::spatial::self_offset", n_queries + 1);
+    Kokkos::parallel_for(
+        "ArborX::DistributedTree::query::spatial::count_destinations",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int q) {
+          for (int i = offset(q); i < offset(q + 1); ++i)
+          {
+            if (indices(i) == comm_rank)
+              ++self_offset(q);
+            else
+              ++remote_offset(q);
+          }
+        });
+    KokkosExt::exclusive_scan(space, remote_offset, remote_offset, 0);
+    KokkosExt::exclusive_scan(space, self_offset, self_offset, 0);
 
-    Kokkos::Profiling::pushRegion(
-        "ArborX::DistributedTree::spatial::postprocess_results");
+    int const n_remote = KokkosExt::lastElement(space, remote_offset);
+    int const n_self = KokkosExt::lastElement(space, self_offset);
+
+    Kokkos::View<int *, MemorySpace> remote_indices(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedTree::query::spatial::remote_indices"),
+        n_remote);
+    Kokkos::View<int *, MemorySpace> self_ids(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedTree::query::spatial::self_ids"),
+        n_self);
+    Kokkos::View<Query *, MemorySpace> self_queries(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedTree::query::spatial::self_queries"),
+        n_self);
+    Kokkos::parallel_for(
+        "ArborX::DistributedTree::query::spatial::split_destinations",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int q) {
+          int j = remote_offset(q);
+          for (int i = offset(q); i < offset(q + 1); ++i)
+          {
+            if (indices(i) == comm_rank)
+            {
+              self_ids(self_offset(q)) = q;
+              self_queries(self_offset(q)) = queries(q);
+            }
+            else
+            {
+              remote_indices(j++) = indices(i);
+            }
+          }
+        });
+
+    // Start forwarding the remote-destined predicates. When the ghost cache
+    // holds the remote contribution from a previous query with the same
+    // epoch, both exchanges and the remote traversal are skipped entirely.
+    bool const use_cached_imports = (ghost != nullptr && ghost->valid());
+    ForwardedQueries<MemorySpace, Query> forwarded;
+    if (!use_cached_imports)
+      forwarded = plan ? forwardQueriesBegin(comm, space, queries,
+                                             remote_indices, remote_offset,
+                                             *plan)
+                       : forwardQueriesBegin(comm, space, queries,
+                                             remote_indices, remote_offset);
+
+    // Perform the queries this rank keeps while the exchange is in flight
+    OutputView self_out(
+        Kokkos::view_alloc(space,
+                           "ArborX::DistributedTree::query::spatial::self_out"),
+        0);
+    Kokkos::View<int *, MemorySpace> self_result_offset(
+        "ArborX::DistributedTree::query::spatial::self_result_offset", 0);
+    query(bottom_tree, space, self_queries, callback, self_out,
+          self_result_offset);
+
+    int const n_self_results = self_out.extent(0);
+    int n_imports;
+    Kokkos::View<int *, MemorySpace> ids;
+    if (!use_cached_imports)
+    {
+      // Perform queries that have been received
+      forwarded.wait();
+      query(bottom_tree, space, forwarded.queries, callback, out, offset);
+
+      // Communicate results back
+      communicateResultsBack(comm, space, out, offset, forwarded.ranks,
+                             forwarded.ids);
+
+      if (ghost)
+        ghost->store(space, out, forwarded.ids);
+
+      Kokkos::Profiling::pushRegion(
+          "ArborX::DistributedTree::spatial::postprocess_results");
+
+      // Merge results, appending the locally produced ones to the imports
+      n_imports = out.extent(0);
+      ids = forwarded.ids;
+      Kokkos::resize(Kokkos::view_alloc(space, Kokkos::WithoutInitializing),
+                     out, n_imports + n_self_results);
+      Kokkos::resize(Kokkos::view_alloc(space, Kokkos::WithoutInitializing),
+                     ids, n_imports + n_self_results);
+    }
+    else
+    {
+      Kokkos::Profiling::pushRegion(
+          "ArborX::DistributedTree::spatial::postprocess_results");
+
+      // Merge results, appending the locally produced ones to the cached
+      // imports of the previous query
+      using Value = typename OutputView::non_const_value_type;
+      n_imports = ghost->size();
+      KokkosExt::reallocWithoutInitializing(space, out,
+                                            n_imports + n_self_results);
+      Kokkos::deep_copy(space,
+                        Kokkos::subview(out, std::make_pair(0, n_imports)),
+                        ghost->template values<Value>(n_imports));
+      ids = Kokkos::View<int *, MemorySpace>(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                             "ArborX::DistributedTree::query::spatial::ids"),
+          n_imports + n_self_results);
+      Kokkos::deep_copy(space,
+                        Kokkos::subview(ids, std::make_pair(0, n_imports)),
+                        ghost->ids());
+    }
+    Kokkos::parallel_for(
+        "ArborX::DistributedTree::query::spatial::append_self_results",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_self),
+        KOKKOS_LAMBDA(int k) {
+          for (int j = self_result_offset(k); j < self_result_offset(k + 1);
+               ++j)
+          {
+            out(n_imports + j) = self_out(j);
+            ids(n_imports + j) = self_ids(k);
+          }
+        });
 
-    // Merge results
-    int const n_queries = queries.size();
     countResults(space, n_queries, ids, offset);
     sortResults(space, ids, out);
 
@@ -93,6 +804,273 @@ DistributedTreeImpl::queryDispatch(SpatialPredicateTag, Tree const &tree,
   }
 }
 
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename OutputView, typename OffsetView, typename Callback>
+std::enable_if_t<Kokkos::is_view<OutputView>{} && Kokkos::is_view<OffsetView>{}>
+DistributedTreeImpl::queryDispatch(SpatialPredicateTag, Tree const &tree,
+                                   ExecutionSpace const &space,
+                                   Predicates const &queries,
+                                   Callback const &callback, OutputView &out,
+                                   OffsetView &offset)
+{
+  using MemorySpace = typename Tree::memory_space;
+  queryDispatchSpatial(
+      tree, space, queries, callback, out, offset,
+      static_cast<Experimental::CommunicationPlan<MemorySpace> *>(nullptr),
+      static_cast<Experimental::GhostCache<MemorySpace> *>(nullptr));
+}
+
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename OutputView, typename OffsetView, typename Callback>
+std::enable_if_t<Kokkos::is_view<OutputView>{} && Kokkos::is_view<OffsetView>{}>
+DistributedTreeImpl::queryDispatch(
+    SpatialPredicateTag, Tree const &tree, ExecutionSpace const &space,
+    Predicates const &queries, Callback const &callback, OutputView &out,
+    OffsetView &offset,
+    Experimental::CommunicationPlan<typename Tree::memory_space> &plan)
+{
+  queryDispatchSpatial(
+      tree, space, queries, callback, out, offset, &plan,
+      static_cast<Experimental::GhostCache<typename Tree::memory_space> *>(
+          nullptr));
+}
+
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename OutputView, typename OffsetView, typename Callback>
+std::enable_if_t<Kokkos::is_view<OutputView>{} && Kokkos::is_view<OffsetView>{}>
+DistributedTreeImpl::queryDispatch(
+    SpatialPredicateTag, Tree const &tree, ExecutionSpace const &space,
+    Predicates const &queries, Callback const &callback, OutputView &out,
+    OffsetView &offset,
+    Experimental::GhostCache<typename Tree::memory_space> &ghost)
+{
+  queryDispatchSpatial(
+      tree, space, queries, callback, out, offset,
+      static_cast<Experimental::CommunicationPlan<
+          typename Tree::memory_space> *>(nullptr),
+      &ghost);
+}
+
+// Completion step of an asynchronous spatial query: runs once the forwarded
+// predicates have arrived. A named functor rather than a lambda because its
+// body launches kernels, which extended device lambdas cannot do from
+// within another lambda.
+template <typename BottomTree, typename ExecutionSpace, typename Callback,
+          typename OutputView, typename OffsetView, typename Query>
+struct SpatialQueryFinish
+{
+  using MemorySpace = typename BottomTree::memory_space;
+
+  MPI_Comm _comm;
+  ExecutionSpace _space;
+  BottomTree _bottom_tree;
+  Callback _callback;
+  std::shared_ptr<DistributedTree::ForwardedQueries<MemorySpace, Query>>
+      _forwarded;
+  Kokkos::View<int *, MemorySpace> _self_ids;
+  OutputView _self_out;
+  Kokkos::View<int *, MemorySpace> _self_result_offset;
+  int _n_queries;
+  int _n_self;
+  OutputView *_out;
+  OffsetView *_offset;
+
+  void operator()() const
+  {
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::DistributedTree::queryAsync::spatial::finish");
+
+    using namespace DistributedTree;
+
+    auto const &space = _space;
+    auto &out = *_out;
+    auto &offset = *_offset;
+
+    // Perform queries that have been received
+    query(_bottom_tree, space, _forwarded->queries, _callback, out, offset);
+
+    // Communicate results back
+    communicateResultsBack(_comm, space, out, offset, _forwarded->ranks,
+                           _forwarded->ids);
+
+    // Merge results, appending the locally produced ones to the imports
+    int const n_imports = out.extent(0);
+    int const n_self_results = _self_out.extent(0);
+    auto ids = _forwarded->ids;
+    Kokkos::resize(Kokkos::view_alloc(space, Kokkos::WithoutInitializing), out,
+                   n_imports + n_self_results);
+    Kokkos::resize(Kokkos::view_alloc(space, Kokkos::WithoutInitializing), ids,
+                   n_imports + n_self_results);
+    // Local copies so that the device lambda does not capture this
+    auto self_out = _self_out;
+    auto self_ids = _self_ids;
+    auto self_result_offset = _self_result_offset;
+    auto merged_out = out;
+    Kokkos::parallel_for(
+        "ArborX::DistributedTree::query::spatial::append_self_results",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, _n_self),
+        KOKKOS_LAMBDA(int k) {
+          for (int j = self_result_offset(k); j < self_result_offset(k + 1);
+               ++j)
+          {
+            merged_out(n_imports + j) = self_out(j);
+            ids(n_imports + j) = self_ids(k);
+          }
+        });
+
+    countResults(space, _n_queries, ids, offset);
+    sortResults(space, ids, out);
+  }
+};
+
+// Asynchronous spatial query: posts the forwarding of the remote-destined
+// predicates, launches the rank's own traversal on the provided execution
+// space instance, and returns a handle. The remaining phases — traversing
+// the predicates received from other ranks and returning their results —
+// run when the handle completes (see Experimental::QueryRequest).
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename OutputView, typename OffsetView, typename Callback>
+std::enable_if_t<Kokkos::is_view<OutputView>{} && Kokkos::is_view<OffsetView>{},
+                 Experimental::QueryRequest>
+DistributedTreeImpl::queryDispatchAsync(SpatialPredicateTag, Tree const &tree,
+                                        ExecutionSpace const &space,
+                                        Predicates const &queries,
+                                        Callback const &callback,
+                                        OutputView &out, OffsetView &offset)
+{
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::DistributedTree::queryAsync::spatial");
+
+  static_assert(!is_tagged_reduction_post_callback<Callback>::value,
+                "Reduction post callbacks are only supported by the "
+                "synchronous query()");
+
+  // Not supported over a hierarchical top tree: the two-hop routing has no
+  // overlap window to hand back to the caller
+  ARBORX_ASSERT(tree._group_size == 0);
+  // Nor over a replicated tree, which has no communication to overlap
+  ARBORX_ASSERT(!tree._replicated);
+
+  using namespace DistributedTree;
+  using MemorySpace = typename Tree::memory_space;
+  using Query = typename Predicates::value_type;
+
+  auto const &top_tree = tree._top_tree;
+  auto bottom_tree = tree._bottom_tree;
+  auto comm = tree.getComm();
+
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+
+  Kokkos::View<int *, MemorySpace> indices(
+      "ArborX::DistributedTree::query::spatial::indices", 0);
+  query(top_tree, space, queries, indices, offset);
+
+  if (tree._n_fragments > 1)
+    mapFragmentsToRanks(space, tree._n_fragments, indices, offset);
+
+  int const n_queries = queries.size();
+
+  // Same self/remote split as the synchronous path above
+  Kokkos::View<int *, MemorySpace> remote_offset(
+      "ArborX::DistributedTree::query::spatial::remote_offset", n_queries + 1);
+  Kokkos::View<int *, MemorySpace> self_offset(
+      "ArborX::DistributedTree::query::spatial::self_offset", n_queries + 1);
+  Kokkos::parallel_for(
+      "ArborX::DistributedTree::query::spatial::count_destinations",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int q) {
+        for (int i = offset(q); i < offset(q + 1); ++i)
+        {
+          if (indices(i) == comm_rank)
+            ++self_offset(q);
+          else
+            ++remote_offset(q);
+        }
+      });
+  KokkosExt::exclusive_scan(space, remote_offset, remote_offset, 0);
+  KokkosExt::exclusive_scan(space, self_offset, self_offset, 0);
+
+  int const n_remote = KokkosExt::lastElement(space, remote_offset);
+  int const n_self = KokkosExt::lastElement(space, self_offset);
+
+  Kokkos::View<int *, MemorySpace> remote_indices(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::spatial::remote_indices"),
+      n_remote);
+  Kokkos::View<int *, MemorySpace> self_ids(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::DistributedTree::query::spatial::self_ids"),
+      n_self);
+  Kokkos::View<Query *, MemorySpace> self_queries(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::DistributedTree::query::spatial::self_queries"),
+      n_self);
+  Kokkos::parallel_for(
+      "ArborX::DistributedTree::query::spatial::split_destinations",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int q) {
+        int j = remote_offset(q);
+        for (int i = offset(q); i < offset(q + 1); ++i)
+        {
+          if (indices(i) == comm_rank)
+          {
+            self_ids(self_offset(q)) = q;
+            self_queries(self_offset(q)) = queries(q);
+          }
+          else
+          {
+            remote_indices(j++) = indices(i);
+          }
+        }
+      });
+
+  // The handle owns the exchange; its buffers must outlive this function
+  auto forwarded = std::make_shared<ForwardedQueries<MemorySpace, Query>>(
+      forwardQueriesBegin(comm, space, queries, remote_indices,
+                          remote_offset));
+
+  // Launch the queries this rank keeps; they proceed asynchronously on the
+  // caller's execution space instance alongside the caller's own work
+  OutputView self_out(
+      Kokkos::view_alloc(space,
+                         "ArborX::DistributedTree::query::spatial::self_out"),
+      0);
+  Kokkos::View<int *, MemorySpace> self_result_offset(
+      "ArborX::DistributedTree::query::spatial::self_result_offset", 0);
+  query(bottom_tree, space, self_queries, callback, self_out,
+        self_result_offset);
+
+  SpatialQueryFinish<decltype(bottom_tree), ExecutionSpace, Callback,
+                     OutputView, OffsetView, Query>
+      finish{comm,      space,    bottom_tree, callback,
+             forwarded, self_ids, self_out,    self_result_offset,
+             n_queries, n_self,   &out,        &offset};
+
+  return {[forwarded]() { return forwarded->test(); },
+          [forwarded]() { forwarded->wait(); }, std::move(finish)};
+}
+
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename IndicesAndRanks, typename Offset>
+std::enable_if_t<Kokkos::is_view<IndicesAndRanks>{} &&
+                     Kokkos::is_view<Offset>{},
+                 Experimental::QueryRequest>
+DistributedTreeImpl::queryDispatchAsync(SpatialPredicateTag, Tree const &tree,
+                                        ExecutionSpace const &space,
+                                        Predicates const &queries,
+                                        IndicesAndRanks &values,
+                                        Offset &offset)
+{
+  int comm_rank;
+  MPI_Comm_rank(tree.getComm(), &comm_rank);
+  return queryDispatchAsync(SpatialPredicateTag{}, tree, space, queries,
+                            DefaultCallbackWithRank{comm_rank}, values,
+                            offset);
+}
+
 template <typename Tree, typename ExecutionSpace, typename Predicates,
           typename IndicesAndRanks, typename Offset>
 std::enable_if_t<Kokkos::is_view<IndicesAndRanks>{} &&
@@ -102,12 +1080,52 @@ DistributedTreeImpl::queryDispatch(SpatialPredicateTag, Tree const &tree,
                                    Predicates const &queries,
                                    IndicesAndRanks &values, Offset &offset)
 {
+  if (tree._replicated)
+  {
+    // The local traversal yields global indices; hand out owner-local
+    // indices and owning ranks like the forwarding-based modes do
+    queryDispatch(SpatialPredicateTag{}, tree, space, queries,
+                  ReplicatedCallbackWithRank<decltype(tree._rank_offset)>{
+                      tree._rank_offset},
+                  values, offset);
+    return;
+  }
   int comm_rank;
   MPI_Comm_rank(tree.getComm(), &comm_rank);
   queryDispatch(SpatialPredicateTag{}, tree, space, queries,
                 DefaultCallbackWithRank{comm_rank}, values, offset);
 }
 
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename IndicesAndRanks, typename Offset>
+std::enable_if_t<Kokkos::is_view<IndicesAndRanks>{} &&
+                 Kokkos::is_view<Offset>{}>
+DistributedTreeImpl::queryDispatch(
+    SpatialPredicateTag, Tree const &tree, ExecutionSpace const &space,
+    Predicates const &queries, IndicesAndRanks &values, Offset &offset,
+    Experimental::CommunicationPlan<typename Tree::memory_space> &plan)
+{
+  int comm_rank;
+  MPI_Comm_rank(tree.getComm(), &comm_rank);
+  queryDispatch(SpatialPredicateTag{}, tree, space, queries,
+                DefaultCallbackWithRank{comm_rank}, values, offset, plan);
+}
+
+template <typename Tree, typename ExecutionSpace, typename Predicates,
+          typename IndicesAndRanks, typename Offset>
+std::enable_if_t<Kokkos::is_view<IndicesAndRanks>{} &&
+                 Kokkos::is_view<Offset>{}>
+DistributedTreeImpl::queryDispatch(
+    SpatialPredicateTag, Tree const &tree, ExecutionSpace const &space,
+    Predicates const &queries, IndicesAndRanks &values, Offset &offset,
+    Experimental::GhostCache<typename Tree::memory_space> &ghost)
+{
+  int comm_rank;
+  MPI_Comm_rank(tree.getComm(), &comm_rank);
+  queryDispatch(SpatialPredicateTag{}, tree, space, queries,
+                DefaultCallbackWithRank{comm_rank}, values, offset, ghost);
+}
+
 } // namespace ArborX::Details
 
 #endif
@@ -0,0 +1,145 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_EDGE_CONTRACTION_HPP
+#define ARBORX_DETAILS_EDGE_CONTRACTION_HPP
+
+#include <ArborX_DetailsWeightedEdge.hpp>
+
+#include <Kokkos_BitManipulation.hpp>
+#include <Kokkos_Core.hpp>
+
+#include <climits>
+
+namespace ArborX::Details
+{
+
+// Lock-free Boruvka over an explicit edge list (in the spirit of ECL-MST).
+// Each round, every live edge proposes itself to the components of both of
+// its endpoints through a 64-bit atomic min; the proposal packs the weight
+// bits above the edge index, so a component slot ends up holding its
+// minimum-weight outgoing edge, with ties broken deterministically by edge
+// index. Winning edges are then committed and their components merged with
+// CAS updates only. Since the proposal order is a strict total order shared
+// by all components, the edges committed in a round never close a cycle.
+
+// Weights are non-negative, so comparing their bit patterns as unsigned
+// integers is equivalent to comparing the floats themselves.
+template <class CandidateEdges>
+KOKKOS_FUNCTION unsigned long long packedEdgeProposal(
+    CandidateEdges const &candidates, int e)
+{
+  return (static_cast<unsigned long long>(
+              Kokkos::bit_cast<unsigned int>(candidates(e).weight))
+          << 32) +
+         static_cast<unsigned int>(e);
+}
+
+template <class CandidateEdges, class UnionFind, class Proposals>
+struct ProposeComponentEdges
+{
+  CandidateEdges _candidates;
+  UnionFind _union_find;
+  Proposals _proposals;
+
+  KOKKOS_FUNCTION void operator()(int e) const
+  {
+    auto const &edge = _candidates(e);
+    auto const i = _union_find.representative(edge.source);
+    auto const j = _union_find.representative(edge.target);
+    if (i == j)
+      return;
+
+    auto const proposal = packedEdgeProposal(_candidates, e);
+    Kokkos::atomic_min(&_proposals(i), proposal);
+    Kokkos::atomic_min(&_proposals(j), proposal);
+  }
+};
+
+template <class CandidateEdges, class UnionFind, class Proposals, class Edges,
+          class EdgesCount>
+struct CommitComponentEdges
+{
+  CandidateEdges _candidates;
+  UnionFind _union_find;
+  Proposals _proposals;
+  Edges _edges;
+  EdgesCount _num_edges;
+
+  KOKKOS_FUNCTION void operator()(int e, int &num_committed) const
+  {
+    auto const &edge = _candidates(e);
+    auto const i = _union_find.representative(edge.source);
+    auto const j = _union_find.representative(edge.target);
+    if (i == j)
+      return;
+
+    // Each edge is examined exactly once per round, so an edge that won the
+    // slot of either endpoint's component is committed exactly once even
+    // when it won both.
+    auto const proposal = packedEdgeProposal(_candidates, e);
+    if (_proposals(i) != proposal && _proposals(j) != proposal)
+      return;
+
+    auto const back = Kokkos::atomic_fetch_inc(&_num_edges());
+    _edges(back) = edge;
+    _union_find.merge(i, j);
+    ++num_committed;
+  }
+};
+
+// Compute the minimum spanning forest of the given explicit edge list,
+// appending the chosen edges to `edges` (starting at `num_edges`, which is
+// updated) and merging the endpoints' components in `union_find`. Unused
+// candidate slots may be filled with self-loops; they are skipped. The
+// result is exact for the candidate graph; whether it is the minimum
+// spanning tree of an underlying point set depends on the candidate graph
+// containing the tree's edges.
+template <class ExecutionSpace, class CandidateEdges, class UnionFind,
+          class Edges, class EdgesCount>
+void contractEdges(ExecutionSpace const &space, int n,
+                   CandidateEdges const &candidates,
+                   UnionFind const &union_find, Edges const &edges,
+                   EdgesCount const &num_edges)
+{
+  using MemorySpace = typename CandidateEdges::memory_space;
+
+  auto const num_candidates = candidates.extent_int(0);
+
+  Kokkos::View<unsigned long long *, MemorySpace> proposals(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::MST::edge_proposals"),
+      n);
+
+  int num_committed;
+  do
+  {
+    Kokkos::deep_copy(space, proposals, ULLONG_MAX);
+
+    Kokkos::parallel_for(
+        "ArborX::MST::propose_component_edges",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_candidates),
+        ProposeComponentEdges<CandidateEdges, UnionFind, decltype(proposals)>{
+            candidates, union_find, proposals});
+
+    Kokkos::parallel_reduce(
+        "ArborX::MST::commit_component_edges",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_candidates),
+        CommitComponentEdges<CandidateEdges, UnionFind, decltype(proposals),
+                             Edges, EdgesCount>{candidates, union_find,
+                                                proposals, edges, num_edges},
+        num_committed);
+  } while (num_committed > 0);
+}
+
+} // namespace ArborX::Details
+
+#endif
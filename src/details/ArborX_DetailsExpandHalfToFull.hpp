@@ -20,6 +20,11 @@
 namespace ArborX::Details
 {
 
+// Convert a half neighbor list (each pair stored once, in the row of one of
+// its endpoints) into a full one (each pair stored in both rows), in place.
+// Both kernels parallelize over the entries of a row, so a few long rows do
+// not serialize the conversion. A single-kernel version is not possible: no
+// index can be placed before the new offsets have been scanned.
 template <class ExecutionSpace, class Offsets, class Indices>
 void expandHalfToFull(ExecutionSpace const &space, Offsets &offsets,
                       Indices &indices)
@@ -33,13 +38,19 @@ void expandHalfToFull(ExecutionSpace const &space, Offsets &offsets,
   Kokkos::deep_copy(space, offsets, 0);
   Kokkos::parallel_for(
       "ArborX::Experimental::HalfToFull::count",
-      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
-        for (int j = offsets_orig(i); j < offsets_orig(i + 1); ++j)
-        {
-          int const k = indices_orig(j);
-          Kokkos::atomic_increment(&offsets(i));
-          Kokkos::atomic_increment(&offsets(k));
-        }
+      Kokkos::TeamPolicy<ExecutionSpace>(space, n, Kokkos::AUTO, 1),
+      KOKKOS_LAMBDA(
+          typename Kokkos::TeamPolicy<ExecutionSpace>::member_type const
+              &member) {
+        auto const i = member.league_rank();
+        auto const first = offsets_orig(i);
+        auto const last = offsets_orig(i + 1);
+        Kokkos::parallel_for(
+            Kokkos::TeamVectorRange(member, last - first), [&](int j) {
+              int const k = indices_orig(first + j);
+              Kokkos::atomic_increment(&offsets(i));
+              Kokkos::atomic_increment(&offsets(k));
+            });
       });
   KokkosExt::exclusive_scan(space, offsets, offsets, 0);
 
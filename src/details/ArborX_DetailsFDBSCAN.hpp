@@ -13,6 +13,7 @@
 #define ARBORX_DETAILSFDBSCAN_HPP
 
 #include <ArborX_Callbacks.hpp>
+#include <ArborX_DetailsKokkosExtMinMaxOperations.hpp>
 #include <ArborX_DetailsUnionFind.hpp>
 #include <ArborX_Predicates.hpp>
 
@@ -43,6 +44,121 @@ struct CountUpToN
   }
 };
 
+// Weighted analogue of CountUpToN for points carrying a multiplicity:
+// accumulates the weight of the encountered neighbors and terminates the
+// traversal once the core threshold is reached. With unit weights this
+// degenerates to neighbor counting.
+template <typename MemorySpace, typename Weights>
+struct CountUpToWeight
+{
+  Kokkos::View<float *, MemorySpace> _weight_sums;
+  Weights _weights;
+  float _threshold;
+
+  template <typename Query, typename Value>
+  KOKKOS_FUNCTION auto operator()(Query const &query, Value const &value) const
+  {
+    auto i = getData(query);
+    Kokkos::atomic_add(&_weight_sums(i), (float)_weights(value.index));
+
+    if (_weight_sums(i) < _threshold)
+      return ArborX::CallbackTreeTraversalControl::normal_continuation;
+
+    // Once the accumulated weight reaches the threshold, terminate the
+    // traversal.
+    return ArborX::CallbackTreeTraversalControl::early_exit;
+  }
+};
+
+// Fused single-traversal formulation of FDBSCAN for modest core_min_size.
+// Instead of determining core points with a separate counting pass, every
+// pair updates the neighbor counts of both endpoints and connectivity is
+// established along the way:
+// - a pair of points that are both already core is merged immediately;
+// - a point that is not yet core remembers the neighbor in a bounded
+//   per-point buffer (a point only ever needs to remember the neighbors
+//   seen before it turned core, of which there are at most
+//   core_min_size - 2).
+// The buffered pairs are resolved by FDBSCANFusedFinalize once all the
+// counts are known, reproducing exactly the FDBSCANCallback semantics while
+// walking the tree once per point instead of twice.
+template <typename UnionFind, typename MemorySpace>
+struct FDBSCANFusedCallback
+{
+  UnionFind _union_find;
+  Kokkos::View<int *, MemorySpace> _num_neigh;
+  Kokkos::View<int *, MemorySpace> _buffer;
+  int _core_min_size;
+
+  KOKKOS_FUNCTION auto operator()(int i, int j) const
+  {
+    // Counts start at one as every point is its own neighbor
+    int const old_i = Kokkos::atomic_fetch_add(&_num_neigh(i), 1);
+    int const old_j = Kokkos::atomic_fetch_add(&_num_neigh(j), 1);
+
+    // Whether the point is core counting this pair in
+    bool const i_is_core = (old_i >= _core_min_size - 1);
+    bool const j_is_core = (old_j >= _core_min_size - 1);
+
+    if (i_is_core && j_is_core)
+    {
+      _union_find.merge(i, j);
+      return ArborX::CallbackTreeTraversalControl::normal_continuation;
+    }
+
+    int const buffer_width = _core_min_size - 2;
+    if (!i_is_core)
+      _buffer(i * buffer_width + old_i - 1) = j;
+    if (!j_is_core)
+      _buffer(j * buffer_width + old_j - 1) = i;
+
+    return ArborX::CallbackTreeTraversalControl::normal_continuation;
+  }
+};
+
+template <typename UnionFind, typename MemorySpace>
+struct FDBSCANFusedFinalize
+{
+  UnionFind _union_find;
+  Kokkos::View<int *, MemorySpace> _num_neigh;
+  Kokkos::View<int *, MemorySpace> _buffer;
+  int _core_min_size;
+
+  KOKKOS_FUNCTION void operator()(int i) const
+  {
+    int const buffer_width = _core_min_size - 2;
+    int const num_stored = KokkosExt::min(_num_neigh(i) - 1, buffer_width);
+
+    if (_num_neigh(i) >= _core_min_size)
+    {
+      // A core point that turned core late: connect to the neighbors seen
+      // before that
+      for (int s = 0; s < num_stored; ++s)
+      {
+        int const j = _buffer(i * buffer_width + s);
+        if (_num_neigh(j) >= _core_min_size)
+          _union_find.merge(i, j);
+        else
+          _union_find.merge_into(j, i); // see NOTE in FDBSCANCallback
+      }
+    }
+    else
+    {
+      // A border point saw all of its neighbors before the buffer could
+      // fill up; attach it to any core one
+      for (int s = 0; s < num_stored; ++s)
+      {
+        int const j = _buffer(i * buffer_width + s);
+        if (_num_neigh(j) >= _core_min_size)
+        {
+          _union_find.merge_into(i, j); // see NOTE in FDBSCANCallback
+          break;
+        }
+      }
+    }
+  }
+};
+
 template <typename UnionFind, typename CorePointsType>
 struct FDBSCANCallback
 {
@@ -16,6 +16,7 @@
 #include <ArborX_DetailsCartesianGrid.hpp>
 #include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
 #include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsSortUtils.hpp>
 #include <ArborX_DetailsUnionFind.hpp>
 #include <ArborX_Predicates.hpp>
 
@@ -183,6 +184,251 @@ struct FDBSCANDenseBoxCallback
   }
 };
 
+// Callback for the low-dimensional stencil-specialized path, where only the
+// points in sparse cells issue tree queries (dense-dense connections are
+// established beforehand by mergeAdjacentDenseCells). It differs from
+// FDBSCANDenseBoxCallback in that a border query point does not terminate
+// the traversal but attaches itself to the first dense cell holding a point
+// within eps, a link the dense side would otherwise have made.
+template <typename UnionFind, typename CorePointsType, typename Primitives,
+          typename DenseCellOffsets, typename Permutation>
+struct FDBSCANDenseBoxSparseCallback
+{
+  UnionFind _union_find;
+  CorePointsType _is_core_point;
+  Primitives _primitives;
+  DenseCellOffsets _dense_cell_offsets;
+  int _num_dense_cells;
+  int _num_points_in_dense_cells;
+  Permutation _permute;
+  float eps;
+
+  template <typename ExecutionSpace>
+  FDBSCANDenseBoxSparseCallback(UnionFind const &union_find,
+                                CorePointsType const &is_core_point,
+                                Primitives const &primitives,
+                                DenseCellOffsets const &dense_cell_offsets,
+                                ExecutionSpace const &exec_space,
+                                Permutation const &permute, float eps_in)
+      : _union_find(union_find)
+      , _is_core_point(is_core_point)
+      , _primitives(primitives)
+      , _dense_cell_offsets(dense_cell_offsets)
+      , _num_dense_cells(dense_cell_offsets.size() - 1)
+      , _num_points_in_dense_cells(
+            KokkosExt::lastElement(exec_space, _dense_cell_offsets))
+      , _permute(permute)
+      , eps(eps_in)
+  {}
+
+  template <typename Query, typename Value>
+  KOKKOS_FUNCTION auto operator()(Query const &query, Value const &value) const
+  {
+    int const k = value.index;
+    auto const i = ArborX::getData(query);
+
+    bool const is_core_point = _is_core_point(i);
+    bool const is_dense_cell = (k < _num_dense_cells);
+
+    if (is_dense_cell)
+    {
+      int const cell_start = _dense_cell_offsets(k);
+      int const cell_end = _dense_cell_offsets(k + 1);
+
+      // Skip the dense box if they were already merged together
+      if (is_core_point &&
+          _union_find.representative(i) ==
+              _union_find.representative(_permute(cell_start)))
+        return CallbackTreeTraversalControl::normal_continuation;
+
+      auto const &query_point = _primitives(i);
+
+      for (int jj = cell_start; jj < cell_end; ++jj)
+      {
+        int j = _permute(jj);
+
+        if (is_core_point &&
+            _union_find.representative(i) == _union_find.representative(j))
+          break;
+
+        if (distance(query_point, _primitives(j)) <= eps)
+        {
+          if (is_core_point)
+          {
+            // We connected to at least one point in the dense box, thus we
+            // connected to all of them, so may terminate
+            _union_find.merge(i, j);
+            break;
+          }
+          // A border point belongs to a single cluster, so the first dense
+          // cell with a close enough point settles it
+          _union_find.merge_into(i, j);
+          return CallbackTreeTraversalControl::early_exit;
+        }
+      }
+    }
+    else
+    {
+      if (!is_core_point)
+        return CallbackTreeTraversalControl::normal_continuation;
+
+      int j = _permute(_num_points_in_dense_cells + (k - _num_dense_cells));
+
+      // No need to check the distance here, as the fact that we are inside the
+      // callback guarantees that it is <= eps
+
+      bool const is_neighbor_core_point = _is_core_point(j);
+      if (is_neighbor_core_point && i > j)
+        _union_find.merge(i, j);
+      else if (!is_neighbor_core_point)
+        _union_find.merge_into(j, i);
+    }
+
+    return CallbackTreeTraversalControl::normal_continuation;
+  }
+};
+
+// Merges every pair of dense cells holding two points within eps of each
+// other by walking the grid neighborhood of each dense cell directly,
+// without any tree involvement. With the dense-box cell length eps/sqrt(DIM)
+// a qualifying pair can sit at most two cells apart in every direction, so
+// the candidate stencil is 5^DIM cells, further pruned by the minimal gap
+// between the cells. Only meant for low dimensions where that stencil is
+// small.
+template <int DIM, typename ExecutionSpace, typename Points,
+          typename CellIndices, typename DenseCellOffsets,
+          typename Permutation, typename UnionFind>
+void mergeAdjacentDenseCells(ExecutionSpace const &exec_space,
+                             CartesianGrid<DIM> const &grid,
+                             Points const &points,
+                             CellIndices const &sorted_dense_cell_indices,
+                             DenseCellOffsets const &dense_cell_offsets,
+                             Permutation const &permute, float eps,
+                             UnionFind union_find)
+{
+  static_assert(DIM == 2 || DIM == 3);
+
+  using MemorySpace = typename Points::memory_space;
+
+  int const num_dense_cells = dense_cell_offsets.size() - 1;
+  if (num_dense_cells == 0)
+    return;
+
+  // The dense prefix of the reordered cell indices is not ordered by cell
+  // index, so stage one index per dense cell and sort them to allow binary
+  // searching the stencil candidates
+  Kokkos::View<size_t *, MemorySpace> cell_ids(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "ArborX::DBSCAN::dense_cell_ids"),
+      num_dense_cells);
+  Kokkos::parallel_for(
+      "ArborX::DBSCAN::extract_dense_cell_ids",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_dense_cells),
+      KOKKOS_LAMBDA(int c) {
+        cell_ids(c) = sorted_dense_cell_indices(dense_cell_offsets(c));
+      });
+  auto cell_permute = sortObjects(exec_space, cell_ids);
+
+  constexpr int stencil_width = 5;
+  constexpr int stencil_size = (DIM == 2 ? 25 : 125);
+
+  Kokkos::parallel_for(
+      "ArborX::DBSCAN::merge_adjacent_dense_cells",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, num_dense_cells),
+      KOKKOS_LAMBDA(int c) {
+        auto const my_id = cell_ids(c);
+        int const cell = cell_permute(c);
+
+        long long coord[DIM];
+        {
+          auto id = my_id;
+          for (int d = 0; d < DIM; ++d)
+          {
+            coord[d] = id % grid.extent(d);
+            id /= grid.extent(d);
+          }
+        }
+
+        for (int s = 0; s < stencil_size; ++s)
+        {
+          long long neighbor_coord[DIM];
+          float gap_sq = 0;
+          bool valid = true;
+          int t = s;
+          for (int d = 0; d < DIM; ++d)
+          {
+            int const offset = t % stencil_width - stencil_width / 2;
+            t /= stencil_width;
+            neighbor_coord[d] = coord[d] + offset;
+            if (neighbor_coord[d] < 0 ||
+                neighbor_coord[d] >= (long long)grid.extent(d))
+            {
+              valid = false;
+              break;
+            }
+            float const gap =
+                Kokkos::max(Kokkos::abs(offset) - 1, 0) * grid.cellSize(d);
+            gap_sq += gap * gap;
+          }
+          if (!valid || gap_sq > eps * eps)
+            continue;
+
+          size_t neighbor_id = 0;
+          for (int d = DIM - 1; d >= 0; --d)
+            neighbor_id = neighbor_id * grid.extent(d) + neighbor_coord[d];
+
+          // Process each pair of dense cells from its lower index only
+          if (neighbor_id <= my_id)
+            continue;
+
+          // Binary search for the candidate among the dense cells
+          int lo = 0;
+          int hi = num_dense_cells;
+          while (lo < hi)
+          {
+            int const mid = lo + (hi - lo) / 2;
+            if (cell_ids(mid) < neighbor_id)
+              lo = mid + 1;
+            else
+              hi = mid;
+          }
+          if (lo == num_dense_cells || cell_ids(lo) != neighbor_id)
+            continue;
+          int const neighbor_cell = cell_permute(lo);
+
+          int const my_start = dense_cell_offsets(cell);
+          int const my_end = dense_cell_offsets(cell + 1);
+          int const neighbor_start = dense_cell_offsets(neighbor_cell);
+          int const neighbor_end = dense_cell_offsets(neighbor_cell + 1);
+
+          bool done = false;
+          for (int ii = my_start; ii < my_end && !done; ++ii)
+          {
+            int const i = permute(ii);
+
+            // The cells may already be connected, possibly through a third
+            // one
+            if (union_find.representative(i) ==
+                union_find.representative(permute(neighbor_start)))
+              break;
+
+            auto const &query_point = points(i);
+            for (int jj = neighbor_start; jj < neighbor_end; ++jj)
+            {
+              int const j = permute(jj);
+              if (distance(query_point, points(j)) <= eps)
+              {
+                // One close pair connects both cells in full
+                union_find.merge(i, j);
+                done = true;
+                break;
+              }
+            }
+          }
+        }
+      });
+}
+
 template <typename ExecutionSpace, typename Primitives>
 Kokkos::View<size_t *, typename Primitives::memory_space>
 computeCellIndices(ExecutionSpace const &exec_space,
@@ -0,0 +1,56 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_DETAILS_GPU_AWARE_MPI_HPP
+#define ARBORX_DETAILS_GPU_AWARE_MPI_HPP
+
+#include <ArborX_Config.hpp>
+
+#include <cstdlib>
+
+#include <mpi.h>
+#if defined(OPEN_MPI)
+#include <mpi-ext.h>
+#endif
+
+namespace ArborX
+{
+namespace Details
+{
+
+// Whether device buffers may be passed directly to MPI calls, skipping the
+// host staging copies. Requires both compiling with
+// ARBORX_ENABLE_GPU_AWARE_MPI and an MPI library that actually supports it
+// at runtime: binaries move between machines, and passing device pointers
+// to an unaware MPI crashes deep inside the library. The runtime answer
+// comes from the MPI extension query when available, and may be overridden
+// either way with the ARBORX_GPU_AWARE_MPI environment variable (0 or 1).
+inline bool hasGpuAwareMpiSupport()
+{
+  static bool const value = [] {
+#ifdef ARBORX_ENABLE_GPU_AWARE_MPI
+    if (char const *env = std::getenv("ARBORX_GPU_AWARE_MPI"))
+      return std::atoi(env) != 0;
+#if defined(OPEN_MPI) && defined(MPIX_CUDA_AWARE_SUPPORT)
+    return MPIX_Query_cuda_support() == 1;
+#else
+    return true;
+#endif
+#else
+    return false;
+#endif
+  }();
+  return value;
+}
+
+} // namespace Details
+} // namespace ArborX
+
+#endif
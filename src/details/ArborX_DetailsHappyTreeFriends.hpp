@@ -26,6 +26,17 @@ namespace ArborX::Details
 
 struct HappyTreeFriends
 {
+  // Detects trees whose values layout splits the indices out of the leaves
+  // (see Experimental::ValuesSoA)
+  template <class BVH, class = void>
+  struct has_soa_values : std::false_type
+  {};
+
+  template <class BVH>
+  struct has_soa_values<BVH, std::enable_if_t<BVH::use_soa_values>>
+      : std::true_type
+  {};
+
   template <class BVH>
   static KOKKOS_FUNCTION int getRoot(BVH const &bvh)
   {
@@ -66,18 +77,45 @@ struct HappyTreeFriends
 #ifdef __HIP_DEVICE_COMPILE__
       auto
 #else
-      auto const &
+      decltype(auto)
 #endif
       getIndexable(BVH const &bvh, int i)
   {
-    return bvh._indexable_getter(getValue(bvh, i));
+    if constexpr (has_soa_values<BVH>::value)
+      return (bvh._leaf_nodes(i).value); // the leaves store the indexable
+    else
+      return bvh._indexable_getter(getValue(bvh, i));
+  }
+
+  template <class BVH>
+  static KOKKOS_FUNCTION auto const &getIndexableGetter(BVH const &bvh)
+  {
+    return bvh._indexable_getter;
+  }
+
+  // Whole-array access, for traversals that stage the tree into scratch
+  template <class BVH>
+  static KOKKOS_FUNCTION auto const &getLeafNodes(BVH const &bvh)
+  {
+    return bvh._leaf_nodes;
+  }
+
+  template <class BVH>
+  static KOKKOS_FUNCTION auto const &getInternalNodes(BVH const &bvh)
+  {
+    return bvh._internal_nodes;
   }
 
   template <class BVH>
-  static KOKKOS_FUNCTION auto const &getValue(BVH const &bvh, int i)
+  static KOKKOS_FUNCTION decltype(auto) getValue(BVH const &bvh, int i)
   {
     KOKKOS_ASSERT(i >= 0 && i < (int)bvh.size());
-    return bvh._leaf_nodes(i).value;
+    if constexpr (has_soa_values<BVH>::value)
+      // Reassemble the pair that the SoA layout stores split up
+      return typename BVH::value_type{bvh._leaf_nodes(i).value,
+                                      bvh._indices(i)};
+    else
+      return (bvh._leaf_nodes(i).value);
   }
 
   template <class BVH>
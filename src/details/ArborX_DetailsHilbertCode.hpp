@@ -0,0 +1,117 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_HILBERT_CODE_HPP
+#define ARBORX_DETAILS_HILBERT_CODE_HPP
+
+#include <ArborX_DetailsKokkosExtMinMaxOperations.hpp> // min, max
+#include <ArborX_DetailsMortonCode.hpp>                // expandBitsBy
+#include <ArborX_GeometryTraits.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX
+{
+
+namespace Details
+{
+
+// Convert per-axis grid coordinates into the "transpose" form of the Hilbert
+// index (Skilling, "Programming the Hilbert curve", 2004). After the
+// transform, interleaving the bits of the coordinates (exactly as for a
+// Morton code) yields the Hilbert index.
+template <int DIM, typename Integer>
+KOKKOS_INLINE_FUNCTION void axesToTranspose(Integer (&x)[DIM], int bits)
+{
+  Integer const m = (Integer)1 << (bits - 1);
+
+  // Inverse undo
+  for (Integer q = m; q > 1; q >>= 1)
+  {
+    Integer const p = q - 1;
+    for (int i = 0; i < DIM; ++i)
+    {
+      if (x[i] & q)
+        x[0] ^= p;
+      else
+      {
+        Integer const t = (x[0] ^ x[i]) & p;
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+    }
+  }
+
+  // Gray encode
+  for (int i = 1; i < DIM; ++i)
+    x[i] ^= x[i - 1];
+  Integer t = 0;
+  for (Integer q = m; q > 1; q >>= 1)
+    if (x[DIM - 1] & q)
+      t ^= q - 1;
+  for (int i = 0; i < DIM; ++i)
+    x[i] ^= t;
+}
+
+template <typename Point,
+          typename Enable = std::enable_if_t<GeometryTraits::is_point<Point>{}>>
+KOKKOS_INLINE_FUNCTION unsigned int hilbert32(Point const &p)
+{
+  constexpr int DIM = GeometryTraits::dimension_v<Point>;
+  constexpr int bits = (DIM == 1 ? 31 : 32 / DIM);
+  constexpr unsigned N = 1u << bits;
+
+  using KokkosExt::max;
+  using KokkosExt::min;
+
+  unsigned int x[DIM];
+  for (int d = 0; d < DIM; ++d)
+    x[d] = (unsigned int)min(max((float)p[d] * N, 0.f), (float)N - 1);
+
+  axesToTranspose(x, bits);
+
+  unsigned int r = 0;
+  for (int d = 0; d < DIM; ++d)
+    r += (expandBitsBy<DIM - 1>(x[d]) << (DIM - d - 1));
+
+  return r;
+}
+
+template <typename Point,
+          typename Enable = std::enable_if_t<GeometryTraits::is_point<Point>{}>>
+KOKKOS_INLINE_FUNCTION unsigned long long hilbert64(Point const &p)
+{
+  constexpr int DIM = GeometryTraits::dimension_v<Point>;
+  constexpr int bits = 63 / DIM;
+  constexpr unsigned long long N = 1llu << bits;
+
+  using KokkosExt::max;
+  using KokkosExt::min;
+
+  unsigned long long x[DIM];
+  for (int d = 0; d < DIM; ++d)
+    x[d] = (unsigned long long)min(max((double)p[d] * N, 0.),
+                                   (double)N - 1);
+
+  axesToTranspose(x, bits);
+
+  unsigned long long r = 0;
+  for (int d = 0; d < DIM; ++d)
+    r += (expandBitsBy<DIM - 1>(x[d]) << (DIM - d - 1));
+
+  return r;
+}
+
+} // namespace Details
+
+} // namespace ArborX
+
+#endif
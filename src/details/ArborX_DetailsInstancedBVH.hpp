@@ -0,0 +1,290 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_INSTANCED_BVH_HPP
+#define ARBORX_DETAILS_INSTANCED_BVH_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_Box.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_Point.hpp>
+#include <ArborX_Sphere.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Rigid motion (rotation followed by translation) placing an instance of a
+// shared geometry in the scene. Restricting transforms to rigid motions
+// keeps spheres spheres and makes the inverse cheap.
+struct RigidTransform
+{
+  float rotation[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+  float translation[3] = {0, 0, 0};
+
+  KOKKOS_FUNCTION Point apply(Point const &p) const
+  {
+    Point q{translation[0], translation[1], translation[2]};
+    for (int i = 0; i < 3; ++i)
+      for (int j = 0; j < 3; ++j)
+        q[i] += rotation[i][j] * p[j];
+    return q;
+  }
+
+  // Rigid inverse: transpose of the rotation
+  KOKKOS_FUNCTION Point applyInverse(Point const &p) const
+  {
+    Point q{0, 0, 0};
+    for (int i = 0; i < 3; ++i)
+      for (int j = 0; j < 3; ++j)
+        q[i] += rotation[j][i] * (p[j] - translation[j]);
+    return q;
+  }
+};
+
+struct Instance
+{
+  RigidTransform transform;
+  // Index of the shared bottom tree this instance refers to
+  int tree_index = 0;
+};
+
+namespace Details
+{
+
+KOKKOS_INLINE_FUNCTION Point
+transformToLocal(Point const &point, RigidTransform const &transform)
+{
+  return transform.applyInverse(point);
+}
+
+KOKKOS_INLINE_FUNCTION Sphere
+transformToLocal(Sphere const &sphere, RigidTransform const &transform)
+{
+  return {transform.applyInverse(sphere.centroid()), sphere.radius()};
+}
+
+// Conservative local-frame box of a world-frame box: the axis-aligned hull
+// of its transformed corners
+KOKKOS_INLINE_FUNCTION Box transformToLocal(Box const &box,
+                                            RigidTransform const &transform)
+{
+  Box local;
+  for (int corner = 0; corner < 8; ++corner)
+  {
+    Point p{(corner & 1 ? box.maxCorner() : box.minCorner())[0],
+            (corner & 2 ? box.maxCorner() : box.minCorner())[1],
+            (corner & 4 ? box.maxCorner() : box.minCorner())[2]};
+    ArborX::Details::expand(local, transform.applyInverse(p));
+  }
+  return local;
+}
+
+KOKKOS_INLINE_FUNCTION Box transformToWorld(Box const &box,
+                                            RigidTransform const &transform)
+{
+  Box world;
+  for (int corner = 0; corner < 8; ++corner)
+  {
+    Point p{(corner & 1 ? box.maxCorner() : box.minCorner())[0],
+            (corner & 2 ? box.maxCorner() : box.minCorner())[1],
+            (corner & 4 ? box.maxCorner() : box.minCorner())[2]};
+    ArborX::Details::expand(world, transform.apply(p));
+  }
+  return world;
+}
+
+} // namespace Details
+
+// Predicate mapped into the local frame of a tree whose geometry sits in
+// the world under the given rigid transform. Rigid motions preserve
+// distances, so both spatial and nearest predicates survive the mapping
+// unchanged in meaning. This is the query-side alternative to rebuilding:
+// when a body moves, keep its tree and transform the predicates instead.
+template <typename Geometry>
+KOKKOS_INLINE_FUNCTION auto transformed(Intersects<Geometry> const &pred,
+                                        RigidTransform const &transform)
+{
+  return intersects(Details::transformToLocal(getGeometry(pred), transform));
+}
+
+template <typename Geometry>
+KOKKOS_INLINE_FUNCTION auto transformed(Nearest<Geometry> const &pred,
+                                        RigidTransform const &transform)
+{
+  return nearest(Details::transformToLocal(getGeometry(pred), transform),
+                 getK(pred));
+}
+
+template <typename Geometry, int K>
+KOKKOS_INLINE_FUNCTION auto transformed(NearestK<Geometry, K> const &pred,
+                                        RigidTransform const &transform)
+{
+  return nearest<K>(Details::transformToLocal(getGeometry(pred), transform));
+}
+
+template <typename Predicate, typename Data>
+KOKKOS_INLINE_FUNCTION auto
+transformed(PredicateWithAttachment<Predicate, Data> const &pred,
+            RigidTransform const &transform)
+{
+  return attach(transformed(getPredicate(pred), transform), getData(pred));
+}
+
+// Lazily transformed predicate set: each predicate is mapped into the
+// tree's local frame as the traversal fetches it, so querying a moved
+// body costs neither a rebuild nor a transformed copy of the predicates.
+template <typename Predicates>
+struct TransformedPredicates
+{
+  Predicates _predicates;
+  RigidTransform _transform;
+};
+
+template <typename Predicates>
+auto transform_predicates(Predicates const &predicates,
+                          RigidTransform const &transform)
+{
+  ArborX::Details::check_valid_access_traits(PredicatesTag{}, predicates);
+  using AccessValues =
+      ArborX::Details::AccessValues<Predicates, PredicatesTag>;
+  return TransformedPredicates<AccessValues>{AccessValues{predicates},
+                                             transform};
+}
+
+// Two-level hierarchy over instances of shared bottom trees. The top tree
+// indexes the world-space boxes of the instances; a query traverses it once
+// per predicate and dispatches into the bottom tree of every matching
+// instance with the predicate geometry mapped into the instance frame. Only
+// the top tree needs rebuilding when instances move.
+//
+// The user callback is invoked as callback(predicate, instance_index, value)
+// with the value stored in the bottom tree.
+template <class BottomTree>
+class InstancedBVH
+{
+public:
+  using memory_space = typename BottomTree::memory_space;
+  using value_type = typename BottomTree::value_type;
+
+  // Both views must be accessible from the host during construction: the
+  // instance boxes for the top tree are computed from the bottom trees'
+  // bounds on the host.
+  template <class ExecutionSpace>
+  InstancedBVH(ExecutionSpace const &space,
+               Kokkos::View<BottomTree *, memory_space> bottom_trees,
+               Kokkos::View<Instance *, memory_space> instances)
+      : _bottom_trees(bottom_trees)
+      , _instances(instances)
+  {
+    int const num_instances = instances.extent_int(0);
+
+    auto instances_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace{}, instances);
+    auto bottom_trees_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace{}, bottom_trees);
+
+    Kokkos::View<Box *, Kokkos::HostSpace> instance_boxes_host(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                           "ArborX::InstancedBVH::instance_boxes"),
+        num_instances);
+    for (int i = 0; i < num_instances; ++i)
+    {
+      auto const &instance = instances_host(i);
+      Box bounds;
+      ArborX::Details::expand(
+          bounds, bottom_trees_host(instance.tree_index).bounds());
+      instance_boxes_host(i) =
+          Details::transformToWorld(bounds, instance.transform);
+    }
+    auto instance_boxes = Kokkos::create_mirror_view_and_copy(
+        memory_space{}, instance_boxes_host);
+
+    _top_tree = BoundingVolumeHierarchy<memory_space>(space, instance_boxes);
+  }
+
+  template <class ExecutionSpace, class Predicates, class Callback>
+  void query(ExecutionSpace const &space, Predicates const &predicates,
+             Callback const &callback) const
+  {
+    ArborX::Details::check_valid_access_traits(PredicatesTag{}, predicates);
+
+    using AccessValues =
+        ArborX::Details::AccessValues<Predicates, PredicatesTag>;
+    AccessValues access_values{predicates};
+
+    static_assert(
+        std::is_same_v<typename AccessValues::value_type::Tag,
+                       ArborX::Details::SpatialPredicateTag>,
+        "InstancedBVH only supports spatial predicates");
+
+    auto const top_tree = _top_tree;
+    auto const bottom_trees = _bottom_trees;
+    auto const instances = _instances;
+    Kokkos::parallel_for(
+        "ArborX::InstancedBVH::query",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, access_values.size()),
+        KOKKOS_LAMBDA(int i) {
+          auto const &predicate = access_values(i);
+          top_tree.query(
+              PerThread{}, predicate,
+              [&](auto const &, auto const &top_value) {
+                int const instance_index = top_value.index;
+                auto const &instance = instances(instance_index);
+                auto local_predicate = intersects(Details::transformToLocal(
+                    getGeometry(predicate), instance.transform));
+                bottom_trees(instance.tree_index)
+                    .query(PerThread{}, local_predicate,
+                           [&](auto const &, value_type const &value) {
+                             callback(predicate, instance_index, value);
+                           });
+              });
+        });
+  }
+
+private:
+  Kokkos::View<BottomTree *, memory_space> _bottom_trees;
+  Kokkos::View<Instance *, memory_space> _instances;
+  BoundingVolumeHierarchy<memory_space> _top_tree;
+};
+
+} // namespace ArborX::Experimental
+
+namespace ArborX
+{
+
+template <typename Predicates>
+struct AccessTraits<Experimental::TransformedPredicates<Predicates>,
+                    PredicatesTag>
+{
+  using TransformedPredicates =
+      Experimental::TransformedPredicates<Predicates>;
+
+  using memory_space = typename Predicates::memory_space;
+
+  KOKKOS_FUNCTION static std::size_t
+  size(TransformedPredicates const &predicates)
+  {
+    return predicates._predicates.size();
+  }
+
+  KOKKOS_FUNCTION static auto get(TransformedPredicates const &predicates,
+                                  std::size_t i)
+  {
+    return Experimental::transformed(predicates._predicates(i),
+                                     predicates._transform);
+  }
+};
+
+} // namespace ArborX
+
+#endif
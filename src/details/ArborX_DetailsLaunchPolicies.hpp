@@ -0,0 +1,84 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_LAUNCH_POLICIES_HPP
+#define ARBORX_DETAILS_LAUNCH_POLICIES_HPP
+
+#include <Kokkos_Core.hpp>
+
+#include <cstdlib>
+
+namespace ArborX::Details
+{
+
+// Launch bounds for the register-heavy traversal kernels, selected per
+// backend. The HIP compiler allocates registers for the worst case and the
+// traversal kernels then run at a fraction of achievable occupancy; capping
+// the block size and requesting a minimum number of resident blocks per CU
+// restores it. The CUDA heuristics already pick a good configuration for
+// these kernels and a cap only hurts there, so CUDA (and the host backends)
+// keep the Kokkos defaults.
+template <typename ExecutionSpace>
+struct TraversalLaunchBounds
+{
+  using type = Kokkos::LaunchBounds<>;
+};
+
+#ifdef KOKKOS_ENABLE_HIP
+template <>
+struct TraversalLaunchBounds<Kokkos::HIP>
+{
+  using type = Kokkos::LaunchBounds<256, 4>;
+};
+#endif
+
+// Occupancy override for the traversal kernels, read once from
+// ARBORX_DESIRED_OCCUPANCY (1-100, percent of achievable occupancy; unset
+// or out of range leaves the backend defaults). Policies annotated with a
+// desired occupancy are also what the Kokkos Tools occupancy autotuner
+// adjusts, so setting the variable doubles as the opt-in hook for
+// tools-driven tuning of these kernels.
+inline int desiredTraversalOccupancy()
+{
+  static int const occupancy = []() {
+    char const *env = std::getenv("ARBORX_DESIRED_OCCUPANCY");
+    int const value = (env != nullptr ? std::atoi(env) : 0);
+    return (value >= 1 && value <= 100) ? value : 0;
+  }();
+  return occupancy;
+}
+
+// Launch a range kernel with the per-backend traversal launch bounds and,
+// when requested, the occupancy annotation. The work tag, if any, is given
+// explicitly: launchTraversalKernel<FullTree>(label, space, n, *this).
+template <typename... WorkTag, typename ExecutionSpace, typename Functor>
+void launchTraversalKernel(char const *label, ExecutionSpace const &space,
+                           int n, Functor const &functor)
+{
+  static_assert(sizeof...(WorkTag) <= 1);
+
+  Kokkos::RangePolicy<ExecutionSpace,
+                      typename TraversalLaunchBounds<ExecutionSpace>::type,
+                      WorkTag...>
+      policy(space, 0, n);
+  if (int const occupancy = desiredTraversalOccupancy(); occupancy > 0)
+    Kokkos::parallel_for(
+        label,
+        Kokkos::Experimental::prefer(
+            policy, Kokkos::Experimental::DesiredOccupancy(occupancy)),
+        functor);
+  else
+    Kokkos::parallel_for(label, policy, functor);
+}
+
+} // namespace ArborX::Details
+
+#endif
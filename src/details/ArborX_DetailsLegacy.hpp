@@ -18,6 +18,12 @@
 namespace ArborX::Details
 {
 
+// Conversion adapter of the backward-compatibility path: presents the
+// user's primitives as (bounding volume, index) pairs for the tree to
+// store. The stored copies are unavoidable here -- BVH<MemorySpace>
+// carries no primitives type in its signature to fetch through at
+// traversal time. Index-tree users who want the geometry kept out of the
+// tree should build with Experimental::make_index_only_bvh() instead.
 template <typename Primitives, typename BoundingVolume>
 class LegacyValues
 {
@@ -56,6 +62,29 @@ public:
   size_type size() const { return Access::size(_primitives); }
 };
 
+// Lazily counted stand-in for the values of an index-only tree (see
+// Experimental::make_index_only_bvh()). Handing this to the tree
+// constructor writes the indices straight into the leaves; a materialized
+// index view would only exist to be copied once and thrown away, which at
+// large primitive counts is a noticeable transient allocation.
+template <typename MemorySpace>
+class IndexValues
+{
+public:
+  using memory_space = MemorySpace;
+  using index_type = unsigned;
+  using value_type = index_type;
+  using size_type = std::size_t;
+
+  size_type _n;
+
+  KOKKOS_FUNCTION
+  value_type operator()(size_type i) const { return (value_type)i; }
+
+  KOKKOS_FUNCTION
+  size_type size() const { return _n; }
+};
+
 template <typename Callback>
 struct LegacyCallbackWrapper
 {
@@ -111,6 +140,26 @@ struct ArborX::GeometryTraits::coordinate_type<
   using type = float;
 };
 
+template <typename MemorySpace>
+struct ArborX::AccessTraits<ArborX::Details::IndexValues<MemorySpace>,
+                            ArborX::PrimitivesTag>
+{
+  using Values = ArborX::Details::IndexValues<MemorySpace>;
+
+  using memory_space = typename Values::memory_space;
+  using size_type = typename Values::size_type;
+  using value_type = typename Values::value_type;
+
+  KOKKOS_FUNCTION static size_type size(Values const &values)
+  {
+    return values.size();
+  }
+  KOKKOS_FUNCTION static auto get(Values const &values, size_type i)
+  {
+    return values(i);
+  }
+};
+
 template <typename Primitives, typename BoundingVolume>
 struct ArborX::AccessTraits<
     ArborX::Details::LegacyValues<Primitives, BoundingVolume>,
@@ -731,6 +731,60 @@ void resetSharedRadii(ExecutionSpace const &space, BVH const &bvh,
       });
 }
 
+// Collapse the neighborhoods recorded during the core distance sweep (see
+// MaxDistanceWithNeighbors) into an upper bound on the weight of each
+// point's first-round Boruvka edge. Every recorded neighbor j lies within
+// the core distance of i, so the mutual reachability between the two
+// reduces to the larger of their core distances, and the smallest such
+// value over the neighborhood bounds the shortest outgoing edge of the
+// singleton component of i.
+template <class ExecutionSpace, class CoreDistances, class NeighborIndices>
+auto computeSeedRadii(ExecutionSpace const &space,
+                      CoreDistances const &core_distances,
+                      NeighborIndices const &neighbor_indices, int k)
+{
+  using MemorySpace = typename CoreDistances::memory_space;
+  constexpr auto inf = KokkosExt::ArithmeticTraits::infinity<float>::value;
+
+  int const n = core_distances.extent(0);
+  Kokkos::View<float *, MemorySpace> seed_radii(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::MST::seed_radii"),
+      n);
+  Kokkos::parallel_for(
+      "ArborX::MST::compute_seed_radii",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        using KokkosExt::max;
+        using KokkosExt::min;
+        float neighbor_core = inf;
+        for (int s = 0; s < k; ++s)
+        {
+          int const j = neighbor_indices(i * (long long)k + s);
+          if (j != i && j != -1)
+            neighbor_core = min(neighbor_core, core_distances(j));
+        }
+        seed_radii(i) = max(core_distances(i), neighbor_core);
+      });
+  return seed_radii;
+}
+
+// Tighten the first-round radii with the precomputed per-point bounds. Only
+// valid while the components are singletons, i.e. before the first label
+// update.
+template <class ExecutionSpace, class BVH, class SeedRadii, class Radii>
+void applySeedRadii(ExecutionSpace const &space, BVH const &bvh,
+                    SeedRadii const &seed_radii, Radii const &radii)
+{
+  auto const n = bvh.size();
+  Kokkos::parallel_for(
+      "ArborX::MST::apply_seed_radii",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        using KokkosExt::min;
+        radii(i) = min(radii(i),
+                       seed_radii(HappyTreeFriends::getValue(bvh, i).index));
+      });
+}
+
 } // namespace ArborX::Details
 
 #endif
@@ -13,10 +13,15 @@
 #define ARBORX_DETAILS_MORTON_CODE_UTILS_HPP
 
 #include <ArborX_DetailsKokkosExtMinMaxOperations.hpp> // min. max
+#include <ArborX_DetailsKokkosExtRadixSort.hpp> // is_radix_sort_candidate
 #include <ArborX_GeometryTraits.hpp>
 
 #include <Kokkos_Core.hpp> // abort
 
+#ifdef __BMI2__
+#include <immintrin.h> // _pdep_u32, _pdep_u64
+#endif
+
 namespace ArborX
 {
 
@@ -45,6 +50,11 @@ KOKKOS_INLINE_FUNCTION unsigned int expandBitsBy<0>(unsigned int x)
 template <>
 KOKKOS_INLINE_FUNCTION unsigned int expandBitsBy<1>(unsigned int x)
 {
+#ifdef __BMI2__
+  // On the host, pdep deposits the low bits of x at the positions set in the
+  // mask, which is this entire shift cascade in a single instruction
+  KOKKOS_IF_ON_HOST((return _pdep_u32(x, 0x55555555u);))
+#endif
   x &= 0x0000ffffu;
   x = (x ^ (x << 8)) & 0x00ff00ffu;
   x = (x ^ (x << 4)) & 0x0f0f0f0fu;
@@ -57,6 +67,9 @@ KOKKOS_INLINE_FUNCTION unsigned int expandBitsBy<1>(unsigned int x)
 template <>
 KOKKOS_INLINE_FUNCTION unsigned int expandBitsBy<2>(unsigned int x)
 {
+#ifdef __BMI2__
+  KOKKOS_IF_ON_HOST((return _pdep_u32(x, 0x09249249u);))
+#endif
   x &= 0x000003ffu;
   x = (x ^ (x << 16)) & 0xff0000ffu;
   x = (x ^ (x << 8)) & 0x0300f00fu;
@@ -168,6 +181,9 @@ KOKKOS_INLINE_FUNCTION unsigned long long expandBitsBy<0>(unsigned long long x)
 template <>
 KOKKOS_INLINE_FUNCTION unsigned long long expandBitsBy<1>(unsigned long long x)
 {
+#ifdef __BMI2__
+  KOKKOS_IF_ON_HOST((return _pdep_u64(x, 0x1555555555555555llu);))
+#endif
   x &= 0x7fffffffllu;
   x = (x | x << 16) & 0x7fff0000ffffllu;
   x = (x | x << 8) & 0x7f00ff00ff00ffllu;
@@ -181,6 +197,9 @@ KOKKOS_INLINE_FUNCTION unsigned long long expandBitsBy<1>(unsigned long long x)
 template <>
 KOKKOS_INLINE_FUNCTION unsigned long long expandBitsBy<2>(unsigned long long x)
 {
+#ifdef __BMI2__
+  KOKKOS_IF_ON_HOST((return _pdep_u64(x, 0x1249249249249249llu);))
+#endif
   x &= 0x1fffffllu;
   x = (x | x << 32) & 0x1f00000000ffffllu;
   x = (x | x << 16) & 0x1f0000ff0000ffllu;
@@ -346,8 +365,204 @@ KOKKOS_INLINE_FUNCTION unsigned long long morton64(Point const &p)
          expandBitsBy<1>((unsigned long long)yd);
 }
 
+// Fixed-width 128-bit unsigned integer stored as two 64-bit halves. Only
+// provides the operations the code computation and the sorting paths need.
+struct UInt128
+{
+  unsigned long long _hi = 0;
+  unsigned long long _lo = 0;
+
+  friend KOKKOS_FUNCTION constexpr bool operator==(UInt128 const &a,
+                                                   UInt128 const &b)
+  {
+    return a._hi == b._hi && a._lo == b._lo;
+  }
+  friend KOKKOS_FUNCTION constexpr bool operator!=(UInt128 const &a,
+                                                   UInt128 const &b)
+  {
+    return !(a == b);
+  }
+  friend KOKKOS_FUNCTION constexpr bool operator<(UInt128 const &a,
+                                                  UInt128 const &b)
+  {
+    return a._hi < b._hi || (a._hi == b._hi && a._lo < b._lo);
+  }
+  friend KOKKOS_FUNCTION constexpr bool operator>(UInt128 const &a,
+                                                  UInt128 const &b)
+  {
+    return b < a;
+  }
+  friend KOKKOS_FUNCTION constexpr bool operator<=(UInt128 const &a,
+                                                   UInt128 const &b)
+  {
+    return !(b < a);
+  }
+  friend KOKKOS_FUNCTION constexpr bool operator>=(UInt128 const &a,
+                                                   UInt128 const &b)
+  {
+    return !(a < b);
+  }
+  friend KOKKOS_FUNCTION constexpr UInt128 operator^(UInt128 const &a,
+                                                     UInt128 const &b)
+  {
+    return {a._hi ^ b._hi, a._lo ^ b._lo};
+  }
+};
+
+// Signed two's complement counterpart of UInt128. Only used as the delta
+// value type during hierarchy generation, and only provides the operations
+// the delta computation needs.
+struct Int128
+{
+  unsigned long long _hi = 0;
+  unsigned long long _lo = 0;
+
+  constexpr Int128() = default;
+  KOKKOS_FUNCTION constexpr Int128(unsigned long long hi,
+                                   unsigned long long lo)
+      : _hi(hi)
+      , _lo(lo)
+  {}
+  KOKKOS_FUNCTION constexpr Int128(int x)
+      : _hi(x < 0 ? ~0llu : 0llu)
+      , _lo((unsigned long long)(long long)x)
+  {}
+  KOKKOS_FUNCTION constexpr explicit Int128(UInt128 const &x)
+      : _hi(x._hi)
+      , _lo(x._lo)
+  {}
+
+  friend KOKKOS_FUNCTION constexpr Int128 operator+(Int128 const &a,
+                                                    Int128 const &b)
+  {
+    Int128 r{a._hi + b._hi, a._lo + b._lo};
+    if (r._lo < a._lo) // carry
+      ++r._hi;
+    return r;
+  }
+  friend KOKKOS_FUNCTION constexpr Int128 operator-(Int128 const &a,
+                                                    Int128 const &b)
+  {
+    Int128 r{a._hi - b._hi, a._lo - b._lo};
+    if (a._lo < b._lo) // borrow
+      --r._hi;
+    return r;
+  }
+  friend KOKKOS_FUNCTION constexpr bool operator==(Int128 const &a,
+                                                   Int128 const &b)
+  {
+    return a._hi == b._hi && a._lo == b._lo;
+  }
+  friend KOKKOS_FUNCTION constexpr bool operator!=(Int128 const &a,
+                                                   Int128 const &b)
+  {
+    return !(a == b);
+  }
+  friend KOKKOS_FUNCTION constexpr bool operator<(Int128 const &a,
+                                                  Int128 const &b)
+  {
+    return (long long)a._hi < (long long)b._hi ||
+           (a._hi == b._hi && a._lo < b._lo);
+  }
+  friend KOKKOS_FUNCTION constexpr bool operator>(Int128 const &a,
+                                                  Int128 const &b)
+  {
+    return b < a;
+  }
+  friend KOKKOS_FUNCTION constexpr bool operator<=(Int128 const &a,
+                                                   Int128 const &b)
+  {
+    return !(b < a);
+  }
+  friend KOKKOS_FUNCTION constexpr bool operator>=(Int128 const &a,
+                                                   Int128 const &b)
+  {
+    return !(a < b);
+  }
+};
+
+// std::make_signed with an extension point for the multi-word code types
+template <typename T>
+struct MakeSigned : std::make_signed<T>
+{};
+
+template <>
+struct MakeSigned<UInt128>
+{
+  using type = Int128;
+};
+
+// Byte extraction for the LSD radix sort passes
+KOKKOS_INLINE_FUNCTION unsigned int radixSortByte(UInt128 const &x,
+                                                  unsigned int shift)
+{
+  return (shift < 64 ? x._lo >> shift : x._hi >> (shift - 64)) & 0xffu;
+}
+
+template <>
+struct KokkosExt::is_radix_sort_candidate<UInt128> : std::true_type
+{};
+
+// Calculate a 128-bit Morton code for a point located within [0, 1]^d, using
+// 42 bits per dimension in 3D and 52 in 2D (the 53-bit double mantissa caps
+// how many bins the scaling below can address). Heavily clustered inputs
+// alias many points to a single 32- or 64-bit code, which degrades the
+// quality of the generated hierarchy; the wider code keeps telling such
+// points apart. Each dimension is expanded in two halves with the 64-bit
+// expansions above, so the two 63-bit interleaved halves never overlap.
+template <typename Point,
+          typename Enable = std::enable_if_t<GeometryTraits::is_point<Point>{}>>
+KOKKOS_INLINE_FUNCTION UInt128 morton128(Point const &p)
+{
+  constexpr int DIM = GeometryTraits::dimension_v<Point>;
+  static_assert(DIM == 2 || DIM == 3,
+                "128-bit Morton codes are only implemented in 2D and 3D");
+
+  constexpr int bits = (DIM == 3 ? 42 : 52);
+  constexpr int half = bits / 2;
+  constexpr unsigned long long N = 1llu << bits;
+
+  using KokkosExt::max;
+  using KokkosExt::min;
+
+  UInt128 r;
+  for (int d = 0; d < DIM; ++d)
+  {
+    // Have to use double as float is not sufficient to represent large
+    // integers, which would result in some missing bins.
+    auto x = min(max((double)p[d] * N, 0.), (double)(N - 1));
+    auto xi = (unsigned long long)x;
+    r._lo += expandBitsBy<DIM - 1>(xi & ((1llu << half) - 1)) << (DIM - d - 1);
+    r._hi += expandBitsBy<DIM - 1>(xi >> half) << (DIM - d - 1);
+  }
+
+  return r;
+}
+
 } // namespace Details
 
 } // namespace ArborX
 
+template <>
+struct Kokkos::reduction_identity<ArborX::Details::UInt128>
+{
+  KOKKOS_FUNCTION static ArborX::Details::UInt128 min()
+  {
+    return {~0llu, ~0llu};
+  }
+  KOKKOS_FUNCTION static ArborX::Details::UInt128 max() { return {0, 0}; }
+};
+
+template <>
+struct Kokkos::Experimental::finite_max<ArborX::Details::Int128>
+{
+  static constexpr ArborX::Details::Int128 value{0x7fffffffffffffffllu, ~0llu};
+};
+
+template <>
+struct Kokkos::Experimental::finite_min<ArborX::Details::Int128>
+{
+  static constexpr ArborX::Details::Int128 value{0x8000000000000000llu, 0};
+};
+
 #endif
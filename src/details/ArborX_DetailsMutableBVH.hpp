@@ -0,0 +1,213 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_MUTABLE_BVH_HPP
+#define ARBORX_DETAILS_MUTABLE_BVH_HPP
+
+#include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp> // exclusive_scan
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsSortUtils.hpp> // sortObjects
+#include <ArborX_Exception.hpp>
+#include <ArborX_LinearBVH.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Maintains a BoundingVolumeHierarchy under a stream of insertions and
+// removals without paying a full reconstruction per step. Inserted values
+// accumulate in a flat delta buffer scanned alongside the tree during
+// queries; removed values are tombstoned by their index and filtered out of
+// query results. Maintenance cost therefore scales with the churn. Once the
+// churn fraction passes a threshold, rebuild() folds everything back into a
+// fresh tree.
+//
+// Values must expose an `index` member uniquely identifying the primitive
+// (as PairValueIndex does); remove() refers to these indices.
+template <class BVH>
+class MutableBVH
+{
+public:
+  using memory_space = typename BVH::memory_space;
+  using value_type = typename BVH::value_type;
+  using size_type = typename BVH::size_type;
+
+  template <class ExecutionSpace, class Values>
+  MutableBVH(ExecutionSpace const &space, Values const &values)
+      : _bvh(space, values)
+      , _delta("ArborX::MutableBVH::delta", 0)
+      , _removed("ArborX::MutableBVH::removed", 0)
+  {}
+
+  KOKKOS_FUNCTION size_type size() const noexcept
+  {
+    return _bvh.size() + _delta.size() - _removed.size();
+  }
+
+  // Append values; they become visible to queries immediately
+  template <class ExecutionSpace>
+  void insert(ExecutionSpace const &space,
+              Kokkos::View<value_type *, memory_space> const &values)
+  {
+    auto const old_size = _delta.size();
+    Kokkos::resize(space, _delta, old_size + values.size());
+    Kokkos::deep_copy(
+        space,
+        Kokkos::subview(_delta,
+                        Kokkos::make_pair(old_size, _delta.size())),
+        values);
+  }
+
+  // Tombstone values by index; they stop appearing in query results
+  // immediately, and are physically dropped on the next rebuild()
+  template <class ExecutionSpace>
+  void remove(ExecutionSpace const &space,
+              Kokkos::View<int *, memory_space> const &indices)
+  {
+    auto const old_size = _removed.size();
+    Kokkos::resize(space, _removed, old_size + indices.size());
+    Kokkos::deep_copy(
+        space,
+        Kokkos::subview(_removed,
+                        Kokkos::make_pair(old_size, _removed.size())),
+        indices);
+    auto removed = _removed;
+    Details::sortObjects(space, removed);
+  }
+
+  // Fraction of the tree made stale by removals and out-of-tree inserts;
+  // a reasonable policy is to rebuild() when this exceeds ~10%
+  float churn() const
+  {
+    if (_bvh.size() == 0)
+      return _delta.size() > 0 ? 1.f : 0.f;
+    return (float)(_delta.size() + _removed.size()) / _bvh.size();
+  }
+
+  // Fold tombstones and the delta buffer into a freshly built tree
+  template <class ExecutionSpace>
+  void rebuild(ExecutionSpace const &space)
+  {
+    int const n = _bvh.size();
+    int const num_delta = _delta.size();
+    auto bvh = _bvh;
+    auto delta = _delta;
+    auto removed = _removed;
+
+    Kokkos::View<int *, memory_space> offsets(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::MutableBVH::rebuild::offsets"),
+        n + 1);
+    Kokkos::parallel_for(
+        "ArborX::MutableBVH::rebuild::mark_survivors",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i) {
+          offsets(i) =
+              !isRemoved(removed, Details::HappyTreeFriends::getValue(bvh, i)
+                                      .index);
+        });
+    Details::KokkosExt::exclusive_scan(space, offsets, offsets, 0);
+    int const num_survivors = Details::KokkosExt::lastElement(space, offsets);
+
+    Kokkos::View<value_type *, memory_space> values(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::MutableBVH::rebuild::values"),
+        num_survivors + num_delta);
+    Kokkos::parallel_for(
+        "ArborX::MutableBVH::rebuild::compact",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n + num_delta),
+        KOKKOS_LAMBDA(int i) {
+          if (i < n)
+          {
+            if (offsets(i + 1) != offsets(i))
+              values(offsets(i)) =
+                  Details::HappyTreeFriends::getValue(bvh, i);
+          }
+          else
+            values(num_survivors + (i - n)) = delta(i - n);
+        });
+
+    _bvh = BVH(space, values);
+    Kokkos::resize(_delta, 0);
+    Kokkos::resize(_removed, 0);
+  }
+
+  template <class ExecutionSpace, class Predicates, class Callback>
+  void query(ExecutionSpace const &space, Predicates const &predicates,
+             Callback const &callback) const
+  {
+    Details::check_valid_access_traits(PredicatesTag{}, predicates);
+
+    using AccessValues = Details::AccessValues<Predicates, PredicatesTag>;
+    AccessValues access_values{predicates};
+
+    static_assert(std::is_same_v<typename AccessValues::value_type::Tag,
+                                 Details::SpatialPredicateTag>,
+                  "MutableBVH only supports spatial predicates");
+
+    auto removed = _removed;
+    _bvh.query(space, predicates,
+               KOKKOS_LAMBDA(auto const &predicate, value_type const &value) {
+                 if (!isRemoved(removed, value.index))
+                   callback(predicate, value);
+               });
+
+    // Brute-force sweep over the (small) delta buffer
+    auto delta = _delta;
+    int const num_delta = delta.size();
+    if (num_delta > 0)
+    {
+      auto const indexable_getter =
+          Details::HappyTreeFriends::getIndexableGetter(_bvh);
+      Kokkos::parallel_for(
+          "ArborX::MutableBVH::query::delta",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, access_values.size()),
+          KOKKOS_LAMBDA(int i) {
+            auto const &predicate = access_values(i);
+            for (int j = 0; j < num_delta; ++j)
+            {
+              auto const &value = delta(j);
+              if (predicate(indexable_getter(value)) &&
+                  !isRemoved(removed, value.index))
+                callback(predicate, value);
+            }
+          });
+    }
+  }
+
+private:
+  KOKKOS_FUNCTION static bool
+  isRemoved(Kokkos::View<int *, memory_space> const &removed, int index)
+  {
+    // The removed view is kept sorted by remove()
+    int first = 0;
+    int last = removed.size();
+    while (first < last)
+    {
+      int const mid = first + (last - first) / 2;
+      if (removed(mid) < index)
+        first = mid + 1;
+      else
+        last = mid;
+    }
+    return first < (int)removed.size() && removed(first) == index;
+  }
+
+  BVH _bvh;
+  Kokkos::View<value_type *, memory_space> _delta;
+  Kokkos::View<int *, memory_space> _removed;
+};
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -47,6 +47,39 @@ struct MaxDistance
   }
 };
 
+// Variant of MaxDistance that additionally records the indices of the
+// returned neighbors. The recorded neighborhoods let the minimum spanning
+// tree construction bound the first Boruvka round from the core distance
+// sweep alone (see computeSeedRadii), instead of immediately re-traversing
+// the tree regions the sweep just visited.
+template <class Primitives, class Distances, class Neighbors, class Counts>
+struct MaxDistanceWithNeighbors
+{
+  Primitives _primitives;
+  Distances _distances;
+  Neighbors _neighbors;
+  Counts _counts;
+  int _k;
+
+  using memory_space = typename Primitives::memory_space;
+  using size_type = typename memory_space::size_type;
+
+  template <class Predicate, typename Value>
+  KOKKOS_FUNCTION void operator()(Predicate const &predicate,
+                                  Value const &value) const
+  {
+    size_type const i = value.index;
+    size_type const j = getData(predicate);
+    using KokkosExt::max;
+    auto const distance_ij = distance(_primitives(i), _primitives(j));
+    // NOTE using knowledge that each nearest predicate traversal is performed
+    // by a single thread.  The updates below would need to be atomic
+    // otherwise.
+    _distances(j) = max(_distances(j), distance_ij);
+    _neighbors(j * (long long)_k + _counts(j)++) = i;
+  }
+};
+
 template <class Primitives>
 struct NearestK
 {
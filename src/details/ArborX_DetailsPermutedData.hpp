@@ -14,6 +14,8 @@
 
 #include <ArborX_AccessTraits.hpp>
 
+#include <type_traits>
+
 namespace ArborX
 {
 
@@ -29,13 +31,45 @@ struct PermutedData
   Data _data;
   Permute _permute;
 
+  // Mirrors the access traits below: with AttachIndices the position is
+  // attached here as well, so direct accesses observe the same predicates
+  // the traversal does (note that the attached result is a value, not a
+  // reference into the underlying data)
   KOKKOS_FUNCTION decltype(auto) operator()(int i) const
   {
-    return _data(_permute(i));
+    if constexpr (AttachIndices)
+      return attach(_data(_permute(i)), i);
+    else
+      return _data(_permute(i));
   }
   KOKKOS_FUNCTION auto size() const { return _data.size(); }
 };
 
+// Predicates that had a permutation applied and their positions attached
+// once, up front (see CrsGraphWrapperImpl::materializePermutedPredicates).
+// Reads are plain streaming accesses; the permutation array is never
+// consulted again.
+template <typename View>
+struct MaterializedPredicates
+{
+  using memory_space = typename View::memory_space;
+  using value_type = typename View::value_type;
+
+  View _data;
+
+  KOKKOS_FUNCTION decltype(auto) operator()(int i) const { return _data(i); }
+  KOKKOS_FUNCTION auto size() const { return _data.size(); }
+};
+
+template <typename T>
+struct is_materialized_predicates : std::false_type
+{};
+
+template <typename View>
+struct is_materialized_predicates<MaterializedPredicates<View>>
+    : std::true_type
+{};
+
 } // namespace Details
 
 template <typename Predicates, typename Permute, bool AttachIndices>
@@ -71,6 +105,26 @@ struct AccessTraits<Details::PermutedData<Predicates, Permute, AttachIndices>,
   }
 };
 
+template <typename View>
+struct AccessTraits<Details::MaterializedPredicates<View>, PredicatesTag>
+{
+  using MaterializedPredicates = Details::MaterializedPredicates<View>;
+
+  using memory_space = typename View::memory_space;
+
+  KOKKOS_FUNCTION static std::size_t
+  size(MaterializedPredicates const &predicates)
+  {
+    return predicates._data.size();
+  }
+
+  KOKKOS_FUNCTION static decltype(auto)
+  get(MaterializedPredicates const &predicates, std::size_t index)
+  {
+    return predicates._data(index);
+  }
+};
+
 } // namespace ArborX
 
 #endif
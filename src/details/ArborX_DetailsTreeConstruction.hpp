@@ -14,6 +14,7 @@
 
 #include <ArborX_DetailsAlgorithms.hpp> // expand
 #include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_DetailsLaunchPolicies.hpp>
 #include <ArborX_DetailsNode.hpp> // makeLeafNode
 #include <ArborX_SpaceFillingCurves.hpp>
 
@@ -55,6 +56,60 @@ inline void projectOntoSpaceFillingCurve(ExecutionSpace const &space,
       });
 }
 
+// Fused alternative to calculateBoundingBoxOfTheScene followed by
+// projectOntoSpaceFillingCurve. The scene reduction caches the centroid of
+// every indexable while the primitive is in registers, so the second pass
+// reads compact points instead of re-streaming the primitives. This only
+// pays off when the indexables are not points themselves (for points the
+// cache would just duplicate the input), which the constructor checks.
+template <typename ExecutionSpace, typename Indexables,
+          typename SpaceFillingCurve, typename Box, typename LinearOrdering,
+          typename Centroids>
+inline void projectOntoSpaceFillingCurveFused(
+    ExecutionSpace const &space, Indexables const &indexables,
+    SpaceFillingCurve const &curve, Box &scene_bounding_box,
+    LinearOrdering linear_ordering_indices, Centroids centroids)
+{
+  size_t const n = indexables.size();
+  ARBORX_ASSERT(linear_ordering_indices.extent(0) == n);
+  ARBORX_ASSERT(centroids.extent(0) == n);
+
+  Kokkos::parallel_reduce(
+      "ArborX::TreeConstruction::calculate_bounding_box_and_centroids",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i, Box &update) {
+        auto const &indexable = indexables(i);
+        centroids(i) = returnCentroid(indexable);
+        expand(update, indexable);
+      },
+      Kokkos::Sum<Box>{scene_bounding_box});
+
+  auto const bbox = scene_bounding_box;
+  Kokkos::parallel_for(
+      "ArborX::TreeConstruction::project_centroids_onto_space_filling_curve",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        linear_ordering_indices(i) = curve(bbox, centroids(i));
+      });
+}
+
+template <typename ExecutionSpace, typename Indexables,
+          typename SpaceFillingCurve, typename Box, typename LinearOrdering>
+inline void projectOntoSpaceFillingCurveFused(
+    ExecutionSpace const &space, Indexables const &indexables,
+    SpaceFillingCurve const &curve, Box &scene_bounding_box,
+    LinearOrdering linear_ordering_indices)
+{
+  using Point = std::decay_t<decltype(returnCentroid(indexables(0)))>;
+
+  Kokkos::View<Point *, typename LinearOrdering::memory_space> centroids(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeConstruction::centroids"),
+      indexables.size());
+  projectOntoSpaceFillingCurveFused(space, indexables, curve,
+                                    scene_bounding_box,
+                                    linear_ordering_indices, centroids);
+}
+
 template <typename ExecutionSpace, typename Values, typename IndexableGetter,
           typename Nodes, typename BoundingVolume>
 inline void
@@ -104,24 +159,23 @@ public:
                     PermutationIndices const &permutation_indices,
                     LinearOrdering const &sorted_morton_codes,
                     LeafNodes leaf_nodes, InternalNodes internal_nodes,
-                    BoundingVolume &bounds)
+                    BoundingVolume &bounds,
+                    Kokkos::View<int *, MemorySpace> ranges,
+                    Kokkos::View<int *, MemorySpace> parents = {})
       : _values(values)
       , _indexable_getter(indexable_getter)
       , _permutation_indices(permutation_indices)
       , _sorted_morton_codes(sorted_morton_codes)
       , _leaf_nodes(leaf_nodes)
       , _internal_nodes(internal_nodes)
-      , _ranges(Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
-                                   "ArborX::BVH::BVH::ranges"),
-                internal_nodes.extent(0))
+      , _ranges(ranges)
+      , _parents(parents)
       , _num_internal_nodes(_internal_nodes.extent_int(0))
   {
     Kokkos::deep_copy(space, _ranges, UNTOUCHED_NODE);
 
-    Kokkos::parallel_for(
-        "ArborX::TreeConstruction::generate_hierarchy",
-        Kokkos::RangePolicy<ExecutionSpace>(space, 0, leaf_nodes.extent(0)),
-        *this);
+    launchTraversalKernel("ArborX::TreeConstruction::generate_hierarchy",
+                          space, leaf_nodes.extent(0), *this);
 
     Kokkos::deep_copy(
         space,
@@ -140,7 +194,7 @@ public:
     return &_internal_nodes.data()->bounding_volume;
   }
 
-  using DeltaValueType = std::make_signed_t<LinearOrderingValueType>;
+  using DeltaValueType = typename MakeSigned<LinearOrderingValueType>::type;
 
   KOKKOS_FUNCTION
   auto internalIndex(int const i) const { return i + _num_internal_nodes + 1; }
@@ -180,11 +234,22 @@ public:
     // Morton comparison. Thus, we add LLONG_MIN to it.
     auto const x = _sorted_morton_codes(i) ^ _sorted_morton_codes(i + 1);
 
-    return x + (!x) * (min_value + (i ^ (i + 1))) - 1;
-    //                                            ^^^
-    // When using 63 bits for Morton codes, the LLONG_MAX is actually a valid
-    // code. As we want the return statement above to return a value always
-    // greater than anything here, we downshift by 1.
+    if constexpr (std::is_integral_v<LinearOrderingValueType>)
+    {
+      return x + (!x) * (min_value + (i ^ (i + 1))) - 1;
+      //                                            ^^^
+      // When using 63 bits for Morton codes, the LLONG_MAX is actually a
+      // valid code. As we want the return statement above to return a value
+      // always greater than anything here, we downshift by 1.
+    }
+    else
+    {
+      // Same construction for the multi-word codes, spelled out since they
+      // do not come with implicit two's complement arithmetic
+      if (x == LinearOrderingValueType{})
+        return min_value + DeltaValueType(i ^ (i + 1)) - DeltaValueType(1);
+      return DeltaValueType(x) - DeltaValueType(1);
+    }
   }
 
   template <typename Node>
@@ -242,6 +307,7 @@ public:
       bool const is_left_child = (delta_right < delta_left);
 
       int left_child;
+      int right_child;
       if (is_left_child)
       {
         // The main benefit of the Apetrei index (which is also called a split
@@ -271,7 +337,7 @@ public:
         // is a leaf node depends on the position of the split (which is
         // apetrei index) to the range boundary.
         left_child = i;
-        int right_child = apetrei_parent + 1;
+        right_child = apetrei_parent + 1;
         bool const right_child_is_leaf = (right_child == range_right);
 
         delta_right = delta(range_right);
@@ -286,6 +352,9 @@ public:
                  _indexable_getter(_leaf_nodes(right_child).value));
         else
           expand(bounding_volume, _internal_nodes(right_child).bounding_volume);
+
+        if (!right_child_is_leaf)
+          right_child = internalIndex(right_child);
       }
       else
       {
@@ -300,6 +369,7 @@ public:
           break;
 
         left_child = apetrei_parent;
+        right_child = i;
         bool const left_child_is_leaf = (left_child == range_left);
 
         delta_left = delta(range_left - 1);
@@ -324,6 +394,17 @@ public:
       setRope(parent_node, range_right, delta_right);
       parent_node.bounding_volume = bounding_volume;
 
+      // This is the only point where both children of the parent are known.
+      // Recording the links here (when requested) spares consumers a separate
+      // pass recovering them from the left-child/rope representation (see
+      // TreeRefit::computeParents). The root is nobody's child and its entry
+      // is left untouched, matching that convention.
+      if (_parents.size() != 0)
+      {
+        _parents(left_child) = internalIndex(karras_parent);
+        _parents(right_child) = internalIndex(karras_parent);
+      }
+
       i = internalIndex(karras_parent);
     } while (i != root);
   }
@@ -336,6 +417,7 @@ private:
   LeafNodes _leaf_nodes;
   InternalNodes _internal_nodes;
   Kokkos::View<int *, MemorySpace> _ranges;
+  Kokkos::View<int *, MemorySpace> _parents; // optional (may be empty)
   int _num_internal_nodes;
 };
 
@@ -352,7 +434,9 @@ void generateHierarchy(
     Kokkos::View<LinearOrderingValueType *, LinearOrderingViewProperties...>
         sorted_morton_codes,
     LeafNodes leaf_nodes, InternalNodes internal_nodes,
-    typename InternalNodes::value_type::bounding_volume_type &bounds)
+    typename InternalNodes::value_type::bounding_volume_type &bounds,
+    Kokkos::View<int *, typename LeafNodes::memory_space> ranges,
+    Kokkos::View<int *, typename LeafNodes::memory_space> parents = {})
 {
   using ConstPermutationIndices =
       Kokkos::View<unsigned int const *, PermutationIndicesViewProperties...>;
@@ -362,7 +446,32 @@ void generateHierarchy(
   GenerateHierarchy(space, values, indexable_getter,
                     ConstPermutationIndices(permutation_indices),
                     ConstLinearOrdering(sorted_morton_codes), leaf_nodes,
-                    internal_nodes, bounds);
+                    internal_nodes, bounds, ranges, parents);
+}
+
+template <typename ExecutionSpace, typename Values, typename IndexableGetter,
+          typename... PermutationIndicesViewProperties,
+          typename LinearOrderingValueType,
+          typename... LinearOrderingViewProperties, typename LeafNodes,
+          typename InternalNodes>
+void generateHierarchy(
+    ExecutionSpace const &space, Values const &values,
+    IndexableGetter const &indexable_getter,
+    Kokkos::View<unsigned int *, PermutationIndicesViewProperties...>
+        permutation_indices,
+    Kokkos::View<LinearOrderingValueType *, LinearOrderingViewProperties...>
+        sorted_morton_codes,
+    LeafNodes leaf_nodes, InternalNodes internal_nodes,
+    typename InternalNodes::value_type::bounding_volume_type &bounds,
+    Kokkos::View<int *, typename LeafNodes::memory_space> parents = {})
+{
+  Kokkos::View<int *, typename LeafNodes::memory_space> ranges(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::BVH::BVH::ranges"),
+      internal_nodes.extent(0));
+  generateHierarchy(space, values, indexable_getter, permutation_indices,
+                    sorted_morton_codes, leaf_nodes, internal_nodes, bounds,
+                    ranges, parents);
 }
 
 } // namespace ArborX::Details::TreeConstruction
@@ -0,0 +1,267 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_TREE_CONSTRUCTION_PLOC_HPP
+#define ARBORX_DETAILS_TREE_CONSTRUCTION_PLOC_HPP
+
+#include <ArborX_DetailsAlgorithms.hpp> // expand
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsNode.hpp> // makeLeafNode
+#include <ArborX_Exception.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Details::TreeConstruction
+{
+
+// Proportional to the surface area of the box; the constant factor is
+// irrelevant as only relative values are compared.
+template <typename Box>
+KOKKOS_FUNCTION auto halfArea(Box const &box)
+{
+  constexpr int DIM = GeometryTraits::dimension_v<Box>;
+  using Coordinate = typename GeometryTraits::coordinate_type<Box>::type;
+  Coordinate area = 0;
+  for (int i = 0; i < DIM; ++i)
+  {
+    Coordinate term = 1;
+    for (int j = 0; j < DIM; ++j)
+      if (j != i)
+        term *= box.maxCorner()[j] - box.minCorner()[j];
+    area += term;
+  }
+  return area;
+}
+
+// Parallel locally-ordered clustering (PLOC) builder. Leaves, in
+// space-filling curve order, start out as clusters; each round finds for
+// every cluster the neighbor within a symmetric search window minimizing the
+// surface area of the merged volume and merges mutually-agreeing pairs into
+// internal nodes. Compared to the Karras builder this costs a few extra
+// passes over the cluster array but produces measurably tighter volumes.
+//
+// The output is the same left-child/rope node array as generateHierarchy,
+// with the root in internal slot 0; ropes are derived in a final top-down
+// sweep.
+template <typename ExecutionSpace, typename Values, typename IndexableGetter,
+          typename PermutationIndices, typename LeafNodes,
+          typename InternalNodes>
+void generateHierarchyPLOC(
+    ExecutionSpace const &space, Values const &values,
+    IndexableGetter const &indexable_getter,
+    PermutationIndices const &permutation_indices, LeafNodes leaf_nodes,
+    InternalNodes internal_nodes,
+    typename InternalNodes::value_type::bounding_volume_type &bounds,
+    int search_radius = 16)
+{
+  using MemorySpace = typename LeafNodes::memory_space;
+  using BoundingVolume =
+      typename InternalNodes::value_type::bounding_volume_type;
+
+  int const n = leaf_nodes.extent_int(0);
+  ARBORX_ASSERT(n > 1);
+
+  Kokkos::View<int *, MemorySpace> ids(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeConstruction::ploc::ids"),
+      n);
+  Kokkos::View<int *, MemorySpace> next_ids(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeConstruction::ploc::next_ids"),
+      n);
+  Kokkos::View<BoundingVolume *, MemorySpace> boxes(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeConstruction::ploc::boxes"),
+      n);
+  Kokkos::View<BoundingVolume *, MemorySpace> next_boxes(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeConstruction::ploc::next_boxes"),
+      n);
+  Kokkos::View<int *, MemorySpace> neighbors(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeConstruction::ploc::neighbors"),
+      n);
+  Kokkos::View<int *, MemorySpace> survivors(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeConstruction::ploc::survivors"),
+      n + 1);
+  // Right children are kept on the side until the rope sweep
+  Kokkos::View<int *, MemorySpace> right_children(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeConstruction::ploc::right_children"),
+      n - 1);
+  // Internal slots are handed out from the back so that the last merge,
+  // which creates the root, lands in slot 0
+  Kokkos::View<int, MemorySpace> slot_counter(
+      Kokkos::view_alloc(space, "ArborX::TreeConstruction::ploc::slots"));
+  Kokkos::deep_copy(space, slot_counter, n - 1);
+
+  Kokkos::parallel_for(
+      "ArborX::TreeConstruction::ploc::initialize_leaves",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        leaf_nodes(i) = makeLeafNode(values(permutation_indices(i)));
+        BoundingVolume bounding_volume{};
+        expand(bounding_volume, indexable_getter(leaf_nodes(i).value));
+        ids(i) = i;
+        boxes(i) = bounding_volume;
+      });
+
+  int num_clusters = n;
+  while (num_clusters > 1)
+  {
+    int const m = num_clusters;
+    int const radius = Kokkos::min(search_radius, m - 1);
+
+    Kokkos::parallel_for(
+        "ArborX::TreeConstruction::ploc::find_nearest_neighbor",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, m),
+        KOKKOS_LAMBDA(int i) {
+          using Kokkos::max;
+          using Kokkos::min;
+          auto best_area =
+              KokkosExt::ArithmeticTraits::infinity<float>::value;
+          int best = -1;
+          for (int j = max(0, i - radius); j <= min(m - 1, i + radius); ++j)
+          {
+            if (j == i)
+              continue;
+            auto merged = boxes(i);
+            expand(merged, boxes(j));
+            float const area = halfArea(merged);
+            if (area < best_area)
+            {
+              best_area = area;
+              best = j;
+            }
+          }
+          neighbors(i) = best;
+        });
+
+    Kokkos::parallel_for(
+        "ArborX::TreeConstruction::ploc::merge_pairs",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, m),
+        KOKKOS_LAMBDA(int i) {
+          int const j = neighbors(i);
+          if (neighbors(j) != i)
+          {
+            survivors(i) = 1;
+            return;
+          }
+          if (i > j)
+          {
+            // The lower index of a mutual pair carries the merged cluster;
+            // the higher one disappears
+            survivors(i) = 0;
+            return;
+          }
+          survivors(i) = 1;
+
+          int const slot = Kokkos::atomic_fetch_sub(&slot_counter(), 1) - 1;
+          auto merged = boxes(i);
+          expand(merged, boxes(j));
+          internal_nodes(slot).left_child = ids(i);
+          internal_nodes(slot).bounding_volume = merged;
+          right_children(slot) = ids(j);
+          ids(i) = n + slot;
+          boxes(i) = merged;
+        });
+
+    auto survivors_range =
+        Kokkos::subview(survivors, Kokkos::make_pair(0, m + 1));
+    KokkosExt::exclusive_scan(space, survivors_range, survivors_range, 0);
+
+    Kokkos::parallel_for(
+        "ArborX::TreeConstruction::ploc::compact",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, m),
+        KOKKOS_LAMBDA(int i) {
+          if (survivors(i + 1) != survivors(i))
+          {
+            next_ids(survivors(i)) = ids(i);
+            next_boxes(survivors(i)) = boxes(i);
+          }
+        });
+
+    num_clusters = KokkosExt::lastElement(
+        space, Kokkos::subview(survivors, Kokkos::make_pair(0, m + 1)));
+    std::swap(ids, next_ids);
+    std::swap(boxes, next_boxes);
+  }
+
+  // Top-down sweep assigning ropes: the rope of a left child is its sibling,
+  // the rope of a right child is inherited from the parent
+  Kokkos::View<int *, MemorySpace> frontier(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeConstruction::ploc::frontier"),
+      n);
+  Kokkos::View<int *, MemorySpace> next_frontier(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeConstruction::ploc::next_frontier"),
+      n);
+  Kokkos::View<int, MemorySpace> frontier_counter(
+      Kokkos::view_alloc(space, "ArborX::TreeConstruction::ploc::counter"));
+
+  Kokkos::parallel_for(
+      "ArborX::TreeConstruction::ploc::init_ropes",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, 1), KOKKOS_LAMBDA(int) {
+        internal_nodes(0).rope = ROPE_SENTINEL;
+        frontier(0) = n; // global index of the root
+      });
+
+  int frontier_size = 1;
+  while (frontier_size > 0)
+  {
+    Kokkos::deep_copy(space, frontier_counter, 0);
+    Kokkos::parallel_for(
+        "ArborX::TreeConstruction::ploc::propagate_ropes",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, frontier_size),
+        KOKKOS_LAMBDA(int f) {
+          int const node = frontier(f);
+          int const slot = node - n;
+          int const left = internal_nodes(slot).left_child;
+          int const right = right_children(slot);
+          int const rope = internal_nodes(slot).rope;
+          if (left < n)
+            leaf_nodes(left).rope = right;
+          else
+          {
+            internal_nodes(left - n).rope = right;
+            next_frontier(Kokkos::atomic_fetch_add(&frontier_counter(), 1)) =
+                left;
+          }
+          if (right < n)
+            leaf_nodes(right).rope = rope;
+          else
+          {
+            internal_nodes(right - n).rope = rope;
+            next_frontier(Kokkos::atomic_fetch_add(&frontier_counter(), 1)) =
+                right;
+          }
+        });
+    // Instance copy and fence rather than a mirror-and-copy, which would
+    // synchronize every execution space instance on each level
+    Kokkos::deep_copy(space, frontier_size, frontier_counter);
+    space.fence("ArborX::TreeConstruction::ploc (frontier size on host)");
+    std::swap(frontier, next_frontier);
+  }
+
+  Kokkos::deep_copy(
+      space,
+      Kokkos::View<BoundingVolume, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>(
+          &bounds),
+      Kokkos::View<BoundingVolume const, MemorySpace, Kokkos::MemoryUnmanaged>(
+          &internal_nodes.data()->bounding_volume));
+}
+
+} // namespace ArborX::Details::TreeConstruction
+
+#endif
@@ -0,0 +1,254 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_TREE_CONSTRUCTION_SAH_HPP
+#define ARBORX_DETAILS_TREE_CONSTRUCTION_SAH_HPP
+
+#include <ArborX_DetailsAlgorithms.hpp> // expand, returnCentroid
+#include <ArborX_DetailsNode.hpp>       // makeLeafNode
+#include <ArborX_DetailsTreeConstructionPLOC.hpp> // halfArea
+#include <ArborX_Exception.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <vector>
+
+namespace ArborX::Details::TreeConstruction
+{
+
+// Host-side top-down binned-SAH builder. Roughly an order of magnitude
+// slower than the LBVH path, but the trees visit significantly fewer nodes
+// per query, which is the right trade for geometry that is built once and
+// queried forever. The output is the same left-child/rope node array the
+// device builders produce (root in internal slot 0), so traversal is
+// oblivious to how the tree was built.
+template <typename ExecutionSpace, typename Values, typename IndexableGetter,
+          typename LeafNodes, typename InternalNodes>
+void generateHierarchySAH(
+    ExecutionSpace const &space, Values const &values,
+    IndexableGetter const &indexable_getter, int num_bins,
+    LeafNodes leaf_nodes, InternalNodes internal_nodes,
+    typename InternalNodes::value_type::bounding_volume_type &bounds)
+{
+  using MemorySpace = typename LeafNodes::memory_space;
+  using BoundingVolume =
+      typename InternalNodes::value_type::bounding_volume_type;
+  constexpr int DIM = GeometryTraits::dimension_v<BoundingVolume>;
+
+  int const n = leaf_nodes.extent_int(0);
+  ARBORX_ASSERT(n > 1);
+  ARBORX_ASSERT(num_bins > 1);
+
+  // The build itself runs on the host over the primitive boxes only; values
+  // are scattered into the leaves on the device at the very end
+  Kokkos::View<BoundingVolume *, MemorySpace> boxes(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeConstruction::sah::boxes"),
+      n);
+  Kokkos::parallel_for(
+      "ArborX::TreeConstruction::sah::compute_boxes",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        BoundingVolume bounding_volume{};
+        expand(bounding_volume, indexable_getter(values(i)));
+        boxes(i) = bounding_volume;
+      });
+  auto boxes_host =
+      Kokkos::create_mirror_view(Kokkos::WithoutInitializing, boxes);
+  Kokkos::deep_copy(space, boxes_host, boxes);
+  space.fence("ArborX::TreeConstruction::sah (boxes copied to host)");
+
+  std::vector<unsigned int> perm(n);
+  for (int i = 0; i < n; ++i)
+    perm[i] = i;
+
+  auto internal_nodes_host = Kokkos::create_mirror_view(internal_nodes);
+  std::vector<int> right_children(n - 1);
+  std::vector<int> leaf_ropes_host(n);
+
+  auto centroid = [&boxes_host](unsigned int i) {
+    return returnCentroid(boxes_host(i));
+  };
+
+  struct Task
+  {
+    int begin;
+    int end;
+    int slot; // internal slot receiving this range's node
+  };
+  std::vector<Task> stack;
+
+  int next_slot = 0; // root is created first and lands in slot 0
+  stack.push_back({0, n, next_slot++});
+
+  while (!stack.empty())
+  {
+    auto const task = stack.back();
+    stack.pop_back();
+
+    // Bounds of the range and of its centroids
+    BoundingVolume range_bounds{};
+    decltype(returnCentroid(boxes_host(0))) centroid_min, centroid_max;
+    for (int i = task.begin; i < task.end; ++i)
+    {
+      expand(range_bounds, boxes_host(perm[i]));
+      auto const c = centroid(perm[i]);
+      for (int d = 0; d < DIM; ++d)
+      {
+        if (i == task.begin || c[d] < centroid_min[d])
+          centroid_min[d] = c[d];
+        if (i == task.begin || c[d] > centroid_max[d])
+          centroid_max[d] = c[d];
+      }
+    }
+    internal_nodes_host(task.slot).bounding_volume = range_bounds;
+
+    int axis = 0;
+    for (int d = 1; d < DIM; ++d)
+      if (centroid_max[d] - centroid_min[d] >
+          centroid_max[axis] - centroid_min[axis])
+        axis = d;
+    auto const extent = centroid_max[axis] - centroid_min[axis];
+
+    int mid;
+    if (extent > 0)
+    {
+      // Binned SAH sweep along the widest centroid axis
+      std::vector<int> bin_counts(num_bins, 0);
+      std::vector<BoundingVolume> bin_bounds(num_bins);
+      auto bin_of = [&](unsigned int i) {
+        int bin = (int)((centroid(i)[axis] - centroid_min[axis]) / extent *
+                        num_bins);
+        return bin < num_bins ? bin : num_bins - 1;
+      };
+      for (int i = task.begin; i < task.end; ++i)
+      {
+        int const bin = bin_of(perm[i]);
+        ++bin_counts[bin];
+        expand(bin_bounds[bin], boxes_host(perm[i]));
+      }
+
+      // Suffix sweep, then prefix sweep keeping the cheapest split
+      std::vector<float> suffix_area(num_bins);
+      BoundingVolume suffix{};
+      for (int b = num_bins - 1; b > 0; --b)
+      {
+        expand(suffix, bin_bounds[b]);
+        suffix_area[b] = halfArea(suffix);
+      }
+      float best_cost = -1;
+      int best_split = -1;
+      BoundingVolume prefix{};
+      int prefix_count = 0;
+      for (int b = 0; b < num_bins - 1; ++b)
+      {
+        expand(prefix, bin_bounds[b]);
+        prefix_count += bin_counts[b];
+        if (prefix_count == 0 || prefix_count == task.end - task.begin)
+          continue;
+        float const cost =
+            halfArea(prefix) * prefix_count +
+            suffix_area[b + 1] * (task.end - task.begin - prefix_count);
+        if (best_split < 0 || cost < best_cost)
+        {
+          best_cost = cost;
+          best_split = b;
+        }
+      }
+
+      mid = task.begin;
+      if (best_split >= 0)
+      {
+        for (int i = task.begin; i < task.end; ++i)
+          if (bin_of(perm[i]) <= best_split)
+            std::swap(perm[i], perm[mid++]);
+      }
+    }
+    else
+    {
+      mid = task.begin;
+    }
+    if (mid == task.begin || mid == task.end)
+      mid = task.begin + (task.end - task.begin) / 2; // degenerate: median
+
+    // Children: a range of size one is a leaf (the leaf index is its final
+    // position), anything larger gets a fresh internal slot
+    int left_child, right_child;
+    if (mid - task.begin == 1)
+      left_child = task.begin;
+    else
+    {
+      left_child = n + next_slot;
+      stack.push_back({task.begin, mid, next_slot++});
+    }
+    if (task.end - mid == 1)
+      right_child = mid;
+    else
+    {
+      right_child = n + next_slot;
+      stack.push_back({mid, task.end, next_slot++});
+    }
+    internal_nodes_host(task.slot).left_child = left_child;
+    right_children[task.slot] = right_child;
+  }
+  ARBORX_ASSERT(next_slot == n - 1);
+
+  // Assign ropes top-down: the rope of a left child is its sibling, the rope
+  // of a right child is inherited from the parent
+  internal_nodes_host(0).rope = ROPE_SENTINEL;
+  std::vector<int> node_stack;
+  node_stack.push_back(0);
+  while (!node_stack.empty())
+  {
+    int const slot = node_stack.back();
+    node_stack.pop_back();
+    int const left_child = internal_nodes_host(slot).left_child;
+    int const right_child = right_children[slot];
+    int const rope = internal_nodes_host(slot).rope;
+    if (left_child < n)
+      leaf_ropes_host[left_child] = right_child;
+    else
+    {
+      internal_nodes_host(left_child - n).rope = right_child;
+      node_stack.push_back(left_child - n);
+    }
+    if (right_child < n)
+      leaf_ropes_host[right_child] = rope;
+    else
+    {
+      internal_nodes_host(right_child - n).rope = rope;
+      node_stack.push_back(right_child - n);
+    }
+  }
+
+  Kokkos::deep_copy(space, internal_nodes, internal_nodes_host);
+
+  // Scatter values and leaf ropes on the device
+  Kokkos::View<unsigned int *, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>
+      perm_host(perm.data(), n);
+  Kokkos::View<int *, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>
+      ropes_host(leaf_ropes_host.data(), n);
+  auto perm_device =
+      Kokkos::create_mirror_view_and_copy(MemorySpace{}, perm_host);
+  auto ropes_device =
+      Kokkos::create_mirror_view_and_copy(MemorySpace{}, ropes_host);
+  Kokkos::parallel_for(
+      "ArborX::TreeConstruction::sah::initialize_leaves",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        leaf_nodes(i) = makeLeafNode(values(perm_device(i)));
+        leaf_nodes(i).rope = ropes_device(i);
+      });
+
+  bounds = internal_nodes_host(0).bounding_volume;
+}
+
+} // namespace ArborX::Details::TreeConstruction
+
+#endif
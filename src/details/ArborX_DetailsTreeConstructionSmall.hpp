@@ -0,0 +1,180 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_TREE_CONSTRUCTION_SMALL_HPP
+#define ARBORX_DETAILS_TREE_CONSTRUCTION_SMALL_HPP
+
+#include <ArborX_DetailsAlgorithms.hpp> // expand
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_DetailsNode.hpp> // makeLeafNode
+#include <ArborX_Exception.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Details::TreeConstruction
+{
+
+// Single-launch builder for small trees. The multi-kernel pipeline (bounds
+// reduction, curve projection, sort, hierarchy generation) costs more in
+// launch latency than in compute below a few thousand primitives; here one
+// team does all of it in a single kernel: team-reduced scene bounds, code
+// computation, odd-even transposition sort, and the original Karras
+// formulation of the hierarchy where every internal node is computed
+// independently from binary searches over the sorted codes (no bottom-up
+// atomics, no extra launches). Quadratic sort and per-node range scans make
+// this unsuitable for large trees, which is why the constructor gates it
+// behind a size threshold.
+template <typename ExecutionSpace, typename Values, typename IndexableGetter,
+          typename SpaceFillingCurve, typename LinearOrdering,
+          typename Permutation, typename LeafNodes, typename InternalNodes>
+void buildSmallTree(
+    ExecutionSpace const &space, Values const &values,
+    IndexableGetter const &indexable_getter, SpaceFillingCurve const &curve,
+    LinearOrdering linear_ordering, Permutation permutation,
+    LeafNodes leaf_nodes, InternalNodes internal_nodes,
+    typename InternalNodes::value_type::bounding_volume_type &bounds)
+{
+  using MemorySpace = typename LeafNodes::memory_space;
+  using BoundingVolume =
+      typename InternalNodes::value_type::bounding_volume_type;
+  using LinearOrderingValueType = typename LinearOrdering::value_type;
+  using DeltaValueType = std::make_signed_t<LinearOrderingValueType>;
+  constexpr int DIM = GeometryTraits::dimension_v<BoundingVolume>;
+  using Box = ExperimentalHyperGeometry::Box<
+      DIM, typename GeometryTraits::coordinate_type<BoundingVolume>::type>;
+
+  int const n = leaf_nodes.extent_int(0);
+  ARBORX_ASSERT(n > 1);
+  ARBORX_ASSERT(linear_ordering.extent_int(0) == n);
+  ARBORX_ASSERT(permutation.extent_int(0) == n);
+
+  using TeamPolicy = Kokkos::TeamPolicy<ExecutionSpace>;
+  using team_member = typename TeamPolicy::member_type;
+
+  Kokkos::parallel_for(
+      "ArborX::TreeConstruction::build_small_tree",
+      TeamPolicy(space, 1, Kokkos::AUTO),
+      KOKKOS_LAMBDA(team_member const &team) {
+        // Distance between sorted codes i and j: the value of the highest
+        // differing bit, with the indices as tie breaker for duplicate codes
+        // (same convention as GenerateHierarchy::delta())
+        auto const dist = [&](int i, int j) {
+          constexpr auto max_value =
+              KokkosExt::ArithmeticTraits::finite_max<DeltaValueType>::value;
+          constexpr auto min_value =
+              KokkosExt::ArithmeticTraits::finite_min<DeltaValueType>::value;
+          if (j < 0 || j >= n)
+            return max_value;
+          auto const x = linear_ordering(i) ^ linear_ordering(j);
+          return (DeltaValueType)(x + (!x) * (min_value + (i ^ j)) - 1);
+        };
+        auto const delta = [&](int i) { return dist(i, i + 1); };
+
+        // Scene bounds (broadcast to the whole team by the reduction)
+        Box bbox{};
+        Kokkos::parallel_reduce(
+            Kokkos::TeamThreadRange(team, n),
+            [&](int i, Box &update) {
+              expand(update, indexable_getter(values(i)));
+            },
+            Kokkos::Sum<Box>{bbox});
+        team.team_barrier();
+
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(team, n), [&](int i) {
+          linear_ordering(i) = curve(bbox, indexable_getter(values(i)));
+          permutation(i) = i;
+        });
+        team.team_barrier();
+
+        // Odd-even transposition sort of (code, permutation) pairs
+        for (int phase = 0; phase < n; ++phase)
+        {
+          Kokkos::parallel_for(Kokkos::TeamThreadRange(team, n / 2),
+                               [&](int k) {
+                                 int const i = 2 * k + (phase & 1);
+                                 if (i + 1 < n &&
+                                     linear_ordering(i) > linear_ordering(i + 1))
+                                 {
+                                   auto const code = linear_ordering(i);
+                                   linear_ordering(i) = linear_ordering(i + 1);
+                                   linear_ordering(i + 1) = code;
+                                   auto const p = permutation(i);
+                                   permutation(i) = permutation(i + 1);
+                                   permutation(i + 1) = p;
+                                 }
+                               });
+          team.team_barrier();
+        }
+
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(team, n), [&](int i) {
+          leaf_nodes(i) = makeLeafNode(values(permutation(i)));
+          if (i != n - 1)
+            leaf_nodes(i).rope =
+                (delta(i) < delta(i + 1) ? i + 1 : (i + 1) + n);
+        });
+
+        // Internal nodes, each independently (Karras 2012): determine the
+        // range direction, its length by exponential + binary search, and
+        // the split position; children and rope follow from those
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(team, n - 1), [&](int i) {
+          int const d = (dist(i, i + 1) < dist(i, i - 1) ? 1 : -1);
+          auto const dist_min = dist(i, i - d);
+
+          int length_max = 2;
+          while (dist(i, i + length_max * d) < dist_min)
+            length_max *= 2;
+          int length = 0;
+          for (int t = length_max / 2; t > 0; t /= 2)
+            if (dist(i, i + (length + t) * d) < dist_min)
+              length += t;
+          int const j = i + length * d;
+
+          auto const dist_node = dist(i, j);
+          int s = 0;
+          for (int t = (length + 1) / 2;; t = (t + 1) / 2)
+          {
+            if (dist(i, i + (s + t) * d) < dist_node)
+              s += t;
+            if (t == 1)
+              break;
+          }
+          int const split = i + s * d + Kokkos::min(d, 0);
+
+          int const range_left = Kokkos::min(i, j);
+          int const range_right = Kokkos::max(i, j);
+
+          auto &node = internal_nodes(i);
+          node.left_child = (split == range_left ? split : split + n);
+          if (range_right != n - 1)
+            node.rope = (delta(range_right) < delta(range_right + 1)
+                             ? range_right + 1
+                             : (range_right + 1) + n);
+          else
+            node.rope = ROPE_SENTINEL;
+
+          BoundingVolume bounding_volume{};
+          for (int leaf = range_left; leaf <= range_right; ++leaf)
+            expand(bounding_volume, indexable_getter(leaf_nodes(leaf).value));
+          node.bounding_volume = bounding_volume;
+        });
+      });
+
+  Kokkos::deep_copy(
+      space,
+      Kokkos::View<BoundingVolume, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>(
+          &bounds),
+      Kokkos::View<BoundingVolume const, MemorySpace, Kokkos::MemoryUnmanaged>(
+          &internal_nodes.data()->bounding_volume));
+}
+
+} // namespace ArborX::Details::TreeConstruction
+
+#endif
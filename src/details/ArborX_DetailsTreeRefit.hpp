@@ -0,0 +1,125 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_TREE_REFIT_HPP
+#define ARBORX_DETAILS_TREE_REFIT_HPP
+
+#include <ArborX_DetailsAlgorithms.hpp> // expand
+#include <ArborX_DetailsNode.hpp>
+#include <ArborX_Exception.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Details::TreeRefit
+{
+
+// Recover parent links from the left-child/rope representation. The right
+// child of an internal node is the rope of its left child, so a single pass
+// over the internal nodes assigns both children their parent. Node indices
+// are global: leaves in [0, n), internal nodes in [n, 2n - 1) with the root
+// at n, matching the convention of HappyTreeFriends.
+template <typename ExecutionSpace, typename LeafNodes, typename InternalNodes,
+          typename Parents>
+void computeParents(ExecutionSpace const &space, LeafNodes const &leaf_nodes,
+                    InternalNodes const &internal_nodes, Parents parents)
+{
+  int const n = leaf_nodes.extent_int(0);
+  ARBORX_ASSERT(parents.extent_int(0) == 2 * n - 1);
+
+  Kokkos::parallel_for(
+      "ArborX::TreeRefit::compute_parents",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n - 1),
+      KOKKOS_LAMBDA(int j) {
+        int const left_child = internal_nodes(j).left_child;
+        int const right_child =
+            (left_child < n ? leaf_nodes(left_child).rope
+                            : internal_nodes(left_child - n).rope);
+        parents(left_child) = j + n;
+        parents(right_child) = j + n;
+      });
+}
+
+// Refit internal bounding volumes bottom-up while keeping the topology. Every
+// leaf walks toward the root; as in construction, an atomic flag per internal
+// node stops the first thread arriving and lets the second one through once
+// both children volumes are up to date.
+template <typename ExecutionSpace, typename Values, typename IndexableGetter,
+          typename PermutationIndices, typename LeafNodes,
+          typename InternalNodes, typename Parents>
+void refitHierarchy(
+    ExecutionSpace const &space, Values const &values,
+    IndexableGetter const &indexable_getter,
+    PermutationIndices const &permutation_indices, LeafNodes leaf_nodes,
+    InternalNodes internal_nodes, Parents const &parents,
+    typename InternalNodes::value_type::bounding_volume_type &bounds)
+{
+  using MemorySpace = typename LeafNodes::memory_space;
+  using BoundingVolume =
+      typename InternalNodes::value_type::bounding_volume_type;
+
+  int const n = leaf_nodes.extent_int(0);
+
+  Kokkos::View<int *, MemorySpace> counters(
+      Kokkos::view_alloc(space, "ArborX::TreeRefit::counters"), n - 1);
+
+  Kokkos::parallel_for(
+      "ArborX::TreeRefit::refit_hierarchy",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        // Replace the leaf value, preserving the position the leaf was
+        // assigned during construction
+        auto &leaf_node = leaf_nodes(i);
+        leaf_node.value = values(permutation_indices(i));
+
+        int node = parents(i);
+        do
+        {
+          // The first thread up terminates; the second one sees both
+          // children's updated volumes
+          if (Kokkos::atomic_fetch_add(&counters(node - n), 1) == 0)
+            break;
+
+          int const left_child = internal_nodes(node - n).left_child;
+          int const right_child =
+              (left_child < n ? leaf_nodes(left_child).rope
+                              : internal_nodes(left_child - n).rope);
+
+          BoundingVolume bounding_volume{};
+          // NOTE we need acquire semantics at the device scope
+          Kokkos::load_fence();
+          if (left_child < n)
+            expand(bounding_volume,
+                   indexable_getter(leaf_nodes(left_child).value));
+          else
+            expand(bounding_volume,
+                   internal_nodes(left_child - n).bounding_volume);
+          if (right_child < n)
+            expand(bounding_volume,
+                   indexable_getter(leaf_nodes(right_child).value));
+          else
+            expand(bounding_volume,
+                   internal_nodes(right_child - n).bounding_volume);
+          internal_nodes(node - n).bounding_volume = bounding_volume;
+
+          node = (node == n ? ROPE_SENTINEL : parents(node));
+        } while (node != ROPE_SENTINEL);
+      });
+
+  Kokkos::deep_copy(
+      space,
+      Kokkos::View<BoundingVolume, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>(
+          &bounds),
+      Kokkos::View<BoundingVolume const, MemorySpace, Kokkos::MemoryUnmanaged>(
+          &internal_nodes.data()->bounding_volume));
+}
+
+} // namespace ArborX::Details::TreeRefit
+
+#endif
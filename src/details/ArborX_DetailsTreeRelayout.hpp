@@ -0,0 +1,141 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_TREE_RELAYOUT_HPP
+#define ARBORX_DETAILS_TREE_RELAYOUT_HPP
+
+#include <ArborX_DetailsNode.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <utility> // swap
+
+namespace ArborX::Details::TreeConstruction
+{
+
+// Rewrite the internal node array in breadth-first order. The bottom-up
+// builders leave internal nodes in Karras order, which scatters a typical
+// root-to-leaf path across the array; after this pass the top levels of the
+// tree — the ones every traversal touches — are contiguous, which noticeably
+// reduces cache misses for host-side traversals. Breadth-first is preferred
+// over van Emde Boas here because the rope-based traversal walks ropes as
+// often as children, and BFS keeps both kinds of neighbors in nearby lines.
+// The root stays in internal slot 0, so nothing else in the tree needs to
+// know the layout changed.
+template <typename ExecutionSpace, typename LeafNodes, typename InternalNodes>
+void relayoutBreadthFirst(ExecutionSpace const &space, LeafNodes leaf_nodes,
+                          InternalNodes internal_nodes)
+{
+  using MemorySpace = typename InternalNodes::memory_space;
+  using Node = typename InternalNodes::value_type;
+
+  int const n = leaf_nodes.extent_int(0);
+  int const num_internal = n - 1;
+  if (num_internal < 2)
+    return;
+
+  Kokkos::View<int *, MemorySpace> order(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeConstruction::relayout::order"),
+      num_internal);
+  Kokkos::View<int *, MemorySpace> new_index(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeConstruction::relayout::new_index"),
+      num_internal);
+  Kokkos::View<int *, MemorySpace> frontier(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeConstruction::relayout::frontier"),
+      num_internal);
+  Kokkos::View<int *, MemorySpace> next_frontier(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeConstruction::relayout::next_frontier"),
+      num_internal);
+  Kokkos::View<int, MemorySpace> frontier_counter(
+      "ArborX::TreeConstruction::relayout::frontier_counter");
+
+  Kokkos::parallel_for(
+      "ArborX::TreeConstruction::relayout::seed_root",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, 1), KOKKOS_LAMBDA(int) {
+        frontier(0) = 0;
+        order(0) = 0;
+        new_index(0) = 0;
+      });
+
+  // Level-by-level sweep from the root, handing out BFS positions
+  int frontier_size = 1;
+  int num_placed = 1;
+  while (frontier_size > 0)
+  {
+    Kokkos::deep_copy(space, frontier_counter, 0);
+    int const offset = num_placed;
+    Kokkos::parallel_for(
+        "ArborX::TreeConstruction::relayout::expand_frontier",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, frontier_size),
+        KOKKOS_LAMBDA(int i) {
+          int const node = frontier(i);
+          int const left_child = internal_nodes(node).left_child;
+          int const right_child = (left_child < n
+                                       ? leaf_nodes(left_child).rope
+                                       : internal_nodes(left_child - n).rope);
+          if (left_child >= n)
+          {
+            int const pos =
+                offset + Kokkos::atomic_fetch_add(&frontier_counter(), 1);
+            order(pos) = left_child - n;
+            new_index(left_child - n) = pos;
+            next_frontier(pos - offset) = left_child - n;
+          }
+          if (right_child >= n)
+          {
+            int const pos =
+                offset + Kokkos::atomic_fetch_add(&frontier_counter(), 1);
+            order(pos) = right_child - n;
+            new_index(right_child - n) = pos;
+            next_frontier(pos - offset) = right_child - n;
+          }
+        });
+    Kokkos::deep_copy(space, frontier_size, frontier_counter);
+    space.fence(
+        "ArborX::TreeConstruction::relayout (frontier size copied to host)");
+    num_placed += frontier_size;
+    std::swap(frontier, next_frontier);
+  }
+
+  // Scatter nodes into their BFS slots with child and rope indices remapped;
+  // leaf indices and the rope sentinel pass through unchanged
+  Kokkos::View<Node *, MemorySpace> relaid_nodes(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeConstruction::relayout::nodes"),
+      num_internal);
+  Kokkos::parallel_for(
+      "ArborX::TreeConstruction::relayout::remap_internal",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_internal),
+      KOKKOS_LAMBDA(int i) {
+        auto node = internal_nodes(order(i));
+        if (node.left_child >= n)
+          node.left_child = n + new_index(node.left_child - n);
+        if (node.rope >= n)
+          node.rope = n + new_index(node.rope - n);
+        relaid_nodes(i) = node;
+      });
+  Kokkos::parallel_for(
+      "ArborX::TreeConstruction::relayout::remap_leaf_ropes",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        auto &rope = leaf_nodes(i).rope;
+        if (rope >= n)
+          rope = n + new_index(rope - n);
+      });
+  Kokkos::deep_copy(space, internal_nodes, relaid_nodes);
+}
+
+} // namespace ArborX::Details::TreeConstruction
+
+#endif
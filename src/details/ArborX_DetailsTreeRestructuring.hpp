@@ -0,0 +1,210 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_TREE_RESTRUCTURING_HPP
+#define ARBORX_DETAILS_TREE_RESTRUCTURING_HPP
+
+#include <ArborX_DetailsAlgorithms.hpp> // expand
+#include <ArborX_DetailsNode.hpp>
+#include <ArborX_DetailsTreeConstructionPLOC.hpp> // halfArea
+#include <ArborX_Exception.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Details::TreeConstruction
+{
+
+// Post-build optimization pass reducing the expected number of nodes visited
+// per query. Each round considers, for every internal node, swapping one of
+// its children with a grandchild (a tree rotation) and applies the swap when
+// it shrinks the surface area of the affected intermediate node. Rotations
+// preserve the set of leaves below a node, so only the rotated child's volume
+// needs recomputing. This is the cheap cousin of full treelet restructuring:
+// a handful of rounds typically recovers a sizable part of the SAH gap
+// between Morton-built and SAH-built trees.
+//
+// Node indices are global (leaves in [0, n), internal in [n, 2n - 1), root at
+// n), and ropes are rewritten from scratch in a final top-down sweep.
+template <typename ExecutionSpace, typename IndexableGetter,
+          typename LeafNodes, typename InternalNodes>
+void optimizeTreeRotations(ExecutionSpace const &space,
+                           IndexableGetter const &indexable_getter,
+                           LeafNodes leaf_nodes, InternalNodes internal_nodes,
+                           int num_rounds)
+{
+  using MemorySpace = typename LeafNodes::memory_space;
+  using BoundingVolume =
+      typename InternalNodes::value_type::bounding_volume_type;
+
+  int const n = leaf_nodes.extent_int(0);
+  ARBORX_ASSERT(n > 1);
+
+  // Explicit children arrays; ropes are invalidated by rotations and
+  // recomputed at the end
+  Kokkos::View<int *, MemorySpace> left(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeRestructuring::left"),
+      n - 1);
+  Kokkos::View<int *, MemorySpace> right(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeRestructuring::right"),
+      n - 1);
+  Kokkos::View<int *, MemorySpace> locks(
+      Kokkos::view_alloc(space, "ArborX::TreeRestructuring::locks"), n - 1);
+
+  Kokkos::parallel_for(
+      "ArborX::TreeRestructuring::extract_children",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n - 1),
+      KOKKOS_LAMBDA(int j) {
+        int const left_child = internal_nodes(j).left_child;
+        left(j) = left_child;
+        right(j) = (left_child < n ? leaf_nodes(left_child).rope
+                                   : internal_nodes(left_child - n).rope);
+      });
+
+  auto volume_of = KOKKOS_LAMBDA(int node)
+  {
+    BoundingVolume bounding_volume{};
+    if (node < n)
+      expand(bounding_volume, indexable_getter(leaf_nodes(node).value));
+    else
+      expand(bounding_volume, internal_nodes(node - n).bounding_volume);
+    return bounding_volume;
+  };
+
+  for (int round = 0; round < num_rounds; ++round)
+  {
+    Kokkos::parallel_for(
+        "ArborX::TreeRestructuring::rotate",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n - 1),
+        KOKKOS_LAMBDA(int j) {
+          // Best-effort: a node whose lock cannot be taken is simply skipped
+          // this round
+          if (Kokkos::atomic_compare_exchange(&locks(j), 0, 1) != 0)
+            return;
+
+          // Consider the four grandchild-for-child swaps and keep the one
+          // with the largest surface area reduction of the intermediate node
+          float best_gain = 0;
+          int best_candidate = -1; // 0: R<->LL, 1: R<->LR, 2: L<->RL, 3: L<->RR
+          int const L = left(j);
+          int const R = right(j);
+          for (int candidate = 0; candidate < 4; ++candidate)
+          {
+            int const child = (candidate < 2 ? L : R);
+            if (child < n)
+              continue; // cannot rotate through a leaf
+            int const other = (candidate < 2 ? R : L);
+            int const kept = (candidate % 2 == 0 ? right(child - n)
+                                                 : left(child - n));
+            auto const old_area =
+                halfArea(internal_nodes(child - n).bounding_volume);
+            auto merged = volume_of(kept);
+            expand(merged, volume_of(other));
+            float const gain = old_area - halfArea(merged);
+            if (gain > best_gain)
+            {
+              best_gain = gain;
+              best_candidate = candidate;
+            }
+          }
+
+          if (best_candidate >= 0)
+          {
+            int const child = (best_candidate < 2 ? L : R);
+            // Lock the intermediate node so that it does not rotate (or get
+            // rotated through) concurrently
+            if (Kokkos::atomic_compare_exchange(&locks(child - n), 0, 1) == 0)
+            {
+              int const other = (best_candidate < 2 ? R : L);
+              auto &demoted = (best_candidate % 2 == 0 ? left(child - n)
+                                                       : right(child - n));
+              int const promoted = demoted;
+              demoted = other;
+              if (best_candidate < 2)
+                right(j) = promoted;
+              else
+                left(j) = promoted;
+
+              auto merged = volume_of(left(child - n));
+              expand(merged, volume_of(right(child - n)));
+              internal_nodes(child - n).bounding_volume = merged;
+
+              Kokkos::memory_fence();
+              Kokkos::atomic_store(&locks(child - n), 0);
+            }
+          }
+          Kokkos::memory_fence();
+          Kokkos::atomic_store(&locks(j), 0);
+        });
+  }
+
+  // Write the updated topology back in left-child/rope form: the rope of a
+  // left child is its sibling, the rope of a right child is inherited
+  Kokkos::View<int *, MemorySpace> frontier(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeRestructuring::frontier"),
+      n);
+  Kokkos::View<int *, MemorySpace> next_frontier(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeRestructuring::next_frontier"),
+      n);
+  Kokkos::View<int, MemorySpace> frontier_counter(
+      Kokkos::view_alloc(space, "ArborX::TreeRestructuring::counter"));
+
+  Kokkos::parallel_for(
+      "ArborX::TreeRestructuring::init_ropes",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, 1), KOKKOS_LAMBDA(int) {
+        internal_nodes(0).rope = ROPE_SENTINEL;
+        frontier(0) = n; // global index of the root
+      });
+
+  int frontier_size = 1;
+  while (frontier_size > 0)
+  {
+    Kokkos::deep_copy(space, frontier_counter, 0);
+    Kokkos::parallel_for(
+        "ArborX::TreeRestructuring::propagate_ropes",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, frontier_size),
+        KOKKOS_LAMBDA(int f) {
+          int const node = frontier(f);
+          int const slot = node - n;
+          int const left_child = left(slot);
+          int const right_child = right(slot);
+          int const rope = internal_nodes(slot).rope;
+          internal_nodes(slot).left_child = left_child;
+          if (left_child < n)
+            leaf_nodes(left_child).rope = right_child;
+          else
+          {
+            internal_nodes(left_child - n).rope = right_child;
+            next_frontier(Kokkos::atomic_fetch_add(&frontier_counter(), 1)) =
+                left_child;
+          }
+          if (right_child < n)
+            leaf_nodes(right_child).rope = rope;
+          else
+          {
+            internal_nodes(right_child - n).rope = rope;
+            next_frontier(Kokkos::atomic_fetch_add(&frontier_counter(), 1)) =
+                right_child;
+          }
+        });
+    auto counter_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace{}, frontier_counter);
+    frontier_size = counter_host();
+    std::swap(frontier, next_frontier);
+  }
+}
+
+} // namespace ArborX::Details::TreeConstruction
+
+#endif
@@ -16,11 +16,16 @@
 #include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
 #include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsLaunchPolicies.hpp>
 #include <ArborX_DetailsNode.hpp> // ROPE_SENTINEL
 #include <ArborX_DetailsPriorityQueue.hpp>
 #include <ArborX_DetailsStack.hpp>
 #include <ArborX_Exception.hpp>
 #include <ArborX_Predicates.hpp>
+#include <ArborX_TraversalStatistics.hpp>
+
+#include <algorithm> // min
+#include <utility>   // declval
 
 namespace ArborX
 {
@@ -37,13 +42,18 @@ struct TreeTraversal<BVH, Predicates, Callback, SpatialPredicateTag>
   BVH _bvh;
   Predicates _predicates;
   Callback _callback;
+  // Latency histogram bins; null unless a TraversalStatistics was set on the
+  // policy (see TraversalPolicy::setLatencyHistogram())
+  unsigned long long *_latency_histogram = nullptr;
 
   template <typename ExecutionSpace>
   TreeTraversal(ExecutionSpace const &space, BVH const &bvh,
-                Predicates const &predicates, Callback const &callback)
+                Predicates const &predicates, Callback const &callback,
+                unsigned long long *latency_histogram = nullptr)
       : _bvh{bvh}
       , _predicates{predicates}
       , _callback{callback}
+      , _latency_histogram{latency_histogram}
   {
     if (_bvh.empty())
     {
@@ -57,13 +67,18 @@ struct TreeTraversal<BVH, Predicates, Callback, SpatialPredicateTag>
                                                            predicates.size()),
           *this);
     }
-    else
+    else if (_latency_histogram)
     {
-      Kokkos::parallel_for("ArborX::TreeTraversal::spatial",
-                           Kokkos::RangePolicy<ExecutionSpace, FullTree>(
+      Kokkos::parallel_for("ArborX::TreeTraversal::spatial_timed",
+                           Kokkos::RangePolicy<ExecutionSpace, FullTreeTimed>(
                                space, 0, predicates.size()),
                            *this);
     }
+    else
+    {
+      launchTraversalKernel<FullTree>("ArborX::TreeTraversal::spatial", space,
+                                      predicates.size(), *this);
+    }
   }
 
   KOKKOS_FUNCTION TreeTraversal(BVH const &bvh, Callback const &callback)
@@ -77,6 +92,12 @@ struct TreeTraversal<BVH, Predicates, Callback, SpatialPredicateTag>
   struct FullTree
   {};
 
+  // Latency instrumentation is selected by work tag at launch, not by a
+  // runtime branch: the common instantiation compiles without the clock
+  // reads and the histogram check on its hot path
+  struct FullTreeTimed
+  {};
+
   KOKKOS_FUNCTION void operator()(OneLeafTree, int queryIndex) const
   {
     auto const &predicate = _predicates(queryIndex);
@@ -94,6 +115,13 @@ struct TreeTraversal<BVH, Predicates, Callback, SpatialPredicateTag>
     operator()(_predicates(queryIndex));
   }
 
+  KOKKOS_FUNCTION void operator()(FullTreeTimed, int queryIndex) const
+  {
+    auto const start = traversalClock();
+    operator()(_predicates(queryIndex));
+    recordTraversalLatency(_latency_histogram, traversalClock() - start);
+  }
+
   template <typename Predicate>
   KOKKOS_FUNCTION void operator()(Predicate const &predicate) const
   {
@@ -117,6 +145,183 @@ struct TreeTraversal<BVH, Predicates, Callback, SpatialPredicateTag>
       }
     } while (node != ROPE_SENTINEL);
   }
+
+  // Cooperative variant: caller `rank` of `size` concurrent callers (e.g. the
+  // members of a team) claims the subtree reached by descending from the root
+  // along the path encoded by its rank bits, then runs the regular rope walk
+  // bounded to that subtree. The 2^floor(log2(size)) paths partition the tree,
+  // so every leaf is visited by exactly one caller; callers whose path is
+  // pruned by the predicate (or whose rank exceeds the largest power of two)
+  // return immediately. See BVH::query(Experimental::PerTeam, ...).
+  template <typename Predicate>
+  KOKKOS_FUNCTION void operator()(Predicate const &predicate, int rank,
+                                  int size) const
+  {
+    int levels = 0;
+    while ((2 << levels) <= size)
+      ++levels;
+    if (rank >= (1 << levels))
+      return;
+
+    int node = HappyTreeFriends::getRoot(_bvh);
+    for (int bit = levels - 1; bit >= 0; --bit)
+    {
+      if (HappyTreeFriends::isLeaf(_bvh, node))
+      {
+        // The remaining subtree is a single leaf; keep it on the one caller
+        // whose remaining path bits are all zero
+        if ((rank & ((2 << bit) - 1)) != 0)
+          return;
+        break;
+      }
+      if (!predicate(HappyTreeFriends::getInternalBoundingVolume(_bvh, node)))
+        return;
+      node = ((rank >> bit) & 1) ? HappyTreeFriends::getRightChild(_bvh, node)
+                                 : HappyTreeFriends::getLeftChild(_bvh, node);
+    }
+
+    // Within the claimed subtree every rope points either inside it or to
+    // the rope of the subtree root, which therefore bounds the walk
+    int const exit_node = HappyTreeFriends::getRope(_bvh, node);
+    do
+    {
+      if (HappyTreeFriends::isLeaf(_bvh, node))
+      {
+        if (predicate(HappyTreeFriends::getIndexable(_bvh, node)) &&
+            invoke_callback_and_check_early_exit(
+                _callback, predicate, HappyTreeFriends::getValue(_bvh, node)))
+          return;
+        node = HappyTreeFriends::getRope(_bvh, node);
+      }
+      else
+      {
+        node =
+            (predicate(HappyTreeFriends::getInternalBoundingVolume(_bvh, node))
+                 ? HappyTreeFriends::getLeftChild(_bvh, node)
+                 : HappyTreeFriends::getRope(_bvh, node));
+      }
+    } while (node != exit_node);
+  }
+
+  // Variant staging the entire node array into team scratch (shared memory
+  // on GPU backends) and traversing it from there: for a small tree hit by
+  // many predicates the node loads, by far the hottest global-memory
+  // traffic, become shared-memory reads. Each team copies the tree once
+  // and grid-strides over the predicates to amortize the staging. Trees
+  // that do not fit in scratch fall back to the regular rope walk.
+  struct ScratchTree
+  {};
+
+  using leaf_node_type = typename std::decay_t<decltype(
+      HappyTreeFriends::getLeafNodes(std::declval<BVH>()))>::value_type;
+  using internal_node_type = typename std::decay_t<decltype(
+      HappyTreeFriends::getInternalNodes(std::declval<BVH>()))>::value_type;
+
+  static constexpr std::size_t scratchPerTeam(int n)
+  {
+    return n * sizeof(leaf_node_type) + (n - 1) * sizeof(internal_node_type);
+  }
+
+  template <typename ExecutionSpace>
+  TreeTraversal(ExecutionSpace const &space, BVH const &bvh,
+                Predicates const &predicates, Callback const &callback,
+                ScratchTree)
+      : _bvh{bvh}
+      , _predicates{predicates}
+      , _callback{callback}
+  {
+    if (_bvh.empty())
+    {
+      // do nothing
+    }
+    else if (_bvh.size() == 1)
+    {
+      Kokkos::parallel_for(
+          "ArborX::TreeTraversal::spatial::degenerated_one_leaf_tree",
+          Kokkos::RangePolicy<ExecutionSpace, OneLeafTree>(space, 0,
+                                                           predicates.size()),
+          *this);
+    }
+    else
+    {
+      int const n_queries = _predicates.size();
+      std::size_t const bytes = scratchPerTeam(_bvh.size());
+      using TeamPolicy = Kokkos::TeamPolicy<ExecutionSpace, ScratchTree>;
+      TeamPolicy probe(space, 1, 1);
+      int const team_size = std::min(
+          probe.team_size_max(*this, Kokkos::ParallelForTag{}), n_queries);
+      if (team_size < 1 || bytes > (std::size_t)TeamPolicy::scratch_size_max(0))
+      {
+        // The tree does not fit in scratch; regular global-memory walk
+        launchTraversalKernel<FullTree>("ArborX::TreeTraversal::spatial", space,
+                                        n_queries, *this);
+        return;
+      }
+      // Cap the league so that every thread processes several predicates and
+      // the staging cost is paid once for all of them
+      int const num_teams =
+          std::min((n_queries + team_size - 1) / team_size, 4096);
+      Kokkos::parallel_for(
+          "ArborX::TreeTraversal::spatial_scratch_tree",
+          TeamPolicy(space, num_teams, team_size)
+              .set_scratch_size(0, Kokkos::PerTeam(bytes)),
+          *this);
+    }
+  }
+
+  template <typename TeamMember>
+  KOKKOS_FUNCTION void operator()(ScratchTree, TeamMember const &team) const
+  {
+    int const n = _bvh.size();
+    auto *leaf_nodes = (leaf_node_type *)team.team_scratch(0).get_shmem(
+        n * sizeof(leaf_node_type));
+    auto *internal_nodes = (internal_node_type *)team.team_scratch(0).get_shmem(
+        (n - 1) * sizeof(internal_node_type));
+    auto const &global_leaf_nodes = HappyTreeFriends::getLeafNodes(_bvh);
+    auto const &global_internal_nodes =
+        HappyTreeFriends::getInternalNodes(_bvh);
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, 2 * n - 1), [&](int i) {
+      if (i < n)
+        leaf_nodes[i] = global_leaf_nodes(i);
+      else
+        internal_nodes[i - n] = global_internal_nodes(i - n);
+    });
+    team.team_barrier();
+
+    int const n_queries = _predicates.size();
+    int const stride = team.league_size() * team.team_size();
+    for (int q = team.league_rank() * team.team_size() + team.team_rank();
+         q < n_queries; q += stride)
+    {
+      auto const &predicate = _predicates(q);
+      int node = n; // root
+      do
+      {
+        if (node < n)
+        {
+          auto const &leaf = leaf_nodes[node];
+          bool matches;
+          if constexpr (HappyTreeFriends::has_soa_values<BVH>::value)
+            matches = predicate(leaf.value);
+          else
+            matches = predicate(
+                HappyTreeFriends::getIndexableGetter(_bvh)(leaf.value));
+          // The value is reread from global memory, but only on a match
+          if (matches && invoke_callback_and_check_early_exit(
+                             _callback, predicate,
+                             HappyTreeFriends::getValue(_bvh, node)))
+            break;
+          node = leaf.rope;
+        }
+        else
+        {
+          auto const &internal = internal_nodes[node - n];
+          node = predicate(internal.bounding_volume) ? internal.left_child
+                                                     : internal.rope;
+        }
+      } while (node != ROPE_SENTINEL);
+    }
+  }
 };
 
 template <typename BVH, typename Predicates, typename Callback>
@@ -127,6 +332,9 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
   BVH _bvh;
   Predicates _predicates;
   Callback _callback;
+  // Latency histogram bins; null unless a TraversalStatistics was set on the
+  // policy (see TraversalPolicy::setLatencyHistogram())
+  unsigned long long *_latency_histogram = nullptr;
 
   using Buffer = Kokkos::View<Kokkos::pair<int, float> *, MemorySpace>;
   using Offset = Kokkos::View<int *, MemorySpace>;
@@ -144,6 +352,8 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
   };
 
   BufferProvider _buffer;
+  // Interleaved buffer of the k-major variant (see KMajorBuffer)
+  Buffer _k_major_buffer;
 
   template <typename ExecutionSpace>
   void allocateBuffer(ExecutionSpace const &space)
@@ -173,7 +383,152 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
 
   template <typename ExecutionSpace>
   TreeTraversal(ExecutionSpace const &space, BVH const &bvh,
-                Predicates const &predicates, Callback const &callback)
+                Predicates const &predicates, Callback const &callback,
+                unsigned long long *latency_histogram = nullptr)
+      : _bvh{bvh}
+      , _predicates{predicates}
+      , _callback{callback}
+      , _latency_histogram{latency_histogram}
+  {
+    if (_bvh.empty())
+    {
+      // do nothing
+    }
+    else if (_bvh.size() == 1)
+    {
+      Kokkos::parallel_for(
+          "ArborX::TreeTraversal::nearest::degenerated_one_leaf_tree",
+          Kokkos::RangePolicy<ExecutionSpace, OneLeafTree>(space, 0,
+                                                           predicates.size()),
+          *this);
+    }
+    else
+    {
+      // Compile-time-k predicates keep their candidate sets in registers
+      if constexpr (!has_static_k<typename Predicates::value_type>::value)
+        allocateBuffer(space);
+
+      if (_latency_histogram)
+        Kokkos::parallel_for(
+            "ArborX::TreeTraversal::nearest_timed",
+            Kokkos::RangePolicy<ExecutionSpace, Timed>(space, 0,
+                                                       predicates.size()),
+            *this);
+      else
+        launchTraversalKernel("ArborX::TreeTraversal::nearest", space,
+                              predicates.size(), *this);
+    }
+  }
+
+  // Variant laying the result buffer out k-major: entry i of query q lives
+  // at i * n_queries + q instead of the row-major offset(q) + i, so the
+  // heap updates that adjacent threads perform on the same heap level fall
+  // on adjacent words and coalesce. Worthwhile for large runtime k (say,
+  // in the hundreds), where the heap operations dominate the memory
+  // traffic of the traversal; the layout allocates max(k) entries for
+  // every query, so batches with wildly varying k pay for the padding.
+  struct KMajorBuffer
+  {};
+
+  // NOTE not inlined in the constructor, which cannot have an extended
+  // __host__ __device__ lambda with NVCC
+  template <typename ExecutionSpace>
+  void allocateKMajorBuffer(ExecutionSpace const &space)
+  {
+    int const n_queries = _predicates.size();
+    int max_k = 0;
+    Kokkos::parallel_reduce(
+        "ArborX::TreeTraversal::nearest::max_k",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_CLASS_LAMBDA(int i, int &update) {
+          update = Kokkos::max(update, getK(_predicates(i)));
+        },
+        Kokkos::Max<int>(max_k));
+    _k_major_buffer =
+        Buffer(Kokkos::view_alloc(
+                   space, Kokkos::WithoutInitializing,
+                   "ArborX::TreeTraversal::nearest::k_major_buffer"),
+               (size_t)max_k * n_queries);
+  }
+
+  template <typename ExecutionSpace>
+  TreeTraversal(ExecutionSpace const &space, BVH const &bvh,
+                Predicates const &predicates, Callback const &callback,
+                KMajorBuffer)
+      : _bvh{bvh}
+      , _predicates{predicates}
+      , _callback{callback}
+  {
+    if (_bvh.empty())
+    {
+      // do nothing
+    }
+    else if (_bvh.size() == 1)
+    {
+      Kokkos::parallel_for(
+          "ArborX::TreeTraversal::nearest::degenerated_one_leaf_tree",
+          Kokkos::RangePolicy<ExecutionSpace, OneLeafTree>(space, 0,
+                                                           predicates.size()),
+          *this);
+    }
+    else
+    {
+      if constexpr (!has_static_k<typename Predicates::value_type>::value)
+        allocateKMajorBuffer(space);
+
+      launchTraversalKernel<KMajorBuffer>(
+          "ArborX::TreeTraversal::nearest_k_major", space, predicates.size(),
+          *this);
+    }
+  }
+
+  KOKKOS_FUNCTION void operator()(KMajorBuffer, int queryIndex) const
+  {
+    int stack[stack_capacity];
+#if !defined(__CUDA_ARCH__)
+    float stack_distance[stack_capacity];
+    float *stack_distance_ptr = stack_distance;
+#else
+    float *stack_distance_ptr = nullptr;
+#endif
+    using Predicate = std::decay_t<decltype(_predicates(0))>;
+    if constexpr (has_static_k<Predicate>::value)
+    {
+      // Compile-time-k candidate sets live in registers; the layout of the
+      // global buffer is moot
+      nearestQueryStaticK<Predicate::static_k>(queryIndex, stack,
+                                               stack_distance_ptr);
+    }
+    else
+    {
+      using PairIndexDistance = Kokkos::pair<int, float>;
+      nearestQuery(queryIndex, stack, stack_distance_ptr,
+                   UnmanagedStridedVector<PairIndexDistance>(
+                       _k_major_buffer.data() + queryIndex,
+                       getK(_predicates(queryIndex)),
+                       (std::ptrdiff_t)_predicates.size()));
+    }
+  }
+
+  // Variant keeping the per-thread traversal stacks in team scratch (shared
+  // memory on GPU backends) instead of thread-local memory, where they spill
+  // to local/global memory under register pressure
+  struct ScratchStack
+  {};
+
+  static constexpr int stack_capacity = 64;
+
+  static constexpr std::size_t scratchPerThread()
+  {
+    // The distance stack is only used by non-CUDA backends but is reserved
+    // unconditionally to keep the launch configuration backend-agnostic
+    return stack_capacity * (sizeof(int) + sizeof(float));
+  }
+
+  template <typename ExecutionSpace>
+  TreeTraversal(ExecutionSpace const &space, BVH const &bvh,
+                Predicates const &predicates, Callback const &callback,
+                ScratchStack)
       : _bvh{bvh}
       , _predicates{predicates}
       , _callback{callback}
@@ -192,15 +547,115 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
     }
     else
     {
-      allocateBuffer(space);
+      if constexpr (!has_static_k<typename Predicates::value_type>::value)
+        allocateBuffer(space);
 
+      int const n_queries = _predicates.size();
+      using TeamPolicy = Kokkos::TeamPolicy<ExecutionSpace, ScratchStack>;
+      TeamPolicy probe(space, 1, 1);
+      int const team_size = std::min(
+          {probe.team_size_max(*this, Kokkos::ParallelForTag{}),
+           (int)(TeamPolicy::scratch_size_max(0) / scratchPerThread()),
+           n_queries});
+      if (team_size < 1)
+      {
+        // Scratch cannot hold even a single stack; fall back to the
+        // thread-local stack path
+        Kokkos::parallel_for(
+            "ArborX::TreeTraversal::nearest",
+            Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries), *this);
+        return;
+      }
+      int const num_teams = (n_queries + team_size - 1) / team_size;
       Kokkos::parallel_for(
-          "ArborX::TreeTraversal::nearest",
-          Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
+          "ArborX::TreeTraversal::nearest_scratch_stacks",
+          TeamPolicy(space, num_teams, team_size)
+              .set_scratch_size(0, Kokkos::PerThread(scratchPerThread())),
           *this);
     }
   }
 
+  template <typename TeamMember>
+  KOKKOS_FUNCTION void operator()(ScratchStack, TeamMember const &team) const
+  {
+    auto *stack = (int *)team.thread_scratch(0).get_shmem(scratchPerThread());
+    int const query_index =
+        team.league_rank() * team.team_size() + team.team_rank();
+    if (query_index >= (int)_predicates.size())
+      return;
+#if !defined(__CUDA_ARCH__)
+    dispatchNearestQuery(query_index, stack,
+                         (float *)(stack + stack_capacity));
+#else
+    dispatchNearestQuery(query_index, stack, nullptr);
+#endif
+  }
+
+  // Variant eliminating the per-thread traversal stack altogether with a
+  // restart trail (Laine 2010): a single 64-bit word records, for every
+  // level of the current path, whether the near or the far child was taken.
+  // When a subtree is exhausted, the traversal restarts from the root and
+  // replays the path the trail dictates, branching off to the far child at
+  // the deepest level whose far subtree is still pending. The near/far
+  // ordering only depends on the child distances, so the replay is
+  // deterministic and results are identical to the stack-based traversal;
+  // internal nodes on replayed paths are revisited, which is the price paid
+  // for keeping no stack state in local memory.
+  struct RestartTrail
+  {};
+
+  template <typename ExecutionSpace>
+  TreeTraversal(ExecutionSpace const &space, BVH const &bvh,
+                Predicates const &predicates, Callback const &callback,
+                RestartTrail)
+      : _bvh{bvh}
+      , _predicates{predicates}
+      , _callback{callback}
+  {
+    if (_bvh.empty())
+    {
+      // do nothing
+    }
+    else if (_bvh.size() == 1)
+    {
+      Kokkos::parallel_for(
+          "ArborX::TreeTraversal::nearest::degenerated_one_leaf_tree",
+          Kokkos::RangePolicy<ExecutionSpace, OneLeafTree>(space, 0,
+                                                           predicates.size()),
+          *this);
+    }
+    else
+    {
+      if constexpr (!has_static_k<typename Predicates::value_type>::value)
+        allocateBuffer(space);
+
+      launchTraversalKernel<RestartTrail>(
+          "ArborX::TreeTraversal::nearest_restart_trail", space,
+          predicates.size(), *this);
+    }
+  }
+
+  KOKKOS_FUNCTION void operator()(RestartTrail, int queryIndex) const
+  {
+    using Predicate = std::decay_t<decltype(_predicates(0))>;
+    using PairIndexDistance = Kokkos::pair<int, float>;
+    if constexpr (has_static_k<Predicate>::value)
+    {
+      // The candidate set is small and of compile-time size, keep it local
+      PairIndexDistance candidates[Predicate::static_k];
+      nearestQueryRestartTrail(queryIndex,
+                               UnmanagedStaticVector<PairIndexDistance>(
+                                   candidates, Predicate::static_k));
+    }
+    else
+    {
+      auto const buffer = _buffer(queryIndex);
+      nearestQueryRestartTrail(queryIndex,
+                               UnmanagedStaticVector<PairIndexDistance>(
+                                   buffer.data(), buffer.size()));
+    }
+  }
+
   struct OneLeafTree
   {};
 
@@ -216,26 +671,82 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
     _callback(predicate, HappyTreeFriends::getValue(_bvh, 0));
   }
 
+  // Latency instrumentation is a separate work tag so the common
+  // instantiation compiles without the clock reads and histogram checks
+  struct Timed
+  {};
+
   KOKKOS_FUNCTION void operator()(int queryIndex) const
+  {
+    int stack[stack_capacity];
+#if !defined(__CUDA_ARCH__)
+    float stack_distance[stack_capacity];
+    dispatchNearestQuery(queryIndex, stack, stack_distance);
+#else
+    dispatchNearestQuery(queryIndex, stack, nullptr);
+#endif
+  }
+
+  KOKKOS_FUNCTION void operator()(Timed, int queryIndex) const
+  {
+    auto const start = traversalClock();
+    operator()(queryIndex);
+    recordTraversalLatency(_latency_histogram, traversalClock() - start);
+  }
+
+  KOKKOS_FUNCTION void dispatchNearestQuery(int queryIndex, int *stack,
+                                            float *stack_distance) const
+  {
+    using Predicate = std::decay_t<decltype(_predicates(0))>;
+    if constexpr (has_static_k<Predicate>::value)
+    {
+      nearestQueryStaticK<Predicate::static_k>(queryIndex, stack,
+                                               stack_distance);
+    }
+    else
+    {
+      auto const buffer = _buffer(queryIndex);
+      nearestQuery(queryIndex, stack, stack_distance,
+                   UnmanagedStaticVector<Kokkos::pair<int, float>>(
+                       buffer.data(), buffer.size()));
+    }
+  }
+
+  template <typename Storage>
+  KOKKOS_FUNCTION void nearestQuery(int queryIndex, int *stack,
+                                    [[maybe_unused]] float *stack_distance,
+                                    Storage const &storage) const
   {
     auto const &predicate = _predicates(queryIndex);
     auto const k = getK(predicate);
-    auto const buffer = _buffer(queryIndex);
 
     // NOTE thinking about making this a precondition
     if (k < 1)
       return;
 
     // Nodes with a distance that exceed that radius can safely be
-    // discarded. Initialize the radius to infinity and tighten it once k
+    // discarded. Initialize the radius to the predicate's bound (infinity
+    // unless it carries one, see BoundedNearest) and tighten it once k
     // neighbors have been found.
-    auto radius = KokkosExt::ArithmeticTraits::infinity<float>::value;
+    //
+    // The traversal only ever compares distances, so it carries squared
+    // distances throughout (squaring preserves the ordering on [0, inf)
+    // and saves a square root on every node visit). The bound is squared
+    // accordingly; infinity squared is still infinity.
+    auto const bound = getBound(predicate);
+    auto radius = bound * bound;
+
+    // Approximate-mode knobs, no-ops for plain nearest predicates (see
+    // Experimental::ApproximateNearest): the slack multiplies squared
+    // distances in the subtree descend tests, the budget caps the number
+    // of nodes this query visits
+    auto const slack = getSlack(predicate);
+    int budget = getVisitBudget(predicate);
 
     using PairIndexDistance = Kokkos::pair<int, float>;
     static_assert(
-        std::is_same<typename decltype(buffer)::value_type,
-                     PairIndexDistance>::value,
-        "Type of the elements stored in the buffer passed as argument to "
+        std::is_same<typename Storage::value_type, PairIndexDistance>::value,
+        "Type of the elements stored in the storage passed as argument to "
         "TreeTraversal::nearestQuery is not right");
     struct CompareDistance
     {
@@ -247,28 +758,24 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
     };
     // Use a priority queue for convenience to store the results and
     // preserve the heap structure internally at all time.  There is no
-    // memory allocation, elements are stored in the buffer passed as an
+    // memory allocation, elements are stored in the storage passed as an
     // argument. The farthest leaf node is on top.
-    KOKKOS_ASSERT(k == (int)buffer.size());
-    PriorityQueue<PairIndexDistance, CompareDistance,
-                  UnmanagedStaticVector<PairIndexDistance>>
-        heap(UnmanagedStaticVector<PairIndexDistance>(buffer.data(),
-                                                      buffer.size()));
+    KOKKOS_ASSERT(k == (int)storage.capacity());
+    PriorityQueue<PairIndexDistance, CompareDistance, Storage> heap(storage);
 
     auto &bvh = _bvh;
     auto const distance = [&predicate, &bvh](int j) {
       return HappyTreeFriends::isLeaf(bvh, j)
-                 ? predicate.distance(HappyTreeFriends::getIndexable(bvh, j))
-                 : predicate.distance(
+                 ? predicate.distanceSquared(
+                       HappyTreeFriends::getIndexable(bvh, j))
+                 : predicate.distanceSquared(
                        HappyTreeFriends::getInternalBoundingVolume(bvh, j));
     };
 
     constexpr int SENTINEL = -1;
-    int stack[64];
     auto *stack_ptr = stack;
     *stack_ptr++ = SENTINEL;
 #if !defined(__CUDA_ARCH__)
-    float stack_distance[64];
     auto *stack_distance_ptr = stack_distance;
     *stack_distance_ptr++ = 0.f;
 #endif
@@ -286,7 +793,10 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
       bool traverse_left = false;
       bool traverse_right = false;
 
-      if (distance_node < radius)
+      if (--budget < 0)
+        break;
+
+      if (distance_node * slack < radius)
       {
         // Insert children into the stack and make sure that the
         // closest one ends on top.
@@ -308,7 +818,7 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
             if ((int)heap.size() == k)
               radius = heap.top().second;
           }
-          else
+          else if (distance_left * slack < radius)
           {
             traverse_left = true;
           }
@@ -327,7 +837,7 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
             if ((int)heap.size() == k)
               radius = heap.top().second;
           }
-          else
+          else if (distance_right * slack < radius)
           {
             traverse_right = true;
           }
@@ -377,6 +887,254 @@ struct TreeTraversal<BVH, Predicates, Callback, NearestPredicateTag>
                 HappyTreeFriends::getValue(_bvh, (heap.data() + i)->first));
     }
   }
+
+  // Compile-time-k variant: the k-best set lives in a small sorted array
+  // that the compiler keeps in registers, with the insertion fully
+  // unrollable, instead of heap operations over an indexed global buffer
+  template <int K>
+  KOKKOS_FUNCTION void
+  nearestQueryStaticK(int queryIndex, int *stack,
+                      [[maybe_unused]] float *stack_distance) const
+  {
+    auto const &predicate = _predicates(queryIndex);
+
+    // Squared distances throughout, same as nearestQuery()
+    auto const bound = getBound(predicate);
+    auto radius = bound * bound;
+    auto const slack = getSlack(predicate);
+    int budget = getVisitBudget(predicate);
+
+    using PairIndexDistance = Kokkos::pair<int, float>;
+    PairIndexDistance best[K];
+    int num_best = 0;
+
+    auto const insert = [&](PairIndexDistance const &pair) {
+      int pos;
+      if (num_best < K)
+        pos = num_best++;
+      else
+        pos = K - 1; // closer than the current k-th best, which is dropped
+      while (pos > 0 && best[pos - 1].second > pair.second)
+      {
+        best[pos] = best[pos - 1];
+        --pos;
+      }
+      best[pos] = pair;
+      if (num_best == K)
+        radius = best[K - 1].second;
+    };
+
+    auto &bvh = _bvh;
+    auto const distance = [&predicate, &bvh](int j) {
+      return HappyTreeFriends::isLeaf(bvh, j)
+                 ? predicate.distanceSquared(
+                       HappyTreeFriends::getIndexable(bvh, j))
+                 : predicate.distanceSquared(
+                       HappyTreeFriends::getInternalBoundingVolume(bvh, j));
+    };
+
+    constexpr int SENTINEL = -1;
+    auto *stack_ptr = stack;
+    *stack_ptr++ = SENTINEL;
+#if !defined(__CUDA_ARCH__)
+    auto *stack_distance_ptr = stack_distance;
+    *stack_distance_ptr++ = 0.f;
+#endif
+
+    int node = HappyTreeFriends::getRoot(_bvh);
+    int left_child;
+    int right_child;
+
+    float distance_left = 0.f;
+    float distance_right = 0.f;
+    float distance_node = 0.f;
+
+    do
+    {
+      bool traverse_left = false;
+      bool traverse_right = false;
+
+      if (--budget < 0)
+        break;
+
+      if (distance_node * slack < radius)
+      {
+        left_child = HappyTreeFriends::getLeftChild(_bvh, node);
+        right_child = HappyTreeFriends::getRightChild(_bvh, node);
+
+        distance_left = distance(left_child);
+        distance_right = distance(right_child);
+
+        if (distance_left < radius)
+        {
+          if (HappyTreeFriends::isLeaf(_bvh, left_child))
+            insert(Kokkos::make_pair(left_child, distance_left));
+          else if (distance_left * slack < radius)
+            traverse_left = true;
+        }
+
+        // Note: radius may have been already updated here from the left child
+        if (distance_right < radius)
+        {
+          if (HappyTreeFriends::isLeaf(_bvh, right_child))
+            insert(Kokkos::make_pair(right_child, distance_right));
+          else if (distance_right * slack < radius)
+            traverse_right = true;
+        }
+      }
+
+      if (!traverse_left && !traverse_right)
+      {
+        node = *--stack_ptr;
+#if defined(__CUDA_ARCH__)
+        if (node != SENTINEL)
+          distance_node = distance(node);
+#else
+        distance_node = *--stack_distance_ptr;
+#endif
+      }
+      else
+      {
+        node = (traverse_left &&
+                (distance_left <= distance_right || !traverse_right))
+                   ? left_child
+                   : right_child;
+        distance_node = (node == left_child ? distance_left : distance_right);
+        if (traverse_left && traverse_right)
+        {
+          *stack_ptr++ = (node == left_child ? right_child : left_child);
+#if !defined(__CUDA_ARCH__)
+          *stack_distance_ptr++ =
+              (node == left_child ? distance_right : distance_left);
+#endif
+        }
+      }
+    } while (node != SENTINEL);
+
+    // best[] is maintained sorted by distance, output directly
+    for (int i = 0; i < num_best; ++i)
+      _callback(predicate, HappyTreeFriends::getValue(_bvh, best[i].first));
+  }
+
+  template <typename Vector>
+  KOKKOS_FUNCTION void nearestQueryRestartTrail(int queryIndex,
+                                                Vector const &storage) const
+  {
+    auto const &predicate = _predicates(queryIndex);
+    auto const k = getK(predicate);
+
+    // NOTE thinking about making this a precondition
+    if (k < 1)
+      return;
+
+    // Squared distances throughout, same as nearestQuery()
+    auto const bound = getBound(predicate);
+    auto radius = bound * bound;
+    auto const slack = getSlack(predicate);
+    int budget = getVisitBudget(predicate);
+
+    using PairIndexDistance = Kokkos::pair<int, float>;
+    struct CompareDistance
+    {
+      KOKKOS_INLINE_FUNCTION bool operator()(PairIndexDistance const &lhs,
+                                             PairIndexDistance const &rhs) const
+      {
+        return lhs.second < rhs.second;
+      }
+    };
+    PriorityQueue<PairIndexDistance, CompareDistance, Vector> heap(storage);
+
+    auto &bvh = _bvh;
+    auto const distance = [&predicate, &bvh](int j) {
+      return HappyTreeFriends::isLeaf(bvh, j)
+                 ? predicate.distanceSquared(
+                       HappyTreeFriends::getIndexable(bvh, j))
+                 : predicate.distanceSquared(
+                       HappyTreeFriends::getInternalBoundingVolume(bvh, j));
+    };
+
+    // One trail bit per level below the root: zero when the path goes
+    // through the near child at that level, one when it goes through the
+    // far child. The expressible depth matches stack_capacity, the same
+    // implicit limit the stack-based traversal has.
+    constexpr unsigned long long root_level = 1ull << (stack_capacity - 1);
+    unsigned long long trail = 0;
+    unsigned long long level = root_level;
+
+    int node = HappyTreeFriends::getRoot(_bvh);
+    float distance_node = 0.f;
+
+    while (true)
+    {
+      if (--budget < 0)
+        break;
+
+      bool descend = false;
+      if (!HappyTreeFriends::isLeaf(_bvh, node))
+      {
+        if (distance_node * slack < radius)
+        {
+          int const left_child = HappyTreeFriends::getLeftChild(_bvh, node);
+          int const right_child = HappyTreeFriends::getRightChild(_bvh, node);
+          float const distance_left = distance(left_child);
+          float const distance_right = distance(right_child);
+
+          level >>= 1;
+          KOKKOS_ASSERT(level != 0);
+          bool const left_is_near = (distance_left <= distance_right);
+          if (left_is_near != (bool)(trail & level))
+          {
+            node = left_child;
+            distance_node = distance_left;
+          }
+          else
+          {
+            node = right_child;
+            distance_node = distance_right;
+          }
+          descend = true;
+        }
+      }
+      else if (distance_node < radius)
+      {
+        auto const leaf_pair = Kokkos::make_pair(node, distance_node);
+        if ((int)heap.size() < k)
+          heap.push(leaf_pair);
+        else
+          heap.popPush(leaf_pair);
+        if ((int)heap.size() == k)
+          radius = heap.top().second;
+      }
+
+      if (!descend)
+      {
+        // A replayed path may get cut short of its old branch point when
+        // the radius tightened in between; the trail bits recorded below
+        // the cut are then stale and are dropped together with the culled
+        // subtree they describe
+        trail &= ~(level - 1);
+        // Adding the level bit ripples a carry up to the deepest ancestor
+        // whose far subtree is still pending, flipping its trail bit and
+        // clearing the bits of all deeper levels; the replay below will
+        // branch off to the far child there with a fresh trail underneath
+        trail += level;
+        if (trail & root_level)
+          break; // the carry passed the root: every subtree is exhausted
+
+        node = HappyTreeFriends::getRoot(_bvh);
+        level = root_level;
+        distance_node = 0.f;
+      }
+    }
+
+    // Sort the leaf nodes and output the results, same as nearestQuery()
+    sortHeap(heap.data(), heap.data() + heap.size(), heap.valueComp());
+    for (decltype(heap.size()) i = 0; i < heap.size(); ++i)
+    {
+      _callback(predicate,
+                HappyTreeFriends::getValue(_bvh, (heap.data() + i)->first));
+    }
+  }
 };
 
 template <class BVH, class Predicates, class Callback>
@@ -409,11 +1167,9 @@ struct TreeTraversal<BVH, Predicates, Callback,
     }
     else
     {
-      Kokkos::parallel_for(
+      launchTraversalKernel<FullTree>(
           "ArborX::Experimental::TreeTraversal::OrderedSpatialPredicate",
-          Kokkos::RangePolicy<ExecutionSpace, FullTree>(space, 0,
-                                                        predicates.size()),
-          *this);
+          space, predicates.size(), *this);
     }
   }
 
@@ -487,15 +1243,34 @@ struct TreeTraversal<BVH, Predicates, Callback,
     int left_child;
     int right_child;
 
+    // Nodes at or beyond the culling distance cannot contribute. It starts
+    // at infinity and, for callbacks that return an updated hit distance
+    // (closest-hit queries), tightens as hits are reported, pruning
+    // everything behind the current closest hit.
+    auto cull = inf;
+
     while (true)
     {
       if (HappyTreeFriends::isLeaf(_bvh, node))
       {
-        if (invoke_callback_and_check_early_exit(
-                _callback, predicate, HappyTreeFriends::getValue(_bvh, node)))
+        using Value =
+            std::decay_t<decltype(HappyTreeFriends::getValue(_bvh, node))>;
+        if constexpr (std::is_arithmetic_v<std::invoke_result_t<
+                          Callback const &, Predicate const &, Value>>)
+        {
+          auto const t =
+              _callback(predicate, HappyTreeFriends::getValue(_bvh, node));
+          if ((distance_type)t < cull)
+            cull = t;
+        }
+        else if (invoke_callback_and_check_early_exit(
+                     _callback, predicate,
+                     HappyTreeFriends::getValue(_bvh, node)))
           return;
 
-        if (heap.empty())
+        // The heap top is the nearest remaining node; if it is culled, so
+        // is everything else
+        if (heap.empty() || heap.top().second >= cull)
           return;
 
         node = heap.top().first;
@@ -517,16 +1292,24 @@ struct TreeTraversal<BVH, Predicates, Callback,
         auto const &further_pair =
             distance_left < distance_right ? right_pair : left_pair;
 
+        if (closer_pair.second >= cull)
+        {
+          if (heap.empty() || heap.top().second >= cull)
+            return;
+          node = heap.top().first;
+          heap.pop();
+          continue;
+        }
+
         if (!heap.empty() && heap.top().second < closer_pair.second)
         {
           node = heap.top().first;
           heap.pop();
-          if (closer_pair.second < inf)
-            heap.push(closer_pair);
+          heap.push(closer_pair);
         }
         else
           node = closer_pair.first;
-        if (further_pair.second < inf)
+        if (further_pair.second < cull)
           heap.push(further_pair);
       }
     }
@@ -536,11 +1319,79 @@ struct TreeTraversal<BVH, Predicates, Callback,
 template <typename ExecutionSpace, typename BVH, typename Predicates,
           typename Callback>
 void traverse(ExecutionSpace const &space, BVH const &bvh,
-              Predicates const &predicates, Callback const &callback)
+              Predicates const &predicates, Callback const &callback,
+              unsigned long long *latency_histogram = nullptr)
+{
+  using Tag = typename Predicates::value_type::Tag;
+  if constexpr (std::is_same_v<Tag, SpatialPredicateTag> ||
+                std::is_same_v<Tag, NearestPredicateTag>)
+  {
+    TreeTraversal<BVH, Predicates, Callback, Tag>(space, bvh, predicates,
+                                                  callback,
+                                                  latency_histogram);
+  }
+  else
+  {
+    TreeTraversal<BVH, Predicates, Callback, Tag>(space, bvh, predicates,
+                                                  callback);
+  }
+}
+
+template <typename ExecutionSpace, typename BVH, typename Predicates,
+          typename Callback>
+void traverseWithKMajorBuffer(ExecutionSpace const &space, BVH const &bvh,
+                              Predicates const &predicates,
+                              Callback const &callback)
+{
+  using Tag = typename Predicates::value_type::Tag;
+  static_assert(std::is_same_v<Tag, NearestPredicateTag>,
+                "The k-major buffer is only available for nearest traversals");
+  using Traversal = TreeTraversal<BVH, Predicates, Callback, Tag>;
+  Traversal(space, bvh, predicates, callback,
+            typename Traversal::KMajorBuffer{});
+}
+
+template <typename ExecutionSpace, typename BVH, typename Predicates,
+          typename Callback>
+void traverseWithScratchStacks(ExecutionSpace const &space, BVH const &bvh,
+                               Predicates const &predicates,
+                               Callback const &callback)
+{
+  using Tag = typename Predicates::value_type::Tag;
+  static_assert(std::is_same_v<Tag, NearestPredicateTag>,
+                "Scratch stacks are only available for nearest traversals");
+  using Traversal = TreeTraversal<BVH, Predicates, Callback, Tag>;
+  Traversal(space, bvh, predicates, callback,
+            typename Traversal::ScratchStack{});
+}
+
+template <typename ExecutionSpace, typename BVH, typename Predicates,
+          typename Callback>
+void traverseWithScratchTree(ExecutionSpace const &space, BVH const &bvh,
+                             Predicates const &predicates,
+                             Callback const &callback)
+{
+  using Tag = typename Predicates::value_type::Tag;
+  static_assert(std::is_same_v<Tag, SpatialPredicateTag>,
+                "The scratch-resident tree is only available for spatial "
+                "traversals");
+  using Traversal = TreeTraversal<BVH, Predicates, Callback, Tag>;
+  Traversal(space, bvh, predicates, callback,
+            typename Traversal::ScratchTree{});
+}
+
+template <typename ExecutionSpace, typename BVH, typename Predicates,
+          typename Callback>
+void traverseWithRestartTrail(ExecutionSpace const &space, BVH const &bvh,
+                              Predicates const &predicates,
+                              Callback const &callback)
 {
   using Tag = typename Predicates::value_type::Tag;
-  TreeTraversal<BVH, Predicates, Callback, Tag>(space, bvh, predicates,
-                                                callback);
+  static_assert(std::is_same_v<Tag, NearestPredicateTag>,
+                "The restart trail is only available for nearest traversals");
+  using Traversal = TreeTraversal<BVH, Predicates, Callback, Tag>;
+  Traversal(space, bvh, predicates, callback,
+            typename Traversal::RestartTrail{});
 }
 
 } // namespace Details
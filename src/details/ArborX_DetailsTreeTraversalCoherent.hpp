@@ -0,0 +1,134 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_TREE_TRAVERSAL_COHERENT_HPP
+#define ARBORX_DETAILS_TREE_TRAVERSAL_COHERENT_HPP
+
+#include <ArborX_Callbacks.hpp>
+#include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_DetailsNode.hpp>
+#include <ArborX_Predicates.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+
+namespace ArborX::Details
+{
+
+// Cooperative spatial traversal for coherent predicate batches. After the
+// predicates are sorted along the space-filling curve, adjacent ones
+// traverse nearly identical node paths, yet the flat traversal loads every
+// node once per thread. Here a team shares a single traversal front for a
+// batch of consecutive predicates: an internal node is loaded once,
+// descended if any lane's predicate intersects it (team reduction), and
+// each lane applies only its own predicate at the leaves. The shared front
+// visits the union of the per-predicate paths, so this only pays off when
+// the batch is actually coherent — which is exactly what the predicate sort
+// provides for short-range queries.
+template <typename BVH, typename Predicates, typename Callback>
+struct CoherentTraversal
+{
+  BVH _bvh;
+  Predicates _predicates;
+  Callback _callback;
+  int _batch_size;
+
+  template <typename ExecutionSpace>
+  CoherentTraversal(ExecutionSpace const &space, BVH const &bvh,
+                    Predicates const &predicates, Callback const &callback,
+                    int batch_size)
+      : _bvh{bvh}
+      , _predicates{predicates}
+      , _callback{callback}
+      , _batch_size{batch_size}
+  {
+    int const n = predicates.size();
+
+    using TeamPolicy = Kokkos::TeamPolicy<ExecutionSpace>;
+    TeamPolicy dummy(space, 1, 1);
+    _batch_size = std::min(
+        _batch_size, dummy.team_size_max(*this, Kokkos::ParallelForTag{}));
+    int const num_teams = (n + _batch_size - 1) / _batch_size;
+    Kokkos::parallel_for("ArborX::TreeTraversal::spatial_coherent",
+                         TeamPolicy(space, num_teams, _batch_size), *this);
+  }
+
+  template <typename TeamMember>
+  KOKKOS_FUNCTION void operator()(TeamMember const &team) const
+  {
+    int const n = _predicates.size();
+    int const query_index =
+        team.league_rank() * _batch_size + team.team_rank();
+    bool active = (query_index < n);
+
+    int node = HappyTreeFriends::getRoot(_bvh);
+    do
+    {
+      if (HappyTreeFriends::isLeaf(_bvh, node))
+      {
+        if (active &&
+            _predicates(query_index)(
+                HappyTreeFriends::getIndexable(_bvh, node)) &&
+            invoke_callback_and_check_early_exit(
+                _callback, _predicates(query_index),
+                HappyTreeFriends::getValue(_bvh, node)))
+          active = false;
+        node = HappyTreeFriends::getRope(_bvh, node);
+      }
+      else
+      {
+        // One lane's hit descends the whole team; the reduction also
+        // doubles as the team barrier keeping the front uniform
+        int any_hit;
+        int const hit =
+            (active && _predicates(query_index)(
+                           HappyTreeFriends::getInternalBoundingVolume(
+                               _bvh, node)))
+                ? 1
+                : 0;
+        Kokkos::parallel_reduce(
+            Kokkos::TeamThreadRange(team, team.team_size()),
+            [&](int, int &update) { update += hit; }, any_hit);
+        node = (any_hit > 0 ? HappyTreeFriends::getLeftChild(_bvh, node)
+                            : HappyTreeFriends::getRope(_bvh, node));
+      }
+    } while (node != ROPE_SENTINEL);
+  }
+};
+
+template <typename ExecutionSpace, typename BVH, typename Predicates,
+          typename Callback>
+void traverseCoherently(ExecutionSpace const &space, BVH const &bvh,
+                        Predicates const &predicates, Callback const &callback,
+                        int batch_size = 32)
+{
+  if (bvh.empty() || predicates.size() == 0)
+    return;
+  if (bvh.size() == 1)
+  {
+    Kokkos::parallel_for(
+        "ArborX::TreeTraversal::spatial_coherent::degenerated_one_leaf_tree",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
+        KOKKOS_LAMBDA(int i) {
+          auto const &predicate = predicates(i);
+          if (predicate(HappyTreeFriends::getIndexable(bvh, 0)))
+            callback(predicate, HappyTreeFriends::getValue(bvh, 0));
+        });
+    return;
+  }
+  CoherentTraversal<BVH, Predicates, Callback>(space, bvh, predicates,
+                                               callback, batch_size);
+}
+
+} // namespace ArborX::Details
+
+#endif
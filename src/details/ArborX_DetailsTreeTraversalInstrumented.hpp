@@ -0,0 +1,387 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_DETAILS_TREE_TRAVERSAL_INSTRUMENTED_HPP
+#define ARBORX_DETAILS_TREE_TRAVERSAL_INSTRUMENTED_HPP
+
+#include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsNode.hpp> // ROPE_SENTINEL
+#include <ArborX_DetailsPriorityQueue.hpp>
+#include <ArborX_Predicates.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX
+{
+namespace Experimental
+{
+
+// Per-query traversal counters filled by queryInstrumented(). Tracking
+// traversal efficiency over time separates "the tree got worse" from "the
+// predicates got worse" without modifying the production query path, which
+// stays entirely free of counters.
+struct TraversalStatistics
+{
+  // Nodes whose bounding volume was tested against the predicate
+  int nodes_visited;
+  // Leaves whose indexable was tested against the predicate
+  int leaf_tests;
+  // High-water mark of the traversal stack (nearest queries only; the
+  // spatial traversal is stackless and reports zero)
+  int max_stack_depth;
+};
+
+} // namespace Experimental
+
+namespace Details
+{
+
+// Counterparts of the TreeTraversal kernels that additionally accumulate
+// per-query statistics. Kept separate so that the regular traversals do not
+// pay for the counters, not even a branch.
+template <typename BVH, typename Predicates, typename Callback,
+          typename StatsView, typename Tag>
+struct InstrumentedTreeTraversal
+{};
+
+template <typename BVH, typename Predicates, typename Callback,
+          typename StatsView>
+struct InstrumentedTreeTraversal<BVH, Predicates, Callback, StatsView,
+                                 SpatialPredicateTag>
+{
+  BVH _bvh;
+  Predicates _predicates;
+  Callback _callback;
+  StatsView _stats;
+
+  template <typename ExecutionSpace>
+  InstrumentedTreeTraversal(ExecutionSpace const &space, BVH const &bvh,
+                            Predicates const &predicates,
+                            Callback const &callback, StatsView const &stats)
+      : _bvh{bvh}
+      , _predicates{predicates}
+      , _callback{callback}
+      , _stats{stats}
+  {
+    Kokkos::parallel_for("ArborX::TreeTraversal::spatial_instrumented",
+                         Kokkos::RangePolicy<ExecutionSpace>(
+                             space, 0, predicates.size()),
+                         *this);
+  }
+
+  KOKKOS_FUNCTION void operator()(int queryIndex) const
+  {
+    auto const &predicate = _predicates(queryIndex);
+
+    Experimental::TraversalStatistics stats{0, 0, 0};
+
+    if (_bvh.size() == 1)
+    {
+      ++stats.nodes_visited;
+      ++stats.leaf_tests;
+      if (predicate(HappyTreeFriends::getIndexable(_bvh, 0)))
+        _callback(predicate, HappyTreeFriends::getValue(_bvh, 0));
+      _stats(queryIndex) = stats;
+      return;
+    }
+
+    int node = HappyTreeFriends::getRoot(_bvh);
+    do
+    {
+      ++stats.nodes_visited;
+      if (HappyTreeFriends::isLeaf(_bvh, node))
+      {
+        ++stats.leaf_tests;
+        if (predicate(HappyTreeFriends::getIndexable(_bvh, node)) &&
+            invoke_callback_and_check_early_exit(
+                _callback, predicate, HappyTreeFriends::getValue(_bvh, node)))
+          break;
+        node = HappyTreeFriends::getRope(_bvh, node);
+      }
+      else
+      {
+        node =
+            (predicate(HappyTreeFriends::getInternalBoundingVolume(_bvh, node))
+                 ? HappyTreeFriends::getLeftChild(_bvh, node)
+                 : HappyTreeFriends::getRope(_bvh, node));
+      }
+    } while (node != ROPE_SENTINEL);
+
+    _stats(queryIndex) = stats;
+  }
+};
+
+template <typename BVH, typename Predicates, typename Callback,
+          typename StatsView>
+struct InstrumentedTreeTraversal<BVH, Predicates, Callback, StatsView,
+                                 NearestPredicateTag>
+{
+  using MemorySpace = typename BVH::memory_space;
+
+  BVH _bvh;
+  Predicates _predicates;
+  Callback _callback;
+  StatsView _stats;
+
+  using Buffer = Kokkos::View<Kokkos::pair<int, float> *, MemorySpace>;
+  using Offset = Kokkos::View<int *, MemorySpace>;
+
+  Buffer _buffer;
+  Offset _offset;
+
+  static constexpr int stack_capacity = 64;
+
+  template <typename ExecutionSpace>
+  InstrumentedTreeTraversal(ExecutionSpace const &space, BVH const &bvh,
+                            Predicates const &predicates,
+                            Callback const &callback, StatsView const &stats)
+      : _bvh{bvh}
+      , _predicates{predicates}
+      , _callback{callback}
+      , _stats{stats}
+  {
+    auto const n_queries = predicates.size();
+
+    if (_bvh.size() > 1)
+    {
+      // Unlike the production nearest traversal, the instrumented one always
+      // keeps the candidate heap in a global buffer, even for
+      // compile-time-k predicates; this is a diagnostic path
+      _offset = Offset(Kokkos::view_alloc(
+                           space, Kokkos::WithoutInitializing,
+                           "ArborX::TreeTraversal::nearest::offset"),
+                       n_queries + 1);
+      Kokkos::parallel_for(
+          "ArborX::TreeTraversal::nearest::"
+          "scan_queries_for_numbers_of_neighbors",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+          KOKKOS_CLASS_LAMBDA(int i) { _offset(i) = getK(_predicates(i)); });
+      KokkosExt::exclusive_scan(space, _offset, _offset, 0);
+      int const buffer_size = KokkosExt::lastElement(space, _offset);
+      _buffer = Buffer(Kokkos::view_alloc(
+                           space, Kokkos::WithoutInitializing,
+                           "ArborX::TreeTraversal::nearest::buffer"),
+                       buffer_size);
+    }
+
+    Kokkos::parallel_for("ArborX::TreeTraversal::nearest_instrumented",
+                         Kokkos::RangePolicy<ExecutionSpace>(space, 0,
+                                                             n_queries),
+                         *this);
+  }
+
+  KOKKOS_FUNCTION void operator()(int queryIndex) const
+  {
+    auto const &predicate = _predicates(queryIndex);
+    auto const k = getK(predicate);
+
+    Experimental::TraversalStatistics stats{0, 0, 0};
+
+    if (k < 1)
+    {
+      _stats(queryIndex) = stats;
+      return;
+    }
+
+    if (_bvh.size() == 1)
+    {
+      ++stats.nodes_visited;
+      ++stats.leaf_tests;
+      _callback(predicate, HappyTreeFriends::getValue(_bvh, 0));
+      _stats(queryIndex) = stats;
+      return;
+    }
+
+    // Squared distances throughout, same as TreeTraversal::nearestQuery()
+    auto const bound = getBound(predicate);
+    auto radius = bound * bound;
+    auto const slack = getSlack(predicate);
+    int budget = getVisitBudget(predicate);
+
+    using PairIndexDistance = Kokkos::pair<int, float>;
+    struct CompareDistance
+    {
+      KOKKOS_INLINE_FUNCTION bool operator()(PairIndexDistance const &lhs,
+                                             PairIndexDistance const &rhs) const
+      {
+        return lhs.second < rhs.second;
+      }
+    };
+    auto const buffer = Kokkos::subview(
+        _buffer, Kokkos::make_pair(_offset(queryIndex), _offset(queryIndex + 1)));
+    PriorityQueue<PairIndexDistance, CompareDistance,
+                  UnmanagedStaticVector<PairIndexDistance>>
+        heap(UnmanagedStaticVector<PairIndexDistance>(buffer.data(),
+                                                      buffer.size()));
+
+    auto &bvh = _bvh;
+    auto const distance = [&predicate, &bvh, &stats](int j) {
+      ++stats.nodes_visited;
+      return HappyTreeFriends::isLeaf(bvh, j)
+                 ? predicate.distanceSquared(
+                       HappyTreeFriends::getIndexable(bvh, j))
+                 : predicate.distanceSquared(
+                       HappyTreeFriends::getInternalBoundingVolume(bvh, j));
+    };
+
+    constexpr int SENTINEL = -1;
+    int stack[stack_capacity];
+    float stack_distance[stack_capacity];
+    auto *stack_ptr = stack;
+    auto *stack_distance_ptr = stack_distance;
+    *stack_ptr++ = SENTINEL;
+    *stack_distance_ptr++ = 0.f;
+
+    int node = HappyTreeFriends::getRoot(_bvh);
+    int left_child;
+    int right_child;
+
+    float distance_left = 0.f;
+    float distance_right = 0.f;
+    float distance_node = 0.f;
+
+    do
+    {
+      bool traverse_left = false;
+      bool traverse_right = false;
+
+      if (--budget < 0)
+        break;
+
+      if (distance_node * slack < radius)
+      {
+        left_child = HappyTreeFriends::getLeftChild(_bvh, node);
+        right_child = HappyTreeFriends::getRightChild(_bvh, node);
+
+        distance_left = distance(left_child);
+        distance_right = distance(right_child);
+
+        if (distance_left < radius)
+        {
+          if (HappyTreeFriends::isLeaf(_bvh, left_child))
+          {
+            ++stats.leaf_tests;
+            auto leaf_pair = Kokkos::make_pair(left_child, distance_left);
+            if ((int)heap.size() < k)
+              heap.push(leaf_pair);
+            else
+              heap.popPush(leaf_pair);
+            if ((int)heap.size() == k)
+              radius = heap.top().second;
+          }
+          else if (distance_left * slack < radius)
+          {
+            traverse_left = true;
+          }
+        }
+
+        if (distance_right < radius)
+        {
+          if (HappyTreeFriends::isLeaf(_bvh, right_child))
+          {
+            ++stats.leaf_tests;
+            auto leaf_pair = Kokkos::make_pair(right_child, distance_right);
+            if ((int)heap.size() < k)
+              heap.push(leaf_pair);
+            else
+              heap.popPush(leaf_pair);
+            if ((int)heap.size() == k)
+              radius = heap.top().second;
+          }
+          else if (distance_right * slack < radius)
+          {
+            traverse_right = true;
+          }
+        }
+      }
+
+      if (!traverse_left && !traverse_right)
+      {
+        node = *--stack_ptr;
+        distance_node = *--stack_distance_ptr;
+      }
+      else
+      {
+        node = (traverse_left &&
+                (distance_left <= distance_right || !traverse_right))
+                   ? left_child
+                   : right_child;
+        distance_node = (node == left_child ? distance_left : distance_right);
+        if (traverse_left && traverse_right)
+        {
+          *stack_ptr++ = (node == left_child ? right_child : left_child);
+          *stack_distance_ptr++ =
+              (node == left_child ? distance_right : distance_left);
+          stats.max_stack_depth =
+              Kokkos::max(stats.max_stack_depth, (int)(stack_ptr - stack));
+        }
+      }
+    } while (node != SENTINEL);
+
+    sortHeap(heap.data(), heap.data() + heap.size(), heap.valueComp());
+    for (decltype(heap.size()) i = 0; i < heap.size(); ++i)
+    {
+      _callback(predicate,
+                HappyTreeFriends::getValue(_bvh, (heap.data() + i)->first));
+    }
+
+    _stats(queryIndex) = stats;
+  }
+};
+
+template <typename ExecutionSpace, typename BVH, typename Predicates,
+          typename Callback, typename StatsView>
+void traverseInstrumented(ExecutionSpace const &space, BVH const &bvh,
+                          Predicates const &predicates,
+                          Callback const &callback, StatsView const &stats)
+{
+  using Tag = typename Predicates::value_type::Tag;
+  if (bvh.empty())
+  {
+    Kokkos::deep_copy(space, stats, Experimental::TraversalStatistics{0, 0, 0});
+    return;
+  }
+  InstrumentedTreeTraversal<BVH, Predicates, Callback, StatsView, Tag>(
+      space, bvh, predicates, callback, stats);
+}
+
+} // namespace Details
+
+namespace Experimental
+{
+
+// Aggregate per-query statistics into scene totals (sums of nodes visited
+// and leaf tests, maximum stack depth), suitable for regression tracking
+template <typename ExecutionSpace, typename StatsView>
+TraversalStatistics reduceTraversalStatistics(ExecutionSpace const &space,
+                                              StatsView const &stats)
+{
+  int total_nodes = 0;
+  int total_leaf_tests = 0;
+  int max_depth = 0;
+  Kokkos::parallel_reduce(
+      "ArborX::TraversalStatistics::reduce",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, stats.extent(0)),
+      KOKKOS_LAMBDA(int i, int &nodes, int &leaf_tests, int &depth) {
+        nodes += stats(i).nodes_visited;
+        leaf_tests += stats(i).leaf_tests;
+        depth = Kokkos::max(depth, stats(i).max_stack_depth);
+      },
+      total_nodes, total_leaf_tests, Kokkos::Max<int>(max_depth));
+  return {total_nodes, total_leaf_tests, max_depth};
+}
+
+} // namespace Experimental
+} // namespace ArborX
+
+#endif
@@ -0,0 +1,148 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_TREE_TRAVERSAL_PACKET_HPP
+#define ARBORX_DETAILS_TREE_TRAVERSAL_PACKET_HPP
+
+#include <ArborX_Callbacks.hpp>
+#include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_DetailsKokkosExtMinMaxOperations.hpp>
+#include <ArborX_DetailsNode.hpp>
+#include <ArborX_Predicates.hpp>
+#include <ArborX_Ray.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+
+namespace ArborX::Details
+{
+
+template <typename Predicate>
+using PredicateRayArchetypeAlias =
+    std::decay_t<decltype(getGeometry(std::declval<Predicate>()))>;
+
+// A bundle of predicates can be bounded by a frustum only when the predicate
+// geometry is a ray
+template <typename Predicates>
+inline constexpr bool predicate_packets_are_rays_v = std::is_same_v<
+    Kokkos::detected_t<PredicateRayArchetypeAlias,
+                       typename Predicates::value_type>,
+    Experimental::Ray>;
+
+// Packet traversal for coherent ray bundles. A team owns a batch of
+// consecutive rays and bounds them once by a frustum (box of origins plus
+// per-component direction intervals). Internal nodes are then tested against
+// the frustum instead of against every ray: the conservative test never
+// culls a node some ray in the bundle hits, and because its outcome is the
+// same for every lane the node loop needs no reductions or barriers at all.
+// Per-ray refinement only happens at the leaves. As with the coherent
+// batched traversal, the shared front visits the union of the per-ray paths,
+// so this pays off only for near-parallel rays with nearby origins — sorting
+// the predicates groups such bundles together.
+template <typename BVH, typename Predicates, typename Callback>
+struct RayPacketTraversal
+{
+  BVH _bvh;
+  Predicates _predicates;
+  Callback _callback;
+  int _batch_size;
+
+  template <typename ExecutionSpace>
+  RayPacketTraversal(ExecutionSpace const &space, BVH const &bvh,
+                     Predicates const &predicates, Callback const &callback,
+                     int batch_size)
+      : _bvh{bvh}
+      , _predicates{predicates}
+      , _callback{callback}
+      , _batch_size{batch_size}
+  {
+    int const n = predicates.size();
+
+    using TeamPolicy = Kokkos::TeamPolicy<ExecutionSpace>;
+    TeamPolicy dummy(space, 1, 1);
+    _batch_size = std::min(
+        _batch_size, dummy.team_size_max(*this, Kokkos::ParallelForTag{}));
+    int const num_teams = (n + _batch_size - 1) / _batch_size;
+    Kokkos::parallel_for("ArborX::TreeTraversal::spatial_ray_packet",
+                         TeamPolicy(space, num_teams, _batch_size), *this);
+  }
+
+  template <typename TeamMember>
+  KOKKOS_FUNCTION void operator()(TeamMember const &team) const
+  {
+    int const n = _predicates.size();
+    int const first = team.league_rank() * _batch_size;
+    int const last = KokkosExt::min(first + _batch_size, n);
+    int const query_index = first + team.team_rank();
+    bool active = (query_index < n);
+
+    // Every lane bounds the whole bundle itself. The few redundant reads
+    // are paid once per traversal and buy a node loop that is entirely
+    // free of synchronization.
+    Experimental::RayFrustum frustum;
+    for (int i = first; i < last; ++i)
+      Experimental::expand(frustum, getGeometry(_predicates(i)));
+
+    int node = HappyTreeFriends::getRoot(_bvh);
+    do
+    {
+      if (HappyTreeFriends::isLeaf(_bvh, node))
+      {
+        if (active &&
+            _predicates(query_index)(
+                HappyTreeFriends::getIndexable(_bvh, node)) &&
+            invoke_callback_and_check_early_exit(
+                _callback, _predicates(query_index),
+                HappyTreeFriends::getValue(_bvh, node)))
+          active = false;
+        node = HappyTreeFriends::getRope(_bvh, node);
+      }
+      else
+      {
+        // one conservative test covers the whole bundle, and its outcome
+        // is uniform across the team
+        node = (intersects(frustum, HappyTreeFriends::getInternalBoundingVolume(
+                                        _bvh, node))
+                    ? HappyTreeFriends::getLeftChild(_bvh, node)
+                    : HappyTreeFriends::getRope(_bvh, node));
+      }
+    } while (node != ROPE_SENTINEL);
+  }
+};
+
+template <typename ExecutionSpace, typename BVH, typename Predicates,
+          typename Callback>
+void traverseRayPackets(ExecutionSpace const &space, BVH const &bvh,
+                        Predicates const &predicates, Callback const &callback,
+                        int batch_size = 32)
+{
+  if (bvh.empty() || predicates.size() == 0)
+    return;
+  if (bvh.size() == 1)
+  {
+    Kokkos::parallel_for(
+        "ArborX::TreeTraversal::spatial_ray_packet::degenerated_one_leaf_tree",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
+        KOKKOS_LAMBDA(int i) {
+          auto const &predicate = predicates(i);
+          if (predicate(HappyTreeFriends::getIndexable(bvh, 0)))
+            callback(predicate, HappyTreeFriends::getValue(bvh, 0));
+        });
+    return;
+  }
+  RayPacketTraversal<BVH, Predicates, Callback>(space, bvh, predicates,
+                                                callback, batch_size);
+}
+
+} // namespace ArborX::Details
+
+#endif
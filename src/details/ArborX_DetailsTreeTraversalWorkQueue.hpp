@@ -0,0 +1,188 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_TREE_TRAVERSAL_WORK_QUEUE_HPP
+#define ARBORX_DETAILS_TREE_TRAVERSAL_WORK_QUEUE_HPP
+
+#include <ArborX_Callbacks.hpp>
+#include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_DetailsNode.hpp>
+#include <ArborX_Predicates.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+
+namespace ArborX::Details
+{
+
+// Persistent-threads alternative to the flat one-predicate-per-thread
+// spatial traversal. A fixed set of workers pulls work items (predicate,
+// resume node) from a global MPMC ring buffer; a traversal that exceeds a
+// node budget is suspended — the rope traversal's entire state is the
+// current node — and re-enqueued at the back of the queue. This bounds how
+// long any single predicate can monopolize a worker, which evens out
+// workloads where per-predicate costs vary by orders of magnitude.
+//
+// The ring uses ticket-sequenced slots (a slot is free when its sequence is
+// zero, full when it holds ticket+1). Since every pop pushes at most one
+// continuation, at most one item per predicate is live and a capacity equal
+// to the number of predicates can never overflow. The spin waits assume
+// independent thread progress, which all current device backends provide.
+template <typename BVH, typename Predicates, typename Callback>
+struct WorkQueueTraversal
+{
+  using MemorySpace = typename BVH::memory_space;
+
+  BVH _bvh;
+  Predicates _predicates;
+  Callback _callback;
+
+  Kokkos::View<Kokkos::pair<int, int> *, MemorySpace> _items;
+  Kokkos::View<int *, MemorySpace> _sequence;
+  Kokkos::View<int, MemorySpace> _head;
+  Kokkos::View<int, MemorySpace> _tail;
+  Kokkos::View<int, MemorySpace> _num_done;
+  int _capacity;
+
+  // Number of nodes a worker visits before a traversal is re-enqueued
+  static constexpr int slice_budget = 512;
+
+  template <typename ExecutionSpace>
+  WorkQueueTraversal(ExecutionSpace const &space, BVH const &bvh,
+                     Predicates const &predicates, Callback const &callback)
+      : _bvh{bvh}
+      , _predicates{predicates}
+      , _callback{callback}
+      , _items(Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                                  "ArborX::TreeTraversal::work_queue::items"),
+               predicates.size())
+      , _sequence(
+            Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                               "ArborX::TreeTraversal::work_queue::sequence"),
+            predicates.size())
+      , _head("ArborX::TreeTraversal::work_queue::head")
+      , _tail("ArborX::TreeTraversal::work_queue::tail")
+      , _num_done("ArborX::TreeTraversal::work_queue::num_done")
+      , _capacity((int)predicates.size())
+  {
+    int const n = _capacity;
+
+    Kokkos::parallel_for(
+        "ArborX::TreeTraversal::work_queue::seed",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+          _items(i) = {i, HappyTreeFriends::getRoot(_bvh)};
+          _sequence(i) = i + 1;
+        });
+    Kokkos::deep_copy(space, _tail, n);
+
+    int const num_workers = (int)std::min<long>(n, space.concurrency());
+    Kokkos::parallel_for("ArborX::TreeTraversal::work_queue",
+                         Kokkos::RangePolicy<ExecutionSpace>(space, 0,
+                                                             num_workers),
+                         *this);
+  }
+
+  KOKKOS_FUNCTION void push(int predicate_index, int node) const
+  {
+    int const ticket = Kokkos::atomic_fetch_add(&_tail(), 1);
+    int const slot = ticket % _capacity;
+    while (Kokkos::atomic_load(&_sequence(slot)) != 0)
+      ;
+    _items(slot) = {predicate_index, node};
+    Kokkos::memory_fence();
+    Kokkos::atomic_store(&_sequence(slot), ticket + 1);
+  }
+
+  KOKKOS_FUNCTION void operator()(int) const
+  {
+    int const n = _capacity;
+    while (true)
+    {
+      int const ticket = Kokkos::atomic_load(&_head());
+      if (ticket >= Kokkos::atomic_load(&_tail()))
+      {
+        if (Kokkos::atomic_load(&_num_done()) == n)
+          break;
+        continue;
+      }
+      if (Kokkos::atomic_compare_exchange(&_head(), ticket, ticket + 1) !=
+          ticket)
+        continue;
+      int const slot = ticket % _capacity;
+      while (Kokkos::atomic_load(&_sequence(slot)) != ticket + 1)
+        ;
+      Kokkos::memory_fence();
+      auto const item = _items(slot);
+      Kokkos::atomic_store(&_sequence(slot), 0);
+
+      auto const &predicate = _predicates(item.first);
+      int node = item.second;
+      int budget = slice_budget;
+      do
+      {
+        if (HappyTreeFriends::isLeaf(_bvh, node))
+        {
+          if (predicate(HappyTreeFriends::getIndexable(_bvh, node)) &&
+              invoke_callback_and_check_early_exit(
+                  _callback, predicate,
+                  HappyTreeFriends::getValue(_bvh, node)))
+            break;
+          node = HappyTreeFriends::getRope(_bvh, node);
+        }
+        else
+        {
+          node = (predicate(
+                      HappyTreeFriends::getInternalBoundingVolume(_bvh, node))
+                      ? HappyTreeFriends::getLeftChild(_bvh, node)
+                      : HappyTreeFriends::getRope(_bvh, node));
+        }
+        if (--budget == 0 && node != ROPE_SENTINEL)
+        {
+          push(item.first, node);
+          node = ROPE_SENTINEL;
+          budget = -1; // suspended, not finished
+        }
+      } while (node != ROPE_SENTINEL);
+      if (budget >= 0)
+        Kokkos::atomic_fetch_add(&_num_done(), 1);
+    }
+  }
+};
+
+template <typename ExecutionSpace, typename BVH, typename Predicates,
+          typename Callback>
+void traverseWithWorkQueue(ExecutionSpace const &space, BVH const &bvh,
+                           Predicates const &predicates,
+                           Callback const &callback)
+{
+  if (bvh.empty() || predicates.size() == 0)
+    return;
+  if (bvh.size() == 1)
+  {
+    // Degenerate one-leaf tree; nothing to schedule
+    Kokkos::parallel_for(
+        "ArborX::TreeTraversal::work_queue::degenerated_one_leaf_tree",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, predicates.size()),
+        KOKKOS_LAMBDA(int i) {
+          auto const &predicate = predicates(i);
+          if (predicate(Details::HappyTreeFriends::getIndexable(bvh, 0)))
+            callback(predicate, Details::HappyTreeFriends::getValue(bvh, 0));
+        });
+    return;
+  }
+  WorkQueueTraversal<BVH, Predicates, Callback>(space, bvh, predicates,
+                                                callback);
+}
+
+} // namespace ArborX::Details
+
+#endif
@@ -179,6 +179,125 @@ struct UnionFind
   }
 };
 
+// Policies for ScatteredUnionFind below, bundling the two knobs that matter
+// under contention: which of two representatives survives a merge
+// ("promotion"), and how far apart consecutive entries are laid out in
+// memory.
+
+// Same choices UnionFind makes implicitly: the smaller id survives, and the
+// labels are stored densely. Mostly useful as a baseline when benchmarking.
+struct UnionFindCompactPolicy
+{
+  static constexpr int stride = 1;
+
+  KOKKOS_FUNCTION static bool wins(int i, int j) { return i < j; }
+};
+
+// Promote by a hash of the representative id, and give every entry its own
+// cache line. Linking by smallest id funnels every merge of an elongated
+// component through the same few low-id roots, so the CAS retries (and the
+// cache line ping-pong between them, as low ids are also adjacent in memory)
+// serialize; hashing spreads the surviving roots uniformly over the id range
+// and the padding puts them on distinct lines.
+struct UnionFindScatterPolicy
+{
+  static constexpr int stride = 16; // one 64-byte cache line per entry
+
+  KOKKOS_FUNCTION static bool wins(int i, int j)
+  {
+    // murmur3 finalizer
+    auto mix = [](unsigned x) {
+      x ^= x >> 16;
+      x *= 0x85ebca6bu;
+      x ^= x >> 13;
+      x *= 0xc2b2ae35u;
+      x ^= x >> 16;
+      return x;
+    };
+    auto const hash_i = mix(i);
+    auto const hash_j = mix(j);
+    // Tie-break by id to keep the order strict (no merge cycles)
+    return hash_i < hash_j || (hash_i == hash_j && i < j);
+  }
+};
+
+// Union-find variant for inputs where UnionFind's min-id linking degrades
+// (e.g., merging many edges of one elongated component in parallel, see
+// benchmarks/union_find). It owns its (possibly padded) storage, so unlike
+// UnionFind it is constructed from a size rather than a labels view, and the
+// final labels are read back through representative().
+//
+// Because the promotion order is no longer aligned with the id order, the
+// monotone ECL find loop does not apply; representative() uses classic path
+// halving instead, whose data races are benign for the same reasons as in
+// UnionFind.
+template <typename MemorySpace, typename Policy = UnionFindScatterPolicy>
+struct ScatteredUnionFind
+{
+  using memory_space = MemorySpace;
+
+  Kokkos::View<int *, MemorySpace> _labels; // entry i lives at i * stride
+
+  template <typename ExecutionSpace>
+  ScatteredUnionFind(ExecutionSpace const &exec_space, int n)
+      : _labels(Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                                   "ArborX::ScatteredUnionFind::labels"),
+                (size_t)n * Policy::stride)
+  {
+    auto labels = _labels;
+    Kokkos::parallel_for(
+        "ArborX::ScatteredUnionFind::init",
+        Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+        KOKKOS_LAMBDA(int const i) { labels(i * Policy::stride) = i; });
+  }
+
+  KOKKOS_FUNCTION
+  auto size() const { return _labels.size() / Policy::stride; }
+
+  KOKKOS_FUNCTION
+  int representative(int const i) const
+  {
+    int curr = i;
+    int next = _labels(curr * Policy::stride);
+    while (next != curr)
+    {
+      int grand = _labels(next * Policy::stride);
+      if (grand != next)
+        _labels(curr * Policy::stride) = grand; // halve the path
+      curr = next;
+      next = grand;
+    }
+    return curr;
+  }
+
+  KOKKOS_FUNCTION
+  void merge_into(int i, int j) const
+  {
+    _labels(i * Policy::stride) = representative(j);
+  }
+
+  KOKKOS_FUNCTION
+  void merge(int i, int j) const
+  {
+    int vstat = representative(i);
+    int ostat = representative(j);
+
+    // Same retry loop as in UnionFind, with the link direction decided by the
+    // policy instead of the id order. A failed exchange returns the current
+    // label, which walks the loser one step closer to its (possibly updated)
+    // representative.
+    while (vstat != ostat)
+    {
+      if (Policy::wins(vstat, ostat))
+        ostat = Kokkos::atomic_compare_exchange(
+            &_labels(ostat * Policy::stride), ostat, vstat);
+      else
+        vstat = Kokkos::atomic_compare_exchange(
+            &_labels(vstat * Policy::stride), vstat, ostat);
+    }
+  }
+};
+
 } // namespace ArborX::Details
 
 #endif
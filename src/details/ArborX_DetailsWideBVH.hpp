@@ -0,0 +1,383 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_WIDE_BVH_HPP
+#define ARBORX_DETAILS_WIDE_BVH_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_Callbacks.hpp>
+#include <ArborX_DetailsAlgorithms.hpp> // expand
+#include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsNode.hpp>
+#include <ArborX_DetailsStack.hpp>
+#include <ArborX_Exception.hpp>
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_Ray.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <climits> // INT_MIN
+
+namespace ArborX::Details
+{
+
+// Internal node of an N-ary tree. Children store the bounding volumes of
+// their subtrees in the parent so that a single traversal step tests all of
+// them from one (wide) cache line. A negative child index -(i + 1) denotes
+// the leaf with index i in the original binary tree; CHILD_SENTINEL marks an
+// unused slot.
+template <class BoundingVolume, int Arity>
+struct WideInternalNode
+{
+  static_assert(Arity == 4 || Arity == 8);
+
+  using bounding_volume_type = BoundingVolume;
+
+  static constexpr int CHILD_SENTINEL = INT_MIN;
+
+  int children[Arity];
+  BoundingVolume bounding_volumes[Arity];
+};
+
+// Collapse the binary tree held by a BoundingVolumeHierarchy into an array of
+// Arity-wide nodes. A wide node is formed by replacing every binary internal
+// node with its log2(Arity)-th generation descendants (or leaves encountered
+// on the way down). The number of wide internal nodes never exceeds the
+// number of binary internal nodes, which is used to bound the allocation
+// before compacting.
+template <class ExecutionSpace, class BVH, class WideNodes>
+void collapseToWideNodes(ExecutionSpace const &space, BVH const &bvh,
+                         WideNodes &wide_nodes)
+{
+  using MemorySpace = typename BVH::memory_space;
+  using WideNode = typename WideNodes::value_type;
+  constexpr int arity = sizeof(WideNode::children) / sizeof(int);
+
+  int const n = bvh.size();
+  ARBORX_ASSERT(n > 1);
+
+  KokkosExt::reallocWithoutInitializing(space, wide_nodes, n - 1);
+
+  // Frontier of (binary node, wide slot) pairs, processed in rounds. Each
+  // round replaces every frontier node with the binary descendants forming
+  // its wide children and enqueues the internal ones.
+  Kokkos::View<int *, MemorySpace> frontier(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::WideBVH::collapse::frontier"),
+      n - 1);
+  Kokkos::View<int *, MemorySpace> next_frontier(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::WideBVH::collapse::next_frontier"),
+      n - 1);
+  Kokkos::View<int, MemorySpace> counters(
+      "ArborX::WideBVH::collapse::counters");
+
+  Kokkos::parallel_for(
+      "ArborX::WideBVH::collapse::init_root",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, 1), KOKKOS_LAMBDA(int) {
+        frontier(0) = HappyTreeFriends::getRoot(bvh);
+      });
+
+  int frontier_size = 1;
+  int num_wide_nodes = 1;
+  while (frontier_size > 0)
+  {
+    Kokkos::deep_copy(space, counters, 0);
+    Kokkos::parallel_for(
+        "ArborX::WideBVH::collapse::process_frontier",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, frontier_size),
+        KOKKOS_LAMBDA(int f) {
+          int const node = frontier(f);
+          int const slot = HappyTreeFriends::internalIndex(bvh, node);
+
+          // Gather up to arity descendants by splitting internal candidates
+          // breadth-first until the target width (or all leaves) is reached.
+          int candidates[arity];
+          int num_candidates = 1;
+          candidates[0] = node;
+          for (int level = 1; level < arity; level *= 2)
+          {
+            int expanded[arity];
+            int num_expanded = 0;
+            for (int c = 0; c < num_candidates; ++c)
+            {
+              int const candidate = candidates[c];
+              if (HappyTreeFriends::isLeaf(bvh, candidate))
+              {
+                expanded[num_expanded++] = candidate;
+              }
+              else
+              {
+                expanded[num_expanded++] =
+                    HappyTreeFriends::getLeftChild(bvh, candidate);
+                expanded[num_expanded++] =
+                    HappyTreeFriends::getRightChild(bvh, candidate);
+              }
+            }
+            for (int c = 0; c < num_expanded; ++c)
+              candidates[c] = expanded[c];
+            num_candidates = num_expanded;
+          }
+
+          auto &wide_node = wide_nodes(slot);
+          for (int c = 0; c < arity; ++c)
+          {
+            if (c >= num_candidates)
+            {
+              wide_node.children[c] = WideNode::CHILD_SENTINEL;
+              continue;
+            }
+            int const child = candidates[c];
+            if (HappyTreeFriends::isLeaf(bvh, child))
+            {
+              wide_node.children[c] = -(child + 1);
+              typename WideNode::bounding_volume_type bounding_volume{};
+              expand(bounding_volume,
+                     HappyTreeFriends::getIndexable(bvh, child));
+              wide_node.bounding_volumes[c] = bounding_volume;
+            }
+            else
+            {
+              wide_node.children[c] =
+                  HappyTreeFriends::internalIndex(bvh, child);
+              wide_node.bounding_volumes[c] =
+                  HappyTreeFriends::getInternalBoundingVolume(bvh, child);
+              next_frontier(Kokkos::atomic_fetch_add(&counters(), 1)) = child;
+            }
+          }
+        });
+    auto counters_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace{}, counters);
+    frontier_size = counters_host();
+    num_wide_nodes += frontier_size;
+    std::swap(frontier, next_frontier);
+  }
+  (void)num_wide_nodes; // slots of skipped binary nodes are left unused
+}
+
+// Branch-free batched box tests for an entire wide node. The per-child
+// corners are transposed into structure-of-arrays stack buffers and the hit
+// mask is computed with flat arithmetic loops over children and dimensions,
+// which host compilers turn into 4/8-lane vector compares — the generic
+// per-child intersects() path branches on every test and defeats
+// vectorization. Device backends compile the same code; the form is
+// harmless there. Unused (sentinel) child slots produce garbage lanes whose
+// results are never consumed.
+template <class Geometry, class BoundingVolume, int Arity>
+KOKKOS_FUNCTION void
+testWideChildren(Geometry const &geometry,
+                 WideInternalNode<BoundingVolume, Arity> const &node,
+                 bool (&hits)[Arity])
+{
+  constexpr int DIM = GeometryTraits::dimension_v<BoundingVolume>;
+  using Coordinate =
+      typename GeometryTraits::coordinate_type<BoundingVolume>::type;
+
+  Coordinate mins[DIM][Arity];
+  Coordinate maxs[DIM][Arity];
+  for (int c = 0; c < Arity; ++c)
+    for (int d = 0; d < DIM; ++d)
+    {
+      mins[d][c] = node.bounding_volumes[c].minCorner()[d];
+      maxs[d][c] = node.bounding_volumes[c].maxCorner()[d];
+    }
+
+  if constexpr (GeometryTraits::is_box<Geometry>{})
+  {
+    for (int c = 0; c < Arity; ++c)
+      hits[c] = true;
+    for (int d = 0; d < DIM; ++d)
+      for (int c = 0; c < Arity; ++c)
+        hits[c] = hits[c] & (geometry.minCorner()[d] <= maxs[d][c]) &
+                  (geometry.maxCorner()[d] >= mins[d][c]);
+  }
+  else if constexpr (GeometryTraits::is_point<Geometry>{})
+  {
+    for (int c = 0; c < Arity; ++c)
+      hits[c] = true;
+    for (int d = 0; d < DIM; ++d)
+      for (int c = 0; c < Arity; ++c)
+        hits[c] = hits[c] & (geometry[d] <= maxs[d][c]) &
+                  (geometry[d] >= mins[d][c]);
+  }
+  else if constexpr (std::is_same_v<Geometry, Experimental::Ray>)
+  {
+    // slab tests against all children at once, with the same zero-numerator
+    // NaN guard as the scalar branch-free intersects(Ray, Box)
+    constexpr auto inf =
+        KokkosExt::ArithmeticTraits::infinity<Coordinate>::value;
+    Coordinate tmin[Arity];
+    Coordinate tmax[Arity];
+    for (int c = 0; c < Arity; ++c)
+    {
+      tmin[c] = 0;
+      tmax[c] = inf;
+    }
+    for (int d = 0; d < DIM; ++d)
+    {
+      auto const orig = geometry.origin()[d];
+      auto const inv_dir = 1 / geometry.direction()[d];
+      for (int c = 0; c < Arity; ++c)
+      {
+        auto const num0 = mins[d][c] - orig;
+        auto const num1 = maxs[d][c] - orig;
+        auto const t0 = num0 == 0 ? 0 : num0 * inv_dir;
+        auto const t1 = num1 == 0 ? 0 : num1 * inv_dir;
+        tmin[c] = Kokkos::max(tmin[c], Kokkos::min(t0, t1));
+        tmax[c] = Kokkos::min(tmax[c], Kokkos::max(t0, t1));
+      }
+    }
+    for (int c = 0; c < Arity; ++c)
+      hits[c] = (tmin[c] <= tmax[c]);
+  }
+  else
+  {
+    static_assert(GeometryTraits::is_sphere<Geometry>{},
+                  "Unsupported geometry for the batched child test");
+    Coordinate cdist[Arity] = {};
+    for (int d = 0; d < DIM; ++d)
+      for (int c = 0; c < Arity; ++c)
+      {
+        auto const projected =
+            Kokkos::min(Kokkos::max(geometry.centroid()[d], mins[d][c]),
+                        maxs[d][c]);
+        auto const diff = geometry.centroid()[d] - projected;
+        cdist[c] += diff * diff;
+      }
+    for (int c = 0; c < Arity; ++c)
+      hits[c] = (cdist[c] <= geometry.radius() * geometry.radius());
+  }
+}
+
+template <class BVH, int Arity>
+struct WideTraversal
+{
+  using MemorySpace = typename BVH::memory_space;
+  using BoundingVolume = typename BVH::bounding_volume_type;
+  using WideNode = WideInternalNode<BoundingVolume, Arity>;
+
+  BVH _bvh;
+  Kokkos::View<WideNode *, MemorySpace> _wide_nodes;
+
+  template <class Predicate, class Callback>
+  KOKKOS_FUNCTION void operator()(Predicate const &predicate,
+                                  Callback const &callback) const
+  {
+    // Root of the binary tree collapses into wide slot 0
+    Stack<int> stack;
+    stack.emplace(0);
+    while (!stack.empty())
+    {
+      auto const &node = _wide_nodes(stack.top());
+      stack.pop();
+
+      bool hits[Arity];
+      using Geometry = std::decay_t<decltype(getGeometry(predicate))>;
+      if constexpr (GeometryTraits::is_box<Geometry>{} ||
+                    GeometryTraits::is_point<Geometry>{} ||
+                    GeometryTraits::is_sphere<Geometry>{} ||
+                    std::is_same_v<Geometry, Experimental::Ray>)
+      {
+        testWideChildren(getGeometry(predicate), node, hits);
+      }
+      else
+      {
+        for (int c = 0; c < Arity; ++c)
+          hits[c] = (node.children[c] != WideNode::CHILD_SENTINEL) &&
+                    predicate(node.bounding_volumes[c]);
+      }
+
+      for (int c = 0; c < Arity; ++c)
+      {
+        int const child = node.children[c];
+        if (child == WideNode::CHILD_SENTINEL)
+          break;
+        if (!hits[c])
+          continue;
+        if (child < 0)
+        {
+          if (invoke_callback_and_check_early_exit(
+                  callback, predicate,
+                  HappyTreeFriends::getValue(_bvh, -child - 1)))
+            return;
+        }
+        else
+        {
+          stack.emplace(child);
+        }
+      }
+    }
+  }
+};
+
+} // namespace ArborX::Details
+
+namespace ArborX::Experimental
+{
+
+// Read-only N-ary (4- or 8-wide) view of an existing BoundingVolumeHierarchy
+// for spatial queries. The wide layout trades one extra node array for a tree
+// of roughly half the depth, which pays off for latency-bound traversals of
+// large trees. The source tree must be kept alive as leaf values are shared
+// with it.
+template <class BVH, int Arity = 4>
+class WideBVH
+{
+public:
+  using memory_space = typename BVH::memory_space;
+  using bounding_volume_type = typename BVH::bounding_volume_type;
+  using value_type = typename BVH::value_type;
+  using size_type = typename BVH::size_type;
+
+  template <class ExecutionSpace>
+  WideBVH(ExecutionSpace const &space, BVH const &bvh)
+      : _bvh(bvh)
+  {
+    ARBORX_ASSERT(bvh.size() > 1);
+    Details::collapseToWideNodes(space, bvh, _wide_nodes);
+  }
+
+  KOKKOS_FUNCTION size_type size() const noexcept { return _bvh.size(); }
+
+  template <class ExecutionSpace, class Predicates, class Callback>
+  void query(ExecutionSpace const &space, Predicates const &predicates,
+             Callback const &callback) const
+  {
+    Details::check_valid_access_traits(PredicatesTag{}, predicates);
+
+    using AccessValues =
+        Details::AccessValues<Predicates, PredicatesTag>;
+    AccessValues access_values{predicates};
+
+    static_assert(
+        std::is_same_v<typename AccessValues::value_type::Tag,
+                       Details::SpatialPredicateTag>,
+        "WideBVH only supports spatial predicates");
+
+    Details::WideTraversal<BVH, Arity> traversal{_bvh, _wide_nodes};
+    Kokkos::parallel_for(
+        "ArborX::WideBVH::query::spatial",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, access_values.size()),
+        KOKKOS_LAMBDA(int i) { traversal(access_values(i), callback); });
+  }
+
+private:
+  BVH _bvh;
+  Kokkos::View<Details::WideInternalNode<bounding_volume_type, Arity> *,
+               memory_space>
+      _wide_nodes;
+};
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -0,0 +1,177 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_FOREST_HPP
+#define ARBORX_FOREST_HPP
+
+#include <ArborX_Box.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_LinearBVH.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Collection of trees sharing one value type that answers a query across
+// all of them at once. A small top tree indexes the root boxes of the
+// member trees; a single kernel traverses it per predicate and descends
+// into every member tree whose bounds the predicate reaches. Compared to
+// querying the trees one by one this pays one kernel launch instead of
+// one per tree and reads each predicate once instead of once per tree.
+//
+// The user callback is invoked as callback(predicate, tree_index, value)
+// with the value stored in the member tree.
+template <class Tree>
+class Forest
+{
+public:
+  using memory_space = typename Tree::memory_space;
+  using value_type = typename Tree::value_type;
+
+  // The trees view must be accessible from the host during construction:
+  // the root boxes for the top tree are gathered from the member trees'
+  // bounds on the host.
+  template <class ExecutionSpace>
+  Forest(ExecutionSpace const &space,
+         Kokkos::View<Tree *, memory_space> trees)
+      : _trees(trees)
+  {
+    int const num_trees = trees.extent_int(0);
+
+    auto trees_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, trees);
+
+    Kokkos::View<Box *, Kokkos::HostSpace> root_boxes_host(
+        Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                           "ArborX::Forest::root_boxes"),
+        num_trees);
+    for (int i = 0; i < num_trees; ++i)
+    {
+      Box bounds;
+      ArborX::Details::expand(bounds, trees_host(i).bounds());
+      root_boxes_host(i) = bounds;
+    }
+    auto root_boxes =
+        Kokkos::create_mirror_view_and_copy(memory_space{}, root_boxes_host);
+
+    _top_tree = BoundingVolumeHierarchy<memory_space>(space, root_boxes);
+  }
+
+  template <class ExecutionSpace, class Predicates, class Callback>
+  void query(ExecutionSpace const &space, Predicates const &predicates,
+             Callback const &callback) const
+  {
+    ArborX::Details::check_valid_access_traits(PredicatesTag{}, predicates);
+
+    using AccessValues =
+        ArborX::Details::AccessValues<Predicates, PredicatesTag>;
+    AccessValues access_values{predicates};
+
+    static_assert(std::is_same_v<typename AccessValues::value_type::Tag,
+                                 ArborX::Details::SpatialPredicateTag>,
+                  "Forest only supports spatial predicates");
+
+    auto const top_tree = _top_tree;
+    auto const trees = _trees;
+    Kokkos::parallel_for(
+        "ArborX::Forest::query",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, access_values.size()),
+        KOKKOS_LAMBDA(int i) {
+          auto const &predicate = access_values(i);
+          top_tree.query(
+              PerThread{}, predicate,
+              [&](auto const &, auto const &top_value) {
+                trees(top_value.index)
+                    .query(PerThread{}, predicate,
+                           [&](auto const &, value_type const &value) {
+                             callback(predicate, top_value.index, value);
+                           });
+              });
+        });
+  }
+
+  // CSR query: values matching predicate i from all member trees land in
+  // values(offset(i)) .. values(offset(i+1)). One count kernel sizes the
+  // output exactly and one fill kernel writes it; a thread owns all the
+  // results of its predicate, so no atomics are involved.
+  template <class ExecutionSpace, class Predicates, class OutputView,
+            class OffsetView>
+  void query(ExecutionSpace const &space, Predicates const &predicates,
+             OutputView &values, OffsetView &offset) const
+  {
+    ArborX::Details::check_valid_access_traits(PredicatesTag{}, predicates);
+
+    using AccessValues =
+        ArborX::Details::AccessValues<Predicates, PredicatesTag>;
+    AccessValues access_values{predicates};
+
+    static_assert(std::is_same_v<typename AccessValues::value_type::Tag,
+                                 ArborX::Details::SpatialPredicateTag>,
+                  "Forest only supports spatial predicates");
+
+    using ArborX::Details::KokkosExt::exclusive_scan;
+    using ArborX::Details::KokkosExt::lastElement;
+    using ArborX::Details::KokkosExt::reallocWithoutInitializing;
+
+    int const n_queries = access_values.size();
+
+    auto const top_tree = _top_tree;
+    auto const trees = _trees;
+
+    reallocWithoutInitializing(space, offset, n_queries + 1);
+    Kokkos::parallel_for(
+        "ArborX::Forest::query::count",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int i) {
+          auto const &predicate = access_values(i);
+          int count = 0;
+          top_tree.query(PerThread{}, predicate,
+                         [&](auto const &, auto const &top_value) {
+                           trees(top_value.index)
+                               .query(PerThread{}, predicate,
+                                      [&](auto const &, value_type const &) {
+                                        ++count;
+                                      });
+                         });
+          offset(i) = count;
+        });
+    exclusive_scan(space, offset, offset, 0);
+
+    int const n_results = lastElement(space, offset);
+    reallocWithoutInitializing(space, values, n_results);
+    Kokkos::parallel_for(
+        "ArborX::Forest::query::fill",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int i) {
+          auto const &predicate = access_values(i);
+          int j = offset(i);
+          top_tree.query(
+              PerThread{}, predicate,
+              [&](auto const &, auto const &top_value) {
+                trees(top_value.index)
+                    .query(PerThread{}, predicate,
+                           [&](auto const &, value_type const &value) {
+                             values(j++) = value;
+                           });
+              });
+        });
+  }
+
+private:
+  Kokkos::View<Tree *, memory_space> _trees;
+  BoundingVolumeHierarchy<memory_space> _top_tree;
+};
+
+} // namespace ArborX::Experimental
+
+#endif
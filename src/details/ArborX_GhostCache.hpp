@@ -0,0 +1,95 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_GHOST_CACHE_HPP
+#define ARBORX_GHOST_CACHE_HPP
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Opt-in cache for the remote contribution of repeated distributed spatial
+// queries. When a cache is passed to DistributedTree::query() after the
+// offset view, the values imported from other ranks are retained, and as
+// long as the epoch does not change subsequent queries skip the forwarding
+// and return exchanges entirely — only the rank's own predicates are
+// traversed — which is the steady state of a halo-exchange loop where the
+// same boundary predicates hit the same remote primitives every step.
+//
+// The user declares change by bumping the epoch: call setEpoch() with a new
+// value whenever the predicates forwarded to other ranks or the data held by
+// other ranks may have changed (e.g., after particles migrate or the tree is
+// rebuilt). A cache is tied to one tree, one set of predicates, and one
+// callback output type.
+template <class MemorySpace>
+class GhostCache
+{
+public:
+  void setEpoch(size_t epoch)
+  {
+    if (epoch != _epoch)
+    {
+      _epoch = epoch;
+      invalidate();
+    }
+  }
+
+  void invalidate() { _valid = false; }
+
+  bool valid() const { return _valid; }
+
+  size_t size() const { return _n_results; }
+
+  // Retain the imported values and the originating query ids
+  template <typename ExecutionSpace, typename Values, typename Ids>
+  void store(ExecutionSpace const &space, Values const &values, Ids const &ids)
+  {
+    using Value = typename Values::non_const_value_type;
+
+    auto const n = values.extent(0);
+    if (_values.extent(0) < n * sizeof(Value))
+      Kokkos::realloc(Kokkos::WithoutInitializing, _values,
+                      n * sizeof(Value));
+    if (_ids.extent(0) < n)
+      Kokkos::realloc(Kokkos::WithoutInitializing, _ids, n);
+
+    Kokkos::deep_copy(space, this->values<Value>(n), values);
+    Kokkos::deep_copy(space, Kokkos::subview(_ids, std::make_pair(size_t(0), n)),
+                      ids);
+
+    _n_results = n;
+    _valid = true;
+  }
+
+  template <typename Value>
+  Kokkos::View<Value *, MemorySpace> values(size_t n) const
+  {
+    return {reinterpret_cast<Value *>(_values.data()), n};
+  }
+
+  auto ids() const
+  {
+    return Kokkos::subview(_ids, std::make_pair(size_t(0), _n_results));
+  }
+
+private:
+  bool _valid = false;
+  size_t _epoch = 0;
+  size_t _n_results = 0;
+
+  Kokkos::View<char *, MemorySpace> _values{"ArborX::GhostCache::values", 0};
+  Kokkos::View<int *, MemorySpace> _ids{"ArborX::GhostCache::ids", 0};
+};
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -0,0 +1,133 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_HYBRID_QUERY_HPP
+#define ARBORX_HYBRID_QUERY_HPP
+
+#include <ArborX_Exception.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Splits a query batch between a device and a host tree so otherwise idle
+// CPU cores contribute throughput while the GPU grinds through its share.
+// The two trees must index the same primitives (build one per memory space
+// from the same input); likewise the two predicate views must hold the same
+// batch in the same order, each accessible from its execution space. The
+// device share [0, n_device) is enqueued first and traversed while the
+// calling thread works through the host share [n_device, n), so the split
+// costs no extra host threads.
+//
+// The work ratio calibrates itself: each call times both sides and blends
+// the measured per-predicate throughputs into the fraction used by the
+// next call, so the split converges over a few batches and tracks drift in
+// predicate cost. The first call uses an initial fraction (device-heavy by
+// default) that can be seeded from setDeviceFraction() when known.
+template <class DeviceTree, class HostTree>
+class HybridQuery
+{
+public:
+  HybridQuery(DeviceTree const &device_tree, HostTree const &host_tree)
+      : _device_tree(device_tree)
+      , _host_tree(host_tree)
+  {
+    ARBORX_ASSERT(device_tree.size() == host_tree.size());
+  }
+
+  float deviceFraction() const { return _device_fraction; }
+
+  void setDeviceFraction(float fraction)
+  {
+    ARBORX_ASSERT(fraction > 0 && fraction < 1);
+    _device_fraction = fraction;
+  }
+
+  template <class DeviceExecutionSpace, class HostExecutionSpace,
+            class DevicePredicates, class HostPredicates,
+            class DeviceCallback, class HostCallback>
+  void query(DeviceExecutionSpace const &device_space,
+             HostExecutionSpace const &host_space,
+             DevicePredicates const &device_predicates,
+             HostPredicates const &host_predicates,
+             DeviceCallback const &device_callback,
+             HostCallback const &host_callback)
+  {
+    static_assert(Kokkos::is_view_v<DevicePredicates> &&
+                      Kokkos::is_view_v<HostPredicates>,
+                  "HybridQuery requires rank-1 views of predicates so the "
+                  "batch can be partitioned with subviews");
+
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::Experimental::HybridQuery::query");
+
+    int const n = device_predicates.extent_int(0);
+    ARBORX_ASSERT(host_predicates.extent_int(0) == n);
+
+    int const n_device = (int)(_device_fraction * n);
+
+    Kokkos::Timer timer;
+    double const t_start = timer.seconds();
+
+    // Enqueue the device share first; it traverses while the calling
+    // thread runs the host share below
+    if (n_device > 0)
+      _device_tree.query(
+          device_space,
+          Kokkos::subview(device_predicates, Kokkos::make_pair(0, n_device)),
+          device_callback);
+
+    double t_host = 0;
+    if (n_device < n)
+    {
+      double const t0 = timer.seconds();
+      _host_tree.query(
+          host_space,
+          Kokkos::subview(host_predicates, Kokkos::make_pair(n_device, n)),
+          host_callback);
+      host_space.fence("ArborX::Experimental::HybridQuery (host share)");
+      t_host = timer.seconds() - t0;
+    }
+
+    device_space.fence("ArborX::Experimental::HybridQuery (device share)");
+    double const t_device = timer.seconds() - t_start;
+
+    calibrate(n_device, n - n_device, t_device, t_host);
+  }
+
+private:
+  void calibrate(int n_device, int n_host, double t_device, double t_host)
+  {
+    // Not every call produces a usable sample: a share may have been empty
+    // or too short to time
+    if (n_device == 0 || n_host == 0 || t_device <= 0 || t_host <= 0)
+      return;
+
+    double const device_rate = n_device / t_device;
+    double const host_rate = n_host / t_host;
+    float const measured =
+        (float)(device_rate / (device_rate + host_rate));
+
+    // Blend with the current fraction to damp run-to-run noise, and keep
+    // both shares non-empty so calibration never starves itself
+    _device_fraction = 0.5f * _device_fraction + 0.5f * measured;
+    _device_fraction = Kokkos::clamp(_device_fraction, 0.05f, 0.95f);
+  }
+
+  DeviceTree _device_tree;
+  HostTree _host_tree;
+  float _device_fraction = 0.85f;
+};
+
+} // namespace ArborX::Experimental
+
+#endif
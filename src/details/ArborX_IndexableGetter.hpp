@@ -13,7 +13,9 @@
 #define ARBORX_INDEXABLE_GETTER_HPP
 
 #include <ArborX_AccessTraits.hpp>
+#include <ArborX_DetailsAlgorithms.hpp>
 #include <ArborX_GeometryTraits.hpp>
+#include <ArborX_HyperBox.hpp>
 #include <ArborX_PairValueIndex.hpp>
 
 namespace ArborX::Details
@@ -64,4 +66,78 @@ struct Indexables
 
 } // namespace ArborX::Details
 
+namespace ArborX::Experimental
+{
+
+// Indexable getter for trees whose stored values are the face indices of an
+// indexed triangle mesh. The bounding box of a face is computed straight
+// from the vertex and index views, so neither the triangles nor their boxes
+// are ever stored in an intermediate array.
+template <typename Vertices, typename Indices>
+struct TriangleMeshIndexableGetter
+{
+  IndexedTriangleMesh<Vertices, Indices> _mesh;
+
+  KOKKOS_FUNCTION auto operator()(int face) const
+  {
+    using Point = typename Vertices::non_const_value_type;
+    constexpr int DIM = GeometryTraits::dimension_v<Point>;
+    using Coordinate = typename GeometryTraits::coordinate_type<Point>::type;
+    ExperimentalHyperGeometry::Box<DIM, Coordinate> box;
+    for (int k = 0; k < 3; ++k)
+      Details::expand(box, _mesh.vertex(face, k));
+    return box;
+  }
+
+  template <typename Index>
+  KOKKOS_FUNCTION auto operator()(PairValueIndex<int, Index> const &pair) const
+  {
+    return (*this)(pair.value);
+  }
+};
+
+// Indexable getter that fetches the geometry from the user's original
+// primitives at traversal time. With values that are bare 32-bit indices,
+// the tree keeps no copy of the geometry at all: the indexable reads go to
+// data the application already owns, and tree memory beyond the nodes is a
+// single index per primitive. See make_index_only_bvh().
+template <typename Primitives>
+struct PrimitivesIndexableGetter
+{
+  Primitives _primitives;
+
+  template <typename Index,
+            typename Enable = std::enable_if_t<std::is_integral_v<Index>>>
+  KOKKOS_FUNCTION decltype(auto) operator()(Index i) const
+  {
+    using Primitive = std::decay_t<decltype(_primitives((int)i))>;
+    if constexpr (GeometryTraits::is_point<Primitive>{} ||
+                  GeometryTraits::is_box<Primitive>{})
+    {
+      return _primitives((int)i);
+    }
+    else
+    {
+      // Primitives that are not their own bounding volume (spheres, KDOPs,
+      // ...) are converted on the fly, matching what the legacy adapter
+      // used to store per leaf
+      constexpr int DIM = GeometryTraits::dimension_v<Primitive>;
+      using Coordinate =
+          typename GeometryTraits::coordinate_type<Primitive>::type;
+      ExperimentalHyperGeometry::Box<DIM, Coordinate> box{};
+      Details::expand(box, _primitives((int)i));
+      return box;
+    }
+  }
+
+  template <typename Value, typename Index>
+  KOKKOS_FUNCTION decltype(auto)
+  operator()(PairValueIndex<Value, Index> const &pair) const
+  {
+    return (*this)(pair.value);
+  }
+};
+
+} // namespace ArborX::Experimental
+
 #endif
@@ -0,0 +1,160 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_KNN_GRAPH_HPP
+#define ARBORX_KNN_GRAPH_HPP
+
+#include <ArborX_DetailsAlgorithms.hpp> // distance
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsMutualReachabilityDistance.hpp> // NearestK
+#include <ArborX_Exception.hpp>
+#include <ArborX_LinearBVH.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Experimental
+{
+
+enum class KNNGraphSymmetry
+{
+  // Directed graph: row i holds the k nearest neighbors of point i
+  None,
+  // Mutual graph: an edge survives only if present in both directions,
+  // non-mutual entries are invalidated in place (index -1, infinite
+  // distance). The union-symmetrized graph has variable degree and does
+  // not fit the dense layout; build it through the generic CSR query path.
+  Mutual
+};
+
+namespace Details
+{
+
+template <class Points, class Cursors, class Indices, class Distances>
+struct DenseKNNCallback
+{
+  Points _points;
+  Cursors _cursors;
+  Indices _indices;
+  Distances _distances;
+  int _k;
+
+  template <class Predicate, class Value>
+  KOKKOS_FUNCTION void operator()(Predicate const &predicate,
+                                  Value const &value) const
+  {
+    int const i = getData(predicate);
+    int const j = (int)value.index;
+    if (j == i) // self match from the k+1 search
+      return;
+
+    // A single thread performs the whole nearest traversal of a predicate
+    // and reports matches in ascending distance order, so a plain cursor
+    // suffices and the dense rows come out sorted
+    int const slot = _cursors(i)++;
+    if (slot < _k)
+    {
+      _indices(i, slot) = j;
+      _distances(i, slot) =
+          ArborX::Details::distance(_points(i), _points(j));
+    }
+  }
+};
+
+} // namespace Details
+
+// Builds the k-nearest-neighbor graph of the points as dense (n, k) index
+// and distance views: indices(i, *) are the k nearest neighbors of point i
+// in ascending distance order, excluding i itself. Rows of points with
+// fewer than k neighbors are padded with index -1 and infinite distance.
+// The fixed k and dense output skip the offset scan, the output
+// reallocation, and the fill pass of the generic CSR path entirely: one
+// nearest traversal writes straight into the final rows.
+template <class ExecutionSpace, class Points, class Indices, class Distances>
+void buildKNNGraph(ExecutionSpace const &space, Points const &points, int k,
+                   Indices &indices, Distances &distances,
+                   KNNGraphSymmetry symmetry = KNNGraphSymmetry::None)
+{
+  using MemorySpace = typename Points::memory_space;
+
+  static_assert(Kokkos::is_view_v<Indices> && unsigned(Indices::rank) == 2);
+  static_assert(Kokkos::is_view_v<Distances> &&
+                unsigned(Distances::rank) == 2);
+
+  ARBORX_ASSERT(k >= 1);
+
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::Experimental::KNNGraph::build");
+
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+  constexpr auto inf =
+      KokkosExt::ArithmeticTraits::infinity<float>::value;
+
+  int const n = points.extent_int(0);
+
+  KokkosExt::reallocWithoutInitializing(space, indices, n, k);
+  KokkosExt::reallocWithoutInitializing(space, distances, n, k);
+  Kokkos::deep_copy(space, indices, -1);
+  Kokkos::deep_copy(space, distances, inf);
+
+  ArborX::BVH<MemorySpace> bvh(space, points);
+
+  Kokkos::View<int *, MemorySpace> cursors(
+      Kokkos::view_alloc(space, "ArborX::Experimental::KNNGraph::cursors"),
+      n);
+
+  // k + 1 nearest: the closest match of a point is the point itself
+  bvh.query(space, ArborX::Details::NearestK<Points>{points, k + 1},
+            Details::DenseKNNCallback<Points, decltype(cursors), Indices,
+                                      Distances>{points, cursors, indices,
+                                                 distances, k});
+
+  if (symmetry == KNNGraphSymmetry::Mutual)
+  {
+    // Mark first, invalidate after: invalidating while other rows are
+    // still being scanned would drop mutual edges
+    Kokkos::View<bool **, MemorySpace> mutual(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::Experimental::KNNGraph::mutual"),
+        n, k);
+    Kokkos::parallel_for(
+        "ArborX::Experimental::KNNGraph::find_mutual_edges",
+        Kokkos::MDRangePolicy<ExecutionSpace, Kokkos::Rank<2>>(space, {0, 0},
+                                                               {n, k}),
+        KOKKOS_LAMBDA(int i, int slot) {
+          int const j = indices(i, slot);
+          bool found = false;
+          if (j >= 0)
+            for (int t = 0; t < k; ++t)
+              if (indices(j, t) == i)
+              {
+                found = true;
+                break;
+              }
+          mutual(i, slot) = found;
+        });
+    Kokkos::parallel_for(
+        "ArborX::Experimental::KNNGraph::drop_non_mutual_edges",
+        Kokkos::MDRangePolicy<ExecutionSpace, Kokkos::Rank<2>>(space, {0, 0},
+                                                               {n, k}),
+        KOKKOS_LAMBDA(int i, int slot) {
+          if (!mutual(i, slot))
+          {
+            indices(i, slot) = -1;
+            distances(i, slot) = inf;
+          }
+        });
+  }
+}
+
+} // namespace ArborX::Experimental
+
+#endif
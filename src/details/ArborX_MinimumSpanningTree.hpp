@@ -13,20 +13,75 @@
 #define ARBORX_MINIMUM_SPANNING_TREE_HPP
 
 #include <ArborX_AccessTraits.hpp>
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsEdgeContraction.hpp>
+#include <ArborX_DetailsHappyTreeFriends.hpp>
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
 #include <ArborX_DetailsKokkosExtViewHelpers.hpp>
 #include <ArborX_DetailsMinimumSpanningTree.hpp>
 #include <ArborX_DetailsMutualReachabilityDistance.hpp>
 #include <ArborX_DetailsTreeNodeLabeling.hpp>
+#include <ArborX_DetailsUnionFind.hpp>
 #include <ArborX_DetailsWeightedEdge.hpp>
+#include <ArborX_Exception.hpp>
 #include <ArborX_LinearBVH.hpp>
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_Profiling_ScopedRegion.hpp>
 
+#include <algorithm> // max
+
 namespace ArborX::Details
 {
 
+// Engine used to compute the tree. Boruvka discovers edges directly on the
+// implicit complete graph through tree traversals and is always exact.
+// EdgeContraction first contracts an explicit k-nearest-neighbor candidate
+// graph with lock-free Boruvka rounds over the edge list (in the spirit of
+// ECL-MST) and only falls back to tree traversals to connect whatever the
+// candidate graph left disconnected; it avoids most full-tree sweeps but is
+// guaranteed exact only when the candidate graph contains every tree edge,
+// which is the typical situation in low dimension. Auto picks an engine
+// based on the problem size.
+enum class MSTAlgorithm
+{
+  Boruvka,
+  EdgeContraction,
+  Auto
+};
+
+template <class Points, class LeafIndices, class Metric, class Counts,
+          class Candidates>
+struct CollectCandidateEdges
+{
+  Points _points;
+  LeafIndices _leaf_indices;
+  Metric _metric;
+  Counts _counts;
+  Candidates _candidates;
+  int _num_candidates;
+
+  template <class Predicate, class Value>
+  KOKKOS_FUNCTION void operator()(Predicate const &predicate,
+                                  Value const &value) const
+  {
+    int const i = getData(predicate);
+    int const j = (int)value.index;
+    if (i == j)
+      return;
+
+    // NOTE using knowledge that each nearest predicate traversal is performed
+    // by a single thread. The slot update below would need to be atomic
+    // otherwise.
+    int const slot = _counts(i)++;
+    // Candidate edges are stored with leaf indices so that they live in the
+    // same index space as the edges found by the Boruvka rounds
+    _candidates(i * (long long)_num_candidates + slot) =
+        WeightedEdge{_leaf_indices(i), _leaf_indices(j),
+                     _metric(i, j, distance(_points(i), _points(j)))};
+  }
+};
+
 template <class MemorySpace, BoruvkaMode Mode = BoruvkaMode::MST>
 struct MinimumSpanningTree
 {
@@ -37,9 +92,13 @@ struct MinimumSpanningTree
   Kokkos::View<int *, MemorySpace> dendrogram_parents;
   Kokkos::View<float *, MemorySpace> dendrogram_parent_heights;
 
+  // num_candidates is the number of candidate neighbors per point used by the
+  // EdgeContraction engine, and acts as its accuracy budget; -1 picks a
+  // default based on k
   template <class ExecutionSpace, class Primitives>
   MinimumSpanningTree(ExecutionSpace const &space, Primitives const &primitives,
-                      int k = 1)
+                      int k = 1, MSTAlgorithm algorithm = MSTAlgorithm::Boruvka,
+                      int num_candidates = -1)
       : edges(Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
                                  "ArborX::MST::edges"),
               AccessTraits<Primitives, PrimitivesTag>::size(primitives) - 1)
@@ -61,20 +120,80 @@ struct MinimumSpanningTree
         space, Experimental::attach_indices(points));
     Kokkos::Profiling::popRegion();
 
+    if constexpr (Mode == BoruvkaMode::HDBSCAN)
+    {
+      // The dendrogram machinery reconstructs parents from the order in which
+      // the Boruvka rounds discover edges; edges committed by contraction
+      // carry no such order, so the alternative engine is limited to the
+      // plain MST mode
+      ARBORX_ASSERT(algorithm != MSTAlgorithm::EdgeContraction);
+      algorithm = MSTAlgorithm::Boruvka;
+    }
+    else if (algorithm == MSTAlgorithm::Auto)
+    {
+      // The candidate pass costs an extra k-NN sweep, which only pays off
+      // when it displaces a number of full-tree Boruvka rounds
+      algorithm = (n >= (1 << 20)) ? MSTAlgorithm::EdgeContraction
+                                   : MSTAlgorithm::Boruvka;
+    }
+
     if (k > 1)
     {
       Kokkos::Profiling::pushRegion("ArborX::MST::compute_core_distances");
       Kokkos::View<float *, MemorySpace> core_distances(
           "ArborX::MST::core_distances", n);
-      bvh.query(space, NearestK<Points>{points, k},
-                MaxDistance<Points, decltype(core_distances)>{points,
-                                                              core_distances});
+      Kokkos::View<float *, MemorySpace> seed_radii("ArborX::MST::seed_radii",
+                                                    0);
+      if (algorithm == MSTAlgorithm::Boruvka)
+      {
+        // Record the neighborhoods discovered by the core distance sweep and
+        // fold them into first-round search radii (see computeSeedRadii), so
+        // that the first Boruvka round does not start from scratch in the
+        // very tree regions the sweep just visited
+        Kokkos::View<int *, MemorySpace> neighbor_indices(
+            Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                               "ArborX::MST::neighbor_indices"),
+            n * (long long)k);
+        Kokkos::deep_copy(space, neighbor_indices, -1);
+        Kokkos::View<int *, MemorySpace> neighbor_counts(
+            Kokkos::view_alloc(space, "ArborX::MST::neighbor_counts"), n);
+        bvh.query(space, NearestK<Points>{points, k},
+                  MaxDistanceWithNeighbors<Points, decltype(core_distances),
+                                           decltype(neighbor_indices),
+                                           decltype(neighbor_counts)>{
+                      points, core_distances, neighbor_indices,
+                      neighbor_counts, k});
+        seed_radii = computeSeedRadii(space, core_distances, neighbor_indices,
+                                      k);
+      }
+      else
+      {
+        bvh.query(space, NearestK<Points>{points, k},
+                  MaxDistance<Points, decltype(core_distances)>{
+                      points, core_distances});
+      }
       Kokkos::Profiling::popRegion();
 
       MutualReachability<decltype(core_distances)> mutual_reachability{
           core_distances};
-      Kokkos::Profiling::pushRegion("ArborX::MST::boruvka");
-      doBoruvka(space, bvh, mutual_reachability);
+      if (algorithm == MSTAlgorithm::EdgeContraction)
+      {
+        Kokkos::Profiling::pushRegion("ArborX::MST::edge_contraction");
+        doEdgeContraction(space, bvh, points, mutual_reachability, k,
+                          num_candidates);
+        Kokkos::Profiling::popRegion();
+      }
+      else
+      {
+        Kokkos::Profiling::pushRegion("ArborX::MST::boruvka");
+        doBoruvka(space, bvh, mutual_reachability, {}, 0, seed_radii);
+        Kokkos::Profiling::popRegion();
+      }
+    }
+    else if (algorithm == MSTAlgorithm::EdgeContraction)
+    {
+      Kokkos::Profiling::pushRegion("ArborX::MST::edge_contraction");
+      doEdgeContraction(space, bvh, points, Euclidean{}, k, num_candidates);
       Kokkos::Profiling::popRegion();
     }
     else
@@ -94,9 +213,98 @@ struct MinimumSpanningTree
 #ifndef KOKKOS_COMPILER_NVCC
 private:
 #endif
+  template <class ExecutionSpace, class BVH, class Points, class Metric>
+  void doEdgeContraction(ExecutionSpace const &space, BVH const &bvh,
+                         Points const &points, Metric const &metric, int k,
+                         int num_candidates)
+  {
+    namespace KokkosExt = ArborX::Details::KokkosExt;
+
+    int const n = bvh.size();
+
+    // Number of candidate neighbors per point (excluding the point itself).
+    // In low dimension a handful of nearest neighbors covers the overwhelming
+    // majority of tree edges; anything missed is picked up by the completion
+    // rounds below.
+    ARBORX_ASSERT(num_candidates == -1 || num_candidates >= 1);
+    if (num_candidates == -1)
+      num_candidates = std::max(k, 8);
+
+    // Map original indices to leaf slots so that candidate edges live in the
+    // same index space as the edges found by the Boruvka rounds;
+    // finalizeEdges() converts back at the very end
+    Kokkos::View<int *, MemorySpace> leaf_indices(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::MST::leaf_indices"),
+        n);
+    Kokkos::parallel_for(
+        "ArborX::MST::compute_leaf_indices",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i) {
+          leaf_indices(HappyTreeFriends::getValue(bvh, i).index) = i;
+        });
+
+    // Unused slots keep their zero-initialized self-loop and are skipped by
+    // the contraction
+    Kokkos::View<WeightedEdge *, MemorySpace> candidates(
+        Kokkos::view_alloc(space, "ArborX::MST::candidate_edges"),
+        n * (long long)num_candidates);
+    Kokkos::View<int *, MemorySpace> counts(
+        Kokkos::view_alloc(space, "ArborX::MST::candidate_counts"), n);
+    bvh.query(space, NearestK<Points>{points, num_candidates + 1},
+              CollectCandidateEdges<Points, decltype(leaf_indices), Metric,
+                                    decltype(counts), decltype(candidates)>{
+                  points, leaf_indices, metric, counts, candidates,
+                  num_candidates});
+    Kokkos::resize(leaf_indices, 0);
+    Kokkos::resize(counts, 0);
+
+    Kokkos::View<int *, MemorySpace> labels(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::MST::labels"),
+        n);
+    KokkosExt::iota(space, labels);
+    Kokkos::View<int, MemorySpace> num_edges(
+        Kokkos::view_alloc(space, "ArborX::MST::num_edges")); // initialize to 0
+
+#ifdef KOKKOS_ENABLE_SERIAL
+    constexpr bool do_serial = std::is_same_v<ExecutionSpace, Kokkos::Serial>;
+#else
+    constexpr bool do_serial = false;
+#endif
+    UnionFind<MemorySpace, do_serial> union_find{labels};
+
+    contractEdges(space, n, candidates, union_find, edges, num_edges);
+    Kokkos::resize(candidates, 0);
+
+    int num_edges_host;
+    Kokkos::deep_copy(space, num_edges_host, num_edges);
+    space.fence();
+
+    if (num_edges_host == n - 1)
+    {
+      // The candidate graph was connected, the tree is complete
+      return;
+    }
+
+    // Flatten the union-find forest into component labels and connect the
+    // remaining components with regular Boruvka rounds
+    Kokkos::parallel_for(
+        "ArborX::MST::flatten_labels",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i) { labels(i) = union_find.representative(i); });
+
+    Kokkos::Profiling::pushRegion("ArborX::MST::boruvka");
+    doBoruvka(space, bvh, metric, labels, num_edges_host);
+    Kokkos::Profiling::popRegion();
+  }
+
   template <class ExecutionSpace, class BVH, class Metric>
   void doBoruvka(ExecutionSpace const &space, BVH const &bvh,
-                 Metric const &metric)
+                 Metric const &metric,
+                 Kokkos::View<int *, MemorySpace> const &seed_labels = {},
+                 int num_seed_edges = 0,
+                 Kokkos::View<float *, MemorySpace> const &seed_radii = {})
   {
     namespace KokkosExt = ArborX::Details::KokkosExt;
 
@@ -112,8 +320,13 @@ private:
         Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
                            "ArborX::MST::labels"),
         2 * n - 1);
-    KokkosExt::iota(space,
-                    Kokkos::subview(labels, std::make_pair((decltype(n))0, n)));
+    if (seed_labels.size() != 0)
+      Kokkos::deep_copy(
+          space, Kokkos::subview(labels, std::make_pair((decltype(n))0, n)),
+          seed_labels);
+    else
+      KokkosExt::iota(
+          space, Kokkos::subview(labels, std::make_pair((decltype(n))0, n)));
     Kokkos::Profiling::popRegion();
 
     Kokkos::View<DirectedEdge *, MemorySpace> component_out_edges(
@@ -161,6 +374,8 @@ private:
     Kokkos::Profiling::pushRegion("ArborX::MST::Boruvka_loop");
     Kokkos::View<int, MemorySpace> num_edges(
         Kokkos::view_alloc(space, "ArborX::MST::num_edges")); // initialize to 0
+    if (num_seed_edges > 0)
+      Kokkos::deep_copy(space, num_edges, num_seed_edges);
 
     Kokkos::View<int *, MemorySpace> edges_mapping("ArborX::MST::edges_mapping",
                                                    0);
@@ -177,7 +392,7 @@ private:
 
     // Boruvka iterations
     int iterations = 0;
-    int num_components = n;
+    int num_components = static_cast<int>(n) - num_seed_edges;
     [[maybe_unused]] int edges_start = 0;
     [[maybe_unused]] int edges_end = 0;
     do
@@ -195,6 +410,10 @@ private:
       Kokkos::deep_copy(space, weights, inf);
       Kokkos::deep_copy(space, radii, inf);
       resetSharedRadii(space, bvh, labels, metric, radii);
+      // The precomputed bounds hold for singleton components only, so they
+      // can only tighten the very first round
+      if (iterations == 1 && seed_radii.size() != 0)
+        applySeedRadii(space, bvh, seed_radii, radii);
 
       FindComponentNearestNeighbors(
           space, bvh, labels, weights, component_out_edges, metric, radii,
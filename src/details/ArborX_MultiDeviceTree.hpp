@@ -0,0 +1,331 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_MULTI_DEVICE_TREE_HPP
+#define ARBORX_MULTI_DEVICE_TREE_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_Box.hpp>
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DetailsSortUtils.hpp>
+#include <ArborX_Exception.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_Predicates.hpp>
+#include <ArborX_SpaceFillingCurves.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <vector>
+
+namespace ArborX::Experimental
+{
+
+// Shards primitives across the devices of a single process, without MPI.
+//
+// DistributedTree pays full message serialization through the Distributor
+// even between GPUs of the same node that share a fast interconnect. Here
+// each device owns a contiguous shard of the space-filling-curve ordering
+// and builds its own tree on its own execution space instance; a query
+// forwards to a device only the predicates that intersect the bounds of
+// its shard, through plain peer-to-peer Kokkos::deep_copy, and merges the
+// per-device results back on the first device.
+//
+// Every execution space instance passed to the constructor must be bound
+// to the device it represents (e.g. a Kokkos::Cuda instance per GPU);
+// primitives are expected to be accessible from the first instance, and
+// query outputs are produced there as well. Only spatial predicates are
+// supported. The interface mirrors the legacy trees: callbacks are not
+// supported yet, and the CSR output holds the indices of the matching
+// primitives.
+template <typename MemorySpace>
+class MultiDeviceTree
+{
+public:
+  using memory_space = MemorySpace;
+  static_assert(Kokkos::is_memory_space<MemorySpace>::value);
+  using execution_space = typename MemorySpace::execution_space;
+  using size_type = typename BVH<MemorySpace>::size_type;
+  using bounding_volume_type = typename BVH<MemorySpace>::bounding_volume_type;
+
+  MultiDeviceTree() = default;
+
+  template <typename Primitives>
+  MultiDeviceTree(std::vector<execution_space> const &spaces,
+                  Primitives const &user_primitives)
+  {
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::MultiDeviceTree::MultiDeviceTree");
+
+    ARBORX_ASSERT(!spaces.empty());
+    _spaces = spaces;
+
+    Details::check_valid_access_traits(PrimitivesTag{}, user_primitives);
+    using AccessValues = Details::AccessValues<Primitives, PrimitivesTag>;
+    AccessValues primitives{user_primitives};
+    using Primitive = typename AccessValues::value_type;
+
+    int const n = primitives.size();
+    int const n_devices = (int)spaces.size();
+    auto const &space = _spaces[0];
+
+    _size = n;
+    _shard_starts.resize(n_devices + 1);
+    _shard_bounds.resize(n_devices);
+    _trees.resize(n_devices);
+    if (n == 0)
+    {
+      for (int d = 0; d <= n_devices; ++d)
+        _shard_starts[d] = 0;
+      return;
+    }
+
+    bounding_volume_type bounds{};
+    Kokkos::parallel_reduce(
+        "ArborX::MultiDeviceTree::reduce_bounds",
+        Kokkos::RangePolicy<execution_space>(space, 0, n),
+        KOKKOS_LAMBDA(int i, bounding_volume_type &update) {
+          using Details::expand;
+          expand(update, primitives(i));
+        },
+        Kokkos::Sum<bounding_volume_type>{bounds});
+    _bounds = bounds;
+
+    // Sort the primitives along a space-filling curve so that each shard
+    // is spatially compact; compact shards keep the number of devices a
+    // predicate is forwarded to small
+    Kokkos::View<unsigned long long *, MemorySpace> keys(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::MultiDeviceTree::sfc_keys"),
+        n);
+    Kokkos::parallel_for(
+        "ArborX::MultiDeviceTree::compute_sfc_keys",
+        Kokkos::RangePolicy<execution_space>(space, 0, n),
+        KOKKOS_LAMBDA(int i) {
+          keys(i) = Morton64{}(bounds, primitives(i));
+        });
+    _permute = Details::sortObjects(space, keys);
+
+    auto const permute = _permute;
+    Kokkos::View<Primitive *, MemorySpace> sorted_primitives(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::MultiDeviceTree::sorted_primitives"),
+        n);
+    Kokkos::parallel_for(
+        "ArborX::MultiDeviceTree::apply_permutation",
+        Kokkos::RangePolicy<execution_space>(space, 0, n),
+        KOKKOS_LAMBDA(int i) { sorted_primitives(i) = primitives(permute(i)); });
+    space.fence(
+        "ArborX::MultiDeviceTree (sorted primitives ready for shipping)");
+
+    for (int d = 0; d <= n_devices; ++d)
+      _shard_starts[d] = (int)((long long)n * d / n_devices);
+
+    for (int d = 0; d < n_devices; ++d)
+    {
+      int const shard_size = _shard_starts[d + 1] - _shard_starts[d];
+      // The allocation and the copy are issued on the owning device; the
+      // copy rides the interconnect directly instead of a Distributor
+      // round trip
+      Kokkos::View<Primitive *, MemorySpace> shard(
+          Kokkos::view_alloc(_spaces[d], Kokkos::WithoutInitializing,
+                             "ArborX::MultiDeviceTree::shard_primitives"),
+          shard_size);
+      Kokkos::deep_copy(_spaces[d], shard,
+                        Kokkos::subview(sorted_primitives,
+                                        Kokkos::make_pair(_shard_starts[d],
+                                                          _shard_starts[d + 1])));
+      _trees[d] = BVH<MemorySpace>(_spaces[d], shard);
+      _shard_bounds[d] = _trees[d].bounds();
+    }
+    for (int d = 0; d < n_devices; ++d)
+      _spaces[d].fence("ArborX::MultiDeviceTree (construction done)");
+  }
+
+  size_type size() const noexcept { return _size; }
+
+  bool empty() const noexcept { return size() == 0; }
+
+  bounding_volume_type bounds() const noexcept { return _bounds; }
+
+  template <typename UserPredicates, typename Values, typename Offset>
+  void query(UserPredicates const &user_predicates, Values &values,
+             Offset &offset) const
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::MultiDeviceTree::query");
+
+    namespace KokkosExt = Details::KokkosExt;
+
+    Details::check_valid_access_traits(PredicatesTag{}, user_predicates);
+    using Predicates = Details::AccessValues<UserPredicates, PredicatesTag>;
+    Predicates predicates{user_predicates};
+
+    using Predicate = typename Predicates::value_type;
+    static_assert(
+        std::is_same_v<typename Predicate::Tag, Details::SpatialPredicateTag>,
+        "MultiDeviceTree only supports spatial predicates");
+
+    auto const &space = _spaces[0];
+    int const n_devices = (int)_spaces.size();
+    int const n_queries = predicates.size();
+
+    KokkosExt::reallocWithoutInitializing(space, offset, n_queries + 1);
+    Kokkos::deep_copy(space, offset, 0);
+    if (empty() || n_queries == 0)
+    {
+      KokkosExt::reallocWithoutInitializing(space, values, 0);
+      return;
+    }
+
+    // Per-device boundary predicate selection: only the predicates whose
+    // geometry reaches into a shard travel to its device
+    std::vector<Kokkos::View<int *, MemorySpace>> selected_ids(n_devices);
+    std::vector<Kokkos::View<Predicate *, MemorySpace>> selected_predicates(
+        n_devices);
+    for (int d = 0; d < n_devices; ++d)
+    {
+      auto const shard_bounds = _shard_bounds[d];
+      Kokkos::View<int *, MemorySpace> marks(
+          Kokkos::view_alloc(space, "ArborX::MultiDeviceTree::query::marks"),
+          n_queries + 1);
+      Kokkos::parallel_for(
+          "ArborX::MultiDeviceTree::query::mark_boundary_predicates",
+          Kokkos::RangePolicy<execution_space>(space, 0, n_queries),
+          KOKKOS_LAMBDA(int i) { marks(i) = predicates(i)(shard_bounds); });
+      KokkosExt::exclusive_scan(space, marks, marks, 0);
+      int const n_selected = KokkosExt::lastElement(space, marks);
+
+      selected_ids[d] = Kokkos::View<int *, MemorySpace>(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                             "ArborX::MultiDeviceTree::query::selected_ids"),
+          n_selected);
+      selected_predicates[d] = Kokkos::View<Predicate *, MemorySpace>(
+          Kokkos::view_alloc(
+              space, Kokkos::WithoutInitializing,
+              "ArborX::MultiDeviceTree::query::selected_predicates"),
+          n_selected);
+      auto const ids = selected_ids[d];
+      auto const preds = selected_predicates[d];
+      Kokkos::parallel_for(
+          "ArborX::MultiDeviceTree::query::pack_boundary_predicates",
+          Kokkos::RangePolicy<execution_space>(space, 0, n_queries),
+          KOKKOS_LAMBDA(int i) {
+            if (marks(i + 1) != marks(i))
+            {
+              ids(marks(i)) = i;
+              preds(marks(i)) = predicates(i);
+            }
+          });
+    }
+    space.fence("ArborX::MultiDeviceTree::query (predicates packed)");
+
+    // Fan the selected predicates out and traverse every shard on its own
+    // device; the copies back to the first device are enqueued on the
+    // owning instance so they are ordered after the traversal
+    std::vector<Kokkos::View<int *, MemorySpace>> shard_values(n_devices);
+    std::vector<Kokkos::View<int *, MemorySpace>> shard_offset(n_devices);
+    for (int d = 0; d < n_devices; ++d)
+    {
+      int const n_selected = selected_ids[d].extent_int(0);
+      if (n_selected == 0)
+        continue;
+
+      Kokkos::View<Predicate *, MemorySpace> remote_predicates(
+          Kokkos::view_alloc(
+              _spaces[d], Kokkos::WithoutInitializing,
+              "ArborX::MultiDeviceTree::query::remote_predicates"),
+          n_selected);
+      Kokkos::deep_copy(_spaces[d], remote_predicates, selected_predicates[d]);
+
+      Kokkos::View<int *, MemorySpace> remote_values(
+          "ArborX::MultiDeviceTree::query::remote_values", 0);
+      Kokkos::View<int *, MemorySpace> remote_offset(
+          "ArborX::MultiDeviceTree::query::remote_offset", 0);
+      _trees[d].query(_spaces[d], remote_predicates, remote_values,
+                      remote_offset);
+
+      shard_values[d] = Kokkos::View<int *, MemorySpace>(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                             "ArborX::MultiDeviceTree::query::shard_values"),
+          remote_values.extent(0));
+      shard_offset[d] = Kokkos::View<int *, MemorySpace>(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                             "ArborX::MultiDeviceTree::query::shard_offset"),
+          remote_offset.extent(0));
+      Kokkos::deep_copy(_spaces[d], shard_values[d], remote_values);
+      Kokkos::deep_copy(_spaces[d], shard_offset[d], remote_offset);
+    }
+    for (int d = 0; d < n_devices; ++d)
+      _spaces[d].fence("ArborX::MultiDeviceTree::query (results shipped)");
+
+    // Merge on the first device. The kernels below run on the same
+    // instance and are serialized, so the per-query cursors need no
+    // atomics; the order of results within a query is unspecified, as for
+    // the single-device trees.
+    for (int d = 0; d < n_devices; ++d)
+    {
+      if (selected_ids[d].extent(0) == 0)
+        continue;
+      auto const ids = selected_ids[d];
+      auto const off = shard_offset[d];
+      Kokkos::parallel_for(
+          "ArborX::MultiDeviceTree::query::accumulate_counts",
+          Kokkos::RangePolicy<execution_space>(space, 0, ids.extent_int(0)),
+          KOKKOS_LAMBDA(int i) { offset(ids(i)) += off(i + 1) - off(i); });
+    }
+    KokkosExt::exclusive_scan(space, offset, offset, 0);
+    int const n_results = KokkosExt::lastElement(space, offset);
+    KokkosExt::reallocWithoutInitializing(space, values, n_results);
+
+    Kokkos::View<int *, MemorySpace> cursors(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::MultiDeviceTree::query::cursors"),
+        n_queries);
+    Kokkos::deep_copy(
+        space, cursors,
+        Kokkos::subview(offset, Kokkos::make_pair(0, n_queries)));
+    auto const permute = _permute;
+    for (int d = 0; d < n_devices; ++d)
+    {
+      if (selected_ids[d].extent(0) == 0)
+        continue;
+      auto const ids = selected_ids[d];
+      auto const vals = shard_values[d];
+      auto const off = shard_offset[d];
+      int const shard_start = _shard_starts[d];
+      Kokkos::parallel_for(
+          "ArborX::MultiDeviceTree::query::merge_results",
+          Kokkos::RangePolicy<execution_space>(space, 0, ids.extent_int(0)),
+          KOKKOS_LAMBDA(int i) {
+            int const q = ids(i);
+            int cursor = cursors(q);
+            for (int j = off(i); j < off(i + 1); ++j)
+              values(cursor++) = (int)permute(shard_start + vals(j));
+            cursors(q) = cursor;
+          });
+    }
+  }
+
+private:
+  std::vector<execution_space> _spaces;
+  std::vector<BVH<MemorySpace>> _trees;
+  std::vector<int> _shard_starts;
+  std::vector<bounding_volume_type> _shard_bounds;
+  Kokkos::View<unsigned int *, MemorySpace> _permute;
+  size_type _size = 0;
+  bounding_volume_type _bounds;
+};
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -0,0 +1,369 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_NEAREST_QUERY_CACHE_HPP
+#define ARBORX_NEAREST_QUERY_CACHE_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_Box.hpp>
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_Predicates.hpp>
+#include <ArborX_SpaceFillingCurves.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace ArborX
+{
+
+namespace Details
+{
+
+struct CachedIndexAndDistance
+{
+  int index;
+  float distance;
+};
+
+// Callback recovering the distance to every reported neighbor. Same device
+// as the one the distributed nearest query uses (see
+// ArborX_DetailsDistributedTreeNearest.hpp, which cannot be included here
+// because it requires MPI): the indexables live in the tree in leaf order,
+// so the original index is mapped back through a reverse permutation.
+template <typename Tree>
+struct NearestQueryCacheCallback
+{
+  Tree _tree;
+  Kokkos::View<unsigned int *, typename Tree::memory_space> _rev_permute;
+
+  template <typename ExecutionSpace>
+  NearestQueryCacheCallback(ExecutionSpace const &space, Tree const &tree)
+      : _tree(tree)
+  {
+    auto const n = _tree.size();
+
+    _rev_permute = Kokkos::View<unsigned int *, typename Tree::memory_space>(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::NearestQueryCache::reverse_permutation"),
+        n);
+    Kokkos::parallel_for(
+        "ArborX::NearestQueryCache::compute_reverse_permutation",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_CLASS_LAMBDA(int const i) {
+          _rev_permute(HappyTreeFriends::getValue(_tree, i).index) = i;
+        });
+  }
+
+  template <typename Query, typename OutputFunctor>
+  KOKKOS_FUNCTION void operator()(Query const &query, int index,
+                                  OutputFunctor const &out) const
+  {
+    int const leaf_node_index = _rev_permute(index);
+    auto const &leaf_node_bounding_volume =
+        HappyTreeFriends::getIndexable(_tree, leaf_node_index);
+    out({index, distance(getGeometry(query), leaf_node_bounding_volume)});
+  }
+};
+
+} // namespace Details
+
+namespace Experimental
+{
+
+// Result cache for nearest queries that are re-issued from almost identical
+// positions, e.g. camera-driven kNN probes evaluated every frame. Each
+// query slot remembers the Morton cell of the predicate centroid (32-bit
+// code, i.e. about a thousand bins per dimension of the scene bounding
+// box), the exact centroid, and the results of the last traversal. A
+// subsequent query in the same slot is served from the cache when the tree
+// is unchanged, the centroid falls in the same cell, and a distance bound
+// certifies the cached neighbor set: traversals ask for one extra neighbor
+// and record the gap between the k-th and (k+1)-th distances, so by the
+// triangle inequality a centroid that moved by less than half that gap has
+// provably the same k nearest neighbors. Cache hits replay the neighbors
+// in the cached order, which may differ from the ascending-distance order
+// a fresh traversal would produce.
+//
+// The cache only supports the index-returning query interface of
+// ArborX::BVH<MemorySpace> (the distance recovery relies on its leaf
+// layout, like the distributed nearest query does) and plain nearest
+// predicates; attachments are ignored. Queries must keep their slot
+// across calls: shuffling the batch defeats the per-slot matching, though
+// it cannot produce wrong results.
+template <class MemorySpace>
+class NearestQueryCache
+{
+public:
+  template <typename Tree, typename ExecutionSpace, typename Predicates,
+            typename Indices, typename Offset>
+  void query(ExecutionSpace const &space, Tree const &tree,
+             Predicates const &predicates, Indices &indices, Offset &offset)
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::NearestQueryCache::query");
+
+    namespace KokkosExt = Details::KokkosExt;
+
+    Details::check_valid_access_traits(PredicatesTag{}, predicates);
+    Details::AccessValues<Predicates, PredicatesTag> queries{predicates};
+
+    int const n = queries.size();
+
+    if (tree.empty() || n == 0)
+    {
+      invalidate();
+      KokkosExt::reallocWithoutInitializing(space, offset, n + 1);
+      Kokkos::deep_copy(space, offset, 0);
+      KokkosExt::reallocWithoutInitializing(space, indices, 0);
+      return;
+    }
+
+    auto const scene = tree.bounds();
+
+    bool const valid = _n == (size_t)n && _tree_size == (size_t)tree.size() &&
+                       Details::equals(scene, _tree_bounds);
+
+    Kokkos::View<unsigned int *, MemorySpace> cells(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::NearestQueryCache::cells"),
+        n);
+    Kokkos::View<Point *, MemorySpace> origins(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::NearestQueryCache::origins"),
+        n);
+    Kokkos::View<int *, MemorySpace> ks(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::NearestQueryCache::ks"),
+        n);
+    Kokkos::parallel_for(
+        "ArborX::NearestQueryCache::project_queries",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+          auto const &query = queries(i);
+          origins(i) = Details::returnCentroid(getGeometry(query));
+          cells(i) = Morton32{}(scene, origins(i));
+          ks(i) = getK(query);
+        });
+
+    // Zero-initialized: without a valid cache every slot is a miss
+    Kokkos::View<int *, MemorySpace> hits(
+        Kokkos::view_alloc(space, "ArborX::NearestQueryCache::hits"), n);
+    int n_hits = 0;
+    if (valid)
+    {
+      auto const cached_cells = _cells;
+      auto const cached_origins = _origins;
+      auto const cached_ks = _ks;
+      auto const cached_slack = _slack;
+      Kokkos::parallel_reduce(
+          "ArborX::NearestQueryCache::match_queries",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+          KOKKOS_LAMBDA(int i, int &update) {
+            bool hit = cells(i) == cached_cells(i) && ks(i) == cached_ks(i);
+            if (hit)
+              hit = 2 * Details::distance(origins(i), cached_origins(i)) <=
+                    cached_slack(i);
+            hits(i) = hit;
+            update += hit;
+          },
+          n_hits);
+    }
+
+    if (n_hits == n)
+    {
+      // Every slot certified: replay the cached results untouched
+      auto const cached_offsets = _offsets;
+      auto const cached_indices = _indices;
+      KokkosExt::reallocWithoutInitializing(space, offset, n + 1);
+      Kokkos::parallel_for(
+          "ArborX::NearestQueryCache::replay_offsets",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n + 1),
+          KOKKOS_LAMBDA(int i) { offset(i) = cached_offsets(i); });
+      int const n_results = KokkosExt::lastElement(space, _offsets);
+      KokkosExt::reallocWithoutInitializing(space, indices, n_results);
+      Kokkos::parallel_for(
+          "ArborX::NearestQueryCache::replay_indices",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_results),
+          KOKKOS_LAMBDA(int i) { indices(i) = cached_indices(i); });
+      return;
+    }
+
+    // Traverse the missed slots, asking for one extra neighbor to derive
+    // the reuse slack
+    int const n_misses = n - n_hits;
+    Kokkos::View<int *, MemorySpace> miss_map(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::NearestQueryCache::miss_map"),
+        n);
+    Kokkos::View<int *, MemorySpace> miss_ids(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::NearestQueryCache::miss_ids"),
+        n_misses);
+    Kokkos::parallel_scan(
+        "ArborX::NearestQueryCache::gather_misses",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i, int &update, bool final_pass) {
+          if (final_pass)
+          {
+            miss_map(i) = update;
+            if (!hits(i))
+              miss_ids(update) = i;
+          }
+          update += !hits(i);
+        });
+
+    using Geometry = std::decay_t<decltype(getGeometry(queries(0)))>;
+    using Query = decltype(nearest(std::declval<Geometry>(), 0));
+    Kokkos::View<Query *, MemorySpace> miss_queries(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::NearestQueryCache::miss_queries"),
+        n_misses);
+    Kokkos::parallel_for(
+        "ArborX::NearestQueryCache::form_miss_queries",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_misses),
+        KOKKOS_LAMBDA(int m) {
+          auto const &query = queries(miss_ids(m));
+          miss_queries(m) = nearest(getGeometry(query), getK(query) + 1);
+        });
+
+    Kokkos::View<Details::CachedIndexAndDistance *, MemorySpace> miss_results(
+        "ArborX::NearestQueryCache::miss_results", 0);
+    Kokkos::View<int *, MemorySpace> miss_offset(
+        "ArborX::NearestQueryCache::miss_offset", 0);
+    tree.query(space, miss_queries,
+               Details::NearestQueryCacheCallback<Tree>(space, tree),
+               miss_results, miss_offset);
+
+    // Assemble the refreshed cache: hit slots keep their entries (including
+    // the origin the slack is measured from), missed slots get the new
+    // traversal results truncated back to k
+    Kokkos::View<int *, MemorySpace> offsets(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::NearestQueryCache::offsets"),
+        n + 1);
+    Kokkos::View<float *, MemorySpace> slack(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::NearestQueryCache::slack"),
+        n);
+    {
+      auto const cached_offsets = _offsets;
+      Kokkos::parallel_for(
+          "ArborX::NearestQueryCache::count_results",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n + 1),
+          KOKKOS_LAMBDA(int i) {
+            if (i == n)
+            {
+              offsets(i) = 0;
+              return;
+            }
+            if (hits(i))
+            {
+              offsets(i) = cached_offsets(i + 1) - cached_offsets(i);
+              return;
+            }
+            int const m = miss_map(i);
+            offsets(i) = Kokkos::min(ks(i), miss_offset(m + 1) - miss_offset(m));
+          });
+    }
+    KokkosExt::exclusive_scan(space, offsets, offsets, 0);
+    int const n_results = KokkosExt::lastElement(space, offsets);
+
+    Kokkos::View<int *, MemorySpace> values(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::NearestQueryCache::values"),
+        n_results);
+    {
+      auto const cached_offsets = _offsets;
+      auto const cached_indices = _indices;
+      auto const cached_origins = _origins;
+      auto const cached_slack = _slack;
+      Kokkos::parallel_for(
+          "ArborX::NearestQueryCache::fill_results",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+          KOKKOS_LAMBDA(int i) {
+            int const begin = offsets(i);
+            int const count = offsets(i + 1) - begin;
+            if (hits(i))
+            {
+              for (int j = 0; j < count; ++j)
+                values(begin + j) = cached_indices(cached_offsets(i) + j);
+              origins(i) = cached_origins(i);
+              slack(i) = cached_slack(i);
+              return;
+            }
+            int const m = miss_map(i);
+            int const miss_begin = miss_offset(m);
+            int const miss_count = miss_offset(m + 1) - miss_begin;
+            for (int j = 0; j < count; ++j)
+              values(begin + j) = miss_results(miss_begin + j).index;
+            // The extra neighbor is only missing when the tree holds no more
+            // than k values, in which case the result set can never change
+            slack(i) =
+                (miss_count > count && count > 0)
+                    ? miss_results(miss_begin + count).distance -
+                          miss_results(miss_begin + count - 1).distance
+                    : KokkosExt::ArithmeticTraits::infinity<float>::value;
+          });
+    }
+
+    KokkosExt::reallocWithoutInitializing(space, offset, n + 1);
+    Kokkos::parallel_for(
+        "ArborX::NearestQueryCache::copy_offsets",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n + 1),
+        KOKKOS_LAMBDA(int i) { offset(i) = offsets(i); });
+    KokkosExt::reallocWithoutInitializing(space, indices, n_results);
+    Kokkos::parallel_for(
+        "ArborX::NearestQueryCache::copy_indices",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_results),
+        KOKKOS_LAMBDA(int i) { indices(i) = values(i); });
+
+    _n = n;
+    _tree_size = tree.size();
+    _tree_bounds = scene;
+    _cells = cells;
+    _origins = origins;
+    _ks = ks;
+    _slack = slack;
+    _offsets = offsets;
+    _indices = values;
+  }
+
+  // Drop the cached results, forcing the next query to traverse. Tree
+  // updates are detected through the size and the bounds, which can both
+  // stay put when values move within the scene; call this when updating
+  // the tree in place.
+  void invalidate()
+  {
+    _n = 0;
+    _tree_size = 0;
+  }
+
+private:
+  size_t _n = 0;
+  size_t _tree_size = 0;
+  Box _tree_bounds;
+  Kokkos::View<unsigned int *, MemorySpace> _cells;
+  Kokkos::View<Point *, MemorySpace> _origins;
+  Kokkos::View<int *, MemorySpace> _ks;
+  Kokkos::View<float *, MemorySpace> _slack;
+  Kokkos::View<int *, MemorySpace> _offsets;
+  Kokkos::View<int *, MemorySpace> _indices;
+};
+
+} // namespace Experimental
+} // namespace ArborX
+
+#endif
@@ -12,14 +12,23 @@
 #ifndef ARBORX_NEIGHBOR_LIST_HPP
 #define ARBORX_NEIGHBOR_LIST_HPP
 
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_DetailsAlgorithms.hpp> // distance
+#include <ArborX_DetailsCartesianGrid.hpp>
 #include <ArborX_DetailsHalfTraversal.hpp>
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
 #include <ArborX_DetailsKokkosExtViewHelpers.hpp> // reallocWithoutInitializing
+#include <ArborX_Exception.hpp>
 #include <ArborX_LinearBVH.hpp>
+#include <ArborX_PeriodicSphere.hpp>
 #include <ArborX_Sphere.hpp>
 
 #include <Kokkos_Core.hpp>
 
+#include <cmath>
+#include <limits>
+#include <vector>
+
 namespace ArborX::Experimental
 {
 
@@ -33,10 +42,33 @@ struct NeighborListPredicateGetter
   }
 };
 
-template <class ExecutionSpace, class Primitives, class Offsets, class Indices>
-void findHalfNeighborList(ExecutionSpace const &space,
-                          Primitives const &primitives, float radius,
-                          Offsets &offsets, Indices &indices)
+template <typename Coordinate>
+struct PeriodicNeighborListPredicateGetter
+{
+  float _radius;
+  PeriodicDomain<3, Coordinate> _domain;
+
+  KOKKOS_FUNCTION auto operator()(Box b) const
+  {
+    auto const &point = b.minCorner();
+    ExperimentalHyperGeometry::Point<3, Coordinate> hyper_point{
+        (Coordinate)point[0], (Coordinate)point[1], (Coordinate)point[2]};
+    return intersects(
+        PeriodicSphere<3, Coordinate>{hyper_point, _radius, _domain});
+  }
+};
+
+} // namespace ArborX::Experimental
+
+namespace ArborX::Details
+{
+
+template <class ExecutionSpace, class Primitives, class PredicateGetter,
+          class Offsets, class Indices>
+void findHalfNeighborListImpl(ExecutionSpace const &space,
+                              Primitives const &primitives,
+                              PredicateGetter const &getter, Offsets &offsets,
+                              Indices &indices)
 {
   Kokkos::Profiling::pushRegion("ArborX::Experimental::HalfNeighborList");
 
@@ -56,7 +88,7 @@ void findHalfNeighborList(ExecutionSpace const &space,
   HalfTraversal(
       space, bvh,
       KOKKOS_LAMBDA(int, int j) { Kokkos::atomic_increment(&offsets(j)); },
-      NeighborListPredicateGetter{radius});
+      getter);
   KokkosExt::exclusive_scan(space, offsets, offsets, 0);
   KokkosExt::reallocWithoutInitializing(space, indices,
                                         KokkosExt::lastElement(space, offsets));
@@ -72,16 +104,18 @@ void findHalfNeighborList(ExecutionSpace const &space,
       KOKKOS_LAMBDA(int i, int j) {
         indices(Kokkos::atomic_fetch_inc(&counts(j))) = i;
       },
-      NeighborListPredicateGetter{radius});
+      getter);
 
   Kokkos::Profiling::popRegion();
   Kokkos::Profiling::popRegion();
 }
 
-template <class ExecutionSpace, class Primitives, class Offsets, class Indices>
-void findFullNeighborList(ExecutionSpace const &space,
-                          Primitives const &primitives, float radius,
-                          Offsets &offsets, Indices &indices)
+template <class ExecutionSpace, class Primitives, class PredicateGetter,
+          class Offsets, class Indices>
+void findFullNeighborListImpl(ExecutionSpace const &space,
+                              Primitives const &primitives,
+                              PredicateGetter const &getter, Offsets &offsets,
+                              Indices &indices)
 {
   Kokkos::Profiling::pushRegion("ArborX::Experimental::FullNeighborList");
 
@@ -104,7 +138,7 @@ void findFullNeighborList(ExecutionSpace const &space,
         Kokkos::atomic_increment(&offsets(i));
         Kokkos::atomic_increment(&offsets(j));
       },
-      NeighborListPredicateGetter{radius});
+      getter);
   KokkosExt::exclusive_scan(space, offsets, offsets, 0);
   KokkosExt::reallocWithoutInitializing(space, indices,
                                         KokkosExt::lastElement(space, offsets));
@@ -120,7 +154,7 @@ void findFullNeighborList(ExecutionSpace const &space,
       KOKKOS_LAMBDA(int i, int j) {
         indices(Kokkos::atomic_fetch_inc(&counts(j))) = i;
       },
-      NeighborListPredicateGetter{radius});
+      getter);
 
   Kokkos::Profiling::popRegion();
   Kokkos::Profiling::pushRegion("ArborX::Experimental::FullNeighborList::Copy");
@@ -146,6 +180,998 @@ void findFullNeighborList(ExecutionSpace const &space,
   Kokkos::Profiling::popRegion();
 }
 
+// Sort every CSR row by increasing distance from its point. The rows of a
+// neighbor list are short, so a per-row insertion sort beats a segmented
+// sort machinery; the distances cost one evaluation per entry, which is
+// cheaper than threading them through the atomic scatter of the fill passes
+// (whose slot order is non-deterministic and would have to be sorted anyway).
+template <class ExecutionSpace, class Points, class Offsets, class Indices>
+void sortNeighborListByDistanceImpl(ExecutionSpace const &space,
+                                    Points const &points,
+                                    Offsets const &offsets,
+                                    Indices const &indices)
+{
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::Experimental::SortNeighborListByDistance");
+
+  using MemorySpace = typename Points::memory_space;
+
+  int const n = points.size();
+
+  Kokkos::View<float *, MemorySpace> distances(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::Experimental::SortNeighborListByDistance::"
+                         "distances"),
+      indices.size());
+  Kokkos::parallel_for(
+      "ArborX::Experimental::SortNeighborListByDistance::sort_rows",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        auto const point = points(i);
+        int const first = offsets(i);
+        int const last = offsets(i + 1);
+
+        for (int k = first; k < last; ++k)
+          distances(k) = distance(point, points(indices(k)));
+
+        for (int k = first + 1; k < last; ++k)
+        {
+          auto const d = distances(k);
+          auto const v = indices(k);
+          int l = k - 1;
+          while (l >= first && distances(l) > d)
+          {
+            distances(l + 1) = distances(l);
+            indices(l + 1) = indices(l);
+            --l;
+          }
+          distances(l + 1) = d;
+          indices(l + 1) = v;
+        }
+      });
+}
+
+template <class ExecutionSpace, class Primitives, class PredicateGetter,
+          class Neighbors, class Counts>
+bool findDenseNeighborListImpl(ExecutionSpace const &space,
+                               Primitives const &primitives,
+                               PredicateGetter const &getter,
+                               Neighbors const &neighbors, Counts const &counts)
+{
+  Kokkos::Profiling::pushRegion("ArborX::Experimental::DenseNeighborList");
+
+  using Details::HalfTraversal;
+
+  using MemorySpace =
+      typename AccessTraits<Primitives, PrimitivesTag>::memory_space;
+  BVH<MemorySpace> bvh(space, primitives);
+  int const n = bvh.size();
+
+  ARBORX_ASSERT((int)neighbors.extent(0) == n);
+  ARBORX_ASSERT((int)counts.extent(0) == n);
+
+  int const max_neighbors = neighbors.extent(1);
+
+  Kokkos::deep_copy(space, counts, 0);
+  HalfTraversal(
+      space, bvh,
+      KOKKOS_LAMBDA(int i, int j) {
+        auto const slot_i = Kokkos::atomic_fetch_inc(&counts(i));
+        if (slot_i < max_neighbors)
+          neighbors(i, slot_i) = j;
+        auto const slot_j = Kokkos::atomic_fetch_inc(&counts(j));
+        if (slot_j < max_neighbors)
+          neighbors(j, slot_j) = i;
+      },
+      getter);
+
+  int max_count = 0;
+  Kokkos::parallel_reduce(
+      "ArborX::Experimental::DenseNeighborList::check_overflow",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i, int &update) {
+        if (counts(i) > update)
+          update = counts(i);
+      },
+      Kokkos::Max<int>(max_count));
+
+  Kokkos::Profiling::popRegion();
+
+  return max_count <= max_neighbors;
+}
+
+// Cell-list engine for the full neighbor list. The points are binned into a
+// grid with cell size equal to the radius, so all neighbors of a point live
+// in the 3^d cells surrounding its own. On near-uniform densities (e.g.,
+// homogeneous liquids) this skips both the hierarchy construction and the
+// traversal and comes out well ahead of the BVH; the density-based dispatch
+// in Experimental::findFullNeighborList decides when to use it.
+template <class ExecutionSpace, class Points, class Offsets, class Indices>
+void findFullNeighborListCellList(
+    ExecutionSpace const &space, Points const &points, float radius,
+    CartesianGrid<GeometryTraits::dimension_v<typename Points::value_type>>
+        const &grid,
+    Offsets &offsets, Indices &indices)
+{
+  Kokkos::Profiling::pushRegion(
+      "ArborX::Experimental::FullNeighborList::CellList");
+
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+
+  using MemorySpace = typename Points::memory_space;
+  constexpr int dim = GeometryTraits::dimension_v<typename Points::value_type>;
+
+  int const n = points.size();
+
+  size_t num_cells = 1;
+  for (int d = 0; d < dim; ++d)
+    num_cells *= grid.extent(d);
+
+  Kokkos::Profiling::pushRegion(
+      "ArborX::Experimental::FullNeighborList::CellList::Bin");
+
+  Kokkos::View<size_t *, MemorySpace> point_cells(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::Experimental::FullNeighborList::point_cells"),
+      n);
+  Kokkos::View<int *, MemorySpace> cell_offsets(
+      Kokkos::view_alloc(space,
+                         "ArborX::Experimental::FullNeighborList::cell_offsets"),
+      num_cells + 1);
+  Kokkos::parallel_for(
+      "ArborX::Experimental::FullNeighborList::compute_cell_indices",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        auto const cell = grid.cellIndex(points(i));
+        point_cells(i) = cell;
+        Kokkos::atomic_increment(&cell_offsets(cell));
+      });
+  KokkosExt::exclusive_scan(space, cell_offsets, cell_offsets, 0);
+
+  auto cell_counts = KokkosExt::clone(
+      space, Kokkos::subview(cell_offsets, std::make_pair((size_t)0, num_cells)),
+      "ArborX::Experimental::FullNeighborList::cell_counts");
+  Kokkos::View<int *, MemorySpace> cell_points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::Experimental::FullNeighborList::cell_points"),
+      n);
+  Kokkos::parallel_for(
+      "ArborX::Experimental::FullNeighborList::bin_points",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        cell_points(Kokkos::atomic_fetch_inc(&cell_counts(point_cells(i)))) = i;
+      });
+
+  Kokkos::Profiling::popRegion();
+  Kokkos::Profiling::pushRegion(
+      "ArborX::Experimental::FullNeighborList::CellList::Count");
+
+  int num_shifts = 1;
+  for (int d = 0; d < dim; ++d)
+    num_shifts *= 3;
+
+  KokkosExt::reallocWithoutInitializing(space, offsets, n + 1);
+  Kokkos::parallel_for(
+      "ArborX::Experimental::FullNeighborList::count_neighbors",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        auto const point = points(i);
+
+        size_t idx = point_cells(i);
+        int ijk[dim];
+        for (int d = 0; d < dim; ++d)
+        {
+          ijk[d] = idx % grid.extent(d);
+          idx /= grid.extent(d);
+        }
+
+        int count = 0;
+        for (int s = 0; s < num_shifts; ++s)
+        {
+          int t = s;
+          size_t cell = 0;
+          bool valid = true;
+          for (int d = dim - 1; d >= 0; --d)
+          {
+            // The digits of s encode the shifts, dimension dim-1 first
+            int const c = ijk[d] + (t % 3) - 1;
+            t /= 3;
+            if (c < 0 || c >= (int)grid.extent(d))
+            {
+              valid = false;
+              break;
+            }
+            cell = cell * grid.extent(d) + c;
+          }
+          if (!valid)
+            continue;
+
+          for (int k = cell_offsets(cell); k < cell_offsets(cell + 1); ++k)
+          {
+            int const j = cell_points(k);
+            if (j != i && distance(point, points(j)) <= radius)
+              ++count;
+          }
+        }
+        offsets(i) = count;
+      });
+  KokkosExt::exclusive_scan(space, offsets, offsets, 0);
+  KokkosExt::reallocWithoutInitializing(space, indices,
+                                        KokkosExt::lastElement(space, offsets));
+
+  Kokkos::Profiling::popRegion();
+  Kokkos::Profiling::pushRegion(
+      "ArborX::Experimental::FullNeighborList::CellList::Fill");
+
+  Kokkos::parallel_for(
+      "ArborX::Experimental::FullNeighborList::fill_neighbors",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        auto const point = points(i);
+
+        size_t idx = point_cells(i);
+        int ijk[dim];
+        for (int d = 0; d < dim; ++d)
+        {
+          ijk[d] = idx % grid.extent(d);
+          idx /= grid.extent(d);
+        }
+
+        int out = offsets(i);
+        for (int s = 0; s < num_shifts; ++s)
+        {
+          int t = s;
+          size_t cell = 0;
+          bool valid = true;
+          for (int d = dim - 1; d >= 0; --d)
+          {
+            int const c = ijk[d] + (t % 3) - 1;
+            t /= 3;
+            if (c < 0 || c >= (int)grid.extent(d))
+            {
+              valid = false;
+              break;
+            }
+            cell = cell * grid.extent(d) + c;
+          }
+          if (!valid)
+            continue;
+
+          for (int k = cell_offsets(cell); k < cell_offsets(cell + 1); ++k)
+          {
+            int const j = cell_points(k);
+            if (j != i && distance(point, points(j)) <= radius)
+              indices(out++) = j;
+          }
+        }
+      });
+
+  Kokkos::Profiling::popRegion();
+  Kokkos::Profiling::popRegion();
+}
+
+// Assign a color to every entry of a half neighbor list so that no two
+// entries of the same color share a particle (edge coloring of the neighbor
+// graph). Each round finds a matching among the uncolored pairs: every pair
+// bids for both of its particles with an atomic min over the pair ids, and
+// the pairs that won both bids take the round's color. The pair with the
+// globally smallest id always wins, so every round makes progress and the
+// result does not depend on the execution order. Returns the number of
+// colors.
+template <class ExecutionSpace, class Offsets, class Indices, class Colors>
+int colorHalfNeighborList(ExecutionSpace const &space, Offsets const &offsets,
+                          Indices const &indices, Colors &colors)
+{
+  using MemorySpace = typename Colors::memory_space;
+
+  int const n = offsets.size() - 1;
+  int const num_pairs = indices.size();
+
+  // Recover the source particle of every entry
+  Kokkos::View<int *, MemorySpace> sources(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::Experimental::PairColoring::sources"),
+      num_pairs);
+  Kokkos::parallel_for(
+      "ArborX::Experimental::PairColoring::compute_sources",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int const i) {
+        for (int k = offsets(i); k < offsets(i + 1); ++k)
+          sources(k) = i;
+      });
+
+  KokkosExt::reallocWithoutInitializing(space, colors, num_pairs);
+  Kokkos::deep_copy(space, colors, -1);
+
+  Kokkos::View<int *, MemorySpace> bids(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::Experimental::PairColoring::bids"),
+      n);
+
+  int color = 0;
+  int num_uncolored = num_pairs;
+  while (num_uncolored > 0)
+  {
+    Kokkos::deep_copy(space, bids, INT_MAX);
+    Kokkos::parallel_for(
+        "ArborX::Experimental::PairColoring::bid",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_pairs),
+        KOKKOS_LAMBDA(int const e) {
+          if (colors(e) >= 0)
+            return;
+          Kokkos::atomic_min(&bids(sources(e)), e);
+          Kokkos::atomic_min(&bids(indices(e)), e);
+        });
+    Kokkos::parallel_reduce(
+        "ArborX::Experimental::PairColoring::assign_color",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_pairs),
+        KOKKOS_LAMBDA(int const e, int &update) {
+          if (colors(e) >= 0)
+            return;
+          if (bids(sources(e)) == e && bids(indices(e)) == e)
+            colors(e) = color;
+          else
+            ++update;
+        },
+        num_uncolored);
+    ++color;
+  }
+
+  return color;
+}
+
+// Predicates for re-querying only the particles of a Verlet list that moved
+// beyond the staleness threshold: one skin-padded sphere per moved particle,
+// with the particle id attached
+template <typename Points>
+struct VerletListMovedPredicates
+{
+  Points _points;
+  Kokkos::View<int *, typename Points::memory_space> _moved;
+  float _radius;
+};
+
+struct NeighborListExcludeSelfCallback
+{
+  template <class Predicate, class OutputFunctor>
+  KOKKOS_FUNCTION void operator()(Predicate const &predicate, int j,
+                                  OutputFunctor const &out) const
+  {
+    if (j != getData(predicate))
+      out(j);
+  }
+};
+
+} // namespace ArborX::Details
+
+template <typename Points>
+struct ArborX::AccessTraits<ArborX::Details::VerletListMovedPredicates<Points>,
+                            ArborX::PredicatesTag>
+{
+  using Self = ArborX::Details::VerletListMovedPredicates<Points>;
+  using memory_space = typename Points::memory_space;
+
+  static KOKKOS_FUNCTION auto size(Self const &x) { return x._moved.size(); }
+  static KOKKOS_FUNCTION auto get(Self const &x, int i)
+  {
+    int const p = x._moved(i);
+    return attach(intersects(Sphere{x._points(p), x._radius}), p);
+  }
+};
+
+namespace ArborX::Experimental
+{
+
+enum class NeighborListSorting
+{
+  None,
+  ByDistance
+};
+
+// Sort every row of a CSR neighbor list by increasing distance from its
+// point, for kernels that iterate neighbors near-to-far (smoothing kernels,
+// cutoff blending). Works on the output of any of the list builders.
+template <class ExecutionSpace, class Primitives, class Offsets, class Indices>
+void sortNeighborListByDistance(ExecutionSpace const &space,
+                                Primitives const &primitives,
+                                Offsets const &offsets, Indices const &indices)
+{
+  using Points = Details::AccessValues<Primitives, PrimitivesTag>;
+  static_assert(GeometryTraits::is_point<typename Points::value_type>{},
+                "sorting neighbor lists by distance requires point primitives");
+  Details::sortNeighborListByDistanceImpl(space, Points{primitives}, offsets,
+                                          indices);
+}
+
+// Invoke callback(i, j) exactly once for every unordered pair of points
+// matching the predicate getter, fused into the tree traversal: nothing is
+// materialized, so self-interaction kernels (e.g., force computations) can
+// accumulate their results directly without ever allocating a CSR list.
+// Which of the two orders a pair is seen in is unspecified, and different
+// pairs are processed concurrently — accumulation into per-point data has to
+// use atomics.
+//
+// The predicate getter maps the bounding volume of a leaf to the search
+// predicate issued for it, which allows e.g. periodic distances
+// (PeriodicNeighborListPredicateGetter) or per-point radii.
+template <class ExecutionSpace, class Primitives, class Callback,
+          class PredicateGetter>
+void forEachPair(ExecutionSpace const &space, Primitives const &primitives,
+                 Callback const &callback, PredicateGetter const &getter)
+{
+  Kokkos::Profiling::ScopedRegion guard("ArborX::Experimental::ForEachPair");
+
+  using MemorySpace =
+      typename AccessTraits<Primitives, PrimitivesTag>::memory_space;
+  BVH<MemorySpace> bvh(space, primitives);
+  Details::HalfTraversal(space, bvh, callback, getter);
+}
+
+// Common case: all pairs of points within the radius of each other (never a
+// point with itself)
+template <class ExecutionSpace, class Primitives, class Callback>
+void forEachPair(ExecutionSpace const &space, Primitives const &primitives,
+                 float radius, Callback const &callback)
+{
+  forEachPair(space, primitives, callback, NeighborListPredicateGetter{radius});
+}
+
+// Half neighbor list in CSR form (offsets/indices): every pair of points
+// within the radius appears exactly once, in the row of one of its two
+// endpoints. This is the natural input for kernels that exploit Newton's
+// third law — accumulating a pair interaction into both endpoints at once —
+// and carries half the memory and fill traffic of the full list. Consumers
+// that do need both directions can post-process with
+// Details::expandHalfToFull. The order of the indices within a row is
+// unspecified.
+template <class ExecutionSpace, class Primitives, class Offsets, class Indices>
+void findHalfNeighborList(ExecutionSpace const &space,
+                          Primitives const &primitives, float radius,
+                          Offsets &offsets, Indices &indices)
+{
+  Details::findHalfNeighborListImpl(
+      space, primitives, NeighborListPredicateGetter{radius}, offsets, indices);
+}
+
+// Half neighbor list in a periodic domain: pair distances follow the
+// minimum-image convention across the periodic dimensions
+template <class ExecutionSpace, class Primitives, class Offsets, class Indices,
+          typename Coordinate>
+void findHalfNeighborList(ExecutionSpace const &space,
+                          Primitives const &primitives, float radius,
+                          PeriodicDomain<3, Coordinate> const &domain,
+                          Offsets &offsets, Indices &indices)
+{
+  Details::findHalfNeighborListImpl(
+      space, primitives,
+      PeriodicNeighborListPredicateGetter<Coordinate>{radius, domain}, offsets,
+      indices);
+}
+
+// Full neighbor list in CSR form: row i holds all points within the radius
+// of point i (excluding i itself), so every pair appears in both of its
+// rows. The order of the indices within a row is unspecified unless
+// NeighborListSorting::ByDistance is requested, in which case each row is
+// emitted in increasing distance from its point.
+template <class ExecutionSpace, class Primitives, class Offsets, class Indices>
+void findFullNeighborList(
+    ExecutionSpace const &space, Primitives const &primitives, float radius,
+    Offsets &offsets, Indices &indices,
+    NeighborListSorting sorting = NeighborListSorting::None)
+{
+  using Points = Details::AccessValues<Primitives, PrimitivesTag>;
+  using Point = typename Points::value_type;
+
+  if constexpr (GeometryTraits::is_point<Point>{})
+  {
+    Points points{primitives};
+    int const n = points.size();
+    constexpr int dim = GeometryTraits::dimension_v<Point>;
+    using Box = ExperimentalHyperGeometry::Box<dim>;
+
+    if (n > 0)
+    {
+      Box bounds;
+      Details::TreeConstruction::calculateBoundingBoxOfTheScene(
+          space,
+          Details::Indexables<Points, Details::DefaultIndexableGetter>{
+              points, Details::DefaultIndexableGetter{}},
+          bounds);
+
+      auto const &min_corner = bounds.minCorner();
+      auto const &max_corner = bounds.maxCorner();
+      double num_cells = 1;
+      bool grid_usable = true;
+      for (int d = 0; d < dim; ++d)
+      {
+        num_cells *= std::max(
+            1., std::ceil((max_corner[d] - min_corner[d]) / (double)radius));
+        // Mirror the precision guard of CartesianGrid so that the automatic
+        // selection never throws on inputs the BVH handles fine
+        if (std::abs(radius / min_corner[d]) <
+            5 * std::numeric_limits<float>::epsilon())
+          grid_usable = false;
+      }
+
+      // With the cell size equal to the radius, near-uniform data fills the
+      // grid with at least one point per cell on average. Only then does the
+      // cell list beat the tree (and its memory stays bounded by the number
+      // of points); sparse or strongly clustered data keeps the BVH.
+      if (grid_usable && num_cells <= (double)n)
+      {
+        Details::CartesianGrid<dim> const grid(bounds, radius);
+        Details::findFullNeighborListCellList(space, points, radius, grid,
+                                              offsets, indices);
+        if (sorting == NeighborListSorting::ByDistance)
+          Details::sortNeighborListByDistanceImpl(space, points, offsets,
+                                                  indices);
+        return;
+      }
+    }
+  }
+
+  Details::findFullNeighborListImpl(
+      space, primitives, NeighborListPredicateGetter{radius}, offsets, indices);
+
+  if constexpr (GeometryTraits::is_point<Point>{})
+  {
+    if (sorting == NeighborListSorting::ByDistance)
+      sortNeighborListByDistance(space, primitives, offsets, indices);
+  }
+}
+
+// Full neighbor list in a periodic domain (see above)
+template <class ExecutionSpace, class Primitives, class Offsets, class Indices,
+          typename Coordinate>
+void findFullNeighborList(ExecutionSpace const &space,
+                          Primitives const &primitives, float radius,
+                          PeriodicDomain<3, Coordinate> const &domain,
+                          Offsets &offsets, Indices &indices)
+{
+  Details::findFullNeighborListImpl(
+      space, primitives,
+      PeriodicNeighborListPredicateGetter<Coordinate>{radius, domain}, offsets,
+      indices);
+}
+
+// Build several full neighbor lists, one per radius, in a single pass: the
+// tree is walked at the largest radius only, and every found pair is
+// classified into all the radii it satisfies, so the additional radii cost
+// one comparison against the already computed distance instead of another
+// tree walk. Typical use: short- and long-range cutoff sets over the same
+// points. The output vectors are resized to the number of radii, and every
+// list follows the findFullNeighborList CSR contract (unsorted rows).
+template <class ExecutionSpace, class Primitives, class Offsets, class Indices>
+void findFullNeighborLists(ExecutionSpace const &space,
+                           Primitives const &primitives,
+                           std::vector<float> const &radii,
+                           std::vector<Offsets> &offsets,
+                           std::vector<Indices> &indices)
+{
+  Kokkos::Profiling::pushRegion("ArborX::Experimental::FullNeighborLists");
+
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+
+  // The radii are passed to the device kernels by value
+  constexpr int max_radii = 8;
+  int const num_radii = radii.size();
+  ARBORX_ASSERT(num_radii >= 1 && num_radii <= max_radii);
+
+  Kokkos::Array<float, max_radii> radii_arr{};
+  float max_radius = 0;
+  for (int r = 0; r < num_radii; ++r)
+  {
+    ARBORX_ASSERT(radii[r] > 0);
+    radii_arr[r] = radii[r];
+    max_radius = std::max(max_radius, radii[r]);
+  }
+
+  offsets.resize(num_radii);
+  indices.resize(num_radii);
+
+  using Points = Details::AccessValues<Primitives, PrimitivesTag>;
+  static_assert(GeometryTraits::is_point<typename Points::value_type>{},
+                "multi-radius neighbor lists require point primitives");
+  Points points{primitives};
+  using MemorySpace = typename Points::memory_space;
+
+  BVH<MemorySpace> bvh(space, primitives);
+  int const n = bvh.size();
+
+  Kokkos::Profiling::pushRegion(
+      "ArborX::Experimental::FullNeighborLists::Count");
+
+  Kokkos::View<int **, MemorySpace> counts(
+      Kokkos::view_alloc(space,
+                         "ArborX::Experimental::FullNeighborLists::counts"),
+      num_radii, n);
+  Details::HalfTraversal(
+      space, bvh,
+      KOKKOS_LAMBDA(int i, int j) {
+        auto const d = Details::distance(points(i), points(j));
+        for (int r = 0; r < num_radii; ++r)
+          if (d <= radii_arr[r])
+          {
+            Kokkos::atomic_increment(&counts(r, i));
+            Kokkos::atomic_increment(&counts(r, j));
+          }
+      },
+      NeighborListPredicateGetter{max_radius});
+
+  Kokkos::Array<int *, max_radii> indices_ptrs{};
+  for (int r = 0; r < num_radii; ++r)
+  {
+    auto &offsets_r = offsets[r];
+    KokkosExt::reallocWithoutInitializing(space, offsets_r, n + 1);
+    auto counts_r = Kokkos::subview(counts, r, Kokkos::ALL());
+    Kokkos::parallel_for(
+        "ArborX::Experimental::FullNeighborLists::copy_counts",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n + 1),
+        KOKKOS_LAMBDA(int i) { offsets_r(i) = (i < n ? counts_r(i) : 0); });
+    KokkosExt::exclusive_scan(space, offsets_r, offsets_r, 0);
+    KokkosExt::reallocWithoutInitializing(
+        space, indices[r], KokkosExt::lastElement(space, offsets_r));
+    indices_ptrs[r] = indices[r].data();
+
+    // Reuse the counts as the write cursors of the fill pass
+    Kokkos::parallel_for(
+        "ArborX::Experimental::FullNeighborLists::reset_cursors",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int i) { counts_r(i) = offsets_r(i); });
+  }
+
+  Kokkos::Profiling::popRegion();
+  Kokkos::Profiling::pushRegion(
+      "ArborX::Experimental::FullNeighborLists::Fill");
+
+  Details::HalfTraversal(
+      space, bvh,
+      KOKKOS_LAMBDA(int i, int j) {
+        auto const d = Details::distance(points(i), points(j));
+        for (int r = 0; r < num_radii; ++r)
+          if (d <= radii_arr[r])
+          {
+            indices_ptrs[r][Kokkos::atomic_fetch_inc(&counts(r, i))] = j;
+            indices_ptrs[r][Kokkos::atomic_fetch_inc(&counts(r, j))] = i;
+          }
+      },
+      NeighborListPredicateGetter{max_radius});
+
+  Kokkos::Profiling::popRegion();
+  Kokkos::Profiling::popRegion();
+}
+
+// Full neighbor list in a dense (n, max_neighbors) layout, for force fields
+// that cap the number of neighbors per point: the known capacity makes the
+// counting pass unnecessary, so the list is filled in a single tree walk and
+// lands in the row-per-point layout vectorized force kernels consume
+// directly. Row i holds counts(i) neighbors of point i, in unspecified
+// order. Returns false if some point exceeded the capacity; the excess
+// neighbors of the affected rows are dropped, but counts still holds the
+// true degrees, so the caller can reallocate to the maximum count and call
+// again.
+template <class ExecutionSpace, class Primitives, class Neighbors,
+          class Counts>
+bool findDenseNeighborList(ExecutionSpace const &space,
+                           Primitives const &primitives, float radius,
+                           Neighbors const &neighbors, Counts const &counts)
+{
+  return Details::findDenseNeighborListImpl(
+      space, primitives, NeighborListPredicateGetter{radius}, neighbors,
+      counts);
+}
+
+// Partition the pairs of a half neighbor list into conflict-free batches: no
+// two pairs within a batch share a particle, so a force accumulation may
+// process one batch at a time with plain stores instead of atomics (the same
+// particle is touched at most once per batch). batch_offsets gets resized to
+// the number of batches plus one, and batch_pairs to (num_pairs, 2); the
+// pairs of batch b occupy the rows [batch_offsets(b), batch_offsets(b + 1)).
+template <class ExecutionSpace, class Offsets, class Indices,
+          class BatchOffsets, class BatchPairs>
+void computeNeighborListPairBatches(ExecutionSpace const &space,
+                                    Offsets const &offsets,
+                                    Indices const &indices,
+                                    BatchOffsets &batch_offsets,
+                                    BatchPairs &batch_pairs)
+{
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::Experimental::PairColoring::compute_batches");
+
+  using MemorySpace = typename BatchPairs::memory_space;
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+
+  int const n = offsets.size() - 1;
+  int const num_pairs = indices.size();
+
+  Kokkos::View<int *, MemorySpace> colors(
+      "ArborX::Experimental::PairColoring::colors", 0);
+  int const num_batches =
+      Details::colorHalfNeighborList(space, offsets, indices, colors);
+
+  KokkosExt::reallocWithoutInitializing(space, batch_offsets, num_batches + 1);
+  Kokkos::deep_copy(space, batch_offsets, 0);
+  Kokkos::parallel_for(
+      "ArborX::Experimental::PairColoring::count_batch_sizes",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_pairs),
+      KOKKOS_LAMBDA(int const e) {
+        Kokkos::atomic_increment(&batch_offsets(colors(e)));
+      });
+  KokkosExt::exclusive_scan(space, batch_offsets, batch_offsets, 0);
+
+  auto cursors = KokkosExt::clone(
+      space, batch_offsets, "ArborX::Experimental::PairColoring::cursors");
+  KokkosExt::reallocWithoutInitializing(space, batch_pairs, num_pairs);
+  Kokkos::parallel_for(
+      "ArborX::Experimental::PairColoring::fill_batches",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int const i) {
+        for (int k = offsets(i); k < offsets(i + 1); ++k)
+        {
+          auto const slot = Kokkos::atomic_fetch_inc(&cursors(colors(k)));
+          batch_pairs(slot, 0) = i;
+          batch_pairs(slot, 1) = indices(k);
+        }
+      });
+}
+
+// Verlet list: a full neighbor list built at radius + skin and reused across
+// steps of a simulation. As long as no particle has moved further than half
+// the skin since the last build, any pair currently within the radius was
+// already within radius + skin at build time, so the list is still a
+// superset of the true neighbors and only needs rebuilding once
+// needsRebuild() returns true. Note that the stored list may contain pairs
+// whose current distance exceeds the radius; consumers are expected to check
+// the distance when iterating, as is customary in molecular dynamics.
+template <typename MemorySpace, typename Point = ArborX::Point>
+struct VerletList
+{
+  using memory_space = MemorySpace;
+
+  Kokkos::View<int *, MemorySpace> offsets;
+  Kokkos::View<int *, MemorySpace> indices;
+
+  float _radius;
+  float _skin;
+  Kokkos::View<Point *, MemorySpace> _reference_points;
+
+  template <typename ExecutionSpace, typename Primitives>
+  VerletList(ExecutionSpace const &space, Primitives const &primitives,
+             float radius, float skin)
+      : offsets("ArborX::VerletList::offsets", 0)
+      , indices("ArborX::VerletList::indices", 0)
+      , _radius(radius)
+      , _skin(skin)
+      , _reference_points("ArborX::VerletList::reference_points", 0)
+  {
+    ARBORX_ASSERT(radius > 0);
+    ARBORX_ASSERT(skin >= 0);
+    rebuild(space, primitives);
+  }
+
+  template <typename ExecutionSpace, typename Primitives>
+  void rebuild(ExecutionSpace const &space, Primitives const &primitives)
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::VerletList::rebuild");
+
+    findFullNeighborList(space, primitives, _radius + _skin, offsets, indices);
+
+    // Snapshot the positions the list was built at
+    using Access = AccessTraits<Primitives, PrimitivesTag>;
+    int const n = Access::size(primitives);
+    Details::KokkosExt::reallocWithoutInitializing(space, _reference_points,
+                                                   n);
+    auto reference_points = _reference_points;
+    Kokkos::parallel_for(
+        "ArborX::VerletList::snapshot_positions",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int const i) {
+          reference_points(i) = Access::get(primitives, i);
+        });
+  }
+
+  // The list is stale once some particle has moved more than half the skin
+  // since the last rebuild: only then can a pair have entered the radius
+  // without having been within radius + skin at build time
+  template <typename ExecutionSpace, typename Primitives>
+  bool needsRebuild(ExecutionSpace const &space,
+                    Primitives const &primitives) const
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::VerletList::needs_rebuild");
+
+    using Access = AccessTraits<Primitives, PrimitivesTag>;
+    int const n = Access::size(primitives);
+    if (n != (int)_reference_points.size())
+      return true;
+
+    auto reference_points = _reference_points;
+    float max_displacement;
+    Kokkos::parallel_reduce(
+        "ArborX::VerletList::max_displacement",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int const i, float &update) {
+          auto const d =
+              Details::distance(Access::get(primitives, i), reference_points(i));
+          if (d > update)
+            update = d;
+        },
+        Kokkos::Max<float>(max_displacement));
+
+    return max_displacement > _skin / 2;
+  }
+
+  // Rebuild if needed; returns whether the list was rebuilt
+  template <typename ExecutionSpace, typename Primitives>
+  bool update(ExecutionSpace const &space, Primitives const &primitives)
+  {
+    if (!needsRebuild(space, primitives))
+      return false;
+    rebuild(space, primitives);
+    return true;
+  }
+
+  // Delta update for low-churn steps: only the particles that moved beyond
+  // half the skin are re-queried (at radius + skin, against the current
+  // positions), and the CSR structure is reassembled by copying the rows
+  // that did not change — the traversal cost scales with the churn, and the
+  // assembly is a linear copy of the list. The references of the re-queried
+  // particles are advanced to their current positions, so the unmoved ones
+  // keep their remaining half-skin headroom. Falls back on a full rebuild
+  // when the churn is large enough that patching stops paying off. Returns
+  // the number of particles that were re-queried (0 leaves the list
+  // untouched).
+  template <typename ExecutionSpace, typename Primitives>
+  int deltaUpdate(ExecutionSpace const &space, Primitives const &primitives)
+  {
+    Kokkos::Profiling::ScopedRegion guard("ArborX::VerletList::delta_update");
+
+    namespace KokkosExt = ArborX::Details::KokkosExt;
+
+    using Access = AccessTraits<Primitives, PrimitivesTag>;
+    int const n = Access::size(primitives);
+    if (n != (int)_reference_points.size())
+    {
+      rebuild(space, primitives);
+      return n;
+    }
+
+    auto reference_points = _reference_points;
+    float const threshold = _skin / 2;
+
+    Kokkos::View<char *, MemorySpace> moved_flags(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::VerletList::moved_flags"),
+        n);
+    Kokkos::View<int *, MemorySpace> moved(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::VerletList::moved"),
+        n);
+    int num_moved;
+    Kokkos::parallel_scan(
+        "ArborX::VerletList::find_moved_particles",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int const i, int &update_, bool final_pass) {
+          bool const is_moved =
+              Details::distance(Access::get(primitives, i),
+                                reference_points(i)) > threshold;
+          if (final_pass)
+          {
+            moved_flags(i) = is_moved;
+            if (is_moved)
+              moved(update_) = i;
+          }
+          if (is_moved)
+            ++update_;
+        },
+        num_moved);
+
+    if (num_moved == 0)
+      return 0;
+    if (num_moved > n / 4)
+    {
+      // Patching would copy the whole list anyway; the full rebuild is
+      // cheaper once a sizable fraction of the particles moved
+      rebuild(space, primitives);
+      return num_moved;
+    }
+
+    // Fresh tree over the current positions: the build is linear and cheap
+    // next to a full list fill, and only the movers are queried against it
+    using Points = Details::AccessValues<Primitives, PrimitivesTag>;
+    Points points{primitives};
+    BVH<MemorySpace> bvh(space, primitives);
+
+    Kokkos::View<int *, MemorySpace> new_offsets(
+        "ArborX::VerletList::new_offsets", 0);
+    Kokkos::View<int *, MemorySpace> new_indices(
+        "ArborX::VerletList::new_indices", 0);
+    auto moved_front =
+        Kokkos::subview(moved, std::make_pair(0, num_moved));
+    bvh.query(space,
+              Details::VerletListMovedPredicates<Points>{
+                  points, moved_front, _radius + _skin},
+              Details::NeighborListExcludeSelfCallback{}, new_indices,
+              new_offsets);
+
+    // Assemble the patched list: unmoved rows keep their entries that do not
+    // point at a mover; the movers get their freshly queried rows, mirrored
+    // into the rows of their unmoved partners
+    auto const old_offsets = offsets;
+    auto const old_indices = indices;
+    Kokkos::View<int *, MemorySpace> patched_offsets(
+        Kokkos::view_alloc(space, "ArborX::VerletList::patched_offsets"),
+        n + 1);
+    Kokkos::parallel_for(
+        "ArborX::VerletList::count_kept_entries",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int const i) {
+          if (moved_flags(i))
+            return;
+          int count = 0;
+          for (int k = old_offsets(i); k < old_offsets(i + 1); ++k)
+            if (!moved_flags(old_indices(k)))
+              ++count;
+          patched_offsets(i) = count;
+        });
+    Kokkos::parallel_for(
+        "ArborX::VerletList::count_new_entries",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_moved),
+        KOKKOS_LAMBDA(int const k) {
+          int const m = moved(k);
+          patched_offsets(m) = new_offsets(k + 1) - new_offsets(k);
+          for (int e = new_offsets(k); e < new_offsets(k + 1); ++e)
+          {
+            int const j = new_indices(e);
+            if (!moved_flags(j))
+              Kokkos::atomic_increment(&patched_offsets(j));
+          }
+        });
+    KokkosExt::exclusive_scan(space, patched_offsets, patched_offsets, 0);
+
+    Kokkos::View<int *, MemorySpace> patched_indices(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::VerletList::patched_indices"),
+        KokkosExt::lastElement(space, patched_offsets));
+    auto cursors = KokkosExt::clone(
+        space, Kokkos::subview(patched_offsets, std::make_pair(0, n)),
+        "ArborX::VerletList::cursors");
+    Kokkos::parallel_for(
+        "ArborX::VerletList::copy_kept_entries",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+        KOKKOS_LAMBDA(int const i) {
+          if (moved_flags(i))
+            return;
+          for (int k = old_offsets(i); k < old_offsets(i + 1); ++k)
+          {
+            int const j = old_indices(k);
+            if (!moved_flags(j))
+              patched_indices(Kokkos::atomic_fetch_inc(&cursors(i))) = j;
+          }
+        });
+    Kokkos::parallel_for(
+        "ArborX::VerletList::write_new_entries",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_moved),
+        KOKKOS_LAMBDA(int const k) {
+          int const m = moved(k);
+          for (int e = new_offsets(k); e < new_offsets(k + 1); ++e)
+          {
+            int const j = new_indices(e);
+            patched_indices(Kokkos::atomic_fetch_inc(&cursors(m))) = j;
+            if (!moved_flags(j))
+              patched_indices(Kokkos::atomic_fetch_inc(&cursors(j))) = m;
+          }
+        });
+
+    offsets = patched_offsets;
+    indices = patched_indices;
+
+    Kokkos::parallel_for(
+        "ArborX::VerletList::advance_references",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_moved),
+        KOKKOS_LAMBDA(int const k) {
+          int const m = moved(k);
+          reference_points(m) = Access::get(primitives, m);
+        });
+
+    return num_moved;
+  }
+};
+
 } // namespace ArborX::Experimental
 
 #endif
@@ -31,6 +31,29 @@ struct PairValueIndex
   Index index;
 };
 
+namespace Details
+{
+template <typename T>
+struct is_pair_value_index : std::false_type
+{};
+
+template <typename Value, typename Index>
+struct is_pair_value_index<PairValueIndex<Value, Index>> : std::true_type
+{};
+
+template <typename T>
+struct pair_value_index_type
+{
+  using type = unsigned;
+};
+
+template <typename Value, typename Index>
+struct pair_value_index_type<PairValueIndex<Value, Index>>
+{
+  using type = Index;
+};
+} // namespace Details
+
 namespace Experimental
 {
 template <typename Values, typename Index>
@@ -12,6 +12,7 @@
 #define ARBORX_PREDICATE_HPP
 
 #include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
 
 namespace ArborX
 {
@@ -62,10 +63,67 @@ struct Nearest
     return distance(_geometry, other);
   }
 
+  template <class OtherGeometry>
+  KOKKOS_FUNCTION auto distanceSquared(OtherGeometry const &other) const
+  {
+    using Details::distanceSquared;
+    return distanceSquared(_geometry, other);
+  }
+
   Geometry _geometry;
   int _k = 0;
 };
 
+// Nearest predicate with the number of neighbors fixed at compile time. The
+// traversal detects static_k and keeps the candidate set in a small sorted
+// array in registers instead of a heap over a runtime-sized global buffer,
+// which is a substantial win for the common k <= 8 case.
+template <typename Geometry, int K>
+struct NearestK
+{
+  static_assert(K > 0);
+
+  using Tag = Details::NearestPredicateTag;
+
+  static constexpr int static_k = K;
+
+  KOKKOS_DEFAULTED_FUNCTION
+  NearestK() = default;
+
+  KOKKOS_FUNCTION
+  NearestK(Geometry const &geometry)
+      : _geometry(geometry)
+  {}
+
+  template <class OtherGeometry>
+  KOKKOS_FUNCTION auto distance(OtherGeometry const &other) const
+  {
+    using Details::distance;
+    return distance(_geometry, other);
+  }
+
+  template <class OtherGeometry>
+  KOKKOS_FUNCTION auto distanceSquared(OtherGeometry const &other) const
+  {
+    using Details::distanceSquared;
+    return distanceSquared(_geometry, other);
+  }
+
+  Geometry _geometry;
+};
+
+namespace Details
+{
+template <typename Predicate, typename = void>
+struct has_static_k : std::false_type
+{};
+
+template <typename Predicate>
+struct has_static_k<Predicate, std::void_t<decltype(Predicate::static_k)>>
+    : std::true_type
+{};
+} // namespace Details
+
 template <typename Geometry>
 struct Intersects
 {
@@ -120,6 +178,13 @@ KOKKOS_INLINE_FUNCTION Nearest<Geometry> nearest(Geometry const &geometry,
   return Nearest<Geometry>(geometry, k);
 }
 
+// nearest<4>(geometry) — k fixed at compile time, see NearestK
+template <int K, typename Geometry>
+KOKKOS_INLINE_FUNCTION NearestK<Geometry, K> nearest(Geometry const &geometry)
+{
+  return NearestK<Geometry, K>(geometry);
+}
+
 template <typename Geometry>
 KOKKOS_INLINE_FUNCTION Intersects<Geometry> intersects(Geometry const &geometry)
 {
@@ -132,6 +197,12 @@ KOKKOS_INLINE_FUNCTION int getK(Nearest<Geometry> const &pred)
   return pred._k;
 }
 
+template <typename Geometry, int K>
+KOKKOS_INLINE_FUNCTION constexpr int getK(NearestK<Geometry, K> const &)
+{
+  return K;
+}
+
 namespace Experimental
 {
 template <typename Geometry>
@@ -149,6 +220,13 @@ getGeometry(Nearest<Geometry> const &pred)
   return pred._geometry;
 }
 
+template <typename Geometry, int K>
+KOKKOS_INLINE_FUNCTION Geometry const &
+getGeometry(NearestK<Geometry, K> const &pred)
+{
+  return pred._geometry;
+}
+
 template <typename Geometry>
 KOKKOS_INLINE_FUNCTION Geometry const &
 getGeometry(Intersects<Geometry> const &pred)
@@ -200,6 +278,120 @@ KOKKOS_INLINE_FUNCTION constexpr auto attach(Predicate &&pred, Data &&data)
       std::forward<Predicate>(pred), std::forward<Data>(data)};
 }
 
+// Nearest predicate decorated with an upper bound on the distance to its
+// k-th neighbor. The traversal starts pruning from the bound instead of from
+// infinity and never reports a neighbor at or beyond it, so the bound acts
+// both as a culling seed (when a valid estimate is available up front, e.g.,
+// from the first round of a distributed nearest search) and as a hard
+// cutoff (see nearest(geometry, k, max_radius)).
+template <typename Predicate>
+struct BoundedNearest : Predicate
+{
+  KOKKOS_DEFAULTED_FUNCTION BoundedNearest() = default;
+  KOKKOS_INLINE_FUNCTION BoundedNearest(Predicate const &pred, float bound)
+      : Predicate{pred}
+      , _bound{bound}
+  {}
+  float _bound =
+      Details::KokkosExt::ArithmeticTraits::infinity<float>::value;
+};
+
+template <typename Predicate>
+KOKKOS_INLINE_FUNCTION float getBound(BoundedNearest<Predicate> const &pred)
+{
+  return pred._bound;
+}
+
+template <typename Predicate>
+KOKKOS_INLINE_FUNCTION float getBound(Predicate const &)
+{
+  return Details::KokkosExt::ArithmeticTraits::infinity<float>::value;
+}
+
+namespace Experimental
+{
+// Approximate-nearest decorator: trades accuracy for traversal time. eps
+// relaxes the pruning test -- a subtree is only entered when it could hold
+// a candidate more than (1 + eps) times closer than the current k-th best,
+// so each reported neighbor is within a factor (1 + eps) in distance of
+// the exact neighbor of its rank. visit_budget caps the nodes visited per
+// query; when it runs out, the best candidates found so far are reported
+// with no quality guarantee. queryInstrumented honors the same knobs, so
+// budget exhaustion shows up there as node-visit counters pinned near the
+// budget while cheaper queries finish well below it.
+template <typename Predicate>
+struct ApproximateNearest : Predicate
+{
+  KOKKOS_DEFAULTED_FUNCTION ApproximateNearest() = default;
+  KOKKOS_INLINE_FUNCTION ApproximateNearest(Predicate const &pred, float eps,
+                                            int visit_budget)
+      : Predicate{pred}
+      , _slack{(1 + eps) * (1 + eps)}
+      , _budget{visit_budget}
+  {}
+  // Multiplies squared distances in the subtree pruning test
+  float _slack = 1.f;
+  int _budget = Details::KokkosExt::ArithmeticTraits::finite_max<int>::value;
+};
+
+template <typename Predicate>
+KOKKOS_INLINE_FUNCTION auto approximate_nearest(
+    Predicate const &pred, float eps,
+    int visit_budget =
+        Details::KokkosExt::ArithmeticTraits::finite_max<int>::value)
+{
+  static_assert(
+      std::is_same_v<typename Predicate::Tag, Details::NearestPredicateTag>);
+  return ApproximateNearest<Predicate>(pred, eps, visit_budget);
+}
+} // namespace Experimental
+
+template <typename Predicate>
+KOKKOS_INLINE_FUNCTION float
+getSlack(Experimental::ApproximateNearest<Predicate> const &pred)
+{
+  return pred._slack;
+}
+
+template <typename Predicate>
+KOKKOS_INLINE_FUNCTION float getSlack(Predicate const &)
+{
+  return 1.f;
+}
+
+template <typename Predicate>
+KOKKOS_INLINE_FUNCTION int
+getVisitBudget(Experimental::ApproximateNearest<Predicate> const &pred)
+{
+  return pred._budget;
+}
+
+template <typename Predicate>
+KOKKOS_INLINE_FUNCTION int getVisitBudget(Predicate const &)
+{
+  return Details::KokkosExt::ArithmeticTraits::finite_max<int>::value;
+}
+
+// Radius-bounded k-nearest: up to k neighbors, none at distance max_radius
+// or beyond. Sparse regions profit the most: the traversal culls with the
+// cutoff from the first node on instead of discovering it after k hits,
+// and effort spent finding distant neighbors the application would discard
+// is not paid in the first place.
+template <typename Geometry>
+KOKKOS_INLINE_FUNCTION BoundedNearest<Nearest<Geometry>>
+nearest(Geometry const &geometry, int k, float max_radius)
+{
+  return {Nearest<Geometry>(geometry, k), max_radius};
+}
+
+// nearest<4>(geometry, max_radius) — the compile-time-k flavor
+template <int K, typename Geometry>
+KOKKOS_INLINE_FUNCTION BoundedNearest<NearestK<Geometry, K>>
+nearest(Geometry const &geometry, float max_radius)
+{
+  return {NearestK<Geometry, K>(geometry), max_radius};
+}
+
 } // namespace ArborX
 
 #endif
@@ -0,0 +1,83 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_QUERY_FUTURE_HPP
+#define ARBORX_QUERY_FUTURE_HPP
+
+#include <ArborX_Exception.hpp>
+#include <ArborX_QueryWorkspace.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Completion handle returned by queryAsync() (see
+// BoundingVolumeHierarchy::queryAsync). The query is enqueued on the
+// execution space instance without any host synchronization; wait() is the
+// single point where the host blocks. The offset and output views handed
+// out by queryAsync() must not be read before wait() returned.
+//
+// Destroying the handle without calling wait() is allowed and does not
+// block, but leaves the workspace without captured counts, so the next
+// asynchronous call needs an explicit buffer size (or a synchronous call in
+// between) to size itself.
+template <class ExecutionSpace, class MemorySpace>
+class QueryFuture
+{
+public:
+  QueryFuture() = default;
+
+  QueryFuture(ExecutionSpace const &space,
+              Kokkos::View<int *, MemorySpace> const &status,
+              QueryWorkspace<MemorySpace> *workspace, size_t n_queries)
+      : _space(space)
+      , _status(status)
+      , _workspace(workspace)
+      , _n_queries(n_queries)
+  {}
+
+  // Whether a wait() is still outstanding
+  bool valid() const { return _workspace != nullptr; }
+
+  // Block the host until the enqueued query completed, and re-arm the
+  // workspace with the per-predicate counts of this call. Throws when a
+  // predicate produced more results than its buffer holds; the counts
+  // gathered during the bounded traversal are exact even then, so
+  // re-issuing the query right away succeeds.
+  void wait()
+  {
+    if (_workspace == nullptr)
+      return;
+
+    int status[2];
+    Kokkos::View<int *, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>
+        status_host(status, 2);
+    Kokkos::deep_copy(_space, status_host, _status);
+    _space.fence("ArborX::QueryFuture::wait");
+
+    _workspace->captureCounts(_n_queries, status[1]);
+    _workspace = nullptr;
+
+    // Overflow of a buffer; capacities are hard in the asynchronous path
+    ARBORX_ASSERT(status[0] == 0);
+  }
+
+private:
+  ExecutionSpace _space;
+  Kokkos::View<int *, MemorySpace> _status;
+  QueryWorkspace<MemorySpace> *_workspace = nullptr;
+  size_t _n_queries = 0;
+};
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -0,0 +1,241 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_QUERY_GRAPH_HPP
+#define ARBORX_QUERY_GRAPH_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_Exception.hpp>
+#include <ArborX_QueryFuture.hpp>
+#include <ArborX_QueryWorkspace.hpp>
+#include <ArborX_TraversalPolicy.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <type_traits>
+
+namespace ArborX::Experimental
+{
+
+// Capture-and-replay handle for a repeated asynchronous query. A small
+// steady-state query still pays for around a dozen kernel launches per
+// call; at high call rates the launch overhead exceeds the kernel time.
+// The first launch() primes the workspace (allocations and lazy backend
+// buffers), the second records the enqueued kernel sequence into a CUDA or
+// HIP graph, and every later call replays the instantiated graph with a
+// single launch.
+//
+// Recording a fixed kernel sequence requires fixed buffer sizes, so the
+// traversal policy must set a (hard) buffer size: the capacity layout is
+// then uniform and independent of the results of previous calls. The
+// number of predicates, the value and offset types, and the policy must
+// not change across calls; the predicate and primitive *contents* may
+// change freely between launches, which is the point. Buffer overflows
+// surface through QueryFuture::wait() exactly like in the uncaptured
+// asynchronous path.
+//
+// On backends without graph support (or host execution spaces) launch()
+// degrades to a plain queryAsync() through the owned workspace.
+template <class ExecutionSpace, class MemorySpace>
+class QueryGraph
+{
+private:
+  static constexpr bool graph_capture_enabled =
+#if defined(KOKKOS_ENABLE_CUDA)
+      std::is_same_v<ExecutionSpace, Kokkos::Cuda>;
+#elif defined(KOKKOS_ENABLE_HIP)
+      std::is_same_v<ExecutionSpace, Kokkos::HIP>;
+#else
+      false;
+#endif
+
+public:
+  QueryGraph() = default;
+  QueryGraph(QueryGraph const &) = delete;
+  QueryGraph &operator=(QueryGraph const &) = delete;
+
+  ~QueryGraph()
+  {
+#if defined(KOKKOS_ENABLE_CUDA)
+    if (_graph_exec != nullptr)
+      cudaGraphExecDestroy(_graph_exec);
+#elif defined(KOKKOS_ENABLE_HIP)
+    if (_graph_exec != nullptr)
+      hipGraphExecDestroy(_graph_exec);
+#endif
+  }
+
+  QueryWorkspace<MemorySpace> &workspace() { return _workspace; }
+
+  bool captured() const { return _state == Captured; }
+
+  // Drop the recorded graph (but keep the workspace buffers), forcing a
+  // re-prime and re-capture on the next launch(). Required before changing
+  // the number of predicates, the buffer size, or the output types.
+  void reset()
+  {
+#if defined(KOKKOS_ENABLE_CUDA)
+    if (_graph_exec != nullptr)
+      cudaGraphExecDestroy(_graph_exec);
+    _graph_exec = nullptr;
+#elif defined(KOKKOS_ENABLE_HIP)
+    if (_graph_exec != nullptr)
+      hipGraphExecDestroy(_graph_exec);
+    _graph_exec = nullptr;
+#endif
+    _state = Empty;
+  }
+
+  template <typename Tree, typename Predicates, typename Callback,
+            typename OutputView, typename OffsetView>
+  QueryFuture<ExecutionSpace, MemorySpace>
+  launch(Tree const &tree, ExecutionSpace const &space,
+         Predicates const &predicates, Callback const &callback,
+         OutputView &out, OffsetView &offset, TraversalPolicy const &policy)
+  {
+    // A data-independent kernel sequence needs a static capacity layout
+    ARBORX_ASSERT(policy._buffer_size != 0);
+
+    if constexpr (!graph_capture_enabled)
+    {
+      return tree.queryAsync(space, predicates, callback, out, offset,
+                             _workspace, policy);
+    }
+    else
+    {
+      using Workspace = QueryWorkspace<MemorySpace>;
+      using OffsetValue = typename OffsetView::non_const_value_type;
+      using Value = typename OutputView::non_const_value_type;
+
+      if (_state == Empty)
+      {
+        // Prime: allocates every workspace slot and any lazily created
+        // backend buffer (e.g. of the scan) at their steady-state sizes, so
+        // that the recording pass below enqueues no allocation
+        auto future = tree.queryAsync(space, predicates, callback, out,
+                                      offset, _workspace, policy);
+        _n_queries = offset.size() - 1;
+        _capacity = out.size();
+        _state = Primed;
+        return future;
+      }
+
+      ARBORX_ASSERT(
+          Details::AccessValues<Predicates, PredicatesTag>{predicates}.size() ==
+          _n_queries);
+
+      auto status = _workspace.template scratch<int>(Workspace::Status, 2);
+
+      if (_state == Primed)
+      {
+        Kokkos::Profiling::ScopedRegion guard(
+            "ArborX::QueryGraph::capture");
+
+        // Recording: the enqueued work is captured, not executed; the
+        // instantiated graph is launched right below so this call still
+        // performs the query
+        beginCapture(space);
+        tree.queryAsync(space, predicates, callback, out, offset, _workspace,
+                        policy);
+        endCapture(space);
+        _state = Captured;
+      }
+      else
+      {
+        // The dispatch ran host-side during recording only; re-point the
+        // caller's views at the workspace slots it would have picked
+        offset = _workspace.template scratch<OffsetValue>(Workspace::Offsets,
+                                                          _n_queries + 1);
+        out = _workspace.template scratch<Value>(Workspace::ValuesScratch,
+                                                 _capacity);
+        _workspace.invalidateCounts();
+      }
+
+      launchGraph(space);
+      return {space, status, &_workspace, _n_queries};
+    }
+  }
+
+private:
+  enum State
+  {
+    Empty,
+    Primed,
+    Captured
+  };
+
+  void beginCapture([[maybe_unused]] ExecutionSpace const &space)
+  {
+#if defined(KOKKOS_ENABLE_CUDA)
+    if constexpr (graph_capture_enabled)
+      ARBORX_ASSERT(cudaStreamBeginCapture(space.cuda_stream(),
+                                           cudaStreamCaptureModeThreadLocal) ==
+                    cudaSuccess);
+#elif defined(KOKKOS_ENABLE_HIP)
+    if constexpr (graph_capture_enabled)
+      ARBORX_ASSERT(hipStreamBeginCapture(space.hip_stream(),
+                                          hipStreamCaptureModeThreadLocal) ==
+                    hipSuccess);
+#endif
+  }
+
+  void endCapture([[maybe_unused]] ExecutionSpace const &space)
+  {
+#if defined(KOKKOS_ENABLE_CUDA)
+    if constexpr (graph_capture_enabled)
+    {
+      cudaGraph_t graph;
+      ARBORX_ASSERT(cudaStreamEndCapture(space.cuda_stream(), &graph) ==
+                    cudaSuccess);
+      ARBORX_ASSERT(cudaGraphInstantiate(&_graph_exec, graph, nullptr, nullptr,
+                                         0) == cudaSuccess);
+      cudaGraphDestroy(graph);
+    }
+#elif defined(KOKKOS_ENABLE_HIP)
+    if constexpr (graph_capture_enabled)
+    {
+      hipGraph_t graph;
+      ARBORX_ASSERT(hipStreamEndCapture(space.hip_stream(), &graph) ==
+                    hipSuccess);
+      ARBORX_ASSERT(hipGraphInstantiate(&_graph_exec, graph, nullptr, nullptr,
+                                        0) == hipSuccess);
+      hipGraphDestroy(graph);
+    }
+#endif
+  }
+
+  void launchGraph([[maybe_unused]] ExecutionSpace const &space)
+  {
+#if defined(KOKKOS_ENABLE_CUDA)
+    if constexpr (graph_capture_enabled)
+      ARBORX_ASSERT(cudaGraphLaunch(_graph_exec, space.cuda_stream()) ==
+                    cudaSuccess);
+#elif defined(KOKKOS_ENABLE_HIP)
+    if constexpr (graph_capture_enabled)
+      ARBORX_ASSERT(hipGraphLaunch(_graph_exec, space.hip_stream()) ==
+                    hipSuccess);
+#endif
+  }
+
+  QueryWorkspace<MemorySpace> _workspace;
+  State _state = Empty;
+  size_t _n_queries = 0;
+  size_t _capacity = 0;
+#if defined(KOKKOS_ENABLE_CUDA)
+  cudaGraphExec_t _graph_exec = nullptr;
+#elif defined(KOKKOS_ENABLE_HIP)
+  hipGraphExec_t _graph_exec = nullptr;
+#endif
+};
+
+} // namespace ArborX::Experimental
+
+#endif
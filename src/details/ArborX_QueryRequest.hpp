@@ -0,0 +1,99 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_QUERY_REQUEST_HPP
+#define ARBORX_QUERY_REQUEST_HPP
+
+#include <functional>
+#include <utility>
+
+namespace ArborX::Experimental
+{
+
+// Handle returned by DistributedTree::queryAsync(). The query returns as
+// soon as the outgoing predicates have been posted and the rank's own
+// traversal has been launched; the caller may then run independent work
+// while the exchange is in flight. The results land in the output views
+// bound at the call once wait() returns (or test() returned true), and
+// those views must stay alive until then.
+//
+// test() is a nonblocking progress check while the forwarded predicates are
+// in flight. Completing the query involves returning results to their
+// originating ranks, which is collective, so every rank must drive its
+// handle to completion; destroying an incomplete handle is equivalent to
+// calling wait().
+class QueryRequest
+{
+public:
+  QueryRequest() = default;
+
+  QueryRequest(std::function<bool()> test_arrival,
+               std::function<void()> wait_arrival, std::function<void()> finish)
+      : _test_arrival(std::move(test_arrival))
+      , _wait_arrival(std::move(wait_arrival))
+      , _finish(std::move(finish))
+      , _done(false)
+  {}
+
+  QueryRequest(QueryRequest &&other)
+      : _test_arrival(std::move(other._test_arrival))
+      , _wait_arrival(std::move(other._wait_arrival))
+      , _finish(std::move(other._finish))
+      , _done(std::exchange(other._done, true))
+  {}
+
+  QueryRequest &operator=(QueryRequest &&other)
+  {
+    wait();
+    _test_arrival = std::move(other._test_arrival);
+    _wait_arrival = std::move(other._wait_arrival);
+    _finish = std::move(other._finish);
+    _done = std::exchange(other._done, true);
+    return *this;
+  }
+
+  ~QueryRequest() { wait(); }
+
+  // Block until the results are available in the bound output views
+  void wait()
+  {
+    if (_done)
+      return;
+    _wait_arrival();
+    _finish();
+    _done = true;
+  }
+
+  // Return true once the results are available. While the forwarded
+  // predicates are still in flight this only pokes MPI and returns false;
+  // the first call after they arrived completes the query, including the
+  // collective return of the results.
+  bool test()
+  {
+    if (_done)
+      return true;
+    if (!_test_arrival())
+      return false;
+    _finish();
+    _done = true;
+    return true;
+  }
+
+private:
+  std::function<bool()> _test_arrival;
+  std::function<void()> _wait_arrival;
+  std::function<void()> _finish;
+  bool _done = true;
+};
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -0,0 +1,109 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_QUERY_WORKSPACE_HPP
+#define ARBORX_QUERY_WORKSPACE_HPP
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Persistent allocations for batched queries, reusable across calls. When a
+// workspace is passed to query() after the offset view, the offsets, values,
+// and the predicate sorting buffers are carved out of the workspace instead
+// of being allocated and freed per call, which matters for high-frequency
+// query loops where device malloc/free dominates.
+//
+// Buffers grow but never shrink, and the offset/values views handed back to
+// the caller alias workspace memory: the workspace must outlive any use of
+// the results, a workspace must not be used by two concurrent queries, and a
+// later query invalidates the results of the previous one.
+template <class MemorySpace>
+class QueryWorkspace
+{
+public:
+  enum Slot
+  {
+    Offsets = 0,
+    OffsetsScratch,
+    Counts,
+    Values,
+    ValuesScratch,
+    LinearOrdering,
+    Permutation,
+    Status,
+    NumSlots
+  };
+
+  template <typename T>
+  Kokkos::View<T *, MemorySpace> scratch(Slot slot, size_t n)
+  {
+    auto &buffer = _buffers[slot];
+    size_t const bytes = n * sizeof(T);
+    if (buffer.extent(0) < bytes)
+      Kokkos::realloc(Kokkos::WithoutInitializing, buffer, bytes);
+    return {reinterpret_cast<T *>(buffer.data()), n};
+  }
+
+  // Tracking for the captured predicate permutation (see
+  // TraversalPolicy::setPermutationReplay): the Permutation slot holds a
+  // valid ordering of n predicates iff hasPermutation(n)
+  bool hasPermutation(size_t n) const
+  {
+    return _permutation_size == n && n > 0;
+  }
+  void capturePermutation(size_t n) { _permutation_size = n; }
+  void invalidatePermutation() { _permutation_size = 0; }
+
+  // Tracking for the per-predicate result counts of the previous call, whose
+  // exclusive scan the Offsets slot still holds after a completed query. The
+  // next call with the same number of predicates uses them to size a single
+  // buffered traversal instead of a count pass (see queryDispatch), and the
+  // asynchronous variant requires them (or an explicit buffer size) since it
+  // cannot read sizes back mid-query. total is their sum, i.e., the number
+  // of values held in the Values slot.
+  bool hasCounts(size_t n) const { return _counts_size == n && n > 0; }
+  void captureCounts(size_t n, size_t total)
+  {
+    _counts_size = n;
+    _total_count = total;
+  }
+  void invalidateCounts()
+  {
+    _counts_size = 0;
+    _total_count = 0;
+  }
+  size_t totalCount() const { return _total_count; }
+
+private:
+  size_t _permutation_size = 0;
+  size_t _counts_size = 0;
+  size_t _total_count = 0;
+
+  Kokkos::View<char *, MemorySpace> _buffers[NumSlots] = {
+      Kokkos::View<char *, MemorySpace>("ArborX::QueryWorkspace::offsets", 0),
+      Kokkos::View<char *, MemorySpace>(
+          "ArborX::QueryWorkspace::offsets_scratch", 0),
+      Kokkos::View<char *, MemorySpace>("ArborX::QueryWorkspace::counts", 0),
+      Kokkos::View<char *, MemorySpace>("ArborX::QueryWorkspace::values", 0),
+      Kokkos::View<char *, MemorySpace>("ArborX::QueryWorkspace::values_scratch",
+                                        0),
+      Kokkos::View<char *, MemorySpace>(
+          "ArborX::QueryWorkspace::linear_ordering", 0),
+      Kokkos::View<char *, MemorySpace>("ArborX::QueryWorkspace::permutation",
+                                        0),
+      Kokkos::View<char *, MemorySpace>("ArborX::QueryWorkspace::status", 0)};
+};
+
+} // namespace ArborX::Experimental
+
+#endif
@@ -0,0 +1,142 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_REBUILD_POLICY_HPP
+#define ARBORX_REBUILD_POLICY_HPP
+
+#include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_Exception.hpp>
+#include <ArborX_TreeQualityMetrics.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <type_traits>
+
+namespace ArborX::Experimental
+{
+
+// Decides between refitting and rebuilding a hierarchy over moving
+// primitives. Refitting keeps the topology and inflates the boxes, so query
+// cost creeps up; rebuilding restores it at a much higher one-time cost. The
+// right cadence depends on how violently the primitives move, so the policy
+// measures rather than guesses.
+//
+// Each update() refits the tree and compares its SAH cost against the cost
+// recorded after the last full build. The SAH cost is proportional to the
+// expected number of nodes a query visits, so a degradation factor d means
+// queries got about d times slower and a rebuild would recover a fraction
+// (1 - 1/d) of the current per-step query time. Once the policy has observed
+// a build (after its first rebuild) and a query time (reported through
+// recordQueryTime()), it rebuilds when the projected savings over the
+// amortization horizon exceed the extra cost of a build over a refit. Until
+// both measurements exist it falls back to a plain degradation threshold.
+template <class Tree>
+class RebuildPolicy
+{
+public:
+  // Refit the tree with the new values, then rebuild it from scratch if the
+  // accumulated quality loss justifies the build cost
+  template <class ExecutionSpace, class Values>
+  void update(ExecutionSpace const &space, Tree &tree, Values const &values)
+  {
+    Kokkos::Profiling::ScopedRegion guard(
+        "ArborX::Experimental::RebuildPolicy::update");
+
+    // Adopt the freshly built tree's quality as the reference on first use
+    if (_reference_sah <= 0)
+      _reference_sah = computeTreeQualityMetrics(space, tree).sah_cost;
+
+    Kokkos::Timer timer;
+    space.fence();
+    tree.update(space, values);
+    space.fence();
+    _refit_seconds = timer.seconds();
+
+    _rebuilt = false;
+
+    float const degradation =
+        computeTreeQualityMetrics(space, tree).sah_cost / _reference_sah;
+    if (degradation <= 1)
+      return;
+
+    bool rebuild;
+    if (_query_seconds > 0 && _build_seconds > 0)
+      rebuild = _query_seconds * (1 - 1 / degradation) * _horizon >
+                _build_seconds - _refit_seconds;
+    else
+      rebuild = degradation > _degradation_threshold;
+    if (!rebuild)
+      return;
+
+    space.fence();
+    timer.reset();
+    rebuildTree(space, tree, values);
+    space.fence();
+    _build_seconds = timer.seconds();
+
+    _reference_sah = computeTreeQualityMetrics(space, tree).sah_cost;
+    _rebuilt = true;
+  }
+
+  // Report the per-step query time so the savings projection has a scale.
+  // Repeated calls blend the measurements to track drift in query cost.
+  void recordQueryTime(double seconds)
+  {
+    ARBORX_ASSERT(seconds >= 0);
+    _query_seconds =
+        (_query_seconds > 0 ? 0.5 * _query_seconds + 0.5 * seconds : seconds);
+  }
+
+  // Number of future updates a rebuild is amortized over
+  void setAmortizationHorizon(int horizon)
+  {
+    ARBORX_ASSERT(horizon > 0);
+    _horizon = horizon;
+  }
+
+  // SAH degradation factor that forces a rebuild before any timings exist
+  void setDegradationThreshold(float threshold)
+  {
+    ARBORX_ASSERT(threshold > 1);
+    _degradation_threshold = threshold;
+  }
+
+  bool rebuiltOnLastUpdate() const { return _rebuilt; }
+
+private:
+  template <class ExecutionSpace, class Values>
+  static void rebuildTree(ExecutionSpace const &space, Tree &tree,
+                          Values const &values)
+  {
+    auto const &indexable_getter =
+        Details::HappyTreeFriends::getIndexableGetter(tree);
+    if constexpr (std::is_constructible_v<Tree, ExecutionSpace const &,
+                                          Values const &,
+                                          std::decay_t<decltype(
+                                              indexable_getter)>>)
+      tree = Tree(space, values, indexable_getter);
+    else
+      tree = Tree(space, values);
+  }
+
+  float _reference_sah = 0;
+  double _refit_seconds = 0;
+  double _build_seconds = 0;
+  double _query_seconds = 0;
+  int _horizon = 1;
+  float _degradation_threshold = 2;
+  bool _rebuilt = false;
+};
+
+} // namespace ArborX::Experimental
+
+#endif
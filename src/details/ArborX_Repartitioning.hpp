@@ -0,0 +1,235 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_REPARTITIONING_HPP
+#define ARBORX_REPARTITIONING_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_Box.hpp>
+#include <ArborX_DetailsDistributedTreeUtils.hpp>
+#include <ArborX_DetailsDistributor.hpp>
+#include <ArborX_DetailsSortUtils.hpp>
+#include <ArborX_DetailsTreeConstruction.hpp>
+#include <ArborX_IndexableGetter.hpp>
+#include <ArborX_SpaceFillingCurves.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <mpi.h>
+
+namespace ArborX::Experimental
+{
+
+// Compute a destination rank for every local primitive such that the global
+// primitive set, ordered along a space-filling curve, is split into
+// contiguous chunks of near equal size — one per rank. The distributed tree
+// happily builds over whatever partition the caller has, but an imbalanced
+// one is paid for in every query: the busiest bottom tree serves a
+// proportional share of all forwarded predicates. Migrating the primitives
+// to the computed ranks before construction yields balanced bottom trees
+// whose bounding boxes barely overlap, since each rank owns a contiguous
+// curve segment.
+//
+// The cuts are chosen from a fixed number of samples of the sorted local
+// codes gathered from every rank, so the balance is approximate: the error
+// is bounded by the global count divided by the total number of samples.
+//
+// Must be called collectively. The returned view holds the destination rank
+// of each local primitive, in the original order; migrating the application
+// data is left to the caller (see migrate() below for plain views).
+template <typename ExecutionSpace, typename UserValues,
+          typename SpaceFillingCurve = Morton64>
+auto computeRepartitionRanks(MPI_Comm comm, ExecutionSpace const &space,
+                             UserValues const &user_values,
+                             SpaceFillingCurve const &curve = {})
+{
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::Experimental::computeRepartitionRanks");
+
+  using Values = Details::AccessValues<UserValues, PrimitivesTag>;
+  using MemorySpace = typename Values::memory_space;
+  static_assert(
+      Details::KokkosExt::is_accessible_from<MemorySpace,
+                                             ExecutionSpace>::value);
+
+  Values values{user_values};
+  Details::Indexables<Values, Details::DefaultIndexableGetter> indexables{
+      values, Details::DefaultIndexableGetter{}};
+
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+  int comm_size;
+  MPI_Comm_size(comm, &comm_size);
+
+  int const n = values.size();
+
+  // The curve codes must be computed over the global scene for the local
+  // orderings to be comparable across ranks
+  Box scene_bounding_box;
+  Details::TreeConstruction::calculateBoundingBoxOfTheScene(
+      space, indexables, scene_bounding_box);
+  space.fence("ArborX::Experimental::computeRepartitionRanks"
+              " (local bounds ready before MPI_Allreduce)");
+  constexpr int DIM = GeometryTraits::dimension_v<Box>;
+  MPI_Allreduce(MPI_IN_PLACE, &scene_bounding_box.minCorner()[0], DIM,
+                MPI_FLOAT, MPI_MIN, comm);
+  MPI_Allreduce(MPI_IN_PLACE, &scene_bounding_box.maxCorner()[0], DIM,
+                MPI_FLOAT, MPI_MAX, comm);
+
+  using Code = std::invoke_result_t<SpaceFillingCurve const &, Box,
+                                    std::decay_t<decltype(indexables(0))>>;
+  Kokkos::View<Code *, MemorySpace> codes(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::Experimental::computeRepartitionRanks::codes"),
+      n);
+  Details::TreeConstruction::projectOntoSpaceFillingCurve(
+      space, indexables, curve, scene_bounding_box, codes);
+
+  // Sample the sorted local codes at regular positions; every sample stands
+  // for n / n_samples primitives of this rank
+  constexpr int n_samples = 128;
+  Kokkos::View<Code *, MemorySpace> sorted_codes(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::Experimental::computeRepartitionRanks::sorted_codes"),
+      n);
+  Kokkos::deep_copy(space, sorted_codes, codes);
+  if (n > 0)
+    Details::sortObjects(space, sorted_codes);
+
+  Kokkos::View<Code *, MemorySpace> samples(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::Experimental::computeRepartitionRanks::samples"),
+      n_samples);
+  Kokkos::parallel_for(
+      "ArborX::Experimental::computeRepartitionRanks::sample_codes",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_samples),
+      KOKKOS_LAMBDA(int j) {
+        samples(j) =
+            (n > 0) ? sorted_codes((int)(((long long)(2 * j + 1) * n) /
+                                         (2 * n_samples)))
+                    : Code(-1);
+      });
+  auto samples_host = Kokkos::create_mirror_view(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, Kokkos::HostSpace{}),
+      samples);
+  Kokkos::deep_copy(space, samples_host, samples);
+  space.fence("ArborX::Experimental::computeRepartitionRanks"
+              " (samples ready before MPI_Allgather)");
+
+  std::vector<Code> all_samples(static_cast<size_t>(comm_size) * n_samples);
+  MPI_Allgather(samples_host.data(), n_samples * sizeof(Code), MPI_BYTE,
+                all_samples.data(), n_samples * sizeof(Code), MPI_BYTE, comm);
+  std::vector<long long> all_counts(comm_size);
+  long long n_ll = n;
+  MPI_Allgather(&n_ll, 1, MPI_LONG_LONG, all_counts.data(), 1, MPI_LONG_LONG,
+                comm);
+
+  // Pick the P-1 cuts as weighted quantiles of the gathered samples
+  std::vector<std::pair<Code, double>> weighted_samples;
+  weighted_samples.reserve(all_samples.size());
+  long long n_global = 0;
+  for (int r = 0; r < comm_size; ++r)
+  {
+    n_global += all_counts[r];
+    if (all_counts[r] == 0)
+      continue;
+    double const weight = static_cast<double>(all_counts[r]) / n_samples;
+    for (int j = 0; j < n_samples; ++j)
+      weighted_samples.emplace_back(all_samples[r * n_samples + j], weight);
+  }
+  std::sort(weighted_samples.begin(), weighted_samples.end());
+
+  std::vector<Code> splitters_host(comm_size - 1, Code(-1));
+  double cumulative = 0;
+  int cut = 0;
+  for (auto const &[code, weight] : weighted_samples)
+  {
+    cumulative += weight;
+    while (cut < comm_size - 1 &&
+           cumulative >= (cut + 1) * static_cast<double>(n_global) / comm_size)
+      splitters_host[cut++] = code;
+    if (cut == comm_size - 1)
+      break;
+  }
+
+  Kokkos::View<Code *, MemorySpace> splitters(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::Experimental::computeRepartitionRanks::splitters"),
+      comm_size - 1);
+  Kokkos::View<Code const *, Kokkos::HostSpace,
+               Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+      splitters_host_view(splitters_host.data(), comm_size - 1);
+  Kokkos::deep_copy(space, splitters, splitters_host_view);
+
+  // The destination of a primitive is the first chunk whose upper cut is not
+  // below its code, so that ties go to the same rank everywhere
+  Kokkos::View<int *, MemorySpace> destination_ranks(
+      Kokkos::view_alloc(
+          space, Kokkos::WithoutInitializing,
+          "ArborX::Experimental::computeRepartitionRanks::destination_ranks"),
+      n);
+  int const n_splitters = comm_size - 1;
+  Kokkos::parallel_for(
+      "ArborX::Experimental::computeRepartitionRanks::assign_ranks",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        int lo = 0;
+        int hi = n_splitters;
+        while (lo < hi)
+        {
+          int const mid = (lo + hi) / 2;
+          if (splitters(mid) < codes(i))
+            lo = mid + 1;
+          else
+            hi = mid;
+        }
+        destination_ranks(i) = lo;
+      });
+
+  return destination_ranks;
+}
+
+// Ship a view of application data to the ranks computed by
+// computeRepartitionRanks(). Returns the migrated view; entries arrive
+// grouped by originating rank, in their original relative order.
+template <typename ExecutionSpace, typename View>
+typename View::non_const_type
+migrate(MPI_Comm comm, ExecutionSpace const &space, View const &values,
+        Kokkos::View<int const *, typename View::memory_space> const
+            &destination_ranks)
+{
+  Kokkos::Profiling::ScopedRegion guard("ArborX::Experimental::migrate");
+
+  using MemorySpace = typename View::memory_space;
+
+  ARBORX_ASSERT(values.extent(0) == destination_ranks.extent(0));
+
+  Details::Distributor<MemorySpace> distributor(comm);
+  int const n_imports = distributor.createFromSends(space, destination_ranks);
+
+  typename View::non_const_type migrated(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, values.label()),
+      n_imports);
+  Details::DistributedTree::sendAcrossNetwork(space, distributor, values,
+                                              migrated);
+  return migrated;
+}
+
+} // namespace ArborX::Experimental
+
+#endif
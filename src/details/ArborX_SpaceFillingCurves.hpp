@@ -13,13 +13,19 @@
 #define ARBORX_SPACE_FILLING_CURVES_HPP
 
 #include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsHilbertCode.hpp>
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_DetailsKokkosExtMinMaxOperations.hpp>
 #include <ArborX_DetailsMortonCode.hpp>
 #include <ArborX_HyperBox.hpp>
 #include <ArborX_HyperPoint.hpp>
 
+#include <Kokkos_Core.hpp>
 #include <Kokkos_DetectionIdiom.hpp>
 #include <Kokkos_Macros.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
 
+#include <cmath>
 #include <type_traits>
 
 namespace ArborX
@@ -71,11 +77,227 @@ struct Morton64
   }
 };
 
+// 128-bit codes (42 bits per dimension in 3D) are worth their extra sorting
+// cost when the input is so clustered that many points alias to a single
+// 64-bit code, which degrades the quality of the generated hierarchy. Only
+// available in 2D and 3D.
+struct Morton128
+{
+  template <typename Box, typename Point,
+            std::enable_if_t<GeometryTraits::is_box<Box>{} &&
+                             GeometryTraits::is_point<Point>{}> * = nullptr>
+  KOKKOS_FUNCTION auto operator()(Box const &scene_bounding_box, Point p) const
+  {
+    Details::translateAndScale(p, p, scene_bounding_box);
+    return Details::morton128(p);
+  }
+  template <typename Box, class Geometry,
+            std::enable_if_t<GeometryTraits::is_box<Box>{} &&
+                             !GeometryTraits::is_point<Geometry>{}> * = nullptr>
+  KOKKOS_FUNCTION auto operator()(Box const &scene_bounding_box,
+                                  Geometry const &geometry) const
+  {
+    auto p = Details::returnCentroid(geometry);
+    Details::translateAndScale(p, p, scene_bounding_box);
+    return Details::morton128(p);
+  }
+};
+
+// Hilbert ordering has no large jumps between consecutive indices, which
+// gives measurably better locality than Z-order on clustered inputs at the
+// price of a more expensive code computation. Usable anywhere Morton32/
+// Morton64 are accepted.
+struct Hilbert32
+{
+  template <typename Box, typename Point,
+            std::enable_if_t<GeometryTraits::is_box<Box>{} &&
+                             GeometryTraits::is_point<Point>{}> * = nullptr>
+  KOKKOS_FUNCTION auto operator()(Box const &scene_bounding_box, Point p) const
+  {
+    Details::translateAndScale(p, p, scene_bounding_box);
+    return Details::hilbert32(p);
+  }
+  template <typename Box, typename Geometry,
+            std::enable_if_t<GeometryTraits::is_box<Box>{} &&
+                             !GeometryTraits::is_point<Geometry>{}> * = nullptr>
+  KOKKOS_FUNCTION auto operator()(Box const &scene_bounding_box,
+                                  Geometry const &geometry) const
+  {
+    auto p = Details::returnCentroid(geometry);
+    Details::translateAndScale(p, p, scene_bounding_box);
+    return Details::hilbert32(p);
+  }
+};
+
+struct Hilbert64
+{
+  template <typename Box, typename Point,
+            std::enable_if_t<GeometryTraits::is_box<Box>{} &&
+                             GeometryTraits::is_point<Point>{}> * = nullptr>
+  KOKKOS_FUNCTION auto operator()(Box const &scene_bounding_box, Point p) const
+  {
+    Details::translateAndScale(p, p, scene_bounding_box);
+    return Details::hilbert64(p);
+  }
+  template <typename Box, class Geometry,
+            std::enable_if_t<GeometryTraits::is_box<Box>{} &&
+                             !GeometryTraits::is_point<Geometry>{}> * = nullptr>
+  KOKKOS_FUNCTION auto operator()(Box const &scene_bounding_box,
+                                  Geometry const &geometry) const
+  {
+    auto p = Details::returnCentroid(geometry);
+    Details::translateAndScale(p, p, scene_bounding_box);
+    return Details::hilbert64(p);
+  }
+};
+
+// Selects between Morton32 and Morton64 automatically at construction.
+// Morton32 halves the sort key bandwidth and builds measurably faster, but
+// aliases nearby primitives to one code when the input outresolves its
+// 2^(32/DIM) buckets per dimension; whether that risk is negligible is
+// decided from the primitive count and a single-pass estimate of the
+// per-dimension extent-to-spacing ratio (see
+// Details::selectNarrowMortonCode), with Morton64 as the fallback.
+struct AutoMorton
+{
+  // Largest primitive count for which the narrow code is considered
+  int max_count = 1 << 21;
+  // Fraction of the per-dimension Morton32 buckets the (clustering
+  // adjusted) extent-to-spacing ratio is allowed to occupy
+  float max_resolution_fraction = 0.25f;
+};
+
 } // namespace Experimental
 
 namespace Details
 {
 
+// Per-dimension centroid statistics gathered in a single pass. Merging via
+// operator+= makes the type usable with the Kokkos::Sum reducer, the same
+// trick the scene bounds reduction plays with Box.
+template <int DIM, typename Coordinate>
+struct CentroidStatistics
+{
+  Coordinate min[DIM];
+  Coordinate max[DIM];
+  double sum[DIM];
+  double sum_squares[DIM];
+
+  KOKKOS_FUNCTION CentroidStatistics()
+  {
+    for (int d = 0; d < DIM; ++d)
+    {
+      min[d] = KokkosExt::ArithmeticTraits::finite_max<Coordinate>::value;
+      max[d] = KokkosExt::ArithmeticTraits::finite_min<Coordinate>::value;
+      sum[d] = 0;
+      sum_squares[d] = 0;
+    }
+  }
+
+  KOKKOS_FUNCTION CentroidStatistics &
+  operator+=(CentroidStatistics const &other)
+  {
+    for (int d = 0; d < DIM; ++d)
+    {
+      min[d] = KokkosExt::min(min[d], other.min[d]);
+      max[d] = KokkosExt::max(max[d], other.max[d]);
+      sum[d] += other.sum[d];
+      sum_squares[d] += other.sum_squares[d];
+    }
+    return *this;
+  }
+
+// FIXME Temporary workaround until we clarify requirements on the Kokkos side.
+#if defined(KOKKOS_ENABLE_OPENMPTARGET) || defined(KOKKOS_ENABLE_SYCL)
+private:
+  friend KOKKOS_FUNCTION CentroidStatistics
+  operator+(CentroidStatistics statistics, CentroidStatistics const &other)
+  {
+    return statistics += other;
+  }
+#endif
+};
+
+} // namespace Details
+} // namespace ArborX
+
+template <int DIM, typename Coordinate>
+struct Kokkos::reduction_identity<
+    ArborX::Details::CentroidStatistics<DIM, Coordinate>>
+{
+  KOKKOS_FUNCTION static ArborX::Details::CentroidStatistics<DIM, Coordinate>
+  sum()
+  {
+    return {};
+  }
+};
+
+namespace ArborX
+{
+namespace Details
+{
+
+// Decides whether Morton32 resolves the input without significant key
+// collisions. A uniform cloud of n primitives has an extent-to-spacing
+// ratio of n^(1/DIM) per dimension; the ratio of the uniform standard
+// deviation (extent/sqrt(12)) to the measured one scales that up when the
+// centroids bunch together. The narrow code is accepted when the adjusted
+// ratio stays below the allowed fraction of the 2^(32/DIM) buckets it
+// resolves per dimension -- in every dimension, since translateAndScale
+// normalizes each one independently.
+template <typename ExecutionSpace, typename Values, typename IndexableGetter>
+bool selectNarrowMortonCode(ExecutionSpace const &space, Values const &values,
+                            IndexableGetter const &indexable_getter,
+                            Experimental::AutoMorton const &params)
+{
+  using Value = typename Values::value_type;
+  using Indexable = std::decay_t<std::invoke_result_t<IndexableGetter, Value>>;
+  constexpr int DIM = GeometryTraits::dimension_v<Indexable>;
+  using Coordinate = typename GeometryTraits::coordinate_type<Indexable>::type;
+
+  int const n = values.size();
+  if (n > params.max_count)
+    return false;
+
+  Kokkos::Profiling::ScopedRegion guard("ArborX::BVH::BVH::auto_morton");
+
+  using Statistics = CentroidStatistics<DIM, Coordinate>;
+  Statistics statistics;
+  Kokkos::parallel_reduce(
+      "ArborX::BVH::BVH::auto_morton::centroid_statistics",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i, Statistics &update) {
+        auto const centroid = returnCentroid(indexable_getter(values(i)));
+        for (int d = 0; d < DIM; ++d)
+        {
+          update.min[d] = KokkosExt::min(update.min[d], centroid[d]);
+          update.max[d] = KokkosExt::max(update.max[d], centroid[d]);
+          update.sum[d] += centroid[d];
+          update.sum_squares[d] += (double)centroid[d] * centroid[d];
+        }
+      },
+      Kokkos::Sum<Statistics>(statistics));
+
+  auto const points_per_dim = std::pow((double)n, 1. / DIM);
+  auto const buckets_per_dim = std::exp2(32. / DIM);
+  for (int d = 0; d < DIM; ++d)
+  {
+    auto const extent = (double)statistics.max[d] - (double)statistics.min[d];
+    if (extent == 0)
+      continue;
+    auto const mean = statistics.sum[d] / n;
+    auto const variance =
+        std::max(statistics.sum_squares[d] / n - mean * mean, 0.);
+    auto const uniform_stddev = extent / std::sqrt(12.);
+    auto const clustering =
+        (variance > 0 ? uniform_stddev / std::sqrt(variance) : 1.);
+    if (std::max(clustering, 1.) * points_per_dim >
+        params.max_resolution_fraction * buckets_per_dim)
+      return false;
+  }
+  return true;
+}
+
 template <int DIM, class SpaceFillingCurve>
 void check_valid_space_filling_curve(SpaceFillingCurve const &)
 {
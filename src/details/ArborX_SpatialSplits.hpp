@@ -0,0 +1,148 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_SPATIAL_SPLITS_HPP
+#define ARBORX_SPATIAL_SPLITS_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_DetailsAlgorithms.hpp> // expand
+#include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_Exception.hpp>
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_HyperBox.hpp>
+#include <ArborX_PairValueIndex.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+namespace ArborX::Experimental
+{
+
+// SBVH-style reference splitting, performed in the values array rather than
+// inside a builder: every primitive whose bounding box is stretched beyond
+// max_aspect_ratio is referenced by several entries, with the box clipped
+// into equal chunks along its longest axis (at most max_fragments of them).
+// Building a tree over the returned references keeps long edge or fiber
+// boxes from producing nodes that span the scene and force queries through
+// false subtrees; the index of each reference points back to the primitive
+// it was clipped from. The tree's node arrays are sized by the value count
+// at construction, which is why the duplication happens up front here
+// instead of behind a builder flag.
+//
+// A chunk of a primitive's box contains the portion of the primitive inside
+// that chunk, so clipped references stay conservative for any geometry and
+// queries lose no matches. The usual caveat of split references applies: a
+// predicate overlapping several fragments of one primitive reports its
+// index once per fragment, and consumers that care must deduplicate.
+template <typename ExecutionSpace, typename UserPrimitives>
+auto splitReferences(ExecutionSpace const &space,
+                     UserPrimitives const &user_primitives,
+                     float max_aspect_ratio = 4, int max_fragments = 8)
+{
+  using Primitives = Details::AccessValues<UserPrimitives, PrimitivesTag>;
+  using MemorySpace = typename Primitives::memory_space;
+  static_assert(Details::KokkosExt::is_accessible_from<MemorySpace,
+                                                       ExecutionSpace>::value);
+  Details::check_valid_access_traits(PrimitivesTag{}, user_primitives);
+
+  Primitives primitives{user_primitives};
+
+  using Primitive = typename Primitives::value_type;
+  constexpr int DIM = GeometryTraits::dimension_v<Primitive>;
+  using Coordinate = typename GeometryTraits::coordinate_type<Primitive>::type;
+  using Box = ExperimentalHyperGeometry::Box<DIM, Coordinate>;
+
+  ARBORX_ASSERT(max_aspect_ratio >= 1);
+  ARBORX_ASSERT(max_fragments >= 1);
+
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::Experimental::split_references");
+
+  int const n = primitives.size();
+
+  Kokkos::View<int *, MemorySpace> offsets(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::Experimental::split_references::offsets"),
+      n + 1);
+  Kokkos::parallel_for(
+      "ArborX::Experimental::split_references::count_fragments",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        Box box{};
+        using Details::expand;
+        expand(box, primitives(i));
+
+        Coordinate longest = 0;
+        Coordinate second = 0;
+        for (int d = 0; d < DIM; ++d)
+        {
+          auto const extent = box.maxCorner()[d] - box.minCorner()[d];
+          if (extent > longest)
+          {
+            second = longest;
+            longest = extent;
+          }
+          else if (extent > second)
+            second = extent;
+        }
+
+        // Clip so that no fragment exceeds the aspect threshold; a box flat
+        // in every other dimension caps out at max_fragments
+        int k = 1;
+        if (longest > 0)
+          k = (second > 0
+                   ? (int)Kokkos::ceil(longest / (max_aspect_ratio * second))
+                   : max_fragments);
+        offsets(i) = Kokkos::min(Kokkos::max(k, 1), max_fragments);
+      });
+  Details::KokkosExt::exclusive_scan(space, offsets, offsets, 0);
+  int const n_references = Details::KokkosExt::lastElement(space, offsets);
+
+  Kokkos::View<PairValueIndex<Box> *, MemorySpace> references(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::Experimental::split_references::references"),
+      n_references);
+  Kokkos::parallel_for(
+      "ArborX::Experimental::split_references::clip_boxes",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        Box box{};
+        using Details::expand;
+        expand(box, primitives(i));
+
+        int axis = 0;
+        for (int d = 1; d < DIM; ++d)
+          if (box.maxCorner()[d] - box.minCorner()[d] >
+              box.maxCorner()[axis] - box.minCorner()[axis])
+            axis = d;
+
+        auto const begin = offsets(i);
+        int const k = offsets(i + 1) - begin;
+        auto const lo = box.minCorner()[axis];
+        auto const step = (box.maxCorner()[axis] - lo) / k;
+        for (int f = 0; f < k; ++f)
+        {
+          Box fragment = box;
+          fragment.minCorner()[axis] = lo + f * step;
+          // The last fragment keeps the exact original boundary so that
+          // rounding in the step cannot shave the far end off
+          fragment.maxCorner()[axis] =
+              (f + 1 == k ? box.maxCorner()[axis] : lo + (f + 1) * step);
+          references(begin + f) = {fragment, (unsigned)i};
+        }
+      });
+
+  return references;
+}
+
+} // namespace ArborX::Experimental
+
+#endif
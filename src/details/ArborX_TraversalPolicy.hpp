@@ -16,6 +16,26 @@ namespace ArborX
 {
 namespace Experimental
 {
+
+// Tags selecting the in-kernel query overloads: a single thread traverses
+// one predicate (PerThread), or the members of a team jointly traverse one
+// predicate (PerTeam).
+struct PerThread
+{};
+
+struct PerTeam
+{};
+
+// Space-filling curve used when sorting predicates (see
+// TraversalPolicy::_sort_predicates). Hilbert ordering has better locality
+// than Z-order on clustered inputs at the price of a more expensive code
+// computation per predicate.
+enum class SortingCurve
+{
+  Morton,
+  Hilbert
+};
+
 struct TraversalPolicy
 {
   // Buffer size lets a user provide an upper bound for the number of results
@@ -33,6 +53,122 @@ struct TraversalPolicy
   // Sort predicates allows disabling predicate sorting.
   bool _sort_predicates = true;
 
+  // Use a persistent-threads work queue for the traversal instead of one
+  // thread per predicate. Long traversals are time-sliced and re-enqueued,
+  // which helps when per-predicate costs vary by orders of magnitude. Only
+  // affects spatial predicates; other traversals ignore the flag.
+  bool _work_queue = false;
+
+  // Traverse batches of consecutive predicates cooperatively: a team shares
+  // one traversal front and loads each node once for the whole batch. Only
+  // worthwhile when predicate sorting is on and queries are short-range;
+  // spatial predicates only.
+  bool _coherent_batches = false;
+
+  // Traverse batches of consecutive rays as packets: a team bounds its rays
+  // by a frustum and tests internal nodes against the frustum once, with
+  // per-ray refinement only at the leaves. Requires spatial predicates whose
+  // geometry is a ray and a box bounding volume; other queries ignore the
+  // flag. Worthwhile for coherent (near-parallel, nearby-origin) bundles.
+  bool _ray_packets = false;
+
+  // Keep per-thread nearest traversal stacks in team scratch (shared memory)
+  // instead of thread-local memory, avoiding local memory spills under
+  // register pressure. Nearest predicates only; falls back to thread-local
+  // stacks when scratch is too small.
+  bool _scratch_stacks = false;
+
+  // Stage the entire node array into team scratch (shared memory on GPU
+  // backends) once per team and traverse it from there. Only sensible for
+  // trees small enough to fit, roughly a thousand values with the default
+  // node types; larger trees silently fall back to the global-memory rope
+  // walk. Pays off when many predicates hit the same small tree, turning
+  // the hottest node loads into shared-memory reads. Spatial predicates
+  // only; the other spatial modes take precedence when combined.
+  bool _scratch_tree = false;
+
+  // Replace the per-thread nearest traversal stack with a restart trail: a
+  // single 64-bit word recording which child was taken at every level of
+  // the current path. Exhausted subtrees are skipped by restarting from
+  // the root and replaying the path the trail dictates, so the traversal
+  // keeps no stack state at all, at the price of revisiting internal nodes
+  // on every replay. Worthwhile when occupancy is limited by the stack
+  // spilling to local memory (large k, deep trees). Nearest predicates
+  // only; takes precedence over _scratch_stacks when both are set.
+  bool _restart_trail = false;
+
+  // Lay the nearest result buffer out k-major (entry i of query q at
+  // i * n_queries + q) instead of query-major, so that the heap updates
+  // adjacent threads perform on the same heap level touch adjacent words
+  // and coalesce. Worthwhile for large runtime k (hundreds), where the
+  // heap traffic dominates; the buffer is padded to the largest k in the
+  // batch. Nearest predicates only; the restart trail and scratch stacks
+  // take precedence when combined.
+  bool _k_major_buffer = false;
+
+  // Estimate the per-query buffer size by sampling a small predicate subset
+  // before the first pass, overriding _buffer_size. Spatial predicates only.
+  bool _adaptive_buffer_size = false;
+
+  // Capacity (total number of results across all queries) of an arena that
+  // results are bump-allocated from during a single traversal, replacing the
+  // count+fill scheme. If the arena overflows, the fill pass of the classic
+  // scheme runs as a fallback. The default value zero disables the arena.
+  // Spatial predicates only.
+  int _single_pass_arena = 0;
+
+  // Space-filling curve used for predicate sorting.
+  SortingCurve _sorting_curve = SortingCurve::Morton;
+
+  // Order predicates by estimated traversal cost, heaviest first, instead
+  // of along a space-filling curve. The spatial sort helps locality but
+  // not load balance: a handful of heavy predicates clumped into the same
+  // blocks dominates the tail of the kernel. Longest-processing-time
+  // ordering schedules them up front, where they overlap with the bulk of
+  // the light work. The cost estimate is the fraction of the scene covered
+  // by the predicate geometry, a proxy for the number of leaves touched;
+  // point-like predicates (e.g. nearest) all estimate the same and keep
+  // their relative order, so the mode only pays off for volumetric spatial
+  // predicates of varied extent.
+  bool _cost_scheduling = false;
+
+  // Replay the predicate permutation captured in the query workspace by a
+  // previous call instead of recomputing it, removing a projection and a
+  // sort per query when the same (or slowly drifting) predicate set is
+  // issued repeatedly. Only honored when a QueryWorkspace is passed and its
+  // captured permutation matches the number of predicates; the caller is
+  // responsible for deciding when a drifting predicate set makes the cached
+  // ordering stale enough to recompute (sorting only affects performance,
+  // never correctness).
+  bool _replay_permutation = false;
+
+  // Treat the offset and output views passed to the query as caller-owned
+  // storage with capacity semantics: ArborX neither reallocates nor shrinks
+  // them. The offset view must hold exactly one entry more than the number
+  // of predicates, and the output view's current size is the capacity. If
+  // the results do not fit, a SearchException reporting the required size is
+  // thrown; on success the valid output length is the last offset entry and
+  // any output past it is unspecified. Implies the count-and-fill scheme
+  // (buffer, arena and adaptive settings are ignored), so queries perform no
+  // allocation in steady state.
+  bool _user_provided_storage = false;
+
+  // Traverse only one representative of every group of byte-identical
+  // predicates and copy its results to the whole group afterwards (see
+  // BatchedQueries::deduplicatePredicates). Worth enabling when batches are
+  // known to repeat predicates, e.g. query spheres generated from shared
+  // mesh corners; the hash pass is wasted work otherwise. Attached data
+  // takes part in the comparison, so predicates with distinct attachments
+  // are never folded. View-form queries only.
+  bool _deduplicate_predicates = false;
+
+  // Device-side histogram bins that callback-form queries record
+  // per-predicate traversal latencies into (see
+  // Experimental::TraversalStatistics). Null disables recording. Queries
+  // returning views run the count and fill passes over every predicate and
+  // would record each one twice, so they ignore the histogram.
+  unsigned long long *_latency_histogram = nullptr;
+
   TraversalPolicy &setBufferSize(int buffer_size)
   {
     _buffer_size = buffer_size;
@@ -44,6 +180,97 @@ struct TraversalPolicy
     _sort_predicates = sort_predicates;
     return *this;
   }
+
+  TraversalPolicy &setWorkQueue(bool work_queue)
+  {
+    _work_queue = work_queue;
+    return *this;
+  }
+
+  TraversalPolicy &setCoherentBatches(bool coherent_batches)
+  {
+    _coherent_batches = coherent_batches;
+    return *this;
+  }
+
+  TraversalPolicy &setRayPackets(bool ray_packets)
+  {
+    _ray_packets = ray_packets;
+    return *this;
+  }
+
+  TraversalPolicy &setScratchStacks(bool scratch_stacks)
+  {
+    _scratch_stacks = scratch_stacks;
+    return *this;
+  }
+
+  TraversalPolicy &setScratchTree(bool scratch_tree)
+  {
+    _scratch_tree = scratch_tree;
+    return *this;
+  }
+
+  TraversalPolicy &setRestartTrail(bool restart_trail)
+  {
+    _restart_trail = restart_trail;
+    return *this;
+  }
+
+  TraversalPolicy &setKMajorBuffer(bool k_major_buffer)
+  {
+    _k_major_buffer = k_major_buffer;
+    return *this;
+  }
+
+  TraversalPolicy &setAdaptiveBufferSize(bool adaptive_buffer_size)
+  {
+    _adaptive_buffer_size = adaptive_buffer_size;
+    return *this;
+  }
+
+  TraversalPolicy &setPredicateDeduplication(bool deduplicate_predicates)
+  {
+    _deduplicate_predicates = deduplicate_predicates;
+    return *this;
+  }
+
+  TraversalPolicy &setSinglePassArena(int single_pass_arena)
+  {
+    _single_pass_arena = single_pass_arena;
+    return *this;
+  }
+
+  TraversalPolicy &setSortingCurve(SortingCurve sorting_curve)
+  {
+    _sorting_curve = sorting_curve;
+    return *this;
+  }
+
+  TraversalPolicy &setCostScheduling(bool cost_scheduling)
+  {
+    _cost_scheduling = cost_scheduling;
+    return *this;
+  }
+
+  TraversalPolicy &setPermutationReplay(bool replay_permutation)
+  {
+    _replay_permutation = replay_permutation;
+    return *this;
+  }
+
+  TraversalPolicy &setUserProvidedStorage(bool user_provided_storage)
+  {
+    _user_provided_storage = user_provided_storage;
+    return *this;
+  }
+
+  template <typename TraversalStatistics>
+  TraversalPolicy &setLatencyHistogram(TraversalStatistics const &statistics)
+  {
+    _latency_histogram = statistics.data();
+    return *this;
+  }
 };
 
 } // namespace Experimental
@@ -0,0 +1,127 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_TRAVERSAL_STATISTICS_HPP
+#define ARBORX_TRAVERSAL_STATISTICS_HPP
+
+#include <Kokkos_Core.hpp>
+
+#include <chrono>
+
+namespace ArborX
+{
+namespace Details
+{
+
+// Clock read bracketing a single predicate's traversal: raw cycle counter on
+// CUDA/HIP devices, steady clock ticks on host backends. The units differ
+// across backends, so only the shape of the distribution within one run is
+// meaningful, which is all the latency histogram needs.
+KOKKOS_INLINE_FUNCTION unsigned long long traversalClock()
+{
+#if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__)
+  return clock64();
+#elif defined(__SYCL_DEVICE_ONLY__) || defined(KOKKOS_ENABLE_OPENMPTARGET)
+  // No portable cycle counter; every predicate lands in the first bin
+  return 0;
+#else
+  return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+// Record one predicate's elapsed traversal time into the power-of-two
+// histogram (bin = floor(log2(elapsed)), elapsed zero goes into bin 0)
+KOKKOS_INLINE_FUNCTION void recordTraversalLatency(unsigned long long *bins,
+                                                   unsigned long long elapsed)
+{
+  int bin = 0;
+  while (elapsed >>= 1)
+    ++bin;
+  Kokkos::atomic_increment(&bins[bin]);
+}
+
+} // namespace Details
+
+namespace Experimental
+{
+
+// Device-side per-predicate latency histogram (see
+// TraversalPolicy::setLatencyHistogram()). Each traversal records the cycles
+// (device) or clock ticks (host) one predicate took into power-of-two bins,
+// making the tail of the distribution visible where aggregate timings only
+// show the mean: a workload where 1% of the predicates hit dense tree
+// regions and take 100x the median shows up as mass many bins to the right.
+// Accumulates across queries until reset() so that production runs can be
+// sampled cheaply; recording costs two clock reads and one atomic per
+// predicate, and nothing at all when no histogram is set.
+template <typename MemorySpace>
+struct TraversalStatistics
+{
+  static_assert(Kokkos::is_memory_space<MemorySpace>::value);
+
+  // 2^64 cycles overflow the clock itself, so 64 bins always suffice
+  static constexpr int num_bins = 64;
+
+  Kokkos::View<unsigned long long *, MemorySpace> _bins;
+
+  TraversalStatistics()
+      : _bins("ArborX::TraversalStatistics::bins", num_bins)
+  {}
+
+  // Pointer handed to the traversal kernels through the policy
+  unsigned long long *data() const { return _bins.data(); }
+
+  void reset() { Kokkos::deep_copy(_bins, 0); }
+
+  // Host copy of the bins; bin b counts predicates with elapsed in
+  // [2^b, 2^(b+1))
+  auto histogram() const
+  {
+    return Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, _bins);
+  }
+
+  // Total number of predicates recorded
+  unsigned long long count() const
+  {
+    auto bins_host = histogram();
+    unsigned long long n = 0;
+    for (int b = 0; b < num_bins; ++b)
+      n += bins_host(b);
+    return n;
+  }
+
+  // Smallest bin whose cumulative count reaches fraction q of the total,
+  // i.e., ceil(log2) of the q-quantile latency. quantileBin(0.99) -
+  // quantileBin(0.5) is the log2 spread between the tail and the median,
+  // which is the signal for re-sorting predicates or rebalancing the tree.
+  int quantileBin(double q) const
+  {
+    auto bins_host = histogram();
+    unsigned long long total = 0;
+    for (int b = 0; b < num_bins; ++b)
+      total += bins_host(b);
+    if (total == 0)
+      return 0;
+    unsigned long long cumulative = 0;
+    for (int b = 0; b < num_bins; ++b)
+    {
+      cumulative += bins_host(b);
+      if (cumulative >= q * total)
+        return b;
+    }
+    return num_bins - 1;
+  }
+};
+
+} // namespace Experimental
+} // namespace ArborX
+
+#endif
@@ -0,0 +1,204 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_TREE_QUALITY_METRICS_HPP
+#define ARBORX_TREE_QUALITY_METRICS_HPP
+
+#include <ArborX_DetailsAlgorithms.hpp> // expand
+#include <ArborX_DetailsHappyTreeFriends.hpp>
+#include <ArborX_DetailsTreeConstructionPLOC.hpp> // halfArea
+#include <ArborX_DetailsTreeNodeLabeling.hpp>     // findParents
+#include <ArborX_Exception.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+namespace ArborX
+{
+namespace Experimental
+{
+
+// Build-quality summary of a bounding volume hierarchy. The metrics are
+// what the builders themselves optimize for, so they make rebuild decisions
+// quantitative: a rising SAH cost or sibling overlap after refitting a
+// deformed geometry tells an auto-rebuild policy that the topology went
+// stale long before traversal timings degrade measurably.
+struct TreeQualityMetrics
+{
+  // Surface area heuristic cost of the tree with unit node and leaf
+  // intersection costs: the sum of all node surface areas divided by the
+  // surface area of the root, i.e., the expected number of nodes a
+  // uniformly distributed query intersecting the scene visits
+  float sah_cost = 0;
+
+  // Mean over the internal nodes of the surface area of the children's
+  // intersection relative to the node's own surface area. Zero when every
+  // pair of siblings is spatially disjoint; large values mean queries
+  // regularly have to descend into both subtrees
+  float sibling_overlap = 0;
+
+  // Depth of the shallowest and deepest leaf (the root's children are at
+  // depth one). A wide spread indicates an unbalanced hierarchy
+  int min_leaf_depth = 0;
+  int max_leaf_depth = 0;
+
+  // leaf_depth_histogram(d) counts the leaves at depth d
+  Kokkos::View<int *, Kokkos::HostSpace> leaf_depth_histogram;
+};
+
+namespace TreeQualityMetricsImpl
+{
+// The tree only stores bounding volumes for the internal nodes; leaf
+// volumes are recomputed from the indexables
+template <typename Tree>
+KOKKOS_FUNCTION auto nodeBoundingVolume(Tree const &tree, int node)
+{
+  using Details::HappyTreeFriends;
+  using BoundingVolume = typename Tree::bounding_volume_type;
+  if (HappyTreeFriends::isLeaf(tree, node))
+  {
+    BoundingVolume volume{};
+    using Details::expand;
+    expand(volume, HappyTreeFriends::getIndexable(tree, node));
+    return volume;
+  }
+  return (BoundingVolume)HappyTreeFriends::getInternalBoundingVolume(tree,
+                                                                     node);
+}
+} // namespace TreeQualityMetricsImpl
+
+template <typename ExecutionSpace, typename Tree>
+TreeQualityMetrics computeTreeQualityMetrics(ExecutionSpace const &space,
+                                             Tree const &tree)
+{
+  Kokkos::Profiling::ScopedRegion guard("ArborX::TreeQualityMetrics");
+
+  using Details::HappyTreeFriends;
+  using Details::TreeConstruction::halfArea;
+  using MemorySpace = typename Tree::memory_space;
+  using BoundingVolume = typename Tree::bounding_volume_type;
+
+  TreeQualityMetrics metrics;
+
+  int const n = tree.size();
+  if (n == 0)
+    return metrics;
+  if (n == 1)
+  {
+    // Degenerate single-leaf tree: the root is the leaf
+    metrics.sah_cost = 1;
+    metrics.leaf_depth_histogram =
+        Kokkos::View<int *, Kokkos::HostSpace>("ArborX::TreeQualityMetrics::"
+                                               "leaf_depth_histogram",
+                                               1);
+    metrics.leaf_depth_histogram(0) = 1;
+    return metrics;
+  }
+
+  // The scene bounds normalize the SAH cost; guard against a degenerate
+  // (flat or point-like) scene whose surface area vanishes
+  float const root_area = halfArea(tree.bounds());
+  ARBORX_ASSERT(root_area > 0);
+
+  float internal_area = 0;
+  float overlap = 0;
+  Kokkos::parallel_reduce(
+      "ArborX::TreeQualityMetrics::reduce_internal_nodes",
+      Kokkos::RangePolicy<ExecutionSpace>(space, n, 2 * n - 1),
+      KOKKOS_LAMBDA(int i, float &area_update, float &overlap_update) {
+        auto const &volume =
+            HappyTreeFriends::getInternalBoundingVolume(tree, i);
+        float const area = halfArea(volume);
+        area_update += area;
+
+        auto const left_volume = TreeQualityMetricsImpl::nodeBoundingVolume(
+            tree, HappyTreeFriends::getLeftChild(tree, i));
+        auto const right_volume = TreeQualityMetricsImpl::nodeBoundingVolume(
+            tree, HappyTreeFriends::getRightChild(tree, i));
+
+        constexpr int DIM = GeometryTraits::dimension_v<BoundingVolume>;
+        BoundingVolume intersection;
+        bool disjoint = false;
+        for (int d = 0; d < DIM; ++d)
+        {
+          intersection.minCorner()[d] = Kokkos::max(
+              left_volume.minCorner()[d], right_volume.minCorner()[d]);
+          intersection.maxCorner()[d] = Kokkos::min(
+              left_volume.maxCorner()[d], right_volume.maxCorner()[d]);
+          disjoint |=
+              (intersection.minCorner()[d] > intersection.maxCorner()[d]);
+        }
+        if (!disjoint && area > 0)
+          overlap_update += halfArea(intersection) / area;
+      },
+      internal_area, overlap);
+
+  float leaf_area = 0;
+  Kokkos::parallel_reduce(
+      "ArborX::TreeQualityMetrics::reduce_leaf_nodes",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i, float &area_update) {
+        area_update +=
+            halfArea(TreeQualityMetricsImpl::nodeBoundingVolume(tree, i));
+      },
+      leaf_area);
+
+  metrics.sah_cost = (internal_area + leaf_area) / root_area;
+  metrics.sibling_overlap = overlap / (n - 1);
+
+  // Leaf depths are found by walking up the parent links, which the tree
+  // does not keep around after construction
+  Kokkos::View<int *, MemorySpace> parents(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeQualityMetrics::parents"),
+      2 * n - 1);
+  Details::findParents(space, tree, parents);
+
+  Kokkos::View<int *, MemorySpace> depths(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::TreeQualityMetrics::leaf_depths"),
+      n);
+  int min_depth;
+  int max_depth;
+  Kokkos::parallel_reduce(
+      "ArborX::TreeQualityMetrics::compute_leaf_depths",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i, int &min_update, int &max_update) {
+        int const root = HappyTreeFriends::getRoot(tree);
+        int depth = 0;
+        for (int node = i; node != root; node = parents(node))
+          ++depth;
+        depths(i) = depth;
+        min_update = Kokkos::min(min_update, depth);
+        max_update = Kokkos::max(max_update, depth);
+      },
+      Kokkos::Min<int>(min_depth), Kokkos::Max<int>(max_depth));
+  metrics.min_leaf_depth = min_depth;
+  metrics.max_leaf_depth = max_depth;
+
+  Kokkos::View<int *, MemorySpace> histogram(
+      Kokkos::view_alloc(space, "ArborX::TreeQualityMetrics::"
+                                "leaf_depth_histogram"),
+      max_depth + 1);
+  Kokkos::parallel_for(
+      "ArborX::TreeQualityMetrics::histogram_leaf_depths",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) { Kokkos::atomic_increment(&histogram(depths(i))); });
+  metrics.leaf_depth_histogram =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, histogram);
+
+  return metrics;
+}
+
+} // namespace Experimental
+} // namespace ArborX
+
+#endif
@@ -33,6 +33,7 @@ namespace Dispatch
 {
 using GeometryTraits::BoxTag;
 using GeometryTraits::KDOPTag;
+using GeometryTraits::OBBTag;
 using GeometryTraits::PointTag;
 using GeometryTraits::SphereTag;
 using GeometryTraits::TriangleTag;
@@ -83,6 +84,18 @@ KOKKOS_INLINE_FUNCTION auto distance(Geometry1 const &geometry1,
                             Geometry1, Geometry2>::apply(geometry1, geometry2);
 }
 
+template <typename Geometry1, typename Geometry2>
+KOKKOS_INLINE_FUNCTION auto distanceSquared(Geometry1 const &geometry1,
+                                            Geometry2 const &geometry2)
+{
+  static_assert(GeometryTraits::dimension_v<Geometry1> ==
+                GeometryTraits::dimension_v<Geometry2>);
+  return Dispatch::distanceSquared<
+      typename GeometryTraits::tag<Geometry1>::type,
+      typename GeometryTraits::tag<Geometry2>::type, Geometry1,
+      Geometry2>::apply(geometry1, geometry2);
+}
+
 template <typename Geometry1, typename Geometry2>
 KOKKOS_INLINE_FUNCTION void expand(Geometry1 &geometry1,
                                    Geometry2 const &geometry2)
@@ -152,6 +165,22 @@ struct equals<SphereTag, Sphere>
   }
 };
 
+// equals obb-obb
+template <typename OBB>
+struct equals<OBBTag, OBB>
+{
+  KOKKOS_FUNCTION static constexpr bool apply(OBB const &l, OBB const &r)
+  {
+    if (!Details::equals(l._centroid, r._centroid))
+      return false;
+    for (int i = 0; i < 3; ++i)
+      if (!Details::equals(l._axes[i], r._axes[i]) ||
+          l._half_extents[i] != r._half_extents[i])
+        return false;
+    return true;
+  }
+};
+
 // isValid point
 template <typename Point>
 struct isValid<PointTag, Point>
@@ -202,12 +231,14 @@ struct distance<PointTag, PointTag, Point1, Point2>
   {
     constexpr int DIM = GeometryTraits::dimension_v<Point1>;
     // Points may have different coordinate types. Try using implicit
-    // conversion to get the best one.
-    using Coordinate = decltype(b[0] - a[0]);
+    // conversion to get the best one, and promote reduced-precision
+    // storage types for the accumulation.
+    using Coordinate =
+        GeometryTraits::compute_coordinate_t<decltype(b[0] - a[0])>;
     Coordinate distance_squared = 0;
     for (int d = 0; d < DIM; ++d)
     {
-      auto tmp = b[d] - a[d];
+      auto const tmp = (Coordinate)b[d] - (Coordinate)a[d];
       distance_squared += tmp * tmp;
     }
     return Kokkos::sqrt(distance_squared);
@@ -296,6 +327,88 @@ struct distance<SphereTag, BoxTag, Sphere, Box>
   }
 };
 
+// distance point-obb
+template <typename Point, typename OBB>
+struct distance<PointTag, OBBTag, Point, OBB>
+{
+  KOKKOS_FUNCTION static auto apply(Point const &point, OBB const &obb)
+  {
+    using KokkosExt::max;
+    using KokkosExt::min;
+
+    // Clamp the point expressed in the frame of the box, then map the
+    // closest point back into world coordinates
+    auto const &c = obb._centroid;
+    auto closest = c;
+    for (int i = 0; i < 3; ++i)
+    {
+      float local = 0;
+      for (int d = 0; d < 3; ++d)
+        local += (point[d] - c[d]) * obb._axes[i][d];
+      local = min(max(local, -obb._half_extents[i]), obb._half_extents[i]);
+      for (int d = 0; d < 3; ++d)
+        closest[d] += local * obb._axes[i][d];
+    }
+    return Details::distance(point, closest);
+  }
+};
+
+// Squared distance, used by the nearest traversals which only ever compare
+// distances: ordering by the squared value is equivalent and skips a square
+// root per node visit. The generic version squares the exact distance; the
+// point specializations below avoid the square root altogether.
+template <typename Tag1, typename Tag2, typename Geometry1, typename Geometry2>
+struct distanceSquared
+{
+  KOKKOS_FUNCTION static auto apply(Geometry1 const &a, Geometry2 const &b)
+  {
+    auto const d = distance<Tag1, Tag2, Geometry1, Geometry2>::apply(a, b);
+    return d * d;
+  }
+};
+
+// squared distance point-point
+template <typename Point1, typename Point2>
+struct distanceSquared<PointTag, PointTag, Point1, Point2>
+{
+  KOKKOS_FUNCTION static auto apply(Point1 const &a, Point2 const &b)
+  {
+    constexpr int DIM = GeometryTraits::dimension_v<Point1>;
+    using Coordinate =
+        GeometryTraits::compute_coordinate_t<decltype(b[0] - a[0])>;
+    Coordinate distance_squared = 0;
+    for (int d = 0; d < DIM; ++d)
+    {
+      auto const tmp = (Coordinate)b[d] - (Coordinate)a[d];
+      distance_squared += tmp * tmp;
+    }
+    return distance_squared;
+  }
+};
+
+// squared distance point-box
+template <typename Point, typename Box>
+struct distanceSquared<PointTag, BoxTag, Point, Box>
+{
+  KOKKOS_FUNCTION static auto apply(Point const &point, Box const &box)
+  {
+    using KokkosExt::max;
+    using KokkosExt::min;
+
+    constexpr int DIM = GeometryTraits::dimension_v<Point>;
+    using Coordinate = decltype(point[0] - box.minCorner()[0]);
+    Coordinate distance_squared = 0;
+    for (int d = 0; d < DIM; ++d)
+    {
+      auto const projected =
+          min(max(point[d], box.minCorner()[d]), box.maxCorner()[d]);
+      auto const tmp = point[d] - projected;
+      distance_squared += tmp * tmp;
+    }
+    return distance_squared;
+  }
+};
+
 // expand a box to include a point
 template <typename Box, typename Point>
 struct expand<BoxTag, PointTag, Box, Point>
@@ -361,6 +474,30 @@ struct expand<BoxTag, TriangleTag, Box, Triangle>
   }
 };
 
+// expand a box to include an oriented box
+template <typename Box, typename OBB>
+struct expand<BoxTag, OBBTag, Box, OBB>
+{
+  KOKKOS_FUNCTION static void apply(Box &box, OBB const &obb)
+  {
+    // The axis-aligned extent of the oriented box along dimension d is the
+    // sum of the projections of its half-extent vectors onto that axis
+    auto const &c = obb._centroid;
+    auto lo = c;
+    auto hi = c;
+    for (int d = 0; d < 3; ++d)
+    {
+      float extent = 0;
+      for (int i = 0; i < 3; ++i)
+        extent += obb._half_extents[i] * Kokkos::abs(obb._axes[i][d]);
+      lo[d] -= extent;
+      hi[d] += extent;
+    }
+    Details::expand(box, lo);
+    Details::expand(box, hi);
+  }
+};
+
 // check if two axis-aligned bounding boxes intersect
 template <typename Box1, typename Box2>
 struct intersects<BoxTag, BoxTag, Box1, Box2>
@@ -369,11 +506,14 @@ struct intersects<BoxTag, BoxTag, Box1, Box2>
                                               Box2 const &other)
   {
     constexpr int DIM = GeometryTraits::dimension_v<Box1>;
+    // The per-dimension overlap tests are accumulated with & instead of
+    // early-returning: the loop body is straight-line compare code that
+    // vectorizes on host backends and does not diverge on GPU
+    bool intersects = true;
     for (int d = 0; d < DIM; ++d)
-      if (box.minCorner()[d] > other.maxCorner()[d] ||
-          box.maxCorner()[d] < other.minCorner()[d])
-        return false;
-    return true;
+      intersects &= (box.minCorner()[d] <= other.maxCorner()[d]) &
+                    (box.maxCorner()[d] >= other.minCorner()[d]);
+    return intersects;
   }
 };
 
@@ -463,6 +603,137 @@ struct intersects<PointTag, TriangleTag, Point, Triangle>
   }
 };
 
+// check if two oriented boxes intersect (separating axis test over the 6
+// face normals and the 9 pairwise axis cross products, see Gottschalk et
+// al., "OBBTree: a hierarchical structure for rapid interference detection")
+template <typename OBB1, typename OBB2>
+struct intersects<OBBTag, OBBTag, OBB1, OBB2>
+{
+  KOKKOS_FUNCTION static bool apply(OBB1 const &a, OBB2 const &b)
+  {
+    using Kokkos::abs;
+
+    // Epsilon term guards the cross-product axes against near-parallel
+    // frames, where the computed axis degenerates to noise
+    constexpr float eps = 1e-6f;
+
+    // Rotation matrix expressing b's frame in a's frame, and the centroid
+    // offset projected onto a's axes
+    float R[3][3];
+    float absR[3][3];
+    float t[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      t[i] = 0;
+      for (int d = 0; d < 3; ++d)
+        t[i] += (b._centroid[d] - a._centroid[d]) * a._axes[i][d];
+      for (int j = 0; j < 3; ++j)
+      {
+        R[i][j] = 0;
+        for (int d = 0; d < 3; ++d)
+          R[i][j] += a._axes[i][d] * b._axes[j][d];
+        absR[i][j] = abs(R[i][j]) + eps;
+      }
+    }
+
+    // Face normals of a
+    for (int i = 0; i < 3; ++i)
+    {
+      float const ra = a._half_extents[i];
+      float const rb = b._half_extents[0] * absR[i][0] +
+                       b._half_extents[1] * absR[i][1] +
+                       b._half_extents[2] * absR[i][2];
+      if (abs(t[i]) > ra + rb)
+        return false;
+    }
+
+    // Face normals of b
+    for (int j = 0; j < 3; ++j)
+    {
+      float const ra = a._half_extents[0] * absR[0][j] +
+                       a._half_extents[1] * absR[1][j] +
+                       a._half_extents[2] * absR[2][j];
+      float const rb = b._half_extents[j];
+      if (abs(t[0] * R[0][j] + t[1] * R[1][j] + t[2] * R[2][j]) > ra + rb)
+        return false;
+    }
+
+    // Cross products of the axes
+    for (int i = 0; i < 3; ++i)
+      for (int j = 0; j < 3; ++j)
+      {
+        int const i1 = (i + 1) % 3;
+        int const i2 = (i + 2) % 3;
+        int const j1 = (j + 1) % 3;
+        int const j2 = (j + 2) % 3;
+        float const ra = a._half_extents[i1] * absR[i2][j] +
+                         a._half_extents[i2] * absR[i1][j];
+        float const rb = b._half_extents[j1] * absR[i][j2] +
+                         b._half_extents[j2] * absR[i][j1];
+        if (abs(t[i2] * R[i1][j] - t[i1] * R[i2][j]) > ra + rb)
+          return false;
+      }
+
+    return true;
+  }
+};
+
+// check if an oriented box intersects with an axis-aligned box
+template <typename OBB, typename Box>
+struct intersects<OBBTag, BoxTag, OBB, Box>
+{
+  KOKKOS_FUNCTION static bool apply(OBB const &obb, Box const &box)
+  {
+    // An axis-aligned box is an oriented box in the trivial frame
+    OBB aligned;
+    for (int d = 0; d < 3; ++d)
+    {
+      aligned._centroid[d] = (box.minCorner()[d] + box.maxCorner()[d]) / 2;
+      aligned._half_extents[d] = (box.maxCorner()[d] - box.minCorner()[d]) / 2;
+    }
+    return Details::intersects(obb, aligned);
+  }
+};
+
+template <typename Box, typename OBB>
+struct intersects<BoxTag, OBBTag, Box, OBB>
+{
+  KOKKOS_FUNCTION static bool apply(Box const &box, OBB const &obb)
+  {
+    return Details::intersects(obb, box);
+  }
+};
+
+// check if an oriented box contains a point
+template <typename Point, typename OBB>
+struct intersects<PointTag, OBBTag, Point, OBB>
+{
+  KOKKOS_FUNCTION static bool apply(Point const &point, OBB const &obb)
+  {
+    using Kokkos::abs;
+
+    for (int i = 0; i < 3; ++i)
+    {
+      float local = 0;
+      for (int d = 0; d < 3; ++d)
+        local += (point[d] - obb._centroid[d]) * obb._axes[i][d];
+      if (abs(local) > obb._half_extents[i])
+        return false;
+    }
+    return true;
+  }
+};
+
+// check if a sphere intersects with an oriented box
+template <typename Sphere, typename OBB>
+struct intersects<SphereTag, OBBTag, Sphere, OBB>
+{
+  KOKKOS_FUNCTION static bool apply(Sphere const &sphere, OBB const &obb)
+  {
+    return Details::distance(sphere.centroid(), obb) <= sphere.radius();
+  }
+};
+
 template <typename Point>
 struct centroid<PointTag, Point>
 {
@@ -507,6 +778,15 @@ struct centroid<TriangleTag, Triangle>
   }
 };
 
+template <typename OBB>
+struct centroid<OBBTag, OBB>
+{
+  KOKKOS_FUNCTION static constexpr auto apply(OBB const &obb)
+  {
+    return obb._centroid;
+  }
+};
+
 } // namespace Dispatch
 
 // transformation that maps the unit cube into a new axis-aligned box
@@ -528,6 +808,137 @@ KOKKOS_FUNCTION void translateAndScale(Point const &in, Point &out,
   }
 }
 
+} // namespace Details
+
+namespace Experimental
+{
+
+// Axis-aligned periodic domain descriptor: the period of each dimension,
+// with 0 marking a dimension as open (non-periodic). All objects are assumed
+// to lie within a single primary image of the domain.
+template <int DIM, typename Coordinate = float>
+struct PeriodicDomain
+{
+  Coordinate _period[DIM] = {};
+
+  KOKKOS_DEFAULTED_FUNCTION PeriodicDomain() = default;
+
+  KOKKOS_FUNCTION constexpr PeriodicDomain(Coordinate const (&period)[DIM])
+  {
+    for (int d = 0; d < DIM; ++d)
+      _period[d] = period[d];
+  }
+
+  template <typename Box,
+            std::enable_if_t<GeometryTraits::is_box<Box>{}> * = nullptr>
+  KOKKOS_FUNCTION explicit constexpr PeriodicDomain(Box const &box)
+  {
+    static_assert(GeometryTraits::dimension_v<Box> == DIM);
+    for (int d = 0; d < DIM; ++d)
+      _period[d] = box.maxCorner()[d] - box.minCorner()[d];
+  }
+
+  KOKKOS_FUNCTION constexpr Coordinate period(int d) const
+  {
+    return _period[d];
+  }
+};
+
+} // namespace Experimental
+
+namespace Details
+{
+
+namespace Dispatch
+{
+template <typename Tag1, typename Tag2, typename Geometry1, typename Geometry2>
+struct periodicDistance;
+
+// periodic distance point-point (minimum-image convention)
+template <typename Point1, typename Point2>
+struct periodicDistance<PointTag, PointTag, Point1, Point2>
+{
+  template <typename PeriodicDomain>
+  KOKKOS_FUNCTION static auto apply(Point1 const &a, Point2 const &b,
+                                    PeriodicDomain const &domain)
+  {
+    constexpr int DIM = GeometryTraits::dimension_v<Point1>;
+    using Coordinate = decltype(b[0] - a[0]);
+    Coordinate distance_squared = 0;
+    for (int d = 0; d < DIM; ++d)
+    {
+      auto delta = Kokkos::abs(b[d] - a[d]);
+      auto const period = domain.period(d);
+      if (period > 0 && 2 * delta > period)
+        delta = period - delta;
+      distance_squared += delta * delta;
+    }
+    return Kokkos::sqrt(distance_squared);
+  }
+};
+
+// periodic distance point-box: the minimum over the images of the point. As
+// the point and the box both lie within the primary domain, only the two
+// adjacent images can come closer than the point itself.
+template <typename Point, typename Box>
+struct periodicDistance<PointTag, BoxTag, Point, Box>
+{
+  template <typename PeriodicDomain>
+  KOKKOS_FUNCTION static auto apply(Point const &point, Box const &box,
+                                    PeriodicDomain const &domain)
+  {
+    using KokkosExt::max;
+    using KokkosExt::min;
+
+    constexpr int DIM = GeometryTraits::dimension_v<Point>;
+    using Coordinate = decltype(point[0] - box.minCorner()[0]);
+    Coordinate distance_squared = 0;
+    for (int d = 0; d < DIM; ++d)
+    {
+      Coordinate const lo = box.minCorner()[d];
+      Coordinate const hi = box.maxCorner()[d];
+      Coordinate const p = point[d];
+      auto gap = max(max(lo - p, p - hi), (Coordinate)0);
+      auto const period = domain.period(d);
+      if (period > 0)
+      {
+        gap = min(gap,
+                  max(max(lo - (p - period), (p - period) - hi), (Coordinate)0));
+        gap = min(gap,
+                  max(max(lo - (p + period), (p + period) - hi), (Coordinate)0));
+      }
+      distance_squared += gap * gap;
+    }
+    return Kokkos::sqrt(distance_squared);
+  }
+};
+
+} // namespace Dispatch
+
+template <typename Geometry1, typename Geometry2, int DIM, typename Coordinate>
+KOKKOS_INLINE_FUNCTION auto
+periodicDistance(Geometry1 const &geometry1, Geometry2 const &geometry2,
+                 Experimental::PeriodicDomain<DIM, Coordinate> const &domain)
+{
+  static_assert(GeometryTraits::dimension_v<Geometry1> == DIM &&
+                GeometryTraits::dimension_v<Geometry2> == DIM);
+  return Dispatch::periodicDistance<
+      typename GeometryTraits::tag<Geometry1>::type,
+      typename GeometryTraits::tag<Geometry2>::type, Geometry1,
+      Geometry2>::apply(geometry1, geometry2, domain);
+}
+
+// check if a sphere wrapped around a periodic domain intersects a geometry
+template <typename Sphere, typename Geometry, int DIM, typename Coordinate>
+KOKKOS_INLINE_FUNCTION bool
+periodicIntersects(Sphere const &sphere, Geometry const &geometry,
+                   Experimental::PeriodicDomain<DIM, Coordinate> const &domain)
+{
+  static_assert(GeometryTraits::is_sphere<Sphere>{});
+  return periodicDistance(sphere.centroid(), geometry, domain) <=
+         sphere.radius();
+}
+
 } // namespace Details
 } // namespace ArborX
 
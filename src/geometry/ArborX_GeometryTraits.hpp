@@ -12,6 +12,7 @@
 #define ARBORX_GEOMETRY_TRAITS_HPP
 
 #include <Kokkos_DetectionIdiom.hpp>
+#include <Kokkos_Half.hpp>
 #include <Kokkos_Macros.hpp>
 
 namespace ArborX
@@ -35,6 +36,9 @@ struct TriangleTag
 struct KDOPTag
 {};
 
+struct OBBTag
+{};
+
 template <typename Geometry>
 struct dimension
 {
@@ -59,6 +63,35 @@ struct coordinate_type
   using type = not_specialized;
 };
 
+// Storage-vs-compute precision split. Coordinates may be stored in a
+// reduced-precision type (fp16/bf16) to halve the memory traffic of
+// distance scans over high-dimensional points, but accumulating distances
+// in that precision is not acceptable; distance computations accumulate in
+// the compute type instead. Full-precision coordinate types map to
+// themselves.
+template <typename Coordinate>
+struct compute_coordinate
+{
+  using type = Coordinate;
+};
+#if defined(KOKKOS_HALF_T_IS_FLOAT) && !KOKKOS_HALF_T_IS_FLOAT
+template <>
+struct compute_coordinate<Kokkos::Experimental::half_t>
+{
+  using type = float;
+};
+#endif
+#if defined(KOKKOS_BHALF_T_IS_FLOAT) && !KOKKOS_BHALF_T_IS_FLOAT
+template <>
+struct compute_coordinate<Kokkos::Experimental::bhalf_t>
+{
+  using type = float;
+};
+#endif
+
+template <typename Coordinate>
+using compute_coordinate_t = typename compute_coordinate<Coordinate>::type;
+
 template <typename Geometry>
 using DimensionNotSpecializedArchetypeAlias =
     typename dimension<Geometry>::not_specialized;
@@ -118,9 +151,9 @@ void check_valid_geometry_traits(Geometry const &)
   static_assert(std::is_same<Tag, PointTag>{} || std::is_same<Tag, BoxTag>{} ||
                     std::is_same<Tag, SphereTag>{} ||
                     std::is_same<Tag, TriangleTag>{} ||
-                    std::is_same<Tag, KDOPTag>{},
+                    std::is_same<Tag, KDOPTag>{} || std::is_same<Tag, OBBTag>{},
                 "GeometryTraits::tag<Geometry>::type must be PointTag, BoxTag, "
-                "SphereTag, TriangleTag or KDOPTag");
+                "SphereTag, TriangleTag, KDOPTag or OBBTag");
 
   static_assert(!std::is_same<typename coordinate_type<Geometry>::type,
                               not_specialized>::value,
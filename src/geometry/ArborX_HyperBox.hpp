@@ -88,8 +88,10 @@ struct Box
 
     for (int d = 0; d < DIM; ++d)
     {
-      minCorner()[d] = min(minCorner()[d], point[d]);
-      maxCorner()[d] = max(maxCorner()[d], point[d]);
+      // The point may store its coordinates in a different (possibly
+      // reduced) precision than the box
+      minCorner()[d] = min(minCorner()[d], (Coordinate)point[d]);
+      maxCorner()[d] = max(maxCorner()[d], (Coordinate)point[d]);
     }
     return *this;
   }
@@ -0,0 +1,76 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_OBB_HPP
+#define ARBORX_OBB_HPP
+
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_Point.hpp>
+
+#include <Kokkos_Macros.hpp>
+
+namespace ArborX
+{
+namespace Experimental
+{
+
+// Oriented bounding box: a box rotated into an arbitrary orthonormal frame,
+// described by its centroid, the three frame axes, and the half-extents
+// along them. Long thin primitives that run diagonally to the coordinate
+// axes (fibers, vessel segments) are bounded far tighter than by an
+// axis-aligned box. The axes are assumed to be unit length and mutually
+// orthogonal; this is not checked.
+struct OBB
+{
+  Point _centroid = {};
+  Point _axes[3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+  float _half_extents[3] = {0, 0, 0};
+
+  KOKKOS_DEFAULTED_FUNCTION
+  constexpr OBB() = default;
+
+  KOKKOS_INLINE_FUNCTION
+  constexpr OBB(Point const &centroid, Point const (&axes)[3],
+                float const (&half_extents)[3])
+      : _centroid(centroid)
+      , _axes{axes[0], axes[1], axes[2]}
+      , _half_extents{half_extents[0], half_extents[1], half_extents[2]}
+  {}
+
+  KOKKOS_INLINE_FUNCTION
+  constexpr Point const &centroid() const { return _centroid; }
+
+  KOKKOS_INLINE_FUNCTION
+  constexpr Point const &axis(int i) const { return _axes[i]; }
+
+  KOKKOS_INLINE_FUNCTION
+  constexpr float halfExtent(int i) const { return _half_extents[i]; }
+};
+
+} // namespace Experimental
+} // namespace ArborX
+
+template <>
+struct ArborX::GeometryTraits::dimension<ArborX::Experimental::OBB>
+{
+  static constexpr int value = 3;
+};
+template <>
+struct ArborX::GeometryTraits::tag<ArborX::Experimental::OBB>
+{
+  using type = OBBTag;
+};
+template <>
+struct ArborX::GeometryTraits::coordinate_type<ArborX::Experimental::OBB>
+{
+  using type = float;
+};
+
+#endif
@@ -0,0 +1,77 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_PERIODIC_SPHERE_HPP
+#define ARBORX_PERIODIC_SPHERE_HPP
+
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_HyperPoint.hpp>
+
+#include <Kokkos_Macros.hpp>
+
+namespace ArborX::Experimental
+{
+
+// Sphere-like query geometry that wraps around a periodic domain. It is
+// meant to be used as the geometry of a spatial predicate: the tree boxes
+// and the stored points are then tested against every periodic image of the
+// sphere at once, avoiding ghost replication of the primitives near the
+// domain boundary.
+template <int DIM, typename Coordinate = float>
+struct PeriodicSphere
+{
+  ExperimentalHyperGeometry::Point<DIM, Coordinate> _centroid = {};
+  Coordinate _radius = 0;
+  PeriodicDomain<DIM, Coordinate> _domain;
+
+  KOKKOS_FUNCTION constexpr auto const &centroid() const { return _centroid; }
+
+  KOKKOS_FUNCTION constexpr Coordinate radius() const { return _radius; }
+
+  KOKKOS_FUNCTION constexpr auto const &domain() const { return _domain; }
+};
+
+// Found through argument-dependent lookup from the spatial predicates,
+// taking precedence over the tag-dispatched non-periodic intersects()
+template <int DIM, typename Coordinate, typename Geometry>
+KOKKOS_INLINE_FUNCTION bool
+intersects(PeriodicSphere<DIM, Coordinate> const &sphere,
+           Geometry const &geometry)
+{
+  return Details::periodicDistance(sphere.centroid(), geometry,
+                                   sphere.domain()) <= sphere.radius();
+}
+
+} // namespace ArborX::Experimental
+
+// Registering with the sphere tag makes the predicate sorting machinery work
+// out of the box (it only looks at the centroid); actual intersection tests
+// never go through the tag dispatch thanks to the overload above.
+template <int DIM, typename Coordinate>
+struct ArborX::GeometryTraits::dimension<
+    ArborX::Experimental::PeriodicSphere<DIM, Coordinate>>
+{
+  static constexpr int value = DIM;
+};
+template <int DIM, typename Coordinate>
+struct ArborX::GeometryTraits::tag<
+    ArborX::Experimental::PeriodicSphere<DIM, Coordinate>>
+{
+  using type = SphereTag;
+};
+template <int DIM, typename Coordinate>
+struct ArborX::GeometryTraits::coordinate_type<
+    ArborX::Experimental::PeriodicSphere<DIM, Coordinate>>
+{
+  using type = Coordinate;
+};
+
+#endif
@@ -201,13 +201,137 @@ bool intersection(Ray const &ray, Box const &box, float &tmin, float &tmax)
   return (tmin <= tmax);
 }
 
+// Branch-free slab test for the boolean hit query, the innermost operation
+// of every ray traversal. The sign branch of the interval routine above is
+// replaced by min/max and the NaN case (an axis-parallel ray originating on
+// a slab plane, 0 * inf) by forcing zero numerators to a zero parameter,
+// which keeps the plane inclusive like the branchy version. The loop body
+// is straight-line code that vectorizes on host backends and does not
+// diverge on GPU. The interval routine is kept for callers that need the
+// actual entry and exit parameters.
 KOKKOS_INLINE_FUNCTION
 bool intersects(Ray const &ray, Box const &box)
 {
-  float tmin;
-  float tmax;
-  // intersects only if box is in front of the ray
-  return intersection(ray, box, tmin, tmax) && (tmax >= 0.f);
+  namespace KokkosExt = Details::KokkosExt;
+  constexpr auto inf = KokkosExt::ArithmeticTraits::infinity<float>::value;
+
+  auto const &min = box.minCorner();
+  auto const &max = box.maxCorner();
+  auto const &orig = ray.origin();
+  auto const &dir = ray.direction();
+
+  // starting from zero folds in the "box is in front of the ray" condition
+  float tmin = 0.f;
+  float tmax = inf;
+  for (int d = 0; d < 3; ++d)
+  {
+    float const inv_dir = 1.f / dir[d];
+    float const num0 = min[d] - orig[d];
+    float const num1 = max[d] - orig[d];
+    float const t0 = num0 == 0 ? 0.f : num0 * inv_dir;
+    float const t1 = num1 == 0 ? 0.f : num1 * inv_dir;
+    tmin = KokkosExt::max(tmin, KokkosExt::min(t0, t1));
+    tmax = KokkosExt::min(tmax, KokkosExt::max(t0, t1));
+  }
+  return tmin <= tmax;
+}
+
+// A ray bundled with the reciprocal of its direction. The slab tests above
+// divide by the direction components, and a tree traversal evaluates the
+// test at every visited node, so a ray predicate repeats the same three
+// divisions dozens of times per walk. Taking the reciprocal once up front
+// turns them into multiplications for the whole descent. The implicit
+// conversion back to Ray keeps all the other geometry overloads (triangles,
+// spheres) available unchanged, so a PrecomputedRay can be dropped into any
+// predicate a Ray goes into.
+struct PrecomputedRay
+{
+  Ray _ray;
+  Vector _inv_direction = {};
+
+  KOKKOS_FUNCTION constexpr operator Ray const &() const { return _ray; }
+
+  KOKKOS_FUNCTION
+  constexpr Point const &origin() const { return _ray.origin(); }
+
+  KOKKOS_FUNCTION
+  constexpr Vector const &direction() const { return _ray.direction(); }
+};
+
+KOKKOS_INLINE_FUNCTION
+PrecomputedRay makePrecomputedRay(Ray const &ray)
+{
+  PrecomputedRay r;
+  r._ray = ray;
+  // Zero components turn into infinities, which the slab tests below treat
+  // the same way as the divisions they replace
+  for (int d = 0; d < 3; ++d)
+    r._inv_direction[d] = 1.f / ray.direction()[d];
+  return r;
+}
+
+KOKKOS_INLINE_FUNCTION
+Point returnCentroid(PrecomputedRay const &ray) { return ray.origin(); }
+
+KOKKOS_INLINE_FUNCTION
+bool intersection(PrecomputedRay const &ray, Box const &box, float &tmin,
+                  float &tmax)
+{
+  auto const &min = box.minCorner();
+  auto const &max = box.maxCorner();
+  auto const &orig = ray.origin();
+  auto const &inv_dir = ray._inv_direction;
+
+  constexpr auto inf =
+      Details::KokkosExt::ArithmeticTraits::infinity<float>::value;
+  tmin = -inf;
+  tmax = inf;
+
+  for (int d = 0; d < 3; ++d)
+  {
+    float tdmin;
+    float tdmax;
+    if (inv_dir[d] >= 0)
+    {
+      tdmin = (min[d] - orig[d]) * inv_dir[d];
+      tdmax = (max[d] - orig[d]) * inv_dir[d];
+    }
+    else
+    {
+      tdmin = (max[d] - orig[d]) * inv_dir[d];
+      tdmax = (min[d] - orig[d]) * inv_dir[d];
+    }
+    if (tmin < tdmin)
+      tmin = tdmin;
+    if (tmax > tdmax)
+      tmax = tdmax;
+  }
+  return (tmin <= tmax);
+}
+
+KOKKOS_INLINE_FUNCTION
+bool intersects(PrecomputedRay const &ray, Box const &box)
+{
+  namespace KokkosExt = Details::KokkosExt;
+  constexpr auto inf = KokkosExt::ArithmeticTraits::infinity<float>::value;
+
+  auto const &min = box.minCorner();
+  auto const &max = box.maxCorner();
+  auto const &orig = ray.origin();
+  auto const &inv_dir = ray._inv_direction;
+
+  float tmin = 0.f;
+  float tmax = inf;
+  for (int d = 0; d < 3; ++d)
+  {
+    float const num0 = min[d] - orig[d];
+    float const num1 = max[d] - orig[d];
+    float const t0 = num0 == 0 ? 0.f : num0 * inv_dir[d];
+    float const t1 = num1 == 0 ? 0.f : num1 * inv_dir[d];
+    tmin = KokkosExt::max(tmin, KokkosExt::min(t0, t1));
+    tmax = KokkosExt::min(tmax, KokkosExt::max(t0, t1));
+  }
+  return tmin <= tmax;
 }
 
 // The function returns the index of the largest
@@ -461,6 +585,99 @@ intersects(Ray const &ray,
   return intersection(ray, triangle, tmin, tmax) && (tmax >= 0.f);
 }
 
+// A triangle stored as the affine transform that maps world coordinates onto
+// the unit triangle with vertices (0,0,0), (1,0,0), (0,1,0) and normal +z
+// (the "unit triangle transformation" of [1]). Building the transform once
+// per triangle moves the edge-vector and determinant setup of the full
+// Moeller-Trumbore style test out of the per-ray path; what remains per ray
+// are two matrix-vector products and a division, which compile down to a
+// handful of fused multiply-adds. This pays off for static meshes traversed
+// by many rays. Unlike the test on the raw vertices above, rays coplanar
+// with the triangle are reported as misses.
+//
+// [1] Woop, S. (2004), A Ray Tracing Hardware Architecture for Dynamic
+// Scenes, Saarland University
+struct PrecomputedTriangle
+{
+  Vector _rows[3] = {};
+  float _shift[3] = {};
+};
+
+KOKKOS_INLINE_FUNCTION
+PrecomputedTriangle makePrecomputedTriangle(
+    ExperimentalHyperGeometry::Triangle<3> const &triangle)
+{
+  auto const &a = triangle.a;
+  auto const ab = makeVector(a, triangle.b);
+  auto const ac = makeVector(a, triangle.c);
+  auto const n = crossProduct(ab, ac);
+
+  // invert the matrix with columns [ab | ac | n] through its adjugate; the
+  // determinant is n . (ab x ac) = |n|^2
+  auto const det = dotProduct(n, n);
+  KOKKOS_ASSERT(det > 0);
+  auto const row_u = crossProduct(ac, n);
+  auto const row_v = crossProduct(n, ab);
+
+  PrecomputedTriangle t;
+  for (int d = 0; d < 3; ++d)
+  {
+    t._rows[0][d] = row_u[d] / det;
+    t._rows[1][d] = row_v[d] / det;
+    t._rows[2][d] = n[d] / det;
+  }
+  for (int i = 0; i < 3; ++i)
+    t._shift[i] = -(t._rows[i][0] * a[0] + t._rows[i][1] * a[1] +
+                    t._rows[i][2] * a[2]);
+  return t;
+}
+
+KOKKOS_INLINE_FUNCTION
+bool intersection(Ray const &ray, PrecomputedTriangle const &triangle,
+                  float &tmin, float &tmax)
+{
+  namespace KokkosExt = Details::KokkosExt;
+
+  constexpr auto inf = KokkosExt::ArithmeticTraits::infinity<float>::value;
+  tmin = inf;
+  tmax = -inf;
+
+  // map the ray into the frame where the triangle is the unit triangle
+  float o[3];
+  float d[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    auto const &row = triangle._rows[i];
+    o[i] = row[0] * ray.origin()[0] + row[1] * ray.origin()[1] +
+           row[2] * ray.origin()[2] + triangle._shift[i];
+    d[i] = dotProduct(row, ray.direction());
+  }
+
+  // the triangle lives in the z = 0 plane of the transformed frame
+  if (d[2] == 0)
+    return false;
+
+  float const t = -o[2] / d[2];
+  float const u = o[0] + t * d[0];
+  float const v = o[1] + t * d[1];
+
+  constexpr float epsilon = 0.0000001f;
+  if (u < -epsilon || v < -epsilon || u + v > 1 + epsilon)
+    return false;
+
+  tmin = t;
+  tmax = t;
+  return true;
+}
+
+KOKKOS_INLINE_FUNCTION
+bool intersects(Ray const &ray, PrecomputedTriangle const &triangle)
+{
+  float tmin;
+  float tmax;
+  return intersection(ray, triangle, tmin, tmax) && (tmax >= 0.f);
+}
+
 // Returns the first positive value for t such that ray.origin + t * direction
 // intersects the given box. If no such value exists, returns inf.
 // Note that this definiton is different from the standard
@@ -477,6 +694,17 @@ float distance(Ray const &ray, Box const &box)
              : Details::KokkosExt::ArithmeticTraits::infinity<float>::value;
 }
 
+KOKKOS_INLINE_FUNCTION
+float distance(PrecomputedRay const &ray, Box const &box)
+{
+  float tmin;
+  float tmax;
+  bool intersects = intersection(ray, box, tmin, tmax) && (tmax >= 0.f);
+  return intersects
+             ? (tmin > 0.f ? tmin : 0.f)
+             : Details::KokkosExt::ArithmeticTraits::infinity<float>::value;
+}
+
 // Solves a*x^2 + b*x + c = 0.
 // If a solution exists, return true and stores roots at x1, x2.
 // If a solution does not exist, returns false.
@@ -586,6 +814,102 @@ KOKKOS_INLINE_FUNCTION float overlapDistance(Ray const &ray,
   return length;
 }
 
+// Conservative bound of a bundle of rays: a box containing all origins and
+// a per-component interval containing all directions. A frustum-box test
+// replaces the per-ray slab tests during packet traversal; it may report an
+// intersection no ray in the bundle has (the test is conservative), but
+// never misses one, so per-ray refinement at the leaves stays correct. The
+// bound is only tight when the bundle is coherent, i.e., the rays are
+// near-parallel with nearby origins.
+struct RayFrustum
+{
+  Box _origins = {};
+  Vector _direction_lo = {0, 0, 0};
+  Vector _direction_hi = {0, 0, 0};
+  int _num_rays = 0;
+};
+
+KOKKOS_INLINE_FUNCTION void expand(RayFrustum &frustum, Ray const &ray)
+{
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+
+  Details::expand(frustum._origins, ray.origin());
+  for (int d = 0; d < 3; ++d)
+  {
+    if (frustum._num_rays == 0)
+    {
+      frustum._direction_lo[d] = ray.direction()[d];
+      frustum._direction_hi[d] = ray.direction()[d];
+    }
+    else
+    {
+      frustum._direction_lo[d] =
+          KokkosExt::min(frustum._direction_lo[d], ray.direction()[d]);
+      frustum._direction_hi[d] =
+          KokkosExt::max(frustum._direction_hi[d], ray.direction()[d]);
+    }
+  }
+  ++frustum._num_rays;
+}
+
+// Interval-arithmetic slab test (in the spirit of Wald et al. (2007), Ray
+// tracing deformable scenes using dynamic bounding volume hierarchies, ACM
+// TOG 26(1)). For each axis, the union of the slab parameter intervals over
+// every ray in the bundle is bounded by multiplying the interval of origin
+// offsets with the interval of inverse directions. If the bounded intervals
+// of the three axes and [0, inf) have no common point, no ray in the bundle
+// can hit the box.
+template <typename Box>
+KOKKOS_INLINE_FUNCTION bool intersects(RayFrustum const &frustum,
+                                       Box const &box)
+{
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+  constexpr auto inf = KokkosExt::ArithmeticTraits::infinity<float>::value;
+
+  if (frustum._num_rays == 0)
+    return false;
+
+  float tmin = 0;
+  float tmax = inf;
+  for (int d = 0; d < 3; ++d)
+  {
+    auto const dir_lo = frustum._direction_lo[d];
+    auto const dir_hi = frustum._direction_hi[d];
+
+    // A bundle whose directions straddle zero in this component has rays
+    // approaching the slab from both sides; the inverse interval is then
+    // unbounded and the axis cannot cull anything
+    if (dir_lo <= 0 && dir_hi >= 0)
+      continue;
+
+    float const inv_lo = 1.f / (dir_lo < 0 ? dir_lo : dir_hi);
+    float const inv_hi = 1.f / (dir_lo < 0 ? dir_hi : dir_lo);
+
+    // interval of distances from any origin to either slab plane
+    float const offsets[] = {
+        box.minCorner()[d] - frustum._origins.maxCorner()[d],
+        box.minCorner()[d] - frustum._origins.minCorner()[d],
+        box.maxCorner()[d] - frustum._origins.maxCorner()[d],
+        box.maxCorner()[d] - frustum._origins.minCorner()[d]};
+
+    float t_lo = inf;
+    float t_hi = -inf;
+    for (auto offset : offsets)
+    {
+      t_lo = KokkosExt::min(
+          t_lo, KokkosExt::min(offset * inv_lo, offset * inv_hi));
+      t_hi = KokkosExt::max(
+          t_hi, KokkosExt::max(offset * inv_lo, offset * inv_hi));
+    }
+
+    tmin = KokkosExt::max(tmin, t_lo);
+    tmax = KokkosExt::min(tmax, t_hi);
+    if (tmin > tmax)
+      return false;
+  }
+  return true;
+}
+
 } // namespace Experimental
 } // namespace ArborX
 #endif
@@ -0,0 +1,157 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#ifndef ARBORX_ROUNDED_FLOAT_BOX_HPP
+#define ARBORX_ROUNDED_FLOAT_BOX_HPP
+
+#include <ArborX_DetailsAlgorithms.hpp>
+#include <ArborX_DetailsKokkosExtArithmeticTraits.hpp>
+#include <ArborX_DetailsKokkosExtMinMaxOperations.hpp>
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_HyperBox.hpp>
+
+#include <Kokkos_Macros.hpp>
+#include <Kokkos_MathematicalFunctions.hpp> // nextafter
+
+namespace ArborX::Experimental
+{
+
+// A single-precision axis-aligned box whose corners are rounded outward
+// when it is expanded with double-precision geometry. Used as the bounding
+// volume of a tree built over double inputs, it halves the node memory
+// traffic of the traversal while staying safe for culling: every corner is
+// rounded away from the interior, so the box always encloses the geometry
+// it was expanded with and a traversal can only visit more nodes than the
+// exact double tree, never fewer. Exact predicate evaluation still happens
+// at the leaves in the input precision.
+template <int DIM>
+struct RoundedFloatBox : ExperimentalHyperGeometry::Box<DIM, float>
+{};
+
+namespace Details
+{
+
+// Largest float not exceeding x
+KOKKOS_INLINE_FUNCTION float roundDown(double x)
+{
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+  auto const f = static_cast<float>(x);
+  return (static_cast<double>(f) > x)
+             ? Kokkos::nextafter(
+                   f, -KokkosExt::ArithmeticTraits::infinity<float>::value)
+             : f;
+}
+
+// Smallest float not less than x
+KOKKOS_INLINE_FUNCTION float roundUp(double x)
+{
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+  auto const f = static_cast<float>(x);
+  return (static_cast<double>(f) < x)
+             ? Kokkos::nextafter(
+                   f, KokkosExt::ArithmeticTraits::infinity<float>::value)
+             : f;
+}
+
+} // namespace Details
+
+} // namespace ArborX::Experimental
+
+template <int DIM>
+struct ArborX::GeometryTraits::dimension<
+    ArborX::Experimental::RoundedFloatBox<DIM>>
+{
+  static constexpr int value = DIM;
+};
+template <int DIM>
+struct ArborX::GeometryTraits::tag<ArborX::Experimental::RoundedFloatBox<DIM>>
+{
+  using type = BoxTag;
+};
+template <int DIM>
+struct ArborX::GeometryTraits::coordinate_type<
+    ArborX::Experimental::RoundedFloatBox<DIM>>
+{
+  using type = float;
+};
+
+template <int DIM, typename Point>
+struct ArborX::Details::Dispatch::expand<
+    ArborX::GeometryTraits::BoxTag, ArborX::GeometryTraits::PointTag,
+    ArborX::Experimental::RoundedFloatBox<DIM>, Point>
+{
+  using RoundedFloatBox = ArborX::Experimental::RoundedFloatBox<DIM>;
+
+  KOKKOS_FUNCTION static void apply(RoundedFloatBox &box, Point const &point)
+  {
+    using ArborX::Experimental::Details::roundDown;
+    using ArborX::Experimental::Details::roundUp;
+    using KokkosExt::max;
+    using KokkosExt::min;
+
+    for (int d = 0; d < DIM; ++d)
+    {
+      box.minCorner()[d] = min(box.minCorner()[d], roundDown(point[d]));
+      box.maxCorner()[d] = max(box.maxCorner()[d], roundUp(point[d]));
+    }
+  }
+};
+
+template <int DIM, typename Box>
+struct ArborX::Details::Dispatch::expand<
+    ArborX::GeometryTraits::BoxTag, ArborX::GeometryTraits::BoxTag,
+    ArborX::Experimental::RoundedFloatBox<DIM>, Box>
+{
+  using RoundedFloatBox = ArborX::Experimental::RoundedFloatBox<DIM>;
+
+  KOKKOS_FUNCTION static void apply(RoundedFloatBox &box, Box const &other)
+  {
+    using ArborX::Experimental::Details::roundDown;
+    using ArborX::Experimental::Details::roundUp;
+    using KokkosExt::max;
+    using KokkosExt::min;
+
+    for (int d = 0; d < DIM; ++d)
+    {
+      box.minCorner()[d] =
+          min(box.minCorner()[d], roundDown(other.minCorner()[d]));
+      box.maxCorner()[d] =
+          max(box.maxCorner()[d], roundUp(other.maxCorner()[d]));
+    }
+  }
+};
+
+template <int DIM, typename Sphere>
+struct ArborX::Details::Dispatch::expand<
+    ArborX::GeometryTraits::BoxTag, ArborX::GeometryTraits::SphereTag,
+    ArborX::Experimental::RoundedFloatBox<DIM>, Sphere>
+{
+  using RoundedFloatBox = ArborX::Experimental::RoundedFloatBox<DIM>;
+
+  KOKKOS_FUNCTION static void apply(RoundedFloatBox &box, Sphere const &sphere)
+  {
+    using ArborX::Experimental::Details::roundDown;
+    using ArborX::Experimental::Details::roundUp;
+    using KokkosExt::max;
+    using KokkosExt::min;
+
+    for (int d = 0; d < DIM; ++d)
+    {
+      box.minCorner()[d] =
+          min(box.minCorner()[d],
+              roundDown(sphere.centroid()[d] - sphere.radius()));
+      box.maxCorner()[d] =
+          max(box.maxCorner()[d],
+              roundUp(sphere.centroid()[d] + sphere.radius()));
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,351 @@
+/****************************************************************************
+ * Copyright (c) 2023 by the ArborX authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_INTERP_DISTRIBUTED_MOVING_LEAST_SQUARES_HPP
+#define ARBORX_INTERP_DISTRIBUTED_MOVING_LEAST_SQUARES_HPP
+
+#include <ArborX_AccessTraits.hpp>
+#include <ArborX_DetailsDistributedTreeUtils.hpp>
+#include <ArborX_DetailsDistributor.hpp>
+#include <ArborX_DetailsKokkosExtViewHelpers.hpp>
+#include <ArborX_DistributedTree.hpp>
+#include <ArborX_Exception.hpp>
+#include <ArborX_GeometryTraits.hpp>
+#include <ArborX_InterpDetailsCompactRadialBasisFunction.hpp>
+#include <ArborX_InterpDetailsMovingLeastSquaresCoefficients.hpp>
+#include <ArborX_InterpDetailsPolynomialBasis.hpp>
+#include <ArborX_PairIndexRank.hpp>
+#include <ArborX_Predicates.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <memory>
+#include <optional>
+
+#include <mpi.h>
+
+namespace ArborX::Interpolation
+{
+
+// Moving least squares interpolation when the source and target clouds live
+// on different MPI partitions. The k nearest source points of every target
+// are found with a DistributedTree query, their coordinates are shipped once
+// at construction from the ranks that own them, and the coefficients are
+// computed locally from there. Each apply then only exchanges the values of
+// those same points, so nothing proportional to the global source cloud is
+// ever allocated or communicated.
+//
+// The constructor and interpolate() must be called collectively on all ranks
+// of the communicator.
+template <typename MemorySpace, typename FloatingCalculationType = double>
+class DistributedMovingLeastSquares
+{
+public:
+  template <typename ExecutionSpace, typename SourcePoints,
+            typename TargetPoints, typename CRBFunc = CRBF::Wendland<0>,
+            typename PolynomialDegree = PolynomialDegree<2>>
+  DistributedMovingLeastSquares(MPI_Comm comm, ExecutionSpace const &space,
+                                SourcePoints const &source_points,
+                                TargetPoints const &target_points, CRBFunc = {},
+                                PolynomialDegree = {},
+                                std::optional<int> num_neighbors = std::nullopt)
+  {
+    namespace KokkosExt = ArborX::Details::KokkosExt;
+    namespace DT = ArborX::Details::DistributedTree;
+
+    auto guard =
+        Kokkos::Profiling::ScopedRegion("ArborX::DistributedMovingLeastSquares");
+
+    static_assert(
+        KokkosExt::is_accessible_from<MemorySpace, ExecutionSpace>::value,
+        "Memory space must be accessible from the execution space");
+
+    // SourcePoints is an access trait of points
+    ArborX::Details::check_valid_access_traits(PrimitivesTag{}, source_points);
+    using SourceAccess =
+        ArborX::Details::AccessValues<SourcePoints, PrimitivesTag>;
+    static_assert(
+        KokkosExt::is_accessible_from<typename SourceAccess::memory_space,
+                                      ExecutionSpace>::value,
+        "Source points must be accessible from the execution space");
+    using SourcePoint = typename SourceAccess::value_type;
+    GeometryTraits::check_valid_geometry_traits(SourcePoint{});
+    static_assert(GeometryTraits::is_point<SourcePoint>::value,
+                  "Source points elements must be points");
+    static constexpr int dimension = GeometryTraits::dimension_v<SourcePoint>;
+
+    // TargetPoints is an access trait of points
+    ArborX::Details::check_valid_access_traits(PrimitivesTag{}, target_points);
+    using TargetAccess =
+        ArborX::Details::AccessValues<TargetPoints, PrimitivesTag>;
+    static_assert(
+        KokkosExt::is_accessible_from<typename TargetAccess::memory_space,
+                                      ExecutionSpace>::value,
+        "Target points must be accessible from the execution space");
+    using TargetPoint = typename TargetAccess::value_type;
+    GeometryTraits::check_valid_geometry_traits(TargetPoint{});
+    static_assert(GeometryTraits::is_point<TargetPoint>::value,
+                  "Target points elements must be points");
+    static_assert(dimension == GeometryTraits::dimension_v<TargetPoint>,
+                  "Target and source points must have the same dimension");
+
+    _num_neighbors =
+        num_neighbors ? *num_neighbors
+                      : Details::polynomialBasisSize<dimension,
+                                                     PolynomialDegree::value>();
+
+    TargetAccess target_access{target_points};
+    SourceAccess source_access{source_points};
+
+    _num_targets = target_access.size();
+    _source_size = source_access.size();
+
+    // Find the k nearest source points of every target, wherever they live
+    DistributedTree<MemorySpace> source_tree(comm, space, source_points);
+    ARBORX_ASSERT(std::size_t(_num_neighbors) <= source_tree.size());
+
+    Kokkos::View<decltype(nearest(TargetPoint{}, 0)) *, MemorySpace> predicates(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedMovingLeastSquares::predicates"),
+        _num_targets);
+    int const num_neighbors = _num_neighbors;
+    Kokkos::parallel_for(
+        "ArborX::DistributedMovingLeastSquares::make_predicates",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, _num_targets),
+        KOKKOS_LAMBDA(int const i) {
+          predicates(i) = nearest(target_access(i), num_neighbors);
+        });
+
+    Kokkos::View<PairIndexRank *, MemorySpace> values(
+        "ArborX::DistributedMovingLeastSquares::values", 0);
+    Kokkos::View<int *, MemorySpace> offset(
+        "ArborX::DistributedMovingLeastSquares::offset", 0);
+    source_tree.query(space, predicates, values, offset);
+
+    // With enough source points globally, every target gets exactly k
+    // results, so the offsets are implied and the flat slot of neighbor j of
+    // target i is i * k + j
+    int const n_exports = _num_targets * _num_neighbors;
+    ARBORX_ASSERT(KokkosExt::lastElement(space, offset) == n_exports);
+
+    // Request the coordinates of the neighbors from their owning ranks. The
+    // flat slot travels with each request so that the reply can be scattered
+    // back regardless of how the messages were laid out.
+    Kokkos::View<int *, MemorySpace> export_ranks(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedMovingLeastSquares::export_ranks"),
+        n_exports);
+    Kokkos::View<int *, MemorySpace> export_indices(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedMovingLeastSquares::export_indices"),
+        n_exports);
+    Kokkos::View<int *, MemorySpace> export_ids(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedMovingLeastSquares::export_ids"),
+        n_exports);
+    Kokkos::parallel_for(
+        "ArborX::DistributedMovingLeastSquares::fill_requests",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_exports),
+        KOKKOS_LAMBDA(int const i) {
+          export_ranks(i) = values(i).rank;
+          export_indices(i) = values(i).index;
+          export_ids(i) = i;
+        });
+
+    ArborX::Details::Distributor<MemorySpace> request_distributor(comm);
+    int const n_imports =
+        request_distributor.createFromSends(space, export_ranks);
+
+    Kokkos::View<int *, MemorySpace> import_indices(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedMovingLeastSquares::import_indices"),
+        n_imports);
+    Kokkos::View<int *, MemorySpace> import_ids(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedMovingLeastSquares::import_ids"),
+        n_imports);
+    DT::sendAcrossNetworkFused(space, request_distributor, export_indices,
+                               import_indices, export_ids, import_ids);
+
+    Kokkos::View<int *, MemorySpace> import_ranks(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedMovingLeastSquares::import_ranks"),
+        n_imports);
+    DT::fillImportRanks(space, request_distributor, import_ranks);
+
+    // Reply with the requested points. The reply plan is kept: every apply
+    // replays it to ship the values of the very same points.
+    _distributor =
+        std::make_shared<ArborX::Details::Distributor<MemorySpace>>(comm);
+    int const n_replies = _distributor->createFromSends(space, import_ranks);
+    ARBORX_ASSERT(n_replies == n_exports);
+
+    Kokkos::View<SourcePoint *, MemorySpace> send_points(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedMovingLeastSquares::send_points"),
+        n_imports);
+    Kokkos::parallel_for(
+        "ArborX::DistributedMovingLeastSquares::gather_points",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_imports),
+        KOKKOS_LAMBDA(int const j) {
+          send_points(j) = source_access(import_indices(j));
+        });
+
+    Kokkos::View<SourcePoint *, MemorySpace> recv_points(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedMovingLeastSquares::recv_points"),
+        n_exports);
+    _recv_ids = Kokkos::View<int *, MemorySpace>(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::DistributedMovingLeastSquares::recv_ids"),
+        n_exports);
+    DT::sendAcrossNetworkFused(space, *_distributor, send_points, recv_points,
+                               import_ids, _recv_ids);
+
+    _import_indices = import_indices;
+
+    // From here on the problem is local: scatter the ghosted points into one
+    // row per target and hand them to the batched coefficients kernel
+    Kokkos::View<SourcePoint **, MemorySpace> gathered_points(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedMovingLeastSquares::source_points"),
+        _num_targets, _num_neighbors);
+    auto const recv_ids = _recv_ids;
+    Kokkos::parallel_for(
+        "ArborX::DistributedMovingLeastSquares::scatter_points",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_exports),
+        KOKKOS_LAMBDA(int const j) {
+          gathered_points(recv_ids(j) / num_neighbors,
+                          recv_ids(j) % num_neighbors) = recv_points(j);
+        });
+
+    _coeffs = Details::movingLeastSquaresCoefficients<CRBFunc, PolynomialDegree,
+                                                      FloatingCalculationType>(
+        space, gathered_points, target_access);
+  }
+
+  template <typename ExecutionSpace, typename SourceValues,
+            typename ApproxValues>
+  void interpolate(ExecutionSpace const &space,
+                   SourceValues const &source_values,
+                   ApproxValues &approx_values) const
+  {
+    auto guard = Kokkos::Profiling::ScopedRegion(
+        "ArborX::DistributedMovingLeastSquares::interpolate");
+
+    namespace KokkosExt = ArborX::Details::KokkosExt;
+    namespace DT = ArborX::Details::DistributedTree;
+
+    static_assert(
+        KokkosExt::is_accessible_from<MemorySpace, ExecutionSpace>::value,
+        "Memory space must be accessible from the execution space");
+
+    // SourceValues is a 1D view of the local source values
+    static_assert(Kokkos::is_view_v<SourceValues> && SourceValues::rank == 1,
+                  "Source values must be a 1D view of values");
+    static_assert(
+        KokkosExt::is_accessible_from<typename SourceValues::memory_space,
+                                      ExecutionSpace>::value,
+        "Source values must be accessible from the execution space");
+
+    // ApproxValues is a writable 1D view for the local target values
+    static_assert(Kokkos::is_view_v<ApproxValues> && ApproxValues::rank == 1,
+                  "Approx values must be a 1D view of values");
+    static_assert(
+        KokkosExt::is_accessible_from<typename ApproxValues::memory_space,
+                                      ExecutionSpace>::value,
+        "Approx values must be accessible from the execution space");
+    static_assert(!std::is_const_v<typename ApproxValues::value_type>,
+                  "Approx values must be writable");
+
+    KOKKOS_ASSERT(_source_size == source_values.extent_int(0));
+    KOKKOS_ASSERT(approx_values.extent_int(0) == _num_targets);
+
+    using Value = typename ApproxValues::non_const_value_type;
+
+    int const n_imports = _import_indices.extent_int(0);
+    int const n_exports = _num_targets * _num_neighbors;
+
+    // Ship the values of the source points other ranks gathered from us at
+    // construction. The plan is replayed, so the receive layout is the same
+    // as for the points and the stored slot ids still apply.
+    auto const import_indices = _import_indices;
+    Kokkos::View<Value *, MemorySpace> send_values(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedMovingLeastSquares::send_values"),
+        n_imports);
+    Kokkos::parallel_for(
+        "ArborX::DistributedMovingLeastSquares::gather_values",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_imports),
+        KOKKOS_LAMBDA(int const j) {
+          send_values(j) = source_values(import_indices(j));
+        });
+
+    Kokkos::View<Value *, MemorySpace> recv_values(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedMovingLeastSquares::recv_values"),
+        n_exports);
+    DT::sendAcrossNetwork(space, *_distributor, send_values, recv_values);
+
+    Kokkos::View<Value *, MemorySpace> ghost_values(
+        Kokkos::view_alloc(
+            space, Kokkos::WithoutInitializing,
+            "ArborX::DistributedMovingLeastSquares::ghost_values"),
+        n_exports);
+    auto const recv_ids = _recv_ids;
+    Kokkos::parallel_for(
+        "ArborX::DistributedMovingLeastSquares::scatter_values",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_exports),
+        KOKKOS_LAMBDA(int const j) {
+          ghost_values(recv_ids(j)) = recv_values(j);
+        });
+
+    Kokkos::parallel_for(
+        "ArborX::DistributedMovingLeastSquares::target_interpolation",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, _num_targets),
+        KOKKOS_CLASS_LAMBDA(int const i) {
+          Value tmp = 0;
+          for (int j = 0; j < _num_neighbors; j++)
+            tmp += _coeffs(i, j) * ghost_values(i * _num_neighbors + j);
+          approx_values(i) = tmp;
+        });
+  }
+
+private:
+  Kokkos::View<FloatingCalculationType **, MemorySpace> _coeffs;
+  // Local source indices whose values must be shipped on every apply, in the
+  // order the reply plan sends them
+  Kokkos::View<int *, MemorySpace> _import_indices;
+  // Flat (target * k + neighbor) slot of every received entry
+  Kokkos::View<int *, MemorySpace> _recv_ids;
+  // Reply-direction communication plan, built once at construction
+  std::shared_ptr<ArborX::Details::Distributor<MemorySpace>> _distributor;
+  int _num_targets;
+  int _num_neighbors;
+  int _source_size;
+};
+
+} // namespace ArborX::Interpolation
+
+#endif
@@ -13,7 +13,7 @@
 #define ARBORX_INTERP_MOVING_LEAST_SQUARES_HPP
 
 #include <ArborX_AccessTraits.hpp>
-#include <ArborX_DetailsLegacy.hpp>
+#include <ArborX_Callbacks.hpp>
 #include <ArborX_GeometryTraits.hpp>
 #include <ArborX_HyperBox.hpp>
 #include <ArborX_IndexableGetter.hpp>
@@ -21,6 +21,7 @@
 #include <ArborX_InterpDetailsMovingLeastSquaresCoefficients.hpp>
 #include <ArborX_InterpDetailsPolynomialBasis.hpp>
 #include <ArborX_LinearBVH.hpp>
+#include <ArborX_PairValueIndex.hpp>
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_Profiling_ScopedRegion.hpp>
@@ -30,67 +31,169 @@
 namespace ArborX::Interpolation::Details
 {
 
-// This is done to avoid a clash with another predicates access trait
-template <typename TargetAccess>
-struct MLSPredicateWrapper
+// Fused search-and-assembly kernel: each thread walks the source tree in
+// distance order for its own target, gathers the nearest source points into
+// scratch and assembles the coefficient row in place. Compared to the
+// two-phase pipeline (query materializing a num_targets x num_neighbors
+// array of points, then the batched coefficients kernel re-reading it), the
+// per-target source points never exist in global memory.
+template <typename SourceTree, typename TargetAccess, typename Indices,
+          typename Coefficients, typename Counts, typename ExecutionSpace,
+          typename CRBFunc, typename PolynomialDegree,
+          typename CoefficientsType>
+class MLSFusedCoefficientsKernel
 {
-  TargetAccess target_access;
-  int num_neighbors;
-};
+private:
+  using ScratchMemorySpace = typename ExecutionSpace::scratch_memory_space;
 
-// Functor used in the tree query to create the 2D source view and indices
-template <typename SourceView, typename IndicesView, typename CounterView>
-struct MLSSearchNeighborsCallback
-{
-  SourceView source_view;
-  IndicesView indices;
-  CounterView counter;
+  using SourcePoint = typename SourceTree::value_type::value_type;
 
-  using SourcePoint = typename SourceView::non_const_value_type;
+  static constexpr int dimension = GeometryTraits::dimension_v<SourcePoint>;
+  static constexpr int degree = PolynomialDegree::value;
+  static constexpr int poly_size =
+      Details::polynomialBasisSize<dimension, degree>();
 
-  template <typename Predicate>
-  KOKKOS_FUNCTION void
-  operator()(Predicate const &predicate,
-             ArborX::PairValueIndex<SourcePoint> const &primitive) const
-  {
-    int const target = getData(predicate);
-    int const source = primitive.index;
-    auto count = Kokkos::atomic_fetch_add(&counter(target), 1);
-    indices(target, count) = source;
-    source_view(target, count) = primitive.value;
-  }
-};
+  template <typename T>
+  using ScratchView =
+      Kokkos::View<T, ScratchMemorySpace, Kokkos::MemoryUnmanaged>;
 
-} // namespace ArborX::Interpolation::Details
+  using LocalSourcePoints = ScratchView<SourcePoint *>;
+  using LocalPhi = ScratchView<CoefficientsType *>;
+  using LocalVandermonde = ScratchView<CoefficientsType *[poly_size]>;
+  using LocalMoment = ScratchView<CoefficientsType[poly_size][poly_size]>;
+  using LocalSVDDiag = ScratchView<CoefficientsType[poly_size]>;
+  using LocalSVDUnit = ScratchView<CoefficientsType[poly_size][poly_size]>;
 
-namespace ArborX
-{
+public:
+  // An empty 'counts' view selects the fixed stencil: every target uses all
+  // _num_neighbors gathered points and 'min_neighbors' is ignored
+  MLSFusedCoefficientsKernel(ExecutionSpace const &,
+                             SourceTree const &source_tree,
+                             TargetAccess const &target_access,
+                             Indices const &indices,
+                             Coefficients const &coefficients,
+                             Counts const &counts, int min_neighbors)
+      : _source_tree(source_tree)
+      , _target_access(target_access)
+      , _indices(indices)
+      , _coefficients(coefficients)
+      , _counts(counts)
+      , _num_targets(target_access.size())
+      , _num_neighbors(indices.extent_int(1))
+      , _min_neighbors(min_neighbors)
+  {}
+
+  template <typename TeamMember>
+  KOKKOS_FUNCTION void operator()(TeamMember const &member) const
+  {
+    auto const &scratch = member.thread_scratch(0);
+
+    int target = member.league_rank() * member.team_size() + member.team_rank();
+    if (target >= _num_targets)
+      return;
+
+    auto target_point = _target_access(target);
+    LocalSourcePoints source_points(scratch, _num_neighbors);
+    LocalPhi phi(scratch, _num_neighbors);
+    LocalVandermonde vandermonde(scratch, _num_neighbors);
+    LocalMoment moment(scratch);
+    LocalSVDDiag svd_diag(scratch);
+    LocalSVDUnit svd_unit(scratch);
+    auto coefficients = Kokkos::subview(_coefficients, target, Kokkos::ALL);
+
+    // The ordered traversal reports the leaves by increasing distance, so
+    // the first k reported values are exactly the k nearest source points
+    int count = 0;
+    auto const &indices = _indices;
+    auto const num_neighbors = _num_neighbors;
+    _source_tree.query(
+        Experimental::PerThread{},
+        Experimental::ordered_intersects(target_point),
+        [&](auto const &, PairValueIndex<SourcePoint> const &value) {
+          indices(target, count) = value.index;
+          source_points(count) = value.value;
+          return (++count < num_neighbors)
+                     ? ArborX::Details::CallbackTreeTraversalControl::
+                           normal_continuation
+                     : ArborX::Details::CallbackTreeTraversalControl::
+                           early_exit;
+        });
 
-template <typename TargetAccess>
-struct AccessTraits<Interpolation::Details::MLSPredicateWrapper<TargetAccess>,
-                    PredicatesTag>
-{
-  using Self = Interpolation::Details::MLSPredicateWrapper<TargetAccess>;
+    bool const adaptive = (_counts.size() != 0);
+    int const num_used =
+        adaptiveMovingLeastSquaresCoefficientsPerTarget<CRBFunc,
+                                                        PolynomialDegree>(
+            target_point, source_points,
+            adaptive ? _min_neighbors : num_neighbors, phi, vandermonde,
+            moment, svd_diag, svd_unit, coefficients);
+    if (adaptive)
+      _counts(target) = num_used;
+  }
 
-  KOKKOS_FUNCTION static auto size(Self const &tp)
+  Kokkos::TeamPolicy<ExecutionSpace>
+  makePolicy(ExecutionSpace const &space) const
   {
-    return tp.target_access.size();
+    Kokkos::TeamPolicy<ExecutionSpace> dummy_policy(space, 1, Kokkos::AUTO);
+    dummy_policy.set_scratch_size(0, Kokkos::PerThread(perTargetMem()));
+    int team_size =
+        dummy_policy.team_size_recommended(*this, Kokkos::ParallelForTag{});
+    if (team_size != 0)
+    {
+      int league_size = (_num_targets + team_size - 1) / team_size;
+      return Kokkos::TeamPolicy<ExecutionSpace>(space, league_size, team_size)
+          .set_scratch_size(0, Kokkos::PerThread(perTargetMem()));
+    }
+    return Kokkos::TeamPolicy<ExecutionSpace>(space, _num_targets, 1, 1)
+        .set_scratch_size(0, Kokkos::PerTeam(perTargetMem()));
   }
 
-  KOKKOS_FUNCTION static auto get(Self const &tp, int const i)
+private:
+  std::size_t perTargetMem() const
   {
-    return attach(nearest(tp.target_access(i), tp.num_neighbors), i);
+    std::size_t val = 0;
+    val += LocalSourcePoints::shmem_size(_num_neighbors);
+    val += LocalPhi::shmem_size(_num_neighbors);
+    val += LocalVandermonde::shmem_size(_num_neighbors);
+    val += LocalMoment::shmem_size();
+    val += LocalSVDDiag::shmem_size();
+    val += LocalSVDUnit::shmem_size();
+    return val;
   }
 
-  using memory_space = typename TargetAccess::memory_space;
+  SourceTree _source_tree;
+  TargetAccess _target_access;
+  Indices _indices;
+  Coefficients _coefficients;
+  Counts _counts;
+  int _num_targets;
+  int _num_neighbors;
+  int _min_neighbors;
 };
 
-} // namespace ArborX
+} // namespace ArborX::Interpolation::Details
 
 namespace ArborX::Interpolation
 {
 
-template <typename MemorySpace, typename FloatingCalculationType = double>
+// Requests per-target adaptive stencil sizes. The stencil of each target
+// starts at min_neighbors source points (the polynomial basis size when
+// zero) and only grows -- up to max_neighbors -- while its moment matrix is
+// rank-deficient. A single global neighbor count has to be sized for the
+// worst-conditioned target; on clouds with large density contrasts most
+// targets need far fewer points than that, and the assembly cost scales with
+// the stencil size.
+struct AdaptiveStencil
+{
+  int max_neighbors;
+  int min_neighbors = 0;
+};
+
+// FloatingCalculationType is the precision the coefficients are computed in;
+// CoefficientStorageType is the precision they are stored (and applied) in.
+// Storing in float while accumulating in double halves the footprint of the
+// operator at a negligible accuracy cost for most transfers.
+template <typename MemorySpace, typename FloatingCalculationType = double,
+          typename CoefficientStorageType = FloatingCalculationType>
 class MovingLeastSquares
 {
 public:
@@ -102,6 +205,40 @@ public:
                      TargetPoints const &target_points, CRBFunc = {},
                      PolynomialDegree = {},
                      std::optional<int> num_neighbors = std::nullopt)
+  {
+    build<CRBFunc, PolynomialDegree>(space, source_points, target_points,
+                                     num_neighbors.value_or(0), 0);
+  }
+
+  // Adaptive-stencil variant: each target uses only as many neighbors as its
+  // moment matrix needs to be well-conditioned (see AdaptiveStencil). The
+  // coefficient storage is still dense at stencil.max_neighbors per row, but
+  // both the assembly and the apply stop at the per-target count.
+  template <typename ExecutionSpace, typename SourcePoints,
+            typename TargetPoints, typename CRBFunc = CRBF::Wendland<0>,
+            typename PolynomialDegree = PolynomialDegree<2>>
+  MovingLeastSquares(ExecutionSpace const &space,
+                     SourcePoints const &source_points,
+                     TargetPoints const &target_points,
+                     AdaptiveStencil const &stencil, CRBFunc = {},
+                     PolynomialDegree = {})
+  {
+    build<CRBFunc, PolynomialDegree>(space, source_points, target_points,
+                                     stencil.max_neighbors,
+                                     stencil.min_neighbors > 0
+                                         ? stencil.min_neighbors
+                                         : -1);
+  }
+
+private:
+  // num_neighbors <= 0 requests the default (the polynomial basis size);
+  // min_neighbors == 0 selects the fixed stencil, -1 the default minimum
+  template <typename CRBFunc, typename PolynomialDegree,
+            typename ExecutionSpace, typename SourcePoints,
+            typename TargetPoints>
+  void build(ExecutionSpace const &space, SourcePoints const &source_points,
+             TargetPoints const &target_points, int num_neighbors,
+             int min_neighbors)
   {
     namespace KokkosExt = ArborX::Details::KokkosExt;
 
@@ -140,10 +277,13 @@ public:
     static_assert(dimension == GeometryTraits::dimension_v<TargetPoint>,
                   "Target and source points must have the same dimension");
 
+    constexpr int default_num_neighbors =
+        Details::polynomialBasisSize<dimension, PolynomialDegree::value>();
     _num_neighbors =
-        num_neighbors ? *num_neighbors
-                      : Details::polynomialBasisSize<dimension,
-                                                     PolynomialDegree::value>();
+        (num_neighbors > 0) ? num_neighbors : default_num_neighbors;
+    bool const adaptive = (min_neighbors != 0);
+    int const stencil_min =
+        (min_neighbors > 0) ? min_neighbors : default_num_neighbors;
 
     TargetAccess target_access{target_points};
     SourceAccess source_access{source_points};
@@ -152,16 +292,71 @@ public:
     _source_size = source_access.size();
     // There must be enough source points
     KOKKOS_ASSERT(0 < _num_neighbors && _num_neighbors <= _source_size);
+    KOKKOS_ASSERT(!adaptive ||
+                  (0 < stencil_min && stencil_min <= _num_neighbors));
+
+    // Organize the source points as a tree
+    BoundingVolumeHierarchy<MemorySpace, ArborX::PairValueIndex<SourcePoint>>
+        source_tree(space, ArborX::Experimental::attach_indices(source_access));
 
-    // Search for neighbors and get the arranged source points
-    auto source_view = searchNeighbors(space, source_access, target_access);
+    _indices = Kokkos::View<int **, MemorySpace>(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::MovingLeastSquares::indices"),
+        _num_targets, _num_neighbors);
+    _coeffs = Kokkos::View<CoefficientStorageType **, MemorySpace>(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                           "ArborX::MovingLeastSquares::coefficients"),
+        _num_targets, _num_neighbors);
+    if (adaptive)
+      _counts = Kokkos::View<int *, MemorySpace>(
+          Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                             "ArborX::MovingLeastSquares::counts"),
+          _num_targets);
+
+    // Each thread searches the neighbors of its own target and assembles its
+    // coefficient row in one go, so the gathered source points only ever
+    // live in scratch memory
+    Details::MLSFusedCoefficientsKernel<
+        decltype(source_tree), TargetAccess, decltype(_indices),
+        decltype(_coeffs), decltype(_counts), ExecutionSpace, CRBFunc,
+        PolynomialDegree, FloatingCalculationType>
+        kernel(space, source_tree, target_access, _indices, _coeffs, _counts,
+               stencil_min);
+
+    Kokkos::parallel_for("ArborX::MovingLeastSquares::fused_coefficients",
+                         kernel.makePolicy(space), kernel);
+  }
 
-    // Compute the moving least squares coefficients
-    _coeffs = Details::movingLeastSquaresCoefficients<CRBFunc, PolynomialDegree,
-                                                      FloatingCalculationType>(
-        space, source_view, target_access._values);
+public:
+  // Rebind a previously computed interpolation state (see coefficients() and
+  // indices()). For fixed source and target clouds, building the coefficients
+  // is orders of magnitude more expensive than applying them, so a caller
+  // that recreates the interpolator every transfer step -- or restarts from a
+  // checkpoint -- can save the two views once and reconstruct from them. The
+  // state is only valid for the exact source points it was computed with;
+  // this is not checked beyond the sizes.
+  MovingLeastSquares(
+      Kokkos::View<CoefficientStorageType **, MemorySpace> const &coefficients,
+      Kokkos::View<int **, MemorySpace> const &indices, int source_size)
+      : _coeffs(coefficients)
+      , _indices(indices)
+      , _num_targets(coefficients.extent_int(0))
+      , _num_neighbors(coefficients.extent_int(1))
+      , _source_size(source_size)
+  {
+    KOKKOS_ASSERT(coefficients.extent(0) == indices.extent(0) &&
+                  coefficients.extent(1) == indices.extent(1));
+    KOKKOS_ASSERT(source_size >= _num_neighbors);
   }
 
+  // Computed interpolation state: one row of coefficients and of source
+  // indices per target point. Exposed so that the caller can persist them
+  // (ArborX does not prescribe an I/O format) and rebind them later through
+  // the constructor above.
+  auto const &coefficients() const { return _coeffs; }
+  auto const &indices() const { return _indices; }
+  int sourceSize() const { return _source_size; }
+
   template <typename ExecutionSpace, typename SourceValues,
             typename ApproxValues>
   void interpolate(ExecutionSpace const &space,
@@ -177,17 +372,22 @@ public:
         KokkosExt::is_accessible_from<MemorySpace, ExecutionSpace>::value,
         "Memory space must be accessible from the execution space");
 
-    // SourceValues is a 1D view of all source values
-    static_assert(Kokkos::is_view_v<SourceValues> && SourceValues::rank == 1,
-                  "Source values must be a 1D view of values");
+    // SourceValues is a 1D view of all source values, or a 2D view holding
+    // one column per field when several fields are transferred through the
+    // same operator
+    static_assert(Kokkos::is_view_v<SourceValues> &&
+                      (SourceValues::rank == 1 || SourceValues::rank == 2),
+                  "Source values must be a 1D or 2D view of values");
     static_assert(
         KokkosExt::is_accessible_from<typename SourceValues::memory_space,
                                       ExecutionSpace>::value,
         "Source values must be accessible from the execution space");
 
-    // ApproxValues is a 1D view for approximated values
-    static_assert(Kokkos::is_view_v<ApproxValues> && ApproxValues::rank == 1,
-                  "Approx values must be a 1D view");
+    // ApproxValues is a view for approximated values of the same rank
+    static_assert(Kokkos::is_view_v<ApproxValues> &&
+                      ApproxValues::rank == SourceValues::rank,
+                  "Approx values must be a view of the same rank as the "
+                  "source values");
     static_assert(
         KokkosExt::is_accessible_from<typename ApproxValues::memory_space,
                                       ExecutionSpace>::value,
@@ -204,59 +404,67 @@ public:
 
     using Value = typename ApproxValues::non_const_value_type;
 
-    Kokkos::parallel_for(
-        "ArborX::MovingLeastSquares::target_interpolation",
-        Kokkos::RangePolicy<ExecutionSpace>(space, 0, _num_targets),
-        KOKKOS_CLASS_LAMBDA(int const i) {
-          Value tmp = 0;
-          for (int j = 0; j < _num_neighbors; j++)
-            tmp += _coeffs(i, j) * source_values(_indices(i, j));
-          approx_values(i) = tmp;
-        });
+    // The apply is an ELLPACK-style product: every row has the same capacity,
+    // so there is no row-pointer indirection, and with the backend's default
+    // view layout (column-major on GPUs) the j-loop below reads _coeffs and
+    // _indices fully coalesced across threads. Only the source_values gather
+    // is irregular. With adaptive stencils each row stops at its own count
+    // (the coefficient tails are zero anyway).
+    if constexpr (SourceValues::rank == 1)
+    {
+      Kokkos::parallel_for(
+          "ArborX::MovingLeastSquares::target_interpolation",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, _num_targets),
+          KOKKOS_CLASS_LAMBDA(int const i) {
+            int const row_width =
+                (_counts.size() != 0) ? _counts(i) : _num_neighbors;
+            Value tmp = 0;
+            for (int j = 0; j < row_width; j++)
+              tmp += _coeffs(i, j) * source_values(_indices(i, j));
+            approx_values(i) = tmp;
+          });
+    }
+    else
+    {
+      KOKKOS_ASSERT(approx_values.extent(1) == source_values.extent(1));
+      int const num_fields = source_values.extent_int(1);
+
+      // Multi-field apply: the fields are processed in register-sized tiles
+      // so that each coefficient and index is read once per tile instead of
+      // once per field
+      constexpr int field_tile = 8;
+      Kokkos::parallel_for(
+          "ArborX::MovingLeastSquares::target_interpolation_multi",
+          Kokkos::RangePolicy<ExecutionSpace>(space, 0, _num_targets),
+          KOKKOS_CLASS_LAMBDA(int const i) {
+            int const row_width =
+                (_counts.size() != 0) ? _counts(i) : _num_neighbors;
+            for (int f = 0; f < num_fields; f += field_tile)
+            {
+              int const width = Kokkos::min(field_tile, num_fields - f);
+              Value tmp[field_tile] = {};
+              for (int j = 0; j < row_width; j++)
+              {
+                auto const coeff = _coeffs(i, j);
+                int const index = _indices(i, j);
+                for (int t = 0; t < width; t++)
+                  tmp[t] += coeff * source_values(index, f + t);
+              }
+              for (int t = 0; t < width; t++)
+                approx_values(i, f + t) = tmp[t];
+            }
+          });
+    }
   }
 
 private:
-  template <typename ExecutionSpace, typename SourceAccess,
-            typename TargetAccess>
-  auto searchNeighbors(ExecutionSpace const &space,
-                       SourceAccess const &source_access,
-                       TargetAccess const &target_access)
-  {
-    auto guard = Kokkos::Profiling::ScopedRegion(
-        "ArborX::MovingLeastSquares::searchNeighbors");
-
-    // Organize the source points as a tree
-    using SourcePoint = typename SourceAccess::value_type;
-    BoundingVolumeHierarchy<MemorySpace, ArborX::PairValueIndex<SourcePoint>>
-        source_tree(space, ArborX::Experimental::attach_indices(source_access));
-
-    // Create the predicates
-    Details::MLSPredicateWrapper<TargetAccess> predicates{target_access,
-                                                          _num_neighbors};
-
-    // Create the callback
-    Kokkos::View<SourcePoint **, MemorySpace> source_view(
-        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
-                           "ArborX::MovingLeastSquares::source_view"),
-        _num_targets, _num_neighbors);
-    _indices = Kokkos::View<int **, MemorySpace>(
-        Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
-                           "ArborX::MovingLeastSquares::indices"),
-        _num_targets, _num_neighbors);
-    Kokkos::View<int *, MemorySpace> counter(
-        "ArborX::MovingLeastSquares::counter", _num_targets);
-    Details::MLSSearchNeighborsCallback<decltype(source_view),
-                                        decltype(_indices), decltype(counter)>
-        callback{source_view, _indices, counter};
-
-    // Query the source tree
-    source_tree.query(space, predicates, callback);
-
-    return source_view;
-  }
-
-  Kokkos::View<FloatingCalculationType **, MemorySpace> _coeffs;
+  // Dense ELLPACK storage: num_targets x num_neighbors rows of equal
+  // capacity, so no offsets array is needed. With adaptive stencils _counts
+  // holds the per-target stencil size (rows are zero-padded past it);
+  // otherwise _counts is left empty and every row is full.
+  Kokkos::View<CoefficientStorageType **, MemorySpace> _coeffs;
   Kokkos::View<int **, MemorySpace> _indices;
+  Kokkos::View<int *, MemorySpace> _counts;
   int _num_targets;
   int _num_neighbors;
   int _source_size;
@@ -107,6 +107,36 @@ evaluate(Point const &point,
       ArborX::Details::distance(point, Point{}) / radius);
 }
 
+// Weights of a whole recentered neighbor tile in one pass. The distances to
+// the origin are computed once and staged in 'phi' while the support radius
+// is reduced over them; the CRBF is then evaluated on the staged scalars, a
+// plain arithmetic loop with no point loads that the compiler can vectorize.
+// The radius is scaled up so that the farthest neighbor does not end up with
+// a zero weight.
+template <typename CRBFunc, typename SourcePoints, typename Phi>
+KOKKOS_INLINE_FUNCTION void evaluateTile(SourcePoints const &source_points,
+                                         int num_neighbors, Phi &phi)
+{
+  using SourcePoint = typename SourcePoints::non_const_value_type;
+  static_assert(GeometryTraits::is_point<SourcePoint>::value,
+                "source points elements must be points");
+  using T = typename Phi::non_const_value_type;
+  constexpr std::size_t dim = GeometryTraits::dimension_v<SourcePoint>;
+
+  T radius = Kokkos::Experimental::epsilon_v<T>;
+  for (int neighbor = 0; neighbor < num_neighbors; neighbor++)
+  {
+    phi(neighbor) =
+        ArborX::Details::distance(source_points(neighbor), SourcePoint{});
+    radius = Kokkos::max(radius, T(phi(neighbor)));
+  }
+  // The one at the limit would be 0 due to how CRBFs work
+  radius *= T(1.1);
+  T const inv_radius = 1 / radius;
+  for (int neighbor = 0; neighbor < num_neighbors; neighbor++)
+    phi(neighbor) = CRBFunc::template evaluate<dim>(phi(neighbor) * inv_radius);
+}
+
 } // namespace CRBF
 
 } // namespace ArborX::Interpolation
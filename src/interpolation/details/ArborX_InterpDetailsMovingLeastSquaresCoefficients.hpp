@@ -26,6 +26,133 @@
 namespace ArborX::Interpolation::Details
 {
 
+// Assembles the coefficients of a single target from its neighbor list,
+// growing the stencil adaptively. The source points must be sorted by
+// increasing distance to the target and are recentered in place; all views
+// are local to the calling thread.
+//
+// The goal is to compute the following line vector:
+// p(x).[P^T.PHI.P]^-1.P^T.PHI
+// Where:
+// - p(x) is the polynomial basis of point x (line vector).
+// - P is the multidimensional Vandermonde matrix built from the source
+//   points, i.e., each line is the polynomial basis of a source point.
+// - PHI is the diagonal weight matrix / CRBF evaluated at each source point.
+//
+// The stencil starts at 'min_neighbors' points and grows until the moment
+// matrix P^T.PHI.P is full rank under the SVD cutoff, or all of
+// 'source_points' is in use. Returns the neighbor count actually used; the
+// unused tail of 'coefficients' is zeroed out so that a dense apply over the
+// full row stays correct.
+template <typename CRBFunc, typename PolynomialDegree, typename TargetPoint,
+          typename SourcePoints, typename Phi, typename Vandermonde,
+          typename Moment, typename SVDDiag, typename SVDUnit,
+          typename Coefficients>
+KOKKOS_FUNCTION int adaptiveMovingLeastSquaresCoefficientsPerTarget(
+    TargetPoint const &target_point, SourcePoints &source_points,
+    int min_neighbors, Phi &phi, Vandermonde &vandermonde, Moment &moment,
+    SVDDiag &svd_diag, SVDUnit &svd_unit, Coefficients &coefficients)
+{
+  using SourcePoint = typename SourcePoints::non_const_value_type;
+  using CoefficientsType = typename Phi::non_const_value_type;
+  static constexpr int dimension = GeometryTraits::dimension_v<SourcePoint>;
+  static constexpr int degree = PolynomialDegree::value;
+  static constexpr int poly_size = polynomialBasisSize<dimension, degree>();
+  int const max_neighbors = source_points.extent_int(0);
+
+  // We first change the origin of the evaluation to be at the target point.
+  // This lets us use p(0) which is [1 0 ... 0].
+  for (int neighbor = 0; neighbor < max_neighbors; neighbor++)
+    for (int k = 0; k < dimension; k++)
+      source_points(neighbor)[k] -= target_point[k];
+
+  int num_neighbors = Kokkos::min(min_neighbors, max_neighbors);
+  // A Vandermonde row only depends on its own source point, so rows survive
+  // stencil growth and are built incrementally
+  int built = 0;
+  while (true)
+  {
+    // This computes PHI for the whole tile in one batched pass (the stencil
+    // radius is computed inside). The radius is that of the current stencil,
+    // so PHI is recomputed whenever the stencil grows.
+    CRBF::evaluateTile<CRBFunc>(source_points, num_neighbors, phi);
+
+    // This builds the missing rows of the Vandermonde (P) matrix
+    for (; built < num_neighbors; built++)
+    {
+      auto basis = evaluatePolynomialBasis<degree>(source_points(built));
+      for (int k = 0; k < poly_size; k++)
+        vandermonde(built, k) = basis[k];
+    }
+
+    // We then create what is called the moment matrix, which is P^T.PHI.P. By
+    // construction, it is symmetric.
+    for (int i = 0; i < poly_size; i++)
+      for (int j = 0; j < poly_size; j++)
+      {
+        moment(i, j) = 0;
+        for (int neighbor = 0; neighbor < num_neighbors; neighbor++)
+          moment(i, j) += vandermonde(neighbor, i) * vandermonde(neighbor, j) *
+                          phi(neighbor);
+      }
+
+    // We need the inverse of P^T.PHI.P, and because it is symmetric, we can
+    // use the symmetric SVD algorithm to get it.
+    symmetricPseudoInverseSVDKernel(moment, svd_diag, svd_unit);
+    // Now, the moment has [P^T.PHI.P]^-1
+
+    if (num_neighbors == max_neighbors)
+      break;
+
+    // A zeroed entry in 'svd_diag' means the pseudo-inverse cutoff dropped an
+    // eigenvalue: the moment matrix is rank-deficient for this stencil and
+    // more neighbors are needed
+    bool well_conditioned = true;
+    for (int i = 0; i < poly_size; i++)
+      if (svd_diag(i) == 0)
+      {
+        well_conditioned = false;
+        break;
+      }
+    if (well_conditioned)
+      break;
+
+    num_neighbors = Kokkos::min(max_neighbors, 3 * num_neighbors / 2 + 1);
+  }
+
+  // Finally, the result is produced by computing p(0).[P^T.PHI.P]^-1.P^T.PHI.
+  // The sum runs in the computation type so that callers may hand a
+  // lower-precision storage row for 'coefficients'.
+  for (int neighbor = 0; neighbor < num_neighbors; neighbor++)
+  {
+    CoefficientsType tmp = 0;
+    for (int i = 0; i < poly_size; i++)
+      tmp += moment(0, i) * vandermonde(neighbor, i) * phi(neighbor);
+    coefficients(neighbor) = tmp;
+  }
+  for (int neighbor = num_neighbors; neighbor < max_neighbors; neighbor++)
+    coefficients(neighbor) = 0;
+
+  return num_neighbors;
+}
+
+// Fixed-stencil assembly: every point of the neighbor list contributes. This
+// is the adaptive kernel pinned at the full stencil, which makes the growth
+// loop above run exactly once.
+template <typename CRBFunc, typename PolynomialDegree, typename TargetPoint,
+          typename SourcePoints, typename Phi, typename Vandermonde,
+          typename Moment, typename SVDDiag, typename SVDUnit,
+          typename Coefficients>
+KOKKOS_FUNCTION void movingLeastSquaresCoefficientsPerTarget(
+    TargetPoint const &target_point, SourcePoints &source_points, Phi &phi,
+    Vandermonde &vandermonde, Moment &moment, SVDDiag &svd_diag,
+    SVDUnit &svd_unit, Coefficients &coefficients)
+{
+  adaptiveMovingLeastSquaresCoefficientsPerTarget<CRBFunc, PolynomialDegree>(
+      target_point, source_points, source_points.extent_int(0), phi,
+      vandermonde, moment, svd_diag, svd_unit, coefficients);
+}
+
 template <typename SourcePoints, typename TargetAccess, typename Coefficients,
           typename ExecutionSpace, typename CRBFunc = CRBF::Wendland<0>,
           typename PolynomialDegree = PolynomialDegree<2>>
@@ -85,36 +212,9 @@ public:
     LocalSVDUnit svd_unit(scratch);
     auto coefficients = Kokkos::subview(_coefficients, target, Kokkos::ALL);
 
-    // The goal is to compute the following line vector for each target point:
-    // p(x).[P^T.PHI.P]^-1.P^T.PHI
-    // Where:
-    // - p(x) is the polynomial basis of point x (line vector).
-    // - P is the multidimensional Vandermonde matrix built from the source
-    //   points, i.e., each line is the polynomial basis of a source point.
-    // - PHI is the diagonal weight matrix / CRBF evaluated at each source
-    // point.
-
-    // We first change the origin of the evaluation to be at the target point.
-    // This lets us use p(0) which is [1 0 ... 0].
-    sourceRecentering(target_point, source_points);
-
-    // This computes PHI given the source points (radius is computed inside)
-    phiComputation(source_points, phi);
-
-    // This builds the Vandermonde (P) matrix
-    vandermondeComputation(source_points, vandermonde);
-
-    // We then create what is called the moment matrix, which is P^T.PHI.P. By
-    // construction, it is symmetric.
-    momentComputation(phi, vandermonde, moment);
-
-    // We need the inverse of P^T.PHI.P, and because it is symmetric, we can use
-    // the symmetric SVD algorithm to get it.
-    symmetricPseudoInverseSVDKernel(moment, svd_diag, svd_unit);
-    // Now, the moment has [P^T.PHI.P]^-1
-
-    // Finally, the result is produced by computing p(0).[P^T.PHI.P]^-1.P^T.PHI
-    coefficientsComputation(phi, vandermonde, moment, coefficients);
+    movingLeastSquaresCoefficientsPerTarget<CRBFunc, PolynomialDegree>(
+        target_point, source_points, phi, vandermonde, moment, svd_diag,
+        svd_unit, coefficients);
   }
 
   Kokkos::TeamPolicy<ExecutionSpace>
@@ -146,76 +246,6 @@ private:
     return val;
   }
 
-  // Recenters the source points so that the target is at the origin
-  KOKKOS_FUNCTION void sourceRecentering(TargetPoint const &target_point,
-                                         LocalSourcePoints &source_points) const
-  {
-    for (int neighbor = 0; neighbor < _num_neighbors; neighbor++)
-      for (int k = 0; k < dimension; k++)
-        source_points(neighbor)[k] -= target_point[k];
-  }
-
-  // Computes the weight matrix
-  KOKKOS_FUNCTION void phiComputation(LocalSourcePoints const &source_points,
-                                      LocalPhi &phi) const
-  {
-    CoefficientsType radius = Kokkos::Experimental::epsilon_v<CoefficientsType>;
-    for (int neighbor = 0; neighbor < _num_neighbors; neighbor++)
-    {
-      CoefficientsType const norm =
-          ArborX::Details::distance(source_points(neighbor), SourcePoint{});
-      radius = Kokkos::max(radius, norm);
-    }
-
-    // The one at the limit would be 0 due to how CRBFs work
-    radius *= CoefficientsType(1.1);
-
-    for (int neighbor = 0; neighbor < _num_neighbors; neighbor++)
-      phi(neighbor) = CRBF::evaluate<CRBFunc>(source_points(neighbor), radius);
-  }
-
-  // Computes the vandermonde matrix
-  KOKKOS_FUNCTION void
-  vandermondeComputation(LocalSourcePoints const &source_points,
-                         LocalVandermonde &vandermonde) const
-  {
-    for (int neighbor = 0; neighbor < _num_neighbors; neighbor++)
-    {
-      auto basis = evaluatePolynomialBasis<degree>(source_points(neighbor));
-      for (int k = 0; k < poly_size; k++)
-        vandermonde(neighbor, k) = basis[k];
-    }
-  }
-
-  // Computes the moment matrix
-  KOKKOS_FUNCTION void momentComputation(LocalPhi const &phi,
-                                         LocalVandermonde const &vandermonde,
-                                         LocalMoment &moment) const
-  {
-    for (int i = 0; i < poly_size; i++)
-      for (int j = 0; j < poly_size; j++)
-      {
-        moment(i, j) = 0;
-        for (int neighbor = 0; neighbor < _num_neighbors; neighbor++)
-          moment(i, j) += vandermonde(neighbor, i) * vandermonde(neighbor, j) *
-                          phi(neighbor);
-      }
-  }
-
-  // Computes the coefficients
-  KOKKOS_FUNCTION void coefficientsComputation(
-      LocalPhi const &phi, LocalVandermonde const &vandermonde,
-      LocalMoment const &moment, LocalCoefficients &coefficients) const
-  {
-    for (int neighbor = 0; neighbor < _num_neighbors; neighbor++)
-    {
-      coefficients(neighbor) = 0;
-      for (int i = 0; i < poly_size; i++)
-        coefficients(neighbor) +=
-            moment(0, i) * vandermonde(neighbor, i) * phi(neighbor);
-    }
-  }
-
   TargetAccess _target_access;
   SourcePoints _source_points;
   Coefficients _coefficients;
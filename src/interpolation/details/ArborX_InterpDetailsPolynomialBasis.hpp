@@ -17,6 +17,7 @@
 #include <Kokkos_Core.hpp>
 
 #include <type_traits>
+#include <utility>
 
 namespace ArborX::Interpolation
 {
@@ -100,7 +101,70 @@ KOKKOS_FUNCTION constexpr std::size_t polynomialBasisSize()
   return result;
 }
 
-// This creates the list by building each slices in-place
+// Each entry of the basis (past the leading 1) is the product of an earlier
+// entry with one coordinate, and which entry and which coordinate only depend
+// on DIM and Degree. Tabulating both at compile time turns the evaluation into
+// a sequence of multiplies with constant indices.
+template <std::size_t DIM, std::size_t Degree>
+KOKKOS_FUNCTION constexpr auto polynomialBasisProductTerms()
+{
+  static_assert(DIM > 0, "Polynomial basis with no dimension is invalid");
+  static_assert(
+      Degree > 0,
+      "Unable to compute product terms for a constant polynomial basis");
+
+  struct
+  {
+    std::size_t prev[polynomialBasisSize<DIM, Degree>()]{};
+    std::size_t dim[polynomialBasisSize<DIM, Degree>()]{};
+  } result;
+
+  auto const slice_lengths = polynomialBasisSliceLengths<DIM, Degree>();
+
+  std::size_t prev_col = 0;
+  std::size_t curr_col = 1;
+
+  for (std::size_t deg = 0; deg < Degree; deg++)
+  {
+    std::size_t loc_offset = curr_col;
+    for (std::size_t dim = 0; dim < DIM; dim++)
+    {
+      // the slice is the previous column multiplied by p[dim]
+      for (std::size_t i = 0; i < slice_lengths.arr[deg][dim]; i++)
+      {
+        result.prev[loc_offset + i] = prev_col + i;
+        result.dim[loc_offset + i] = dim;
+      }
+
+      loc_offset += slice_lengths.arr[deg][dim];
+    }
+
+    prev_col = curr_col;
+    curr_col = loc_offset;
+  }
+
+  return result;
+}
+
+template <std::size_t Degree, typename Value, std::size_t Size, typename Point,
+          std::size_t... Is>
+KOKKOS_FUNCTION void
+evaluatePolynomialBasisImpl(Kokkos::Array<Value, Size> &arr, Point const &p,
+                            std::index_sequence<Is...>)
+{
+  static constexpr std::size_t DIM = GeometryTraits::dimension_v<Point>;
+  static constexpr auto terms = polynomialBasisProductTerms<DIM, Degree>();
+
+  // The comma fold is sequenced left to right and every slot only reads slots
+  // of lower index, so this expands to straight-line code where all array and
+  // coordinate indices are compile-time constants
+  ((arr[Is + 1] = arr[terms.prev[Is + 1]] * p[terms.dim[Is + 1]]), ...);
+}
+
+// This creates the list by building each slices in-place. The whole
+// evaluation is unrolled at compile time; it runs once per neighbor inside
+// the coefficients kernels, where a runtime loop nest costs about as much as
+// the multiplies themselves at low degrees.
 template <std::size_t Degree, typename Point>
 KOKKOS_FUNCTION auto evaluatePolynomialBasis(Point const &p)
 {
@@ -114,30 +178,9 @@ KOKKOS_FUNCTION auto evaluatePolynomialBasis(Point const &p)
   arr[0] = Value(1);
 
   if constexpr (Degree > 0)
-  {
-    // Cannot use structured binding with constexpr
-    static constexpr auto slice_lengths =
-        polynomialBasisSliceLengths<DIM, Degree>();
-
-    std::size_t prev_col = 0;
-    std::size_t curr_col = 1;
-
-    for (std::size_t deg = 0; deg < Degree; deg++)
-    {
-      std::size_t loc_offset = curr_col;
-      for (std::size_t dim = 0; dim < DIM; dim++)
-      {
-        // copy the previous column and multply by p[dim]
-        for (std::size_t i = 0; i < slice_lengths.arr[deg][dim]; i++)
-          arr[loc_offset + i] = arr[prev_col + i] * p[dim];
-
-        loc_offset += slice_lengths.arr[deg][dim];
-      }
-
-      prev_col = curr_col;
-      curr_col = loc_offset;
-    }
-  }
+    evaluatePolynomialBasisImpl<Degree>(
+        arr, p,
+        std::make_index_sequence<polynomialBasisSize<DIM, Degree>() - 1>{});
 
   return arr;
 }
@@ -226,6 +226,168 @@ KOKKOS_FUNCTION void symmetricPseudoInverseSVDKernel(Matrix &mat, Diag &diag,
     }
 }
 
+// Team-collaborative version of the kernel above: the whole team factors a
+// single matrix. The pivot search is a team reduction over the upper
+// triangle and the rotations are applied one row per thread (the touched
+// elements are disjoint across rows). The rotation parameters are computed
+// redundantly by every thread, which is cheaper than a broadcast. Intended
+// to be called on matrices staged in scratch memory, one matrix per team.
+template <typename TeamMember, typename Matrix, typename Diag, typename Unit>
+KOKKOS_FUNCTION void
+symmetricPseudoInverseSVDTeamKernel(TeamMember const &member, Matrix &mat,
+                                    Diag &diag, Unit &unit)
+{
+  ensureIsSquareSymmetricMatrix(mat);
+  ensureIsSquareMatrix(unit);
+  static_assert(
+      std::is_same_v<typename Matrix::value_type, typename Diag::value_type> &&
+          std::is_same_v<typename Diag::value_type, typename Unit::value_type>,
+      "All input matrices must have the same value type");
+  KOKKOS_ASSERT(mat.extent(0) == diag.extent(0) &&
+                diag.extent(0) == unit.extent(0));
+  using Value = typename Matrix::non_const_value_type;
+  int const size = mat.extent(0);
+
+  // We first initialize 'unit' as the identity matrix
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(member, size * size),
+                       [&](int k) {
+                         unit(k / size, k % size) = Value(k / size == k % size);
+                       });
+  member.team_barrier();
+
+  static constexpr Value epsilon = Kokkos::Experimental::epsilon_v<float>;
+  using MaxLoc = Kokkos::MaxLoc<Value, int>;
+  while (true)
+  {
+    // Team-parallel argmax over the upper triangle. The result is broadcast
+    // to every member, so the loop exits uniformly.
+    typename MaxLoc::value_type pivot;
+    Kokkos::parallel_reduce(
+        Kokkos::TeamThreadRange(member, size * size),
+        [&](int k, typename MaxLoc::value_type &update) {
+          int const i = k / size;
+          int const j = k % size;
+          if (i < j)
+          {
+            Value const val = Kokkos::abs(mat(i, j));
+            if (update.val < val)
+            {
+              update.val = val;
+              update.loc = k;
+            }
+          }
+        },
+        MaxLoc(pivot));
+    if (pivot.val <= epsilon)
+      break;
+    // We have a guarantee that p < q
+    int const p = pivot.loc / size;
+    int const q = pivot.loc % size;
+
+    auto const a = mat(p, p);
+    auto const b = mat(p, q);
+    auto const c = mat(q, q);
+
+    // Same 2x2 diagonalization as in the serial kernel
+    Value cos_theta;
+    Value sin_theta;
+    Value x;
+    Value y;
+    if (a == c)
+    {
+      cos_theta = Kokkos::sqrt(Value(2)) / 2;
+      sin_theta = cos_theta;
+      x = a + b;
+      y = a - b;
+    }
+    else
+    {
+      auto const u = (2 * b) / (a - c);
+      auto const v = 1 / Kokkos::sqrt(u * u + 1);
+      cos_theta = Kokkos::sqrt((1 + v) / 2);
+      sin_theta = Kokkos::copysign(Kokkos::sqrt((1 - v) / 2), u);
+      x = (a + c + (a - c) / v) / 2;
+      y = a + c - x;
+    }
+    // Everybody read a, b and c before the rotation overwrites them
+    member.team_barrier();
+
+    // mat <- R'(theta)^T . mat . R'(theta), one row or column per thread;
+    // iteration i only touches the elements pairing i with p and q
+    Kokkos::parallel_for(
+        Kokkos::TeamThreadRange(member, size), [&](int i) {
+          if (i < p)
+          {
+            auto const es_ip = mat(i, p);
+            auto const es_iq = mat(i, q);
+            mat(i, p) = cos_theta * es_ip + sin_theta * es_iq;
+            mat(i, q) = -sin_theta * es_ip + cos_theta * es_iq;
+          }
+          else if (i == p)
+          {
+            mat(p, p) = x;
+            mat(p, q) = 0;
+          }
+          else if (i < q)
+          {
+            auto const es_pi = mat(p, i);
+            auto const es_iq = mat(i, q);
+            mat(p, i) = cos_theta * es_pi + sin_theta * es_iq;
+            mat(i, q) = -sin_theta * es_pi + cos_theta * es_iq;
+          }
+          else if (i == q)
+          {
+            mat(q, q) = y;
+          }
+          else
+          {
+            auto const es_pi = mat(p, i);
+            auto const es_qi = mat(q, i);
+            mat(p, i) = cos_theta * es_pi + sin_theta * es_qi;
+            mat(q, i) = -sin_theta * es_pi + cos_theta * es_qi;
+          }
+        });
+
+    // unit <- unit . R'(theta), rows are independent of 'mat'
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(member, size), [&](int i) {
+      auto const u_ip = unit(i, p);
+      auto const u_iq = unit(i, q);
+      unit(i, p) = cos_theta * u_ip + sin_theta * u_iq;
+      unit(i, q) = -sin_theta * u_ip + cos_theta * u_iq;
+    });
+    member.team_barrier();
+  }
+
+  // We compute the max to get a range of the invertible eigenvalues
+  Value max_eigen;
+  Kokkos::parallel_reduce(
+      Kokkos::TeamThreadRange(member, size),
+      [&](int i, Value &update) {
+        diag(i) = mat(i, i);
+        update = Kokkos::max(Kokkos::abs(mat(i, i)), update);
+      },
+      Kokkos::Max<Value>(max_eigen));
+  auto const threshold = Kokkos::max(max_eigen, epsilon) * epsilon;
+  member.team_barrier();
+
+  // We invert the diagonal of 'mat', except if "0" is found
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(member, size), [&](int i) {
+    diag(i) = (Kokkos::abs(diag(i)) < threshold) ? 0 : 1 / diag(i);
+  });
+  member.team_barrier();
+
+  // Then we fill out 'mat' as the pseudo inverse
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(member, size * size),
+                       [&](int k) {
+                         int const i = k / size;
+                         int const j = k % size;
+                         Value sum = 0;
+                         for (int l = 0; l < size; l++)
+                           sum += diag(l) * unit(i, l) * unit(j, l);
+                         mat(i, j) = sum;
+                       });
+}
+
 template <typename ExecutionSpace, typename InOutMatrices>
 void symmetricPseudoInverseSVD(ExecutionSpace const &space,
                                InOutMatrices &matrices)
@@ -247,25 +409,51 @@ void symmetricPseudoInverseSVD(ExecutionSpace const &space,
   KOKKOS_ASSERT(matrices.extent(1) == matrices.extent(2)); // Must be square
 
   using Value = typename InOutMatrices::non_const_value_type;
-  using MemorySpace = typename InOutMatrices::memory_space;
-
-  Kokkos::View<Value **, MemorySpace> diags(
-      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
-                         "ArborX::SymmetricPseudoInverseSVD::diags"),
-      matrices.extent(0), matrices.extent(1));
-  Kokkos::View<Value ***, MemorySpace> units(
-      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
-                         "ArborX::SymmetricPseudoInverseSVD::units"),
-      matrices.extent(0), matrices.extent(1), matrices.extent(2));
+  using ScratchMatrix =
+      Kokkos::View<Value **, typename ExecutionSpace::scratch_memory_space,
+                   Kokkos::MemoryUnmanaged>;
+  using ScratchDiag =
+      Kokkos::View<Value *, typename ExecutionSpace::scratch_memory_space,
+                   Kokkos::MemoryUnmanaged>;
+
+  int const num_matrices = matrices.extent(0);
+  int const size = matrices.extent(1);
+
+  // One matrix per team, staged in scratch: the serial-per-thread version
+  // had each thread walking its own global matrix, which thrashes the cache
+  // as soon as the matrices outgrow a few cache lines (polynomial degree 2
+  // in 3D is already 10x10)
+  std::size_t const shmem =
+      2 * ScratchMatrix::shmem_size(size, size) + ScratchDiag::shmem_size(size);
+  Kokkos::TeamPolicy<ExecutionSpace> policy(space, num_matrices, Kokkos::AUTO);
+  policy.set_scratch_size(0, Kokkos::PerTeam(shmem));
 
   Kokkos::parallel_for(
-      "ArborX::SymmetricPseudoInverseSVD::computations",
-      Kokkos::RangePolicy<ExecutionSpace>(space, 0, matrices.extent(0)),
-      KOKKOS_LAMBDA(int const i) {
-        auto mat = Kokkos::subview(matrices, i, Kokkos::ALL, Kokkos::ALL);
-        auto diag = Kokkos::subview(diags, i, Kokkos::ALL);
-        auto unit = Kokkos::subview(units, i, Kokkos::ALL, Kokkos::ALL);
-        symmetricPseudoInverseSVDKernel(mat, diag, unit);
+      "ArborX::SymmetricPseudoInverseSVD::computations", policy,
+      KOKKOS_LAMBDA(
+          typename Kokkos::TeamPolicy<ExecutionSpace>::member_type const
+              &member) {
+        auto mat_global = Kokkos::subview(matrices, member.league_rank(),
+                                          Kokkos::ALL, Kokkos::ALL);
+        ScratchMatrix mat(member.team_scratch(0), size, size);
+        ScratchMatrix unit(member.team_scratch(0), size, size);
+        ScratchDiag diag(member.team_scratch(0), size);
+
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member, size * size),
+                             [&](int k) {
+                               mat(k / size, k % size) =
+                                   mat_global(k / size, k % size);
+                             });
+        member.team_barrier();
+
+        symmetricPseudoInverseSVDTeamKernel(member, mat, diag, unit);
+
+        member.team_barrier();
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member, size * size),
+                             [&](int k) {
+                               mat_global(k / size, k % size) =
+                                   mat(k / size, k % size);
+                             });
       });
 }
 
@@ -0,0 +1,154 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_KOKKOS_EXT_RADIX_SORT_HPP
+#define ARBORX_DETAILS_KOKKOS_EXT_RADIX_SORT_HPP
+
+#include <ArborX_DetailsKokkosExtStdAlgorithms.hpp> // exclusive_scan
+#include <ArborX_Exception.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace ArborX::Details::KokkosExt
+{
+
+// Key types the radix sort below understands. Wider key types (such as the
+// 128-bit Morton codes) opt in by specializing the trait and providing a
+// radixSortByte overload found through argument-dependent lookup.
+template <typename Key>
+struct is_radix_sort_candidate
+    : std::bool_constant<std::is_integral_v<Key> && std::is_unsigned_v<Key>>
+{};
+
+template <typename Key>
+KOKKOS_INLINE_FUNCTION unsigned int radixSortByte(Key x, unsigned int shift)
+{
+  return (x >> shift) & 0xffu;
+}
+
+// Stable LSD radix sort for unsigned integer keys with the value permutation
+// fused into every scatter pass. Keys are consumed one byte at a time; each
+// pass computes a digit-major histogram over fixed-size chunks, scans it, and
+// scatters chunk-sequentially so that no atomics are needed (a chunk owns its
+// histogram column). Passes whose digit is identical across all keys --
+// common for Morton codes that do not fill the full word -- are skipped.
+template <typename ExecutionSpace, typename Keys, typename Values>
+void radixSortByKey(ExecutionSpace const &space, Keys &keys, Values &values)
+{
+  using Key = typename Keys::non_const_value_type;
+  using Value = typename Values::non_const_value_type;
+  using MemorySpace = typename Keys::memory_space;
+
+  static_assert(is_radix_sort_candidate<Key>::value);
+
+  int const n = keys.size();
+  ARBORX_ASSERT((int)values.size() == n);
+
+  constexpr int num_buckets = 256;
+  constexpr int chunk_size = 1024;
+  int const num_chunks = (n + chunk_size - 1) / chunk_size;
+
+  Kokkos::View<Key *, MemorySpace> keys_scratch(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::Sorting::radix::keys_scratch"),
+      n);
+  Kokkos::View<Value *, MemorySpace> values_scratch(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::Sorting::radix::values_scratch"),
+      n);
+  Kokkos::View<int *, MemorySpace> counts(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::Sorting::radix::counts"),
+      num_buckets * num_chunks);
+  Kokkos::View<int *, MemorySpace> digit_totals(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::Sorting::radix::digit_totals"),
+      num_buckets);
+  auto digit_totals_host = Kokkos::create_mirror_view(digit_totals);
+
+  Kokkos::View<Key *, MemorySpace> keys_src = keys;
+  Kokkos::View<Key *, MemorySpace> keys_dst = keys_scratch;
+  Kokkos::View<Value *, MemorySpace> values_src = values;
+  Kokkos::View<Value *, MemorySpace> values_dst = values_scratch;
+  bool in_scratch = false;
+
+  for (unsigned int shift = 0; shift < 8 * sizeof(Key); shift += 8)
+  {
+    Kokkos::deep_copy(space, counts, 0);
+    Kokkos::parallel_for(
+        "ArborX::Sorting::radix::histogram",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_chunks),
+        KOKKOS_LAMBDA(int c) {
+          int const begin = c * chunk_size;
+          int const end = Kokkos::min(begin + chunk_size, n);
+          for (int i = begin; i < end; ++i)
+          {
+            int const digit = radixSortByte(keys_src(i), shift);
+            ++counts(digit * num_chunks + c);
+          }
+        });
+
+    // A pass with a constant digit would be a pure (stable) copy
+    Kokkos::parallel_for(
+        "ArborX::Sorting::radix::digit_totals",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_buckets),
+        KOKKOS_LAMBDA(int digit) {
+          int count = 0;
+          for (int c = 0; c < num_chunks; ++c)
+            count += counts(digit * num_chunks + c);
+          digit_totals(digit) = count;
+        });
+    Kokkos::deep_copy(space, digit_totals_host, digit_totals);
+    space.fence();
+    bool skip = false;
+    for (int digit = 0; digit < num_buckets; ++digit)
+    {
+      if (digit_totals_host(digit) == n)
+        skip = true;
+      if (digit_totals_host(digit) != 0)
+        break;
+    }
+    if (skip)
+      continue;
+
+    exclusive_scan(space, counts, counts, 0);
+
+    Kokkos::parallel_for(
+        "ArborX::Sorting::radix::scatter",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, num_chunks),
+        KOKKOS_LAMBDA(int c) {
+          int const begin = c * chunk_size;
+          int const end = Kokkos::min(begin + chunk_size, n);
+          for (int i = begin; i < end; ++i)
+          {
+            int const digit = radixSortByte(keys_src(i), shift);
+            // Only this chunk touches its histogram column, no atomics needed
+            int const j = counts(digit * num_chunks + c)++;
+            keys_dst(j) = keys_src(i);
+            values_dst(j) = values_src(i);
+          }
+        });
+
+    std::swap(keys_src, keys_dst);
+    std::swap(values_src, values_dst);
+    in_scratch = !in_scratch;
+  }
+
+  if (in_scratch)
+  {
+    Kokkos::deep_copy(space, keys, keys_src);
+    Kokkos::deep_copy(space, values, values_src);
+  }
+}
+
+} // namespace ArborX::Details::KokkosExt
+
+#endif
@@ -0,0 +1,146 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef ARBORX_DETAILS_KOKKOS_EXT_SEGMENTED_SORT_HPP
+#define ARBORX_DETAILS_KOKKOS_EXT_SEGMENTED_SORT_HPP
+
+#include <ArborX_DetailsKokkosExtAccessibilityTraits.hpp>
+#include <ArborX_DetailsKokkosExtSwap.hpp>
+#include <ArborX_Exception.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+namespace ArborX::Details::KokkosExt
+{
+
+// Sort the entries of each segment [offsets(i), offsets(i + 1)) in
+// ascending key order, permuting the values alongside. This is the shape of
+// most of our result postprocessing: the rows of a CSR structure need
+// ordering, but the rows are independent and typically short, so a global
+// sort (and the device library round-trips it entails) is overkill.
+//
+// Segments below a length threshold are each sorted serially by a single
+// thread; longer segments get a team apiece and are sorted cooperatively
+// with an odd-even transposition sweep over the row.
+template <typename ExecutionSpace, typename Offsets, typename Keys,
+          typename Values>
+void segmentedSortByKey(ExecutionSpace const &space, Offsets const &offsets,
+                        Keys const &keys, Values const &values)
+{
+  Kokkos::Profiling::ScopedRegion guard(
+      "ArborX::KokkosExt::segmentedSortByKey");
+
+  static_assert(Kokkos::is_view<Offsets>::value);
+  static_assert(Kokkos::is_view<Keys>::value);
+  static_assert(Kokkos::is_view<Values>::value);
+  static_assert(Offsets::rank == 1);
+  static_assert(Keys::rank == 1);
+  static_assert(Values::rank == 1);
+  static_assert(KokkosExt::is_accessible_from<typename Offsets::memory_space,
+                                              ExecutionSpace>::value);
+  static_assert(KokkosExt::is_accessible_from<typename Keys::memory_space,
+                                              ExecutionSpace>::value);
+  static_assert(KokkosExt::is_accessible_from<typename Values::memory_space,
+                                              ExecutionSpace>::value);
+
+  if (offsets.size() == 0)
+    return;
+  int const n_segments = offsets.size() - 1;
+  ARBORX_ASSERT(values.size() == keys.size());
+
+  // Below this length a serial insertion sort in registers beats paying for
+  // a team launch and the barriers of the cooperative sweep
+  constexpr int team_sort_threshold = 64;
+
+  Kokkos::parallel_for(
+      "ArborX::KokkosExt::segmented_sort::short_segments",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_segments),
+      KOKKOS_LAMBDA(int const s) {
+        int const begin = offsets(s);
+        int const end = offsets(s + 1);
+        if (end - begin > team_sort_threshold)
+          return;
+        for (int i = begin + 1; i < end; ++i)
+        {
+          auto key = keys(i);
+          auto value = values(i);
+          int j = i - 1;
+          while (j >= begin && keys(j) > key)
+          {
+            keys(j + 1) = keys(j);
+            values(j + 1) = values(j);
+            --j;
+          }
+          keys(j + 1) = key;
+          values(j + 1) = value;
+        }
+      });
+
+  int n_long_segments;
+  Kokkos::parallel_reduce(
+      "ArborX::KokkosExt::segmented_sort::count_long_segments",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_segments),
+      KOKKOS_LAMBDA(int const s, int &update) {
+        update += (offsets(s + 1) - offsets(s) > team_sort_threshold);
+      },
+      n_long_segments);
+  if (n_long_segments == 0)
+    return;
+
+  Kokkos::View<int *, typename Offsets::memory_space> long_segments(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "ArborX::KokkosExt::segmented_sort::long_segments"),
+      n_long_segments);
+  Kokkos::parallel_scan(
+      "ArborX::KokkosExt::segmented_sort::extract_long_segments",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_segments),
+      KOKKOS_LAMBDA(int const s, int &update, bool final_pass) {
+        if (offsets(s + 1) - offsets(s) > team_sort_threshold)
+        {
+          if (final_pass)
+            long_segments(update) = s;
+          ++update;
+        }
+      });
+
+  using TeamPolicy = Kokkos::TeamPolicy<ExecutionSpace>;
+  Kokkos::parallel_for(
+      "ArborX::KokkosExt::segmented_sort::long_segments",
+      TeamPolicy(space, n_long_segments, Kokkos::AUTO),
+      KOKKOS_LAMBDA(typename TeamPolicy::member_type const &member) {
+        int const s = long_segments(member.league_rank());
+        int const begin = offsets(s);
+        int const len = offsets(s + 1) - begin;
+        // Odd-even transposition: alternating phases compare-exchange
+        // disjoint adjacent pairs, so every phase is fully parallel, and
+        // len phases guarantee the row is sorted
+        for (int phase = 0; phase < len; ++phase)
+        {
+          int const start = phase % 2;
+          Kokkos::parallel_for(
+              Kokkos::TeamThreadRange(member, (len - start) / 2),
+              [&](int const t) {
+                int const i = begin + start + 2 * t;
+                if (keys(i + 1) < keys(i))
+                {
+                  swap(keys(i), keys(i + 1));
+                  swap(values(i), values(i + 1));
+                }
+              });
+          member.team_barrier();
+        }
+      });
+}
+
+} // namespace ArborX::Details::KokkosExt
+
+#endif
@@ -15,6 +15,7 @@
 #include <ArborX_Config.hpp> // ARBORX_ENABLE_ROCTHRUST
 
 #include <ArborX_DetailsKokkosExtMinMaxReduce.hpp>
+#include <ArborX_DetailsKokkosExtRadixSort.hpp>
 
 #include <Kokkos_Profiling_ScopedRegion.hpp>
 #include <Kokkos_Sort.hpp>
@@ -99,6 +100,17 @@ void sortByKey(ExecutionSpace const &space, Keys &keys, Values &values)
   if (min_val == max_val)
     return;
 
+  // Fixed-width unsigned integer keys (notably Morton codes, including the
+  // 128-bit ones) take the dedicated radix path. The Thrust and oneDPL
+  // specializations below already use a radix sort internally for integer
+  // keys.
+  using KeyValueType = typename Keys::non_const_value_type;
+  if constexpr (is_radix_sort_candidate<KeyValueType>::value)
+  {
+    radixSortByKey(space, keys, values);
+    return;
+  }
+
   using SizeType = unsigned int;
   using CompType = Kokkos::BinOp1D<Keys>;
 
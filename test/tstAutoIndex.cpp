@@ -0,0 +1,130 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+// clang-format off
+#include "boost_ext/KokkosPairComparison.hpp"
+#include "boost_ext/TupleComparison.hpp"
+#include "boost_ext/CompressedStorageComparison.hpp"
+// clang-format on
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include "ArborX_EnableViewComparison.hpp"
+#include <ArborX_AutoIndex.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(AutoIndex)
+
+namespace Test
+{
+
+// Points at (i, i, i) with unit spacing along every axis; a sphere of
+// radius 2 around point i intersects exactly the points i-1, i, i+1
+template <typename DeviceType>
+void check_auto_index(int n)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space;
+
+  Kokkos::View<ArborX::Point *, MemorySpace> points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::points"),
+      n);
+  Kokkos::parallel_for(
+      "Test::generate_points", Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        points(i) = {(float)i, (float)i, (float)i};
+      });
+
+  using IntersectsSphere = decltype(ArborX::intersects(ArborX::Sphere{}));
+  Kokkos::View<IntersectsSphere *, MemorySpace> queries(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::queries"),
+      n);
+  Kokkos::parallel_for(
+      "Test::generate_queries",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        queries(i) = ArborX::intersects(
+            ArborX::Sphere{{(float)i, (float)i, (float)i}, 2.f});
+      });
+
+  ArborX::Experimental::AutoIndex<MemorySpace> index(space, points);
+  BOOST_TEST((int)index.size() == n);
+
+  Kokkos::View<int *, MemorySpace> offsets("Test::offsets", 0);
+  Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+  index.query(space, queries, indices, offsets);
+
+  std::vector<int> offsets_ref;
+  std::vector<int> indices_ref;
+  offsets_ref.push_back(0);
+  for (int i = 0; i < n; ++i)
+  {
+    for (int j = std::max(i - 1, 0); j <= std::min(i + 1, n - 1); ++j)
+      indices_ref.push_back(j);
+    offsets_ref.push_back(indices_ref.size());
+  }
+
+  auto offsets_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets);
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  BOOST_TEST(make_compressed_storage(offsets_host, indices_host) ==
+                 make_compressed_storage(offsets_ref, indices_ref),
+             boost::test_tools::per_element());
+}
+
+} // namespace Test
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(auto_index_dispatch, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space;
+
+  Kokkos::View<ArborX::Point *, MemorySpace> points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::points"),
+      100);
+  Kokkos::parallel_for(
+      "Test::generate_points",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, 100), KOKKOS_LAMBDA(int i) {
+        points(i) = {(float)i, (float)i, (float)i};
+      });
+
+  // 100 primitives are always below the crossover; 100000 are always above
+  ArborX::Experimental::AutoIndex<MemorySpace> small_index(space, points);
+  BOOST_TEST(small_index.usesBruteForce());
+
+  Kokkos::resize(Kokkos::view_alloc(space, Kokkos::WithoutInitializing), points,
+                 100000);
+  Kokkos::parallel_for(
+      "Test::generate_points",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, 100000),
+      KOKKOS_LAMBDA(int i) {
+        points(i) = {(float)i, (float)i, (float)i};
+      });
+  ArborX::Experimental::AutoIndex<MemorySpace> large_index(space, points);
+  BOOST_TEST(!large_index.usesBruteForce());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(auto_index_query, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  // Same expected results on both sides of the crossover
+  Test::check_auto_index<DeviceType>(100);
+  Test::check_auto_index<DeviceType>(20000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,93 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include "ArborX_EnableViewComparison.hpp"
+#include <ArborX_BruteForce.hpp>
+#include <ArborX_Point.hpp>
+#include <ArborX_Sphere.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(BruteForceAppend)
+
+// An index built from the first batch and extended by append() must be
+// indistinguishable from one built from all values at once. The batch sizes
+// are chosen to trigger the geometric capacity growth twice.
+BOOST_AUTO_TEST_CASE_TEMPLATE(brute_force_append, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space;
+
+  using Point = ArborX::Point;
+  using Value = ArborX::PairValueIndex<Point>;
+
+  int const n = 100;
+  Kokkos::View<Value *, MemorySpace> values(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::values"),
+      n);
+  Kokkos::parallel_for(
+      "Test::generate_values", Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        values(i) = {Point{(float)i, 0.f, 0.f}, (unsigned)i};
+      });
+
+  ArborX::BruteForce<MemorySpace, Value> brute(
+      space, Kokkos::subview(values, Kokkos::make_pair(0, 10)));
+  brute.append(space, Kokkos::subview(values, Kokkos::make_pair(10, 20)));
+  brute.append(space, Kokkos::subview(values, Kokkos::make_pair(20, n)));
+  // Appending nothing is a no-op
+  brute.append(space, Kokkos::subview(values, Kokkos::make_pair(n, n)));
+
+  BOOST_TEST(brute.size() == (unsigned)n);
+
+  auto const bounds = brute.bounds();
+  BOOST_TEST(bounds.minCorner()[0] == 0.f);
+  BOOST_TEST(bounds.maxCorner()[0] == (float)(n - 1));
+
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, MemorySpace>
+      queries(Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                                 "Test::queries"),
+              n);
+  Kokkos::parallel_for(
+      "Test::generate_queries",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        queries(i) =
+            ArborX::intersects(ArborX::Sphere{{(float)i, 0.f, 0.f}, .25f});
+      });
+
+  Kokkos::View<int *, MemorySpace> offset("Test::offset", 0);
+  Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+  brute.query(space, queries, ArborX::Details::LegacyDefaultCallback{}, indices,
+              offset);
+
+  std::vector<int> offset_ref(n + 1);
+  std::vector<int> indices_ref(n);
+  for (int i = 0; i < n; ++i)
+  {
+    offset_ref[i + 1] = i + 1;
+    indices_ref[i] = i;
+  }
+
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  BOOST_TEST(offset_host == offset_ref, boost::test_tools::per_element());
+  BOOST_TEST(indices_host == indices_ref, boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
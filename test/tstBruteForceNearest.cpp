@@ -0,0 +1,170 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include "ArborX_EnableViewComparison.hpp"
+#include <ArborX_BruteForce.hpp>
+#include <ArborX_HyperPoint.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(BruteForceNearest)
+
+// High-dimensional points exercise the distance-matrix kNN kernel; the
+// queries are offset by 0.1 along the line so that the neighbor ordering is
+// tie-free and fully determined
+BOOST_AUTO_TEST_CASE_TEMPLATE(brute_force_nearest_high_dimension, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space;
+
+  using Point = ArborX::ExperimentalHyperGeometry::Point<10, float>;
+
+  int const n = 100;
+  int const k = 3;
+
+  Kokkos::View<Point *, MemorySpace> points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::points"),
+      n);
+  Kokkos::parallel_for(
+      "Test::generate_points", Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        for (int d = 0; d < 10; ++d)
+          points(i)[d] = 0;
+        points(i)[0] = (float)i;
+      });
+
+  Kokkos::View<ArborX::Nearest<Point> *, MemorySpace> queries(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::queries"),
+      n);
+  Kokkos::parallel_for(
+      "Test::generate_queries",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        Point center;
+        for (int d = 0; d < 10; ++d)
+          center[d] = 0;
+        center[0] = i + .1f;
+        queries(i) = ArborX::Nearest<Point>(center, k);
+      });
+
+  ArborX::BruteForce<MemorySpace, ArborX::PairValueIndex<Point>> brute{
+      space, ArborX::Experimental::attach_indices(points)};
+
+  Kokkos::View<int *, MemorySpace> offset("Test::offset", 0);
+  Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+  brute.query(space, queries, ArborX::Details::LegacyDefaultCallback{}, indices,
+              offset);
+
+  std::vector<int> offset_ref(n + 1);
+  std::vector<int> indices_ref;
+  for (int i = 0; i < n; ++i)
+  {
+    std::vector<int> candidates(n);
+    std::iota(candidates.begin(), candidates.end(), 0);
+    std::partial_sort(candidates.begin(), candidates.begin() + k,
+                      candidates.end(), [i](int a, int b) {
+                        return std::abs(i + .1f - a) < std::abs(i + .1f - b);
+                      });
+    indices_ref.insert(indices_ref.end(), candidates.begin(),
+                       candidates.begin() + k);
+    offset_ref[i + 1] = indices_ref.size();
+  }
+
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  BOOST_TEST(offset_host == offset_ref, boost::test_tools::per_element());
+  BOOST_TEST(indices_host == indices_ref, boost::test_tools::per_element());
+}
+
+// Same setup with reduced-precision coordinate storage: the integer
+// coordinates used here are exactly representable in fp16, so the fp32
+// accumulation must reproduce the full-precision neighbors bit for bit
+BOOST_AUTO_TEST_CASE_TEMPLATE(brute_force_nearest_half_precision_storage,
+                              DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space;
+
+  using StoragePoint =
+      ArborX::ExperimentalHyperGeometry::Point<10,
+                                               Kokkos::Experimental::half_t>;
+  using QueryPoint = ArborX::ExperimentalHyperGeometry::Point<10, float>;
+
+  int const n = 100;
+  int const k = 3;
+
+  Kokkos::View<StoragePoint *, MemorySpace> points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::points"),
+      n);
+  Kokkos::parallel_for(
+      "Test::generate_points", Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        for (int d = 0; d < 10; ++d)
+          points(i)[d] = 0;
+        points(i)[0] = (float)i;
+      });
+
+  Kokkos::View<ArborX::Nearest<QueryPoint> *, MemorySpace> queries(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::queries"),
+      n);
+  Kokkos::parallel_for(
+      "Test::generate_queries",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        QueryPoint center;
+        for (int d = 0; d < 10; ++d)
+          center[d] = 0;
+        center[0] = i + .1f;
+        queries(i) = ArborX::Nearest<QueryPoint>(center, k);
+      });
+
+  ArborX::BruteForce<MemorySpace, ArborX::PairValueIndex<StoragePoint>> brute{
+      space, ArborX::Experimental::attach_indices(points)};
+
+  Kokkos::View<int *, MemorySpace> offset("Test::offset", 0);
+  Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+  brute.query(space, queries, ArborX::Details::LegacyDefaultCallback{}, indices,
+              offset);
+
+  std::vector<int> offset_ref(n + 1);
+  std::vector<int> indices_ref;
+  for (int i = 0; i < n; ++i)
+  {
+    std::vector<int> candidates(n);
+    std::iota(candidates.begin(), candidates.end(), 0);
+    std::partial_sort(candidates.begin(), candidates.begin() + k,
+                      candidates.end(), [i](int a, int b) {
+                        return std::abs(i + .1f - a) < std::abs(i + .1f - b);
+                      });
+    indices_ref.insert(indices_ref.end(), candidates.begin(),
+                       candidates.begin() + k);
+    offset_ref[i + 1] = indices_ref.size();
+  }
+
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  BOOST_TEST(offset_host == offset_ref, boost::test_tools::per_element());
+  BOOST_TEST(indices_host == indices_ref, boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
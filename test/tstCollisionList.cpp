@@ -0,0 +1,104 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborXTest_StdVectorToKokkosView.hpp"
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_CollisionList.hpp>
+#include <ArborX_LinearBVH.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+#include <utility>
+
+BOOST_AUTO_TEST_SUITE(CollisionList)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(find_overlapping_pairs, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  // Boxes 0 and 1 overlap, box 2 overlaps neither, and box 3 sits 0.5
+  // away from box 2 (found only with a margin above that)
+  auto boxes = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Box>{
+          {{0.f, 0.f, 0.f}, {2.f, 2.f, 2.f}},
+          {{1.f, 1.f, 1.f}, {3.f, 3.f, 3.f}},
+          {{5.f, 5.f, 5.f}, {6.f, 6.f, 6.f}},
+          {{6.5f, 5.f, 5.f}, {7.5f, 6.f, 6.f}},
+      },
+      "Test::boxes");
+
+  ArborX::BVH<MemorySpace> bvh(exec_space, boxes);
+
+  auto to_set = [](auto pairs) {
+    auto pairs_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, pairs);
+    std::set<std::pair<int, int>> set;
+    for (int k = 0; k < (int)pairs_host.size(); ++k)
+    {
+      int i = pairs_host(k).first;
+      int j = pairs_host(k).second;
+      BOOST_TEST(i != j);
+      set.emplace(std::min(i, j), std::max(i, j));
+    }
+    // No duplicate unordered pair
+    BOOST_TEST(set.size() == pairs_host.size());
+    return set;
+  };
+
+  auto pairs = to_set(
+      ArborX::Experimental::findOverlappingPairs(exec_space, bvh));
+  BOOST_TEST((pairs == std::set<std::pair<int, int>>{{0, 1}}));
+
+  auto fat_pairs = to_set(
+      ArborX::Experimental::findOverlappingPairs(exec_space, bvh, 0.6f));
+  BOOST_TEST((fat_pairs == std::set<std::pair<int, int>>{{0, 1}, {2, 3}}));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(for_each_overlapping_pair, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  // A chain of unit boxes, each overlapping only its neighbors
+  int const n = 16;
+  Kokkos::View<ArborX::Box *, MemorySpace> boxes(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "Test::boxes"),
+      n);
+  Kokkos::parallel_for(
+      "Test::make_boxes", Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        boxes(i) = {{i - .6f, 0.f, 0.f}, {i + .6f, 1.f, 1.f}};
+      });
+
+  ArborX::BVH<MemorySpace> bvh(exec_space, boxes);
+
+  Kokkos::View<int *, MemorySpace> degrees("Test::degrees", n);
+  ArborX::Experimental::forEachOverlappingPair(
+      exec_space, bvh, KOKKOS_LAMBDA(int i, int j) {
+        Kokkos::atomic_increment(&degrees(i));
+        Kokkos::atomic_increment(&degrees(j));
+      });
+
+  auto degrees_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, degrees);
+  for (int i = 0; i < n; ++i)
+    BOOST_TEST(degrees_host(i) == (i == 0 || i == n - 1 ? 1 : 2));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -10,12 +10,19 @@
  ****************************************************************************/
 #include "ArborXTest_StdVectorToKokkosView.hpp"
 #include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_ClusterPostprocessing.hpp>
 #include <ArborX_DBSCAN.hpp>
+#include <ArborX_DBSCANOutOfCore.hpp>
+#include <ArborX_DBSCANSweep.hpp>
 #include <ArborX_DBSCANVerification.hpp>
+#include <ArborX_IncrementalDBSCAN.hpp>
 
 #include "BoostTest_CUDA_clang_workarounds.hpp"
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <vector>
+
 template <typename View>
 struct HiddenView
 {
@@ -159,7 +166,8 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(dbscan, DeviceType, ARBORX_DEVICE_TYPES)
   ExecutionSpace space;
 
   for (auto impl : {ArborX::DBSCAN::Implementation::FDBSCAN,
-                    ArborX::DBSCAN::Implementation::FDBSCAN_DenseBox})
+                    ArborX::DBSCAN::Implementation::FDBSCAN_DenseBox,
+                    ArborX::DBSCAN::Implementation::Auto})
   {
     ArborX::DBSCAN::Parameters params;
     params.setImplementation(impl);
@@ -258,4 +266,302 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(dbscan, DeviceType, ARBORX_DEVICE_TYPES)
   }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(dbscan_cluster_postprocessing, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  ExecutionSpace space;
+
+  // Labels as dbscan() produces them: cluster representatives interleaved
+  // with noise, not compacted
+  auto labels = toView<DeviceType, int>({0, 0, -1, 3, 3, 3, -1});
+
+  Kokkos::View<int *, MemorySpace> cluster_indices("Test::cluster_indices", 0);
+  Kokkos::View<int *, MemorySpace> cluster_offset("Test::cluster_offset", 0);
+
+  auto sorted_cluster = [&](int c) {
+    auto offset_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{},
+                                            cluster_offset);
+    auto indices_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace{}, cluster_indices);
+    std::vector<int> cluster(indices_host.data() + offset_host(c),
+                             indices_host.data() + offset_host(c + 1));
+    std::sort(cluster.begin(), cluster.end());
+    return cluster;
+  };
+
+  {
+    ArborX::Experimental::sortAndFilterClusters(space, labels, cluster_indices,
+                                                cluster_offset);
+    auto offset_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{},
+                                            cluster_offset);
+    BOOST_TEST(offset_host.size() == 3);
+    BOOST_TEST(offset_host(2) == 5);
+    BOOST_TEST(sorted_cluster(0) == (std::vector<int>{0, 1}),
+               boost::test_tools::per_element());
+    BOOST_TEST(sorted_cluster(1) == (std::vector<int>{3, 4, 5}),
+               boost::test_tools::per_element());
+  }
+  {
+    // Filter out clusters smaller than three points
+    ArborX::Experimental::sortAndFilterClusters(space, labels, cluster_indices,
+                                                cluster_offset, 3);
+    auto offset_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{},
+                                            cluster_offset);
+    BOOST_TEST(offset_host.size() == 2);
+    BOOST_TEST(offset_host(1) == 3);
+    BOOST_TEST(sorted_cluster(0) == (std::vector<int>{3, 4, 5}),
+               boost::test_tools::per_element());
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(dbscan_weighted, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using ArborX::dbscan;
+  using ArborX::Point;
+  using ArborX::Details::verifyDBSCAN;
+
+  ExecutionSpace space;
+
+  auto points = toView<DeviceType, Point>(
+      {{{0, 0, 0}}, {{1, 0, 0}}, {{2, 0, 0}}, {{10, 0, 0}}});
+
+  {
+    // The middle point is the only core one: its neighborhood weight is
+    // 3 + 1 + 1 = 5, while the ends only reach 4 and 2
+    auto weights = toView<DeviceType, float>({3.f, 1.f, 1.f, 1.f});
+
+    auto labels = dbscan(space, points, 1.2f, 5.f, weights);
+    auto labels_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, labels);
+    BOOST_TEST(labels_host(1) >= 0);
+    BOOST_TEST(labels_host(0) == labels_host(1));
+    BOOST_TEST(labels_host(2) == labels_host(1));
+    BOOST_TEST(labels_host(3) == -1);
+
+    // Nothing reaches a threshold above the largest neighborhood weight
+    labels = dbscan(space, points, 1.2f, 5.5f, weights);
+    labels_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, labels);
+    for (int i = 0; i < 4; ++i)
+      BOOST_TEST(labels_host(i) == -1);
+  }
+
+  {
+    // With unit weights the weighted variant matches the unweighted one
+    auto weights = toView<DeviceType, float>({1.f, 1.f, 1.f, 1.f});
+    BOOST_TEST(verifyDBSCAN(space, points, 1.2f, 2,
+                            dbscan(space, points, 1.2f, 2.f, weights)));
+    BOOST_TEST(verifyDBSCAN(space, points, 1.2f, 3,
+                            dbscan(space, points, 1.2f, 3.f, weights)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(dbscan_periodic, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using ArborX::dbscan;
+  using ArborX::Point;
+
+  ExecutionSpace space;
+
+  // Two pairs straddling the boundaries of a [0,10)^3 periodic box plus an
+  // interior point too far from either; every within-eps pair wraps around
+  auto points = toView<DeviceType, Point>({{0.1f, 5, 5},
+                                           {9.9f, 5, 5},
+                                           {5, 0.2f, 5},
+                                           {5, 9.8f, 5},
+                                           {{5, 5, 5}}});
+  ArborX::Experimental::PeriodicDomain<3> domain({10.f, 10.f, 10.f});
+
+  {
+    auto labels = dbscan(space, points, 0.5f, 2, domain);
+    auto labels_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, labels);
+    BOOST_TEST(labels_host(0) >= 0);
+    BOOST_TEST(labels_host(0) == labels_host(1));
+    BOOST_TEST(labels_host(2) >= 0);
+    BOOST_TEST(labels_host(2) == labels_host(3));
+    BOOST_TEST(labels_host(0) != labels_host(2));
+    BOOST_TEST(labels_host(4) == -1);
+  }
+  {
+    // No point has more than one within-eps neighbor
+    auto labels = dbscan(space, points, 0.5f, 3, domain);
+    auto labels_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, labels);
+    for (int i = 0; i < 5; ++i)
+      BOOST_TEST(labels_host(i) == -1);
+  }
+  {
+    // A domain with open dimensions must not wrap around them
+    ArborX::Experimental::PeriodicDomain<3> open_x({0.f, 10.f, 10.f});
+    auto labels = dbscan(space, points, 0.5f, 2, open_x);
+    auto labels_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, labels);
+    BOOST_TEST(labels_host(0) == -1);
+    BOOST_TEST(labels_host(1) == -1);
+    BOOST_TEST(labels_host(2) >= 0);
+    BOOST_TEST(labels_host(2) == labels_host(3));
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(dbscan_adjacency, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  using ArborX::dbscan;
+  using ArborX::Point;
+  using ArborX::Details::verifyDBSCAN;
+
+  ExecutionSpace space;
+
+  auto points = toView<DeviceType, Point>(
+      {{{0, 0, 0}}, {{1, 0, 0}}, {{2, 0, 0}}, {{10, 0, 0}}});
+
+  float const eps = 1.2f;
+
+  Kokkos::View<int *, MemorySpace> offsets("Testing::offsets", 0);
+  Kokkos::View<int *, MemorySpace> indices("Testing::indices", 0);
+  auto labels = dbscan(space, points, eps, 2, offsets, indices);
+
+  BOOST_TEST(verifyDBSCAN(space, points, eps, 2, labels));
+
+  auto offsets_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets);
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+
+  BOOST_TEST(offsets_host == (std::vector<int>{0, 1, 3, 4, 4}),
+             boost::test_tools::per_element());
+
+  // The order within a row is unspecified
+  for (int i = 0; i < (int)offsets_host.size() - 1; ++i)
+    std::sort(indices_host.data() + offsets_host(i),
+              indices_host.data() + offsets_host(i + 1));
+  BOOST_TEST(indices_host == (std::vector<int>{1, 0, 2, 1}),
+             boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(dbscan_incremental, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  using ArborX::Point;
+  using ArborX::Details::verifyDBSCAN;
+
+  ExecutionSpace space;
+
+  float const r = 1.1f;
+
+  auto points = toView<DeviceType, Point>({
+      {0, 0, 0}, {1, 0, 0}, {2, 0, 0}, // chain
+      {6, 0, 0}, {7, 0, 0},            // pair
+      {10, 0, 0}                       // noise
+  });
+  ArborX::Experimental::IncrementalDBSCAN<MemorySpace, Point> incremental(
+      space, points, r, 2);
+  BOOST_TEST(verifyDBSCAN(space, points, r, 2, incremental.labels(space)));
+
+  // Inserting a bridge must merge the two clusters
+  incremental.insert(
+      space, toView<DeviceType, Point>({{3, 0, 0}, {4, 0, 0}, {5, 0, 0}}));
+  auto all_points = toView<DeviceType, Point>({
+      {0, 0, 0}, {1, 0, 0}, {2, 0, 0}, {6, 0, 0}, {7, 0, 0}, {10, 0, 0},
+      {3, 0, 0}, {4, 0, 0}, {5, 0, 0} // insertion order
+  });
+  BOOST_TEST(verifyDBSCAN(space, all_points, r, 2, incremental.labels(space)));
+
+  // Removing the middle of the bridge must split them again
+  incremental.remove(space, toView<DeviceType, int>({7}));
+  auto labels_host = Kokkos::create_mirror_view_and_copy(
+      Kokkos::HostSpace{}, incremental.labels(space));
+  auto all_points_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, all_points);
+  std::vector<Point> alive_points;
+  std::vector<int> alive_labels;
+  for (int i = 0; i < (int)all_points_host.size(); ++i)
+    if (i != 7)
+    {
+      alive_points.push_back(all_points_host(i));
+      alive_labels.push_back(labels_host(i));
+    }
+  BOOST_TEST(labels_host(7) == -1);
+  BOOST_TEST(verifyDBSCAN(space, toView<DeviceType, Point>(alive_points), r, 2,
+                          toView<DeviceType, int>(alive_labels)));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(dbscan_sweep, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using ArborX::Point;
+  using ArborX::Details::verifyDBSCAN;
+
+  ExecutionSpace space;
+
+  auto points = toView<DeviceType, Point>({
+      {0, 0, 0}, {1, 0, 0}, {2, 0, 0}, // chain
+      {6, 0, 0}, {7, 0, 0},            // pair
+      {10, 0, 0}                       // noise
+  });
+  std::vector<float> eps_values = {0.5f, 1.1f, 2.1f, 4.1f};
+
+  for (int core_min_size : {2, 3})
+  {
+    auto all_labels = ArborX::Experimental::dbscanSweep(
+        space, points, eps_values, core_min_size);
+    BOOST_TEST(all_labels.size() == eps_values.size());
+    for (std::size_t k = 0; k < eps_values.size(); ++k)
+      BOOST_TEST(verifyDBSCAN(space, points, eps_values[k], core_min_size,
+                              all_labels[k]));
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(dbscan_out_of_core, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  using ArborX::Point;
+  using ArborX::Details::verifyDBSCAN;
+
+  ExecutionSpace space;
+
+  // A unit grid forming a single cluster, a pair, and an isolated point
+  std::vector<Point> points_v;
+  for (int i = 0; i < 20; ++i)
+    for (int j = 0; j < 20; ++j)
+      points_v.push_back({(float)i, (float)j, 0});
+  points_v.push_back({5.5f, 5.5f, 5});
+  points_v.push_back({5.5f, 6.4f, 5});
+  points_v.push_back({10.5f, 5.5f, 5});
+
+  Kokkos::View<Point *, Kokkos::HostSpace> points_host(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Test::points"),
+      points_v.size());
+  std::copy(points_v.begin(), points_v.end(), points_host.data());
+
+  auto points = toView<DeviceType, Point>(points_v);
+
+  float const eps = 1.1f;
+  for (int core_min_size : {2, 3})
+  {
+    // A tiny tile budget forces multiple tiles with the cluster straddling
+    // their boundaries
+    auto labels_host = ArborX::Experimental::dbscanOutOfCore(
+        space, points_host, eps, core_min_size, /*max_tile_points=*/16);
+    auto labels =
+        Kokkos::create_mirror_view_and_copy(MemorySpace{}, labels_host);
+    BOOST_TEST(verifyDBSCAN(space, points, eps, core_min_size, labels));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
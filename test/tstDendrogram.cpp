@@ -104,6 +104,45 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(dendrogram_union_find, DeviceType,
   }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(dendrogram_alpha, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  using namespace ArborX::Details;
+  using ArborX::Experimental::Dendrogram;
+  using ArborX::Experimental::DendrogramImplementation;
+
+  ExecutionSpace space;
+
+  // Stay below the size where the MST starts producing edges of equal weight
+  // (see the comment in dendrogram_boruvka), as the alpha-tree construction
+  // ranks equal-weight edges by their sorted position rather than by the
+  // union-find processing order
+  int const n = 3000;
+  auto points = ArborXTest::make_random_cloud<ArborX::Point>(space, n);
+
+  MinimumSpanningTree<MemorySpace> mst(space, points);
+
+  Dendrogram<MemorySpace> dendrogram_alpha(space, mst.edges,
+                                           DendrogramImplementation::ALPHA);
+  Dendrogram<MemorySpace> dendrogram_union_find(
+      space, mst.edges, DendrogramImplementation::UNION_FIND);
+
+  auto parents_alpha = Kokkos::create_mirror_view_and_copy(
+      Kokkos::HostSpace{}, dendrogram_alpha._parents);
+  auto heights_alpha = Kokkos::create_mirror_view_and_copy(
+      Kokkos::HostSpace{}, dendrogram_alpha._parent_heights);
+  auto parents_union_find = Kokkos::create_mirror_view_and_copy(
+      Kokkos::HostSpace{}, dendrogram_union_find._parents);
+  auto heights_union_find = Kokkos::create_mirror_view_and_copy(
+      Kokkos::HostSpace{}, dendrogram_union_find._parent_heights);
+
+  BOOST_TEST(parents_alpha == parents_union_find, tt::per_element());
+  BOOST_TEST(heights_alpha == heights_union_find, tt::per_element());
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(dendrogram_boruvka, DeviceType,
                               ARBORX_DEVICE_TYPES)
 {
@@ -15,6 +15,8 @@
 #include <ArborX_HyperPoint.hpp>
 #include <ArborX_HyperSphere.hpp>
 #include <ArborX_HyperTriangle.hpp>
+#include <ArborX_OBB.hpp>
+#include <ArborX_RoundedFloatBox.hpp>
 
 #include <boost/mpl/list.hpp>
 
@@ -280,3 +282,106 @@ BOOST_AUTO_TEST_CASE(is_valid)
   BOOST_TEST(!isValid(Sphere{{{0., -infty, 0.}}, +1.}));
   BOOST_TEST(isValid(Sphere{}));
 }
+
+BOOST_AUTO_TEST_CASE(obb)
+{
+  using ArborX::Details::distance;
+  using ArborX::Details::equals;
+  using ArborX::Details::expand;
+  using ArborX::Details::intersects;
+  using ArborX::Details::returnCentroid;
+  using ArborX::Experimental::OBB;
+
+  namespace tt = boost::test_tools;
+
+  // thin box of length 4 running along the xy diagonal
+  auto const s = std::sqrt(2.f) / 2;
+  OBB const diagonal{{0, 0, 0},
+                     {{s, s, 0}, {-s, s, 0}, {0, 0, 1}},
+                     {2.f, .1f, .1f}};
+
+  // points on the long axis are inside, points off it are not
+  BOOST_TEST(intersects(Point{{0., 0., 0.}}, diagonal));
+  BOOST_TEST(intersects(Point{{1., 1., 0.}}, diagonal));
+  BOOST_TEST(!intersects(Point{{2., 2., 0.}}, diagonal));
+  BOOST_TEST(!intersects(Point{{1., -1., 0.}}, diagonal));
+  BOOST_TEST(!intersects(Point{{1., 1., .2}}, diagonal));
+
+  BOOST_TEST(distance(Point{{0., 0., 0.}}, diagonal) == 0.f);
+  BOOST_TEST(distance(Point{{1., -1., 0.}}, diagonal) ==
+                 std::sqrt(2.f) - .1f,
+             tt::tolerance(1e-5f));
+
+  // the same box in the trivial frame misses points on the diagonal ends
+  OBB const aligned{{0, 0, 0},
+                    {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}},
+                    {2.f, .1f, .1f}};
+  BOOST_TEST(!intersects(Point{{1.2, 1.2, 0.}}, aligned));
+  BOOST_TEST(intersects(Point{{1.2, 1.2, 0.}}, diagonal));
+
+  // the two boxes overlap around the origin; pushing one along the
+  // anti-diagonal separates them
+  BOOST_TEST(intersects(diagonal, aligned));
+  OBB shifted = aligned;
+  shifted._centroid = {-2, 2, 0};
+  BOOST_TEST(!intersects(diagonal, shifted));
+
+  // axis-aligned box overlap checks go through the same separating axis test
+  BOOST_TEST(intersects(diagonal, Box{{{.9, .9, -.05}}, {{1.1, 1.1, .05}}}));
+  BOOST_TEST(intersects(Box{{{.9, .9, -.05}}, {{1.1, 1.1, .05}}}, diagonal));
+  BOOST_TEST(!intersects(Box{{{.9, -1.1, -.05}}, {{1.1, -.9, .05}}}, diagonal));
+
+  BOOST_TEST(intersects(Sphere{{{1., -1., 0.}}, 1.5}, diagonal));
+  BOOST_TEST(!intersects(Sphere{{{1., -1., 0.}}, 1.}, diagonal));
+
+  // axis-aligned bounds project the half-extents onto each axis
+  Box box;
+  expand(box, diagonal);
+  BOOST_TEST(box.minCorner()[0] == -2.1f * s, tt::tolerance(1e-5f));
+  BOOST_TEST(box.maxCorner()[1] == 2.1f * s, tt::tolerance(1e-5f));
+  BOOST_TEST(box.minCorner()[2] == -.1f);
+  BOOST_TEST(box.maxCorner()[2] == .1f);
+
+  BOOST_TEST(equals(diagonal, diagonal));
+  BOOST_TEST(!equals(diagonal, aligned));
+
+  auto center = returnCentroid(diagonal);
+  BOOST_TEST(center[0] == 0.f);
+  BOOST_TEST(center[1] == 0.f);
+  BOOST_TEST(center[2] == 0.f);
+}
+
+BOOST_AUTO_TEST_CASE(rounded_float_box)
+{
+  using ArborX::Details::expand;
+  using ArborX::ExperimentalHyperGeometry::Point;
+  ArborX::Experimental::RoundedFloatBox<3> box;
+
+  // 0.1 is not representable in binary; the corners must straddle it
+  expand(box, Point<3, double>{0.1, 0.2, 0.3});
+  for (int d = 0; d < 3; ++d)
+  {
+    BOOST_TEST(static_cast<double>(box.minCorner()[d]) < 0.1 * (d + 1));
+    BOOST_TEST(static_cast<double>(box.maxCorner()[d]) > 0.1 * (d + 1));
+  }
+
+  // representable values are not widened
+  expand(box, Point<3, double>{0.5, 0.5, 0.5});
+  BOOST_TEST(box.maxCorner()[0] == 0.5f);
+
+  // expanding with a double box and a double sphere stays conservative
+  expand(box, ArborX::ExperimentalHyperGeometry::Box<3, double>{
+                  {{-0.1, -0.1, -0.1}}, {{0.1, 0.1, 0.1}}});
+  BOOST_TEST(static_cast<double>(box.minCorner()[0]) < -0.1);
+  expand(box, ArborX::ExperimentalHyperGeometry::Sphere<3, double>{
+                  {{0., 0., 0.}}, 0.7});
+  BOOST_TEST(static_cast<double>(box.maxCorner()[2]) > 0.7);
+  BOOST_TEST(static_cast<double>(box.minCorner()[2]) < -0.7);
+
+  // float-float unions do not drift: the union of a rounded box with itself
+  // leaves the corners unchanged
+  auto const copy = box;
+  expand(box, copy);
+  using ArborX::Details::equals;
+  BOOST_TEST(equals(box, copy));
+}
@@ -97,3 +97,46 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(query_impl, DeviceType, ARBORX_DEVICE_TYPES)
   BOOST_TEST(offset_host == offset_ref, tt::per_element());
   BOOST_TEST(indices_host == indices_ref, tt::per_element());
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(materialize_permuted_predicates, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  ExecutionSpace space;
+
+  int const n = 10;
+  using Predicate = decltype(ArborX::intersects(std::declval<ArborX::Point>()));
+  Kokkos::View<Predicate *, DeviceType> predicates(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "Testing::predicates"),
+      n);
+  // Reversing permutation, so every entry moves
+  Kokkos::View<unsigned int *, DeviceType> permute(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "Testing::permute"),
+      n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        predicates(i) = ArborX::intersects(ArborX::Point{(float)i, 0, 0});
+        permute(i) = n - 1 - i;
+      });
+
+  auto materialized =
+      ArborX::Details::CrsGraphWrapperImpl::materializePermutedPredicates(
+          space, predicates, permute);
+  BOOST_TEST((int)materialized.size() == n);
+
+  // Entry i must hold predicate permute(i) with position i attached
+  Kokkos::View<int *, DeviceType> errors("Testing::errors", n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        auto const &predicate = materialized(i);
+        errors(i) = (getData(predicate) != i ||
+                     getGeometry(predicate)[0] != (float)(n - 1 - i));
+      });
+  auto errors_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, errors);
+  for (int i = 0; i < n; ++i)
+    BOOST_TEST(errors_host(i) == 0);
+}
@@ -350,10 +350,13 @@ struct Helper
 {
   template <typename View1, typename View2, typename View3>
   static void checkSendAcrossNetwork(MPI_Comm comm, View1 const &ranks,
-                                     View2 const &v_exp, View3 const &v_ref)
+                                     View2 const &v_exp, View3 const &v_ref,
+                                     bool topology_aware = false)
   {
     ArborX::Details::Distributor<DeviceType> distributor(comm);
     distributor.createFromSends(typename DeviceType::execution_space{}, ranks);
+    if (topology_aware)
+      distributor.enableTopologyAwareScheduling();
 
     // NOTE here we assume that the reference solution is sized properly
     auto v_imp = Kokkos::create_mirror(typename View3::memory_space(), v_ref);
@@ -415,4 +418,9 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(send_across_network, DeviceType,
       u_exp};
   Helper<DeviceType>::checkSendAcrossNetwork(comm, ranks_u, u_exp_unmanaged,
                                              u_ref);
+
+  // The topology-aware schedule changes the posting order only; the result
+  // must not depend on it
+  Helper<DeviceType>::checkSendAcrossNetwork(comm, ranks_u, u_exp, u_ref,
+                                             /*topology_aware*/ true);
 }
@@ -0,0 +1,86 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <ArborX_DetailsHilbertCode.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <array>
+
+using namespace ArborX::Details;
+
+#include <ArborX_HyperPoint.hpp>
+
+BOOST_AUTO_TEST_SUITE(HilbertCodes)
+
+BOOST_AUTO_TEST_CASE(hilbert_codes_1d)
+{
+  using ArborX::ExperimentalHyperGeometry::Point;
+
+  // In 1D the Hilbert curve degenerates to the identity
+  BOOST_TEST(hilbert32(Point{0.f}) == 0x0u);
+  BOOST_TEST(hilbert32(Point{0.5f}) == 0x40000000u);
+  BOOST_TEST(hilbert64(Point{0.f}) == 0x0llu);
+  BOOST_TEST(hilbert64(Point{0.5f}) == 0x4000000000000000llu);
+}
+
+// The defining property of the Hilbert curve: consecutive cells along the
+// curve are face neighbors. Check it on the 2^DIM top-level subdivisions.
+template <int DIM, typename Codes>
+void checkOrthantAdjacency(Codes const &codes)
+{
+  int const n = (int)codes.size();
+
+  std::array<int, (1 << DIM)> order;
+  for (int i = 0; i < n; ++i)
+    order[i] = i;
+  std::sort(order.begin(), order.begin() + n,
+            [&codes](int i, int j) { return codes[i] < codes[j]; });
+
+  for (int i = 0; i < n - 1; ++i)
+  {
+    // Orthants differing in exactly one bit share a face
+    int const diff = order[i] ^ order[i + 1];
+    BOOST_TEST((diff & (diff - 1)) == 0);
+    BOOST_TEST(diff != 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(hilbert_codes_orthant_adjacency)
+{
+  using ArborX::ExperimentalHyperGeometry::Point;
+
+  std::array<unsigned int, 4> codes_2d_32;
+  std::array<unsigned long long, 4> codes_2d_64;
+  for (int i = 0; i < 4; ++i)
+  {
+    Point<2> const p{(i & 1 ? 0.75f : 0.25f), (i & 2 ? 0.75f : 0.25f)};
+    codes_2d_32[i] = hilbert32(p);
+    codes_2d_64[i] = hilbert64(p);
+  }
+  checkOrthantAdjacency<2>(codes_2d_32);
+  checkOrthantAdjacency<2>(codes_2d_64);
+
+  std::array<unsigned int, 8> codes_3d_32;
+  std::array<unsigned long long, 8> codes_3d_64;
+  for (int i = 0; i < 8; ++i)
+  {
+    Point<3> const p{(i & 1 ? 0.75f : 0.25f), (i & 2 ? 0.75f : 0.25f),
+                     (i & 4 ? 0.75f : 0.25f)};
+    codes_3d_32[i] = hilbert32(p);
+    codes_3d_64[i] = hilbert64(p);
+  }
+  checkOrthantAdjacency<3>(codes_3d_32);
+  checkOrthantAdjacency<3>(codes_3d_64);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,110 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include "ArborX_EnableViewComparison.hpp"
+#include <ArborX_DetailsKokkosExtSegmentedSort.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#define BOOST_TEST_MODULE KokkosExtSegmentedSort
+
+namespace tt = boost::test_tools;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(segmented_sort_by_key, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  namespace KokkosExt = ArborX::Details::KokkosExt;
+
+  ExecutionSpace space{};
+
+  // Segment lengths exercise the empty, single-element, serial, and
+  // cooperative (length above the team threshold) paths
+  std::vector<int> segment_sizes = {5, 0, 1, 63, 64, 65, 200, 2};
+  int const n_segments = segment_sizes.size();
+
+  std::vector<int> offsets_host(n_segments + 1);
+  offsets_host[0] = 0;
+  std::partial_sum(segment_sizes.begin(), segment_sizes.end(),
+                   offsets_host.begin() + 1);
+  int const n = offsets_host.back();
+
+  std::vector<float> keys_host(n);
+  std::vector<int> values_host(n);
+  for (int i = 0; i < n; ++i)
+  {
+    // Deterministic scrambled keys with duplicates
+    keys_host[i] = (float)((i * 97) % 89);
+    values_host[i] = i;
+  }
+
+  Kokkos::View<int *, DeviceType> offsets("offsets", n_segments + 1);
+  Kokkos::View<float *, DeviceType> keys("keys", n);
+  Kokkos::View<int *, DeviceType> values("values", n);
+  Kokkos::deep_copy(
+      offsets, Kokkos::View<int *, Kokkos::HostSpace,
+                            Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+                   offsets_host.data(), n_segments + 1));
+  Kokkos::deep_copy(keys,
+                    Kokkos::View<float *, Kokkos::HostSpace,
+                                 Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+                        keys_host.data(), n));
+  Kokkos::deep_copy(values,
+                    Kokkos::View<int *, Kokkos::HostSpace,
+                                 Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+                        values_host.data(), n));
+
+  KokkosExt::segmentedSortByKey(space, offsets, keys, values);
+
+  // Sort each segment on the host pairing keys with values
+  std::vector<float> keys_ref = keys_host;
+  std::vector<int> values_ref = values_host;
+  for (int s = 0; s < n_segments; ++s)
+  {
+    std::vector<std::pair<float, int>> segment;
+    for (int i = offsets_host[s]; i < offsets_host[s + 1]; ++i)
+      segment.emplace_back(keys_ref[i], values_ref[i]);
+    std::stable_sort(segment.begin(), segment.end(),
+                     [](auto const &lhs, auto const &rhs) {
+                       return lhs.first < rhs.first;
+                     });
+    for (int i = offsets_host[s]; i < offsets_host[s + 1]; ++i)
+    {
+      keys_ref[i] = segment[i - offsets_host[s]].first;
+      values_ref[i] = segment[i - offsets_host[s]].second;
+    }
+  }
+
+  auto keys_out = Kokkos::create_mirror_view(keys);
+  Kokkos::deep_copy(keys_out, keys);
+  BOOST_TEST(keys_ref == keys_out, tt::per_element());
+
+  // Equal keys may come out in any order within a segment; compare the
+  // values only where the key is unique in its segment
+  auto values_out = Kokkos::create_mirror_view(values);
+  Kokkos::deep_copy(values_out, values);
+  for (int s = 0; s < n_segments; ++s)
+    for (int i = offsets_host[s]; i < offsets_host[s + 1]; ++i)
+    {
+      bool const unique =
+          (i == offsets_host[s] || keys_ref[i - 1] != keys_ref[i]) &&
+          (i + 1 == offsets_host[s + 1] || keys_ref[i] != keys_ref[i + 1]);
+      if (unique)
+        BOOST_TEST(values_out(i) == values_ref[i]);
+    }
+}
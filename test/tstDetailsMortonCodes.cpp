@@ -81,4 +81,38 @@ BOOST_AUTO_TEST_CASE(morton_codes)
   BOOST_TEST(morton64(Point{1.f, 1.f, 0.f}) == 0x6db6db6db6db6db6llu);
 }
 
+BOOST_AUTO_TEST_CASE(morton_codes_128)
+{
+  using ArborX::ExperimentalHyperGeometry::Point;
+
+  // Both 63-bit (3D) and 52-bit (2D) halves carry the same interleaving
+  // pattern as the corresponding 64-bit code
+  BOOST_TEST((morton128(Point{0.f, 0.f}) == UInt128{0x0llu, 0x0llu}));
+  BOOST_TEST((morton128(Point{1.f, 1.f}) ==
+              UInt128{0xfffffffffffffllu, 0xfffffffffffffllu}));
+  BOOST_TEST((morton128(Point{0.f, 1.f}) ==
+              UInt128{0x5555555555555llu, 0x5555555555555llu}));
+  BOOST_TEST((morton128(Point{1.f, 0.f}) ==
+              UInt128{0xaaaaaaaaaaaaallu, 0xaaaaaaaaaaaaallu}));
+
+  BOOST_TEST((morton128(Point{0.f, 0.f, 0.f}) == UInt128{0x0llu, 0x0llu}));
+  BOOST_TEST((morton128(Point{1.f, 1.f, 1.f}) ==
+              UInt128{0x7fffffffffffffffllu, 0x7fffffffffffffffllu}));
+  BOOST_TEST((morton128(Point{0.f, 0.f, 1.f}) ==
+              UInt128{0x1249249249249249llu, 0x1249249249249249llu}));
+  BOOST_TEST((morton128(Point{1.f, 1.f, 0.f}) ==
+              UInt128{0x6db6db6db6db6db6llu, 0x6db6db6db6db6db6llu}));
+
+  // Comparisons are lexicographic on (hi, lo)
+  BOOST_TEST((UInt128{0, 1} < UInt128{1, 0}));
+  BOOST_TEST((UInt128{1, 0} < UInt128{1, 1}));
+  BOOST_TEST(!(UInt128{1, 1} < UInt128{1, 1}));
+  BOOST_TEST((UInt128{1, 1} <= UInt128{1, 1}));
+  BOOST_TEST((UInt128{1, 0} > UInt128{0, ~0llu}));
+
+  // Byte extraction used by the radix sort passes
+  BOOST_TEST(radixSortByte(UInt128{0xabllu << 8, 0xcdllu}, 0) == 0xcdu);
+  BOOST_TEST(radixSortByte(UInt128{0xabllu << 8, 0xcdllu}, 72) == 0xabu);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -18,6 +18,7 @@
 #include <ArborX_DetailsSortUtils.hpp>  // sortObjects
 #include <ArborX_DetailsTreeConstruction.hpp>
 #include <ArborX_IndexableGetter.hpp>
+#include <ArborX_SpaceFillingCurves.hpp>
 
 #include <boost/test/unit_test.hpp>
 
@@ -149,6 +150,36 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(indirect_sort, DeviceType, ARBORX_DEVICE_TYPES)
   BOOST_TEST(ids_host == ref, tt::per_element());
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(indirect_sort_128, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  // same as above for 128-bit Morton codes, whose ordering is lexicographic
+  // on the (hi, lo) halves
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using ArborX::Details::UInt128;
+
+  unsigned int const n = 4;
+  Kokkos::View<UInt128 *, DeviceType> k("k", n);
+  Kokkos::parallel_for(
+      "fill_k", Kokkos::RangePolicy<ExecutionSpace>(0, n),
+      KOKKOS_LAMBDA(int const i) {
+        // {1,1}, {1,0}, {0,1}, {0,0}
+        k[i] = {(unsigned long long)(3 - i) / 2, (unsigned long long)(3 - i) % 2};
+      });
+
+  std::vector<size_t> ref = {3, 2, 1, 0};
+  auto ids = ArborX::Details::sortObjects(ExecutionSpace{}, k);
+
+  auto k_host = Kokkos::create_mirror_view(k);
+  Kokkos::deep_copy(k_host, k);
+  auto ids_host = Kokkos::create_mirror_view(ids);
+  Kokkos::deep_copy(ids_host, ids);
+
+  for (unsigned int i = 0; i < n - 1; ++i)
+    BOOST_TEST((k_host[i] < k_host[i + 1]));
+  BOOST_TEST(ids_host == ref, tt::per_element());
+}
+
 template <typename Primitives, typename MortonCodes, typename LeafNodes,
           typename InternalNodes>
 void generateHierarchy(Primitives primitives, MortonCodes sorted_morton_codes,
@@ -269,3 +300,50 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(example_tree_construction, DeviceType,
 
   BOOST_TEST(sol.str() == ref.str());
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(auto_morton_selection, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space;
+
+  int const n = 20000;
+  Kokkos::View<ArborX::Point *, MemorySpace> points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::points"),
+      n);
+  Kokkos::parallel_for(
+      "Test::generate_uniform_cloud",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {(float)(i % 28), (float)((i / 28) % 28),
+                     (float)(i / 784)};
+      });
+
+  using Values =
+      ArborX::Details::AccessValues<decltype(points), ArborX::PrimitivesTag>;
+  ArborX::Details::DefaultIndexableGetter indexable_getter;
+
+  // A uniform mid-size cloud resolves comfortably in 32 bits
+  BOOST_TEST(ArborX::Details::selectNarrowMortonCode(
+      space, Values{points}, indexable_getter,
+      ArborX::Experimental::AutoMorton{}));
+
+  // The count cap forces the wide code regardless of the distribution
+  BOOST_TEST(!ArborX::Details::selectNarrowMortonCode(
+      space, Values{points}, indexable_getter,
+      ArborX::Experimental::AutoMorton{/*max_count*/ 1000}));
+
+  // A remote outlier stretches the scene box without spreading the cloud,
+  // so the effective spacing is far finer than the extent suggests
+  Kokkos::parallel_for(
+      "Test::generate_clustered_cloud",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {1.e-4f * (i % 28), 1.e-4f * ((i / 28) % 28),
+                     1.e-4f * (i / 784)};
+        if (i == 0)
+          points(i) = {1.e6f, 1.e6f, 1.e6f};
+      });
+  BOOST_TEST(!ArborX::Details::selectNarrowMortonCode(
+      space, Values{points}, indexable_getter,
+      ArborX::Experimental::AutoMorton{}));
+}
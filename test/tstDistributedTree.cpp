@@ -18,8 +18,10 @@
 #include <boost/test/unit_test.hpp>
 
 #include <algorithm>
+#include <cstdio> // remove
 #include <iostream>
 #include <random>
+#include <string>
 #include <tuple>
 
 #include "Search_UnitTestHelpers.hpp"
@@ -684,6 +686,95 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(callback_with_attachment, DeviceType,
   }
 }
 
+template <typename DeviceType>
+struct CustomReductionPostCallback
+{
+  using tag = ArborX::Details::ReductionPostCallbackTag;
+  Kokkos::View<ArborX::Point *, DeviceType> points;
+  ArborX::Point const origin = {{0., 0., 0.}};
+  template <typename Predicates, typename InOutView, typename InView,
+            typename OutView>
+  void operator()(Predicates const &queries, InOutView &offset, InView in,
+                  OutView &out) const
+  {
+    using ExecutionSpace = typename DeviceType::execution_space;
+    using ArborX::Details::distance;
+    auto const n = offset.extent(0) - 1;
+    // One reduced value per predicate, the distance of its closest match
+    Kokkos::realloc(out, n);
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<ExecutionSpace>(0, n), KOKKOS_CLASS_LAMBDA(int i) {
+          auto data = ArborX::getData(queries(i));
+          float reduced = -1.f;
+          for (int j = offset(i); j < offset(i + 1); ++j)
+          {
+            float const value = (float)distance(points(in(j)), origin) + data;
+            if (reduced < 0 || value < reduced)
+              reduced = value;
+          }
+          out(i) = reduced;
+        });
+  }
+};
+BOOST_AUTO_TEST_CASE_TEMPLATE(reduction_post_callback, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+  int comm_size;
+  MPI_Comm_size(comm, &comm_size);
+
+  // Same setup as callback_with_attachment: one box per rank, and a query
+  // point landing in the next rank's box. Each predicate matches a single
+  // primitive on a single remote rank, so the reduced value per contacted
+  // rank coincides with the per-match value of the inline callback.
+  auto const tree = makeDistributedTree<DeviceType>(
+      comm,
+      {{{{(double)comm_rank, 0., 0.}}, {{(double)comm_rank + 1, 1., 1.}}}});
+
+  int const n_queries = 1;
+  Kokkos::View<ArborX::Point *, DeviceType> points("Testing::points",
+                                                   n_queries);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(0, n_queries), KOKKOS_LAMBDA(int i) {
+        points(i) = {(float)(comm_rank) + 1.5f, 0.f, 0.f};
+      });
+  auto points_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, points);
+
+  // As in callback_with_attachment, the callback runs on the rank producing
+  // the results, so points(0) within the callback refers to that rank's
+  // point
+  int const n_results = (comm_rank < comm_size - 1) ? 1 : 0;
+  ArborX::Point const origin = {{0., 0., 0.}};
+  Kokkos::View<float *, DeviceType> ref("Testing::ref", n_results);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(0, n_results), KOKKOS_LAMBDA(int i) {
+        ref(i) =
+            float(ArborX::Details::distance(points(i), origin) + 1) + comm_rank;
+      });
+
+  Kokkos::View<float *, DeviceType> custom("Testing::custom", 0);
+  Kokkos::View<int *, DeviceType> offset("Testing::offset", 0);
+  tree.query(ExecutionSpace{},
+             makeIntersectsBoxWithAttachmentQueries<DeviceType, int>(
+                 {{points_host(0), points_host(0)}}, {comm_rank}),
+             CustomReductionPostCallback<DeviceType>{points}, custom, offset);
+
+  auto custom_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, custom);
+  auto ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, ref);
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+  BOOST_TEST(make_compressed_storage(offset_host, custom_host) ==
+                 make_compressed_storage(offset_host, ref_host),
+             tt::per_element());
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(boost_comparison, DeviceType, ARBORX_DEVICE_TYPES)
 {
   using ExecutionSpace = typename DeviceType::execution_space;
@@ -848,3 +939,53 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(distributed_ray, DeviceType, ARBORX_DEVICE_TYPES)
       make_reference_solution<PairIndexRank>({{0, comm_rank}, {0, 0}},
                                              {0, 1, 2}));
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(save_and_load, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+  int comm_size;
+  MPI_Comm_size(comm, &comm_size);
+
+  // tree has one leaf per rank
+  auto const tree = makeDistributedTree<DeviceType>(
+      comm,
+      {
+          {{{(double)comm_rank, 0., 0.}}, {{(double)comm_rank + 1., 1., 1.}}},
+      });
+
+  std::string const prefix = "ArborX_tstDistributedTree_save_and_load";
+  tree.saveToFile(prefix);
+  auto const tree_reloaded =
+      ArborX::DistributedTree<typename DeviceType::memory_space>::loadFromFile(
+          comm, ExecutionSpace{}, prefix);
+  // saveToFile() returned only once every file was complete, so the loads
+  // above could not race with the writes; the files are no longer needed
+  std::remove((prefix + ".bottom." + std::to_string(comm_rank)).c_str());
+  if (comm_rank == 0)
+    std::remove((prefix + ".top").c_str());
+
+  BOOST_TEST(tree_reloaded.size() == tree.size());
+  BOOST_TEST(ArborX::Details::equals(tree_reloaded.bounds(), tree.bounds()));
+
+  ARBORX_TEST_QUERY_TREE(
+      ExecutionSpace{}, tree_reloaded,
+      makeIntersectsBoxQueries<DeviceType>({
+          {{{(double)comm_size - (double)comm_rank - .5, .5, .5}},
+           {{(double)comm_size - (double)comm_rank - .5, .5, .5}}},
+          {{{(double)comm_rank + .5, .5, .5}},
+           {{(double)comm_rank + .5, .5, .5}}},
+      }),
+      make_reference_solution<PairIndexRank>(
+          {{0, comm_size - 1 - comm_rank}, {0, comm_rank}}, {0, 1, 2}));
+
+  ARBORX_TEST_QUERY_TREE(ExecutionSpace{}, tree_reloaded,
+                         makeNearestQueries<DeviceType>({
+                             {{{(double)comm_rank + .5, .5, .5}}, 1},
+                         }),
+                         make_reference_solution<PairIndexRank>(
+                             {{0, comm_rank}}, {0, 1}));
+}
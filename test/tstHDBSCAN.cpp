@@ -0,0 +1,81 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborXTest_StdVectorToKokkosView.hpp"
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_HDBSCAN.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(HDBSCAN)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(hdbscan_labels, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using ArborX::Experimental::DendrogramImplementation;
+  using ArborXTest::toView;
+
+  ExecutionSpace exec_space;
+
+  // Two well-separated tight groups and a far away straggler: the groups
+  // must come out as two different clusters and the straggler as noise
+  std::vector<ArborX::Point> points{
+      {0.0f, 0, 0}, {0.1f, 0, 0},  {0.2f, 0, 0},  {0.3f, 0, 0},
+      {10.0f, 0, 0}, {10.1f, 0, 0}, {10.2f, 0, 0}, {10.3f, 0, 0},
+      {100.f, 0, 0},
+  };
+  auto points_device = toView<ExecutionSpace>(points, "Test::points");
+
+  for (auto dendrogram_impl : {DendrogramImplementation::BORUVKA,
+                               DendrogramImplementation::UNION_FIND})
+  {
+    auto labels = ArborX::Experimental::hdbscanLabels(
+        exec_space, points_device, /*core_min_size=*/2, /*min_cluster_size=*/3,
+        dendrogram_impl);
+
+    auto labels_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, labels);
+
+    BOOST_TEST(labels_host(0) >= 0);
+    BOOST_TEST(labels_host(4) >= 0);
+    for (int i = 1; i < 4; ++i)
+      BOOST_TEST(labels_host(i) == labels_host(0));
+    for (int i = 5; i < 8; ++i)
+      BOOST_TEST(labels_host(i) == labels_host(4));
+    BOOST_TEST(labels_host(0) != labels_host(4));
+    BOOST_TEST(labels_host(8) == -1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(hdbscan_labels_all_noise, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using ArborXTest::toView;
+
+  ExecutionSpace exec_space;
+
+  std::vector<ArborX::Point> points{{0, 0, 0}, {1, 0, 0}, {2, 0, 0}};
+  auto points_device = toView<ExecutionSpace>(points, "Test::points");
+
+  // min_cluster_size exceeding the problem size leaves every point
+  // unclustered
+  auto labels = ArborX::Experimental::hdbscanLabels(
+      exec_space, points_device, /*core_min_size=*/2, /*min_cluster_size=*/5);
+
+  auto labels_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, labels);
+  for (int i = 0; i < 3; ++i)
+    BOOST_TEST(labels_host(i) == -1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,152 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborXTest_Cloud.hpp"
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_LinearBVH.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+
+BOOST_AUTO_TEST_SUITE(IndexOnlyBVH)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(index_only_bvh_vs_legacy, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  // Leaves holding bare indices with the geometry fetched from the user's
+  // view must produce exactly the same spatial results as the legacy tree
+  // that copies the geometry into its values
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  int const n = 256;
+  auto points = ArborXTest::make_random_cloud<ArborX::Point>(exec_space, n);
+
+  float const radius = 0.15f;
+
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, MemorySpace>
+      predicates(Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                                    "Test::predicates"),
+                 n);
+  Kokkos::parallel_for(
+      "Test::make_predicates",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        predicates(i) = ArborX::intersects(ArborX::Sphere{points(i), radius});
+      });
+
+  ArborX::BVH<MemorySpace> bvh(exec_space, points);
+  auto index_only_bvh =
+      ArborX::Experimental::make_index_only_bvh(exec_space, points);
+
+  BOOST_TEST(index_only_bvh.size() == (unsigned)n);
+
+  Kokkos::View<int *, MemorySpace> bvh_indices("Test::bvh_indices", 0);
+  Kokkos::View<int *, MemorySpace> bvh_offset("Test::bvh_offset", 0);
+  ArborX::query(bvh, exec_space, predicates, bvh_indices, bvh_offset);
+
+  Kokkos::View<unsigned *, MemorySpace> indices("Test::indices", 0);
+  Kokkos::View<int *, MemorySpace> offset("Test::offset", 0);
+  index_only_bvh.query(exec_space, predicates, indices, offset);
+
+  auto bvh_indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, bvh_indices);
+  auto bvh_offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, bvh_offset);
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+
+  BOOST_TEST(offset_host.size() == bvh_offset_host.size());
+  for (int i = 0; i < n; ++i)
+  {
+    BOOST_TEST(offset_host(i) == bvh_offset_host(i));
+    std::set<int> expected(bvh_indices_host.data() + bvh_offset_host(i),
+                           bvh_indices_host.data() + bvh_offset_host(i + 1));
+    std::set<int> actual(indices_host.data() + offset_host(i),
+                         indices_host.data() + offset_host(i + 1));
+    BOOST_TEST((actual == expected));
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(index_only_bvh_converted_primitives, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  // Primitives that are not their own bounding volume (here spheres) are
+  // converted to boxes on the fly by the indexable getter; the results must
+  // match the legacy tree that stores the converted boxes in its leaves
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  int const n = 256;
+  auto points = ArborXTest::make_random_cloud<ArborX::Point>(exec_space, n);
+
+  Kokkos::View<ArborX::Sphere *, MemorySpace> spheres(
+      Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                         "Test::spheres"),
+      n);
+  Kokkos::parallel_for(
+      "Test::make_spheres",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        spheres(i) = ArborX::Sphere{points(i), 0.05f + 0.1f * (i % 3)};
+      });
+
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, MemorySpace>
+      predicates(Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                                    "Test::predicates"),
+                 n);
+  Kokkos::parallel_for(
+      "Test::make_predicates",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        predicates(i) = ArborX::intersects(ArborX::Sphere{points(i), 0.15f});
+      });
+
+  ArborX::BVH<MemorySpace> bvh(exec_space, spheres);
+  auto index_only_bvh =
+      ArborX::Experimental::make_index_only_bvh(exec_space, spheres);
+
+  Kokkos::View<int *, MemorySpace> bvh_indices("Test::bvh_indices", 0);
+  Kokkos::View<int *, MemorySpace> bvh_offset("Test::bvh_offset", 0);
+  ArborX::query(bvh, exec_space, predicates, bvh_indices, bvh_offset);
+
+  Kokkos::View<unsigned *, MemorySpace> indices("Test::indices", 0);
+  Kokkos::View<int *, MemorySpace> offset("Test::offset", 0);
+  index_only_bvh.query(exec_space, predicates, indices, offset);
+
+  auto bvh_indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, bvh_indices);
+  auto bvh_offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, bvh_offset);
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+
+  BOOST_TEST(offset_host.size() == bvh_offset_host.size());
+  for (int i = 0; i < n; ++i)
+  {
+    BOOST_TEST(offset_host(i) == bvh_offset_host(i));
+    std::set<int> expected(bvh_indices_host.data() + bvh_offset_host(i),
+                           bvh_indices_host.data() + bvh_offset_host(i + 1));
+    std::set<int> actual(indices_host.data() + offset_host(i),
+                         indices_host.data() + offset_host(i + 1));
+    BOOST_TEST((actual == expected));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
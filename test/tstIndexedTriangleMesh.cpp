@@ -0,0 +1,118 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_HyperBox.hpp>
+#include <ArborX_HyperPoint.hpp>
+#include <ArborX_LinearBVH.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm> // min, max
+
+BOOST_AUTO_TEST_SUITE(IndexedTriangleMesh)
+
+// Strip of n triangles sharing a vertex buffer: the tree is built straight
+// off the vertex and index views, the stored values are face indices, and
+// the face boxes are computed on the fly. Neither triangles nor boxes are
+// ever materialized in an intermediate array.
+BOOST_AUTO_TEST_CASE_TEMPLATE(indexed_triangle_mesh, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space;
+
+  using Point = ArborX::ExperimentalHyperGeometry::Point<3>;
+  using Box = ArborX::ExperimentalHyperGeometry::Box<3>;
+
+  int const n = 20;
+
+  // vertices of a zigzag strip in the z = 0 plane; face i spans [i/2, i/2+1]
+  // in x
+  Kokkos::View<Point *, MemorySpace> vertices(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::vertices"),
+      n + 2);
+  Kokkos::parallel_for(
+      "Test::generate_vertices",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n + 2),
+      KOKKOS_LAMBDA(int i) {
+        vertices(i) = {(float)(i / 2), (float)(i % 2), 0.f};
+      });
+  Kokkos::View<int *, MemorySpace> vertex_indices(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing,
+                         "Test::vertex_indices"),
+      3 * n);
+  Kokkos::parallel_for(
+      "Test::generate_indices", Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        vertex_indices(3 * i + 0) = i;
+        vertex_indices(3 * i + 1) = i + 1;
+        vertex_indices(3 * i + 2) = i + 2;
+      });
+
+  using Mesh = ArborX::Experimental::IndexedTriangleMesh<
+      decltype(vertices), decltype(vertex_indices)>;
+  Mesh mesh{vertices, vertex_indices};
+
+  // stored values are the face indices themselves
+  Kokkos::View<int *, MemorySpace> faces(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::faces"), n);
+  Kokkos::parallel_for(
+      "Test::generate_faces", Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) { faces(i) = i; });
+
+  ArborX::BoundingVolumeHierarchy<
+      MemorySpace, int,
+      ArborX::Experimental::TriangleMeshIndexableGetter<
+          decltype(vertices), decltype(vertex_indices)>,
+      Box>
+      tree(space, faces, {mesh});
+
+  BOOST_TEST(tree.size() == n);
+
+  // a thin box in the interior of the column spanned by faces 2i and 2i+1
+  // hits exactly those two faces
+  int const n_queries = n / 2;
+  using IntersectsBox = decltype(ArborX::intersects(Box{}));
+  Kokkos::View<IntersectsBox *, MemorySpace> queries(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::queries"),
+      n_queries);
+  Kokkos::parallel_for(
+      "Test::generate_queries",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int i) {
+        float const x = i + .5f;
+        queries(i) = ArborX::intersects(
+            Box{{{x - .1f, .4f, -.1f}}, {{x + .1f, .6f, .1f}}});
+      });
+
+  Kokkos::View<int *, MemorySpace> offset("Test::offset", 0);
+  Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+  tree.query(space, queries, indices, offset);
+
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  BOOST_TEST(offset_host.size() == n_queries + 1);
+  for (int i = 0; i < n_queries; ++i)
+  {
+    BOOST_TEST(offset_host(i + 1) - offset_host(i) == 2);
+    int const a = indices_host(offset_host(i));
+    int const b = indices_host(offset_host(i) + 1);
+    BOOST_TEST(std::min(a, b) == 2 * i);
+    BOOST_TEST(std::max(a, b) == 2 * i + 1);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -101,3 +101,37 @@ MAKE_TEST_NONE(Buhmann, 4)
 #undef MAKE_TEST_NONE
 #undef MAKE_TEST_POLY
 #undef MAKE_TEST
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(compact_radial_basis_function_tile, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space{};
+
+  // The batched tile fill must match the scalar evaluation with the radius
+  // the coefficient kernels use (1.1x the largest distance in the tile)
+  using Point = ArborX::ExperimentalHyperGeometry::Point<2, double>;
+  using CRBF = ArborX::Interpolation::CRBF::Wendland<2>;
+  static constexpr int n = 16;
+  Kokkos::View<Point *, MemorySpace> points("Testing::points", n);
+  Kokkos::View<double *, MemorySpace> phi("Testing::phi", n);
+  Kokkos::View<double *, MemorySpace> reference("Testing::reference", n);
+  Kokkos::parallel_for(
+      "Testing::eval_crbf_tile",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, 1), KOKKOS_LAMBDA(int) {
+        for (int i = 0; i < n; i++)
+          points(i) = {{Kokkos::cos(1. * i) * (i + 1) / n,
+                        Kokkos::sin(1. * i) * (i + 1) / n}};
+        double radius = 0;
+        for (int i = 0; i < n; i++)
+          radius =
+              Kokkos::max(radius, ArborX::Details::distance(points(i), Point{}));
+        radius *= 1.1;
+        for (int i = 0; i < n; i++)
+          reference(i) =
+              ArborX::Interpolation::CRBF::evaluate<CRBF>(points(i), radius);
+        ArborX::Interpolation::CRBF::evaluateTile<CRBF>(points, n, phi);
+      });
+  ARBORX_MDVIEW_TEST_TOL(phi, reference, 1e-14);
+}
@@ -0,0 +1,64 @@
+/****************************************************************************
+ * Copyright (c) 2023 by the ArborX authors                                 *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp"
+#include "ArborX_EnableViewComparison.hpp"
+#include <ArborX_InterpDistributedMovingLeastSquares.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#define BOOST_TEST_MODULE InterpDistributedMovingLeastSquares
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <mpi.h>
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(distributed_moving_least_squares, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space{};
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int comm_rank;
+  MPI_Comm_rank(comm, &comm_rank);
+
+  // f(x) = 3, 2 neighbors, linear. Sources sit on a line split in contiguous
+  // blocks of 4 per rank and targets sit between them, so the last target of
+  // every rank (but the last) has its second neighbor on the next rank.
+  // SRC (rank r):   8r  8r+2  8r+4  8r+6
+  // TGT (rank r):     8r+1  8r+3  8r+5  8r+7
+  int const n = 4;
+  Kokkos::View<ArborX::Point *, MemorySpace> srcp("Testing::srcp", n);
+  Kokkos::View<ArborX::Point *, MemorySpace> tgtp("Testing::tgtp", n);
+  Kokkos::View<double *, MemorySpace> srcv("Testing::srcv", n);
+  Kokkos::View<double *, MemorySpace> tgtv("Testing::tgtv", n);
+  Kokkos::View<double *, MemorySpace> eval("Testing::eval", n);
+  Kokkos::parallel_for(
+      "Testing::distributed_moving_least_squares::for0",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int const i) {
+        auto f = [](const ArborX::Point &) { return 3.; };
+
+        srcp(i) = {{8.f * comm_rank + 2 * i, 0.f, 0.f}};
+        srcv(i) = f(srcp(i));
+        tgtp(i) = {{8.f * comm_rank + 2 * i + 1, 0.f, 0.f}};
+        tgtv(i) = f(tgtp(i));
+      });
+
+  ArborX::Interpolation::DistributedMovingLeastSquares<MemorySpace, double> mls(
+      comm, space, srcp, tgtp, ArborX::Interpolation::CRBF::Wendland<0>{},
+      ArborX::Interpolation::PolynomialDegree<1>{}, 2);
+  mls.interpolate(space, srcv, eval);
+  ARBORX_MDVIEW_TEST_TOL(eval, tgtv, Kokkos::Experimental::epsilon_v<float>);
+}
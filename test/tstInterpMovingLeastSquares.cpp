@@ -96,6 +96,186 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(moving_least_squares, DeviceType,
   ARBORX_MDVIEW_TEST_TOL(eval1, tgtv1, Kokkos::Experimental::epsilon_v<float>);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(moving_least_squares_rebind, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space{};
+
+  // Same layout as case 2 of moving_least_squares; the interpolator built
+  // from the extracted coefficients and indices must reproduce the original
+  // one exactly
+  using Point = ArborX::ExperimentalHyperGeometry::Point<2, double>;
+  Kokkos::View<Point *, MemorySpace> srcp("Testing::srcp", 9);
+  Kokkos::View<Point *, MemorySpace> tgtp("Testing::tgtp", 4);
+  Kokkos::View<double *, MemorySpace> srcv("Testing::srcv", 9);
+  Kokkos::View<double *, MemorySpace> eval("Testing::eval", 4);
+  Kokkos::View<double *, MemorySpace> eval_rebound("Testing::eval_rebound", 4);
+  Kokkos::parallel_for(
+      "Testing::moving_least_squares_rebind::for0",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, 9),
+      KOKKOS_LAMBDA(int const i) {
+        int u = (i / 2) * 2 - 1;
+        int v = (i % 2) * 2 - 1;
+        int x = (i / 3) - 1;
+        int y = (i % 3) - 1;
+        auto f = [](const Point &p) { return p[0] * p[1] + 4 * p[0]; };
+
+        srcp(i) = {{x * 2., y * 2.}};
+        srcv(i) = f(srcp(i));
+        if (i < 4)
+          tgtp(i) = {{u * 1., v * 1.}};
+      });
+  ArborX::Interpolation::MovingLeastSquares<MemorySpace, double> mls(
+      space, srcp, tgtp, ArborX::Interpolation::CRBF::Wendland<2>{},
+      ArborX::Interpolation::PolynomialDegree<2>{}, 8);
+  mls.interpolate(space, srcv, eval);
+
+  // A real application would persist the two views between the steps
+  ArborX::Interpolation::MovingLeastSquares<MemorySpace, double> mls_rebound(
+      mls.coefficients(), mls.indices(), mls.sourceSize());
+  mls_rebound.interpolate(space, srcv, eval_rebound);
+  ARBORX_MDVIEW_TEST(eval_rebound, eval);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(moving_least_squares_mixed_precision, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space{};
+
+  // Same layout as case 2 of moving_least_squares, but the coefficients are
+  // stored in float while still being computed in double. A degree-2 basis
+  // reproduces f exactly, so the only error left is the float rounding of
+  // the coefficients themselves.
+  using Point = ArborX::ExperimentalHyperGeometry::Point<2, double>;
+  Kokkos::View<Point *, MemorySpace> srcp("Testing::srcp", 9);
+  Kokkos::View<Point *, MemorySpace> tgtp("Testing::tgtp", 4);
+  Kokkos::View<double *, MemorySpace> srcv("Testing::srcv", 9);
+  Kokkos::View<double *, MemorySpace> tgtv("Testing::tgtv", 4);
+  Kokkos::View<double *, MemorySpace> eval("Testing::eval", 4);
+  Kokkos::parallel_for(
+      "Testing::moving_least_squares_mixed_precision::for0",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, 9),
+      KOKKOS_LAMBDA(int const i) {
+        int u = (i / 2) * 2 - 1;
+        int v = (i % 2) * 2 - 1;
+        int x = (i / 3) - 1;
+        int y = (i % 3) - 1;
+        auto f = [](const Point &p) { return p[0] * p[1] + 4 * p[0]; };
+
+        srcp(i) = {{x * 2., y * 2.}};
+        srcv(i) = f(srcp(i));
+        if (i < 4)
+        {
+          tgtp(i) = {{u * 1., v * 1.}};
+          tgtv(i) = f(tgtp(i));
+        }
+      });
+  ArborX::Interpolation::MovingLeastSquares<MemorySpace, double, float> mls(
+      space, srcp, tgtp, ArborX::Interpolation::CRBF::Wendland<2>{},
+      ArborX::Interpolation::PolynomialDegree<2>{}, 8);
+  static_assert(std::is_same_v<typename std::decay_t<
+                                   decltype(mls.coefficients())>::value_type,
+                               float>);
+  mls.interpolate(space, srcv, eval);
+  ARBORX_MDVIEW_TEST_TOL(eval, tgtv,
+                         10 * Kokkos::Experimental::epsilon_v<float>);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(moving_least_squares_multi_field, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space{};
+
+  // Several fields transferred through the same operator in one pass must
+  // match the per-field applications exactly. Use more fields than the
+  // internal register tile to exercise the remainder handling.
+  int constexpr num_fields = 11;
+  using Point = ArborX::ExperimentalHyperGeometry::Point<2, double>;
+  Kokkos::View<Point *, MemorySpace> srcp("Testing::srcp", 9);
+  Kokkos::View<Point *, MemorySpace> tgtp("Testing::tgtp", 4);
+  Kokkos::View<double **, MemorySpace> srcv("Testing::srcv", 9, num_fields);
+  Kokkos::View<double **, MemorySpace> eval("Testing::eval", 4, num_fields);
+  Kokkos::View<double *, MemorySpace> srcv_field("Testing::srcv_field", 9);
+  Kokkos::View<double *, MemorySpace> eval_field("Testing::eval_field", 4);
+  Kokkos::parallel_for(
+      "Testing::moving_least_squares_multi_field::for0",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, 9),
+      KOKKOS_LAMBDA(int const i) {
+        int u = (i / 2) * 2 - 1;
+        int v = (i % 2) * 2 - 1;
+        int x = (i / 3) - 1;
+        int y = (i % 3) - 1;
+
+        srcp(i) = {{x * 2., y * 2.}};
+        for (int f = 0; f < num_fields; f++)
+          srcv(i, f) = srcp(i)[0] * srcp(i)[1] + f * srcp(i)[0];
+        if (i < 4)
+          tgtp(i) = {{u * 1., v * 1.}};
+      });
+  ArborX::Interpolation::MovingLeastSquares<MemorySpace, double> mls(
+      space, srcp, tgtp, ArborX::Interpolation::CRBF::Wendland<2>{},
+      ArborX::Interpolation::PolynomialDegree<2>{}, 8);
+  mls.interpolate(space, srcv, eval);
+
+  for (int f = 0; f < num_fields; f++)
+  {
+    Kokkos::deep_copy(space, srcv_field,
+                      Kokkos::subview(srcv, Kokkos::ALL, f));
+    mls.interpolate(space, srcv_field, eval_field);
+    auto eval_column = Kokkos::subview(eval, Kokkos::ALL, f);
+    ARBORX_MDVIEW_TEST(eval_column, eval_field);
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(moving_least_squares_adaptive, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space{};
+
+  // A duplicated source point makes the minimal stencil (3 points for a
+  // degree-2 basis in 1D) rank-deficient for the leftmost target, so its
+  // stencil has to grow, while the other targets keep the minimal one. A
+  // degree-2 basis over enough distinct points reproduces f exactly either
+  // way.
+  //      -------0--------------->
+  // SRC:        0,0 2   4   6
+  // TGT:          1   3   5
+  using Point = ArborX::ExperimentalHyperGeometry::Point<1, double>;
+  Kokkos::View<Point *, MemorySpace> srcp("Testing::srcp", 5);
+  Kokkos::View<Point *, MemorySpace> tgtp("Testing::tgtp", 3);
+  Kokkos::View<double *, MemorySpace> srcv("Testing::srcv", 5);
+  Kokkos::View<double *, MemorySpace> tgtv("Testing::tgtv", 3);
+  Kokkos::View<double *, MemorySpace> eval("Testing::eval", 3);
+  Kokkos::parallel_for(
+      "Testing::moving_least_squares_adaptive::for0",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, 5),
+      KOKKOS_LAMBDA(int const i) {
+        auto f = [](const Point &p) { return p[0] * p[0] - 3 * p[0] + 7; };
+
+        srcp(i) = {{2. * Kokkos::max(i - 1, 0)}};
+        srcv(i) = f(srcp(i));
+        if (i < 3)
+        {
+          tgtp(i) = {{2. * i + 1}};
+          tgtv(i) = f(tgtp(i));
+        }
+      });
+  ArborX::Interpolation::MovingLeastSquares<MemorySpace, double> mls(
+      space, srcp, tgtp, ArborX::Interpolation::AdaptiveStencil{5},
+      ArborX::Interpolation::CRBF::Wendland<2>{},
+      ArborX::Interpolation::PolynomialDegree<2>{});
+  mls.interpolate(space, srcv, eval);
+  ARBORX_MDVIEW_TEST_TOL(eval, tgtv, Kokkos::Experimental::epsilon_v<float>);
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(moving_least_squares_edge_cases, DeviceType,
                               ARBORX_DEVICE_TYPES)
 {
@@ -0,0 +1,111 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborXTest_StdVectorToKokkosView.hpp"
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_KNNGraph.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib> // abs
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(KNNGraph)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(build_knn_graph, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  // Points on a line with unit spacing: the two nearest neighbors of an
+  // interior point are its direct neighbors, in ascending distance order
+  // only up to the tie between them, so check as a set of expectations
+  int const n = 8;
+  std::vector<ArborX::Point> points_v;
+  points_v.reserve(n);
+  for (int i = 0; i < n; ++i)
+    points_v.push_back({(float)i, 0.f, 0.f});
+  auto points =
+      ArborXTest::toView<ExecutionSpace>(points_v, "Test::points");
+
+  Kokkos::View<int **, MemorySpace> indices("Test::indices", 0, 0);
+  Kokkos::View<float **, MemorySpace> distances("Test::distances", 0, 0);
+  ArborX::Experimental::buildKNNGraph(exec_space, points, 2, indices,
+                                      distances);
+
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  auto distances_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, distances);
+
+  BOOST_TEST(indices_host.extent_int(0) == n);
+  BOOST_TEST(indices_host.extent_int(1) == 2);
+
+  for (int i = 0; i < n; ++i)
+  {
+    // Rows are sorted by distance
+    BOOST_TEST(distances_host(i, 0) <= distances_host(i, 1));
+    for (int slot = 0; slot < 2; ++slot)
+    {
+      int const j = indices_host(i, slot);
+      BOOST_TEST(j != i);
+      BOOST_TEST(j >= 0);
+      BOOST_TEST(j < n);
+      BOOST_TEST(std::abs(i - j) <= 2);
+      BOOST_TEST(distances_host(i, slot) == (float)std::abs(i - j));
+    }
+    // Direct neighbors are always among the two nearest
+    if (i > 0 && i < n - 1)
+    {
+      bool const found_left = (indices_host(i, 0) == i - 1 ||
+                               indices_host(i, 1) == i - 1);
+      bool const found_right = (indices_host(i, 0) == i + 1 ||
+                                indices_host(i, 1) == i + 1);
+      BOOST_TEST(found_left);
+      BOOST_TEST(found_right);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(build_knn_graph_mutual, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  // With k = 1: 0 and 1 pick each other, 2 picks 1, but the nearest
+  // neighbor of 1 is 0 -- the edge 2 -> 1 is not mutual
+  auto points = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Point>{
+          {0.f, 0.f, 0.f},
+          {1.f, 0.f, 0.f},
+          {2.5f, 0.f, 0.f},
+      },
+      "Test::points");
+
+  Kokkos::View<int **, MemorySpace> indices("Test::indices", 0, 0);
+  Kokkos::View<float **, MemorySpace> distances("Test::distances", 0, 0);
+  ArborX::Experimental::buildKNNGraph(
+      exec_space, points, 1, indices, distances,
+      ArborX::Experimental::KNNGraphSymmetry::Mutual);
+
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+
+  BOOST_TEST(indices_host(0, 0) == 1);
+  BOOST_TEST(indices_host(1, 0) == 0);
+  BOOST_TEST(indices_host(2, 0) == -1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
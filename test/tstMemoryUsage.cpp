@@ -0,0 +1,98 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include "ArborX_EnableViewComparison.hpp"
+#include <ArborX_Exception.hpp>
+#include <ArborX_HyperPoint.hpp>
+#include <ArborX_LinearBVH.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(MemoryUsage)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(memory_usage_and_compact, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space;
+
+  using Point = ArborX::ExperimentalHyperGeometry::Point<3>;
+
+  int const n = 100;
+  Kokkos::View<Point *, MemorySpace> points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::points"),
+      n);
+  Kokkos::parallel_for(
+      "Test::generate_points", Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        points(i) = {(float)(i % 10), (float)(i / 10), (float)(i % 7)};
+      });
+
+  using Tree = ArborX::BoundingVolumeHierarchy<MemorySpace,
+                                               ArborX::PairValueIndex<Point>>;
+  Tree tree(space, ArborX::Experimental::attach_indices(points));
+
+  auto const usage = tree.memoryUsage();
+  BOOST_TEST(usage.leaf_nodes > 0u);
+  BOOST_TEST(usage.internal_nodes > 0u);
+  BOOST_TEST(usage.permutation == n * sizeof(unsigned int));
+  // Parent links only appear after the first update()
+  BOOST_TEST(usage.parents == 0u);
+  BOOST_TEST(usage.total() == usage.leaf_nodes + usage.internal_nodes +
+                                  usage.permutation + usage.parents);
+
+  tree.update(space, ArborX::Experimental::attach_indices(points));
+  BOOST_TEST(tree.memoryUsage().parents == (2 * n - 1) * sizeof(int));
+
+  using IntersectsSphere = decltype(ArborX::intersects(ArborX::Sphere{}));
+  Kokkos::View<IntersectsSphere *, MemorySpace> queries(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::queries"),
+      1);
+  Kokkos::parallel_for(
+      "Test::generate_queries", Kokkos::RangePolicy<ExecutionSpace>(space, 0, 1),
+      KOKKOS_LAMBDA(int i) {
+        queries(i) = ArborX::intersects(
+            ArborX::Sphere{{{(float)i, (float)i, (float)i}}, 1.5f});
+      });
+
+  Kokkos::View<int *, MemorySpace> offset("Test::offset", 0);
+  Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+  tree.query(space, queries, ArborX::Details::LegacyDefaultCallback{},
+             indices, offset);
+
+  // Compacting releases the parent links but keeps queries and update() valid
+  tree.compact();
+  BOOST_TEST(tree.memoryUsage().parents == 0u);
+  BOOST_CHECK_NO_THROW(
+      tree.update(space, ArborX::Experimental::attach_indices(points)));
+
+  // Giving up update() support also releases the permutation
+  tree.compact(/*keep_update_support*/ false);
+  BOOST_TEST(tree.memoryUsage().permutation == 0u);
+  BOOST_CHECK_THROW(
+      tree.update(space, ArborX::Experimental::attach_indices(points)),
+      ArborX::SearchException);
+
+  Kokkos::View<int *, MemorySpace> offset_compacted("Test::offset_compacted",
+                                                    0);
+  Kokkos::View<int *, MemorySpace> indices_compacted("Test::indices_compacted",
+                                                     0);
+  tree.query(space, queries, ArborX::Details::LegacyDefaultCallback{},
+             indices_compacted, offset_compacted);
+
+  ARBORX_MDVIEW_TEST(offset_compacted, offset);
+  ARBORX_MDVIEW_TEST(indices_compacted, indices);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -54,12 +54,16 @@ using ArborXTest::toView;
 template <class ExecutionSpace>
 auto build_minimum_spanning_tree(ExecutionSpace const &exec_space,
                                  std::vector<ArborX::Point> const &points_host,
-                                 int k)
+                                 int k,
+                                 ArborX::Details::MSTAlgorithm algorithm =
+                                     ArborX::Details::MSTAlgorithm::Boruvka,
+                                 int num_candidates = -1)
 {
   auto points = toView<ExecutionSpace>(points_host, "Test::points");
 
   using MemorySpace = typename ExecutionSpace::memory_space;
-  ArborX::Details::MinimumSpanningTree<MemorySpace> mst{exec_space, points, k};
+  ArborX::Details::MinimumSpanningTree<MemorySpace> mst{
+      exec_space, points, k, algorithm, num_candidates};
 
   auto edges_host =
       Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, mst.edges);
@@ -79,6 +83,12 @@ std::vector<T> sorted(std::vector<T> v)
                  Test::sorted(ref),                                            \
              boost::test_tools::per_element());
 
+#define ARBORX_TEST_MINIMUM_SPANNING_TREE_ALGORITHM(exec_space, points, k,     \
+                                                    algorithm, ref)            \
+  BOOST_TEST(Test::build_minimum_spanning_tree(exec_space, points, k,          \
+                                               algorithm) == Test::sorted(ref),\
+             boost::test_tools::per_element());
+
 } // namespace Test
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(minimum_spanning_tree, DeviceType,
@@ -157,3 +167,58 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(minimum_spanning_tree, DeviceType,
             {0, 1, 10}, {1, 2, 9}, {2, 3, 8}, {3, 4, 7}, {0, 5, 10}}));
   }
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(minimum_spanning_tree_edge_contraction,
+                              DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  // The point sets are small enough for the candidate graph to be complete,
+  // so the contraction engine must reproduce the exact tree. Only parameters
+  // for which the tree is unique are checked, as the two engines break ties
+  // between equal-weight edges differently.
+  auto const algorithm = ArborX::Details::MSTAlgorithm::EdgeContraction;
+
+  {
+    std::vector<ArborX::Point> points{
+        {0, 0, 0}, {1, 0, 0}, {2, 0, 0}, {3, 0, 0}, {4, 0, 0},
+    };
+
+    ARBORX_TEST_MINIMUM_SPANNING_TREE_ALGORITHM(
+        exec_space, points, 1, algorithm,
+        (std::vector<ArborX::Details::WeightedEdge>{
+            {0, 1, 1}, {1, 2, 1}, {2, 3, 1}, {3, 4, 1}}));
+
+    ARBORX_TEST_MINIMUM_SPANNING_TREE_ALGORITHM(
+        exec_space, points, 2, algorithm,
+        (std::vector<ArborX::Details::WeightedEdge>{
+            {0, 1, 1}, {1, 2, 1}, {2, 3, 1}, {3, 4, 1}}));
+  }
+  {
+    std::vector<ArborX::Point> non_equidistant_points{
+        {0, 0, 0}, {1, 0, 0}, {2, 0, 0}, {3, 0, 0}, {6, 0, 0}, {10, 0, 0},
+    };
+
+    ARBORX_TEST_MINIMUM_SPANNING_TREE_ALGORITHM(
+        exec_space, non_equidistant_points, 1, algorithm,
+        (std::vector<ArborX::Details::WeightedEdge>{
+            {0, 1, 1}, {1, 2, 1}, {2, 3, 1}, {3, 4, 3}, {4, 5, 4}}));
+
+    ARBORX_TEST_MINIMUM_SPANNING_TREE_ALGORITHM(
+        exec_space, non_equidistant_points, 2, algorithm,
+        (std::vector<ArborX::Details::WeightedEdge>{
+            {0, 1, 1}, {1, 2, 1}, {2, 3, 1}, {3, 4, 3}, {4, 5, 4}}));
+
+    // A budget of a single candidate neighbor per point forces the
+    // completion rounds to do part of the work; nearest-neighbor edges
+    // always belong to the tree, so the result must still be exact
+    BOOST_TEST(
+        Test::build_minimum_spanning_tree(exec_space, non_equidistant_points,
+                                          1, algorithm,
+                                          /*num_candidates=*/1) ==
+            Test::sorted(std::vector<ArborX::Details::WeightedEdge>{
+                {0, 1, 1}, {1, 2, 1}, {2, 3, 1}, {3, 4, 3}, {4, 5, 4}}),
+        boost::test_tools::per_element());
+  }
+}
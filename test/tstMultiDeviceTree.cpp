@@ -0,0 +1,86 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborXTest_Cloud.hpp"
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_MultiDeviceTree.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(MultiDeviceTree)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(multi_device_tree_vs_bvh, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  // The sharding and merge logic does not depend on the shards living on
+  // different physical devices, so exercise it with several instances of
+  // the same device and compare against a single tree
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  int const n = 256;
+  auto points = ArborXTest::make_random_cloud<ArborX::Point>(exec_space, n);
+
+  float const radius = 0.2f;
+
+  Kokkos::View<decltype(ArborX::intersects(ArborX::Sphere{})) *, MemorySpace>
+      predicates(Kokkos::view_alloc(exec_space, Kokkos::WithoutInitializing,
+                                    "Test::predicates"),
+                 n);
+  Kokkos::parallel_for(
+      "Test::make_predicates",
+      Kokkos::RangePolicy<ExecutionSpace>(exec_space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        predicates(i) = ArborX::intersects(ArborX::Sphere{points(i), radius});
+      });
+
+  ArborX::BVH<MemorySpace> bvh(exec_space, points);
+  ArborX::Experimental::MultiDeviceTree<MemorySpace> multi_tree(
+      std::vector<ExecutionSpace>(3, exec_space), points);
+
+  BOOST_TEST(multi_tree.size() == (unsigned)n);
+
+  Kokkos::View<int *, MemorySpace> bvh_indices("Test::bvh_indices", 0);
+  Kokkos::View<int *, MemorySpace> bvh_offset("Test::bvh_offset", 0);
+  ArborX::query(bvh, exec_space, predicates, bvh_indices, bvh_offset);
+
+  Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+  Kokkos::View<int *, MemorySpace> offset("Test::offset", 0);
+  multi_tree.query(predicates, indices, offset);
+
+  auto bvh_indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, bvh_indices);
+  auto bvh_offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, bvh_offset);
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+
+  BOOST_TEST(offset_host.size() == bvh_offset_host.size());
+  for (int i = 0; i < n; ++i)
+  {
+    BOOST_TEST(offset_host(i) == bvh_offset_host(i));
+    std::set<int> expected(bvh_indices_host.data() + bvh_offset_host(i),
+                           bvh_indices_host.data() + bvh_offset_host(i + 1));
+    std::set<int> actual(indices_host.data() + offset_host(i),
+                         indices_host.data() + offset_host(i + 1));
+    BOOST_TEST((actual == expected));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,136 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_NearestQueryCache.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(NearestQueryCache)
+
+namespace
+{
+// Sort every row so that the comparison is insensitive to the order the
+// neighbors are reported in (cache hits replay the cached order)
+template <typename Indices, typename Offset>
+std::vector<int> sorted_rows(Indices const &indices, Offset const &offset)
+{
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+  std::vector<int> result(indices_host.data(),
+                          indices_host.data() + indices_host.size());
+  for (size_t q = 0; q + 1 < offset_host.size(); ++q)
+    std::sort(result.data() + offset_host(q), result.data() + offset_host(q + 1));
+  return result;
+}
+
+// The fractional offsets keep the queries away from distance ties between
+// grid points, which a k-th vs (k+1)-th traversal may break differently
+template <typename ExecutionSpace, typename Queries>
+void place_queries(ExecutionSpace const &space, Queries const &queries,
+                   float dx)
+{
+  int const n = queries.extent_int(0);
+  Kokkos::parallel_for(
+      "Test::place_queries", Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        queries(i) = ArborX::nearest(
+            ArborX::Point{(float)(i % 8) * 2 + .13f + dx,
+                          (float)(i / 8) * 3 + .29f, .37f},
+            4);
+      });
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(nearest_query_cache, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space;
+
+  using ArborX::Point;
+
+  int const n_points = 256;
+  Kokkos::View<Point *, MemorySpace> points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::points"),
+      n_points);
+  Kokkos::parallel_for(
+      "Test::generate_points",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_points),
+      KOKKOS_LAMBDA(int i) {
+        points(i) = {(float)(i % 16), (float)(i / 16), 0.f};
+      });
+
+  ArborX::BVH<MemorySpace> tree(space, points);
+
+  int const n_queries = 24;
+  using Query = decltype(ArborX::nearest(Point{}, 0));
+  Kokkos::View<Query *, MemorySpace> queries(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::queries"),
+      n_queries);
+  place_queries(space, queries, 0.f);
+
+  ArborX::Experimental::NearestQueryCache<MemorySpace> cache;
+
+  Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+  Kokkos::View<int *, MemorySpace> offset("Test::offset", 0);
+  Kokkos::View<int *, MemorySpace> ref_indices("Test::ref_indices", 0);
+  Kokkos::View<int *, MemorySpace> ref_offset("Test::ref_offset", 0);
+
+  auto check_against_traversal = [&] {
+    tree.query(space, queries, ref_indices, ref_offset);
+    BOOST_TEST(sorted_rows(indices, offset) ==
+                   sorted_rows(ref_indices, ref_offset),
+               boost::test_tools::per_element());
+  };
+
+  // Cold call populates the cache and matches a plain traversal
+  cache.query(space, tree, queries, indices, offset);
+  check_against_traversal();
+
+  // Identical batch: served from the cache
+  cache.query(space, tree, queries, indices, offset);
+  check_against_traversal();
+
+  // Small drift within the grid spacing: hits are only served where the
+  // distance bound proves the neighbor set unchanged, so the result must
+  // still match a fresh traversal exactly
+  place_queries(space, queries, .01f);
+  cache.query(space, tree, queries, indices, offset);
+  check_against_traversal();
+
+  // Large jump: every slot misses and gets re-traversed
+  place_queries(space, queries, 5.f);
+  cache.query(space, tree, queries, indices, offset);
+  check_against_traversal();
+
+  // Rebuilding the tree with different values is detected through the
+  // fingerprint and drops the cached results
+  Kokkos::parallel_for(
+      "Test::shift_points",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_points),
+      KOKKOS_LAMBDA(int i) {
+        points(i) = {(float)(i % 16) + 20, (float)(i / 16), 0.f};
+      });
+  tree = ArborX::BVH<MemorySpace>(space, points);
+  cache.query(space, tree, queries, indices, offset);
+  check_against_traversal();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
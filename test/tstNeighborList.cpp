@@ -27,6 +27,10 @@
 #include "BoostTest_CUDA_clang_workarounds.hpp"
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <set>
+#include <utility>
+
 namespace Test
 {
 using ArborXTest::toView;
@@ -206,6 +210,58 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(find_neighbor_list, DeviceType,
       (std::vector<int>{1, 2, 3, 0, 2, 3, 0, 1, 3, 0, 1, 2}));
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(find_neighbor_list_periodic, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  // In a box of length 10 along x, the first and the last point are
+  // neighbors only through the boundary
+  auto points = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Point>{
+          {0.5f, 0.f, 0.f},
+          {1.5f, 0.f, 0.f},
+          {8.5f, 0.f, 0.f},
+          {9.5f, 0.f, 0.f},
+      },
+      "Test::wrapped_points");
+
+  ArborX::Experimental::PeriodicDomain<3> domain({10.f, 0.f, 0.f});
+  float const radius = 1.5f;
+
+  std::vector<int> offsets_ref{0, 2, 3, 4, 6};
+  std::vector<int> indices_ref{1, 3, 0, 3, 0, 2};
+
+  {
+    Kokkos::View<int *, ExecutionSpace> offsets("Test::offsets", 0);
+    Kokkos::View<int *, ExecutionSpace> indices("Test::indices", 0);
+    ArborX::Experimental::findFullNeighborList(exec_space, points, radius,
+                                               domain, offsets, indices);
+    BOOST_TEST(
+        make_compressed_storage(
+            Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets),
+            Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{},
+                                                indices)) ==
+            make_compressed_storage(offsets_ref, indices_ref),
+        boost::test_tools::per_element());
+  }
+  {
+    Kokkos::View<int *, ExecutionSpace> offsets("Test::offsets", 0);
+    Kokkos::View<int *, ExecutionSpace> indices("Test::indices", 0);
+    ArborX::Experimental::findHalfNeighborList(exec_space, points, radius,
+                                               domain, offsets, indices);
+    ArborX::Details::expandHalfToFull(exec_space, offsets, indices);
+    BOOST_TEST(
+        make_compressed_storage(
+            Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets),
+            Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{},
+                                                indices)) ==
+            make_compressed_storage(offsets_ref, indices_ref),
+        boost::test_tools::per_element());
+  }
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(
     find_neighbor_list_compare_filtered_tree_traversal, DeviceType,
     ARBORX_DEVICE_TYPES)
@@ -226,3 +282,397 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(
           Test::compute_reference<MemorySpace>(exec_space, points, radius),
       boost::test_tools::per_element());
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(verlet_list, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  // Collinear points spaced 2 apart; with radius 2 and skin 1, the list is
+  // built at cutoff 3 and contains the adjacent pairs only
+  float const radius = 2.f;
+  float const skin = 1.f;
+  auto points = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Point>{
+          {0.f, 0.f, 0.f},
+          {2.f, 0.f, 0.f},
+          {4.f, 0.f, 0.f},
+          {6.f, 0.f, 0.f},
+      },
+      "Test::points");
+
+  ArborX::Experimental::VerletList<MemorySpace> verlet_list(exec_space, points,
+                                                            radius, skin);
+
+  auto list_storage = [](auto const &list) {
+    return make_compressed_storage(
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, list.offsets),
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, list.indices));
+  };
+
+  std::vector<int> offsets_ref{0, 1, 3, 5, 6};
+  std::vector<int> indices_ref{1, 0, 2, 1, 3, 2};
+  BOOST_TEST(list_storage(verlet_list) ==
+                 make_compressed_storage(offsets_ref, indices_ref),
+             boost::test_tools::per_element());
+
+  BOOST_TEST(!verlet_list.needsRebuild(exec_space, points));
+
+  // Moving a point by less than half the skin keeps the list valid
+  auto points_small_move = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Point>{
+          {0.4f, 0.f, 0.f},
+          {2.f, 0.f, 0.f},
+          {4.f, 0.f, 0.f},
+          {6.f, 0.f, 0.f},
+      },
+      "Test::points_small_move");
+  BOOST_TEST(!verlet_list.update(exec_space, points_small_move));
+
+  // Moving it past half the skin invalidates the list and update() rebuilds
+  // at the new positions
+  auto points_large_move = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Point>{
+          {0.6f, 0.f, 0.f},
+          {2.f, 0.f, 0.f},
+          {4.f, 0.f, 0.f},
+          {6.f, 0.f, 0.f},
+      },
+      "Test::points_large_move");
+  BOOST_TEST(verlet_list.update(exec_space, points_large_move));
+  BOOST_TEST(!verlet_list.needsRebuild(exec_space, points_large_move));
+  BOOST_TEST(list_storage(verlet_list) ==
+                 make_compressed_storage(offsets_ref, indices_ref),
+             boost::test_tools::per_element());
+
+  // A different number of points always triggers a rebuild
+  auto fewer_points = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Point>{
+          {0.f, 0.f, 0.f},
+          {2.f, 0.f, 0.f},
+      },
+      "Test::fewer_points");
+  BOOST_TEST(verlet_list.needsRebuild(exec_space, fewer_points));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(verlet_list_delta_update, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  // Same setup as in the verlet_list case: collinear points spaced 2 apart,
+  // list built at cutoff 3
+  float const radius = 2.f;
+  float const skin = 1.f;
+  auto points = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Point>{
+          {0.f, 0.f, 0.f},
+          {2.f, 0.f, 0.f},
+          {4.f, 0.f, 0.f},
+          {6.f, 0.f, 0.f},
+      },
+      "Test::points");
+
+  ArborX::Experimental::VerletList<MemorySpace> verlet_list(exec_space, points,
+                                                            radius, skin);
+
+  auto list_storage = [](auto const &list) {
+    return make_compressed_storage(
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, list.offsets),
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, list.indices));
+  };
+
+  // Only the last point moves (well beyond half the skin); its row is
+  // re-queried at cutoff 3 over the current positions and mirrored into the
+  // rows of its new unmoved partners, while the untouched rows are copied
+  auto moved_points = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Point>{
+          {0.f, 0.f, 0.f},
+          {2.f, 0.f, 0.f},
+          {4.f, 0.f, 0.f},
+          {3.2f, 0.f, 0.f},
+      },
+      "Test::moved_points");
+  BOOST_TEST(verlet_list.deltaUpdate(exec_space, moved_points) == 1);
+
+  std::vector<int> offsets_ref{0, 1, 4, 6, 8};
+  std::vector<int> indices_ref{1, 0, 2, 3, 1, 3, 1, 2};
+  BOOST_TEST(list_storage(verlet_list) ==
+                 make_compressed_storage(offsets_ref, indices_ref),
+             boost::test_tools::per_element());
+
+  // The reference of the moved point was advanced, so the patched list is
+  // valid and a second delta update is a no-op
+  BOOST_TEST(!verlet_list.needsRebuild(exec_space, moved_points));
+  BOOST_TEST(verlet_list.deltaUpdate(exec_space, moved_points) == 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(neighbor_list_pair_batches, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  auto points = ArborXTest::make_random_cloud<ArborX::Point>(exec_space, 100);
+  auto radius = .3f;
+
+  Kokkos::View<int *, MemorySpace> offsets("Test::offsets", 0);
+  Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+  ArborX::Experimental::findHalfNeighborList(exec_space, points, radius,
+                                             offsets, indices);
+
+  Kokkos::View<int *, MemorySpace> batch_offsets("Test::batch_offsets", 0);
+  Kokkos::View<int *[2], MemorySpace> batch_pairs("Test::batch_pairs", 0);
+  ArborX::Experimental::computeNeighborListPairBatches(
+      exec_space, offsets, indices, batch_offsets, batch_pairs);
+
+  auto offsets_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets);
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  auto batch_offsets_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, batch_offsets);
+  auto batch_pairs_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, batch_pairs);
+
+  int const n = offsets_host.size() - 1;
+  int const num_pairs = indices_host.size();
+  int const num_batches = batch_offsets_host.size() - 1;
+
+  // The batches partition the pairs
+  BOOST_TEST(batch_offsets_host(0) == 0);
+  BOOST_TEST(batch_offsets_host(num_batches) == num_pairs);
+  BOOST_TEST((int)batch_pairs_host.extent(0) == num_pairs);
+
+  // No two pairs within a batch share a particle
+  std::vector<int> last_batch(n, -1);
+  for (int b = 0; b < num_batches; ++b)
+    for (int k = batch_offsets_host(b); k < batch_offsets_host(b + 1); ++k)
+      for (int c : {0, 1})
+      {
+        int const p = batch_pairs_host(k, c);
+        BOOST_TEST(last_batch[p] < b);
+        last_batch[p] = b;
+      }
+
+  // The pairs are exactly the ones of the half list
+  auto normalize = [](int i, int j) {
+    return std::make_pair(std::min(i, j), std::max(i, j));
+  };
+  std::set<std::pair<int, int>> list_pairs;
+  for (int i = 0; i < n; ++i)
+    for (int k = offsets_host(i); k < offsets_host(i + 1); ++k)
+      list_pairs.insert(normalize(i, indices_host(k)));
+  std::set<std::pair<int, int>> batched_pairs;
+  for (int k = 0; k < num_pairs; ++k)
+    batched_pairs.insert(normalize(batch_pairs_host(k, 0),
+                                   batch_pairs_host(k, 1)));
+  BOOST_TEST((int)list_pairs.size() == num_pairs);
+  BOOST_TEST((batched_pairs == list_pairs));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(find_neighbor_list_cell_list, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  // A uniform cloud in the unit cube with a radius this large drives the
+  // average cell occupancy above one, so the automatic dispatch takes the
+  // cell-list engine; compare it against the filtered tree traversal
+  auto points = ArborXTest::make_random_cloud<ArborX::Point>(exec_space, 1000);
+  auto radius = .25f;
+
+  BOOST_TEST(
+      Test::buildFullNeighborList(exec_space, points, radius) ==
+          Test::compute_reference<MemorySpace>(exec_space, points, radius),
+      boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(find_dense_neighbor_list, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  auto points = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Point>{
+          {0.f, 0.f, 0.f},
+          {1.f, 1.f, 1.f},
+          {2.f, 2.f, 2.f},
+          {3.f, 3.f, 3.f},
+      },
+      "Test::four_points");
+
+  Kokkos::View<int **, MemorySpace> neighbors("Test::neighbors", 4, 2);
+  Kokkos::View<int *, MemorySpace> counts("Test::counts", 4);
+
+  // Only the consecutive points are within the radius
+  BOOST_TEST(ArborX::Experimental::findDenseNeighborList(exec_space, points,
+                                                         2.f, neighbors,
+                                                         counts));
+
+  auto neighbors_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, neighbors);
+  auto counts_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, counts);
+
+  BOOST_TEST(counts_host(0) == 1);
+  BOOST_TEST(counts_host(1) == 2);
+  BOOST_TEST(counts_host(2) == 2);
+  BOOST_TEST(counts_host(3) == 1);
+
+  std::vector<std::vector<int>> rows_ref{{1}, {0, 2}, {1, 3}, {2}};
+  for (int i = 0; i < 4; ++i)
+  {
+    std::vector<int> row(counts_host(i));
+    for (int k = 0; k < counts_host(i); ++k)
+      row[k] = neighbors_host(i, k);
+    std::sort(row.begin(), row.end());
+    BOOST_TEST(row == rows_ref[i], boost::test_tools::per_element());
+  }
+
+  // A capacity of one overflows on the middle points; the true degrees are
+  // still reported
+  Kokkos::View<int **, MemorySpace> tight_neighbors("Test::tight_neighbors", 4,
+                                                    1);
+  BOOST_TEST(!ArborX::Experimental::findDenseNeighborList(
+      exec_space, points, 2.f, tight_neighbors, counts));
+  Kokkos::deep_copy(counts_host, counts);
+  BOOST_TEST(counts_host(0) == 1);
+  BOOST_TEST(counts_host(1) == 2);
+  BOOST_TEST(counts_host(2) == 2);
+  BOOST_TEST(counts_host(3) == 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(for_each_pair, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  auto points = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Point>{
+          {0.f, 0.f, 0.f},
+          {1.f, 1.f, 1.f},
+          {2.f, 2.f, 2.f},
+          {3.f, 3.f, 3.f},
+      },
+      "Test::four_points");
+
+  // Accumulate the degrees during the traversal; every unordered pair must
+  // be seen exactly once
+  Kokkos::View<int *, MemorySpace> degrees("Test::degrees", 4);
+  ArborX::Experimental::forEachPair(
+      exec_space, points, 2.f, KOKKOS_LAMBDA(int i, int j) {
+        Kokkos::atomic_increment(&degrees(i));
+        Kokkos::atomic_increment(&degrees(j));
+      });
+
+  auto degrees_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, degrees);
+  BOOST_TEST(degrees_host(0) == 1);
+  BOOST_TEST(degrees_host(1) == 2);
+  BOOST_TEST(degrees_host(2) == 2);
+  BOOST_TEST(degrees_host(3) == 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(find_neighbor_list_sorted_by_distance,
+                              DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  // Points on a line with distinct pairwise gaps so the in-row order is
+  // fully determined
+  auto points = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Point>{
+          {0.f, 0.f, 0.f},
+          {1.f, 0.f, 0.f},
+          {3.f, 0.f, 0.f},
+          {7.f, 0.f, 0.f},
+      },
+      "Test::line_points");
+
+  auto build_sorted = [&exec_space, &points](float radius) {
+    Kokkos::View<int *, ExecutionSpace> offsets("Test::offsets", 0);
+    Kokkos::View<int *, ExecutionSpace> indices("Test::indices", 0);
+    ArborX::Experimental::findFullNeighborList(
+        exec_space, points, radius, offsets, indices,
+        ArborX::Experimental::NeighborListSorting::ByDistance);
+    return std::make_pair(
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets),
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices));
+  };
+
+  {
+    // Cell-list path (one point per cell on average)
+    auto [offsets, indices] = build_sorted(7.f);
+    BOOST_TEST(offsets == (std::vector<int>{0, 3, 6, 9, 12}),
+               boost::test_tools::per_element());
+    BOOST_TEST(indices ==
+                   (std::vector<int>{1, 2, 3, 0, 2, 3, 1, 0, 3, 2, 1, 0}),
+               boost::test_tools::per_element());
+  }
+  {
+    auto [offsets, indices] = build_sorted(4.f);
+    BOOST_TEST(offsets == (std::vector<int>{0, 2, 4, 7, 8}),
+               boost::test_tools::per_element());
+    BOOST_TEST(indices == (std::vector<int>{1, 2, 0, 2, 1, 0, 3, 2}),
+               boost::test_tools::per_element());
+  }
+  {
+    // BVH path (grid larger than the point set)
+    auto [offsets, indices] = build_sorted(1.f);
+    BOOST_TEST(offsets == (std::vector<int>{0, 1, 2, 2, 2}),
+               boost::test_tools::per_element());
+    BOOST_TEST(indices == (std::vector<int>{1, 0}),
+               boost::test_tools::per_element());
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(find_full_neighbor_lists_multi_radius,
+                              DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  auto points = ArborXTest::toView<ExecutionSpace>(
+      std::vector<ArborX::Point>{
+          {0.f, 0.f, 0.f},
+          {1.f, 0.f, 0.f},
+          {3.f, 0.f, 0.f},
+          {7.f, 0.f, 0.f},
+      },
+      "Test::line_points");
+
+  std::vector<Kokkos::View<int *, ExecutionSpace>> offsets;
+  std::vector<Kokkos::View<int *, ExecutionSpace>> indices;
+  ArborX::Experimental::findFullNeighborLists(
+      exec_space, points, std::vector<float>{1.5f, 4.f}, offsets, indices);
+
+  BOOST_TEST(offsets.size() == 2);
+  BOOST_TEST(indices.size() == 2);
+
+  auto storage = [](auto const &offsets_r, auto const &indices_r) {
+    return make_compressed_storage(
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offsets_r),
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices_r));
+  };
+
+  BOOST_TEST(storage(offsets[0], indices[0]) ==
+                 make_compressed_storage(std::vector<int>{0, 1, 2, 2, 2},
+                                         std::vector<int>{1, 0}),
+             boost::test_tools::per_element());
+  BOOST_TEST(storage(offsets[1], indices[1]) ==
+                 make_compressed_storage(
+                     std::vector<int>{0, 2, 4, 7, 8},
+                     std::vector<int>{1, 2, 0, 2, 0, 1, 3, 2}),
+             boost::test_tools::per_element());
+}
@@ -0,0 +1,80 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborXTest_StdVectorToKokkosView.hpp"
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_OPTICS.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+
+BOOST_AUTO_TEST_SUITE(OPTICS)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(optics_ordering, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using ArborXTest::toView;
+
+  ExecutionSpace exec_space;
+
+  // Points on a line with strictly growing gaps: the expansion sweeps left
+  // to right and the reachabilities are the gaps
+  std::vector<ArborX::Point> points{
+      {0, 0, 0}, {1, 0, 0}, {3, 0, 0}, {7, 0, 0}};
+  auto points_device = toView<ExecutionSpace>(points, "Test::points");
+
+  for (int core_min_size : {1, 2})
+  {
+    auto result = ArborX::Experimental::optics(exec_space, points_device,
+                                               core_min_size);
+
+    auto order = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{},
+                                                     result.order);
+    auto reachability = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace{}, result.reachability);
+
+    BOOST_TEST(order(0) == 0);
+    BOOST_TEST(order(1) == 1);
+    BOOST_TEST(order(2) == 2);
+    BOOST_TEST(order(3) == 3);
+
+    BOOST_TEST(std::isinf(reachability(0)));
+    BOOST_TEST(reachability(1) == 1.f);
+    BOOST_TEST(reachability(2) == 2.f);
+    BOOST_TEST(reachability(3) == 4.f);
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(optics_degenerate, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using ArborXTest::toView;
+
+  ExecutionSpace exec_space;
+
+  auto single_point = toView<ExecutionSpace>(
+      std::vector<ArborX::Point>{{0, 0, 0}}, "Test::single_point");
+  auto result =
+      ArborX::Experimental::optics(exec_space, single_point, 1);
+
+  auto order =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, result.order);
+  auto reachability = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{},
+                                                          result.reachability);
+  BOOST_TEST(order.size() == 1);
+  BOOST_TEST(order(0) == 0);
+  BOOST_TEST(std::isinf(reachability(0)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -9,6 +9,8 @@
  * SPDX-License-Identifier: BSD-3-Clause                                    *
  ****************************************************************************/
 
+#include <ArborX_AttachHandles.hpp>
+
 #include <boost/test/unit_test.hpp>
 
 #include <numeric>
@@ -255,6 +257,24 @@ struct CustomPostCallbackWithAttachment
   }
 };
 
+template <typename DeviceType>
+struct CustomInlineCallbackWithHandle
+{
+  Kokkos::View<ArborX::Point *, DeviceType> points;
+  Kokkos::View<float *, DeviceType> payloads;
+  ArborX::Point const origin = {{0., 0., 0.}};
+  template <typename Query, typename Insert>
+  KOKKOS_FUNCTION void operator()(Query const &query, int index,
+                                  Insert const &insert) const
+  {
+    float const distance_to_origin =
+        ArborX::Details::distance(points(index), origin);
+
+    // The payload stays out-of-line; the predicate only carries its index.
+    insert({index, payloads(ArborX::getData(query)) + distance_to_origin});
+  }
+};
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(callback_with_attachment_spatial_predicate,
                               TreeTypeTraits, TreeTypeTraitsList)
 {
@@ -292,6 +312,39 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(callback_with_attachment_spatial_predicate,
       make_compressed_storage(offsets, values));
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(callback_with_out_of_line_attachment,
+                              TreeTypeTraits, TreeTypeTraitsList)
+{
+  using Tree = typename TreeTypeTraits::type;
+  using ExecutionSpace = typename TreeTypeTraits::execution_space;
+  using DeviceType = typename TreeTypeTraits::device_type;
+
+  int const n = 10;
+  Kokkos::View<ArborX::Point *, DeviceType> points(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "points"), n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {{(double)i, (double)i, (double)i}};
+      });
+  float const delta = 5.f;
+
+  Kokkos::View<float *, DeviceType> payloads(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "payloads"), 1);
+  Kokkos::deep_copy(payloads, delta);
+
+  auto values = initialize_values(points, delta);
+  std::vector<int> offsets = {0, n};
+
+  Tree const tree(ExecutionSpace{}, points);
+
+  ARBORX_TEST_QUERY_TREE_CALLBACK(
+      ExecutionSpace{}, tree,
+      ArborX::Experimental::attach_handles(makeIntersectsBoxQueries<DeviceType>(
+          {static_cast<ArborX::Box>(tree.bounds())})),
+      (CustomInlineCallbackWithHandle<DeviceType>{points, payloads}),
+      make_compressed_storage(offsets, values));
+}
+
 #ifndef ARBORX_TEST_DISABLE_NEAREST_QUERY
 BOOST_AUTO_TEST_CASE_TEMPLATE(callback_with_attachment_nearest_predicate,
                               TreeTypeTraits, TreeTypeTraitsList)
@@ -0,0 +1,98 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(Concurrency)
+
+// Concurrent read-only queries against one shared tree are a documented
+// guarantee: the whole CRS query path keeps its intermediate state local to
+// the call, so several host threads may query simultaneously as long as each
+// uses its own execution space instance. Boost.Test assertions are not
+// thread-safe, hence the per-thread error tallies checked after the join.
+BOOST_AUTO_TEST_CASE_TEMPLATE(concurrent_queries_shared_tree, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  int const n = 1000;
+  Kokkos::View<ArborX::Point *, DeviceType> points(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Testing::points"), n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {{(float)i, (float)i, (float)i}};
+      });
+
+  ArborX::BVH<MemorySpace> const tree(ExecutionSpace{}, points);
+
+  // Disjoint boxes, so query i matches exactly point i
+  using Box = ArborX::Box;
+  Kokkos::View<decltype(ArborX::intersects(Box{})) *, DeviceType> predicates(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "Testing::predicates"),
+      n);
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<ExecutionSpace>(0, n), KOKKOS_LAMBDA(int i) {
+        float const c = i;
+        predicates(i) = ArborX::intersects(
+            Box{{c - .5f, c - .5f, c - .5f}, {c + .5f, c + .5f, c + .5f}});
+      });
+  ExecutionSpace{}.fence();
+
+  int const num_threads = 4;
+  int const num_repeats = 8;
+  auto instances =
+      Kokkos::Experimental::partition_space(ExecutionSpace{}, 1, 1, 1, 1);
+
+  std::vector<int> thread_errors(num_threads, 0);
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t)
+    threads.emplace_back([&, t] {
+      auto const &space = instances[t];
+      for (int repeat = 0; repeat < num_repeats; ++repeat)
+      {
+        Kokkos::View<int *, DeviceType> indices("Testing::indices", 0);
+        Kokkos::View<int *, DeviceType> offsets("Testing::offsets", 0);
+        tree.query(space, predicates, indices, offsets);
+
+        auto indices_host = Kokkos::create_mirror_view(indices);
+        auto offsets_host = Kokkos::create_mirror_view(offsets);
+        Kokkos::deep_copy(space, indices_host, indices);
+        Kokkos::deep_copy(space, offsets_host, offsets);
+        space.fence();
+
+        if ((int)offsets_host.extent(0) != n + 1)
+        {
+          ++thread_errors[t];
+          continue;
+        }
+        for (int i = 0; i < n; ++i)
+          if (offsets_host(i + 1) - offsets_host(i) != 1 ||
+              indices_host(offsets_host(i)) != i)
+            ++thread_errors[t];
+      }
+    });
+  for (auto &thread : threads)
+    thread.join();
+
+  for (int t = 0; t < num_threads; ++t)
+    BOOST_TEST(thread_errors[t] == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
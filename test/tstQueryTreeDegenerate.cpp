@@ -11,6 +11,7 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <set>
 #include <vector>
 
 #include "Search_UnitTestHelpers.hpp"
@@ -369,6 +370,67 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(not_exceeding_stack_capacity_spatial_predicate,
   BOOST_TEST(ArborX::Details::KokkosExt::lastElement(space, offset) == n);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(support_wide_offset_types, TreeTypeTraits,
+                              TreeTypeTraitsList)
+{
+  // The offset element type parametrizes the result indexing; 64-bit
+  // offsets must produce the same graph as the default 32-bit ones
+  using Tree = typename TreeTypeTraits::type;
+  using ExecutionSpace = typename TreeTypeTraits::execution_space;
+  using DeviceType = typename TreeTypeTraits::device_type;
+
+  std::vector<ArborX::Box> boxes;
+  int const n = 64;
+  boxes.reserve(n);
+  for (int i = 0; i < n; ++i)
+  {
+    double const a = i;
+    double const b = i + 1;
+    boxes.push_back({{{a, a, a}}, {{b, b, b}}});
+  }
+  ExecutionSpace space;
+  auto const bvh = make<Tree>(space, boxes);
+
+  auto queries = makeIntersectsBoxQueries<DeviceType>({
+      {{{0., 0., 0.}}, {{n, n, n}}},
+      {},
+      {{{0., 0., 0.}}, {{1., 1., 1.}}},
+  });
+
+  Kokkos::View<int *, DeviceType> indices("indices", 0);
+  Kokkos::View<int *, DeviceType> offset("offset", 0);
+  ArborX::query(bvh, space, queries, indices, offset);
+
+  Kokkos::View<int *, DeviceType> wide_indices("indices", 0);
+  Kokkos::View<long long *, DeviceType> wide_offset("offset", 0);
+  ArborX::query(bvh, space, queries, wide_indices, wide_offset);
+
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+  auto wide_offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, wide_offset);
+  BOOST_TEST(wide_offset_host.size() == offset_host.size());
+  for (int i = 0; i < (int)offset_host.size(); ++i)
+    BOOST_TEST(wide_offset_host(i) == offset_host(i));
+
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  auto wide_indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, wide_indices);
+  BOOST_TEST(wide_indices_host.size() == indices_host.size());
+  for (int i = 0; i < (int)offset_host.size() - 1; ++i)
+  {
+    std::set<int> expected;
+    std::set<int> actual;
+    for (int j = offset_host(i); j < offset_host(i + 1); ++j)
+    {
+      expected.insert(indices_host(j));
+      actual.insert(wide_indices_host(j));
+    }
+    BOOST_TEST((actual == expected));
+  }
+}
+
 #ifndef ARBORX_TEST_DISABLE_NEAREST_QUERY
 BOOST_AUTO_TEST_CASE_TEMPLATE(not_exceeding_stack_capacity_nearest_predicate,
                               TreeTypeTraits, TreeTypeTraitsList)
@@ -0,0 +1,95 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include "ArborX_EnableViewComparison.hpp"
+#include <ArborX_HyperPoint.hpp>
+#include <ArborX_HyperSphere.hpp>
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_RoundedFloatBox.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(MixedPrecision)
+
+// Double-precision points indexed by a tree with outward-rounded float
+// nodes. Culling through the float boxes must not lose any of the exact
+// double-precision matches found at the leaves.
+BOOST_AUTO_TEST_CASE_TEMPLATE(mixed_precision_spatial, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space;
+
+  using Point = ArborX::ExperimentalHyperGeometry::Point<3, double>;
+  using Sphere = ArborX::ExperimentalHyperGeometry::Sphere<3, double>;
+
+  int const n = 100;
+
+  // points on a line with a spacing that is not representable in binary
+  Kokkos::View<Point *, MemorySpace> points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::points"),
+      n);
+  Kokkos::parallel_for(
+      "Test::generate_points", Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        points(i) = {0.1 * i, 0.1 * i, 0.1 * i};
+      });
+
+  using IntersectsSphere = decltype(ArborX::intersects(Sphere{}));
+  Kokkos::View<IntersectsSphere *, MemorySpace> queries(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::queries"),
+      n);
+  Kokkos::parallel_for(
+      "Test::generate_queries",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        // the spacing between neighbors is 0.1 * sqrt(3) ~ 0.173, so the
+        // radius covers the direct neighbors but not the second ones
+        queries(i) = ArborX::intersects(
+            Sphere{{0.1 * i, 0.1 * i, 0.1 * i}, 0.26});
+      });
+
+  ArborX::BoundingVolumeHierarchy<
+      MemorySpace, ArborX::PairValueIndex<Point>,
+      ArborX::Details::DefaultIndexableGetter,
+      ArborX::Experimental::RoundedFloatBox<3>>
+      tree{space, ArborX::Experimental::attach_indices(points)};
+
+  Kokkos::View<int *, MemorySpace> offset("Test::offset", 0);
+  Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+  tree.query(space, queries, ArborX::Details::LegacyDefaultCallback{}, indices,
+             offset);
+
+  // each query covers its own point and both direct neighbors
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  BOOST_TEST(offset_host.size() == n + 1);
+  for (int i = 0; i < n; ++i)
+  {
+    int const expected = 1 + (i > 0) + (i < n - 1);
+    BOOST_TEST(offset_host(i + 1) - offset_host(i) == expected);
+    bool found_self = false;
+    for (int k = offset_host(i); k < offset_host(i + 1); ++k)
+    {
+      BOOST_TEST(std::abs(indices_host(k) - i) <= 1);
+      found_self |= (indices_host(k) == i);
+    }
+    BOOST_TEST(found_self);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -12,10 +12,12 @@
 #include "ArborXTest_StdVectorToKokkosView.hpp"
 #include <ArborX.hpp>
 #include <ArborX_Ray.hpp>
+#include <ArborX_RayStream.hpp>
 
 #include <boost/test/unit_test.hpp>
 
-#include <numeric> //iota
+#include <algorithm> //sort
+#include <numeric>   //iota
 #include <vector>
 
 #include "Search_UnitTestHelpers.hpp"
@@ -130,6 +132,132 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_ray_box_intersection, DeviceType,
       exec_space, tree, predicates,
       make_reference_solution<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}, {0, 10}));
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_ray_box_intersection_packet, DeviceType,
+                              ARBORX_TEST_DEVICE_TYPES)
+{
+  using memory_space = typename DeviceType::memory_space;
+  typename DeviceType::execution_space exec_space;
+
+  std::vector<ArborX::Box> boxes;
+  for (unsigned int i = 0; i < 10; ++i)
+    boxes.emplace_back(ArborX::Point(i, i, i),
+                       ArborX::Point(i + 1, i + 1, i + 1));
+  Kokkos::View<ArborX::Box *, DeviceType> device_boxes("boxes", 10);
+  Kokkos::deep_copy(exec_space, device_boxes,
+                    Kokkos::View<ArborX::Box *, Kokkos::HostSpace>(
+                        boxes.data(), boxes.size()));
+
+  ArborX::BVH<memory_space> const tree(exec_space, device_boxes);
+
+  // coherent bundle: same direction, nearby origins, same hit set
+  Kokkos::View<ArborX::Experimental::Ray *, Kokkos::HostSpace> host_rays("rays",
+                                                                         2);
+  host_rays(0) = ArborX::Experimental::Ray{
+      ArborX::Point{0, 0, 0}, ArborX::Experimental::Vector{1, 1, 1}};
+  host_rays(1) = ArborX::Experimental::Ray{
+      ArborX::Point{.5, .5, .5}, ArborX::Experimental::Vector{1, 1, 1}};
+  Kokkos::View<ArborX::Experimental::Ray *, DeviceType> device_rays("rays", 2);
+  Kokkos::deep_copy(exec_space, device_rays, host_rays);
+
+  BoxesIntersectedByRay<DeviceType> predicates{device_rays};
+
+  Kokkos::View<int *, DeviceType> indices("indices", 0);
+  Kokkos::View<int *, DeviceType> offset("offset", 0);
+  ArborX::query(tree, exec_space, predicates, indices, offset,
+                ArborX::Experimental::TraversalPolicy().setRayPackets(true));
+
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  BOOST_TEST(offset_host.size() == 3);
+  BOOST_TEST(offset_host(0) == 0);
+  BOOST_TEST(offset_host(1) == 10);
+  BOOST_TEST(offset_host(2) == 20);
+  for (int q = 0; q < 2; ++q)
+  {
+    std::vector<int> hits(&indices_host(10 * q), &indices_host(10 * q) + 10);
+    std::sort(hits.begin(), hits.end());
+    for (int i = 0; i < 10; ++i)
+      BOOST_TEST(hits[i] == i);
+  }
+}
+
+template <typename DeviceType>
+struct AdvancePastHitShader
+{
+  Kokkos::View<int **, DeviceType> log;
+  Kokkos::View<int *, DeviceType> depth;
+
+  KOKKOS_FUNCTION bool operator()(int i, int hit,
+                                  ArborX::Experimental::Ray &ray) const
+  {
+    log(i, depth(i)++) = hit;
+    // Restart just past the box that was hit, keeping the direction
+    ray.origin() = {2.f * hit + 1.5f, .5f, .5f};
+    return true;
+  }
+};
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_ray_stream, DeviceType,
+                              ARBORX_TEST_DEVICE_TYPES)
+{
+  using memory_space = typename DeviceType::memory_space;
+  typename DeviceType::execution_space exec_space;
+
+  // boxes spaced out along the x-axis
+  int const n_boxes = 10;
+  std::vector<ArborX::Box> boxes;
+  for (int i = 0; i < n_boxes; ++i)
+    boxes.emplace_back(ArborX::Point(2.f * i, 0, 0),
+                       ArborX::Point(2.f * i + 1, 1, 1));
+  Kokkos::View<ArborX::Box *, DeviceType> device_boxes("boxes", n_boxes);
+  Kokkos::deep_copy(exec_space, device_boxes,
+                    Kokkos::View<ArborX::Box *, Kokkos::HostSpace>(
+                        boxes.data(), boxes.size()));
+
+  ArborX::BVH<memory_space> const tree(exec_space, device_boxes);
+
+  int const n_rays = 3;
+  Kokkos::View<ArborX::Experimental::Ray *, Kokkos::HostSpace> host_rays(
+      "rays", n_rays);
+  // marches through the boxes from the left; stopped by the bounce limit
+  host_rays(0) = ArborX::Experimental::Ray{
+      ArborX::Point{-1, .5f, .5f}, ArborX::Experimental::Vector{1, 0, 0}};
+  // starts inside box 7; runs off the right end after three hits
+  host_rays(1) = ArborX::Experimental::Ray{
+      ArborX::Point{14.2f, .5f, .5f}, ArborX::Experimental::Vector{1, 0, 0}};
+  // never hits anything
+  host_rays(2) = ArborX::Experimental::Ray{
+      ArborX::Point{-1, .5f, .5f}, ArborX::Experimental::Vector{-1, 0, 0}};
+  Kokkos::View<ArborX::Experimental::Ray *, DeviceType> device_rays("rays",
+                                                                    n_rays);
+  Kokkos::deep_copy(exec_space, device_rays, host_rays);
+
+  int const max_bounces = 4;
+  Kokkos::View<int **, DeviceType> log("log", n_rays, max_bounces);
+  Kokkos::deep_copy(log, -1);
+  Kokkos::View<int *, DeviceType> depth("depth", n_rays);
+
+  ArborX::Experimental::traverseRayStream(
+      exec_space, tree, device_rays,
+      AdvancePastHitShader<DeviceType>{log, depth}, max_bounces);
+
+  auto log_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, log);
+  auto depth_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, depth);
+
+  std::vector<std::vector<int>> log_ref = {
+      {0, 1, 2, 3}, {7, 8, 9, -1}, {-1, -1, -1, -1}};
+  std::vector<int> depth_ref = {4, 3, 0};
+  for (int r = 0; r < n_rays; ++r)
+  {
+    BOOST_TEST(depth_host(r) == depth_ref[r]);
+    for (int b = 0; b < max_bounces; ++b)
+      BOOST_TEST(log_host(r, b) == log_ref[r][b]);
+  }
+}
 BOOST_AUTO_TEST_SUITE_END()
 
 template <typename DeviceType>
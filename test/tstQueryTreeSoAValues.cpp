@@ -0,0 +1,117 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include "ArborX_EnableViewComparison.hpp"
+#include <ArborX_HyperPoint.hpp>
+#include <ArborX_LinearBVH.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(SoAValues)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(soa_values_layout, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space;
+
+  using Point = ArborX::ExperimentalHyperGeometry::Point<3>;
+
+  int const n = 100;
+  Kokkos::View<Point *, MemorySpace> points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::points"),
+      n);
+  Kokkos::parallel_for(
+      "Test::generate_points", Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        points(i) = {(float)(i % 10), (float)(i / 10), (float)(i % 7)};
+      });
+
+  using Value = ArborX::PairValueIndex<Point>;
+  ArborX::BoundingVolumeHierarchy<MemorySpace, Value> tree(
+      space, ArborX::Experimental::attach_indices(points));
+  ArborX::BoundingVolumeHierarchy<
+      MemorySpace, Value, ArborX::Details::DefaultIndexableGetter,
+      ArborX::ExperimentalHyperGeometry::Box<3, float>,
+      ArborX::Experimental::ValuesSoA>
+      tree_soa(space, ArborX::Experimental::attach_indices(points));
+
+  BOOST_TEST(tree_soa.size() == tree.size());
+  // The SoA layout moves the indices out of the leaf nodes
+  BOOST_TEST(tree_soa.memoryUsage().indices == n * sizeof(unsigned));
+  BOOST_TEST(tree_soa.memoryUsage().leaf_nodes <
+             tree.memoryUsage().leaf_nodes);
+
+  int const n_queries = 10;
+
+  // Spatial queries must see the exact same values in both layouts
+  {
+    using IntersectsSphere = decltype(ArborX::intersects(ArborX::Sphere{}));
+    Kokkos::View<IntersectsSphere *, MemorySpace> queries(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::queries"),
+        n_queries);
+    Kokkos::parallel_for(
+        "Test::generate_queries",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int i) {
+          queries(i) = ArborX::intersects(
+              ArborX::Sphere{{{(float)i, (float)i, (float)(i % 7)}}, 1.5f});
+        });
+
+    Kokkos::View<int *, MemorySpace> offset("Test::offset", 0);
+    Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+    tree.query(space, queries, ArborX::Details::LegacyDefaultCallback{},
+               indices, offset);
+
+    Kokkos::View<int *, MemorySpace> offset_soa("Test::offset_soa", 0);
+    Kokkos::View<int *, MemorySpace> indices_soa("Test::indices_soa", 0);
+    tree_soa.query(space, queries,
+                   ArborX::Details::LegacyDefaultCallback{}, indices_soa,
+                   offset_soa);
+
+    ARBORX_MDVIEW_TEST(offset_soa, offset);
+    ARBORX_MDVIEW_TEST(indices_soa, indices);
+  }
+
+  // Nearest queries exercise getValue() reassembling the pairs
+  {
+    using NearestToPoint = ArborX::Nearest<Point>;
+    Kokkos::View<NearestToPoint *, MemorySpace> queries(
+        Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::queries"),
+        n_queries);
+    Kokkos::parallel_for(
+        "Test::generate_queries",
+        Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+        KOKKOS_LAMBDA(int i) {
+          queries(i) = ArborX::nearest(
+              Point{(float)i, (float)i, (float)(i % 7)}, 3);
+        });
+
+    Kokkos::View<int *, MemorySpace> offset("Test::offset", 0);
+    Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+    tree.query(space, queries, ArborX::Details::LegacyDefaultCallback{},
+               indices, offset);
+
+    Kokkos::View<int *, MemorySpace> offset_soa("Test::offset_soa", 0);
+    Kokkos::View<int *, MemorySpace> indices_soa("Test::indices_soa", 0);
+    tree_soa.query(space, queries,
+                   ArborX::Details::LegacyDefaultCallback{}, indices_soa,
+                   offset_soa);
+
+    ARBORX_MDVIEW_TEST(offset_soa, offset);
+    ARBORX_MDVIEW_TEST(indices_soa, indices);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
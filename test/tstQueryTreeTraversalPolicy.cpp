@@ -14,6 +14,7 @@
 #include <ArborX_DetailsKokkosExtStdAlgorithms.hpp>
 #include <ArborX_DetailsKokkosExtViewHelpers.hpp>
 #include <ArborX_LinearBVH.hpp>
+#include <ArborX_TraversalStatistics.hpp>
 
 #include <boost/test/unit_test.hpp>
 
@@ -183,4 +184,409 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(unsorted_predicates, DeviceType,
   }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(cost_scheduling, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  // Heaviest-first scheduling only permutes the traversal order; the
+  // results must be identical to the default ordering
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  auto const bvh = make<ArborX::BVH<typename DeviceType::memory_space>>(
+      ExecutionSpace{}, {
+                            {{{0., 0., 0.}}, {{0., 0., 0.}}},
+                            {{{1., 1., 1.}}, {{1., 1., 1.}}},
+                            {{{2., 2., 2.}}, {{2., 2., 2.}}},
+                            {{{3., 3., 3.}}, {{3., 3., 3.}}},
+                        });
+
+  using ViewType = Kokkos::View<int *, DeviceType>;
+  ViewType indices("indices", 0);
+  ViewType offset("offset", 0);
+
+  // one heavy predicate covering the scene, two light ones
+  auto const queries = makeIntersectsBoxQueries<DeviceType>({
+      {{{2., 2., 2.}}, {{3., 3., 3.}}},
+      {{{0., 0., 0.}}, {{3., 3., 3.}}},
+      {{{0., 0., 0.}}, {{1., 1., 1.}}},
+  });
+
+  std::vector<int> indices_ref = {2, 3, 0, 1, 2, 3, 0, 1};
+  std::vector<int> offset_ref = {0, 2, 6, 8};
+
+  BOOST_CHECK_NO_THROW(ArborX::query(
+      bvh, ExecutionSpace{}, queries, indices, offset,
+      ArborX::Experimental::TraversalPolicy().setCostScheduling(true)));
+
+  auto indices_host = Kokkos::create_mirror_view(indices);
+  Kokkos::deep_copy(indices_host, indices);
+  auto offset_host = Kokkos::create_mirror_view(offset);
+  Kokkos::deep_copy(offset_host, offset);
+  BOOST_TEST(make_compressed_storage(offset_host, indices_host) ==
+                 make_compressed_storage(offset_ref, indices_ref),
+             tt::per_element());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(deduplicated_predicates, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  // Only representatives of byte-identical predicates are traversed and
+  // their rows copied to the duplicates; the results must be identical to
+  // the plain query
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  auto const bvh = make<ArborX::BVH<typename DeviceType::memory_space>>(
+      ExecutionSpace{}, {
+                            {{{0., 0., 0.}}, {{0., 0., 0.}}},
+                            {{{1., 1., 1.}}, {{1., 1., 1.}}},
+                            {{{2., 2., 2.}}, {{2., 2., 2.}}},
+                            {{{3., 3., 3.}}, {{3., 3., 3.}}},
+                        });
+
+  using ViewType = Kokkos::View<int *, DeviceType>;
+  ViewType indices("indices", 0);
+  ViewType offset("offset", 0);
+
+  // repeated predicates, including duplicates of one without results and a
+  // batch with no duplicates at all
+  auto const queries = makeIntersectsBoxQueries<DeviceType>({
+      {{{0., 0., 0.}}, {{1., 1., 1.}}},
+      {{{2., 2., 2.}}, {{3., 3., 3.}}},
+      {{{0., 0., 0.}}, {{1., 1., 1.}}},
+      {},
+      {},
+      {{{0., 0., 0.}}, {{1., 1., 1.}}},
+  });
+
+  std::vector<int> indices_ref = {0, 1, 2, 3, 0, 1, 0, 1};
+  std::vector<int> offset_ref = {0, 2, 4, 6, 6, 6, 8};
+
+  BOOST_CHECK_NO_THROW(ArborX::query(
+      bvh, ExecutionSpace{}, queries, indices, offset,
+      ArborX::Experimental::TraversalPolicy().setPredicateDeduplication(
+          true)));
+
+  auto indices_host = Kokkos::create_mirror_view(indices);
+  Kokkos::deep_copy(indices_host, indices);
+  auto offset_host = Kokkos::create_mirror_view(offset);
+  Kokkos::deep_copy(offset_host, offset);
+  BOOST_TEST(make_compressed_storage(offset_host, indices_host) ==
+                 make_compressed_storage(offset_ref, indices_ref),
+             tt::per_element());
+
+  // all predicates distinct: the stage detects nothing and falls through
+  auto const distinct_queries = makeIntersectsBoxQueries<DeviceType>({
+      {{{2., 2., 2.}}, {{3., 3., 3.}}},
+      {{{0., 0., 0.}}, {{1., 1., 1.}}},
+  });
+  BOOST_CHECK_NO_THROW(ArborX::query(
+      bvh, ExecutionSpace{}, distinct_queries, indices, offset,
+      ArborX::Experimental::TraversalPolicy().setPredicateDeduplication(
+          true)));
+  indices_host = Kokkos::create_mirror_view(indices);
+  Kokkos::deep_copy(indices_host, indices);
+  offset_host = Kokkos::create_mirror_view(offset);
+  Kokkos::deep_copy(offset_host, offset);
+  std::vector<int> distinct_indices_ref = {2, 3, 0, 1};
+  std::vector<int> distinct_offset_ref = {0, 2, 4};
+  BOOST_TEST(make_compressed_storage(offset_host, indices_host) ==
+                 make_compressed_storage(distinct_offset_ref,
+                                         distinct_indices_ref),
+             tt::per_element());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(scratch_tree, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  // The traversal runs against the scratch-resident copy of the nodes; the
+  // results must be identical to the global-memory walk
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  auto const bvh = make<ArborX::BVH<typename DeviceType::memory_space>>(
+      ExecutionSpace{}, {
+                            {{{0., 0., 0.}}, {{0., 0., 0.}}},
+                            {{{1., 1., 1.}}, {{1., 1., 1.}}},
+                            {{{2., 2., 2.}}, {{2., 2., 2.}}},
+                            {{{3., 3., 3.}}, {{3., 3., 3.}}},
+                            {{{4., 4., 4.}}, {{4., 4., 4.}}},
+                        });
+
+  auto const queries = makeIntersectsBoxQueries<DeviceType>({
+      {{{0., 0., 0.}}, {{1., 1., 1.}}},
+      {{{2.5, 2.5, 2.5}}, {{4.5, 4.5, 4.5}}},
+      {{{5., 5., 5.}}, {{6., 6., 6.}}}, // no results
+      {{{0., 0., 0.}}, {{4., 4., 4.}}}, // all leaves
+  });
+
+  using ViewType = Kokkos::View<int *, DeviceType>;
+  ViewType indices("indices", 0);
+  ViewType offset("offset", 0);
+  BOOST_CHECK_NO_THROW(ArborX::query(
+      bvh, ExecutionSpace{}, queries, indices, offset,
+      ArborX::Experimental::TraversalPolicy().setScratchTree(true)));
+
+  ViewType indices_ref("indices_ref", 0);
+  ViewType offset_ref("offset_ref", 0);
+  BOOST_CHECK_NO_THROW(
+      ArborX::query(bvh, ExecutionSpace{}, queries, indices_ref, offset_ref));
+
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+  auto indices_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices_ref);
+  auto offset_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset_ref);
+  BOOST_TEST(make_compressed_storage(offset_host, indices_host) ==
+                 make_compressed_storage(offset_ref_host, indices_ref_host),
+             tt::per_element());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(restart_trail, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  // The restart trail replays paths instead of popping a stack; the
+  // results must be identical to the stack-based nearest traversal
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  auto const bvh = make<ArborX::BVH<typename DeviceType::memory_space>>(
+      ExecutionSpace{}, {
+                            {{{0., 0., 0.}}, {{0., 0., 0.}}},
+                            {{{1., 1., 1.}}, {{1., 1., 1.}}},
+                            {{{2., 2., 2.}}, {{2., 2., 2.}}},
+                            {{{3., 3., 3.}}, {{3., 3., 3.}}},
+                            {{{4., 4., 4.}}, {{4., 4., 4.}}},
+                        });
+
+  auto const queries = makeNearestQueries<DeviceType>({
+      {{{0., 0., 0.}}, 3},
+      {{{4.5, 4.5, 4.5}}, 2},
+      {{{2.4, 2.4, 2.4}}, 10}, // k exceeds the number of leaves
+  });
+
+  using ViewType = Kokkos::View<int *, DeviceType>;
+  ViewType indices("indices", 0);
+  ViewType offset("offset", 0);
+  BOOST_CHECK_NO_THROW(ArborX::query(
+      bvh, ExecutionSpace{}, queries, indices, offset,
+      ArborX::Experimental::TraversalPolicy().setRestartTrail(true)));
+
+  ViewType indices_ref("indices_ref", 0);
+  ViewType offset_ref("offset_ref", 0);
+  BOOST_CHECK_NO_THROW(
+      ArborX::query(bvh, ExecutionSpace{}, queries, indices_ref, offset_ref));
+
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+  auto indices_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices_ref);
+  auto offset_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset_ref);
+  BOOST_TEST(make_compressed_storage(offset_host, indices_host) ==
+                 make_compressed_storage(offset_ref_host, indices_ref_host),
+             tt::per_element());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(k_major_buffer, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  // The interleaved layout only changes where the heap entries live; the
+  // results must be identical to the query-major buffer, including for
+  // batches mixing different k
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  auto const bvh = make<ArborX::BVH<typename DeviceType::memory_space>>(
+      ExecutionSpace{}, {
+                            {{{0., 0., 0.}}, {{0., 0., 0.}}},
+                            {{{1., 1., 1.}}, {{1., 1., 1.}}},
+                            {{{2., 2., 2.}}, {{2., 2., 2.}}},
+                            {{{3., 3., 3.}}, {{3., 3., 3.}}},
+                            {{{4., 4., 4.}}, {{4., 4., 4.}}},
+                        });
+
+  auto const queries = makeNearestQueries<DeviceType>({
+      {{{0., 0., 0.}}, 3},
+      {{{4.5, 4.5, 4.5}}, 1},
+      {{{2.4, 2.4, 2.4}}, 10}, // k exceeds the number of leaves
+      {{{1.1, 1.1, 1.1}}, 5},
+  });
+
+  using ViewType = Kokkos::View<int *, DeviceType>;
+  ViewType indices("indices", 0);
+  ViewType offset("offset", 0);
+  BOOST_CHECK_NO_THROW(ArborX::query(
+      bvh, ExecutionSpace{}, queries, indices, offset,
+      ArborX::Experimental::TraversalPolicy().setKMajorBuffer(true)));
+
+  ViewType indices_ref("indices_ref", 0);
+  ViewType offset_ref("offset_ref", 0);
+  BOOST_CHECK_NO_THROW(
+      ArborX::query(bvh, ExecutionSpace{}, queries, indices_ref, offset_ref));
+
+  auto indices_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+  auto offset_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+  auto indices_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices_ref);
+  auto offset_ref_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset_ref);
+  BOOST_TEST(make_compressed_storage(offset_host, indices_host) ==
+                 make_compressed_storage(offset_ref_host, indices_ref_host),
+             tt::per_element());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(user_provided_storage, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+
+  auto const bvh = make<ArborX::BVH<typename DeviceType::memory_space>>(
+      ExecutionSpace{}, {
+                            {{{0., 0., 0.}}, {{0., 0., 0.}}},
+                            {{{1., 0., 0.}}, {{1., 0., 0.}}},
+                            {{{2., 0., 0.}}, {{2., 0., 0.}}},
+                            {{{3., 0., 0.}}, {{3., 0., 0.}}},
+                        });
+
+  auto const policy =
+      ArborX::Experimental::TraversalPolicy().setUserProvidedStorage(true);
+
+  using ViewType = Kokkos::View<int *, DeviceType>;
+
+  auto checkResultsAreFine = [](auto const &indices, auto const &offset,
+                                std::vector<int> const &indices_ref,
+                                std::vector<int> const &offset_ref) {
+    auto indices_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, indices);
+    auto offset_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, offset);
+    BOOST_TEST(make_compressed_storage(offset_host, indices_host) ==
+                   make_compressed_storage(offset_ref, indices_ref),
+               tt::per_element());
+  };
+
+  {
+    auto const queries = makeIntersectsBoxQueries<DeviceType>({
+        {},
+        {{{0., 0., 0.}}, {{3., 3., 3.}}},
+        {},
+    });
+    std::vector<int> const indices_ref = {0, 1, 2, 3};
+    std::vector<int> const offset_ref = {0, 0, 4, 4};
+
+    ViewType offset("offset", 4);
+
+    // exact-fit capacity
+    ViewType indices("indices", 4);
+    BOOST_CHECK_NO_THROW(
+        ArborX::query(bvh, ExecutionSpace{}, queries, indices, offset, policy));
+    BOOST_TEST(indices.size() == 4u); // not reallocated
+    checkResultsAreFine(indices, offset, indices_ref, offset_ref);
+
+    // extra capacity is neither shrunk nor reallocated
+    ViewType indices_large("indices", 10);
+    BOOST_CHECK_NO_THROW(ArborX::query(bvh, ExecutionSpace{}, queries,
+                                       indices_large, offset, policy));
+    BOOST_TEST(indices_large.size() == 10u);
+    checkResultsAreFine(indices_large, offset, indices_ref, offset_ref);
+
+    // insufficient capacity throws instead of reallocating
+    ViewType indices_small("indices", 2);
+    BOOST_CHECK_THROW(ArborX::query(bvh, ExecutionSpace{}, queries,
+                                    indices_small, offset, policy),
+                      ArborX::SearchException);
+
+    // the offset view must have exactly one entry per query plus one
+    ViewType offset_wrong("offset", 2);
+    BOOST_CHECK_THROW(ArborX::query(bvh, ExecutionSpace{}, queries, indices,
+                                    offset_wrong, policy),
+                      ArborX::SearchException);
+  }
+
+  {
+    auto const queries = makeNearestQueries<DeviceType>({
+        {{{0., 0., 0.}}, 2},
+        {{{3., 0., 0.}}, 2},
+    });
+
+    ViewType offset("offset", 3);
+    ViewType indices("indices", 4);
+    BOOST_CHECK_NO_THROW(
+        ArborX::query(bvh, ExecutionSpace{}, queries, indices, offset, policy));
+    BOOST_TEST(indices.size() == 4u);
+    checkResultsAreFine(indices, offset, {0, 1, 3, 2}, {0, 2, 4});
+
+    // nearest queries need room for k results per query even if fewer are
+    // found; the compacted results only occupy the front of the view
+    auto const greedy_queries = makeNearestQueries<DeviceType>({
+        {{{0., 0., 0.}}, 10},
+    });
+    ViewType greedy_indices("indices", 10);
+    ViewType greedy_offset("offset", 2);
+    BOOST_CHECK_NO_THROW(ArborX::query(bvh, ExecutionSpace{}, greedy_queries,
+                                       greedy_indices, greedy_offset, policy));
+    BOOST_TEST(greedy_indices.size() == 10u);
+    checkResultsAreFine(greedy_indices, greedy_offset, {0, 1, 2, 3}, {0, 4});
+
+    ViewType indices_small("indices", 3);
+    BOOST_CHECK_THROW(ArborX::query(bvh, ExecutionSpace{}, queries,
+                                    indices_small, offset, policy),
+                      ArborX::SearchException);
+  }
+}
+
+struct DiscardResults
+{
+  template <typename Predicate>
+  KOKKOS_FUNCTION void operator()(Predicate const &, int) const
+  {}
+};
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(latency_histogram, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  auto const bvh = make<ArborX::BVH<MemorySpace>>(
+      ExecutionSpace{}, {
+                            {{{0., 0., 0.}}, {{0., 0., 0.}}},
+                            {{{1., 0., 0.}}, {{1., 0., 0.}}},
+                            {{{2., 0., 0.}}, {{2., 0., 0.}}},
+                            {{{3., 0., 0.}}, {{3., 0., 0.}}},
+                        });
+
+  auto const queries = makeIntersectsBoxQueries<DeviceType>({
+      {{{0., 0., 0.}}, {{3., 3., 3.}}},
+      {{{1., 0., 0.}}, {{2., 0., 0.}}},
+      {},
+  });
+
+  ArborX::Experimental::TraversalStatistics<MemorySpace> statistics;
+  auto const policy =
+      ArborX::Experimental::TraversalPolicy().setLatencyHistogram(statistics);
+
+  // Every predicate lands in exactly one bin
+  bvh.query(ExecutionSpace{}, queries, DiscardResults{}, policy);
+  Kokkos::fence();
+  BOOST_TEST(statistics.count() == 3u);
+
+  // The histogram accumulates across queries (and predicate tags) until reset
+  bvh.query(ExecutionSpace{},
+            makeNearestQueries<DeviceType>({{{{0., 0., 0.}}, 2}}),
+            DiscardResults{}, policy);
+  Kokkos::fence();
+  BOOST_TEST(statistics.count() == 4u);
+
+  BOOST_TEST(statistics.quantileBin(0.99) >= statistics.quantileBin(0.5));
+
+  statistics.reset();
+  BOOST_TEST(statistics.count() == 0u);
+  BOOST_TEST(statistics.quantileBin(0.5) == 0);
+
+  // Queries without the histogram set do not record
+  bvh.query(ExecutionSpace{}, queries, DiscardResults{});
+  Kokkos::fence();
+  BOOST_TEST(statistics.count() == 0u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
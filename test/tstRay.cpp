@@ -276,6 +276,95 @@ BOOST_AUTO_TEST_CASE(ray_box_distance)
   BOOST_TEST(ArborX::Experimental::distance(Ray{{.5, .5, -.5}, {0, 0, -1}}, unit_box) == inf);
 }
 
+BOOST_AUTO_TEST_CASE(precomputed_ray_box,
+                     *boost::unit_test::tolerance(1e-6f))
+{
+  using ArborX::Box;
+  using ArborX::Experimental::makePrecomputedRay;
+  using ArborX::Experimental::Ray;
+
+  constexpr Box unit_box{{0, 0, 0}, {1, 1, 1}};
+
+  // the cached reciprocals must reproduce the plain ray results, including
+  // the axis-parallel cases where a direction component is zero
+  Ray rays[] = {
+      {{.5, .5, .5}, {1, 0, 0}},
+      {{-1, .5, .5}, {1, 0, 0}},
+      {{-1, .5, .5}, {-1, 0, 0}},
+      {{2, .5, .5}, {-1, 0, 0}},
+      {{-1, 1.5, .5}, {1, -1, 0}},
+      {{1, 2, 3}, {-1, -2, -3}},
+      // origin on a slab plane with an axis-parallel direction (the 0 * inf
+      // corner case discussed with the slab tests)
+      {{0, .5, .5}, {0, 1, 0}},
+      {{1, .5, .5}, {0, 0, 1}},
+      {{0, 2, 2}, {0, -1, -1}},
+  };
+  for (auto const &ray : rays)
+  {
+    auto const precomputed = makePrecomputedRay(ray);
+    BOOST_TEST(intersects(precomputed, unit_box) ==
+               intersects(ray, unit_box));
+    BOOST_TEST(ArborX::Experimental::distance(precomputed, unit_box) ==
+               ArborX::Experimental::distance(ray, unit_box));
+
+    float tmin;
+    float tmax;
+    float tmin_ref;
+    float tmax_ref;
+    if (intersection(ray, unit_box, tmin_ref, tmax_ref))
+    {
+      BOOST_TEST(intersection(precomputed, unit_box, tmin, tmax));
+      BOOST_TEST(tmin == tmin_ref);
+      BOOST_TEST(tmax == tmax_ref);
+    }
+  }
+
+  // the conversion back to Ray keeps the other geometry overloads usable
+  auto const precomputed = makePrecomputedRay(Ray{{.5, .5, -1}, {0, 0, 1}});
+  float tmin;
+  float tmax;
+  BOOST_TEST(intersection(static_cast<Ray const &>(precomputed),
+                          ArborX::Sphere{{.5, .5, .5}, .4f}, tmin, tmax));
+}
+
+BOOST_AUTO_TEST_CASE(intersects_frustum)
+{
+  using ArborX::Box;
+  using ArborX::Experimental::expand;
+  using ArborX::Experimental::Ray;
+  using ArborX::Experimental::RayFrustum;
+
+  constexpr Box unit_box{{0, 0, 0}, {1, 1, 1}};
+
+  // a frustum with no rays intersects nothing
+  RayFrustum frustum;
+  BOOST_TEST(!intersects(frustum, unit_box));
+
+  // bundle of near-parallel rays shooting down the x axis
+  expand(frustum, Ray{{-1, .2, .2}, {1, .01, .01}});
+  expand(frustum, Ray{{-1, .8, .8}, {1, .02, .02}});
+  BOOST_TEST(intersects(frustum, unit_box));
+  // boxes in front of the bundle
+  BOOST_TEST(intersects(frustum, Box{{5, 0, 0}, {6, 1, 1}}));
+  // boxes behind or to the side of the bundle are culled
+  BOOST_TEST(!intersects(frustum, Box{{-5, 0, 0}, {-4, 1, 1}}));
+  BOOST_TEST(!intersects(frustum, Box{{0, 5, 0}, {1, 6, 1}}));
+  BOOST_TEST(!intersects(frustum, Box{{0, 0, 5}, {1, 1, 6}}));
+
+  // the test is conservative: the bound covers the whole bundle, so a box
+  // between the rays is reported even though neither ray hits it
+  BOOST_TEST(intersects(frustum, Box{{-.8, .45, .45}, {-.7, .55, .55}}));
+
+  // directions straddling zero in a component disable culling on that axis
+  // but the others still apply
+  RayFrustum diverging;
+  expand(diverging, Ray{{0, 0, 0}, {1, 1, 0}});
+  expand(diverging, Ray{{0, 0, 0}, {1, -1, 0}});
+  BOOST_TEST(intersects(diverging, Box{{2, -3, 0}, {3, 3, 1}}));
+  BOOST_TEST(!intersects(diverging, Box{{-3, -3, 0}, {-2, 3, 1}}));
+}
+
 // NOTE until boost 1.70 need to cast both operands when comparing floating
 // points
 BOOST_AUTO_TEST_CASE(overlap_distance_sphere,
@@ -474,6 +563,53 @@ BOOST_AUTO_TEST_CASE(intersects_triangle)
   BOOST_TEST(!intersects(Ray{{0., 0., 0.1}, {1, 1, 1}}, tilted_triangle));
 }
 
+BOOST_AUTO_TEST_CASE(intersects_precomputed_triangle,
+                     *boost::unit_test::tolerance(2e-6f))
+{
+  using ArborX::Experimental::makePrecomputedTriangle;
+  using ArborX::Experimental::Ray;
+  using ArborX::ExperimentalHyperGeometry::Point;
+  using ArborX::ExperimentalHyperGeometry::Triangle;
+
+  auto const unit_triangle = makePrecomputedTriangle(
+      Triangle{Point{0, 0, 0}, Point{1, 0, 0}, Point{0, 1, 0}});
+
+  BOOST_TEST(intersects(Ray{{.1, .2, .3}, {0, 0, -1}}, unit_triangle));
+  BOOST_TEST(intersects(Ray{{1.1, 1.2, 1}, {-1, -1, -1}}, unit_triangle));
+  BOOST_TEST(intersects(Ray{{-1.9, 3.2, -1}, {2, -3, 1}}, unit_triangle));
+  BOOST_TEST(!intersects(Ray{{1, 2, 3}, {1, 1, 0}}, unit_triangle));
+  BOOST_TEST(!intersects(Ray{{-1, 2, -3}, {0, 0, 1}}, unit_triangle));
+
+  // ray origin on the triangle
+  BOOST_TEST(intersects(Ray{{.1, .2, 0}, {0, 0, 1}}, unit_triangle));
+  BOOST_TEST(intersects(Ray{{.1, .2, 0}, {0, 0, -1}}, unit_triangle));
+
+  // ray directed away from the triangle
+  BOOST_TEST(!intersects(Ray{{.1, .2, .3}, {0, 0, 1}}, unit_triangle));
+
+  // hits vertices and edges
+  BOOST_TEST(intersects(Ray{{0, 0, -1}, {0, 0, 1}}, unit_triangle));
+  BOOST_TEST(intersects(Ray{{1, 0, -2}, {0, 0, 1}}, unit_triangle));
+  BOOST_TEST(intersects(Ray{{.5, .5, -3}, {0, 0, 1}}, unit_triangle));
+
+  // unlike the test on the raw vertices, coplanar rays are misses
+  BOOST_TEST(!intersects(Ray{{.3, .3, 0}, {1, 1, 0}}, unit_triangle));
+
+  // hit parameter matches the full test
+  auto const tilted = Triangle{Point{0, 0, 0}, Point{2, 0, 1}, Point{0, 2, 1}};
+  auto const tilted_precomputed = makePrecomputedTriangle(tilted);
+  Ray const ray{{.5, .5, 3}, {0, 0, -1}};
+  float t0_ref;
+  float t1_ref;
+  BOOST_TEST(ArborX::Experimental::intersection(ray, tilted, t0_ref, t1_ref));
+  float t0;
+  float t1;
+  BOOST_TEST(
+      ArborX::Experimental::intersection(ray, tilted_precomputed, t0, t1));
+  BOOST_TEST(t0 == t0_ref);
+  BOOST_TEST(t1 == t1_ref);
+}
+
 #define ARBORX_TEST_RAY_TRIANGLE_INTERSECTION(ray, triangle, t0_ref, t1_ref)   \
   do                                                                           \
   {                                                                            \
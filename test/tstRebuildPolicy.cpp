@@ -0,0 +1,116 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_RebuildPolicy.hpp>
+#include <ArborX_TreeQualityMetrics.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(RebuildPolicy)
+
+namespace tt = boost::test_tools;
+
+template <typename ExecutionSpace, typename Points>
+void generate_grid_points(ExecutionSpace const &space, Points const &points)
+{
+  int const n = points.extent_int(0);
+  Kokkos::parallel_for(
+      "Test::generate_grid_points",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        points(i) = {(float)(i % 16), (float)(i / 16), 0.f};
+      });
+}
+
+template <typename ExecutionSpace, typename Points>
+void generate_scattered_points(ExecutionSpace const &space,
+                               Points const &points)
+{
+  int const n = points.extent_int(0);
+  Kokkos::parallel_for(
+      "Test::generate_scattered_points",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n), KOKKOS_LAMBDA(int i) {
+        // Jump each point far from its neighbors so refitted boxes blow up
+        int const j = (i * 61) % n;
+        points(i) = {100.f * (j % 16), 100.f * (j / 16), 100.f * (i % 7)};
+      });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(rebuild_policy, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space;
+
+  using Point = ArborX::ExperimentalHyperGeometry::Point<3>;
+  using Tree = ArborX::BoundingVolumeHierarchy<MemorySpace,
+                                               ArborX::PairValueIndex<Point>>;
+
+  int const n = 256;
+  Kokkos::View<Point *, MemorySpace> points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::points"),
+      n);
+  generate_grid_points(space, points);
+
+  Tree tree(space, ArborX::Experimental::attach_indices(points));
+  ArborX::Experimental::RebuildPolicy<Tree> policy;
+
+  // Quiescent step: no motion, no quality loss, no rebuild
+  policy.update(space, tree, ArborX::Experimental::attach_indices(points));
+  BOOST_TEST(!policy.rebuiltOnLastUpdate());
+
+  // Violent step: the scattered positions inflate the refitted boxes far
+  // beyond the default degradation threshold
+  generate_scattered_points(space, points);
+  policy.update(space, tree, ArborX::Experimental::attach_indices(points));
+  BOOST_TEST(policy.rebuiltOnLastUpdate());
+
+  // The rebuild is a regular construction over the new values
+  BOOST_TEST(tree.size() == (unsigned)n);
+  Tree reference(space, ArborX::Experimental::attach_indices(points));
+  auto const sah =
+      ArborX::Experimental::computeTreeQualityMetrics(space, tree).sah_cost;
+  auto const reference_sah =
+      ArborX::Experimental::computeTreeQualityMetrics(space, reference)
+          .sah_cost;
+  BOOST_TEST(sah == reference_sah, tt::tolerance(1e-5f));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(rebuild_policy_threshold, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space;
+
+  using Point = ArborX::ExperimentalHyperGeometry::Point<3>;
+  using Tree = ArborX::BoundingVolumeHierarchy<MemorySpace,
+                                               ArborX::PairValueIndex<Point>>;
+
+  int const n = 256;
+  Kokkos::View<Point *, MemorySpace> points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::points"),
+      n);
+  generate_grid_points(space, points);
+
+  Tree tree(space, ArborX::Experimental::attach_indices(points));
+  ArborX::Experimental::RebuildPolicy<Tree> policy;
+  // An unreachable threshold keeps the policy refitting no matter what
+  policy.setDegradationThreshold(1e6f);
+
+  generate_scattered_points(space, points);
+  policy.update(space, tree, ArborX::Experimental::attach_indices(points));
+  BOOST_TEST(!policy.rebuiltOnLastUpdate());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,83 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include "ArborX_EnableViewComparison.hpp"
+#include <ArborX_HyperPoint.hpp>
+#include <ArborX_LinearBVH.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio> // remove
+
+BOOST_AUTO_TEST_SUITE(SaveAndLoad)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(save_and_load, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space;
+
+  using Point = ArborX::ExperimentalHyperGeometry::Point<3>;
+
+  int const n = 100;
+  Kokkos::View<Point *, MemorySpace> points(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::points"),
+      n);
+  Kokkos::parallel_for(
+      "Test::generate_points", Kokkos::RangePolicy<ExecutionSpace>(space, 0, n),
+      KOKKOS_LAMBDA(int i) {
+        points(i) = {(float)(i % 10), (float)(i / 10), (float)(i % 7)};
+      });
+
+  using Tree =
+      ArborX::BoundingVolumeHierarchy<MemorySpace, ArborX::PairValueIndex<Point>>;
+  Tree tree(space, ArborX::Experimental::attach_indices(points));
+
+  std::string const filename = "ArborX_tstSaveAndLoad_tree.bin";
+  tree.saveToFile(filename);
+  auto tree_reloaded = Tree::loadFromFile(space, filename);
+  std::remove(filename.c_str());
+
+  BOOST_TEST(tree_reloaded.size() == tree.size());
+
+  // Same queries must come back with identical results from both trees
+  int const n_queries = 10;
+  using IntersectsSphere = decltype(ArborX::intersects(ArborX::Sphere{}));
+  Kokkos::View<IntersectsSphere *, MemorySpace> queries(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::queries"),
+      n_queries);
+  Kokkos::parallel_for(
+      "Test::generate_queries",
+      Kokkos::RangePolicy<ExecutionSpace>(space, 0, n_queries),
+      KOKKOS_LAMBDA(int i) {
+        queries(i) = ArborX::intersects(
+            ArborX::Sphere{{{(float)i, (float)i, (float)(i % 7)}}, 1.5f});
+      });
+
+  Kokkos::View<int *, MemorySpace> offset("Test::offset", 0);
+  Kokkos::View<int *, MemorySpace> indices("Test::indices", 0);
+  tree.query(space, queries, ArborX::Details::LegacyDefaultCallback{},
+             indices, offset);
+
+  Kokkos::View<int *, MemorySpace> offset_reloaded("Test::offset_reloaded", 0);
+  Kokkos::View<int *, MemorySpace> indices_reloaded("Test::indices_reloaded",
+                                                    0);
+  tree_reloaded.query(space, queries,
+                      ArborX::Details::LegacyDefaultCallback{},
+                      indices_reloaded, offset_reloaded);
+
+  ARBORX_MDVIEW_TEST(offset_reloaded, offset);
+  ARBORX_MDVIEW_TEST(indices_reloaded, indices);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,71 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_Box.hpp>
+#include <ArborX_SpatialSplits.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(SpatialSplits)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(split_references, DeviceType, ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+  ExecutionSpace space;
+
+  // A cube, a 10:1:1 box, and a degenerate segment along x
+  Kokkos::View<ArborX::Box *, MemorySpace> boxes(
+      Kokkos::view_alloc(space, Kokkos::WithoutInitializing, "Test::boxes"), 3);
+  auto boxes_host = Kokkos::create_mirror_view(boxes);
+  boxes_host(0) = {{0, 0, 0}, {1, 1, 1}};
+  boxes_host(1) = {{0, 0, 0}, {10, 1, 1}};
+  boxes_host(2) = {{0, 0, 0}, {5, 0, 0}};
+  Kokkos::deep_copy(space, boxes, boxes_host);
+
+  auto references = ArborX::Experimental::splitReferences(
+      space, boxes, /*max_aspect_ratio*/ 4, /*max_fragments*/ 8);
+
+  // cube: 1 fragment; 10:1:1 box: ceil(10/4) = 3; segment: max_fragments
+  BOOST_TEST(references.size() == 1u + 3u + 8u);
+
+  auto references_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, references);
+
+  int offset = 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    int const k = (i == 0 ? 1 : (i == 1 ? 3 : 8));
+    auto const &box = boxes_host(i);
+    auto const step = (box.maxCorner()[0] - box.minCorner()[0]) / k;
+    for (int f = 0; f < k; ++f)
+    {
+      auto const &reference = references_host(offset + f);
+      BOOST_TEST(reference.index == (unsigned)i);
+      auto const &fragment = reference.value;
+      // Fragments tile the original box along its longest axis (x for all
+      // three), preserving the other dimensions and the exact far boundary
+      BOOST_TEST(fragment.minCorner()[0] == f * step);
+      BOOST_TEST(fragment.maxCorner()[0] ==
+                 (f + 1 == k ? box.maxCorner()[0] : (f + 1) * step));
+      for (int d = 1; d < 3; ++d)
+      {
+        BOOST_TEST(fragment.minCorner()[d] == box.minCorner()[d]);
+        BOOST_TEST(fragment.maxCorner()[d] == box.maxCorner()[d]);
+      }
+    }
+    offset += k;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
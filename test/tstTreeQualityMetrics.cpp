@@ -0,0 +1,87 @@
+/****************************************************************************
+ * Copyright (c) 2017-2023 by the ArborX authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the ArborX library. ArborX is                       *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "ArborXTest_Cloud.hpp"
+#include "ArborX_EnableDeviceTypes.hpp" // ARBORX_DEVICE_TYPES
+#include <ArborX_LinearBVH.hpp>
+#include <ArborX_TreeQualityMetrics.hpp>
+
+#include "BoostTest_CUDA_clang_workarounds.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+
+BOOST_AUTO_TEST_SUITE(TreeQualityMetrics)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(tree_quality_metrics, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  int const n = 256;
+  auto points = ArborXTest::make_random_cloud<ArborX::Point>(exec_space, n);
+
+  ArborX::BVH<MemorySpace> bvh(exec_space, points);
+  auto const metrics =
+      ArborX::Experimental::computeTreeQualityMetrics(exec_space, bvh);
+
+  // A query intersecting the scene visits at least the root
+  BOOST_TEST(metrics.sah_cost >= 1.f);
+  // The intersection of two siblings is contained in their parent
+  BOOST_TEST(metrics.sibling_overlap >= 0.f);
+  BOOST_TEST(metrics.sibling_overlap <= 1.f);
+
+  // A binary tree over n leaves is at least ceil(log2(n)) deep
+  BOOST_TEST(metrics.min_leaf_depth >= 1);
+  BOOST_TEST(metrics.max_leaf_depth >= (int)std::ceil(std::log2(n)));
+  BOOST_TEST(metrics.min_leaf_depth <= metrics.max_leaf_depth);
+
+  // Every leaf lands in exactly one histogram bin
+  auto const &histogram = metrics.leaf_depth_histogram;
+  BOOST_TEST((int)histogram.size() == metrics.max_leaf_depth + 1);
+  int count = 0;
+  for (int d = 0; d < (int)histogram.size(); ++d)
+    count += histogram(d);
+  BOOST_TEST(count == n);
+  BOOST_TEST(histogram(metrics.min_leaf_depth) > 0);
+  BOOST_TEST(histogram(metrics.max_leaf_depth) > 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(tree_quality_metrics_degenerate, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using MemorySpace = typename DeviceType::memory_space;
+  using ExecutionSpace = typename DeviceType::execution_space;
+  ExecutionSpace exec_space;
+
+  {
+    ArborX::BVH<MemorySpace> empty_bvh;
+    auto const metrics =
+        ArborX::Experimental::computeTreeQualityMetrics(exec_space, empty_bvh);
+    BOOST_TEST(metrics.sah_cost == 0.f);
+    BOOST_TEST(metrics.leaf_depth_histogram.size() == 0u);
+  }
+
+  {
+    auto point = ArborXTest::make_random_cloud<ArborX::Point>(exec_space, 1);
+    ArborX::BVH<MemorySpace> one_leaf_bvh(exec_space, point);
+    auto const metrics = ArborX::Experimental::computeTreeQualityMetrics(
+        exec_space, one_leaf_bvh);
+    BOOST_TEST(metrics.sah_cost == 1.f);
+    BOOST_TEST(metrics.max_leaf_depth == 0);
+    BOOST_TEST(metrics.leaf_depth_histogram.size() == 1u);
+    BOOST_TEST(metrics.leaf_depth_histogram(0) == 1);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -110,4 +110,40 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(union_find, DeviceType, ARBORX_DEVICE_TYPES)
                                          (std::vector<int>{0, 0, 0, 0, 0}));
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(union_find_scattered, DeviceType,
+                              ARBORX_DEVICE_TYPES)
+{
+  using ExecutionSpace = typename DeviceType::execution_space;
+  using MemorySpace = typename DeviceType::memory_space;
+
+  ExecutionSpace space;
+
+  constexpr int n = 5;
+
+  // The representatives are remapped to the smallest set index, so the same
+  // expectations hold regardless of the promotion policy
+  ArborX::Details::ScatteredUnionFind<MemorySpace> union_find(space, n);
+
+  ARBORX_TEST_UNION_FIND_REPRESENTATIVES(space, union_find,
+                                         (std::vector<int>{0, 1, 2, 3, 4}));
+
+  merge(space, union_find, 1, 1);
+  ARBORX_TEST_UNION_FIND_REPRESENTATIVES(space, union_find,
+                                         (std::vector<int>{0, 1, 2, 3, 4}));
+
+  merge(space, union_find, 3, 0);
+  ARBORX_TEST_UNION_FIND_REPRESENTATIVES(space, union_find,
+                                         (std::vector<int>{0, 1, 2, 0, 4}));
+
+  merge(space, union_find, 1, 2);
+  merge(space, union_find, 4, 1);
+  merge(space, union_find, 1, 1);
+  ARBORX_TEST_UNION_FIND_REPRESENTATIVES(space, union_find,
+                                         (std::vector<int>{0, 1, 1, 0, 1}));
+
+  merge(space, union_find, 0, 1);
+  ARBORX_TEST_UNION_FIND_REPRESENTATIVES(space, union_find,
+                                         (std::vector<int>{0, 0, 0, 0, 0}));
+}
+
 BOOST_AUTO_TEST_SUITE_END()